@@ -67,7 +67,8 @@ struct PxConstraintFlag
 		eENABLE_EXTENDED_LIMITS		= 1<<9,		//!< enables extended limit ranges for angular limits (e.g., limit values > PxPi or < -PxPi)
 		eGPU_COMPATIBLE				= 1<<10,	//!< the constraint type is supported by gpu dynamics
 		eALWAYS_UPDATE				= 1<<11,	//!< updates the constraint each frame
-		eDISABLE_CONSTRAINT			= 1<<12		//!< disables the constraint. SolverPrep functions won't be called for this constraint.
+		eDISABLE_CONSTRAINT			= 1<<12,	//!< disables the constraint. SolverPrep functions won't be called for this constraint.
+		eWARM_START					= 1<<13		//!< warm-starts the solver with the impulses this constraint applied in the previous step, so that long chains of joints need fewer iterations to converge. The impulses are applied right before the first solver iteration. Only supported by the CPU solver, ignored for constraints involving articulations.
 	};
 };
 
@@ -89,6 +90,7 @@ struct PxConstraintShaderTable
 	PxConstraintProject		project;	//!< @deprecated constraint projection function
 	PxConstraintVisualize	visualize;	//!< constraint visualization function
 	PxConstraintFlag::Enum	flag;		//!< constraint flags
+	PxConstraintSolverPrepBatch	solverPrepBatch;	//!< optional batched solver constraint generation function, can be NULL. Only used for solver batches of 4 constraints sharing this function, see PxConstraintSolverPrepBatch
 };
 
 /**
@@ -231,6 +231,49 @@ typedef PxU32 (*PxConstraintSolverPrep)(Px1DConstraint* constraints,
 										PxVec3p& cAtW,
 										PxVec3p& cBtW);
 
+/**
+\brief Batched solver constraint generation shader
+
+Optional counterpart of PxConstraintSolverPrep that generates the rows of several constraints of the same type in one call,
+so that the implementation can process them in SIMD-friendly structure-of-arrays form. The results must match those of the
+regular shader for each constraint, up to floating-point rounding.
+
+The solver groups constraints in batches of 4, and the batched shader is only used for full batches whose 4 constraints all
+use the same PxConstraintSolverPrepBatch function. It is currently always called with nbConstraints equal to 4. Partial batches,
+batches mixing constraint types, and constraints without a batched shader fall back to PxConstraintSolverPrep, so the regular
+shader must always be provided.
+
+All array parameters contain nbConstraints entries, and entry i has the same meaning as the corresponding
+parameter of PxConstraintSolverPrep for constraint i.
+
+\param[in] nbConstraints		The number of constraints to prepare
+\param[out] constraints			The solver constraint row buffers, one per constraint. Each buffer can hold maxConstraints rows.
+\param[out] nbRows				The number of constraint rows written for each constraint
+\param[out] bodyAWorldOffset	See PxConstraintSolverPrep
+\param[in] maxConstraints		The size of each constraint buffer
+\param[out] invMassScale		See PxConstraintSolverPrep
+\param[in] constantBlock		The constant data blocks
+\param[in] bodyAToWorld			See PxConstraintSolverPrep
+\param[in] bodyBToWorld			See PxConstraintSolverPrep
+\param[in] useExtendedLimits	See PxConstraintSolverPrep
+\param[out] cAtW				See PxConstraintSolverPrep
+\param[out] cBtW				See PxConstraintSolverPrep
+
+@see PxConstraintSolverPrep PxConstraintShaderTable
+*/
+typedef void (*PxConstraintSolverPrepBatch)(PxU32 nbConstraints,
+											Px1DConstraint* const* constraints,
+											PxU32* nbRows,
+											PxVec3p* bodyAWorldOffset,
+											PxU32 maxConstraints,
+											PxConstraintInvMassScale* invMassScale,
+											const void* const* constantBlock,
+											const PxTransform* bodyAToWorld,
+											const PxTransform* bodyBToWorld,
+											const bool* useExtendedLimits,
+											PxVec3p* cAtW,
+											PxVec3p* cBtW);
+
 /**
 \brief Solver constraint projection shader
 
@@ -45,6 +45,7 @@ namespace physx
 	class PxCudaContextManager;
 	class PxBaseTask;
 	class PxGeometry;
+	class PxCpuDispatcher;
 
 #if !PX_DOXYGEN
 namespace immediate
@@ -587,6 +588,92 @@ namespace immediate
 	*/
 	PX_C_EXPORT PX_PHYSX_CORE_API void PxUpdateArticulationBodiesTGS(PxArticulationHandle articulation, const PxReal dt);
 
+	/**
+	\brief Computes unconstrained velocities for a set of articulations.
+
+	This is equivalent to calling PxComputeUnconstrainedVelocities() for each articulation, but the per-call overhead is
+	amortized over the batch and the articulations are distributed over the worker threads of the dispatcher, in chunks.
+	The articulations can have different topologies, but the work is split evenly by count, so batches of identical
+	articulations give the best load balancing.
+
+	\param	[in] articulations		Articulation handles. Each handle must appear only once.
+	\param	[in] nbArticulations	Number of articulations
+	\param	[in] gravity			Gravity vector
+	\param	[in] dt					Timestep
+	\param	[in] invLengthScale		1/lengthScale from PxTolerancesScale.
+	\param	[in] dispatcher			CPU dispatcher used to process the batch in parallel, or NULL to run on the calling thread.
+
+	@see PxComputeUnconstrainedVelocities
+	*/
+	PX_C_EXPORT PX_PHYSX_CORE_API void PxComputeUnconstrainedVelocitiesBatch(	const PxArticulationHandle* articulations, const PxU32 nbArticulations, const PxVec3& gravity,
+																				const PxReal dt, const PxReal invLengthScale, PxCpuDispatcher* dispatcher = NULL);
+
+	/**
+	\brief Updates bodies for a set of articulations. See PxComputeUnconstrainedVelocitiesBatch for the batching rules.
+	\param	[in] articulations		Articulation handles. Each handle must appear only once.
+	\param	[in] nbArticulations	Number of articulations
+	\param	[in] dt					Timestep
+	\param	[in] dispatcher			CPU dispatcher used to process the batch in parallel, or NULL to run on the calling thread.
+
+	@see PxUpdateArticulationBodies
+	*/
+	PX_C_EXPORT PX_PHYSX_CORE_API void PxUpdateArticulationBodiesBatch(const PxArticulationHandle* articulations, const PxU32 nbArticulations, const PxReal dt, PxCpuDispatcher* dispatcher = NULL);
+
+	/**
+	\brief Computes unconstrained velocities for a set of articulations. See PxComputeUnconstrainedVelocitiesBatch for the batching rules.
+	\param	[in] articulations		Articulation handles. Each handle must appear only once.
+	\param	[in] nbArticulations	Number of articulations
+	\param	[in] gravity			Gravity vector
+	\param	[in] dt					Timestep/numPosIterations
+	\param	[in] totalDt			Timestep
+	\param	[in] invDt				1/(Timestep/numPosIterations)
+	\param	[in] invTotalDt			1/Timestep
+	\param	[in] invLengthScale		1/lengthScale from PxTolerancesScale.
+	\param	[in] dispatcher			CPU dispatcher used to process the batch in parallel, or NULL to run on the calling thread.
+
+	@see PxComputeUnconstrainedVelocitiesTGS
+	*/
+	PX_C_EXPORT PX_PHYSX_CORE_API void PxComputeUnconstrainedVelocitiesBatchTGS(	const PxArticulationHandle* articulations, const PxU32 nbArticulations, const PxVec3& gravity,
+																					const PxReal dt, const PxReal totalDt, const PxReal invDt, const PxReal invTotalDt,
+																					const PxReal invLengthScale, PxCpuDispatcher* dispatcher = NULL);
+
+	/**
+	\brief Updates bodies for a set of articulations. See PxComputeUnconstrainedVelocitiesBatch for the batching rules.
+	\param	[in] articulations		Articulation handles. Each handle must appear only once.
+	\param	[in] nbArticulations	Number of articulations
+	\param	[in] dt					Timestep
+	\param	[in] dispatcher			CPU dispatcher used to process the batch in parallel, or NULL to run on the calling thread.
+
+	@see PxUpdateArticulationBodiesTGS
+	*/
+	PX_C_EXPORT PX_PHYSX_CORE_API void PxUpdateArticulationBodiesBatchTGS(const PxArticulationHandle* articulations, const PxU32 nbArticulations, const PxReal dt, PxCpuDispatcher* dispatcher = NULL);
+
+	/**
+	\brief Copies the internal data of a set of articulations to their caches.
+	\param[in] articulations		Articulation handles. Each handle must appear only once.
+	\param[in] caches				One cache per articulation, created with PxCreateArticulationCache for that articulation.
+	\param[in] nbArticulations		Number of articulations
+	\param[in] flag				Indicates which values of the articulation systems are copied to the caches
+	\param[in] dispatcher			CPU dispatcher used to process the batch in parallel, or NULL to run on the calling thread.
+
+	@see PxCopyInternalStateToArticulationCache PxApplyArticulationCacheBatch
+	*/
+	PX_C_EXPORT PX_PHYSX_CORE_API void PxCopyInternalStateToArticulationCacheBatch(	const PxArticulationHandle* articulations, PxArticulationCache*const* caches, const PxU32 nbArticulations,
+																					PxArticulationCacheFlags flag, PxCpuDispatcher* dispatcher = NULL);
+
+	/**
+	\brief Applies the user defined data in a set of caches to their articulations.
+	\param[in] articulations		Articulation handles. Each handle must appear only once.
+	\param[in] caches				One cache per articulation, created with PxCreateArticulationCache for that articulation.
+	\param[in] nbArticulations		Number of articulations
+	\param[in] flag				Defines which values in the caches will be applied to the articulations
+	\param[in] dispatcher			CPU dispatcher used to process the batch in parallel, or NULL to run on the calling thread.
+
+	@see PxApplyArticulationCache PxCopyInternalStateToArticulationCacheBatch
+	*/
+	PX_C_EXPORT PX_PHYSX_CORE_API void PxApplyArticulationCacheBatch(	const PxArticulationHandle* articulations, PxArticulationCache*const* caches, const PxU32 nbArticulations,
+																		PxArticulationCacheFlags flag, PxCpuDispatcher* dispatcher = NULL);
+
 	/**
 	\brief Constructs a PxSolverBodyData structure based on rigid body properties. Applies gravity, damping and clamps maximum velocity.
 	\param	[in] inRigidData		The array rigid body properties
@@ -37,6 +37,7 @@
 #include "PxDeletionListener.h"
 #include "foundation/PxTransform.h"
 #include "PxShape.h"
+#include "geometry/PxBVHBuildStrategy.h"
 #include "PxAggregate.h"
 #include "PxBuffer.h"
 #include "PxParticleSystem.h"
@@ -57,6 +58,7 @@ class PxTolerancesScale;
 class PxPvd;
 class PxOmniPvd;
 class PxInsertionCallback;
+class PxCpuDispatcher;
 
 class PxRigidActor;
 class PxConstraintConnector;
@@ -482,12 +484,14 @@ public:
 	\note It is not allowed to pass in actors which are already part of a scene.
 	\note Articulation links cannot be provided.
 
-	\param	[in] actors		Array of actors to add to the pruning structure. Must be non NULL.
-	\param	[in] nbActors	Number of actors in the array. Must be >0.
+	\param	[in] actors			Array of actors to add to the pruning structure. Must be non NULL.
+	\param	[in] nbActors		Number of actors in the array. Must be >0.
+	\param	[in] buildStrategy	Build strategy of the static and dynamic trees of the pruning structure.
+	\param	[in] dispatcher		Optional dispatcher used to build the trees in parallel with PxBVHBuildStrategy::eBINNED_SAH. The build is serial if NULL.
 	\return Pruning structure created from given actors, or NULL if any of the actors did not comply with the above requirements.
-	@see PxActor PxPruningStructure
+	@see PxActor PxPruningStructure PxBVHBuildStrategy
 	*/
-	virtual PxPruningStructure* createPruningStructure(PxRigidActor*const* actors, PxU32 nbActors) = 0;
+	virtual PxPruningStructure* createPruningStructure(PxRigidActor*const* actors, PxU32 nbActors, PxBVHBuildStrategy::Enum buildStrategy = PxBVHBuildStrategy::eFAST, PxCpuDispatcher* dispatcher = NULL) = 0;
 
 	//@}
 	/** @name Shapes
@@ -34,6 +34,8 @@
 #include "foundation/PxVec3.h"
 #include "foundation/PxFlags.h"
 #include "foundation/PxAssert.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxSort.h"
 #include "geometry/PxGeometryHit.h"
 #include "geometry/PxGeometryQueryContext.h"
 #include "PxPhysXConfig.h"
@@ -146,6 +148,27 @@ struct PxHitCallback : PxQueryThreadContext
 	@see PxAgain PxRaycastHit PxSweepHit PxOverlapHit */
 	virtual PxAgain processTouches(const HitType* buffer, PxU32 nbHits) = 0;
 
+	/**
+	\brief	Optional callback used to grow the touch buffer instead of flushing it.
+
+	Called when the touch buffer is full and another touch hit needs to be stored. Callbacks that can provide more
+	memory should store the current #nbTouches hits, point #touches and #maxNbTouches to new free space, reset
+	#nbTouches to 0 and return true. The query then simply continues without issuing processTouches, and skips the
+	nested closest blocking hit search that is otherwise needed to flush a full buffer.
+
+	\param[in,out]	maxTouchDistance	Current maximum distance for touch hits. Can be reduced by the callback, in which
+										case touch hits further than the new value are discarded. The distance used to find
+										the blocking hit is not affected.
+
+	\note	Only used for raycasts and sweeps.
+	\note	When this returns true, touch hits are not guaranteed to be closer than the final blocking hit. They should be
+	\note	clipped against #block in finalizeQuery.
+
+	\return	true if the touch buffer has been grown, false to use the regular processTouches path.
+
+	@see processTouches PxHitArena */
+	virtual bool growTouches(PxReal& maxTouchDistance) { PX_UNUSED(maxTouchDistance); return false; }
+
 	virtual void finalizeQuery() {} //!< Query finalization callback, called after the last processTouches callback.
 
 	virtual ~PxHitCallback() {}
@@ -242,6 +265,151 @@ struct PxSweepBufferN : public PxHitBuffer<PxSweepHit>
 	PxSweepBufferN() : PxHitBuffer<PxSweepHit>(hits, N) {}
 };
 
+/**
+\brief	Returns all touching hits of a raycast or sweep query in an internally grown buffer, sorted by distance.
+
+Touch hits are accumulated in an internal array that grows on demand, so the query never has to be repeated or split
+into several processTouches callbacks when the number of hits is unknown. After the query, getTouches() returns the
+hits sorted by increasing distance, clipped against the blocking hit if any.
+
+An optional maximum number of hits can be given. Once the internal array holds more than that, it is sorted and
+truncated, and touch hits farther than the farthest kept hit are discarded as soon as they are found. This keeps
+memory bounded. The search for the blocking hit is not affected, so the query still traverses the full distance.
+
+Memory is kept between queries, so reusing the same object for many queries avoids repeated allocations.
+
+\note	Use PxQueryFlag::eNO_BLOCK (or a filter returning PxQueryHitType::eTOUCH) to get all hits reported as touches.
+\note	When a maximum number of hits is used, the returned blocking hit is the same as without a maximum, and can be
+\note	farther than the last kept touch.
+\note	Pre-made typedef shorthands ::PxRaycastArena and ::PxSweepArena can be used for raycast and sweep queries.
+\note	Overlap hits have no distance and should use a regular PxOverlapBuffer.
+
+@see PxHitBuffer PxHitCallback.growTouches PxRaycastArena PxSweepArena
+*/
+template<typename HitType>
+struct PxHitArena : public PxHitBuffer<HitType>
+{
+	/**
+	\brief	Initializes the arena.
+
+	\param[in] maxNbHits		Maximum number of touch hits returned by the query. The closest ones are kept.
+	\param[in] initialCapacity	Initial size of the internal buffer.
+	*/
+	PxHitArena(PxU32 maxNbHits = 0xffffffff, PxU32 initialCapacity = 32) : mNbStored(0), mMaxNbHits(maxNbHits)
+	{
+		PX_ASSERT(maxNbHits);
+		mStorage.resize(PxMax<PxU32>(initialCapacity, 4));
+		resetTouches();
+	}
+
+	virtual ~PxHitArena() {}
+
+	/** \brief Sets the maximum number of touch hits returned by the next queries. */
+	PX_INLINE void	setMaxNbHits(PxU32 maxNbHits)	{ PX_ASSERT(maxNbHits); mMaxNbHits = maxNbHits;	}
+	/** \brief Returns the maximum number of touch hits returned by the query. */
+	PX_INLINE PxU32	getMaxNbHits()	const			{ return mMaxNbHits;							}
+
+protected:
+	virtual PxAgain processTouches(const HitType* buffer, PxU32 nbHits)
+	{
+		// called for the remaining hits at the end of the query, or with a full buffer by systems not supporting growTouches
+		PX_ASSERT(buffer == mStorage.begin() + mNbStored);
+		PX_UNUSED(buffer);
+		mNbStored += nbHits;
+		if(mNbStored < mStorage.size() && mNbStored < mMaxNbHits)
+		{
+			this->touches = mStorage.begin() + mNbStored;
+			this->maxNbTouches = mStorage.size() - mNbStored;
+		}
+		else
+		{
+			PxReal maxDist = PX_MAX_F32;
+			flush(maxDist);
+		}
+		return true;
+	}
+
+	virtual bool growTouches(PxReal& maxTouchDistance)
+	{
+		mNbStored += this->nbTouches;
+		this->nbTouches = 0;
+		flush(maxTouchDistance);
+		return true;
+	}
+
+	virtual void finalizeQuery()
+	{
+		PxU32 nb = mNbStored + this->nbTouches;
+		HitType* hits = mStorage.begin();
+
+		// touches stored via growTouches have not been clipped against the final blocking hit
+		if(this->hasBlock)
+		{
+			const PxReal blockDist = this->block.distance;
+			PxU32 i = 0;
+			while(i < nb)
+			{
+				if(hits[i].distance > blockDist)
+					hits[i] = hits[--nb];
+				else
+					i++;
+			}
+		}
+
+		if(nb > 1)
+			PxSort(hits, nb, DistanceLess());
+
+		this->touches = hits;
+		this->nbTouches = PxMin(nb, mMaxNbHits);
+		this->maxNbTouches = mStorage.size();
+		mNbStored = 0;
+	}
+
+	struct DistanceLess
+	{
+		PX_FORCE_INLINE bool operator()(const HitType& a, const HitType& b) const { return a.distance < b.distance; }
+	};
+
+	// Moves the write window past the stored hits, growing the storage or truncating to the closest mMaxNbHits hits.
+	void flush(PxReal& maxTouchDistance)
+	{
+		if(mNbStored >= mMaxNbHits)
+		{
+			PxSort(mStorage.begin(), mNbStored, DistanceLess());
+			mNbStored = mMaxNbHits;
+			const PxReal farthest = mStorage[mNbStored - 1].distance;
+			if(farthest < maxTouchDistance)
+				maxTouchDistance = farthest;
+		}
+
+		// keep at least as much free space as stored hits, so that truncations and reallocations stay amortized
+		const PxU32 minSize = PxMax<PxU32>(mNbStored * 2, 4);
+		if(mStorage.size() < minSize)
+			mStorage.resize(minSize);
+
+		this->touches = mStorage.begin() + mNbStored;
+		this->maxNbTouches = mStorage.size() - mNbStored;
+	}
+
+	void resetTouches()
+	{
+		this->touches = mStorage.begin();
+		this->maxNbTouches = mStorage.size();
+	}
+
+	PxArray<HitType>	mStorage;		//!< Internal hit storage, kept between queries
+	PxU32				mNbStored;		//!< Number of hits stored in mStorage before the current write window
+	PxU32				mMaxNbHits;		//!< Maximum number of touch hits returned by the query
+
+	PX_NOCOPY(PxHitArena)
+};
+
+/** \brief Raycast query arena, returning all touching hits sorted by distance. */
+typedef PxHitArena<PxRaycastHit> PxRaycastArena;
+
+/** \brief Sweep query arena, returning all touching hits sorted by distance. */
+typedef PxHitArena<PxSweepHit> PxSweepArena;
+
 /**
 \brief single hit cache for scene queries.
 
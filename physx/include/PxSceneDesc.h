@@ -803,6 +803,23 @@ public:
 	*/
 	PxReal	wakeCounterResetValue;
 
+	/**
+	\brief Maximum number of sleeping bodies that moving kinematics may wake up per simulation step.
+
+	When a kinematic target is set, the islands touching the kinematic are woken up. Sweeping a kinematic through a
+	large sleeping pile can wake thousands of bodies in a single frame. With this budget, islands reached through a
+	kinematic are only woken while the budget lasts; the remaining islands are woken in subsequent steps, oldest
+	request first. At least one island is woken per step, and islands woken by dynamic bodies are never deferred.
+
+	\note Islands are woken as a whole, so the budget is only checked between islands.
+
+	<b>Range:</b> [1, PX_MAX_U32]<br>
+	<b>Default:</b> PX_MAX_U32 (no budget)
+
+	@see PxSimulationStatistics::nbDeferredIslandWakes
+	*/
+	PxU32	maxNbKinematicWakeNodesPerFrame;
+
 	/**
 	\brief The bounds used to sanity check user-set positions of actors and articulation links
 
@@ -949,6 +966,7 @@ PX_INLINE PxSceneDesc::PxSceneDesc(const PxTolerancesScale& scale):
 	ccdThreshold					(PX_MAX_F32),
 	ccdMaxSeparation				(0.04f * scale.length),
 	wakeCounterResetValue			(20.0f*0.02f),
+	maxNbKinematicWakeNodesPerFrame	(PX_MAX_U32),
 	sanityBounds					(PxBounds3(PxVec3(-PX_MAX_BOUNDS_EXTENTS), PxVec3(PX_MAX_BOUNDS_EXTENTS))),
 	gpuMaxNumPartitions				(8),
 	gpuMaxNumStaticPartitions		(16),
@@ -1008,6 +1026,9 @@ PX_INLINE bool PxSceneDesc::isValid() const
 	if(wakeCounterResetValue <= 0.0f)
 		return false;
 
+	if(!maxNbKinematicWakeNodesPerFrame)
+		return false;
+
 	if(!sanityBounds.isValid())
 		return false;
 
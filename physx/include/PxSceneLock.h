@@ -118,6 +118,60 @@ private:
 	PxScene& mScene;
 };
 
+/**
+\brief RAII wrapper for the PxScene read lock of worker threads running scene queries on behalf of another thread.
+
+With PxSceneFlag::eREQUIRE_RW_LOCK the read lock is tracked per thread, so a lock held by the thread dispatching the work
+does not cover its worker threads. Use isRequired() once on the dispatching thread, then lock the scene in each job as follows:
+
+	PxSceneWorkerReadLock lock(sceneRef, required);
+
+@see PxSceneReadLock, PxScene::lockRead(), PxScene::unlockRead(), PxSceneFlag::eREQUIRE_RW_LOCK
+*/
+class PxSceneWorkerReadLock
+{
+	PxSceneWorkerReadLock(const PxSceneWorkerReadLock&);
+	PxSceneWorkerReadLock& operator=(const PxSceneWorkerReadLock&);
+
+public:
+
+	/**
+	\brief Returns whether worker threads must lock the scene for reading, i.e. whether PxSceneFlag::eREQUIRE_RW_LOCK is set.
+
+	The scene flags are read under a read lock of the calling thread. Call this on the dispatching thread, not on the worker threads.
+
+	\param scene The scene queried by the worker threads
+	*/
+	static bool isRequired(PxScene& scene)
+	{
+		PxSceneReadLock lock(scene);
+		return scene.getFlags() & PxSceneFlag::eREQUIRE_RW_LOCK;
+	}
+
+	/**
+	\brief Constructor
+	\param scene The scene to lock for reading
+	\param required The value returned by isRequired(). The scene is not locked if false.
+	\param file Optional string for debugging purposes
+	\param line Optional line number for debugging purposes
+	*/
+	PxSceneWorkerReadLock(PxScene& scene, bool required, const char* file=NULL, PxU32 line=0)
+		: mScene(required ? &scene : NULL)
+	{
+		if(mScene)
+			mScene->lockRead(file, line);
+	}
+
+	~PxSceneWorkerReadLock()
+	{
+		if(mScene)
+			mScene->unlockRead();
+	}
+
+private:
+
+	PxScene* mScene;
+};
 
 #if !PX_DOXYGEN
 } // namespace physx
@@ -58,6 +58,12 @@ dynamic AABB tree, without the per-frame overhead. This can be a good choice for
 objects, if no static objects are added, moved or removed after the scene has been
 created. If there is no such guarantee (e.g. when streaming parts of the world in and out),
 then the dynamic version is a better choice even for static objects.
+
+eHASH_GRID stores objects in a loose multi-level hash grid. Adding, moving and removing objects
+are constant-time operations and there is no rebuild cost, which makes it a good choice for large
+numbers of small, fast-moving, uniformly distributed dynamic objects (projectiles, debris). Queries
+covering large areas, or long raycasts in sparse scenes, are slower than with a tree. The cell size
+is controlled by #PxSceneQueryDesc::hashGridCellSize.
 */
 struct PxPruningStructureType
 {
@@ -66,6 +72,7 @@ struct PxPruningStructureType
 		eNONE,					//!< Using a simple data structure
 		eDYNAMIC_AABB_TREE,		//!< Using a dynamic AABB tree
 		eSTATIC_AABB_TREE,		//!< Using a static AABB tree
+		eHASH_GRID,				//!< Using a loose multi-level hash grid
 
 		eLAST
 	};
@@ -193,6 +200,24 @@ public:
 	*/
 	PxU32	dynamicTreeRebuildRateHint;
 
+	/**
+	\brief Cell size of the smallest grid level for PxPruningStructureType::eHASH_GRID structures.
+
+	Each grid level doubles the cell size of the previous one, and objects are stored in the first level
+	whose cells are at least as large as the objects. Small cells mean more cells to visit per query, and
+	more objects changing cells each frame. A few times the size of the smallest objects stored in the
+	structure is usually a good value.
+
+	\note Only used when PxSceneQueryDesc::staticStructure or PxSceneQueryDesc::dynamicStructure is PxPruningStructureType::eHASH_GRID.
+	If both are, they share this cell size.
+
+	<b>Range:</b> (0, PX_MAX_F32)<br>
+	<b>Default:</b> 1.0
+
+	@see PxPruningStructureType
+	*/
+	PxReal	hashGridCellSize;
+
 	/**
 	\brief Secondary pruner for dynamic tree.
 
@@ -264,6 +289,32 @@ public:
 	*/
 	PxU32	dynamicNbObjectsPerNode;
 
+	/**
+	\brief Use a wide quantized tree layout for queries against PxSceneQueryDesc::staticStructure.
+
+	When enabled, the AABB tree is collapsed into 4-wide nodes with 16-bit quantized bounds, which are traversed with
+	SIMD tests on four children at a time. This reduces cache misses for raycasts, sweeps and overlaps in large scenes,
+	at the cost of some extra memory and of keeping the wide copy updated when the tree is rebuilt or refit.
+
+	This is only used with PxPruningStructureType::eDYNAMIC_AABB_TREE and PxPruningStructureType::eSTATIC_AABB_TREE.
+
+	<b>Default:</b> false
+
+	@see PxSceneQueryDesc::staticStructure
+	*/
+	bool	staticWideTree;
+
+	/**
+	\brief Use a wide quantized tree layout for queries against PxSceneQueryDesc::dynamicStructure.
+
+	See PxSceneQueryDesc::staticWideTree. Objects that are not in the tree yet (while it is being rebuilt) are not affected.
+
+	<b>Default:</b> false
+
+	@see PxSceneQueryDesc::dynamicStructure PxSceneQueryDesc::staticWideTree
+	*/
+	bool	dynamicWideTree;
+
 	/**
 	\brief Defines the scene query update mode.
 
@@ -295,11 +346,14 @@ PX_INLINE PxSceneQueryDesc::PxSceneQueryDesc():
 	staticStructure				(PxPruningStructureType::eDYNAMIC_AABB_TREE),
 	dynamicStructure			(PxPruningStructureType::eDYNAMIC_AABB_TREE),
 	dynamicTreeRebuildRateHint	(100),
+	hashGridCellSize			(1.0f),
 	dynamicTreeSecondaryPruner	(PxDynamicTreeSecondaryPruner::eINCREMENTAL),
 	staticBVHBuildStrategy		(PxBVHBuildStrategy::eFAST),
 	dynamicBVHBuildStrategy		(PxBVHBuildStrategy::eFAST),
 	staticNbObjectsPerNode		(4),
 	dynamicNbObjectsPerNode		(4),
+	staticWideTree				(false),
+	dynamicWideTree				(false),
 	sceneQueryUpdateMode		(PxSceneQueryUpdateMode::eBUILD_ENABLED_COMMIT_ENABLED)
 {
 }
@@ -317,6 +371,9 @@ PX_INLINE bool PxSceneQueryDesc::isValid() const
 	if(dynamicTreeRebuildRateHint < 4)
 		return false;
 
+	if(!(hashGridCellSize > 0.0f))
+		return false;
+
 	return true;
 }
 
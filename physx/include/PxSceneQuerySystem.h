@@ -67,6 +67,23 @@ namespace physx
 		PX_SCENE_COMPOUND_PRUNER	= 0xffffffff
 	};
 
+	/**
+	\brief Statistics about the refit of the dynamic trees, see PxSceneQuerySystemBase::getDynamicTreeRefitStats()
+
+	Updated bounds (e.g. the bounds of moving objects synced from the simulation) are taken into account by refitting the
+	dynamic trees when the updates are committed. Large batches of updates refit the whole tree at once, in parallel when
+	a CPU dispatcher is available, while smaller batches only refit the nodes above the updated objects.
+	*/
+	struct PxDynamicTreeRefitStats
+	{
+		PxDynamicTreeRefitStats() : nbUpdatedObjects(0), nbRefitNodes(0), nbBulkRefits(0), refitTime(0.0f)	{}
+
+		PxU32	nbUpdatedObjects;	//!< Number of objects updated before the refit
+		PxU32	nbRefitNodes;		//!< Number of tree nodes whose bounds have been recomputed
+		PxU32	nbBulkRefits;		//!< Number of trees fully refit at once, instead of partially
+		PxReal	refitTime;			//!< Time spent refitting the trees, in seconds
+	};
+
 	/**
 	\brief Base class for the scene-query system.
 
@@ -141,6 +158,23 @@ namespace physx
 		*/
 		virtual	PxU32	getStaticTimestamp()	const	= 0;
 
+		/**
+		\brief Retrieves statistics about the last refit of the dynamic trees.
+
+		This is the refit performed by the last commit of pending updates, e.g. the one following the bounds sync at the end
+		of a simulation step. If there are several dynamic trees, the statistics are accumulated over all of them.
+
+		The default implementation reports no refit, for custom scene query systems that do not track these statistics.
+
+		\param[out] stats	The refit statistics.
+
+		@see PxDynamicTreeRefitStats flushUpdates()
+		*/
+		virtual	void	getDynamicTreeRefitStats(PxDynamicTreeRefitStats& stats)	const
+		{
+			stats = PxDynamicTreeRefitStats();
+		}
+
 		/**
 		\brief Flushes any changes to the scene query representation.
 
@@ -529,6 +563,25 @@ namespace physx
 		*/
 		virtual	void	updateSQCompound(PxSQCompoundHandle compoundHandle, const PxTransform& compoundTransform)	= 0;
 
+		/**
+		\brief Updates a batch of compounds in the SQ system.
+
+		This is equivalent to calling updateSQCompound() for each compound, but lets implementations amortize the
+		update of their compound-level structures over the whole batch (e.g. refitting the compound tree once instead
+		of updating it per compound). The default implementation simply calls updateSQCompound() in a loop.
+
+		\param[in] compoundHandles		SQ compound handles (returned by addSQCompound)
+		\param[in] compoundTransforms	New actor/compound transforms, in world-space
+		\param[in] nbCompounds			Number of compounds to update
+
+		@see updateSQCompound
+		*/
+		virtual	void	updateSQCompounds(const PxSQCompoundHandle* compoundHandles, const PxTransform* compoundTransforms, PxU32 nbCompounds)
+		{
+			for(PxU32 i=0; i<nbCompounds; i++)
+				updateSQCompound(compoundHandles[i], compoundTransforms[i]);
+		}
+
 		/**
 		\brief Shift the data structures' origin by the specified vector.
 
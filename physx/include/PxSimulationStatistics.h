@@ -272,6 +272,18 @@ public:
 	*/
 	PxU32	nbPartitions;
 
+	/**
+	\brief Number of sleeping islands touched by kinematics whose wake-up was postponed to a later frame
+
+	@see PxSceneDesc::maxNbKinematicWakeNodesPerFrame
+	*/
+	PxU32	nbDeferredIslandWakes;
+
+	/**
+	\brief Number of bodies in the islands counted by nbDeferredIslandWakes
+	*/
+	PxU32	nbDeferredNodeWakes;
+
 	/**
 	\brief GPU device memory in bytes allocated for particle state accessible through API
 	*/
@@ -393,6 +405,8 @@ public:
 		nbNewTouches						(0),
 		nbLostTouches						(0),
 		nbPartitions						(0),
+		nbDeferredIslandWakes				(0),
+		nbDeferredNodeWakes					(0),
 		gpuMemParticles						(0),
 		gpuMemSoftBodies					(0),
 		gpuMemFEMCloths                     (0),
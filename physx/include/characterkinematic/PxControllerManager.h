@@ -48,6 +48,9 @@ class PxController;
 class PxControllerDesc;
 class PxObstacleContext;
 class PxControllerFilterCallback;
+class PxShape;
+class PxCpuDispatcher;
+class PxControllerFilters;
 
 /**
 \brief specifies debug-rendering flags
@@ -266,6 +269,51 @@ public:
 	*/
 	virtual	void				shiftOrigin(const PxVec3& shift) = 0;
 
+	/**
+	\brief Notifies the manager that a shape's data was modified in place.
+
+	Character controllers keep the geometry they touched from one move to the next, and triangles extracted from static meshes
+	and heightfields are shared between controllers. These caches are checked against the scene when static shapes are added,
+	removed, moved or given a new geometry, but modifications of the underlying mesh data itself (for example triangle mesh
+	vertices modified and refit in place) cannot be detected. Call this function after such a modification to discard all the
+	data cached for the shape.
+
+	\param[in] shape The modified shape.
+
+	@see PxController::invalidateCache()
+	*/
+	virtual	void				invalidateShapeCache(const PxShape& shape) = 0;
+
+	/**
+	\brief Depenetrates all characters from static objects and from each other, as a group.
+
+	The overlap recovery module resolves penetrations from within PxController::move(), one character at a time. When many characters
+	are spawned or teleported into a crowded area this becomes expensive, and characters pushed out of static objects may end up
+	overlapping each other. This function instead computes the minimum translational distance (MTD) of all characters at once, using
+	the current positions of all characters, and then moves them together. The process is repeated until no character overlaps anymore,
+	or until maxIterations passes have been performed.
+
+	Characters are pushed out of static and kinematic objects, following the same rules as the overlap recovery module (dynamic objects
+	are ignored). Overlapping characters are pushed apart along the plane orthogonal to their up direction, by half their penetration
+	depth each, like in computeInteractions().
+
+	Characters are moved with PxController::setPosition(), i.e. without sweeps. This function can be used whether the overlap recovery
+	module is enabled or not, and should not run concurrently with PxController::move() calls or scene writes.
+
+	\note When a dispatcher is provided the scene queries run on its worker threads, so the filter callback must be thread-safe.
+
+	\note If the scene has PxSceneFlag::eREQUIRE_RW_LOCK set, this function takes the scene locks it needs itself: each query job takes a
+	PxSceneWorkerReadLock, and a write lock is taken while the characters are moved. The calling thread must therefore not hold any scene lock.
+
+	\param[in] filters			Filters for the queries against static and kinematic objects, and CCT-vs-CCT filter callback.
+	\param[in] dispatcher		Dispatcher used to compute the penetrations in parallel. NULL to run on the calling thread.
+	\param[in] maxIterations	Maximum number of depenetration passes.
+	\return The number of characters that have been moved.
+
+	@see setOverlapRecoveryModule() computeInteractions() PxController::setPosition()
+	*/
+	virtual	PxU32				recoverFromOverlaps(const PxControllerFilters& filters, PxCpuDispatcher* dispatcher=NULL, PxU32 maxIterations=4) = 0;
+
 protected:
 	PxControllerManager() {}
 	virtual ~PxControllerManager() {}
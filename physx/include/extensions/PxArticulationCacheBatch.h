@@ -0,0 +1,192 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2023 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef PX_ARTICULATION_CACHE_BATCH_H
+#define PX_ARTICULATION_CACHE_BATCH_H
+/** \addtogroup extensions
+  @{
+*/
+
+#include "PxArticulationReducedCoordinate.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+class PxCpuDispatcher;
+
+/**
+\brief Contiguous tensors read or written by PxArticulationCacheBatch.
+
+Each pointer is either NULL or points to a user-owned buffer holding the data of all articulations in the batch,
+one row per articulation, in the order the articulations were passed to PxCreateArticulationCacheBatch:
+
+- jointVelocity, jointAcceleration, jointPosition, jointForce, jointSolverForces: N = getNbArticulations() * getDofStride().
+- linkVelocity, linkAcceleration: N = getNbArticulations() * getLinkStride().
+- rootLinkData: N = getNbArticulations().
+- sensorForces: N = getNbArticulations() * getSensorStride().
+
+Within a row, the data follows the regular PxArticulationCache indexing. Rows are padded to the stride, and the padding
+entries of articulations with fewer DOFs/links/sensors than the stride are never touched.
+
+Only the buffers matching the PxArticulationCacheFlags passed to PxArticulationCacheBatch::copyInternalStateToTensors and
+PxArticulationCacheBatch::applyTensors need to be set.
+
+@see PxArticulationCacheBatch PxArticulationCache
+*/
+struct PxArticulationCacheTensors
+{
+	PxArticulationCacheTensors() :
+		jointVelocity		(NULL),
+		jointAcceleration	(NULL),
+		jointPosition		(NULL),
+		jointForce			(NULL),
+		jointSolverForces	(NULL),
+		linkVelocity		(NULL),
+		linkAcceleration	(NULL),
+		rootLinkData		(NULL),
+		sensorForces		(NULL)
+	{}
+
+	PxReal*						jointVelocity;		//!< Joint DOF velocities, see PxArticulationCache::jointVelocity
+	PxReal*						jointAcceleration;	//!< Joint DOF accelerations, see PxArticulationCache::jointAcceleration
+	PxReal*						jointPosition;		//!< Joint DOF positions, see PxArticulationCache::jointPosition
+	PxReal*						jointForce;			//!< Joint DOF forces, see PxArticulationCache::jointForce
+	PxReal*						jointSolverForces;	//!< Solver constraint joint DOF forces, see PxArticulationCache::jointSolverForces
+	PxSpatialVelocity*			linkVelocity;		//!< Link spatial velocities, see PxArticulationCache::linkVelocity
+	PxSpatialVelocity*			linkAcceleration;	//!< Link classical accelerations, see PxArticulationCache::linkAcceleration
+	PxArticulationRootLinkData*	rootLinkData;		//!< Root link data, see PxArticulationCache::rootLinkData
+	PxSpatialForce*				sensorForces;		//!< Link sensor forces, see PxArticulationCache::sensorForces
+};
+
+/**
+\brief Gathers and scatters articulation cache data for many articulations in one call.
+
+This is the batched equivalent of PxArticulationReducedCoordinate::copyInternalStateToCache and
+PxArticulationReducedCoordinate::applyCache, typically used by reinforcement-learning style applications that simulate
+many copies of the same articulation and exchange their state with a training framework every step.
+
+The batch owns one PxArticulationCache per articulation, but the data is read from and written to the user tensors
+directly (see PxArticulationCacheTensors), i.e. there is no intermediate copy.
+
+- Gathers are split into chunks of articulations and run in parallel on the CPU dispatcher.
+- Scatters update scene-level data (wake state, shape poses) and therefore run on the calling thread.
+- The batch becomes invalid when the configuration of one of its articulations changes (see PxArticulationCache::version).
+It must then be released and re-created.
+- The usual PxArticulationCache rules apply: the articulations must be in a scene, and these functions cannot be called
+while the simulation is running. If PxSceneFlag::eREQUIRE_RW_LOCK is used, the user must hold the appropriate scene lock.
+
+@see PxCreateArticulationCacheBatch PxArticulationCacheTensors PxArticulationCache
+*/
+class PxArticulationCacheBatch
+{
+public:
+	/**
+	\brief Releases the batch and its internal caches.
+	*/
+	virtual	void		release()								= 0;
+
+	/**
+	\return The number of articulations in the batch.
+	*/
+	virtual	PxU32		getNbArticulations()			const	= 0;
+
+	/**
+	\return The articulation at the given index in the batch.
+	*/
+	virtual	PxArticulationReducedCoordinate*	getArticulation(PxU32 index)	const	= 0;
+
+	/**
+	\return The row size of the DOF tensors, i.e. the maximum number of DOFs over the articulations in the batch.
+	*/
+	virtual	PxU32		getDofStride()					const	= 0;
+
+	/**
+	\return The row size of the link tensors, i.e. the maximum number of links over the articulations in the batch.
+	*/
+	virtual	PxU32		getLinkStride()					const	= 0;
+
+	/**
+	\return The row size of the sensor tensor, i.e. the maximum number of sensors over the articulations in the batch.
+	*/
+	virtual	PxU32		getSensorStride()				const	= 0;
+
+	/**
+	\brief Copies the internal state of the articulations to the user tensors.
+
+	\param[out] tensors		Destination tensors. Buffers matching the flags must be set.
+	\param[in] flags		The data to copy, see PxArticulationReducedCoordinate::copyInternalStateToCache.
+	\param[in] indices		Optional indices of the articulations to process. NULL to process the whole batch.
+	\param[in] nbIndices	Number of indices, ignored if indices is NULL.
+
+	@see applyTensors
+	*/
+	virtual	void		copyInternalStateToTensors(const PxArticulationCacheTensors& tensors, PxArticulationCacheFlags flags, const PxU32* indices = NULL, PxU32 nbIndices = 0)	= 0;
+
+	/**
+	\brief Applies the user tensors to the articulations.
+
+	Passing indices is useful to e.g. only reset the environments that terminated during the last step.
+
+	\param[in] tensors		Source tensors. Buffers matching the flags must be set.
+	\param[in] flags		The data to apply, see PxArticulationReducedCoordinate::applyCache.
+	\param[in] autowake		If true, articulations are woken up if needed, see PxArticulationReducedCoordinate::applyCache.
+	\param[in] indices		Optional indices of the articulations to process. NULL to process the whole batch.
+	\param[in] nbIndices	Number of indices, ignored if indices is NULL.
+
+	@see copyInternalStateToTensors
+	*/
+	virtual	void		applyTensors(const PxArticulationCacheTensors& tensors, PxArticulationCacheFlags flags, bool autowake = true, const PxU32* indices = NULL, PxU32 nbIndices = 0)	= 0;
+
+protected:
+						PxArticulationCacheBatch()		{}
+	virtual				~PxArticulationCacheBatch()		{}
+};
+
+/**
+\brief Creates a batched articulation cache.
+
+\param[in] articulations	Articulations to batch. They must all be in a scene.
+\param[in] nbArticulations	Number of articulations.
+\param[in] dispatcher		CPU dispatcher used for parallel gathers. If NULL, the dispatcher of the first articulation's
+							scene is used. If that is NULL too, everything runs on the calling thread.
+\param[in] batchSize		Number of articulations processed by each task.
+
+\return The new batch, or NULL if the parameters were invalid.
+
+@see PxArticulationCacheBatch
+*/
+PxArticulationCacheBatch*	PxCreateArticulationCacheBatch(PxArticulationReducedCoordinate*const* articulations, PxU32 nbArticulations, PxCpuDispatcher* dispatcher = NULL, PxU32 batchSize = 64);
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+/** @} */
+#endif
@@ -0,0 +1,84 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2023 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef PX_BVH_EXT_H
+#define PX_BVH_EXT_H
+/** \addtogroup extensions
+  @{
+*/
+
+#include "geometry/PxBVH.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+class PxCpuDispatcher;
+
+/**
+\brief Utility functions for use with PxBVH.
+
+@see PxBVH
+*/
+class PxBVHExt
+{
+public:
+
+	/**
+	\brief Parallel version of PxBVH::cullFrusta().
+
+	The frusta are split in chunks of nbFrustaPerTask and each chunk is culled by one task, i.e. each task traverses the
+	BVH once for all the frusta in its chunk and writes to its own range of the output buffers. The calling thread takes
+	part in the work and the function returns when all frusta have been processed.
+
+	The parameters and results are the same as for PxBVH::cullFrusta().
+
+	\param[in] bvh						The BVH to cull.
+	\param[in] nbFrusta					Number of frusta.
+	\param[in] frusta					Array of frusta.
+	\param[in] maxNbIndicesPerFrustum	Capacity of each per-frustum index list.
+	\param[out] indices					Output buffer, must be able to hold nbFrusta*maxNbIndicesPerFrustum indices.
+	\param[out] nbIndices				Output buffer, receives the number of indices written for each frustum.
+	\param[in] dispatcher				CPU dispatcher running the tasks. If NULL, everything runs on the calling thread.
+	\param[in] nbFrustaPerTask			Number of frusta culled by each task. Values above 32 need more than one traversal per task.
+	\param[in] queryFlags				Optional flags controlling the query.
+	\return false if at least one of the per-frustum lists overflowed.
+
+	@see PxBVH::cullFrusta()
+	*/
+	static	bool	cullFrusta(	const PxBVH& bvh, PxU32 nbFrusta, const PxBVH::Frustum* frusta, PxU32 maxNbIndicesPerFrustum, PxU32* indices, PxU32* nbIndices,
+								PxCpuDispatcher* dispatcher, PxU32 nbFrustaPerTask = 32, PxGeometryQueryFlags queryFlags = PxGeometryQueryFlag::eDEFAULT);
+};
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+/** @} */
+#endif
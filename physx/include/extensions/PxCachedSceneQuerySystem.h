@@ -0,0 +1,197 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2023 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef PX_CACHED_SCENE_QUERY_SYSTEM_H
+#define PX_CACHED_SCENE_QUERY_SYSTEM_H
+/** \addtogroup extensions
+  @{
+*/
+
+#include "PxSceneQuerySystem.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+	/**
+	\brief Descriptor for PxCachedSceneQuerySystem.
+
+	@see PxCreateCachedSceneQuerySystem
+	*/
+	struct PxSceneQueryCacheDesc
+	{
+		PX_INLINE	PxSceneQueryCacheDesc() :
+			maxNbEntries			(1024),
+			maxNbHits				(16384),
+			regionSize				(8.0f),
+			nbRegionStamps			(4096),
+			maxNbRegionsPerQuery	(64),
+			cacheFilteredQueries	(false)
+		{
+		}
+
+		/**
+		\brief Maximum number of cached queries. The whole cache is flushed when this limit is reached.
+		*/
+		PxU32	maxNbEntries;
+
+		/**
+		\brief Maximum number of cached hits, over all cached queries. The whole cache is flushed when this limit is reached.
+		*/
+		PxU32	maxNbHits;
+
+		/**
+		\brief Size of the world-space regions used to track changes to the scene.
+
+		A change to an object only invalidates cached queries whose bounds touch the same regions. Smaller regions give more
+		accurate invalidations but make large queries and large objects more expensive to track.
+		*/
+		PxReal	regionSize;
+
+		/**
+		\brief Number of change stamps for the regions. Must be a power of two.
+
+		Regions are hashed to these stamps, collisions only result in extra invalidations.
+		*/
+		PxU32	nbRegionStamps;
+
+		/**
+		\brief Maximum number of regions touched by a query or an object.
+
+		Queries or objects touching more regions than this are tracked globally, i.e. any change to the scene invalidates such
+		queries, and any change to such objects invalidates all cached queries.
+		*/
+		PxU32	maxNbRegionsPerQuery;
+
+		/**
+		\brief Enables caching of queries using a filter callback.
+
+		By default queries using PxQueryFlag::ePREFILTER or PxQueryFlag::ePOSTFILTER with a filter callback are not cached,
+		since the callback's results can change from one call to the next. Set this to true if the callbacks are deterministic.
+		*/
+		bool	cacheFilteredQueries;
+
+		/**
+		\brief Returns true if the descriptor is valid.
+		*/
+		PX_INLINE	bool	isValid()	const
+		{
+			if(!maxNbEntries || !maxNbHits || !maxNbRegionsPerQuery)
+				return false;
+			if(!(regionSize > 0.0f))
+				return false;
+			if(!nbRegionStamps || (nbRegionStamps & (nbRegionStamps - 1)))
+				return false;
+			return true;
+		}
+	};
+
+	/**
+	\brief Statistics about the queries processed by PxCachedSceneQuerySystem.
+	*/
+	struct PxSceneQueryCacheStats
+	{
+		PxSceneQueryCacheStats() : nbCacheHits(0), nbCacheMisses(0), nbInvalidatedEntries(0), nbUncachedQueries(0)	{}
+
+		PxU32	nbCacheHits;			//!< Number of queries answered from the cache, without traversing the pruners
+		PxU32	nbCacheMisses;			//!< Number of cacheable queries not found in the cache
+		PxU32	nbInvalidatedEntries;	//!< Number of cache misses due to a change in the scene since the query was cached
+		PxU32	nbUncachedQueries;		//!< Number of queries bypassing the cache (unsupported geometry, filter callback, PxQueryCache...)
+	};
+
+	/**
+	\brief A scene query system caching the results of repeated queries.
+
+	This system wraps another PxSceneQuerySystem and forwards all calls to it. Raycast, sweep and overlap queries are
+	additionally cached, keyed by their full set of parameters (geometry, pose, direction, distance, flags and filter
+	data). When the same query is issued again and nothing changed in its vicinity, the cached results are directly
+	reported to the query's callback without traversing the pruners.
+
+	Cached entries are invalidated by:
+	- any change to the static timestamp of the wrapped system,
+	- any object added, updated or removed in the regions touched by the query's bounds,
+	- any change to an object returned by the query.
+
+	Touching hits returned from the cache might be ordered differently than the ones from the wrapped system.
+
+	\note Changes that are not visible to the scene query system, like shape query filter data or shape flags, are not
+	tracked. Call invalidateCache() after such changes.
+
+	@see PxCreateCachedSceneQuerySystem PxSceneQueryCacheDesc PxSceneDesc::sceneQuerySystem
+	*/
+	class PxCachedSceneQuerySystem : public PxSceneQuerySystem
+	{
+		public:
+				PxCachedSceneQuerySystem()	{}
+		virtual	~PxCachedSceneQuerySystem()	{}
+
+		/**
+		\brief Discards all cached queries.
+		*/
+		virtual	void	invalidateCache()	= 0;
+
+		/**
+		\brief Retrieves the cache statistics accumulated since the last call to resetCacheStats().
+
+		\param[out] stats	The cache statistics.
+
+		@see PxSceneQueryCacheStats resetCacheStats
+		*/
+		virtual	void	getCacheStats(PxSceneQueryCacheStats& stats)	const	= 0;
+
+		/**
+		\brief Resets the cache statistics.
+
+		@see getCacheStats
+		*/
+		virtual	void	resetCacheStats()	= 0;
+	};
+
+	/**
+	\brief Creates a cached scene query system.
+
+	The returned object wraps an existing scene query system, e.g. one returned by PxCreateExternalSceneQuerySystem. It can
+	be plugged to PxScene the same way, via PxSceneDesc::sceneQuerySystem. The wrapped system's reference count is
+	incremented, and decremented again when the cached system is released.
+
+	\param[in] system	The scene query system to wrap
+	\param[in] desc		Cache descriptor
+
+	\return	A cached SQ system instance, or NULL if the descriptor is invalid
+
+	@see PxCachedSceneQuerySystem PxSceneQueryCacheDesc PxCreateExternalSceneQuerySystem PxSceneDesc::sceneQuerySystem
+	*/
+	PxCachedSceneQuerySystem* PxCreateCachedSceneQuerySystem(PxSceneQuerySystem& system, const PxSceneQueryCacheDesc& desc = PxSceneQueryCacheDesc());
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+/** @} */
+#endif
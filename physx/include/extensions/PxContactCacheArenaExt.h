@@ -0,0 +1,155 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2023 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef PX_CONTACT_CACHE_ARENA_EXT_H
+#define PX_CONTACT_CACHE_ARENA_EXT_H
+/** \addtogroup extensions
+  @{
+*/
+
+#include "PxImmediateMode.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+/**
+\brief Persistent storage for the contact caches of immediate::PxGenerateContacts.
+
+The arena maps user-defined pair ids to PxCache objects and owns the memory the contact generation code allocates for
+them, so that persistent contact manifolds are kept from one frame to the next without a custom PxCacheAllocator.
+
+The cache data is double-buffered: during a frame, PxGenerateContacts reads the manifolds written during the previous
+frame and writes the new ones to the current buffer. Each thread gets its own allocator (see getAllocator()), which hands
+out memory from pages that are recycled every other frame, so there is no per-pair allocation or release. Pairs that
+have not been used during a frame are discarded at the beginning of the next one.
+
+Typical usage:
+
+- call beginFrame() once per frame,
+- call acquireCaches() on the calling thread for the pairs to process,
+- call immediate::PxGenerateContacts() with the returned caches, possibly from several threads, each thread using its own
+getAllocator(threadIndex). Every acquired cache must be passed to PxGenerateContacts during the frame.
+
+generateContacts() does the last two steps in one call on a single thread.
+
+@see PxCreateContactCacheArenaExt immediate::PxGenerateContacts
+*/
+class PxContactCacheArenaExt
+{
+public:
+	/**
+	\brief Releases the arena and all cached data.
+	*/
+	virtual	void				release()	= 0;
+
+	/**
+	\brief Starts a new frame.
+
+	Discards the pairs that have not been acquired during the previous frame, and recycles the memory of the frame before it.
+	*/
+	virtual	void				beginFrame()	= 0;
+
+	/**
+	\brief Retrieves the caches of a set of pairs, creating empty caches for new pairs.
+
+	The returned pointers remain valid until the next call to acquireCaches(), beginFrame() or reset(). This function is not
+	thread-safe.
+
+	\param[in] pairIds		Pair ids, e.g. combined indices of the two shapes. The same id must always refer to the same pair.
+	\param[in] nbPairs		Number of pairs
+	\param[out] caches		nbPairs cache pointers
+	*/
+	virtual	void				acquireCaches(const PxU64* pairIds, PxU32 nbPairs, PxCache** caches)	= 0;
+
+	/**
+	\brief Returns the cache allocator of a thread.
+
+	Each thread calling immediate::PxGenerateContacts concurrently must use a different allocator.
+
+	\param[in] threadIndex	Thread index, between 0 and getNbThreads()-1
+	\return The cache allocator for this thread
+	*/
+	virtual	PxCacheAllocator&	getAllocator(PxU32 threadIndex)	= 0;
+
+	/**
+	\brief Acquires the caches of a set of pairs and generates their contacts on the calling thread.
+
+	See immediate::PxGenerateContacts for the parameters. Allocations go through getAllocator(0).
+
+	\param[in] pairIds		Pair ids, see acquireCaches()
+	\return True on success
+	*/
+	virtual	bool				generateContacts(const PxU64* pairIds, const PxGeometry* const* geom0, const PxGeometry* const* geom1,
+												const PxTransform* pose0, const PxTransform* pose1, PxU32 nbPairs, immediate::PxContactRecorder& contactRecorder,
+												PxReal contactDistance, PxReal meshContactMargin, PxReal toleranceLength)	= 0;
+
+	/**
+	\brief Discards all pairs and cached data. The memory pages are kept for reuse.
+	*/
+	virtual	void				reset()	= 0;
+
+	/**
+	\return The number of threads the arena has been created for.
+	*/
+	virtual	PxU32				getNbThreads()	const	= 0;
+
+	/**
+	\return The number of pairs currently cached.
+	*/
+	virtual	PxU32				getNbPairs()	const	= 0;
+
+	/**
+	\return The total size of the memory pages owned by the arena, in bytes.
+	*/
+	virtual	PxU64				getNbAllocatedBytes()	const	= 0;
+
+protected:
+								PxContactCacheArenaExt()	{}
+	virtual						~PxContactCacheArenaExt()	{}
+};
+
+/**
+\brief Creates a contact cache arena.
+
+\param[in] nbThreads	Number of threads that can generate contacts concurrently, i.e. number of allocators
+\param[in] pageSize		Size of the memory pages, in bytes. Larger allocations get their own page.
+
+\return The new arena, or NULL if the parameters were invalid.
+
+@see PxContactCacheArenaExt
+*/
+PxContactCacheArenaExt*	PxCreateContactCacheArenaExt(PxU32 nbThreads = 1, PxU32 pageSize = 32 * 1024);
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+/** @} */
+#endif
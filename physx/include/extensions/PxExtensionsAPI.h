@@ -57,13 +57,19 @@
 #include "extensions/PxSimpleFactory.h"
 #include "extensions/PxStringTableExt.h"
 #include "extensions/PxBroadPhaseExt.h"
+#include "extensions/PxBVHExt.h"
 #include "extensions/PxMassProperties.h"
 #include "extensions/PxSceneQueryExt.h"
 #include "extensions/PxSceneQuerySystemExt.h"
 #include "extensions/PxCustomSceneQuerySystem.h"
+#include "extensions/PxCachedSceneQuerySystem.h"
+#include "extensions/PxVersionedSceneQuerySystem.h"
 #include "extensions/PxConvexMeshExt.h"
 #include "extensions/PxSamplingExt.h"
 #include "extensions/PxTetrahedronMeshExt.h"
+#include "extensions/PxArticulationCacheBatch.h"
+#include "extensions/PxImmediateStepperExt.h"
+#include "extensions/PxContactCacheArenaExt.h"
 
 /** \brief Initialize the PhysXExtensions library. 
 
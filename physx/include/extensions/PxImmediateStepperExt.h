@@ -0,0 +1,278 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2023 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef PX_IMMEDIATE_STEPPER_EXT_H
+#define PX_IMMEDIATE_STEPPER_EXT_H
+/** \addtogroup extensions
+  @{
+*/
+
+#include "PxImmediateMode.h"
+#include "PxBroadPhase.h"
+#include "foundation/PxArray.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+class PxCpuDispatcher;
+
+/**
+\brief Broadphase used by PxImmediateStepperExt.
+
+Implement this interface to plug a custom broadphase into the stepper. The default implementation, used when
+PxImmediateStepperDescExt::broadPhase is NULL, is built on a PxAABBManager.
+
+@see PxImmediateStepperExt PxImmediateStepperDescExt
+*/
+class PxImmediateBroadPhaseExt
+{
+public:
+	/**
+	\brief Finds the overlapping shape pairs.
+
+	Shapes are identified by their index in PxImmediateSceneDataExt. Overlaps must be ignored for pairs of shapes whose groups
+	would be filtered out by a PxBroadPhase, i.e. two static shapes, or two dynamic shapes of the same body.
+
+	\param[in] nbShapes		Number of shapes
+	\param[in] bounds		World-space bounds of each shape, already inflated by the contact distance
+	\param[in] groups		Filter group of each shape, PxGetBroadPhaseStaticFilterGroup() for static shapes and
+							PxGetBroadPhaseDynamicFilterGroup(bodyIndex) for dynamic shapes
+	\param[out] pairs		All currently overlapping pairs (not only the new ones). The array is cleared by the caller.
+	*/
+	virtual	void	findPairs(PxU32 nbShapes, const PxBounds3* bounds, const PxBpFilterGroup* groups, PxArray<PxBroadPhasePair>& pairs)	= 0;
+
+	/**
+	\brief Discards any internal state, e.g. after the shapes have been reordered.
+	*/
+	virtual	void	reset()	{}
+
+	virtual			~PxImmediateBroadPhaseExt()	{}
+};
+
+/**
+\brief Scene description passed to PxImmediateStepperExt::step(), as structures of arrays.
+
+Bodies are indexed from 0 to nbBodies-1. The first nbDynamicBodies are dynamic, the remaining ones are static. Body
+poses are center-of-mass frames, aligned with the principal axes of inertia, and shape poses are relative to them.
+
+The buffers are owned by the user. The poses and velocities of dynamic bodies are updated in place by step().
+
+\note Shape indices are used as persistent pair ids for contact caching. Call PxImmediateStepperExt::resetContactCaches()
+after shapes have been added, removed or reordered.
+
+@see PxImmediateStepperExt
+*/
+struct PxImmediateSceneDataExt
+{
+	PxImmediateSceneDataExt() :
+		nbBodies			(0),
+		nbDynamicBodies		(0),
+		bodyPoses			(NULL),
+		linearVelocities	(NULL),
+		angularVelocities	(NULL),
+		invMasses			(NULL),
+		invInertias			(NULL),
+		nbShapes			(0),
+		shapeGeometries		(NULL),
+		shapeLocalPoses		(NULL),
+		shapeBodies			(NULL),
+		shapeMaterials		(NULL),
+		nbJoints			(0),
+		jointConstraints	(NULL),
+		jointBodies0		(NULL),
+		jointBodies1		(NULL)
+	{}
+
+	PxU32						nbBodies;			//!< Total number of bodies
+	PxU32						nbDynamicBodies;	//!< Number of dynamic bodies, stored first
+	PxTransform*				bodyPoses;			//!< nbBodies poses. Updated for dynamic bodies.
+	PxVec3*						linearVelocities;	//!< nbDynamicBodies linear velocities. Updated.
+	PxVec3*						angularVelocities;	//!< nbDynamicBodies angular velocities. Updated.
+	const PxReal*				invMasses;			//!< nbDynamicBodies inverse masses
+	const PxVec3*				invInertias;		//!< nbDynamicBodies mass-space inverse inertias
+
+	PxU32						nbShapes;			//!< Number of shapes
+	const PxGeometry*const*		shapeGeometries;	//!< nbShapes geometries
+	const PxTransform*			shapeLocalPoses;	//!< nbShapes poses, relative to their body. NULL for identity poses.
+	const PxU32*				shapeBodies;		//!< nbShapes body indices
+	const PxVec3*				shapeMaterials;		//!< nbShapes (static friction, dynamic friction, restitution). NULL to use the descriptor's material.
+
+	PxU32						nbJoints;			//!< Number of joints
+	immediate::PxImmediateConstraint*	jointConstraints;	//!< nbJoints joint shaders
+	const PxU32*				jointBodies0;		//!< nbJoints first body indices, or 0xffffffff for the world frame
+	const PxU32*				jointBodies1;		//!< nbJoints second body indices, or 0xffffffff for the world frame
+};
+
+/**
+\brief Descriptor for PxImmediateStepperExt.
+
+@see PxCreateImmediateStepperExt
+*/
+struct PxImmediateStepperDescExt
+{
+	PxImmediateStepperDescExt()	{ setToDefault();	}
+
+	PX_INLINE void setToDefault()
+	{
+		gravity						= PxVec3(0.0f, -9.81f, 0.0f);
+		nbPositionIterations		= 4;
+		nbVelocityIterations		= 1;
+		useTGS						= true;
+		toleranceLength				= 1.0f;
+		contactDistance				= 0.04f;
+		meshContactMargin			= 0.01f;
+		bounceThreshold				= -2.0f;
+		frictionOffsetThreshold		= 0.04f;
+		correlationDistance			= 0.025f;
+		linearDamping				= 0.0f;
+		angularDamping				= 0.05f;
+		maxLinearVelocity			= 100.0f;
+		maxAngularVelocity			= 100.0f;
+		maxDepenetrationVelocity	= 5.0f;
+		defaultMaterial				= PxVec3(0.5f, 0.5f, 0.0f);
+		cpuDispatcher				= NULL;
+		broadPhase					= NULL;
+		minPairsPerTask				= 64;
+	}
+
+	PX_INLINE bool isValid() const
+	{
+		if(!gravity.isFinite() || !nbPositionIterations)
+			return false;
+		if(!(toleranceLength > 0.0f) || contactDistance < 0.0f || meshContactMargin < 0.0f || correlationDistance < 0.0f)
+			return false;
+		if(linearDamping < 0.0f || angularDamping < 0.0f || !(maxLinearVelocity > 0.0f) || !(maxAngularVelocity > 0.0f) || !(maxDepenetrationVelocity > 0.0f))
+			return false;
+		if(!defaultMaterial.isFinite() || !minPairsPerTask)
+			return false;
+		return true;
+	}
+
+	PxVec3						gravity;					//!< Gravity
+	PxU32						nbPositionIterations;		//!< Solver position iterations (sub-steps for TGS)
+	PxU32						nbVelocityIterations;		//!< Solver velocity iterations
+	bool						useTGS;						//!< Use the TGS solver, else PGS
+	PxReal						toleranceLength;			//!< PxTolerancesScale::length
+	PxReal						contactDistance;			//!< Contact distance, also used to inflate the shape bounds
+	PxReal						meshContactMargin;			//!< Mesh contact margin, see immediate::PxGenerateContacts
+	PxReal						bounceThreshold;			//!< See immediate::PxCreateContactConstraints
+	PxReal						frictionOffsetThreshold;	//!< See immediate::PxCreateContactConstraints
+	PxReal						correlationDistance;		//!< See immediate::PxCreateContactConstraints
+	PxReal						linearDamping;				//!< Linear damping of all dynamic bodies
+	PxReal						angularDamping;				//!< Angular damping of all dynamic bodies
+	PxReal						maxLinearVelocity;			//!< Maximum linear velocity of dynamic bodies
+	PxReal						maxAngularVelocity;			//!< Maximum angular velocity of dynamic bodies
+	PxReal						maxDepenetrationVelocity;	//!< Maximum depenetration velocity of dynamic bodies
+	PxVec3						defaultMaterial;			//!< (static friction, dynamic friction, restitution) used when PxImmediateSceneDataExt::shapeMaterials is NULL
+	PxCpuDispatcher*			cpuDispatcher;				//!< Dispatcher running the parallel stages. NULL to run everything on the calling thread.
+	PxImmediateBroadPhaseExt*	broadPhase;					//!< User broadphase, owned by the user. NULL to use the default one.
+	PxU32						minPairsPerTask;			//!< Minimum number of pairs per contact generation task
+};
+
+/**
+\brief Statistics of the last PxImmediateStepperExt::step() call.
+*/
+struct PxImmediateStepperStatsExt
+{
+	PxU32	nbBroadPhasePairs;		//!< Number of overlapping shape pairs found by the broadphase
+	PxU32	nbTouchingPairs;		//!< Number of shape pairs with contacts
+	PxU32	nbContacts;				//!< Total number of contacts
+	PxU32	nbIslands;				//!< Number of islands
+	PxU32	largestIsland;			//!< Number of dynamic bodies in the largest island
+};
+
+/**
+\brief Multithreaded stepper for the immediate mode API.
+
+This runs the full pipeline of a simulation step on user-provided arrays, like PxScene::simulate() would do for
+actors, so that custom simulation loops get similar throughput without re-implementing the scheduling:
+
+- shape bounds are computed in parallel, then passed to the broadphase (see PxImmediateBroadPhaseExt),
+- contact generation (immediate::PxGenerateContacts) runs in parallel over the broadphase pairs, with persistent contact
+and friction caches,
+- dynamic bodies are split into islands connected by contacts and joints,
+- islands are batched, prepared, solved and integrated independently, in parallel.
+
+The stepper owns the per-thread allocators for contact caches and constraint data. Cached data is kept for one step.
+
+@see PxCreateImmediateStepperExt PxImmediateSceneDataExt PxImmediateStepperDescExt
+*/
+class PxImmediateStepperExt
+{
+public:
+	/**
+	\brief Releases the stepper.
+	*/
+	virtual	void		release()	= 0;
+
+	/**
+	\brief Runs a simulation step.
+
+	\param[in,out] data		The scene to simulate. Dynamic body poses and velocities are updated.
+	\param[in] dt			Timestep
+
+	\return true on success, false if the data was invalid.
+	*/
+	virtual	bool		step(const PxImmediateSceneDataExt& data, PxReal dt)	= 0;
+
+	/**
+	\brief Discards persistent contact caches and the default broadphase state.
+
+	Call this when the shape indices change meaning, e.g. after shapes have been removed or reordered.
+	*/
+	virtual	void		resetContactCaches()	= 0;
+
+	/**
+	\return Statistics of the last step.
+	*/
+	virtual	const PxImmediateStepperStatsExt&	getStats()	const	= 0;
+
+protected:
+						PxImmediateStepperExt()		{}
+	virtual				~PxImmediateStepperExt()	{}
+};
+
+/**
+\brief Creates an immediate mode stepper.
+
+\param[in] desc		Stepper descriptor
+
+\return The new stepper, or NULL if the descriptor is invalid.
+
+@see PxImmediateStepperExt
+*/
+PxImmediateStepperExt*	PxCreateImmediateStepperExt(const PxImmediateStepperDescExt& desc);
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+/** @} */
+#endif
@@ -501,6 +501,94 @@ PxBatchQueryExt* PxCreateBatchQueryExt(
 	PxSweepBuffer* sweepBuffers, const PxU32 maxNbSweeps, PxSweepHit* sweepTouches, const PxU32 maxNbSweepTouches,
 	PxOverlapBuffer* overlapBuffers, const PxU32 maxNbOverlaps, PxOverlapHit* overlapTouches, const PxU32 maxNbOverlapTouches);
 
+/**
+\brief Batched sweep queries for many shapes against a scene.
+
+This is meant for large batches of sweeps, e.g. thousands of capsules swept by AI motion planners each frame. Instead
+of running each sweep through its own pruner traversal, execute():
+- sorts the sweeps by sweep geometry type and spatial locality (Morton order of the swept volumes),
+- groups nearby sweeps sharing the same filter data into clusters, and gathers the candidate shapes of a whole cluster
+with a single scene overlap query against the union of the swept volumes,
+- runs the narrow-phase sweep tests of a cluster sorted by candidate geometry type, so that each batch of tests
+uses the same sweep function,
+- spreads the clusters over the CPU dispatcher's worker threads.
+
+Results are reported like PxBatchQueryExt: each sweep() call returns a PxSweepBuffer whose contents become valid
+after execute(), see PxBatchQueryStatus. Touches are sorted by distance, and if they overflow the touch buffer the
+closest ones are kept.
+
+\note Filtering follows PxScene::sweep(): the filter data equation and PxQueryFlag::eSTATIC / eDYNAMIC are applied
+when gathering candidates, then the pre- and post-filters of the query filter callback are called per sweep and shape.
+Since the candidate shapes of a cluster are tested in a different order than in a pruner traversal, pre-filters can
+be called for shapes that a regular sweep would have culled.
+\note Meshes and heightfields report a single (closest) hit per shape, PxHitFlag::eMESH_MULTIPLE is ignored.
+\note The scene must not be modified while execute() runs.
+
+@see PxCreateBatchSweepQueryExt PxBatchQueryExt PxScene::sweep
+*/
+class PxBatchSweepQueryExt
+{
+public:
+
+	virtual void release() = 0;
+
+	/**
+	\brief Adds a sweep test to the batch.
+
+	\param[in] geometry		Geometry of object to sweep (supported types are: box, sphere, capsule, convex).
+	\param[in] pose			Pose of the sweep object.
+	\param[in] unitDir		Normalized direction of the sweep.
+	\param[in] distance		Sweep distance. Needs to be larger than 0. Will be clamped to PX_MAX_SWEEP_DISTANCE.
+	\param[in] maxNbTouches	Maximum number of hits to record in the touch buffer for this query. Default=0 reports a single blocking hit.
+	\param[in] hitFlags		Specifies which properties per hit should be computed and returned in hit array and blocking hit.
+	\param[in] filterData	Filtering data and simple logic. See #PxQueryFilterData #PxQueryFilterCallback
+	\param[in] inflation	Skin around the swept geometry, see PxScene::sweep().
+
+	\note This call is NOT thread safe.
+
+	\return Returns a PxSweepBuffer pointer that will store the result of the query after execute() is completed, or NULL
+	if the batch is full or the query is invalid.
+
+	@see PxScene::sweep PxBatchQueryStatus
+	*/
+	virtual PxSweepBuffer* sweep(
+		const PxGeometry& geometry, const PxTransform& pose, const PxVec3& unitDir, const PxReal distance,
+		const PxU16 maxNbTouches = 0,
+		PxHitFlags hitFlags = PxHitFlags(PxHitFlag::eDEFAULT),
+		const PxQueryFilterData& filterData = PxQueryFilterData(),
+		const PxReal inflation = 0.0f) = 0;
+
+	/**
+	\brief Runs all the sweeps added since the last call, and resets the batch.
+
+	\note If the scene has PxSceneFlag::eREQUIRE_RW_LOCK set, each task takes its own read lock with PxSceneWorkerReadLock.
+	The calling thread must therefore not hold a write lock on the scene.
+	*/
+	virtual void execute() = 0;
+
+protected:
+
+	virtual ~PxBatchSweepQueryExt() {}
+};
+
+/**
+\brief Create a PxBatchSweepQueryExt.
+
+\param[in] scene					Queries will be performed against objects in the specified PxScene
+\param[in] queryFilterCallback		Filtering for all queries is performed using queryFilterCallback. A null pointer results in all shapes being considered.
+\param[in] maxNbSweeps				Maximum number of sweep() calls per batch.
+\param[in] maxNbSweepTouches		A touch buffer will be allocated that is large enough to accommodate maxNbSweepTouches touches for all sweeps in the batch.
+\param[in] maxNbSweepsPerCluster	Maximum number of nearby sweeps sharing a candidate gathering query. 1 disables clustering.
+\param[in] cpuDispatcher			Dispatcher used to run the clusters in parallel. If NULL the scene's dispatcher is used.
+
+\return Returns a PxBatchSweepQueryExt instance, or NULL if the arguments are illegal or allocations fail.
+In the event that a NULL pointer is returned a corresponding error will be issued to the error stream.
+*/
+PxBatchSweepQueryExt* PxCreateBatchSweepQueryExt(
+	const PxScene& scene, PxQueryFilterCallback* queryFilterCallback,
+	const PxU32 maxNbSweeps, const PxU32 maxNbSweepTouches,
+	const PxU32 maxNbSweepsPerCluster = 16, PxCpuDispatcher* cpuDispatcher = NULL);
+
 #if !PX_DOXYGEN
 } // namespace physx
 #endif
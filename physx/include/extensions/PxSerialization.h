@@ -44,7 +44,7 @@
 PX_BINARY_SERIAL_VERSION is used to version the PhysX binary data and meta data. The global unique identifier of the PhysX SDK needs to match 
 the one in the data and meta data, otherwise they are considered incompatible. A 32 character wide GUID can be generated with https://www.guidgenerator.com/ for example. 
 */
-#define PX_BINARY_SERIAL_VERSION "0E16D844227B469DB23DA9C42CB4E624"
+#define PX_BINARY_SERIAL_VERSION "8C4BF595BA0049D2816C4E8256F62D32"
 
 
 #if !PX_DOXYGEN
@@ -0,0 +1,122 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2023 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef PX_VERSIONED_SCENE_QUERY_SYSTEM_H
+#define PX_VERSIONED_SCENE_QUERY_SYSTEM_H
+/** \addtogroup extensions
+  @{
+*/
+
+#include "PxSceneQuerySystem.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+	/**
+	\brief A scene query system with versioned pruners, letting queries run concurrently with updates.
+
+	This system maintains two copies of the pruning structures. Updates (added, removed and moved objects, bounds synced
+	from the simulation...) are applied to the back copy only, while queries always run against the published copy. When
+	the updates are committed, the back copy becomes the new published version with a single atomic swap, and the
+	updates are replayed on the previous version once the queries running against it have completed.
+
+	Updates are committed by flushUpdates() and, unless PxSceneQueryUpdateMode::eBUILD_ENABLED_COMMIT_DISABLED or
+	PxSceneQueryUpdateMode::eBUILD_DISABLED_COMMIT_DISABLED is used, by finalizeUpdates(). When used as a scene's query
+	system, this means a new version is published in PxScene::fetchResults(), after the bounds of moving objects have
+	been synced.
+
+	Queries never block and never see partially applied updates: they see the state of the scene as of the last published
+	version. Queries can be issued from any thread, at any time including during PxScene::simulate() and
+	PxScene::fetchResults(), by calling raycast(), sweep() and overlap() directly on this object rather than on PxScene,
+	which would take the scene's read lock when PxSceneFlag::eREQUIRE_RW_LOCK is set.
+
+	\note Removing objects, adding compounds and merging pruning structures immediately publish a new version and wait for
+	the queries running against the previous version to complete, since the removed objects, the BVH or the pruning
+	structure may be released by the caller as soon as the call returns.
+
+	\note Objects returned by a query are only guaranteed to be valid while no object can be released, i.e. the
+	usual rules for accessing PxShape and PxRigidActor objects from multiple threads still apply.
+
+	\note Both copies contain the same objects, i.e. memory usage and update costs are roughly twice the ones of a
+	regular scene query system.
+
+	@see PxCreateVersionedSceneQuerySystem PxSceneDesc::sceneQuerySystem
+	*/
+	class PxVersionedSceneQuerySystem : public PxSceneQuerySystem
+	{
+		public:
+				PxVersionedSceneQuerySystem()	{}
+		virtual	~PxVersionedSceneQuerySystem()	{}
+
+		/**
+		\brief Publishes pending updates, regardless of the update mode.
+
+		The calling thread blocks until the build steps running on the back version have completed, and then until the queries
+		running against the previous version have completed, before replaying the updates on it.
+
+		\note Must not be called concurrently with updates, e.g. during PxScene::fetchResults().
+
+		@see getVersion
+		*/
+		virtual	void	publish()	= 0;
+
+		/**
+		\brief Retrieves the number of versions published so far.
+
+		This can be called from query threads, e.g. to detect when a new version has been published.
+
+		\return The number of published versions.
+
+		@see publish
+		*/
+		virtual	PxU32	getVersion()	const	= 0;
+	};
+
+	/**
+	\brief Creates a scene query system with versioned pruners.
+
+	The pruners of both versions are created from the same descriptor, as with PxCreateExternalSceneQuerySystem. The
+	returned system can be plugged to PxScene via PxSceneDesc::sceneQuerySystem.
+
+	\param[in] desc			Scene query descriptor
+	\param[in] contextID	Context ID parameter, sent to the profiler
+
+	\return	A versioned SQ system instance, or NULL if the descriptor is invalid
+
+	@see PxVersionedSceneQuerySystem PxSceneQueryDesc PxCreateExternalSceneQuerySystem PxSceneDesc::sceneQuerySystem
+	*/
+	PxVersionedSceneQuerySystem* PxCreateVersionedSceneQuerySystem(const PxSceneQueryDesc& desc, PxU64 contextID);
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+/** @} */
+#endif
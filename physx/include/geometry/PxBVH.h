@@ -195,6 +195,42 @@ public:
 	*/
 	virtual	bool				cull(PxU32 nbPlanes, const PxPlane* planes, OverlapCallback& cb, PxGeometryQueryFlags queryFlags = PxGeometryQueryFlag::eDEFAULT) const = 0;
 
+	/**
+	\brief A frustum (or any convex volume defined by a set of planes) for #cullFrusta().
+	*/
+	struct Frustum
+	{
+		const PxPlane*	planes;		//!< Planes of the frustum, should be in the same space as the BVH.
+		PxU32			nbPlanes;	//!< Number of planes.
+	};
+
+	/**
+	\brief Batched frustum culling test against a BVH.
+
+	This is equivalent to calling #cull() once per frustum, but the BVH is traversed only once for all of them:
+	each visited node is tested against the frusta that can still see it, and subtrees fully inside a frustum are
+	collected for that frustum without further plane tests. This is useful when culling for many views at once
+	(e.g. shadow cascades, cube map faces, split-screen, portals).
+
+	The results are written to a user-provided buffer, as one compact index list per frustum. The list for frustum i
+	starts at indices + i*maxNbIndicesPerFrustum and nbIndices[i] receives the number of written indices. Like #cull(),
+	the returned indices are conservative.
+
+	This function is const and does not modify the BVH, so it can be called from multiple threads at the same time,
+	e.g. on disjoint subsets of the frusta. See PxBVHExt::cullFrusta() in the extensions library.
+
+	\param[in] nbFrusta				Number of frusta.
+	\param[in] frusta					Array of frusta.
+	\param[in] maxNbIndicesPerFrustum	Capacity of each per-frustum index list.
+	\param[out] indices				Output buffer, must be able to hold nbFrusta*maxNbIndicesPerFrustum indices.
+	\param[out] nbIndices				Output buffer, receives the number of indices written for each frustum.
+	\param[in] queryFlags				Optional flags controlling the query.
+	\return false if at least one of the per-frustum lists overflowed. Its results are then truncated.
+
+	@see cull()
+	*/
+	virtual	bool				cullFrusta(PxU32 nbFrusta, const Frustum* frusta, PxU32 maxNbIndicesPerFrustum, PxU32* indices, PxU32* nbIndices, PxGeometryQueryFlags queryFlags = PxGeometryQueryFlag::eDEFAULT) const = 0;
+
 	/**
 	\brief Returns the number of bounds in the BVH.
 
@@ -49,6 +49,7 @@ struct PxBVHBuildStrategy
 		eFAST = 0,		//!< Fast build strategy. Fast build speed, good runtime performance in most cases. Recommended for runtime cooking.
 		eDEFAULT = 1,	//!< Default build strategy. Medium build speed, good runtime performance in all cases.
 		eSAH = 2,		//!< SAH build strategy. Slower builds, slightly improved runtime performance in some cases.
+		eBINNED_SAH = 3,	//!< Binned SAH build strategy. Similar quality to eSAH with much faster builds, parallelized over the CPU dispatcher when one is available.
 
 		eLAST
 	};
@@ -504,6 +504,29 @@ namespace physx
 		const PxVehicleContext& context = PxVehicleGetDefaultContext());
 
 
+	/**
+	\brief Update an array of vehicles like PxVehicleUpdates, but with the vehicles processed in groups of the same vehicle type.
+
+	The vehicles array is not reordered.  Internally, vehicles are visited grouped by PxVehicleTypes (PxVehicleDrive4W first, 
+	then PxVehicleDriveNW, PxVehicleDriveTank and PxVehicleNoDrive), each group keeping the relative order of the vehicles array.  
+	This keeps a single update path hot in the instruction cache and avoids switching on the vehicle type for each vehicle, which
+	pays off for large arrays that mix vehicle types.  Results are written to vehicleWheelQueryResults[i] and vehicleConcurrentUpdates[i] 
+	for vehicles[i], exactly as with PxVehicleUpdates.
+
+	\note The parameters and their requirements are identical to PxVehicleUpdates.
+
+	\note Since the update order differs from PxVehicleUpdates, vehicles that interact with each other in the same call (e.g. a vehicle driving
+	on top of another one without vehicleConcurrentUpdates) can produce slightly different results.
+
+	@see PxVehicleUpdates, PxVehiclePostUpdates
+	*/
+	PX_DEPRECATED void PxVehicleUpdatesGrouped(
+		const PxReal timestep, const PxVec3& gravity, 
+		const PxVehicleDrivableSurfaceToTireFrictionPairs& vehicleDrivableSurfaceToTireFrictionPairs, 
+		const PxU32 nbVehicles, PxVehicleWheels** vehicles, PxVehicleWheelQueryResult* vehicleWheelQueryResults, PxVehicleConcurrentUpdateData* vehicleConcurrentUpdates = NULL,
+		const PxVehicleContext& context = PxVehicleGetDefaultContext());
+
+
 	/**
 	\brief Apply actor changes that were computed in concurrent calls to PxVehicleUpdates or PxVehicleUpdateSingleVehicleAndStoreTelemetryData but 
 	which could not be safely applied due to the concurrency.
@@ -39,6 +39,10 @@
 #include "vehicle2/PxVehicleFunctions.h"
 #include "vehicle2/PxVehicleMaths.h"
 
+#include "vehicle2/batch/PxVehicleBatchStates.h"
+#include "vehicle2/batch/PxVehicleBatchHelpers.h"
+#include "vehicle2/batch/PxVehicleBatchFunctions.h"
+
 #include "vehicle2/braking/PxVehicleBrakingParams.h"
 #include "vehicle2/braking/PxVehicleBrakingFunctions.h"
 
@@ -83,6 +87,11 @@
 #include "vehicle2/steering/PxVehicleSteeringParams.h"
 #include "vehicle2/steering/PxVehicleSteeringFunctions.h"
 
+#include "vehicle2/substep/PxVehicleSubstepParams.h"
+#include "vehicle2/substep/PxVehicleSubstepStates.h"
+#include "vehicle2/substep/PxVehicleSubstepFunctions.h"
+#include "vehicle2/substep/PxVehicleSubstepComponents.h"
+
 #include "vehicle2/suspension/PxVehicleSuspensionParams.h"
 #include "vehicle2/suspension/PxVehicleSuspensionStates.h"
 #include "vehicle2/suspension/PxVehicleSuspensionHelpers.h"
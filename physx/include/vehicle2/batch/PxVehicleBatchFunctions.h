@@ -0,0 +1,103 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2023 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#pragma once
+/** \addtogroup vehicle2
+  @{
+*/
+
+#include "foundation/PxSimpleTypes.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+class PxCpuDispatcher;
+
+namespace vehicle2
+{
+#endif
+
+struct PxVehicleWheelBatchState;
+
+/**
+\brief Compute the suspension force magnitude of a range of wheels in a batch.
+\param[in] startWheel is the first wheel of the range and must be a multiple of 4.
+\param[in] endWheel is one past the last wheel of the range.
+\param[in,out] batchState is the batch to update. The result is written to PxVehicleWheelBatchState::normalForce.
+\note This replicates PxVehicleSuspensionForceUpdate for four wheels at a time.
+*/
+void PxVehicleWheelBatchSuspensionForceUpdate
+(const PxU32 startWheel, const PxU32 endWheel, PxVehicleWheelBatchState& batchState);
+
+/**
+\brief Compute the tire slips, grip, sticky states and tire forces of a range of wheels in a batch.
+\param[in] dt is the timestep of the update.
+\param[in] startWheel is the first wheel of the range and must be a multiple of 4.
+\param[in] endWheel is one past the last wheel of the range.
+\param[in,out] batchState is the batch to update. 
+\note This replicates PxVehicleTireSlipsUpdate, PxVehicleTireGripUpdate, PxVehicleTireStickyStateUpdate, 
+PxVehicleTireSlipsAccountingForStickyStatesUpdate and PxVehicleTireForcesUpdate for four wheels at a time.
+\note The lateral slip uses a polynomial approximation of atan with a maximum error of about 1e-5 radians.
+*/
+void PxVehicleWheelBatchTireUpdate
+(const PxReal dt, const PxU32 startWheel, const PxU32 endWheel, PxVehicleWheelBatchState& batchState);
+
+/**
+\brief Forward integrate the rotation speed of a range of wheels in a batch given the brake and drive torques applied to them.
+\param[in] dt is the timestep of the update.
+\param[in] startWheel is the first wheel of the range and must be a multiple of 4.
+\param[in] endWheel is one past the last wheel of the range.
+\param[in,out] batchState is the batch to update. 
+\note This replicates PxVehicleDirectDriveUpdate for four wheels at a time.
+*/
+void PxVehicleWheelBatchDirectDriveUpdate
+(const PxReal dt, const PxU32 startWheel, const PxU32 endWheel, PxVehicleWheelBatchState& batchState);
+
+/**
+\brief Run the selected stages of the wheel update across all wheels of a batch.
+\param[in] dt is the timestep of the update.
+\param[in] stages is a combination of PxVehicleWheelBatchStages::Enum values.
+\param[in,out] batchState is the batch to update.
+\param[in] dispatcher is used to run ranges of wheels in parallel. If NULL the update is run on the calling thread.
+\param[in] nbWheelsPerTask is the number of wheels processed by each task and is rounded up to a multiple of 4.
+\note All stages of a wheel are run back to back in the same task so the data of the wheel stays in cache.
+\note The function returns once all tasks have completed.
+\note Vehicles with an engine drivetrain should omit PxVehicleWheelBatchStages::eDIRECT_DRIVE and run 
+PxVehicleEngineDrivetrainUpdate per vehicle with the tire forces read back by PxVehicleWheelBatchOutputsGet.
+@see PxVehicleWheelBatchStages
+*/
+void PxVehicleWheelBatchUpdate
+(const PxReal dt, const PxU32 stages, PxVehicleWheelBatchState& batchState,
+ PxCpuDispatcher* dispatcher, const PxU32 nbWheelsPerTask = 64);
+
+#if !PX_DOXYGEN
+} // namespace vehicle2
+} // namespace physx
+#endif
+
+/** @} */
@@ -0,0 +1,171 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2023 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#pragma once
+/** \addtogroup vehicle2
+  @{
+*/
+
+#include "foundation/PxSimpleTypes.h"
+#include "foundation/PxVec3.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+class PxAllocatorCallback;
+
+namespace vehicle2
+{
+#endif
+
+struct PxVehicleWheelBatchState;
+struct PxVehicleWheelParams;
+struct PxVehicleSuspensionParams;
+struct PxVehicleSuspensionForceParams;
+struct PxVehicleTireSlipParams;
+struct PxVehicleTireStickyParams;
+struct PxVehicleTireForceParams;
+struct PxVehicleRoadGeometryState;
+struct PxVehicleSuspensionState;
+struct PxVehicleSuspensionComplianceState;
+struct PxVehicleRigidBodyState;
+struct PxVehicleTireDirectionState;
+struct PxVehicleTireSpeedState;
+struct PxVehicleTireCamberAngleState;
+struct PxVehicleWheelActuationState;
+struct PxVehicleWheelRigidBody1dState;
+struct PxVehicleSuspensionForce;
+struct PxVehicleTireSlipState;
+struct PxVehicleTireGripState;
+struct PxVehicleTireStickyState;
+struct PxVehicleTireForce;
+
+/**
+\brief Create a PxVehicleWheelBatchState instance with room for a specified number of wheels.
+\param[in] maxNbWheels is the maximum number of wheels, summed over all vehicles, that will be stored in the batch.
+\param[in] allocator is used to allocate the memory of the batch as a single block.
+\return The created batch with all arrays set to zero and nbWheels set to zero.
+\note maxNbWheels is rounded up to the next multiple of 4.
+@see PxVehicleWheelBatchStateRelease
+*/
+PxVehicleWheelBatchState* PxVehicleWheelBatchStateCreate
+(const PxU32 maxNbWheels, PxAllocatorCallback& allocator);
+
+/**
+\brief Release a PxVehicleWheelBatchState instance created by PxVehicleWheelBatchStateCreate().
+\param[in] batchState is the batch to release.
+\param[in] allocator must be the instance used by PxVehicleWheelBatchStateCreate().
+@see PxVehicleWheelBatchStateCreate
+*/
+void PxVehicleWheelBatchStateRelease
+(PxVehicleWheelBatchState* batchState, PxAllocatorCallback& allocator);
+
+/**
+\brief Copy the parameters of a single wheel into a slot of a batch.
+\param[in] wheelParams describes the radius, moment of inertia and damping rate of the wheel.
+\param[in] suspForceParams describes the stiffness, damping and sprung mass of the suspension.
+\param[in] vehicleMass is the mass of the vehicle's rigid body.
+\param[in] tireSlipParams describes the denominators used in the tire slip computation.
+\param[in] tireStickyParams describes the thresholds of the tire sticky states.
+\param[in] tireForceParams describes the load filter, friction response and stiffnesses of the tire.
+\param[in] slot is the index of the wheel in the batch.
+\param[in,out] batchState is the batch to write to.
+\note This only needs to be called when the parameters of the wheel change.
+*/
+void PxVehicleWheelBatchParamsSet
+(const PxVehicleWheelParams& wheelParams, const PxVehicleSuspensionForceParams& suspForceParams, const PxReal vehicleMass,
+ const PxVehicleTireSlipParams& tireSlipParams, const PxVehicleTireStickyParams& tireStickyParams, 
+ const PxVehicleTireForceParams& tireForceParams,
+ const PxU32 slot, PxVehicleWheelBatchState& batchState);
+
+/**
+\brief Copy the per-update inputs of a single wheel into a slot of a batch.
+\param[in] suspParams describes the frame of the suspension.
+\param[in] roadGeomState describes the road geometry under the wheel.
+\param[in] suspState describes the jounce, jounce speed and separation of the suspension.
+\param[in] rigidBodyState describes the pose and the external force and torque of the vehicle's rigid body.
+\param[in] gravity is the gravitational acceleration.
+\param[in] vehicleMass is the mass of the vehicle's rigid body.
+\param[in] tireSpeedState describes the longitudinal and lateral speed at the tire contact point.
+\param[in] camberAngleState describes the camber angle of the tire.
+\param[in] actuationState is a binary record of whether brake and drive torque are applied to the wheel.
+\param[in] brakeTorque is the brake torque to be applied to the wheel.
+\param[in] driveTorque is the drive torque to be applied to the wheel.
+\param[in] isIntentionToAccelerate must be true if any wheel of the vehicle has a drive torque applied.
+\param[in] isIntentionToBrake must be true if any wheel of the vehicle has a brake torque applied.
+\param[in] wheelRigidBody1dState describes the rotation speed of the wheel.
+\param[in] tireStickyState describes the accumulated low speed times of the tire.
+\param[in] slot is the index of the wheel in the batch.
+\param[in,out] batchState is the batch to write to.
+\note The states are expected to have been computed with the existing per-vehicle functions, for example
+PxVehicleSuspensionStateUpdate, PxVehicleTireDirsUpdate, PxVehicleTireSlipSpeedsUpdate and PxVehicleTireCamberAnglesUpdate.
+\note The rotation speed and the low speed times only need to be copied if they were modified outside of the batch.
+@see PxVehicleWheelBatchUpdate
+*/
+void PxVehicleWheelBatchInputsSet
+(const PxVehicleSuspensionParams& suspParams,
+ const PxVehicleRoadGeometryState& roadGeomState, const PxVehicleSuspensionState& suspState,
+ const PxVehicleRigidBodyState& rigidBodyState, const PxVec3& gravity, const PxReal vehicleMass,
+ const PxVehicleTireSpeedState& tireSpeedState, const PxVehicleTireCamberAngleState& camberAngleState,
+ const PxVehicleWheelActuationState& actuationState, const PxReal brakeTorque, const PxReal driveTorque,
+ const bool isIntentionToAccelerate, const bool isIntentionToBrake,
+ const PxVehicleWheelRigidBody1dState& wheelRigidBody1dState, const PxVehicleTireStickyState& tireStickyState,
+ const PxU32 slot, PxVehicleWheelBatchState& batchState);
+
+/**
+\brief Read back the outputs of the batched update for a single wheel.
+\param[in] batchState is the batch to read from.
+\param[in] slot is the index of the wheel in the batch.
+\param[in] suspParams describes the frame of the suspension.
+\param[in] roadGeomState describes the road geometry under the wheel.
+\param[in] complianceState describes the suspension and tire force application points.
+\param[in] rigidBodyState describes the pose of the vehicle's rigid body.
+\param[in] tireDirectionState describes the longitudinal and lateral directions of the tire in the world frame.
+\param[out] suspForce is the force and torque to apply to the vehicle's rigid body from the suspension.
+\param[out] tireSlipState is the tire slip after accounting for the sticky states.
+\param[out] tireGripState is the load and friction of the tire.
+\param[out] tireStickyState is the sticky state of the tire.
+\param[out] tireForce is the force and torque to apply to the vehicle's rigid body from the tire.
+\param[out] wheelRigidBody1dState is the integrated rotation speed of the wheel.
+\note The force and torque vectors are reconstructed from the batched magnitudes in the same way as 
+PxVehicleSuspensionForceUpdate and PxVehicleTireForcesUpdate.
+*/
+void PxVehicleWheelBatchOutputsGet
+(const PxVehicleWheelBatchState& batchState, const PxU32 slot,
+ const PxVehicleSuspensionParams& suspParams,
+ const PxVehicleRoadGeometryState& roadGeomState, const PxVehicleSuspensionComplianceState& complianceState,
+ const PxVehicleRigidBodyState& rigidBodyState, const PxVehicleTireDirectionState& tireDirectionState,
+ PxVehicleSuspensionForce& suspForce, PxVehicleTireSlipState& tireSlipState, PxVehicleTireGripState& tireGripState,
+ PxVehicleTireStickyState& tireStickyState, PxVehicleTireForce& tireForce, PxVehicleWheelRigidBody1dState& wheelRigidBody1dState);
+
+#if !PX_DOXYGEN
+} // namespace vehicle2
+} // namespace physx
+#endif
+
+/** @} */
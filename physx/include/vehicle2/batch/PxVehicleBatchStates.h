@@ -0,0 +1,161 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2023 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#pragma once
+/** \addtogroup vehicle2
+  @{
+*/
+
+#include "foundation/PxSimpleTypes.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+namespace vehicle2
+{
+#endif
+
+/**
+\brief The stages of the wheel update that can be run across a PxVehicleWheelBatchState.
+@see PxVehicleWheelBatchUpdate
+*/
+struct PxVehicleWheelBatchStages
+{
+	enum Enum
+	{
+		eSUSPENSION_FORCE = (1 << 0),	//!< Compute the suspension force magnitude (see PxVehicleSuspensionForceUpdate).
+		eTIRE = (1 << 1),				//!< Compute tire slips, grip, sticky states and tire forces (see PxVehicleTireComponent).
+		eDIRECT_DRIVE = (1 << 2),		//!< Integrate the wheel rotation speed with a direct drive (see PxVehicleDirectDriveUpdate).
+		eALL = (eSUSPENSION_FORCE | eTIRE | eDIRECT_DRIVE)
+	};
+};
+
+/**
+\brief PxVehicleWheelBatchState stores the wheels of many vehicles as structure-of-arrays so that the
+suspension force, tire and direct drive stages of the wheel update can be run four wheels at a time.
+
+Each wheel of each vehicle occupies a single slot in the batch. Every array has room for maxNbWheels 
+entries, is 16-byte aligned and is padded so that the wheel count may be rounded up to a multiple of 4. 
+
+The arrays are grouped as follows:
+\li Parameters are written by PxVehicleWheelBatchParamsSet and only need to be rewritten when the parameters of a wheel change.
+\li Inputs are written each update by PxVehicleWheelBatchInputsSet from the per-vehicle states computed by the existing 
+road geometry, suspension state, tire direction, tire speed, tire camber and command response functions.
+\li Persistent states are read and written by the batched update.
+\li Outputs are written by the batched update and can be read back into the per-vehicle states with PxVehicleWheelBatchOutputsGet.
+
+Boolean quantities are stored as 0.0f (false) or 1.0f (true) so that they can be loaded straight into SIMD registers.
+
+\note Only the non-legacy suspension force and tire slip models are supported.
+@see PxVehicleWheelBatchStateCreate
+@see PxVehicleWheelBatchUpdate
+*/
+struct PxVehicleWheelBatchState
+{
+	PxU32 nbWheels;		//!< The number of wheel slots in use.
+	PxU32 maxNbWheels;	//!< The capacity of each array, always a multiple of 4.
+
+	//Parameters
+	PxReal* radius;							//!< PxVehicleWheelParams::radius
+	PxReal* moi;							//!< PxVehicleWheelParams::moi
+	PxReal* dampingRate;					//!< PxVehicleWheelParams::dampingRate
+	PxReal* suspStiffness;					//!< PxVehicleSuspensionForceParams::stiffness
+	PxReal* suspDamping;					//!< PxVehicleSuspensionForceParams::damping
+	PxReal* sprungMassRatio;				//!< PxVehicleSuspensionForceParams::sprungMass divided by the mass of the vehicle.
+	PxReal* restLoad;						//!< PxVehicleTireForceParams::restLoad
+	PxReal* loadFilterMinX;					//!< PxVehicleTireForceParams::loadFilter[0][0]
+	PxReal* loadFilterMinY;					//!< PxVehicleTireForceParams::loadFilter[0][1]
+	PxReal* loadFilterMaxX;					//!< PxVehicleTireForceParams::loadFilter[1][0]
+	PxReal* loadFilterMaxY;					//!< PxVehicleTireForceParams::loadFilter[1][1]
+	PxReal* frictionVsSlipX0;				//!< PxVehicleTireForceParams::frictionVsSlip[0][0]
+	PxReal* frictionVsSlipY0;				//!< PxVehicleTireForceParams::frictionVsSlip[0][1]
+	PxReal* frictionVsSlipX1;				//!< PxVehicleTireForceParams::frictionVsSlip[1][0]
+	PxReal* frictionVsSlipY1;				//!< PxVehicleTireForceParams::frictionVsSlip[1][1]
+	PxReal* frictionVsSlipX2;				//!< PxVehicleTireForceParams::frictionVsSlip[2][0]
+	PxReal* frictionVsSlipY2;				//!< PxVehicleTireForceParams::frictionVsSlip[2][1]
+	PxReal* latStiffX;						//!< PxVehicleTireForceParams::latStiffX
+	PxReal* latStiffY;						//!< PxVehicleTireForceParams::latStiffY
+	PxReal* longStiff;						//!< PxVehicleTireForceParams::longStiff
+	PxReal* camberStiff;					//!< PxVehicleTireForceParams::camberStiff
+	PxReal* minLatSlipDenominator;			//!< PxVehicleTireSlipParams::minLatSlipDenominator
+	PxReal* minPassiveLongSlipDenominator;	//!< PxVehicleTireSlipParams::minPassiveLongSlipDenominator
+	PxReal* minActiveLongSlipDenominator;	//!< PxVehicleTireSlipParams::minActiveLongSlipDenominator
+	PxReal* lngStickyThresholdSpeed;		//!< PxVehicleTireStickyParams::stickyParams[eLONGITUDINAL].thresholdSpeed
+	PxReal* lngStickyThresholdTime;			//!< PxVehicleTireStickyParams::stickyParams[eLONGITUDINAL].thresholdTime
+	PxReal* latStickyThresholdSpeed;		//!< PxVehicleTireStickyParams::stickyParams[eLATERAL].thresholdSpeed
+	PxReal* latStickyThresholdTime;			//!< PxVehicleTireStickyParams::stickyParams[eLATERAL].thresholdTime
+
+	//Inputs
+	PxReal* isOnGround;						//!< 1.0f if the road geometry query has a hit and the wheel touches the ground, 0.0f otherwise.
+	PxReal* jounce;							//!< PxVehicleSuspensionState::jounce
+	PxReal* jounceSpeed;					//!< PxVehicleSuspensionState::jounceSpeed
+	PxReal* suspDirX;						//!< The world frame suspension direction.
+	PxReal* suspDirY;
+	PxReal* suspDirZ;
+	PxReal* normalX;						//!< The world frame normal of the road geometry plane.
+	PxReal* normalY;
+	PxReal* normalZ;
+	PxReal* externalForceX;					//!< The linear and angular external forces acting on the suspension, including gravity.
+	PxReal* externalForceY;
+	PxReal* externalForceZ;
+	PxReal* roadFriction;					//!< PxVehicleRoadGeometryState::friction
+	PxReal* lngSpeed;						//!< PxVehicleTireSpeedState::speedStates[eLONGITUDINAL]
+	PxReal* latSpeed;						//!< PxVehicleTireSpeedState::speedStates[eLATERAL]
+	PxReal* camber;							//!< PxVehicleTireCamberAngleState::camberAngle
+	PxReal* brakeTorque;					//!< The brake torque applied to the wheel.
+	PxReal* driveTorque;					//!< The drive torque applied to the wheel.
+	PxReal* isBrakeApplied;					//!< PxVehicleWheelActuationState::isBrakeApplied
+	PxReal* isDriveApplied;					//!< PxVehicleWheelActuationState::isDriveApplied
+	PxReal* isIntentionToAccelerate;		//!< 1.0f if any wheel of the vehicle has a drive torque applied.
+	PxReal* isIntentionToBrake;				//!< 1.0f if any wheel of the vehicle has a brake torque applied.
+
+	//Persistent states
+	PxReal* rotationSpeed;					//!< PxVehicleWheelRigidBody1dState::rotationSpeed
+	PxReal* lngLowSpeedTime;				//!< PxVehicleTireStickyState::lowSpeedTime[eLONGITUDINAL]
+	PxReal* latLowSpeedTime;				//!< PxVehicleTireStickyState::lowSpeedTime[eLATERAL]
+
+	//Outputs
+	PxReal* normalForce;					//!< PxVehicleSuspensionForce::normalForce, also the magnitude of the suspension force along the road normal.
+	PxReal* lngSlip;						//!< PxVehicleTireSlipState::slips[eLONGITUDINAL] after accounting for sticky states.
+	PxReal* latSlip;						//!< PxVehicleTireSlipState::slips[eLATERAL] after accounting for sticky states.
+	PxReal* load;							//!< PxVehicleTireGripState::load
+	PxReal* friction;						//!< PxVehicleTireGripState::friction
+	PxReal* isLngStickyActive;				//!< PxVehicleTireStickyState::activeStatus[eLONGITUDINAL]
+	PxReal* isLatStickyActive;				//!< PxVehicleTireStickyState::activeStatus[eLATERAL]
+	PxReal* lngForce;						//!< The signed magnitude of the longitudinal tire force.
+	PxReal* latForce;						//!< The signed magnitude of the lateral tire force.
+	PxReal* aligningMoment;					//!< PxVehicleTireForce::aligningMoment
+	PxReal* wheelTorque;					//!< PxVehicleTireForce::wheelTorque
+};
+
+#if !PX_DOXYGEN
+} // namespace vehicle2
+} // namespace physx
+#endif
+
+/** @} */
@@ -39,6 +39,7 @@ namespace physx
 {
 class PxScene;
 class PxConvexMesh;
+class PxCpuDispatcher;
 
 namespace vehicle2
 {
@@ -48,6 +49,8 @@ struct PxVehicleWheelParams;
 struct PxVehicleSuspensionParams;
 struct PxVehiclePhysXRoadGeometryQueryParams;
 struct PxVehiclePhysXRoadGeometryQueryState;
+struct PxVehiclePhysXRoadGeometryQueryCacheParams;
+struct PxVehiclePhysXRoadGeometryQueryCacheState;
 struct PxVehiclePhysXMaterialFrictionParams;
 struct PxVehicleRigidBodyState;
 struct PxVehicleFrame;
@@ -82,6 +85,49 @@ void PxVehiclePhysXRoadGeometryQueryUpdate
  PxVehicleRoadGeometryState& roadGeomState,
  PxVehiclePhysXRoadGeometryQueryState* physxRoadGeometryState);
 
+/**
+\brief The inputs and outputs of the road geometry query of a single wheel processed by PxVehiclePhysXRoadGeometryQueryBatchUpdate().
+\note The members have the same meaning as the arguments of PxVehiclePhysXRoadGeometryQueryUpdate().
+@see PxVehiclePhysXRoadGeometryQueryBatchUpdate
+*/
+struct PxVehiclePhysXRoadGeometryQueryBatchEntry
+{
+	const PxVehicleWheelParams* wheelParams;
+	const PxVehicleSuspensionParams* suspParams;
+	const PxVehiclePhysXRoadGeometryQueryParams* roadGeomParams;
+	const PxVehiclePhysXMaterialFrictionParams* materialFrictionParams;
+	PxReal wheelYawAngle;
+	const PxVehicleRigidBodyState* rigidBodyState;
+	const PxVehicleFrame* frame;
+	PxVehicleRoadGeometryState* roadGeomState;
+	PxVehiclePhysXRoadGeometryQueryState* physxRoadGeometryState;	//!< Optional, set to NULL if not needed.
+	PxVehiclePhysXRoadGeometryQueryCacheState* cacheState;			//!< Optional, set to NULL to always issue a scene query for the wheel.
+};
+
+/**
+\brief Compute the plane of the road geometry and the tire friction under the wheels of many vehicles.
+\param[in,out] entries describes the road geometry query of each wheel. Wheels of different vehicles may be mixed freely.
+\param[in] nbEntries is the number of elements in the entries array.
+\param[in] cacheParams describes when the cached result of a previous scene query may be reused instead of issuing a new scene query.
+\param[in] scene is the PhysX scene that will be queried.
+\param[in] unitCylinderSweepMesh is a convex cylindrical mesh of unit radius and half-width to be used by sweep queries.
+\param[in] dispatcher is used to run ranges of entries in parallel. If NULL all queries are run on the calling thread.
+\param[in] nbEntriesPerTask is the number of entries processed by each task.
+\return The number of PhysX scene queries that were issued. Entries that reused a cached result do not issue a scene query.
+\note The result of each entry is identical to calling PxVehiclePhysXRoadGeometryQueryUpdate() unless a cached result is reused.
+\note Only results against static actors are cached. The caches must be reset with PxVehiclePhysXRoadGeometryQueryCacheState::setToDefault()
+if the static actors of the scene are moved, modified or released.
+\note The scene must not be modified while this function runs and any filter callback must be safe to call from multiple threads.
+\note If the scene has PxSceneFlag::eREQUIRE_RW_LOCK set, each task takes its own read lock with PxSceneWorkerReadLock. The calling thread
+must therefore not hold a write lock on the scene, or the tasks will block.
+@see PxVehiclePhysXRoadGeometryQueryUpdate
+*/
+PxU32 PxVehiclePhysXRoadGeometryQueryBatchUpdate
+(const PxVehiclePhysXRoadGeometryQueryBatchEntry* entries, const PxU32 nbEntries,
+ const PxVehiclePhysXRoadGeometryQueryCacheParams& cacheParams,
+ const PxScene& scene, const PxConvexMesh* unitCylinderSweepMesh,
+ PxCpuDispatcher* dispatcher, const PxU32 nbEntriesPerTask = 16);
+
 #if !PX_DOXYGEN
 } // namespace vehicle2
 } // namespace physx
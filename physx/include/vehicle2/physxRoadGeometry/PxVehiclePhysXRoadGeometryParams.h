@@ -33,6 +33,9 @@
 */
 
 #include "foundation/PxFoundation.h"
+#include "foundation/PxMath.h"
+
+#include "vehicle2/PxVehicleParams.h"
 
 #include "PxQueryFiltering.h"
 
@@ -156,6 +159,57 @@ struct PxVehiclePhysXMaterialFrictionParams
 	}
 };
 
+/**
+\brief Describes when the result of a previous road geometry query may be reused instead of issuing a new PhysX scene query.
+
+A result is only reused if the previous query hit a static actor, the start position of the query moved less than
+positionTolerance, the direction of the query changed by less than directionTolerance and the result was reused
+fewer than maxNbReuses times in a row.
+@see PxVehiclePhysXRoadGeometryQueryBatchUpdate
+@see PxVehiclePhysXRoadGeometryQueryCacheState
+*/
+struct PxVehiclePhysXRoadGeometryQueryCacheParams
+{
+	/**
+	\brief The maximum distance that the start position of the query may move while the previous result is reused.
+
+	<b>Range:</b> [0, inf)<br>
+	<b>Unit:</b> length
+	*/
+	PxReal positionTolerance;
+
+	/**
+	\brief The maximum angle between the current and the previous query direction while the previous result is reused.
+
+	<b>Range:</b> [0, pi/2)<br>
+	<b>Unit:</b> radians
+	*/
+	PxReal directionTolerance;
+
+	/**
+	\brief The maximum number of consecutive updates that may reuse the result of a scene query.
+	\note A value of 0 disables the reuse of scene query results.
+	*/
+	PxU32 maxNbReuses;
+
+	PX_FORCE_INLINE PxVehiclePhysXRoadGeometryQueryCacheParams transformAndScale(
+		const PxVehicleFrame& srcFrame, const PxVehicleFrame& trgFrame, const PxVehicleScale& srcScale, const PxVehicleScale& trgScale) const
+	{
+		PX_UNUSED(srcFrame);
+		PX_UNUSED(trgFrame);
+		PxVehiclePhysXRoadGeometryQueryCacheParams r = *this;
+		r.positionTolerance *= (trgScale.scale / srcScale.scale);
+		return r;
+	}
+
+	PX_FORCE_INLINE bool isValid() const
+	{
+		PX_CHECK_AND_RETURN_VAL(positionTolerance >= 0.0f, "PxVehiclePhysXRoadGeometryQueryCacheParams.positionTolerance must be greater than or equal to zero", false);
+		PX_CHECK_AND_RETURN_VAL(directionTolerance >= 0.0f && directionTolerance < PxPiDivTwo, "PxVehiclePhysXRoadGeometryQueryCacheParams.directionTolerance must be in range [0, pi/2)", false);
+		return true;
+	}
+};
+
 #if !PX_DOXYGEN
 } // namespace vehicle2
 } // namespace physx
@@ -35,6 +35,8 @@
 #include "foundation/PxMemory.h"
 #include "foundation/PxVec3.h"
 
+#include "vehicle2/roadGeometry/PxVehicleRoadGeometryState.h"
+
 #if !PX_DOXYGEN
 namespace physx
 {
@@ -60,6 +62,26 @@ struct PxVehiclePhysXRoadGeometryQueryState
 	}
 };
 
+/**
+\brief The result of the last PhysX scene query of a wheel, kept so that it can be reused by later updates.
+@see PxVehiclePhysXRoadGeometryQueryCacheParams
+@see PxVehiclePhysXRoadGeometryQueryBatchUpdate
+*/
+struct PxVehiclePhysXRoadGeometryQueryCacheState
+{
+	PxVehicleRoadGeometryState roadGeomState;								//!< The road geometry state computed from the last scene query.
+	PxVehiclePhysXRoadGeometryQueryState physxRoadGeometryState;			//!< The actor, shape and material hit by the last scene query.
+	PxVec3 queryOrigin;														//!< The start position of the last scene query.
+	PxVec3 queryDir;														//!< The direction of the last scene query.
+	PxU32 nbReuses;															//!< The number of consecutive updates that reused the last scene query.
+	bool isValid;															//!< True if the last scene query hit a static actor and may be reused.
+
+	PX_FORCE_INLINE void setToDefault()
+	{
+		PxMemZero(this, sizeof(PxVehiclePhysXRoadGeometryQueryCacheState));
+	}
+};
+
 #if !PX_DOXYGEN
 } // namespace vehicle2
 } // namespace physx
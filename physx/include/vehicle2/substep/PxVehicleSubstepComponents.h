@@ -0,0 +1,126 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2023 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#pragma once
+
+/** \addtogroup vehicle2
+  @{
+*/
+#include "vehicle2/PxVehicleParams.h"
+#include "vehicle2/PxVehicleComponent.h"
+#include "vehicle2/PxVehicleComponentSequence.h"
+
+#include "PxVehicleSubstepFunctions.h"
+
+#include "common/PxProfileZone.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+namespace vehicle2
+{
+#endif
+
+/**
+\brief Pick the number of substeps of a substep group of the vehicle's component sequence for the current update.
+
+The component must be added to the sequence before the substep group that it controls, outside of it. Components that do not
+benefit from substepping, such as road geometry queries and PVD recording, should be kept outside of the group as well, so
+that only the suspension, tire, drivetrain, constraint and rigid body components run once per substep.
+
+@see PxVehicleSubstepCountUpdate
+*/
+class PxVehicleSubstepComponent : public PxVehicleComponent
+{
+public:
+
+	PxVehicleSubstepComponent() : PxVehicleComponent() {}
+	virtual ~PxVehicleSubstepComponent() {}
+
+	/**
+	\brief Retrieve pointers to the parameter and state data required to pick the number of substeps.
+	\param[out] axleDescription must be returned as a non-null pointer to a single PxVehicleAxleDescription instance that describes the wheels and axles
+	of the vehicle.
+	\param[out] substepParams must be returned as a non-null pointer to a single PxVehicleSubstepParams instance.
+	\param[out] suspensionForceParams must be returned as a non-null pointer to an array of suspension stiffnesses and sprung masses, one for each wheel.
+	\param[out] rigidBodyState must be returned as a non-null pointer to a single PxVehicleRigidBodyState instance.
+	\param[out] commands may be returned as a null pointer or a pointer to the command state of the vehicle.
+	\param[out] engineParams may be returned as a null pointer, or a pointer to the engine parameters if engineState is non-null.
+	\param[out] engineState may be returned as a null pointer, for example for vehicles without an engine.
+	\param[out] substepState must be returned as a non-null pointer to a single PxVehicleSubstepState instance.
+	\param[out] componentSequence must be returned as a non-null pointer to the sequence that owns the substep group.
+	\param[out] substepGroupHandle must be returned as the handle of the substep group, as returned by PxVehicleComponentSequence::beginSubstepGroup().
+	*/
+	virtual void getDataForSubstepComponent(
+		const PxVehicleAxleDescription*& axleDescription,
+		const PxVehicleSubstepParams*& substepParams,
+		PxVehicleArrayData<const PxVehicleSuspensionForceParams>& suspensionForceParams,
+		const PxVehicleRigidBodyState*& rigidBodyState,
+		const PxVehicleCommandState*& commands,
+		const PxVehicleEngineParams*& engineParams,
+		const PxVehicleEngineState*& engineState,
+		PxVehicleSubstepState*& substepState,
+		PxVehicleComponentSequence*& componentSequence,
+		PxU8& substepGroupHandle) = 0;
+
+	virtual bool update(const PxReal dt, const PxVehicleSimulationContext& context)
+	{
+		PX_PROFILE_ZONE("PxVehicleSubstepComponent::update", 0);
+
+		const PxVehicleAxleDescription* axleDescription;
+		const PxVehicleSubstepParams* substepParams;
+		PxVehicleArrayData<const PxVehicleSuspensionForceParams> suspensionForceParams;
+		const PxVehicleRigidBodyState* rigidBodyState;
+		const PxVehicleCommandState* commands;
+		const PxVehicleEngineParams* engineParams;
+		const PxVehicleEngineState* engineState;
+		PxVehicleSubstepState* substepState;
+		PxVehicleComponentSequence* componentSequence;
+		PxU8 substepGroupHandle;
+
+		getDataForSubstepComponent(axleDescription, substepParams, suspensionForceParams, rigidBodyState,
+			commands, engineParams, engineState, substepState, componentSequence, substepGroupHandle);
+
+		const PxU8 nbSubsteps = PxVehicleSubstepCountUpdate(
+			*axleDescription, *substepParams, suspensionForceParams, *rigidBodyState,
+			commands, engineParams, engineState,
+			dt, context.frame,
+			*substepState);
+
+		componentSequence->setSubsteps(substepGroupHandle, nbSubsteps);
+
+		return true;
+	}
+};
+
+#if !PX_DOXYGEN
+} // namespace vehicle2
+} // namespace physx
+#endif
+
+/** @} */
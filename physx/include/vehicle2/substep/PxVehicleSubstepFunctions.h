@@ -0,0 +1,86 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2023 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#pragma once
+
+/** \addtogroup vehicle2
+  @{
+*/
+
+#include "foundation/PxSimpleTypes.h"
+#include "vehicle2/PxVehicleParams.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+namespace vehicle2
+{
+#endif
+
+struct PxVehicleSubstepParams;
+struct PxVehicleSubstepState;
+struct PxVehicleSuspensionForceParams;
+struct PxVehicleRigidBodyState;
+struct PxVehicleCommandState;
+struct PxVehicleEngineParams;
+struct PxVehicleEngineState;
+
+/**
+\brief Pick the number of substeps of a vehicle for the next update from its speed, suspension stiffness and engine state.
+\param[in] axleDescription is a description of the axles of the vehicle and the wheels on each axle.
+\param[in] substepParams describes how the number of substeps is picked.
+\param[in] suspensionForceParams is an array of suspension stiffnesses and sprung masses, one for each wheel.
+\param[in] rigidBodyState is the current state of the vehicle's rigid body.
+\param[in] commands is an optional pointer to the brake, throttle and steer commands of the vehicle. A vehicle with 
+a non-zero throttle is never considered at rest.
+\param[in] engineParams is an optional pointer to the engine parameters. Must be non-null if engineState is non-null.
+\param[in] engineState is an optional pointer to the engine state. A vehicle whose engine turns faster than the idle speed plus
+PxVehicleSubstepParams::engineIdleTolerance is never considered at rest.
+\param[in] dt is the timestep of the upcoming update.
+\param[in] frame describes the longitudinal, lateral and vertical axes of the vehicle.
+\param[in,out] substepState records the picked number of substeps and the substeps saved relative to PxVehicleSubstepParams::maxNbSubsteps.
+\return The number of substeps, in range [PxVehicleSubstepParams::minNbSubsteps, PxVehicleSubstepParams::maxNbSubsteps].
+\note The returned value is typically passed to PxVehicleComponentSequence::setSubsteps() for the substep group that holds the 
+suspension, tire, drivetrain and rigid body components. Road geometry queries and PVD recording are better placed outside that
+group so that they run once per update.
+@see PxVehicleSubstepComponent
+*/
+PxU8 PxVehicleSubstepCountUpdate
+	(const PxVehicleAxleDescription& axleDescription, const PxVehicleSubstepParams& substepParams,
+	 const PxVehicleArrayData<const PxVehicleSuspensionForceParams>& suspensionForceParams,
+	 const PxVehicleRigidBodyState& rigidBodyState, const PxVehicleCommandState* commands,
+	 const PxVehicleEngineParams* engineParams, const PxVehicleEngineState* engineState,
+	 const PxReal dt, const PxVehicleFrame& frame,
+	 PxVehicleSubstepState& substepState);
+
+#if !PX_DOXYGEN
+} // namespace vehicle2
+} // namespace physx
+#endif
+
+/** @} */
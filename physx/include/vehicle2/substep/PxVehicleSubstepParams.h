@@ -0,0 +1,155 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2023 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#pragma once
+
+/** \addtogroup vehicle2
+  @{
+*/
+
+#include "foundation/PxFoundation.h"
+#include "vehicle2/PxVehicleParams.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+namespace vehicle2
+{
+#endif
+
+/**
+\brief Parameters used to pick the number of substeps of a vehicle for each update.
+
+The number of substeps is the smallest number that satisfies all of the following, clamped to [minNbSubsteps, maxNbSubsteps]:
+- The suspension spring of each wheel advances by at most maxSuspensionPhasePerSubstep per substep.
+- The vehicle travels at most maxTravelPerSubstep per substep.
+- lowSpeedNbSubsteps substeps are used when the longitudinal speed is below lowSpeed, where tire slips are most sensitive to the timestep.
+
+A vehicle at rest only keeps the suspension requirement, which lets parked vehicles run with the minimum number of substeps.
+A vehicle is at rest when its speed is below restSpeed, the throttle is released and the engine (if any) turns at no more than
+engineIdleTolerance above the idle speed.
+
+@see PxVehicleSubstepCountUpdate
+*/
+struct PxVehicleSubstepParams
+{
+	/**
+	\brief The minimum number of substeps.
+
+	<b>Range:</b> [1, maxNbSubsteps]<br>
+	*/
+	PxU8 minNbSubsteps;
+
+	/**
+	\brief The maximum number of substeps.
+
+	<b>Range:</b> [minNbSubsteps, 255]<br>
+	*/
+	PxU8 maxNbSubsteps;
+
+	/**
+	\brief The number of substeps used below lowSpeed, unless the vehicle is at rest.
+
+	<b>Range:</b> [1, 255]<br>
+	*/
+	PxU8 lowSpeedNbSubsteps;
+
+	/**
+	\brief The longitudinal speed below which lowSpeedNbSubsteps substeps are used.
+
+	<b>Range:</b> [0, inf)<br>
+	<b>Unit:</b> length / time
+	*/
+	PxReal lowSpeed;
+
+	/**
+	\brief The speed below which the vehicle may be considered at rest.
+
+	<b>Range:</b> [0, inf)<br>
+	<b>Unit:</b> length / time
+	*/
+	PxReal restSpeed;
+
+	/**
+	\brief The maximum distance travelled by the vehicle during a single substep.
+
+	<b>Range:</b> (0, inf)<br>
+	<b>Unit:</b> length
+	*/
+	PxReal maxTravelPerSubstep;
+
+	/**
+	\brief The maximum phase advance of the suspension springs during a single substep, i.e. the substep multiplied by the 
+	natural frequency sqrt(stiffness/sprungMass) of the stiffest suspension.
+
+	<b>Range:</b> (0, inf)<br>
+	<b>Unit:</b> radians
+	*/
+	PxReal maxSuspensionPhasePerSubstep;
+
+	/**
+	\brief The engine rotation speed above the idle speed up to which the vehicle may be considered at rest.
+
+	<b>Range:</b> [0, inf)<br>
+	<b>Unit:</b> radians / time
+	*/
+	PxReal engineIdleTolerance;
+
+	PX_FORCE_INLINE PxVehicleSubstepParams transformAndScale(
+		const PxVehicleFrame& srcFrame, const PxVehicleFrame& trgFrame, const PxVehicleScale& srcScale, const PxVehicleScale& trgScale) const
+	{
+		PX_UNUSED(srcFrame);
+		PX_UNUSED(trgFrame);
+		PxVehicleSubstepParams r = *this;
+		const PxReal scale = trgScale.scale / srcScale.scale;
+		r.lowSpeed *= scale;
+		r.restSpeed *= scale;
+		r.maxTravelPerSubstep *= scale;
+		return r;
+	}
+
+	PX_FORCE_INLINE bool isValid() const
+	{
+		PX_CHECK_AND_RETURN_VAL(minNbSubsteps > 0, "PxVehicleSubstepParams.minNbSubsteps must be greater than zero", false);
+		PX_CHECK_AND_RETURN_VAL(maxNbSubsteps >= minNbSubsteps, "PxVehicleSubstepParams.maxNbSubsteps must be greater than or equal to minNbSubsteps", false);
+		PX_CHECK_AND_RETURN_VAL(lowSpeedNbSubsteps > 0, "PxVehicleSubstepParams.lowSpeedNbSubsteps must be greater than zero", false);
+		PX_CHECK_AND_RETURN_VAL(lowSpeed >= 0.0f, "PxVehicleSubstepParams.lowSpeed must be greater than or equal to zero", false);
+		PX_CHECK_AND_RETURN_VAL(restSpeed >= 0.0f, "PxVehicleSubstepParams.restSpeed must be greater than or equal to zero", false);
+		PX_CHECK_AND_RETURN_VAL(maxTravelPerSubstep > 0.0f, "PxVehicleSubstepParams.maxTravelPerSubstep must be greater than zero", false);
+		PX_CHECK_AND_RETURN_VAL(maxSuspensionPhasePerSubstep > 0.0f, "PxVehicleSubstepParams.maxSuspensionPhasePerSubstep must be greater than zero", false);
+		PX_CHECK_AND_RETURN_VAL(engineIdleTolerance >= 0.0f, "PxVehicleSubstepParams.engineIdleTolerance must be greater than or equal to zero", false);
+		return true;
+	}
+};
+
+#if !PX_DOXYGEN
+} // namespace vehicle2
+} // namespace physx
+#endif
+
+/** @} */
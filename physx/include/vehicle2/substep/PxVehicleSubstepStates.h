@@ -0,0 +1,69 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2023 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#pragma once
+
+/** \addtogroup vehicle2
+  @{
+*/
+
+#include "foundation/PxSimpleTypes.h"
+#include "foundation/PxMemory.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+namespace vehicle2
+{
+#endif
+
+/**
+\brief The number of substeps picked for the latest update of a vehicle, and the work saved by not running all updates
+with PxVehicleSubstepParams::maxNbSubsteps substeps.
+@see PxVehicleSubstepCountUpdate
+*/
+struct PxVehicleSubstepState
+{
+	PxU8 nbSubsteps;				//!< The number of substeps picked for the latest update.
+	PxU8 nbSavedSubsteps;			//!< PxVehicleSubstepParams::maxNbSubsteps minus nbSubsteps for the latest update.
+	bool atRest;					//!< True if the vehicle was considered at rest in the latest update.
+	PxU64 totalNbSubsteps;			//!< The sum of nbSubsteps over all updates since the last call to setToDefault().
+	PxU64 totalNbSavedSubsteps;		//!< The sum of nbSavedSubsteps over all updates since the last call to setToDefault().
+
+	PX_FORCE_INLINE void setToDefault()
+	{
+		PxMemZero(this, sizeof(PxVehicleSubstepState));
+	}
+};
+
+#if !PX_DOXYGEN
+} // namespace vehicle2
+} // namespace physx
+#endif
+
+/** @} */
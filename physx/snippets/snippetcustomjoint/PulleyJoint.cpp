@@ -117,7 +117,7 @@ static void visualize(	PxConstraintVisualizer&	viz,
 	viz.visualizeJointFrames(PxTransform(data.attachment0), PxTransform(data.attachment1));
 }
 
-static PxConstraintShaderTable sShaderTable = { solverPrep, project, visualize, PxConstraintFlag::Enum(0) };
+static PxConstraintShaderTable sShaderTable = { solverPrep, project, visualize, PxConstraintFlag::Enum(0), NULL };
 
 PxConstraintSolverPrep PulleyJoint::getPrep() const { return solverPrep; }
 
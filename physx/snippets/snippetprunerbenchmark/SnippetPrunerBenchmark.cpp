@@ -0,0 +1,302 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2023 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+// ****************************************************************************
+// This snippet compares the low-level pruners used by scene queries on a
+// workload made of many small, fast-moving, uniformly distributed objects
+// (think projectiles or debris).
+//
+// Each frame all objects move, the pruners are updated, and a batch of
+// raycasts and sphere overlaps is performed. The snippet prints the time spent
+// in each phase for the bucket pruner (PxPruningStructureType::eNONE), the
+// dynamic AABB tree (PxPruningStructureType::eDYNAMIC_AABB_TREE) and the hash
+// grid (PxPruningStructureType::eHASH_GRID). The number of hits is printed as
+// well, it should be the same for all pruners.
+//
+// ****************************************************************************
+
+#include "PxPhysicsAPI.h"
+#include "GuFactory.h"
+#include "GuPruner.h"
+#include "GuBounds.h"
+#include "foundation/PxArray.h"
+#include "../snippetcommon/SnippetPrint.h"
+#include "../snippetutils/SnippetUtils.h"
+
+using namespace physx;
+using namespace Gu;
+
+static const PxU32 gNbObjects = 50000;
+static const PxU32 gNbFrames = 64;
+static const PxU32 gNbRaycastsPerFrame = 1000;
+static const PxU32 gNbOverlapsPerFrame = 1000;
+static const float gWorldSize = 70.0f;
+static const float gMinObjectSize = 0.05f;
+static const float gMaxObjectSize = 0.25f;
+static const float gMaxSpeed = 0.5f;
+static const float gRaycastLength = 20.0f;
+static const float gOverlapRadius = 1.0f;
+
+static PxDefaultAllocator		gAllocator;
+static PxDefaultErrorCallback	gErrorCallback;
+static PxFoundation*			gFoundation = NULL;
+
+namespace
+{
+	struct Object
+	{
+		PxVec3	mPos;
+		PxVec3	mVel;
+		PxVec3	mExtents;
+	};
+
+	struct CountRaycastHits : PrunerRaycastCallback
+	{
+		CountRaycastHits() : mNbHits(0)	{}
+
+		virtual bool	invoke(PxReal&, PxU32, const PrunerPayload*, const PxTransform*)
+		{
+			mNbHits++;
+			return true;
+		}
+
+		PxU32	mNbHits;
+	};
+
+	struct CountOverlapHits : PrunerOverlapCallback
+	{
+		CountOverlapHits() : mNbHits(0)	{}
+
+		virtual bool	invoke(PxU32, const PrunerPayload*, const PxTransform*)
+		{
+			mNbHits++;
+			return true;
+		}
+
+		PxU32	mNbHits;
+	};
+
+	struct Timings
+	{
+		Timings() : mUpdate(0.0f), mCommit(0.0f), mRaycasts(0.0f), mOverlaps(0.0f), mNbRaycastHits(0), mNbOverlapHits(0)	{}
+
+		float	mUpdate;
+		float	mCommit;
+		float	mRaycasts;
+		float	mOverlaps;
+		PxU32	mNbRaycastHits;
+		PxU32	mNbOverlapHits;
+	};
+}
+
+static float getElapsedTime(PxU64 startTime)
+{
+	return SnippetUtils::getElapsedTimeInMilliseconds(SnippetUtils::getCurrentTimeCounterValue() - startTime);
+}
+
+static PxBounds3 computeBounds(const Object& object)
+{
+	return PxBounds3::centerExtents(object.mPos, object.mExtents);
+}
+
+static void createObjects(PxArray<Object>& objects)
+{
+	SnippetUtils::BasicRandom rnd(42);
+
+	const float halfWorldSize = gWorldSize * 0.5f;
+	objects.resize(gNbObjects);
+	for(PxU32 i=0;i<gNbObjects;i++)
+	{
+		Object& object = objects[i];
+		object.mPos = PxVec3(rnd.rand(-halfWorldSize, halfWorldSize), rnd.rand(-halfWorldSize, halfWorldSize), rnd.rand(-halfWorldSize, halfWorldSize));
+		object.mVel = PxVec3(rnd.rand(-gMaxSpeed, gMaxSpeed), rnd.rand(-gMaxSpeed, gMaxSpeed), rnd.rand(-gMaxSpeed, gMaxSpeed));
+		const float size = rnd.rand(gMinObjectSize, gMaxObjectSize);
+		object.mExtents = PxVec3(size);
+	}
+}
+
+static void moveObjects(PxArray<Object>& objects)
+{
+	// Objects bounce back inside the world when they reach its boundaries
+	const float halfWorldSize = gWorldSize * 0.5f;
+	const PxU32 nbObjects = objects.size();
+	for(PxU32 i=0;i<nbObjects;i++)
+	{
+		Object& object = objects[i];
+		object.mPos += object.mVel;
+		for(PxU32 j=0;j<3;j++)
+		{
+			if(PxAbs(object.mPos[j]) > halfWorldSize)
+				object.mVel[j] = -object.mVel[j];
+		}
+	}
+}
+
+static Timings runBenchmark(Pruner* pruner)
+{
+	Timings timings;
+
+	PxArray<Object> objects;
+	createObjects(objects);
+
+	PxArray<PrunerHandle> handles(gNbObjects);
+	PxArray<PxU32> boundsIndices(gNbObjects);
+	PxArray<PxBounds3> bounds(gNbObjects);
+	PxArray<PrunerPayload> payloads(gNbObjects);
+	PxArray<PxTransform> transforms(gNbObjects);
+	PxArray<PxTransform32> transforms32(gNbObjects);
+	for(PxU32 i=0;i<gNbObjects;i++)
+	{
+		boundsIndices[i] = i;
+		bounds[i] = computeBounds(objects[i]);
+		payloads[i].data[0] = i;
+		payloads[i].data[1] = 0;
+		transforms[i] = PxTransform(objects[i].mPos);
+		transforms32[i].transform = transforms[i];
+	}
+
+	pruner->addObjects(handles.begin(), bounds.begin(), payloads.begin(), transforms.begin(), gNbObjects, false);
+
+	// The first commit builds the initial tree for the AABB pruner, we do not measure it
+	pruner->commit();
+
+	DynamicPruner* dynamicPruner = pruner->isDynamic() ? static_cast<DynamicPruner*>(pruner) : NULL;
+
+	// Queries use the same random sequence for all pruners
+	SnippetUtils::BasicRandom rnd(0x1234);
+	const float halfWorldSize = gWorldSize * 0.5f;
+
+	for(PxU32 frame=0;frame<gNbFrames;frame++)
+	{
+		moveObjects(objects);
+
+		PxU64 time = SnippetUtils::getCurrentTimeCounterValue();
+		{
+			for(PxU32 i=0;i<gNbObjects;i++)
+			{
+				bounds[i] = computeBounds(objects[i]);
+				transforms32[i].transform.p = objects[i].mPos;
+			}
+			pruner->updateObjects(handles.begin(), gNbObjects, 0.0f, boundsIndices.begin(), bounds.begin(), transforms32.begin());
+		}
+		timings.mUpdate += getElapsedTime(time);
+
+		time = SnippetUtils::getCurrentTimeCounterValue();
+		{
+			// This is what the scene-query system does each frame for dynamic trees
+			if(dynamicPruner)
+				dynamicPruner->buildStep(true);
+			pruner->commit();
+		}
+		timings.mCommit += getElapsedTime(time);
+
+		time = SnippetUtils::getCurrentTimeCounterValue();
+		for(PxU32 i=0;i<gNbRaycastsPerFrame;i++)
+		{
+			const PxVec3 origin(rnd.rand(-halfWorldSize, halfWorldSize), rnd.rand(-halfWorldSize, halfWorldSize), rnd.rand(-halfWorldSize, halfWorldSize));
+			PxVec3 dir(rnd.randomFloat(), rnd.randomFloat(), rnd.randomFloat());
+			dir.normalize();
+
+			CountRaycastHits cb;
+			PxReal dist = gRaycastLength;
+			pruner->raycast(origin, dir, dist, cb);
+			timings.mNbRaycastHits += cb.mNbHits;
+		}
+		timings.mRaycasts += getElapsedTime(time);
+
+		time = SnippetUtils::getCurrentTimeCounterValue();
+		for(PxU32 i=0;i<gNbOverlapsPerFrame;i++)
+		{
+			const PxVec3 center(rnd.rand(-halfWorldSize, halfWorldSize), rnd.rand(-halfWorldSize, halfWorldSize), rnd.rand(-halfWorldSize, halfWorldSize));
+			const ShapeData queryVolume(PxSphereGeometry(gOverlapRadius), PxTransform(center), 0.0f);
+
+			CountOverlapHits cb;
+			pruner->overlap(queryVolume, cb);
+			timings.mNbOverlapHits += cb.mNbHits;
+		}
+		timings.mOverlaps += getElapsedTime(time);
+	}
+
+	return timings;
+}
+
+static void printTimings(const char* name, const Timings& timings)
+{
+	const float coeff = 1.0f / float(gNbFrames);
+	printf("%-20s update: %7.3f ms  commit: %7.3f ms  raycasts: %7.3f ms  overlaps: %7.3f ms  (%d raycast hits, %d overlap hits)\n",
+		name, timings.mUpdate*coeff, timings.mCommit*coeff, timings.mRaycasts*coeff, timings.mOverlaps*coeff, timings.mNbRaycastHits, timings.mNbOverlapHits);
+}
+
+void initPhysics(bool /*interactive*/)
+{
+	// Like SnippetStandaloneQuerySystem, we only need Foundation and PhysXCommon here
+	gFoundation = PxCreateFoundation(PX_PHYSICS_VERSION, gAllocator, gErrorCallback);
+}
+
+void stepPhysics(bool /*interactive*/)
+{
+	printf("%d objects, %d frames, times are per frame:\n", gNbObjects, gNbFrames);
+
+	const PxU64 contextID = 0;
+	struct PrunerDesc
+	{
+		const char*	mName;
+		Pruner*		mPruner;
+	};
+
+	PrunerDesc pruners[] = {
+		{ "Bucket pruner",		createBucketPruner(contextID)	},
+		{ "Dynamic AABB tree",	createAABBPruner(contextID, true, COMPANION_PRUNER_INCREMENTAL, BVH_SPLATTER_POINTS, 4)	},
+		{ "Hash grid",			createHashGridPruner(contextID, gMaxObjectSize*8.0f)	},	// Cells a few times larger than the objects
+	};
+
+	for(PxU32 i=0;i<PX_ARRAY_SIZE(pruners);i++)
+	{
+		const Timings timings = runBenchmark(pruners[i].mPruner);
+		printTimings(pruners[i].mName, timings);
+		PX_DELETE(pruners[i].mPruner);
+	}
+}
+
+void cleanupPhysics(bool /*interactive*/)
+{
+	PX_RELEASE(gFoundation);
+
+	printf("SnippetPrunerBenchmark done.\n");
+}
+
+int snippetMain(int, const char*const*)
+{
+	printf("Pruner benchmark snippet.\n");
+
+	initPhysics(false);
+	stepPhysics(false);
+	cleanupPhysics(false);
+
+	return 0;
+}
@@ -119,6 +119,11 @@ EngineDriveVehicle gVehicle;
 //gravitational acceleration.
 PxVehiclePhysXSimulationContext gVehicleSimulationContext;
 
+//The number of substeps of the vehicle is picked for each update from
+//its speed, suspension stiffness and engine state.
+PxVehicleSubstepParams gSubstepParams;
+PxVehicleSubstepState gSubstepState;
+
 //Gravitational acceleration
 const PxVec3 gGravity(0.0f, -9.81f, 0.0f);
 
@@ -273,6 +278,20 @@ bool initVehicles()
 	gVehicleSimulationContext.gravity = gGravity;
 	gVehicleSimulationContext.physxScene = gScene;
 	gVehicleSimulationContext.physxActorUpdateMode = PxVehiclePhysXActorUpdateMode::eAPPLY_ACCELERATION;
+
+	//Substep 3 times at low forward speed to improve simulation fidelity, and more often
+	//if the vehicle travels more than 1m per substep. A vehicle at rest is updated with a single substep.
+	gSubstepParams.minNbSubsteps = 1;
+	gSubstepParams.maxNbSubsteps = 8;
+	gSubstepParams.lowSpeedNbSubsteps = 3;
+	gSubstepParams.lowSpeed = 5.0f;
+	gSubstepParams.restSpeed = 0.1f;
+	gSubstepParams.maxTravelPerSubstep = 1.0f;
+	gSubstepParams.maxSuspensionPhasePerSubstep = 0.5f;
+	gSubstepParams.engineIdleTolerance = 10.0f;
+	if (!gSubstepParams.isValid())
+		return false;
+	gSubstepState.setToDefault();
 	return true;
 }
 
@@ -314,11 +333,14 @@ void stepPhysics()
 	gVehicle.mTransmissionCommandState.targetGear = command.gear;
 
 	//Forward integrate the vehicle by a single timestep.
-	//Apply substepping at low forward speed to improve simulation fidelity.
-	const PxVec3 linVel = gVehicle.mPhysXState.physxActor.rigidBody->getLinearVelocity();
-	const PxVec3 forwardDir = gVehicle.mPhysXState.physxActor.rigidBody->getGlobalPose().q.getBasisVector2();
-	const PxReal forwardSpeed = linVel.dot(forwardDir);
-	const PxU8 nbSubsteps = (forwardSpeed < 5.0f ? 3 : 1);
+	//Pick the number of substeps from the current state of the vehicle.
+	const PxU8 nbSubsteps = PxVehicleSubstepCountUpdate(
+		gVehicle.mBaseParams.axleDescription, gSubstepParams,
+		PxVehicleArrayData<const PxVehicleSuspensionForceParams>(gVehicle.mBaseParams.suspensionForceParams),
+		gVehicle.mBaseState.rigidBodyState, &gVehicle.mCommandState,
+		&gVehicle.mEngineDriveParams.engineParams, &gVehicle.mEngineDriveState.engineState,
+		timestep, gVehicleSimulationContext.frame,
+		gSubstepState);
 	gVehicle.mComponentSequence.setSubsteps(gVehicle.mComponentSequenceSubstepGroupHandle, nbSubsteps);
 	gVehicle.step(timestep, gVehicleSimulationContext);
 
@@ -362,6 +384,8 @@ int snippetMain(int argc, const char*const* argv)
 		{
 			stepPhysics();
 		}
+		printf("Substeps: %d run, %d saved compared to always running %d substeps.\n",
+			int(gSubstepState.totalNbSubsteps), int(gSubstepState.totalNbSavedSubsteps), int(gSubstepParams.maxNbSubsteps));
 		cleanupPhysics();
 	}
 #endif
@@ -0,0 +1,325 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2023 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+// ****************************************************************************
+// This snippet compares PxVehicleUpdates and PxVehicleUpdatesGrouped on a large
+// array of legacy vehicles mixing all drive types (PxVehicleDrive4W,
+// PxVehicleDriveNW, PxVehicleDriveTank and PxVehicleNoDrive).
+//
+// The vehicles are interleaved in the array, which is the worst case for
+// PxVehicleUpdates since consecutive vehicles take different update paths.
+// PxVehicleUpdatesGrouped visits the vehicles grouped by drive type instead.
+// Each benchmark runs the same scene from scratch and only the vehicle update
+// is timed. The average chassis speed is printed as well, it should be very
+// close for both functions.
+//
+// ****************************************************************************
+
+#include "PxPhysicsAPI.h"
+#include "foundation/PxArray.h"
+#include "../snippetcommon/SnippetPrint.h"
+#include "../snippetutils/SnippetUtils.h"
+
+using namespace physx;
+
+static const PxU32 gNbVehicles = 2048;
+static const PxU32 gNbWheels = 4;
+static const PxU32 gNbFrames = 120;
+static const PxReal gTimestep = 1.0f/60.0f;
+static const PxReal gVehicleSpacing = 8.0f;
+static const PxReal gChassisMass = 1500.0f;
+static const PxVec3 gChassisHalfExtents(1.0f, 0.5f, 2.2f);
+static const PxReal gWheelRadius = 0.4f;
+static const PxReal gWheelWidth = 0.3f;
+static const PxReal gWheelMass = 20.0f;
+
+static PxDefaultAllocator		gAllocator;
+static PxDefaultErrorCallback	gErrorCallback;
+static PxFoundation*			gFoundation = NULL;
+static PxPhysics*				gPhysics = NULL;
+static PxDefaultCpuDispatcher*	gDispatcher = NULL;
+static PxMaterial*				gMaterial = NULL;
+static PxVehicleDrivableSurfaceToTireFrictionPairs*	gFrictionPairs = NULL;
+
+namespace
+{
+	struct Timings
+	{
+		Timings() : mUpdate(0.0f), mAverageSpeed(0.0f)	{}
+
+		float	mUpdate;
+		float	mAverageSpeed;
+	};
+}
+
+static float getElapsedTime(PxU64 startTime)
+{
+	return SnippetUtils::getElapsedTimeInMilliseconds(SnippetUtils::getCurrentTimeCounterValue() - startTime);
+}
+
+static PxVehicleWheelsSimData* createWheelsSimData()
+{
+	const PxVec3 wheelOffsets[gNbWheels] =
+	{
+		PxVec3( gChassisHalfExtents.x - gWheelWidth, -gChassisHalfExtents.y,  gChassisHalfExtents.z - gWheelRadius),
+		PxVec3(-gChassisHalfExtents.x + gWheelWidth, -gChassisHalfExtents.y,  gChassisHalfExtents.z - gWheelRadius),
+		PxVec3( gChassisHalfExtents.x - gWheelWidth, -gChassisHalfExtents.y, -gChassisHalfExtents.z + gWheelRadius),
+		PxVec3(-gChassisHalfExtents.x + gWheelWidth, -gChassisHalfExtents.y, -gChassisHalfExtents.z + gWheelRadius)
+	};
+
+	PxReal sprungMasses[gNbWheels];
+	PxVehicleComputeSprungMasses(gNbWheels, wheelOffsets, PxVec3(0.0f), gChassisMass, 1, sprungMasses);
+
+	PxVehicleWheelsSimData* wheelsSimData = PxVehicleWheelsSimData::allocate(gNbWheels);
+	for(PxU32 i=0;i<gNbWheels;i++)
+	{
+		PxVehicleWheelData wheel;
+		wheel.mRadius = gWheelRadius;
+		wheel.mWidth = gWheelWidth;
+		wheel.mMass = gWheelMass;
+		wheel.mMOI = 0.5f*gWheelMass*gWheelRadius*gWheelRadius;
+		wheel.mMaxHandBrakeTorque = i>=2 ? 4000.0f : 0.0f;
+		wheel.mMaxSteer = i<2 ? PxPi*0.333f : 0.0f;
+
+		PxVehicleSuspensionData susp;
+		susp.mSprungMass = sprungMasses[i];
+		susp.mSpringStrength = 35000.0f;
+		susp.mSpringDamperRate = 4500.0f;
+
+		wheelsSimData->setWheelData(i, wheel);
+		wheelsSimData->setTireData(i, PxVehicleTireData());
+		wheelsSimData->setSuspensionData(i, susp);
+		wheelsSimData->setSuspTravelDirection(i, PxVec3(0.0f, -1.0f, 0.0f));
+		wheelsSimData->setWheelCentreOffset(i, wheelOffsets[i]);
+		wheelsSimData->setSuspForceAppPointOffset(i, PxVec3(wheelOffsets[i].x, -0.3f, wheelOffsets[i].z));
+		wheelsSimData->setTireForceAppPointOffset(i, PxVec3(wheelOffsets[i].x, -0.3f, wheelOffsets[i].z));
+		wheelsSimData->setWheelShapeMapping(i, -1);	// The chassis box is the only shape
+	}
+	return wheelsSimData;
+}
+
+static PxRigidDynamic* createVehicleActor(const PxTransform& pose)
+{
+	PxRigidDynamic* actor = gPhysics->createRigidDynamic(pose);
+	PxShape* chassis = PxRigidActorExt::createExclusiveShape(*actor, PxBoxGeometry(gChassisHalfExtents), *gMaterial);
+	chassis->setFlag(PxShapeFlag::eSCENE_QUERY_SHAPE, false);	// Suspension raycasts should only hit the ground
+	chassis->setLocalPose(PxTransform(PxVec3(0.0f, 0.4f, 0.0f)));
+
+	const PxVec3 dims = gChassisHalfExtents*2.0f;
+	actor->setMass(gChassisMass);
+	actor->setMassSpaceInertiaTensor(PxVec3(dims.y*dims.y + dims.z*dims.z, dims.x*dims.x + dims.z*dims.z, dims.x*dims.x + dims.y*dims.y)*(gChassisMass/12.0f));
+	return actor;
+}
+
+// Vehicle types are interleaved: 4W, NW, tank, no-drive, 4W, ...
+static PxVehicleWheels* createVehicle(PxU32 index, const PxVehicleWheelsSimData& wheelsSimData)
+{
+	const PxU32 nbPerRow = PxU32(PxSqrt(PxReal(gNbVehicles)));
+	const PxVec3 pos(PxReal(index % nbPerRow)*gVehicleSpacing, 1.0f, PxReal(index / nbPerRow)*gVehicleSpacing);
+	PxRigidDynamic* actor = createVehicleActor(PxTransform(pos));
+
+	switch(index & 3)
+	{
+	case PxVehicleTypes::eDRIVE4W:
+		{
+			PxVehicleAckermannGeometryData ackermann;
+			ackermann.mFrontWidth = 2.0f*(gChassisHalfExtents.x - gWheelWidth);
+			ackermann.mRearWidth = ackermann.mFrontWidth;
+			ackermann.mAxleSeparation = 2.0f*(gChassisHalfExtents.z - gWheelRadius);
+
+			PxVehicleDriveSimData4W driveSimData;
+			driveSimData.setAckermannGeometryData(ackermann);
+
+			PxVehicleDrive4W* vehicle = PxVehicleDrive4W::create(gPhysics, actor, wheelsSimData, driveSimData, 0);
+			vehicle->mDriveDynData.forceGearChange(PxVehicleGearsData::eFIRST);
+			vehicle->mDriveDynData.setUseAutoGears(true);
+			vehicle->mDriveDynData.setAnalogInput(PxVehicleDrive4WControl::eANALOG_INPUT_ACCEL, 0.6f);
+			vehicle->mDriveDynData.setAnalogInput(PxVehicleDrive4WControl::eANALOG_INPUT_STEER_LEFT, 0.1f);
+			return vehicle;
+		}
+	case PxVehicleTypes::eDRIVENW:
+		{
+			PxVehicleDifferentialNWData diff;
+			for(PxU32 i=0;i<gNbWheels;i++)
+				diff.setDrivenWheel(i, true);
+
+			PxVehicleDriveSimDataNW driveSimData;
+			driveSimData.setDiffData(diff);
+
+			PxVehicleDriveNW* vehicle = PxVehicleDriveNW::create(gPhysics, actor, wheelsSimData, driveSimData, gNbWheels);
+			vehicle->mDriveDynData.forceGearChange(PxVehicleGearsData::eFIRST);
+			vehicle->mDriveDynData.setUseAutoGears(true);
+			vehicle->mDriveDynData.setAnalogInput(PxVehicleDriveNWControl::eANALOG_INPUT_ACCEL, 0.6f);
+			vehicle->mDriveDynData.setAnalogInput(PxVehicleDriveNWControl::eANALOG_INPUT_STEER_RIGHT, 0.1f);
+			return vehicle;
+		}
+	case PxVehicleTypes::eDRIVETANK:
+		{
+			PxVehicleDriveTank* vehicle = PxVehicleDriveTank::create(gPhysics, actor, wheelsSimData, PxVehicleDriveSimData(), gNbWheels);
+			vehicle->mDriveDynData.forceGearChange(PxVehicleGearsData::eFIRST);
+			vehicle->mDriveDynData.setUseAutoGears(true);
+			vehicle->mDriveDynData.setAnalogInput(PxVehicleDriveTankControl::eANALOG_INPUT_ACCEL, 0.6f);
+			vehicle->mDriveDynData.setAnalogInput(PxVehicleDriveTankControl::eANALOG_INPUT_THRUST_LEFT, 0.8f);
+			vehicle->mDriveDynData.setAnalogInput(PxVehicleDriveTankControl::eANALOG_INPUT_THRUST_RIGHT, 0.6f);
+			return vehicle;
+		}
+	default:
+		{
+			PxVehicleNoDrive* vehicle = PxVehicleNoDrive::create(gPhysics, actor, wheelsSimData);
+			for(PxU32 i=0;i<gNbWheels;i++)
+				vehicle->setDriveTorque(i, 300.0f);
+			vehicle->setSteerAngle(0, 0.1f);
+			vehicle->setSteerAngle(1, 0.1f);
+			return vehicle;
+		}
+	}
+}
+
+static void releaseVehicle(PxVehicleWheels* vehicle)
+{
+	switch(vehicle->getVehicleType())
+	{
+	case PxVehicleTypes::eDRIVE4W:		static_cast<PxVehicleDrive4W*>(vehicle)->free();	break;
+	case PxVehicleTypes::eDRIVENW:		static_cast<PxVehicleDriveNW*>(vehicle)->free();	break;
+	case PxVehicleTypes::eDRIVETANK:	static_cast<PxVehicleDriveTank*>(vehicle)->free();	break;
+	default:							static_cast<PxVehicleNoDrive*>(vehicle)->free();	break;
+	}
+}
+
+static Timings runBenchmark(bool grouped)
+{
+	PxSceneDesc sceneDesc(gPhysics->getTolerancesScale());
+	sceneDesc.gravity = PxVec3(0.0f, -9.81f, 0.0f);
+	sceneDesc.cpuDispatcher = gDispatcher;
+	sceneDesc.filterShader = PxDefaultSimulationFilterShader;
+	PxScene* scene = gPhysics->createScene(sceneDesc);
+
+	PxRigidStatic* groundPlane = PxCreatePlane(*gPhysics, PxPlane(0.0f, 1.0f, 0.0f, 0.0f), *gMaterial);
+	scene->addActor(*groundPlane);
+
+	PxVehicleWheelsSimData* wheelsSimData = createWheelsSimData();
+
+	PxArray<PxVehicleWheels*> vehicles(gNbVehicles);
+	for(PxU32 i=0;i<gNbVehicles;i++)
+	{
+		vehicles[i] = createVehicle(i, *wheelsSimData);
+		scene->addActor(*vehicles[i]->getRigidDynamicActor());
+	}
+	wheelsSimData->free();
+
+	PxBatchQueryExt* batchQuery = PxCreateBatchQueryExt(*scene, NULL, gNbVehicles*gNbWheels, gNbVehicles*gNbWheels, 0, 0, 0, 0);
+
+	PxArray<PxWheelQueryResult> wheelQueryResults(gNbVehicles*gNbWheels);
+	PxArray<PxVehicleWheelQueryResult> vehicleQueryResults(gNbVehicles);
+	for(PxU32 i=0;i<gNbVehicles;i++)
+	{
+		vehicleQueryResults[i].wheelQueryResults = &wheelQueryResults[i*gNbWheels];
+		vehicleQueryResults[i].nbWheelQueryResults = gNbWheels;
+	}
+
+	Timings timings;
+	for(PxU32 frame=0;frame<gNbFrames;frame++)
+	{
+		PxVehicleSuspensionRaycasts(batchQuery, gNbVehicles, vehicles.begin(), NULL, PxQueryFlag::eSTATIC);
+
+		const PxU64 time = SnippetUtils::getCurrentTimeCounterValue();
+		if(grouped)
+			PxVehicleUpdatesGrouped(gTimestep, sceneDesc.gravity, *gFrictionPairs, gNbVehicles, vehicles.begin(), vehicleQueryResults.begin());
+		else
+			PxVehicleUpdates(gTimestep, sceneDesc.gravity, *gFrictionPairs, gNbVehicles, vehicles.begin(), vehicleQueryResults.begin());
+		timings.mUpdate += getElapsedTime(time);
+
+		scene->simulate(gTimestep);
+		scene->fetchResults(true);
+	}
+	timings.mUpdate /= float(gNbFrames);
+
+	for(PxU32 i=0;i<gNbVehicles;i++)
+	{
+		timings.mAverageSpeed += vehicles[i]->computeForwardSpeed();
+		releaseVehicle(vehicles[i]);
+	}
+	timings.mAverageSpeed /= float(gNbVehicles);
+
+	batchQuery->release();
+	scene->release();
+	return timings;
+}
+
+void initPhysics(bool /*interactive*/)
+{
+	gFoundation = PxCreateFoundation(PX_PHYSICS_VERSION, gAllocator, gErrorCallback);
+	gPhysics = PxCreatePhysics(PX_PHYSICS_VERSION, *gFoundation, PxTolerancesScale());
+	const PxU32 numCores = SnippetUtils::getNbPhysicalCores();
+	gDispatcher = PxDefaultCpuDispatcherCreate(numCores == 0 ? 0 : numCores - 1);
+	gMaterial = gPhysics->createMaterial(0.5f, 0.5f, 0.6f);
+
+	PxInitVehicleSDK(*gPhysics);
+	PxVehicleSetBasisVectors(PxVec3(0.0f, 1.0f, 0.0f), PxVec3(0.0f, 0.0f, 1.0f));
+	PxVehicleSetUpdateMode(PxVehicleUpdateMode::eVELOCITY_CHANGE);
+
+	PxVehicleDrivableSurfaceType surfaceType;
+	surfaceType.mType = 0;
+	const PxMaterial* surfaceMaterial = gMaterial;
+	gFrictionPairs = PxVehicleDrivableSurfaceToTireFrictionPairs::allocate(1, 1);
+	gFrictionPairs->setup(1, 1, &surfaceMaterial, &surfaceType);
+}
+
+void stepPhysics(bool /*interactive*/)
+{
+	printf("%d vehicles of 4 types, %d frames, times are per frame:\n", gNbVehicles, gNbFrames);
+
+	const Timings ungrouped = runBenchmark(false);
+	printf("PxVehicleUpdates:        %7.3f ms  (average speed: %.3f)\n", double(ungrouped.mUpdate), double(ungrouped.mAverageSpeed));
+
+	const Timings grouped = runBenchmark(true);
+	printf("PxVehicleUpdatesGrouped: %7.3f ms  (average speed: %.3f)\n", double(grouped.mUpdate), double(grouped.mAverageSpeed));
+}
+
+void cleanupPhysics(bool /*interactive*/)
+{
+	gFrictionPairs->release();
+	PxCloseVehicleSDK();
+	PX_RELEASE(gMaterial);
+	PX_RELEASE(gDispatcher);
+	PX_RELEASE(gPhysics);
+	PX_RELEASE(gFoundation);
+
+	printf("SnippetVehicleBenchmark done.\n");
+}
+
+int snippetMain(int, const char*const*)
+{
+	printf("Vehicle benchmark snippet.\n");
+
+	initPhysics(false);
+	stepPhysics(false);
+	cleanupPhysics(false);
+
+	return 0;
+}
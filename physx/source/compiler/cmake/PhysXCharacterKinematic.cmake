@@ -57,6 +57,7 @@ SET(PHYSXCCT_SOURCE
 	${LL_SOURCE_DIR}/CctSweptBox.cpp
 	${LL_SOURCE_DIR}/CctSweptCapsule.cpp
 	${LL_SOURCE_DIR}/CctSweptVolume.cpp
+	${LL_SOURCE_DIR}/CctTriangleCache.cpp
 	${LL_SOURCE_DIR}/CctBoxController.h
 	${LL_SOURCE_DIR}/CctCapsuleController.h
 	${LL_SOURCE_DIR}/CctCharacterController.h
@@ -67,6 +68,7 @@ SET(PHYSXCCT_SOURCE
 	${LL_SOURCE_DIR}/CctSweptBox.h
 	${LL_SOURCE_DIR}/CctSweptCapsule.h
 	${LL_SOURCE_DIR}/CctSweptVolume.h
+	${LL_SOURCE_DIR}/CctTriangleCache.h
 	${LL_SOURCE_DIR}/CctUtils.h
 )
 SOURCE_GROUP(src FILES ${PHYSXCCT_SOURCE})
@@ -87,6 +89,7 @@ TARGET_INCLUDE_DIRECTORIES(PhysXCharacterKinematic
 	PRIVATE ${PHYSX_SOURCE_DIR}/common/src
 	
 	PRIVATE ${PHYSX_SOURCE_DIR}/geomutils/include
+	PRIVATE ${PHYSX_SOURCE_DIR}/geomutils/src
 )
 
 TARGET_COMPILE_DEFINITIONS(PhysXCharacterKinematic 
@@ -513,11 +513,18 @@ SET(PHYSXCOMMON_GU_PRUNERS_SOURCE
 	${GU_SOURCE_DIR}/src/GuAABBTreeNode.h
 	${GU_SOURCE_DIR}/src/GuAABBTreeBuildStats.h
 	${GU_SOURCE_DIR}/src/GuAABBTreeQuery.h
+	${GU_SOURCE_DIR}/src/GuWideAABBTree.cpp
+	${GU_SOURCE_DIR}/src/GuWideAABBTree.h
+	${GU_SOURCE_DIR}/src/GuWideAABBTreeQuery.h
 	${GU_SOURCE_DIR}/src/GuSqInternal.cpp
 	${GU_SOURCE_DIR}/src/GuIncrementalAABBTree.h
 	${GU_SOURCE_DIR}/src/GuIncrementalAABBTree.cpp
 	${GU_SOURCE_DIR}/src/GuSAH.cpp
 	${GU_SOURCE_DIR}/src/GuSAH.h
+	${GU_SOURCE_DIR}/src/GuBinnedSAH.cpp
+	${GU_SOURCE_DIR}/src/GuBinnedSAH.h
+	${GU_SOURCE_DIR}/src/GuParallelJobs.cpp
+	${GU_SOURCE_DIR}/src/GuParallelJobs.h
 	${GU_SOURCE_DIR}/src/GuBVH.cpp
 	${GU_SOURCE_DIR}/src/GuBVH.h
 	${GU_SOURCE_DIR}/src/GuBVHTestsSIMD.h
@@ -529,6 +536,8 @@ SET(PHYSXCOMMON_GU_PRUNERS_SOURCE
 	${GU_SOURCE_DIR}/src/GuPruningPool.cpp
 	${GU_SOURCE_DIR}/src/GuBucketPruner.h
 	${GU_SOURCE_DIR}/src/GuBucketPruner.cpp
+	${GU_SOURCE_DIR}/src/GuHashGridPruner.h
+	${GU_SOURCE_DIR}/src/GuHashGridPruner.cpp
 	${GU_SOURCE_DIR}/src/GuMaverickNode.h
 	${GU_SOURCE_DIR}/src/GuMaverickNode.cpp
 	${GU_SOURCE_DIR}/src/GuExtendedBucketPruner.h
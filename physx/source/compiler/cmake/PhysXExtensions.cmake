@@ -35,7 +35,9 @@ SET(LL_SOURCE_DIR ${PHYSX_SOURCE_DIR}/physxextensions/src)
 include(${PHYSX_ROOT_DIR}/${PROJECT_CMAKE_FILES_DIR}/${TARGET_BUILD_PLATFORM}/PhysXExtensions.cmake)
 
 SET(PHYSX_EXTENSIONS_SOURCE
+	${LL_SOURCE_DIR}/ExtArticulationCacheBatch.cpp
 	${LL_SOURCE_DIR}/ExtBroadPhase.cpp
+	${LL_SOURCE_DIR}/ExtBVH.cpp
 	${LL_SOURCE_DIR}/ExtCollection.cpp
 	${LL_SOURCE_DIR}/ExtConvexMeshExt.cpp
 	${LL_SOURCE_DIR}/ExtCpuWorkerThread.cpp
@@ -51,8 +53,13 @@ SET(PHYSX_EXTENSIONS_SOURCE
 	${LL_SOURCE_DIR}/ExtRigidBodyExt.cpp
 	${LL_SOURCE_DIR}/ExtRigidActorExt.cpp	
 	${LL_SOURCE_DIR}/ExtSceneQueryExt.cpp
+	${LL_SOURCE_DIR}/ExtBatchSweepQuery.cpp
+	${LL_SOURCE_DIR}/ExtContactCacheArena.cpp
+	${LL_SOURCE_DIR}/ExtImmediateStepper.cpp
 	${LL_SOURCE_DIR}/ExtSceneQuerySystem.cpp
 	${LL_SOURCE_DIR}/ExtCustomSceneQuerySystem.cpp
+	${LL_SOURCE_DIR}/ExtCachedSceneQuerySystem.cpp
+	${LL_SOURCE_DIR}/ExtVersionedSceneQuerySystem.cpp
 	${LL_SOURCE_DIR}/ExtSqQuery.cpp
 	${LL_SOURCE_DIR}/ExtSqQuery.h
 	${LL_SOURCE_DIR}/ExtSqManager.cpp
@@ -70,6 +77,7 @@ SET(PHYSX_EXTENSIONS_SOURCE
 	${LL_SOURCE_DIR}/ExtPvd.h
 	${LL_SOURCE_DIR}/ExtSerialization.h
 	${LL_SOURCE_DIR}/ExtSharedQueueEntryPool.h
+	${LL_SOURCE_DIR}/ExtPagedAllocator.h
 	${LL_SOURCE_DIR}/ExtTaskQueueHelper.h
 	${LL_SOURCE_DIR}/ExtSampling.cpp
 	${LL_SOURCE_DIR}/ExtTetMakerExt.cpp
@@ -162,8 +170,12 @@ SET(PHYSX_EXTENSIONS_OMNIPVD_SOURCE
 SOURCE_GROUP(src\\omnipvd FILES ${PHYSX_EXTENSIONS_OMNIPVD_SOURCE})
 
 SET(PHYSX_EXTENSIONS_HEADERS
+	${PHYSX_ROOT_DIR}/include/extensions/PxArticulationCacheBatch.h
+	${PHYSX_ROOT_DIR}/include/extensions/PxImmediateStepperExt.h
+	${PHYSX_ROOT_DIR}/include/extensions/PxContactCacheArenaExt.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxBinaryConverter.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxBroadPhaseExt.h
+	${PHYSX_ROOT_DIR}/include/extensions/PxBVHExt.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxCollectionExt.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxConvexMeshExt.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxDefaultAllocator.h
@@ -181,6 +193,8 @@ SET(PHYSX_EXTENSIONS_HEADERS
 	${PHYSX_ROOT_DIR}/include/extensions/PxSceneQueryExt.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxSceneQuerySystemExt.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxCustomSceneQuerySystem.h
+	${PHYSX_ROOT_DIR}/include/extensions/PxCachedSceneQuerySystem.h
+	${PHYSX_ROOT_DIR}/include/extensions/PxVersionedSceneQuerySystem.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxSerialization.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxShapeExt.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxSimpleFactory.h
@@ -43,6 +43,11 @@ SET(PHYSX_VEHICLE2_HEADERS
 	${PHYSX_ROOT_DIR}/include/vehicle2/PxVehicleParams.h
 	${PHYSX_ROOT_DIR}/include/vehicle2/PxVehicleMaths.h
 )
+SET(PHYSX_VEHICLE2_BATCH_HEADERS
+	${PHYSX_ROOT_DIR}/include/vehicle2/batch/PxVehicleBatchFunctions.h
+	${PHYSX_ROOT_DIR}/include/vehicle2/batch/PxVehicleBatchHelpers.h
+	${PHYSX_ROOT_DIR}/include/vehicle2/batch/PxVehicleBatchStates.h
+)
 SET(PHYSX_VEHICLE2_BRAKING_HEADERS
 	${PHYSX_ROOT_DIR}/include/vehicle2/braking/PxVehicleBrakingFunctions.h
 	${PHYSX_ROOT_DIR}/include/vehicle2/braking/PxVehicleBrakingParams.h
@@ -92,6 +97,12 @@ SET(PHYSX_VEHICLE2_STEERING_HEADERS
 	${PHYSX_ROOT_DIR}/include/vehicle2/steering/PxVehicleSteeringFunctions.h
 	${PHYSX_ROOT_DIR}/include/vehicle2/steering/PxVehicleSteeringParams.h
 )
+SET(PHYSX_VEHICLE2_SUBSTEP_HEADERS
+	${PHYSX_ROOT_DIR}/include/vehicle2/substep/PxVehicleSubstepComponents.h
+	${PHYSX_ROOT_DIR}/include/vehicle2/substep/PxVehicleSubstepFunctions.h
+	${PHYSX_ROOT_DIR}/include/vehicle2/substep/PxVehicleSubstepParams.h
+	${PHYSX_ROOT_DIR}/include/vehicle2/substep/PxVehicleSubstepStates.h
+)
 SET(PHYSX_VEHICLE2_SUSPENSION_HEADERS
 	${PHYSX_ROOT_DIR}/include/vehicle2/suspension/PxVehicleSuspensionComponents.h
 	${PHYSX_ROOT_DIR}/include/vehicle2/suspension/PxVehicleSuspensionFunctions.h
@@ -120,6 +131,7 @@ SET(PHYSX_VEHICLE2_PVD_HEADERS
 )
 
 SOURCE_GROUP(include FILES ${PHYSX_VEHICLE2_HEADERS})
+SOURCE_GROUP(include\\batch FILES ${PHYSX_VEHICLE2_BATCH_HEADERS})
 SOURCE_GROUP(include\\braking FILES ${PHYSX_VEHICLE2_BRAKING_HEADERS})
 SOURCE_GROUP(include\\commands FILES ${PHYSX_VEHICLE2_COMMAND_HEADERS})
 SOURCE_GROUP(include\\drivetrain FILES ${PHYSX_VEHICLE2_DRIVETRAIN_HEADERS})
@@ -129,12 +141,18 @@ SOURCE_GROUP(include\\rigidBody FILES ${PHYSX_VEHICLE2_RIGIDBODY_HEADERS})
 SOURCE_GROUP(include\\roadGeometry FILES ${PHYSX_VEHICLE2_ROADGEOMETRY_HEADERS})
 SOURCE_GROUP(include\\physxRoadGeometry FILES ${PHYSX_VEHICLE2_PHYSXROADGEOMETRY_HEADERS})
 SOURCE_GROUP(include\\steering FILES ${PHYSX_VEHICLE2_STEERING_HEADERS})
+SOURCE_GROUP(include\\substep FILES ${PHYSX_VEHICLE2_SUBSTEP_HEADERS})
 SOURCE_GROUP(include\\suspension FILES ${PHYSX_VEHICLE2_SUSPENSION_HEADERS})
 SOURCE_GROUP(include\\tire FILES ${PHYSX_VEHICLE2_TIRE_HEADERS})
 SOURCE_GROUP(include\\wheel FILES ${PHYSX_VEHICLE2_WHEEL_HEADERS})
 SOURCE_GROUP(include\\pvd FILES ${PHYSX_VEHICLE2_PVD_HEADERS})
 
 
+SET(PHYSX_VEHICLE2_BATCH_SOURCE
+	${LL_SOURCE_DIR}/batch/VhBatchFunctions.cpp
+	${LL_SOURCE_DIR}/batch/VhBatchHelpers.cpp
+	${LL_SOURCE_DIR}/batch/VhBatchTasks.h
+)
 SET(PHYSX_VEHICLE2_BRAKING_SOURCE
 )
 SET(PHYSX_VEHICLE2_COMMANDS_SOURCE
@@ -162,6 +180,9 @@ SET(PHYSX_VEHICLE2_RIGIDBODY_SOURCE
 SET(PHYSX_VEHICLE2_STEERING_SOURCE
 	${LL_SOURCE_DIR}/steering/VhSteeringFunctions.cpp
 )
+SET(PHYSX_VEHICLE2_SUBSTEP_SOURCE
+	${LL_SOURCE_DIR}/substep/VhSubstepFunctions.cpp
+)
 SET(PHYSX_VEHICLE2_SUSPENSION_SOURCE
 	${LL_SOURCE_DIR}/suspension/VhSuspensionFunctions.cpp
     ${LL_SOURCE_DIR}/suspension/VhSuspensionHelpers.cpp
@@ -182,6 +203,7 @@ SET(PHYSX_VEHICLE2_PVD_SOURCE
 	${LL_SOURCE_DIR}/pvd/VhPvdWriter.h
 )
 
+SOURCE_GROUP(src\\batch FILES ${PHYSX_VEHICLE2_BATCH_SOURCE})
 SOURCE_GROUP(src\\braking FILES ${PHYSX_VEHICLE2_BRAKING_SOURCE})
 SOURCE_GROUP(src\\commands FILES ${PHYSX_VEHICLE2_COMMANDS_SOURCE})
 SOURCE_GROUP(src\\drivetrain FILES ${PHYSX_VEHICLE2_DRIVETRAIN_SOURCE})
@@ -190,12 +212,14 @@ SOURCE_GROUP(src\\physxConstraints FILES ${PHYSX_VEHICLE2_PHYSXCONSTRAINT_SOURCE
 SOURCE_GROUP(src\\physxRoadGeometry FILES ${PHYSX_VEHICLE2_PHYSXROADGEOMETRY_SOURCE})
 SOURCE_GROUP(src\\rigidBody FILES ${PHYSX_VEHICLE2_RIGIDBODY_SOURCE})
 SOURCE_GROUP(src\\steering FILES ${PHYSX_VEHICLE2_STEERING_SOURCE})
+SOURCE_GROUP(src\\substep FILES ${PHYSX_VEHICLE2_SUBSTEP_SOURCE})
 SOURCE_GROUP(src\\suspension FILES ${PHYSX_VEHICLE2_SUSPENSION_SOURCE})
 SOURCE_GROUP(src\\tire FILES ${PHYSX_VEHICLE2_TIRE_SOURCE})
 SOURCE_GROUP(src\\wheel FILES ${PHYSX_VEHICLE2_WHEEL_SOURCE})
 SOURCE_GROUP(src\\pvd FILES ${PHYSX_VEHICLE2_PVD_SOURCE})
 
 ADD_LIBRARY(PhysXVehicle2 ${PHYSXVEHICLE2_LIBTYPE}
+	${PHYSX_VEHICLE2_BATCH_SOURCE}
 	${PHYSX_VEHICLE2_BRAKING_SOURCE}
 	${PHYSX_VEHICLE2_COMMANDS_SOURCE}
 	${PHYSX_VEHICLE2_DRIVETRAIN_SOURCE}
@@ -204,11 +228,13 @@ ADD_LIBRARY(PhysXVehicle2 ${PHYSXVEHICLE2_LIBTYPE}
 	${PHYSX_VEHICLE2_PHYSXROADGEOMETRY_SOURCE}
 	${PHYSX_VEHICLE2_RIGIDBODY_SOURCE}
 	${PHYSX_VEHICLE2_STEERING_SOURCE}
+	${PHYSX_VEHICLE2_SUBSTEP_SOURCE}
 	${PHYSX_VEHICLE2_SUSPENSION_SOURCE}
 	${PHYSX_VEHICLE2_TIRE_SOURCE}
 	${PHYSX_VEHICLE2_WHEEL_SOURCE}
 	${PHYSX_VEHICLE2_PVD_SOURCE}
 	${PHYSX_VEHICLE2_HEADERS}
+	${PHYSX_VEHICLE2_BATCH_HEADERS}
 	${PHYSX_VEHICLE2_BRAKING_HEADERS}
 	${PHYSX_VEHICLE2_COMMAND_HEADERS}
 	${PHYSX_VEHICLE2_DRIVETRAIN_HEADERS}
@@ -218,6 +244,7 @@ ADD_LIBRARY(PhysXVehicle2 ${PHYSXVEHICLE2_LIBTYPE}
 	${PHYSX_VEHICLE2_RIGIDBODY_HEADERS}
 	${PHYSX_VEHICLE2_ROADGEOMETRY_HEADERS}
 	${PHYSX_VEHICLE2_STEERING_HEADERS}
+	${PHYSX_VEHICLE2_SUBSTEP_HEADERS}
 	${PHYSX_VEHICLE2_SUSPENSION_HEADERS}
 	${PHYSX_VEHICLE2_TIRE_HEADERS}
 	${PHYSX_VEHICLE2_WHEEL_HEADERS}
@@ -225,6 +252,7 @@ ADD_LIBRARY(PhysXVehicle2 ${PHYSXVEHICLE2_LIBTYPE}
 )
 
 INSTALL(FILES ${PHYSX_VEHICLE2_HEADERS} DESTINATION include/vehicle2)
+INSTALL(FILES ${PHYSX_VEHICLE2_BATCH_HEADERS} DESTINATION include/vehicle2/batch)
 INSTALL(FILES ${PHYSX_VEHICLE2_BRAKING_HEADERS} DESTINATION include/vehicle2/braking)
 INSTALL(FILES ${PHYSX_VEHICLE2_COMMAND_HEADERS} DESTINATION include/vehicle2/commands)
 INSTALL(FILES ${PHYSX_VEHICLE2_DRIVETRAIN_HEADERS} DESTINATION include/vehicle2/drivetrain)
@@ -234,6 +262,7 @@ INSTALL(FILES ${PHYSX_VEHICLE2_PHYSXROADGEOMETRY_HEADERS} DESTINATION include/ve
 INSTALL(FILES ${PHYSX_VEHICLE2_RIGIDBODY_HEADERS} DESTINATION include/vehicle2/rigidBody)
 INSTALL(FILES ${PHYSX_VEHICLE2_ROADGEOMETRY_HEADERS} DESTINATION include/vehicle2/roadGeometry)
 INSTALL(FILES ${PHYSX_VEHICLE2_STEERING_HEADERS} DESTINATION include/vehicle2/steering)
+INSTALL(FILES ${PHYSX_VEHICLE2_SUBSTEP_HEADERS} DESTINATION include/vehicle2/substep)
 INSTALL(FILES ${PHYSX_VEHICLE2_SUSPENSION_HEADERS} DESTINATION include/vehicle2/suspension)
 INSTALL(FILES ${PHYSX_VEHICLE2_TIRE_HEADERS} DESTINATION include/vehicle2/tire)
 INSTALL(FILES ${PHYSX_VEHICLE2_WHEEL_HEADERS} DESTINATION include/vehicle2/wheel)
@@ -243,6 +272,7 @@ TARGET_INCLUDE_DIRECTORIES(PhysXVehicle2
 	PRIVATE ${PHYSXVEHICLE2_PLATFORM_INCLUDES}
 	PRIVATE ${PHYSX_ROOT_DIR}/include
 	PRIVATE ${PHYSX_ROOT_DIR}/pvdruntime/include
+	PRIVATE ${PHYSX_SOURCE_DIR}/geomutils/src
 )
 
 # No linked libraries
@@ -290,6 +320,7 @@ IF(PX_GENERATE_SOURCE_DISTRO)
 	LIST(APPEND SOURCE_DISTRO_FILE_LIST ${PHYSX_VEHICLE2_RIGIDBODY_HEADERS})
 	LIST(APPEND SOURCE_DISTRO_FILE_LIST ${PHYSX_VEHICLE2_ROADGEOMETRY_HEADERS})
 	LIST(APPEND SOURCE_DISTRO_FILE_LIST ${PHYSX_VEHICLE2_STEERING_HEADERS})
+	LIST(APPEND SOURCE_DISTRO_FILE_LIST ${PHYSX_VEHICLE2_SUBSTEP_HEADERS})
 	LIST(APPEND SOURCE_DISTRO_FILE_LIST ${PHYSX_VEHICLE2_SUSPENSION_HEADERS})
 	LIST(APPEND SOURCE_DISTRO_FILE_LIST ${PHYSX_VEHICLE2_TIRE_HEADERS})
 	LIST(APPEND SOURCE_DISTRO_FILE_LIST ${PHYSX_VEHICLE2_WHEEL_HEADERS})
@@ -302,6 +333,7 @@ IF(PX_GENERATE_SOURCE_DISTRO)
 	LIST(APPEND SOURCE_DISTRO_FILE_LIST ${PHYSX_VEHICLE2_PHYSXROADGEOMETRY_SOURCE})
 	LIST(APPEND SOURCE_DISTRO_FILE_LIST ${PHYSX_VEHICLE2_RIGIDBODY_SOURCE})
 	LIST(APPEND SOURCE_DISTRO_FILE_LIST ${PHYSX_VEHICLE2_STEERING_SOURCE})
+	LIST(APPEND SOURCE_DISTRO_FILE_LIST ${PHYSX_VEHICLE2_SUBSTEP_SOURCE})
 	LIST(APPEND SOURCE_DISTRO_FILE_LIST ${PHYSX_VEHICLE2_SUSPENSION_SOURCE})
 	LIST(APPEND SOURCE_DISTRO_FILE_LIST ${PHYSX_VEHICLE2_TIRE_SOURCE})
 	LIST(APPEND SOURCE_DISTRO_FILE_LIST ${PHYSX_VEHICLE2_WHEEL_SOURCE})
@@ -35,13 +35,16 @@
 
 namespace physx
 {
+	class PxCpuDispatcher;
+
 namespace Gu
 {
 	class Pruner;
 
 	PX_C_EXPORT	PX_PHYSX_COMMON_API	Gu::Pruner*	createBucketPruner(PxU64 contextID);
-	PX_C_EXPORT	PX_PHYSX_COMMON_API	Gu::Pruner*	createAABBPruner(PxU64 contextID, bool dynamic, Gu::CompanionPrunerType type, Gu::BVHBuildStrategy buildStrategy, PxU32 nbObjectsPerNode);
+	PX_C_EXPORT	PX_PHYSX_COMMON_API	Gu::Pruner*	createAABBPruner(PxU64 contextID, bool dynamic, Gu::CompanionPrunerType type, Gu::BVHBuildStrategy buildStrategy, PxU32 nbObjectsPerNode, PxCpuDispatcher* dispatcher=NULL, bool wideTree=false);
 	PX_C_EXPORT	PX_PHYSX_COMMON_API	Gu::Pruner*	createIncrementalPruner(PxU64 contextID);
+	PX_C_EXPORT	PX_PHYSX_COMMON_API	Gu::Pruner*	createHashGridPruner(PxU64 contextID, float cellSize=1.0f);
 }
 }
 
@@ -196,6 +196,19 @@ namespace Gu
 		virtual	void					getGlobalBounds(PxBounds3&)	const	= 0;
 	};
 
+	/**
+	*	Statistics about the refit of a dynamic pruner's tree, see DynamicPruner::getRefitStats()
+	*/
+	struct PrunerRefitStats
+	{
+		PrunerRefitStats() : mNbUpdatedObjects(0), mNbRefitNodes(0), mRefitTime(0.0f), mBulkRefit(false)	{}
+
+		PxU32	mNbUpdatedObjects;	//!< Number of objects updated before the refit
+		PxU32	mNbRefitNodes;		//!< Number of refit tree nodes
+		PxReal	mRefitTime;			//!< Time spent in the refit, in seconds
+		bool	mBulkRefit;			//!< True if the whole tree was refit at once, false for a partial refit
+	};
+
 	/**
 	*	Pruner building accel structure over time base class
 	*/
@@ -220,6 +233,11 @@ namespace Gu
 		 * returns true if new tree is needed
 		 */
 		virtual bool					prepareBuild() = 0;	
+
+		/**
+		 * Retrieves statistics about the last refit of the tree, i.e. the last commit that had pending updates.
+		 */
+		virtual void					getRefitStats(PrunerRefitStats& stats) const = 0;
 	};
 }
 }
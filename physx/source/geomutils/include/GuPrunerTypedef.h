@@ -56,7 +56,8 @@ namespace physx
 		{
 			BVH_SPLATTER_POINTS,
 			BVH_SPLATTER_POINTS_SPLIT_GEOM_CENTER,
-			BVH_SAH
+			BVH_SAH,
+			BVH_BINNED_SAH
 		};
 	}
 }
@@ -38,6 +38,10 @@
 #define SQ_DEBUG_VIZ_DYNAMIC_COLOR2	PxU32(PxDebugColor::eARGB_DARKRED)
 #define SQ_DEBUG_VIZ_COMPOUND_COLOR	PxU32(PxDebugColor::eARGB_MAGENTA)
 
+//	#define SQ_PRUNER_EPSILON	0.01f
+	#define SQ_PRUNER_EPSILON	0.005f
+	#define SQ_PRUNER_INFLATION	(1.0f + SQ_PRUNER_EPSILON)	// pruner test shape inflation (not narrow phase shape)
+
 namespace physx
 {
 	class PxRenderOutput;
@@ -30,6 +30,7 @@
 #include "foundation/PxIntrinsics.h"
 #include "foundation/PxUserAllocated.h"
 #include "foundation/PxBitUtils.h"
+#include "foundation/PxTime.h"
 #include "GuAABBPruner.h"
 #include "GuPrunerMergeData.h"
 #include "GuCallbackAdapter.h"
@@ -37,20 +38,22 @@
 #include "GuBox.h"
 #include "GuCapsule.h"
 #include "GuAABBTreeQuery.h"
+#include "GuWideAABBTreeQuery.h"
 #include "GuAABBTreeNode.h"
 #include "GuQuery.h"
+#include "GuSqInternal.h"
 #include "CmVisualization.h"
 
 using namespace physx;
 using namespace Gu;
 using namespace Cm;
 
-// PT: TODO: this is copied from SqBounds.h, should be either moved to Gu and shared or passed as a user parameter
-	#define SQ_PRUNER_EPSILON	0.005f
-	#define SQ_PRUNER_INFLATION	(1.0f + SQ_PRUNER_EPSILON)	// pruner test shape inflation (not narrow phase shape)
+// Batches updating at least 1/Nth of the objects trigger a full refit of the tree instead of a partial refit
+#define BULK_REFIT_FRACTION	4
 
-AABBPruner::AABBPruner(bool incrementalRebuild, PxU64 contextID, CompanionPrunerType cpType, BVHBuildStrategy buildStrategy, PxU32 nbObjectsPerNode) :
+AABBPruner::AABBPruner(bool incrementalRebuild, PxU64 contextID, CompanionPrunerType cpType, BVHBuildStrategy buildStrategy, PxU32 nbObjectsPerNode, PxCpuDispatcher* dispatcher, bool wideTree) :
 	mAABBTree			(NULL),
+	mWideTree			(NULL),
 	mNewTree			(NULL),
 	mNbCachedBoxes		(0),
 	mNbCalls			(0),
@@ -61,11 +64,15 @@ AABBPruner::AABBPruner(bool incrementalRebuild, PxU64 contextID, CompanionPruner
 	mAdaptiveRebuildTerm(0),
 	mNbObjectsPerNode	(nbObjectsPerNode),
 	mBuildStrategy		(buildStrategy),
+	mDispatcher			(dispatcher),
+	mUseWideTree		(wideTree),
 	mPool				(contextID, TRANSFORM_CACHE_GLOBAL),
 	mIncrementalRebuild	(incrementalRebuild),
 	mUncommittedChanges	(false),
 	mNeedsNewTree		(false),
-	mNewTreeFixups		("AABBPruner::mNewTreeFixups")
+	mNewTreeFixups		("AABBPruner::mNewTreeFixups"),
+	mBulkRefitPending	(false),
+	mNbUpdatedObjects	(0)
 {
 	PX_ASSERT(nbObjectsPerNode<16);
 }
@@ -132,17 +139,33 @@ void AABBPruner::updateObjects(const PrunerHandle* handles, PxU32 count, float i
 	if(mIncrementalRebuild && mAABBTree)
 	{
 		mNeedsNewTree = true; // each update forces a tree rebuild
+		mNbUpdatedObjects += count;
+
+		// Large batches, typically the bounds of all moving objects synced from the transform cache after a simulation step, end
+		// up marking most of the tree anyway. In that case we skip the per-object marking and refit the whole tree in commit().
+		const bool bulkRefit = count * BULK_REFIT_FRACTION >= mPool.getNbActiveObjects();
+		if(bulkRefit)
+			mBulkRefitPending = true;
+
+		const bool addToRefit = mProgress == BUILD_NEW_MAPPING || mProgress == BUILD_FULL_REFIT || mProgress==BUILD_LAST_FRAME;
+
+		// Objects living in the bucket pruner, and objects moving while a new tree is being finalized, still need per-object work
+		if(bulkRefit && !addToRefit && !mBucketPruner.getNbObjects())
+			return;
+
 		const PxBounds3* currentBounds = mPool.getCurrentWorldBoxes();
 		const PxTransform* currentTransforms = mPool.getTransforms();
 		const PrunerPayload* data = mPool.getObjects();
-		const bool addToRefit = mProgress == BUILD_NEW_MAPPING || mProgress == BUILD_FULL_REFIT || mProgress==BUILD_LAST_FRAME;
 		for(PxU32 i=0; i<count; i++)
 		{
 			const PrunerHandle handle = handles[i];
 			const PoolIndex poolIndex = mPool.getIndex(handle);
 			const TreeNodeIndex treeNodeIndex = mTreeMap[poolIndex];
 			if(treeNodeIndex != INVALID_NODE_ID) // this means it's in the current tree still and hasn't been removed
-				mAABBTree->markNodeForRefit(treeNodeIndex);
+			{
+				if(!bulkRefit)
+					mAABBTree->markNodeForRefit(treeNodeIndex);
+			}
 			else // otherwise it means it should be in the bucket pruner
 			{
 				PX_ASSERT(&data[poolIndex]==&mPool.getPayloadData(handle));
@@ -209,6 +232,24 @@ void AABBPruner::removeObjects(const PrunerHandle* handles, PxU32 count, PrunerP
 	}
 }
 
+template<typename Test>
+static PX_FORCE_INLINE bool treeOverlap(const AABBTreeBounds& bounds, const AABBTree& tree, const WideAABBTree* wideTree, const ShapeData& queryVolume, const Test& test, OverlapCallbackAdapter& pcb)
+{
+	if(wideTree)
+		return WideAABBTreeOverlap<Test, OverlapCallbackAdapter>()(bounds, tree, *wideTree, queryVolume.getPrunerInflatedWorldAABB(), test, pcb);
+	else
+		return AABBTreeOverlap<true, Test, AABBTree, BVHNode, OverlapCallbackAdapter>()(bounds, tree, test, pcb);
+}
+
+template<const bool tInflate>
+static PX_FORCE_INLINE bool treeRaycast(const AABBTreeBounds& bounds, const AABBTree& tree, const WideAABBTree* wideTree, const PxVec3& origin, const PxVec3& unitDir, PxReal& maxDist, const PxVec3& inflation, RaycastCallbackAdapter& pcb)
+{
+	if(wideTree)
+		return WideAABBTreeRaycast<tInflate, RaycastCallbackAdapter>()(bounds, tree, *wideTree, origin, unitDir, maxDist, inflation, pcb);
+	else
+		return AABBTreeRaycast<tInflate, true, AABBTree, BVHNode, RaycastCallbackAdapter>()(bounds, tree, origin, unitDir, maxDist, inflation, pcb);
+}
+
 bool AABBPruner::overlap(const ShapeData& queryVolume, PrunerOverlapCallback& pcbArgName) const
 {
 	PX_ASSERT(!mUncommittedChanges);
@@ -226,12 +267,12 @@ bool AABBPruner::overlap(const ShapeData& queryVolume, PrunerOverlapCallback& pc
 				if(queryVolume.isOBB())
 				{	
 					const DefaultOBBAABBTest test(queryVolume);
-					again = AABBTreeOverlap<true, OBBAABBTest, AABBTree, BVHNode, OverlapCallbackAdapter>()(mPool.getCurrentAABBTreeBounds(), *mAABBTree, test, pcb);
+					again = treeOverlap<OBBAABBTest>(mPool.getCurrentAABBTreeBounds(), *mAABBTree, mWideTree, queryVolume, test, pcb);
 				}
 				else
 				{
 					const DefaultAABBAABBTest test(queryVolume);
-					again = AABBTreeOverlap<true, AABBAABBTest, AABBTree, BVHNode, OverlapCallbackAdapter>()(mPool.getCurrentAABBTreeBounds(), *mAABBTree, test, pcb);
+					again = treeOverlap<AABBAABBTest>(mPool.getCurrentAABBTreeBounds(), *mAABBTree, mWideTree, queryVolume, test, pcb);
 				}
 			}
 			break;
@@ -239,21 +280,21 @@ bool AABBPruner::overlap(const ShapeData& queryVolume, PrunerOverlapCallback& pc
 			case PxGeometryType::eCAPSULE:
 			{
 				const DefaultCapsuleAABBTest test(queryVolume, SQ_PRUNER_INFLATION);
-				again = AABBTreeOverlap<true, CapsuleAABBTest, AABBTree, BVHNode, OverlapCallbackAdapter>()(mPool.getCurrentAABBTreeBounds(), *mAABBTree, test, pcb);
+				again = treeOverlap<CapsuleAABBTest>(mPool.getCurrentAABBTreeBounds(), *mAABBTree, mWideTree, queryVolume, test, pcb);
 			}
 			break;
 
 			case PxGeometryType::eSPHERE:
 			{
 				const DefaultSphereAABBTest test(queryVolume);
-				again = AABBTreeOverlap<true, SphereAABBTest, AABBTree, BVHNode, OverlapCallbackAdapter>()(mPool.getCurrentAABBTreeBounds(), *mAABBTree, test, pcb);
+				again = treeOverlap<SphereAABBTest>(mPool.getCurrentAABBTreeBounds(), *mAABBTree, mWideTree, queryVolume, test, pcb);
 			}
 			break;
 
 			case PxGeometryType::eCONVEXMESH:
 			{
 				const DefaultOBBAABBTest test(queryVolume);
-				again = AABBTreeOverlap<true, OBBAABBTest, AABBTree, BVHNode, OverlapCallbackAdapter>()(mPool.getCurrentAABBTreeBounds(), *mAABBTree, test, pcb);
+				again = treeOverlap<OBBAABBTest>(mPool.getCurrentAABBTreeBounds(), *mAABBTree, mWideTree, queryVolume, test, pcb);
 			}
 			break;
 		default:
@@ -277,7 +318,7 @@ bool AABBPruner::sweep(const ShapeData& queryVolume, const PxVec3& unitDir, PxRe
 	{
 		RaycastCallbackAdapter pcb(pcbArgName, mPool);
 		const PxBounds3& aabb = queryVolume.getPrunerInflatedWorldAABB();
-		again = AABBTreeRaycast<true, true, AABBTree, BVHNode, RaycastCallbackAdapter>()(mPool.getCurrentAABBTreeBounds(), *mAABBTree, aabb.getCenter(), unitDir, inOutDistance, aabb.getExtents(), pcb);
+		again = treeRaycast<true>(mPool.getCurrentAABBTreeBounds(), *mAABBTree, mWideTree, aabb.getCenter(), unitDir, inOutDistance, aabb.getExtents(), pcb);
 	}
 
 	if(again && mIncrementalRebuild && mBucketPruner.getNbObjects())
@@ -295,7 +336,7 @@ bool AABBPruner::raycast(const PxVec3& origin, const PxVec3& unitDir, PxReal& in
 	if(mAABBTree)
 	{
 		RaycastCallbackAdapter pcb(pcbArgName, mPool);
-		again = AABBTreeRaycast<false, true, AABBTree, BVHNode, RaycastCallbackAdapter>()(mPool.getCurrentAABBTreeBounds(), *mAABBTree, origin, unitDir, inOutDistance, PxVec3(0.0f), pcb);
+		again = treeRaycast<false>(mPool.getCurrentAABBTreeBounds(), *mAABBTree, mWideTree, origin, unitDir, inOutDistance, PxVec3(0.0f), pcb);
 	}
 		
 	if(again && mIncrementalRebuild && mBucketPruner.getNbObjects())
@@ -373,6 +414,7 @@ void AABBPruner::commit()
 			PX_PROFILE_ZONE("SceneQuery.prunerNewTreeSwitch", mPool.mContextID);
 
 			PX_DELETE(mAABBTree); // delete the old tree
+			PX_DELETE(mWideTree); // and its wide copy, rebuilt for the new tree below
 			mCachedBoxes.release();
 			mProgress = BUILD_NOT_STARTED; // reset the build state to initial
 
@@ -435,6 +477,8 @@ void AABBPruner::commit()
 			refitUpdatedAndRemoved();
 		}
 
+		buildWideTree();
+
 		{
 			PX_PROFILE_ZONE("SceneQuery.prunerNewTreeRemoveObjects", mPool.mContextID);
 
@@ -455,6 +499,9 @@ void AABBPruner::shiftOrigin(const PxVec3& shift)
 	if(mAABBTree)
 		mAABBTree->shiftOrigin(shift);
 
+	if(mWideTree)
+		mWideTree->shiftOrigin(shift);
+
 	if(mIncrementalRebuild)
 		mBucketPruner.shiftOrigin(shift);
 
@@ -487,6 +534,19 @@ bool AABBPruner::buildStep(bool synchronousCall)
 			if(!synchronousCall || !prepareBuild())
 				return false;
 		}
+		else if(mProgress==BUILD_INIT && mBuildStrategy==BVH_BINNED_SAH)
+		{
+			// The binned SAH builder is fast enough (and parallel when a dispatcher is available) to build the whole
+			// tree in one step, so there is no progressive version of it.
+			PX_PROFILE_ZONE("SceneQuery.prunerNewTreeBinnedBuild", mPool.mContextID);
+
+			mNewTree->build(mBuilder, mNodeAllocator);
+			mProgress = BUILD_NEW_MAPPING;
+			mNbCalls = 0;
+#if PX_DEBUG
+			mNewTree->validate();
+#endif
+		}
 		else if(mProgress==BUILD_INIT)
 		{
 			mNewTree->progressiveBuild(mBuilder, mNodeAllocator, mBuildStats, 0, 0);
@@ -627,6 +687,7 @@ bool AABBPruner::prepareBuild()
 			mBuilder.mBounds		= &mCachedBoxes;
 			mBuilder.mLimit			= mNbObjectsPerNode;
 			mBuilder.mBuildStrategy	= mBuildStrategy;
+			mBuilder.mDispatcher	= mDispatcher;
 
 			mBuildStats.reset();
 
@@ -652,6 +713,7 @@ bool AABBPruner::fullRebuildAABBTree()
 
 	// Release possibly already existing tree
 	PX_DELETE(mAABBTree);
+	PX_DELETE(mWideTree);
 
 	// Don't bother building an AABB-tree if there isn't a single static object
 	const PxU32 nbObjects = mPool.getNbActiveObjects();
@@ -663,9 +725,13 @@ bool AABBPruner::fullRebuildAABBTree()
 		// Create a new tree
 		mAABBTree = PX_NEW(AABBTree);
 
-		Status = mAABBTree->build(AABBTreeBuildParams(mNbObjectsPerNode, nbObjects, &mPool.getCurrentAABBTreeBounds(), mBuildStrategy), mNodeAllocator);
+		AABBTreeBuildParams params(mNbObjectsPerNode, nbObjects, &mPool.getCurrentAABBTreeBounds(), mBuildStrategy);
+		params.mDispatcher = mDispatcher;
+		Status = mAABBTree->build(params, mNodeAllocator);
 	}
 
+	buildWideTree();
+
 	// No need for the tree map for static pruner
 	if(mIncrementalRebuild)
 		mTreeMap.initMap(PxMax(nbObjects, mNbCachedBoxes), *mAABBTree);
@@ -696,11 +762,14 @@ void AABBPruner::release() // this can be called from purge()
 	mNodeAllocator.release();
 	PX_DELETE(mNewTree);
 	PX_DELETE(mAABBTree);
+	PX_DELETE(mWideTree);
 
 	mNbCachedBoxes = 0;
 	mProgress = BUILD_NOT_STARTED;
 	mNewTreeFixups.clear();
 	mUncommittedChanges = false;
+	mBulkRefitPending = false;
+	mNbUpdatedObjects = 0;
 }
 
 // Refit current tree
@@ -719,13 +788,66 @@ void AABBPruner::refitUpdatedAndRemoved()
 
 	//### missing a way to skip work if not needed
 
+	const bool bulkRefit = mBulkRefitPending;
+	mBulkRefitPending = false;
+
 	const PxU32 nbObjects = mPool.getNbActiveObjects();
 	// At this point there still can be objects in the tree that are blanked out so it's an optimization shortcut (not required)
 	if(!nbObjects)
 		return;
 
 	mBucketPruner.refitMarkedNodes(mPool.getCurrentWorldBoxes());
-	tree->refitMarkedNodes(mPool.getCurrentWorldBoxes());
+
+	PxTime timer;
+	mRefitStats.mNbUpdatedObjects = mNbUpdatedObjects;
+	mRefitStats.mBulkRefit = bulkRefit;
+	mNbUpdatedObjects = 0;
+
+	if(bulkRefit)
+	{
+		PX_PROFILE_ZONE("SceneQuery.prunerBulkRefit", mPool.mContextID);
+
+		// The whole tree is refit, so nodes marked by removals or by smaller batches don't need a separate pass
+		tree->clearRefitMarks();
+		tree->fullRefitParallel(mPool.getCurrentWorldBoxes(), mDispatcher);
+		if(mWideTree)
+			mWideTree->requantize(tree->getNodes());
+
+		mRefitStats.mNbRefitNodes = tree->getNbNodes();
+	}
+	else if(mWideTree)
+	{
+		mRefitStats.mNbRefitNodes = tree->getNbMarkedNodes();
+
+		// The binary refit clears the refit bitmask, so we keep a copy of it to update the same nodes in the wide tree
+		const PxU32 nbWords = tree->getNbRefitWords();
+		mWideTreeRefitBits.resizeUninitialized(nbWords);
+		if(nbWords)
+			PxMemCopy(mWideTreeRefitBits.begin(), tree->getRefitBits(), nbWords*sizeof(PxU32));
+
+		tree->refitMarkedNodes(mPool.getCurrentWorldBoxes());
+		mWideTree->refitMarkedNodes(tree->getNodes(), mWideTreeRefitBits.begin(), nbWords);
+	}
+	else
+	{
+		mRefitStats.mNbRefitNodes = tree->getNbMarkedNodes();
+		tree->refitMarkedNodes(mPool.getCurrentWorldBoxes());
+	}
+
+	mRefitStats.mRefitTime = PxReal(timer.getElapsedSeconds());
+}
+
+void AABBPruner::buildWideTree()
+{
+	PX_DELETE(mWideTree);
+	if(!mUseWideTree || !mAABBTree)
+		return;
+
+	PX_PROFILE_ZONE("SceneQuery.prunerBuildWideTree", mPool.mContextID);
+
+	mWideTree = PX_NEW(WideAABBTree);
+	if(!mWideTree->build(*mAABBTree))
+		PX_DELETE(mWideTree);
 }
 
 void AABBPruner::merge(const void* mergeParams)
@@ -748,6 +870,7 @@ void AABBPruner::merge(const void* mergeParams)
 		{
 			// merge tree directly
 			mAABBTree->mergeTree(aabbTreeMergeParams);		
+			buildWideTree();
 		}
 		else
 		{
@@ -36,6 +36,7 @@
 #include "GuAABBTree.h"
 #include "GuAABBTreeUpdateMap.h"
 #include "GuAABBTreeBuildStats.h"
+#include "GuWideAABBTree.h"
 
 namespace physx
 {
@@ -110,6 +111,7 @@ namespace Gu
 
 	// This class implements the Pruner interface for internal SQ use with some additional specialized functions
 	// The underlying data structure is a binary AABB tree
+	// Optionally, queries can use a 4-wide quantized copy of that tree (WideAABBTree), kept in sync with it in commit()
 	// AABBPruner supports insertions, removals and updates for dynamic objects
 	// The tree is either entirely rebuilt in a single frame (static pruner) or progressively rebuilt over multiple frames (dynamic pruner)
 	// The rebuild happens on a copy of the tree
@@ -126,7 +128,7 @@ namespace Gu
 	{
 												PX_NOCOPY(AABBPruner)
 		public:
-		PX_PHYSX_COMMON_API						AABBPruner(bool incrementalRebuild, PxU64 contextID, CompanionPrunerType cpType, BVHBuildStrategy buildStrategy=BVH_SPLATTER_POINTS, PxU32 nbObjectsPerNode=4); // true is equivalent to former dynamic pruner
+		PX_PHYSX_COMMON_API						AABBPruner(bool incrementalRebuild, PxU64 contextID, CompanionPrunerType cpType, BVHBuildStrategy buildStrategy=BVH_SPLATTER_POINTS, PxU32 nbObjectsPerNode=4, PxCpuDispatcher* dispatcher=NULL, bool wideTree=false); // true is equivalent to former dynamic pruner
 		virtual									~AABBPruner();
 
 		// BasePruner
@@ -142,6 +144,7 @@ namespace Gu
 		virtual			void					setRebuildRateHint(PxU32 nbStepsForRebuild);	// Besides the actual rebuild steps, 3 additional steps are needed.
 		virtual			bool					buildStep(bool synchronousCall = true);	// returns true if finished
 		virtual			bool					prepareBuild();	// returns true if new tree is needed
+		virtual			void					getRefitStats(PrunerRefitStats& stats)	const	{ stats = mRefitStats;	}
 		//~DynamicPruner
 
 		// direct access for test code
@@ -152,12 +155,14 @@ namespace Gu
 		PX_FORCE_INLINE	void					setAABBTree(AABBTree* tree)		{ mAABBTree = tree; }
 		PX_FORCE_INLINE	const AABBTree*			hasAABBTree()		const		{ return mAABBTree;	}
 		PX_FORCE_INLINE	BuildStatus				getBuildStatus()	const		{ return mProgress;	}
+		PX_FORCE_INLINE	const WideAABBTree*		getWideTree()		const		{ PX_ASSERT(!mUncommittedChanges); return mWideTree;	}
 				
 		// local functions
 //		private:
 						NodeAllocator			mNodeAllocator;
 
 						AABBTree*				mAABBTree; // current active tree
+						WideAABBTree*			mWideTree; // wide copy of mAABBTree used by queries, if enabled
 						AABBTreeBuildParams		mBuilder; // this class deals with the details of the actual tree building
 						BuildStats				mBuildStats;
 
@@ -200,6 +205,10 @@ namespace Gu
 
 			const		PxU32					mNbObjectsPerNode;
 			const		BVHBuildStrategy		mBuildStrategy;
+						PxCpuDispatcher*		mDispatcher;	// Optional, for the BVH_BINNED_SAH strategy and for bulk refits
+			const		bool					mUseWideTree;
+		// copy of the tree's refit bitmask, needed to update the wide tree after the binary refit cleared it
+						PxArray<PxU32>			mWideTreeRefitBits;
 
 						PruningPool				mPool; // Pool of AABBs
 
@@ -250,10 +259,17 @@ namespace Gu
 
 						PxArray<PoolIndex>		mToRefit;
 
+		// Set when a large batch of objects got updated. The next refit then updates the whole tree instead of the marked nodes.
+						bool					mBulkRefitPending;
+		// Number of objects updated since the last refit, and statistics about that refit
+						PxU32					mNbUpdatedObjects;
+						PrunerRefitStats		mRefitStats;
+
 		// Internal methods
 						bool					fullRebuildAABBTree(); // full rebuild function, used with static pruner mode
 						void					release();
 						void					refitUpdatedAndRemoved();
+						void					buildWideTree();
 						void					updateBucketPruner();
 	};
 
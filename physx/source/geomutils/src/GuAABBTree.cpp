@@ -32,8 +32,13 @@
 #include "GuBounds.h"
 #include "GuAABBTreeNode.h"
 #include "GuSAH.h"
+#include "GuBinnedSAH.h"
+#include "GuParallelJobs.h"
 #include "foundation/PxMathUtils.h"
 #include "foundation/PxFPU.h"
+#include "foundation/PxBitUtils.h"
+#include "foundation/PxInlineArray.h"
+#include "task/PxCpuDispatcher.h"
 
 using namespace physx;
 using namespace Gu;
@@ -105,6 +110,38 @@ void NodeAllocator::init(PxU32 nbPrimitives, PxU32 limit)
 	mTotalNbNodes = 1;
 }
 
+void NodeAllocator::initSubtree(PxU32 nbPrimitives, PxU32 limit)
+{
+	PX_ASSERT(nbPrimitives);
+	const PxU32 maxSize = nbPrimitives * 2 - 2;	// Max possible #nodes below the root for a complete tree
+	const PxU32 estimatedFinalSize = PxMax(maxSize <= 1024 ? maxSize : maxSize / limit, PxU32(2));
+	mPool = PX_NEW(AABBTreeBuildNode)[estimatedFinalSize];
+	PxMemZero(mPool, sizeof(AABBTreeBuildNode)*estimatedFinalSize);
+
+	mSlabs.pushBack(Slab(mPool, 0, estimatedFinalSize));
+	mCurrentSlabIndex = 0;
+	mTotalNbNodes = 0;
+}
+
+void NodeAllocator::append(NodeAllocator& other)
+{
+	const PxU32 nbSlabs = other.mSlabs.size();
+	if(!nbSlabs)
+		return;
+
+	for(PxU32 i=0;i<nbSlabs;i++)
+		mSlabs.pushBack(other.mSlabs[i]);
+
+	mCurrentSlabIndex = mSlabs.size() - 1;
+	mTotalNbNodes += other.mTotalNbNodes;
+
+	// The slabs are owned by this allocator now
+	other.mSlabs.reset();
+	other.mPool = NULL;
+	other.mCurrentSlabIndex = 0;
+	other.mTotalNbNodes = 0;
+}
+
 // PT: TODO: inline this?
 AABBTreeBuildNode* NodeAllocator::getBiNode()
 {
@@ -413,6 +450,8 @@ PxU32* Gu::buildAABBTree(const AABBTreeBuildParams& params, NodeAllocator& nodeA
 		SAH_Buffers buffers(params.mNbPrimitives);
 		nodeAllocator.mPool->_buildHierarchySAH(params, buffers, stats, nodeAllocator, indices);
 	}
+	else if(params.mBuildStrategy==BVH_BINNED_SAH)
+		buildHierarchyBinnedSAH(params, nodeAllocator, stats, indices);
 	else
 		nodeAllocator.mPool->_buildHierarchy(params, stats, nodeAllocator, indices);
 
@@ -758,6 +797,120 @@ void BVHCoreData::fullRefit(const PxBounds3* boxes)
 		refitLoop<0>(boxes, mNodes, mIndices, mNbNodes);
 }
 
+// Subtrees are only refit in parallel for trees larger than this
+#define PARALLEL_REFIT_MIN_NB_NODES		4096
+// Target number of subtrees per worker thread, to balance the load of unbalanced trees
+#define PARALLEL_REFIT_SUBTREES_PER_WORKER	4
+#define PARALLEL_REFIT_MAX_NB_SUBTREES		256
+
+namespace
+{
+	struct ParallelRefitContext
+	{
+		const PxBounds3*	mBoxes;
+		const PxU32*		mIndices;
+		BVHNode*			mNodes;
+		const PxU32*		mSubtreeRoots;
+	};
+}
+
+// Bottom-up refit of the subtree below a node. The flat node order of the whole tree cannot be used here, since the nodes
+// of a subtree are not contiguous, so we do a post-order traversal instead: a node is refit after both of its children.
+template<const bool hasIndices>
+static void refitSubtree(const PxBounds3* PX_RESTRICT boxes, BVHNode* const PX_RESTRICT nodeBase, const PxU32* PX_RESTRICT indices, PxU32 rootIndex)
+{
+	PxInlineArray<PxU32, 256> stack;
+	stack.pushBack(rootIndex<<1);
+	while(stack.size())
+	{
+		// Bit 0 is set when the children of the node have already been processed
+		const PxU32 entry = stack.popBack();
+		BVHNode* node = nodeBase + (entry>>1);
+		if((entry & 1) || node->isLeaf())
+		{
+			refitNode<hasIndices>(node, boxes, indices, nodeBase);
+		}
+		else
+		{
+			const PxU32 posIndex = node->getPosIndex();
+			stack.pushBack(entry|1);
+			stack.pushBack(posIndex<<1);
+			stack.pushBack((posIndex+1)<<1);
+		}
+	}
+}
+
+static void refitSubtreeJob(void* userData, PxU32 jobIndex)
+{
+	const ParallelRefitContext* context = reinterpret_cast<const ParallelRefitContext*>(userData);
+	const PxU32 rootIndex = context->mSubtreeRoots[jobIndex];
+	if(context->mIndices)
+		refitSubtree<1>(context->mBoxes, context->mNodes, context->mIndices, rootIndex);
+	else
+		refitSubtree<0>(context->mBoxes, context->mNodes, context->mIndices, rootIndex);
+}
+
+void BVHCoreData::fullRefitParallel(const PxBounds3* boxes, PxCpuDispatcher* dispatcher)
+{
+	const PxU32 nbWorkers = dispatcher ? dispatcher->getWorkerCount() : 0;
+	if(!nbWorkers || mNbNodes<PARALLEL_REFIT_MIN_NB_NODES)
+	{
+		fullRefit(boxes);
+		return;
+	}
+
+	// Split the top of the tree breadth-first until we have enough subtrees. The split nodes are recorded in topNodes,
+	// where children always appear after their parent.
+	const PxU32 nbWanted = PxMin(nbWorkers * PARALLEL_REFIT_SUBTREES_PER_WORKER, PxU32(PARALLEL_REFIT_MAX_NB_SUBTREES));
+	PxInlineArray<PxU32, PARALLEL_REFIT_MAX_NB_SUBTREES> subtrees;
+	PxInlineArray<PxU32, PARALLEL_REFIT_MAX_NB_SUBTREES> topNodes;
+	subtrees.pushBack(0);
+	PxU32 cursor = 0;
+	bool splitSome = false;
+	while(subtrees.size()<nbWanted)
+	{
+		if(cursor==subtrees.size())
+		{
+			// All remaining subtrees are leaves
+			if(!splitSome)
+				break;
+			cursor = 0;
+			splitSome = false;
+		}
+
+		const PxU32 nodeIndex = subtrees[cursor];
+		const BVHNode& node = mNodes[nodeIndex];
+		if(node.isLeaf())
+		{
+			cursor++;
+			continue;
+		}
+
+		topNodes.pushBack(nodeIndex);
+		subtrees[cursor++] = node.getPosIndex();
+		subtrees.pushBack(node.getNegIndex());
+		splitSome = true;
+	}
+
+	ParallelRefitContext context;
+	context.mBoxes			= boxes;
+	context.mIndices		= mIndices;
+	context.mNodes			= mNodes;
+	context.mSubtreeRoots	= subtrees.begin();
+	runJobs(dispatcher, refitSubtreeJob, &context, subtrees.size());
+
+	// Then the nodes above the subtrees, children first
+	PxU32 nbTopNodes = topNodes.size();
+	while(nbTopNodes--)
+	{
+		BVHNode* current = mNodes + topNodes[nbTopNodes];
+		if(mIndices)
+			refitNode<1>(current, boxes, mIndices, mNodes);
+		else
+			refitNode<0>(current, boxes, mIndices, mNodes);
+	}
+}
+
 void BVHPartialRefitData::markNodeForRefit(TreeNodeIndex nodeIndex)
 {
 	BitArray* PX_RESTRICT refitBitmask = &mRefitBitmask;
@@ -927,6 +1080,28 @@ void BVHPartialRefitData::refitMarkedNodes(const PxBounds3* boxes)
 }
 #endif
 
+void BVHPartialRefitData::clearRefitMarks()
+{
+	PxU32* bits = const_cast<PxU32*>(mRefitBitmask.getBits());
+	if(!bits)
+		return;
+
+	PxMemZero(bits, (mRefitHighestSetWord+1)*sizeof(PxU32));
+	mRefitHighestSetWord = 0;
+}
+
+PxU32 BVHPartialRefitData::getNbMarkedNodes() const
+{
+	const PxU32* bits = mRefitBitmask.getBits();
+	if(!bits)
+		return 0;
+
+	PxU32 nb = 0;
+	for(PxU32 i=0;i<=mRefitHighestSetWord;i++)
+		nb += PxBitCount(bits[i]);
+	return nb;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 AABBTree::AABBTree() : mTotalPrims(0)
@@ -38,6 +38,8 @@
 
 namespace physx
 {
+	class PxCpuDispatcher;
+
 namespace Gu
 {
 	struct BVHNode;
@@ -61,7 +63,8 @@ namespace Gu
 									mNbPrimitives	(nb_prims),
 									mBounds			(bounds),
 									mCache			(NULL),
-									mBuildStrategy	(bs)
+									mBuildStrategy	(bs),
+									mDispatcher		(NULL)
 								{
 								}
 								~AABBTreeBuildParams()
@@ -81,6 +84,7 @@ namespace Gu
 		const AABBTreeBounds*	mBounds;		//!< Shortcut to an app-controlled array of AABBs.
 		mutable PxVec3*			mCache;			//!< Cache for AABB centers - managed by build code.
 		BVHBuildStrategy		mBuildStrategy;
+		PxCpuDispatcher*		mDispatcher;	//!< Optional dispatcher used by the BVH_BINNED_SAH strategy. The build is serial if NULL.
 	};
 
 	//! AABB tree node used for building
@@ -129,6 +133,10 @@ namespace Gu
 
 		void						release();
 		void						init(PxU32 nbPrimitives, PxU32 limit);
+		// Sets up an allocator for the children of a node owned by another allocator. The root node is not allocated here.
+		void						initSubtree(PxU32 nbPrimitives, PxU32 limit);
+		// Moves all slabs of another allocator to the end of this one. The other allocator is left empty.
+		void						append(NodeAllocator& other);
 		AABBTreeBuildNode*			getBiNode();
 
 		AABBTreeBuildNode*			mPool;
@@ -251,6 +259,8 @@ namespace Gu
 		PX_FORCE_INLINE			BVHNode*		getNodes()					{ return mNodes;		}
 
 		PX_PHYSX_COMMON_API		void			fullRefit(const PxBounds3* boxes);
+		// Same as fullRefit, but independent subtrees are refit in parallel on the workers of the dispatcher
+		PX_PHYSX_COMMON_API		void			fullRefitParallel(const PxBounds3* boxes, PxCpuDispatcher* dispatcher);
 
 		// PT: I'm leaving the above accessors here to avoid refactoring the SQ code using them, but members became public.
 								PxU32			mNbIndices;	//!< Nb indices
@@ -270,9 +280,16 @@ namespace Gu
 		// Note that this includes updating the hierarchy up the chain
 		PX_PHYSX_COMMON_API		void			markNodeForRefit(TreeNodeIndex nodeIndex);
 		PX_PHYSX_COMMON_API		void			refitMarkedNodes(const PxBounds3* boxes);
+		// Discards the nodes marked for refit, e.g. when a full refit made the marks obsolete
+		PX_PHYSX_COMMON_API		void			clearRefitMarks();
+		PX_PHYSX_COMMON_API		PxU32			getNbMarkedNodes()	const;
 
 		PX_FORCE_INLINE			PxU32*			getUpdateMap()	{ return mUpdateMap;	}
 
+		// Nodes marked for refit, valid until the next refitMarkedNodes call
+		PX_FORCE_INLINE			const PxU32*	getRefitBits()		const	{ return mRefitBitmask.getBits();								}
+		PX_FORCE_INLINE			PxU32			getNbRefitWords()	const	{ return mRefitBitmask.getBits() ? mRefitHighestSetWord+1 : 0;	}
+
 		protected:
 								PxU32*			mParentIndices;		//!< PT: hot/cold split, keep parent data in separate array
 								PxU32*			mUpdateMap;			//!< PT: Local index to tree node index
@@ -29,6 +29,7 @@
 #include "foundation/PxFoundation.h"
 #include "foundation/PxFPU.h"
 #include "foundation/PxPlane.h"
+#include "foundation/PxBitUtils.h"
 #include "geometry/PxGeometryInternal.h"
 #include "GuBVH.h"
 #include "GuAABBTreeQuery.h"
@@ -697,6 +698,244 @@ bool BVH::cull(PxU32 nbPlanes, const PxPlane* planes, OverlapCallback& cb, PxGeo
 	}
 }
 
+namespace
+{
+	// Four planes in SoA form. Unused slots are filled with a plane that never rejects anything (n=0, d=-1).
+	struct PlaneGroup4
+	{
+		PxVec4	mNx, mNy, mNz, mD;
+		PxVec4	mAbsNx, mAbsNy, mAbsNz;
+	};
+
+	enum FrustumClassification
+	{
+		FRUSTUM_OUTSIDE,
+		FRUSTUM_INSIDE,
+		FRUSTUM_STRADDLING
+	};
+
+	// Same test as planesAABBOverlap, for 4 planes at a time
+	PX_FORCE_INLINE FrustumClassification classifyBox(	const PlaneGroup4* PX_RESTRICT groups, PxU32 nbGroups,
+														const Vec4V cx, const Vec4V cy, const Vec4V cz,
+														const Vec4V ex, const Vec4V ey, const Vec4V ez)
+	{
+		BoolV straddling = BFFFF();
+		for(PxU32 i=0;i<nbGroups;i++)
+		{
+			const PlaneGroup4& g = groups[i];
+			const Vec4V MP = V4MulAdd(V4LoadU(&g.mNx.x), cx, V4MulAdd(V4LoadU(&g.mNy.x), cy, V4MulAdd(V4LoadU(&g.mNz.x), cz, V4LoadU(&g.mD.x))));
+			const Vec4V NP = V4MulAdd(V4LoadU(&g.mAbsNx.x), ex, V4MulAdd(V4LoadU(&g.mAbsNy.x), ey, V4Mul(V4LoadU(&g.mAbsNz.x), ez)));
+
+			if(BGetBitMask(V4IsGrtr(MP, NP)))
+				return FRUSTUM_OUTSIDE;
+
+			straddling = BOr(straddling, V4IsGrtr(MP, V4Neg(NP)));
+		}
+		return BGetBitMask(straddling) ? FRUSTUM_STRADDLING : FRUSTUM_INSIDE;
+	}
+
+	struct MultiFrustumEntry
+	{
+		const BVHNode*	mNode;
+		PxU32			mActive;	// Frusta for which the node straddles at least one plane
+		PxU32			mInside;	// Frusta for which the node is fully visible
+	};
+
+	class MultiFrustumCuller
+	{
+		PX_NOCOPY(MultiFrustumCuller)
+		public:
+			MultiFrustumCuller(PxU32 nbFrusta, const PxBVH::Frustum* frusta, PxU32 maxNbIndicesPerFrustum, PxU32* indices, PxU32* nbIndices) :
+				mMaxNbIndices	(maxNbIndicesPerFrustum),
+				mIndices		(indices),
+				mNbIndices		(nbIndices),
+				mOverflow		(false)
+			{
+				mGroupOffsets.resizeUninitialized(nbFrusta+1);
+
+				PxU32 nbGroups = 0;
+				for(PxU32 i=0;i<nbFrusta;i++)
+				{
+					mGroupOffsets[i] = nbGroups;
+					nbGroups += (frusta[i].nbPlanes + 3)>>2;
+				}
+				mGroupOffsets[nbFrusta] = nbGroups;
+
+				mGroups.resizeUninitialized(nbGroups);
+				for(PxU32 i=0;i<nbFrusta;i++)
+				{
+					const PxPlane* planes = frusta[i].planes;
+					const PxU32 nbPlanes = frusta[i].nbPlanes;
+					PlaneGroup4* groups = mGroups.begin() + mGroupOffsets[i];
+					for(PxU32 j=0;j<mGroupOffsets[i+1]-mGroupOffsets[i];j++)
+					{
+						PlaneGroup4& g = groups[j];
+						for(PxU32 k=0;k<4;k++)
+						{
+							const PxU32 planeIndex = j*4+k;
+							const PxPlane p = planeIndex<nbPlanes ? planes[planeIndex] : PxPlane(0.0f, 0.0f, 0.0f, -1.0f);
+							g.mNx[k] = p.n.x;
+							g.mNy[k] = p.n.y;
+							g.mNz[k] = p.n.z;
+							g.mD[k] = p.d;
+							g.mAbsNx[k] = PxAbs(p.n.x);
+							g.mAbsNy[k] = PxAbs(p.n.y);
+							g.mAbsNz[k] = PxAbs(p.n.z);
+						}
+					}
+				}
+			}
+
+			// Classifies a box against the frusta in 'active', with frustum indices relative to 'base'. Returns the
+			// frusta for which the box straddles a plane, and adds the ones fully containing the box to 'inside'.
+			PX_FORCE_INLINE PxU32 classify(PxU32 base, PxU32 active, PxU32& inside, const Vec3V center, const Vec3V extents)	const
+			{
+				const Vec4V c = Vec4V_From_Vec3V(center);
+				const Vec4V e = Vec4V_From_Vec3V(extents);
+				const Vec4V cx = V4SplatElement<0>(c);
+				const Vec4V cy = V4SplatElement<1>(c);
+				const Vec4V cz = V4SplatElement<2>(c);
+				const Vec4V ex = V4SplatElement<0>(e);
+				const Vec4V ey = V4SplatElement<1>(e);
+				const Vec4V ez = V4SplatElement<2>(e);
+
+				PxU32 straddling = 0;
+				while(active)
+				{
+					const PxU32 bit = PxLowestSetBit(active);
+					active &= active - 1;
+
+					const PxU32 frustumIndex = base + bit;
+					const PxU32 offset = mGroupOffsets[frustumIndex];
+					const FrustumClassification fc = classifyBox(mGroups.begin() + offset, mGroupOffsets[frustumIndex+1] - offset, cx, cy, cz, ex, ey, ez);
+					if(fc==FRUSTUM_STRADDLING)
+						straddling |= 1<<bit;
+					else if(fc==FRUSTUM_INSIDE)
+						inside |= 1<<bit;
+				}
+				return straddling;
+			}
+
+			PX_FORCE_INLINE void output(PxU32 base, PxU32 visible, PxU32 primIndex)
+			{
+				while(visible)
+				{
+					const PxU32 frustumIndex = base + PxLowestSetBit(visible);
+					visible &= visible - 1;
+
+					const PxU32 nb = mNbIndices[frustumIndex];
+					if(nb<mMaxNbIndices)
+					{
+						mIndices[frustumIndex*mMaxNbIndices + nb] = primIndex;
+						mNbIndices[frustumIndex] = nb + 1;
+					}
+					else
+						mOverflow = true;
+				}
+			}
+
+			PxInlineArray<PlaneGroup4, 16>	mGroups;
+			PxInlineArray<PxU32, 33>		mGroupOffsets;
+			const PxU32						mMaxNbIndices;
+			PxU32*							mIndices;
+			PxU32*							mNbIndices;
+			bool							mOverflow;
+	};
+}
+
+bool BVH::cullFrusta(PxU32 nbFrusta, const Frustum* frusta, PxU32 maxNbIndicesPerFrustum, PxU32* indices, PxU32* nbIndices, PxGeometryQueryFlags flags) const
+{
+	PX_SIMD_GUARD_CNDT(flags & PxGeometryQueryFlag::eSIMD_GUARD)
+
+	for(PxU32 i=0;i<nbFrusta;i++)
+		nbIndices[i] = 0;
+
+	if(!nbFrusta || !mData.mNodes)
+		return true;
+
+	MultiFrustumCuller culler(nbFrusta, frusta, maxNbIndicesPerFrustum, indices, nbIndices);
+
+	const PxBounds3* bounds = mData.mBounds.getBounds();
+	const PxU32* primIndices = mData.mIndices;
+	const BVHNode* const nodeBase = mData.mNodes;
+
+	PxInlineArray<MultiFrustumEntry, RAW_TRAVERSAL_STACK_SIZE> stack;
+	stack.forceSize_Unsafe(RAW_TRAVERSAL_STACK_SIZE);
+
+	// The frusta are processed in groups of 32, using one bit per frustum in the traversal masks
+	for(PxU32 base=0; base<nbFrusta; base+=32)
+	{
+		const PxU32 nbInGroup = PxMin(nbFrusta - base, 32u);
+
+		stack[0].mNode = nodeBase;
+		stack[0].mActive = nbInGroup==32 ? 0xffffffff : (1u<<nbInGroup)-1;
+		stack[0].mInside = 0;
+		PxU32 stackIndex = 1;
+
+		while(stackIndex > 0)
+		{
+			const MultiFrustumEntry& entry = stack[--stackIndex];
+			const BVHNode* node = entry.mNode;
+			PxU32 active = entry.mActive;
+			PxU32 inside = entry.mInside;
+
+			while(1)
+			{
+				// Once a node is fully inside a frustum its whole subtree is, so only the remaining frusta are tested
+				if(active)
+				{
+					Vec3V center, extents;
+					node->getAABBCenterExtentsV(&center, &extents);
+					active = culler.classify(base, active, inside, center, extents);
+					if(!(active|inside))
+						break;
+				}
+
+				if(node->isLeaf())
+				{
+					PxU32 nbPrims = node->getNbPrimitives();
+					// Same as in cull(), a single primitive has the bounds of its leaf so we skip the redundant test
+					const bool doBoxTest = active && nbPrims > 1;
+					const PxU32* prims = primIndices ? node->getPrimitives(primIndices) : NULL;
+					while(nbPrims--)
+					{
+						const PxU32 primIndex = primIndices ? *prims++ : node->getPrimitiveIndex();
+
+						PxU32 visible = inside;
+						if(doBoxTest)
+						{
+							Vec4V center2, extents2;
+							getBoundsTimesTwo(center2, extents2, bounds, primIndex);
+
+							const FloatV halfV = FLoad(0.5f);
+							const Vec3V extents_ = Vec3V_From_Vec4V(V4Scale(extents2, halfV));
+							const Vec3V center_ = Vec3V_From_Vec4V(V4Scale(center2, halfV));
+
+							visible |= culler.classify(base, active, visible, center_, extents_);
+						}
+						else
+							visible |= active;
+
+						culler.output(base, visible, primIndex);
+					}
+					break;
+				}
+
+				const BVHNode* children = node->getPos(nodeBase);
+				node = children;
+
+				MultiFrustumEntry& next = stack[stackIndex++];
+				next.mNode = children + 1;
+				next.mActive = active;
+				next.mInside = inside;
+				if(stackIndex == stack.capacity())
+					stack.resizeUninitialized(stack.capacity() * 2);
+			}
+		}
+	}
+	return !culler.mOverflow;
+}
+
 void BVH::refit()
 {
 	mData.fullRefit(mData.mBounds.getBounds());
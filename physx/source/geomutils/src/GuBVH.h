@@ -107,6 +107,7 @@ namespace Gu
 		virtual				bool				overlap(const PxGeometry& geom, const PxTransform& pose, OverlapCallback& cb, PxGeometryQueryFlags flags)										const	/*override*/;
 		virtual				bool				sweep(const PxGeometry& geom, const PxTransform& pose, const PxVec3& unitDir, float distance, RaycastCallback& cb, PxGeometryQueryFlags flags)	const	/*override*/;
 		virtual				bool				cull(PxU32 nbPlanes, const PxPlane* planes, OverlapCallback& cb, PxGeometryQueryFlags flags)													const	/*override*/;
+		virtual				bool				cullFrusta(PxU32 nbFrusta, const Frustum* frusta, PxU32 maxNbIndicesPerFrustum, PxU32* indices, PxU32* nbIndices, PxGeometryQueryFlags flags)	const	/*override*/;
 
 		virtual				PxU32				raycast(const PxVec3& origin, const PxVec3& unitDir, PxReal maxDist, PxU32 maxHits, PxU32* PX_RESTRICT rayHits)									const	/*override*/;
 		virtual				PxU32				sweep(const PxBounds3& aabb, const PxVec3& unitDir, PxReal maxDist, PxU32 maxHits, PxU32* PX_RESTRICT sweepHits)								const	/*override*/;
@@ -0,0 +1,438 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2023 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "foundation/PxArray.h"
+#include "foundation/PxVecMath.h"
+#include "task/PxCpuDispatcher.h"
+#include "GuBinnedSAH.h"
+#include "GuAABBTree.h"
+#include "GuAABBTreeBounds.h"
+#include "GuAABBTreeBuildStats.h"
+#include "GuBounds.h"
+#include "GuParallelJobs.h"
+
+using namespace physx;
+using namespace Gu;
+using namespace aos;
+
+#define BINNED_SAH_NB_BINS			16
+// Nodes with more primitives than this are binned by several threads
+#define BINNED_SAH_PARALLEL_BINNING	(1<<15)
+// Number of primitives binned by each job for these nodes
+#define BINNED_SAH_BINNING_CHUNK	(1<<13)
+// Subtrees smaller than this are never split into several jobs
+#define BINNED_SAH_MIN_SUBTREE		1024
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+	struct RangeBounds
+	{
+		Vec4V	mBoxMin;
+		Vec4V	mBoxMax;
+		Vec4V	mCenterMin;
+		Vec4V	mCenterMax;
+
+		PX_FORCE_INLINE	void	merge(const RangeBounds& other)
+		{
+			mBoxMin = V4Min(mBoxMin, other.mBoxMin);
+			mBoxMax = V4Max(mBoxMax, other.mBoxMax);
+			mCenterMin = V4Min(mCenterMin, other.mCenterMin);
+			mCenterMax = V4Max(mCenterMax, other.mCenterMax);
+		}
+	};
+
+	struct Bins
+	{
+		Vec4V	mMin[3][BINNED_SAH_NB_BINS];
+		Vec4V	mMax[3][BINNED_SAH_NB_BINS];
+		PxU32	mCounts[3][BINNED_SAH_NB_BINS];
+
+		void	reset()
+		{
+			const Vec4V minV = V4Load(PX_MAX_F32);
+			const Vec4V maxV = V4Load(-PX_MAX_F32);
+			for(PxU32 axis=0;axis<3;axis++)
+			{
+				for(PxU32 i=0;i<BINNED_SAH_NB_BINS;i++)
+				{
+					mMin[axis][i] = minV;
+					mMax[axis][i] = maxV;
+					mCounts[axis][i] = 0;
+				}
+			}
+		}
+
+		void	merge(const Bins& other)
+		{
+			for(PxU32 axis=0;axis<3;axis++)
+			{
+				for(PxU32 i=0;i<BINNED_SAH_NB_BINS;i++)
+				{
+					mMin[axis][i] = V4Min(mMin[axis][i], other.mMin[axis][i]);
+					mMax[axis][i] = V4Max(mMax[axis][i], other.mMax[axis][i]);
+					mCounts[axis][i] += other.mCounts[axis][i];
+				}
+			}
+		}
+	};
+
+	// Shared data for the parallel binning of a large node
+	struct BinningContext
+	{
+		Vec4V						mCenterMin;
+		Vec4V						mBinScale;
+		const PxU32*				mPrims;
+		const PxBounds3*			mBoxes;
+		const PxVec3*				mCenters;
+		PxU32						mNbPrims;
+		RangeBounds*				mRangeBounds;
+		Bins*						mBins;
+	};
+}
+
+static PX_FORCE_INLINE void computeBinIndices(PxU32* PX_RESTRICT binIndices, const Vec4V centerV, const Vec4V centerMinV, const Vec4V binScaleV)
+{
+	PX_ALIGN(16, PxVec4) bins;
+	V4StoreA(V4Mul(V4Sub(centerV, centerMinV), binScaleV), &bins.x);
+	binIndices[0] = PxMin(PxU32(bins.x), PxU32(BINNED_SAH_NB_BINS-1));
+	binIndices[1] = PxMin(PxU32(bins.y), PxU32(BINNED_SAH_NB_BINS-1));
+	binIndices[2] = PxMin(PxU32(bins.z), PxU32(BINNED_SAH_NB_BINS-1));
+}
+
+static void computeRangeBounds(RangeBounds& bounds, PxU32 nb, const PxU32* PX_RESTRICT prims, const PxBounds3* PX_RESTRICT boxes, const PxVec3* PX_RESTRICT centers)
+{
+	Vec4V boxMinV = V4Load(PX_MAX_F32);
+	Vec4V boxMaxV = V4Load(-PX_MAX_F32);
+	Vec4V centerMinV = boxMinV;
+	Vec4V centerMaxV = boxMaxV;
+	for(PxU32 i=0;i<nb;i++)
+	{
+		const PxU32 index = prims[i];
+		const Vec4V centerV = V4LoadU(&centers[index].x);
+		boxMinV = V4Min(boxMinV, V4LoadU(&boxes[index].minimum.x));
+		boxMaxV = V4Max(boxMaxV, V4LoadU(&boxes[index].maximum.x));
+		centerMinV = V4Min(centerMinV, centerV);
+		centerMaxV = V4Max(centerMaxV, centerV);
+	}
+	bounds.mBoxMin = boxMinV;
+	bounds.mBoxMax = boxMaxV;
+	bounds.mCenterMin = centerMinV;
+	bounds.mCenterMax = centerMaxV;
+}
+
+static void binRange(Bins& bins, PxU32 nb, const PxU32* PX_RESTRICT prims, const PxBounds3* PX_RESTRICT boxes, const PxVec3* PX_RESTRICT centers, const Vec4V centerMinV, const Vec4V binScaleV)
+{
+	bins.reset();
+	for(PxU32 i=0;i<nb;i++)
+	{
+		const PxU32 index = prims[i];
+		const Vec4V boxMinV = V4LoadU(&boxes[index].minimum.x);
+		const Vec4V boxMaxV = V4LoadU(&boxes[index].maximum.x);
+
+		PxU32 binIndices[3];
+		computeBinIndices(binIndices, V4LoadU(&centers[index].x), centerMinV, binScaleV);
+		for(PxU32 axis=0;axis<3;axis++)
+		{
+			const PxU32 binIndex = binIndices[axis];
+			bins.mMin[axis][binIndex] = V4Min(bins.mMin[axis][binIndex], boxMinV);
+			bins.mMax[axis][binIndex] = V4Max(bins.mMax[axis][binIndex], boxMaxV);
+			bins.mCounts[axis][binIndex]++;
+		}
+	}
+}
+
+static void computeRangeBoundsJob(void* userData, PxU32 jobIndex)
+{
+	const BinningContext* context = reinterpret_cast<const BinningContext*>(userData);
+	const PxU32 start = jobIndex * BINNED_SAH_BINNING_CHUNK;
+	const PxU32 nb = PxMin(context->mNbPrims - start, PxU32(BINNED_SAH_BINNING_CHUNK));
+	computeRangeBounds(context->mRangeBounds[jobIndex], nb, context->mPrims + start, context->mBoxes, context->mCenters);
+}
+
+static void binRangeJob(void* userData, PxU32 jobIndex)
+{
+	const BinningContext* context = reinterpret_cast<const BinningContext*>(userData);
+	const PxU32 start = jobIndex * BINNED_SAH_BINNING_CHUNK;
+	const PxU32 nb = PxMin(context->mNbPrims - start, PxU32(BINNED_SAH_BINNING_CHUNK));
+	binRange(context->mBins[jobIndex], nb, context->mPrims + start, context->mBoxes, context->mCenters, context->mCenterMin, context->mBinScale);
+}
+
+static PX_FORCE_INLINE float getHalfSurfaceArea(const Vec4V minV, const Vec4V maxV)
+{
+	PX_ALIGN(16, PxVec4) e;
+	V4StoreA(V4Sub(maxV, minV), &e.x);
+	return e.x * e.y + e.y * e.z + e.z * e.x;
+}
+
+// Finds the split plane between two bins with the lowest SAH cost. Primitives in bins below bestBin go to the first child.
+static bool findBestSplit(PxU32& bestAxis, PxU32& bestBin, const Bins& bins)
+{
+	bool found = false;
+	float bestCost = PX_MAX_F32;
+	for(PxU32 axis=0;axis<3;axis++)
+	{
+		// Sweep from the right first, to get the area and count of all bins above each split plane
+		float rightAreas[BINNED_SAH_NB_BINS];
+		PxU32 rightCounts[BINNED_SAH_NB_BINS];
+		Vec4V minV = V4Load(PX_MAX_F32);
+		Vec4V maxV = V4Load(-PX_MAX_F32);
+		PxU32 count = 0;
+		for(PxU32 i=BINNED_SAH_NB_BINS-1;i>0;i--)
+		{
+			minV = V4Min(minV, bins.mMin[axis][i]);
+			maxV = V4Max(maxV, bins.mMax[axis][i]);
+			count += bins.mCounts[axis][i];
+			rightAreas[i] = count ? getHalfSurfaceArea(minV, maxV) : 0.0f;
+			rightCounts[i] = count;
+		}
+
+		// Then sweep from the left and evaluate the cost of splitting between bins i-1 and i
+		minV = V4Load(PX_MAX_F32);
+		maxV = V4Load(-PX_MAX_F32);
+		count = 0;
+		for(PxU32 i=1;i<BINNED_SAH_NB_BINS;i++)
+		{
+			minV = V4Min(minV, bins.mMin[axis][i-1]);
+			maxV = V4Max(maxV, bins.mMax[axis][i-1]);
+			count += bins.mCounts[axis][i-1];
+			if(!count || !rightCounts[i])
+				continue;
+
+			const float cost = float(count) * getHalfSurfaceArea(minV, maxV) + float(rightCounts[i]) * rightAreas[i];
+			if(cost < bestCost)
+			{
+				bestCost = cost;
+				bestAxis = axis;
+				bestBin = i;
+				found = true;
+			}
+		}
+	}
+	return found;
+}
+
+static PxU32 partition(PxU32 nb, PxU32* PX_RESTRICT prims, const PxVec3* PX_RESTRICT centers, const Vec4V centerMinV, const Vec4V binScaleV, PxU32 axis, PxU32 splitBin)
+{
+	PxU32 nbLeft = 0;
+	for(PxU32 i=0;i<nb;i++)
+	{
+		const PxU32 index = prims[i];
+
+		// Same computation as in binRange(), so that primitives end up on the side they were binned on
+		PxU32 binIndices[3];
+		computeBinIndices(binIndices, V4LoadU(&centers[index].x), centerMinV, binScaleV);
+		if(binIndices[axis] < splitBin)
+		{
+			prims[i] = prims[nbLeft];
+			prims[nbLeft++] = index;
+		}
+	}
+	return nbLeft;
+}
+
+// Computes the node's bounds and, unless it is a leaf, splits its primitives between two new children. Returns true if children were created.
+static bool subdivideBinned(AABBTreeBuildNode& node, const AABBTreeBuildParams& params, NodeAllocator& allocator, BuildStats& stats, PxU32* const indices, PxCpuDispatcher* dispatcher)
+{
+	PxU32* const PX_RESTRICT prims = indices + node.mNodeIndex;
+	const PxU32 nb = node.mNbPrimitives;
+	const PxBounds3* PX_RESTRICT boxes = params.mBounds->getBounds();
+	const PxVec3* PX_RESTRICT centers = params.mCache;
+	PX_ASSERT(nb);
+
+	const bool parallel = dispatcher && nb > BINNED_SAH_PARALLEL_BINNING;
+	const PxU32 nbChunks = parallel ? (nb + BINNED_SAH_BINNING_CHUNK - 1) / BINNED_SAH_BINNING_CHUNK : 1;
+
+	BinningContext context;
+	context.mPrims		= prims;
+	context.mBoxes		= boxes;
+	context.mCenters	= centers;
+	context.mNbPrims	= nb;
+
+	RangeBounds bounds;
+	if(parallel)
+	{
+		context.mRangeBounds = PX_ALLOCATE(RangeBounds, nbChunks, "RangeBounds");
+		runJobs(dispatcher, computeRangeBoundsJob, &context, nbChunks);
+		bounds = context.mRangeBounds[0];
+		for(PxU32 i=1;i<nbChunks;i++)
+			bounds.merge(context.mRangeBounds[i]);
+		PX_FREE(context.mRangeBounds);
+	}
+	else
+		computeRangeBounds(bounds, nb, prims, boxes, centers);
+
+	StoreBounds(node.mBV, bounds.mBoxMin, bounds.mBoxMax);
+
+	// Check the user-defined limit. Also ensures we stop subdividing if we reach a leaf node.
+	if(nb <= params.mLimit)
+		return false;
+
+	// The bins cover the bounds of the primitive centers
+	PX_ALIGN(16, PxVec4) centerExtents;
+	V4StoreA(V4Sub(bounds.mCenterMax, bounds.mCenterMin), &centerExtents.x);
+	const float binScale = float(BINNED_SAH_NB_BINS) * 0.9999f;
+	const PX_ALIGN(16, PxVec4) scale(	centerExtents.x > 0.0f ? binScale / centerExtents.x : 0.0f,
+										centerExtents.y > 0.0f ? binScale / centerExtents.y : 0.0f,
+										centerExtents.z > 0.0f ? binScale / centerExtents.z : 0.0f, 0.0f);
+	context.mCenterMin = bounds.mCenterMin;
+	context.mBinScale = V4LoadA(&scale.x);
+
+	Bins bins;
+	if(parallel)
+	{
+		context.mBins = PX_ALLOCATE(Bins, nbChunks, "Bins");
+		runJobs(dispatcher, binRangeJob, &context, nbChunks);
+		bins = context.mBins[0];
+		for(PxU32 i=1;i<nbChunks;i++)
+			bins.merge(context.mBins[i]);
+		PX_FREE(context.mBins);
+	}
+	else
+		binRange(bins, nb, prims, boxes, centers, context.mCenterMin, context.mBinScale);
+
+	PxU32 nbPos = 0;
+	PxU32 axis, splitBin;
+	if(findBestSplit(axis, splitBin, bins))
+		nbPos = partition(nb, prims, centers, context.mCenterMin, context.mBinScale, axis, splitBin);
+
+	// All centers are in the same bin: make an arbitrary 50-50 split, as the other build strategies do
+	if(!nbPos || nbPos == nb)
+		nbPos = nb >> 1;
+
+	// Now create children and assign their pointers.
+	node.mPos = allocator.getBiNode();
+
+	stats.increaseCount(2);
+
+	// Assign children
+	PX_ASSERT(!node.isLeaf());
+	AABBTreeBuildNode* Pos = const_cast<AABBTreeBuildNode*>(node.mPos);
+	AABBTreeBuildNode* Neg = Pos + 1;
+	Pos->mNodeIndex = node.mNodeIndex;
+	Pos->mNbPrimitives = nbPos;
+	Neg->mNodeIndex = node.mNodeIndex + nbPos;
+	Neg->mNbPrimitives = nb - nbPos;
+	return true;
+}
+
+// Builds the hierarchy below a node. When subtreeRoots is provided, nodes with at most subtreeSize primitives are
+// collected there instead of being subdivided.
+static void buildNodes(AABBTreeBuildNode* root, const AABBTreeBuildParams& params, NodeAllocator& allocator, BuildStats& stats, PxU32* const indices,
+	PxCpuDispatcher* dispatcher, PxArray<AABBTreeBuildNode*>* subtreeRoots, PxU32 subtreeSize)
+{
+	PxArray<AABBTreeBuildNode*> stack;
+	stack.pushBack(root);
+	while(stack.size())
+	{
+		AABBTreeBuildNode* node = stack.popBack();
+		if(subtreeRoots && node->mNbPrimitives <= subtreeSize)
+		{
+			subtreeRoots->pushBack(node);
+			continue;
+		}
+
+		stats.mTotalPrims += node->mNbPrimitives;
+
+		if(subdivideBinned(*node, params, allocator, stats, indices, dispatcher))
+		{
+			AABBTreeBuildNode* Pos = const_cast<AABBTreeBuildNode*>(node->getPos());
+			stack.pushBack(Pos + 1);
+			stack.pushBack(Pos);
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+	struct SubtreeBuild : public PxUserAllocated
+	{
+		AABBTreeBuildNode*	mRoot;
+		NodeAllocator		mAllocator;
+		BuildStats			mStats;
+	};
+
+	struct SubtreeContext
+	{
+		const AABBTreeBuildParams*	mParams;
+		PxU32*						mIndices;
+		SubtreeBuild*				mSubtrees;
+	};
+}
+
+static void buildSubtreeJob(void* userData, PxU32 jobIndex)
+{
+	const SubtreeContext* context = reinterpret_cast<const SubtreeContext*>(userData);
+	SubtreeBuild& subtree = context->mSubtrees[jobIndex];
+
+	subtree.mAllocator.initSubtree(subtree.mRoot->mNbPrimitives, context->mParams->mLimit);
+	buildNodes(subtree.mRoot, *context->mParams, subtree.mAllocator, subtree.mStats, context->mIndices, NULL, NULL, 0);
+}
+
+void Gu::buildHierarchyBinnedSAH(const AABBTreeBuildParams& params, NodeAllocator& nodeAllocator, BuildStats& stats, PxU32* indices)
+{
+	PxCpuDispatcher* dispatcher = params.mDispatcher;
+	const PxU32 nbWorkers = dispatcher ? dispatcher->getWorkerCount() : 0;
+	if(!nbWorkers)
+	{
+		buildNodes(nodeAllocator.mPool, params, nodeAllocator, stats, indices, NULL, NULL, 0);
+		return;
+	}
+
+	// Build the top of the tree until the nodes are small enough to give each worker a few subtrees
+	const PxU32 subtreeSize = PxMax(params.mNbPrimitives / (nbWorkers * 4), PxU32(BINNED_SAH_MIN_SUBTREE));
+	PxArray<AABBTreeBuildNode*> subtreeRoots;
+	buildNodes(nodeAllocator.mPool, params, nodeAllocator, stats, indices, dispatcher, &subtreeRoots, subtreeSize);
+
+	const PxU32 nbSubtrees = subtreeRoots.size();
+	if(!nbSubtrees)
+		return;
+
+	SubtreeBuild* subtrees = PX_NEW(SubtreeBuild)[nbSubtrees];
+	for(PxU32 i=0;i<nbSubtrees;i++)
+		subtrees[i].mRoot = subtreeRoots[i];
+
+	SubtreeContext context;
+	context.mParams		= &params;
+	context.mIndices	= indices;
+	context.mSubtrees	= subtrees;
+	runJobs(dispatcher, buildSubtreeJob, &context, nbSubtrees);
+
+	// Subtrees are appended in a fixed order so that the final tree does not depend on thread scheduling
+	for(PxU32 i=0;i<nbSubtrees;i++)
+	{
+		nodeAllocator.append(subtrees[i].mAllocator);
+		stats.increaseCount(subtrees[i].mStats.getCount());
+		stats.mTotalPrims += subtrees[i].mStats.mTotalPrims;
+	}
+
+	PX_DELETE_ARRAY(subtrees);
+}
@@ -0,0 +1,63 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2023 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef GU_BINNED_SAH_H
+#define GU_BINNED_SAH_H
+
+/** \addtogroup geomutils
+@{
+*/
+
+#include "foundation/PxSimpleTypes.h"
+
+namespace physx
+{
+namespace Gu
+{
+	class AABBTreeBuildParams;
+	class NodeAllocator;
+	struct BuildStats;
+
+	/*
+	*	\brief		Builds the hierarchy below the root node of a node allocator, using a binned SAH.
+	*
+	*	The top of the tree is built by the calling thread, with the binning of large nodes spread over the workers of
+	*	params.mDispatcher. The remaining subtrees are then built in parallel, each with its own node allocator, and
+	*	appended to nodeAllocator in a deterministic order. Without a dispatcher everything runs on the calling thread.
+	*
+	*	\param		params				[in]		AABBTree build params, with initialized centers cache
+	*	\param		nodeAllocator		[in/out]	Node allocator, initialized with the root node
+	*	\param		stats				[in/out]	Statistics
+	*	\param		indices				[in/out]	Primitive indices, reorganized during build
+	*/
+	void	buildHierarchyBinnedSAH(const AABBTreeBuildParams& params, NodeAllocator& nodeAllocator, BuildStats& stats, PxU32* indices);
+}
+}
+
+/** @} */
+#endif
@@ -39,10 +39,6 @@ using namespace Gu;
 
 #define EXT_NB_OBJECTS_PER_NODE	4
 
-// PT: TODO: this is copied from SqBounds.h, should be either moved to Gu and shared or passed as a user parameter
-	#define SQ_PRUNER_EPSILON	0.005f
-	#define SQ_PRUNER_INFLATION	(1.0f + SQ_PRUNER_EPSILON)	// pruner test shape inflation (not narrow phase shape)
-
 ExtendedBucketPruner::ExtendedBucketPruner(PxU64 contextID, CompanionPrunerType type, const PruningPool* pool) :
 	mCompanion			(createCompanionPruner(contextID, type, pool)),
 	mPruningPool		(pool),
@@ -30,6 +30,7 @@
 #include "GuAABBPruner.h"
 #include "GuBucketPruner.h"
 #include "GuIncrementalAABBPruner.h"
+#include "GuHashGridPruner.h"
 
 using namespace physx;
 using namespace Gu;
@@ -39,9 +40,9 @@ Pruner* physx::Gu::createBucketPruner(PxU64 contextID)
 	return PX_NEW(BucketPruner)(contextID);
 }
 
-Pruner* physx::Gu::createAABBPruner(PxU64 contextID, bool dynamic, CompanionPrunerType cpType, BVHBuildStrategy buildStrategy, PxU32 nbObjectsPerNode)
+Pruner* physx::Gu::createAABBPruner(PxU64 contextID, bool dynamic, CompanionPrunerType cpType, BVHBuildStrategy buildStrategy, PxU32 nbObjectsPerNode, PxCpuDispatcher* dispatcher, bool wideTree)
 {
-	return PX_NEW(AABBPruner)(dynamic, contextID, cpType, buildStrategy, nbObjectsPerNode);
+	return PX_NEW(AABBPruner)(dynamic, contextID, cpType, buildStrategy, nbObjectsPerNode, dispatcher, wideTree);
 }
 
 Pruner* physx::Gu::createIncrementalPruner(PxU64 contextID)
@@ -49,3 +50,7 @@ Pruner* physx::Gu::createIncrementalPruner(PxU64 contextID)
 	return PX_NEW(IncrementalAABBPruner)(32, contextID);
 }
 
+Pruner* physx::Gu::createHashGridPruner(PxU64 contextID, float cellSize)
+{
+	return PX_NEW(HashGridPruner)(contextID, cellSize);
+}
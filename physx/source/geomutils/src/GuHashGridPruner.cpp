@@ -0,0 +1,976 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2023 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "foundation/PxMath.h"
+#include "foundation/PxMemory.h"
+#include "foundation/PxBitUtils.h"
+#include "CmVisualization.h"
+#include "GuHashGridPruner.h"
+#include "GuCallbackAdapter.h"
+#include "GuBVHTestsSIMD.h"
+#include "GuQuery.h"
+#include "GuSqInternal.h"
+#include "GuSphere.h"
+#include "GuBox.h"
+#include "GuCapsule.h"
+
+using namespace physx;
+using namespace aos;
+using namespace Gu;
+
+#define INVALID_ID			0xffffffff
+#define OVERFLOW_LEVEL		HASH_GRID_NB_LEVELS
+// Cell coordinates are clamped to this value to fit in 32-bit integers. Objects beyond that go to the overflow level.
+#define MAX_CELL_COORD		1e9f
+
+HashGridCellMap::HashGridCellMap() : mEntries(NULL), mMask(0), mNbEntries(0)
+{
+}
+
+HashGridCellMap::~HashGridCellMap()
+{
+	release();
+}
+
+void HashGridCellMap::release()
+{
+	PX_FREE(mEntries);
+	mMask = 0;
+	mNbEntries = 0;
+}
+
+void HashGridCellMap::resize(PxU32 newSize)
+{
+	PX_ASSERT(PxIsPowerOfTwo(newSize));
+	Entry* oldEntries = mEntries;
+	const PxU32 oldSize = oldEntries ? mMask+1 : 0;
+
+	mEntries = PX_ALLOCATE(Entry, newSize, "HashGridCellMap");
+	mMask = newSize-1;
+	for(PxU32 i=0;i<newSize;i++)
+		mEntries[i].mCell = INVALID_ID;
+
+	const HashGridCellKeyHash hash;
+	for(PxU32 i=0;i<oldSize;i++)
+	{
+		const Entry& e = oldEntries[i];
+		if(e.mCell==INVALID_ID)
+			continue;
+
+		PxU32 j = hash(e.mKey) & mMask;
+		while(mEntries[j].mCell!=INVALID_ID)
+			j = (j+1) & mMask;
+		mEntries[j] = e;
+	}
+	PX_FREE(oldEntries);
+}
+
+void HashGridCellMap::insert(const HashGridCellKey& key, PxU32 cellIndex)
+{
+	PX_ASSERT(!find(key));
+	PX_ASSERT(cellIndex!=INVALID_ID);
+
+	// We keep the load factor below 1/2 so that probe sequences stay short
+	const PxU32 size = mEntries ? mMask+1 : 0;
+	if((mNbEntries+1)*2 > size)
+		resize(PxMax<PxU32>(64, size*2));
+
+	PxU32 i = HashGridCellKeyHash()(key) & mMask;
+	while(mEntries[i].mCell!=INVALID_ID)
+		i = (i+1) & mMask;
+
+	mEntries[i].mKey = key;
+	mEntries[i].mCell = cellIndex;
+	mNbEntries++;
+}
+
+void HashGridCellMap::erase(const HashGridCellKey& key)
+{
+	const HashGridCellKeyHash hash;
+	PxU32 i = hash(key) & mMask;
+	while(!hash.equal(mEntries[i].mKey, key))
+	{
+		PX_ASSERT(mEntries[i].mCell!=INVALID_ID);
+		i = (i+1) & mMask;
+	}
+
+	// Backward shift deletion: entries following the hole move back into it, unless the hole is before their home slot
+	PxU32 j = i;
+	for(;;)
+	{
+		j = (j+1) & mMask;
+		if(mEntries[j].mCell==INVALID_ID)
+			break;
+
+		const PxU32 home = hash(mEntries[j].mKey) & mMask;
+		const bool canMove = i<=j ? (home<=i || home>j) : (home<=i && home>j);
+		if(canMove)
+		{
+			mEntries[i] = mEntries[j];
+			i = j;
+		}
+	}
+	mEntries[i].mCell = INVALID_ID;
+	mNbEntries--;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+HashGrid::HashGrid(float cellSize) : mFreeBlocks(INVALID_ID)
+{
+	PX_ASSERT(cellSize>0.0f);
+	float size = cellSize;
+	for(PxU32 i=0;i<HASH_GRID_NB_LEVELS;i++)
+	{
+		mCellSizes[i] = size;
+		mInvCellSizes[i] = 1.0f/size;
+		mLevelExtents[i] = 0.0f;
+		size *= 2.0f;
+	}
+}
+
+HashGrid::~HashGrid()
+{
+}
+
+void HashGrid::release()
+{
+	mCells.reset();
+	mFreeCells.reset();
+	mBlocks.reset();
+	mFreeBlocks = INVALID_ID;
+	for(PxU32 i=0;i<=HASH_GRID_NB_LEVELS;i++)
+		mLevelCells[i].reset();
+	mObjects.reset();
+	mCellMap.release();
+}
+
+static PX_FORCE_INLINE void setOverflowKey(HashGridCellKey& key)
+{
+	key.mX = key.mY = key.mZ = 0;
+	key.mLevel = OVERFLOW_LEVEL;
+}
+
+void HashGrid::computeCellKey(const PxBounds3& bounds, HashGridCellKey& key, float& extent) const
+{
+	extent = 0.0f;
+
+	// Written so that NaNs and empty bounds end up in the overflow level
+	const PxVec3 dims = bounds.maximum - bounds.minimum;
+	const float size = PxMax(dims.x, PxMax(dims.y, dims.z));
+	if(!(size>=0.0f))
+	{
+		setOverflowKey(key);
+		return;
+	}
+
+	PxU32 level = 0;
+	while(level<HASH_GRID_NB_LEVELS && size>mCellSizes[level])
+		level++;
+
+	if(level==HASH_GRID_NB_LEVELS)
+	{
+		setOverflowKey(key);
+		return;
+	}
+
+	const PxVec3 c = bounds.getCenter() * mInvCellSizes[level];
+	if(!(PxAbs(c.x)<MAX_CELL_COORD && PxAbs(c.y)<MAX_CELL_COORD && PxAbs(c.z)<MAX_CELL_COORD))
+	{
+		setOverflowKey(key);
+		return;
+	}
+
+	key.mX = PxI32(PxFloor(c.x));
+	key.mY = PxI32(PxFloor(c.y));
+	key.mZ = PxI32(PxFloor(c.z));
+	key.mLevel = level;
+	// Small margin to make up for rounding errors in the cell coordinates
+	extent = size * 0.5f * mInvCellSizes[level] + 1e-3f;
+}
+
+PxU32 HashGrid::getOrCreateCell(const HashGridCellKey& key)
+{
+	const PxU32* existingCell = mCellMap.find(key);
+	if(existingCell)
+		return *existingCell;
+
+	PxU32 cellIndex;
+	if(mFreeCells.size())
+	{
+		cellIndex = mFreeCells.popBack();
+	}
+	else
+	{
+		cellIndex = mCells.size();
+		mCells.insert();
+	}
+
+	HashGridCell& cell = mCells[cellIndex];
+	cell.mKey = key;
+	cell.mNbBoxes = 0;
+	cell.mFirstBlock = INVALID_ID;
+	cell.mLevelSlot = mLevelCells[key.mLevel].size();
+	if(key.mLevel!=OVERFLOW_LEVEL)
+	{
+		HashGridKeyBounds& levelBounds = mLevelBounds[key.mLevel];
+		if(!cell.mLevelSlot)
+		{
+			levelBounds.set(key);
+			mLevelExtents[key.mLevel] = 0.0f;
+		}
+		else
+			levelBounds.include(key);
+	}
+	mLevelCells[key.mLevel].pushBack(cellIndex);
+	mCellMap.insert(key, cellIndex);
+	return cellIndex;
+}
+
+static PX_FORCE_INLINE void writeBox(HashGridBoxes4& boxes, PxU32 lane, const PxBounds3& bounds)
+{
+	boxes.mMinX[lane] = bounds.minimum.x;
+	boxes.mMinY[lane] = bounds.minimum.y;
+	boxes.mMinZ[lane] = bounds.minimum.z;
+	boxes.mMaxX[lane] = bounds.maximum.x;
+	boxes.mMaxY[lane] = bounds.maximum.y;
+	boxes.mMaxZ[lane] = bounds.maximum.z;
+}
+
+static PX_FORCE_INLINE void copyBox(HashGridBoxes4& dst, PxU32 dstLane, const HashGridBoxes4& src, PxU32 srcLane)
+{
+	dst.mMinX[dstLane] = src.mMinX[srcLane];
+	dst.mMinY[dstLane] = src.mMinY[srcLane];
+	dst.mMinZ[dstLane] = src.mMinZ[srcLane];
+	dst.mMaxX[dstLane] = src.mMaxX[srcLane];
+	dst.mMaxY[dstLane] = src.mMaxY[srcLane];
+	dst.mMaxZ[dstLane] = src.mMaxZ[srcLane];
+	dst.mHandles[dstLane] = src.mHandles[srcLane];
+}
+
+PxU32 HashGrid::allocBlock()
+{
+	PxU32 block = mFreeBlocks;
+	if(block!=INVALID_ID)
+	{
+		mFreeBlocks = mBlocks[block].mNext;
+	}
+	else
+	{
+		block = mBlocks.size();
+		mBlocks.insert();
+	}
+
+	// Unused lanes are never reported but they are still tested, so we keep them initialized
+	PxMemZero(&mBlocks[block], sizeof(HashGridBoxes4));
+	return block;
+}
+
+void HashGrid::freeBlock(PxU32 block)
+{
+	mBlocks[block].mNext = mFreeBlocks;
+	mFreeBlocks = block;
+}
+
+void HashGrid::insertInCell(PrunerHandle handle, PxU32 cellIndex, const PxBounds3& bounds, float extent)
+{
+	HashGridCell& cell = mCells[cellIndex];
+
+	// New objects go to the first block of the cell, a new one is pushed in front of the list when it is full
+	const PxU32 lane = cell.mNbBoxes & 3;
+	if(!lane)
+	{
+		const PxU32 block = allocBlock();
+		mBlocks[block].mNext = cell.mFirstBlock;
+		cell.mFirstBlock = block;
+	}
+	cell.mNbBoxes++;
+
+	HashGridBoxes4& boxes = mBlocks[cell.mFirstBlock];
+	writeBox(boxes, lane, bounds);
+	boxes.mHandles[lane] = handle;
+
+	if(cell.mKey.mLevel!=OVERFLOW_LEVEL)
+		mLevelExtents[cell.mKey.mLevel] = PxMax(mLevelExtents[cell.mKey.mLevel], extent);
+
+	HashGridObject& object = mObjects[handle];
+	object.mKey = cell.mKey;
+	object.mCell = cellIndex;
+	object.mBox = cell.mFirstBlock*4 + lane;
+}
+
+void HashGrid::removeFromCell(PrunerHandle handle)
+{
+	HashGridObject& object = mObjects[handle];
+	PX_ASSERT(object.mCell!=INVALID_ID);
+
+	const PxU32 cellIndex = object.mCell;
+	HashGridCell& cell = mCells[cellIndex];
+
+	// The last object of the first block replaces the removed one
+	const PxU32 firstBlock = cell.mFirstBlock;
+	const PxU32 lastLane = --cell.mNbBoxes & 3;
+	const PxU32 lastBox = firstBlock*4 + lastLane;
+	if(object.mBox!=lastBox)
+	{
+		const HashGridBoxes4& src = mBlocks[firstBlock];
+		copyBox(mBlocks[object.mBox>>2], object.mBox&3, src, lastLane);
+		mObjects[src.mHandles[lastLane]].mBox = object.mBox;
+	}
+	if(!lastLane)
+	{
+		cell.mFirstBlock = mBlocks[firstBlock].mNext;
+		freeBlock(firstBlock);
+	}
+
+	object.mCell = INVALID_ID;
+	object.mBox = INVALID_ID;
+
+	if(!cell.mNbBoxes)
+	{
+		PX_ASSERT(cell.mFirstBlock==INVALID_ID);
+		mCellMap.erase(cell.mKey);
+
+		PxArray<PxU32>& levelCells = mLevelCells[cell.mKey.mLevel];
+		const PxU32 movedCell = levelCells.back();
+		levelCells.replaceWithLast(cell.mLevelSlot);
+		if(movedCell!=cellIndex)
+			mCells[movedCell].mLevelSlot = cell.mLevelSlot;
+
+		mFreeCells.pushBack(cellIndex);
+	}
+}
+
+void HashGrid::addObject(PrunerHandle handle, const PxBounds3& bounds)
+{
+	if(handle>=mObjects.size())
+	{
+		if(handle>=mObjects.capacity())
+			mObjects.reserve(PxMax(mObjects.capacity()*2, handle+1));
+
+		HashGridObject invalid;
+		setOverflowKey(invalid.mKey);
+		invalid.mCell = INVALID_ID;
+		invalid.mBox = INVALID_ID;
+		mObjects.resize(handle+1, invalid);
+	}
+
+	HashGridCellKey key;
+	float extent;
+	computeCellKey(bounds, key, extent);
+	insertInCell(handle, getOrCreateCell(key), bounds, extent);
+}
+
+void HashGrid::updateObject(PrunerHandle handle, const PxBounds3& bounds)
+{
+	HashGridCellKey key;
+	float extent;
+	computeCellKey(bounds, key, extent);
+
+	const HashGridObject& object = mObjects[handle];
+	if(HashGridCellKeyHash().equal(object.mKey, key))
+	{
+		// Still in the same cell, only the box copy needs updating
+		writeBox(mBlocks[object.mBox>>2], object.mBox&3, bounds);
+		if(key.mLevel!=OVERFLOW_LEVEL)
+			mLevelExtents[key.mLevel] = PxMax(mLevelExtents[key.mLevel], extent);
+		return;
+	}
+
+	removeFromCell(handle);
+	insertInCell(handle, getOrCreateCell(key), bounds, extent);
+}
+
+void HashGrid::updateObjects(const PrunerHandle* handles, PxU32 count, const PruningPool& pool)
+{
+	// Handles are usually in random order, so objects and their box copies are prefetched a few iterations ahead
+	const PxBounds3* boxes = pool.getCurrentWorldBoxes();
+	for(PxU32 i=0;i<count;i++)
+	{
+		if(i+16<count)
+			PxPrefetchLine(&mObjects[handles[i+16]]);
+		if(i+8<count)
+			PxPrefetchLine(&mBlocks[mObjects[handles[i+8]].mBox>>2]);
+
+		const PrunerHandle h = handles[i];
+		updateObject(h, boxes[pool.getIndex(h)]);
+	}
+}
+
+void HashGrid::removeObject(PrunerHandle handle)
+{
+	removeFromCell(handle);
+}
+
+namespace
+{
+	// Range of cells whose loose bounds can touch a given box, for one level
+	struct CellRange
+	{
+		PxI32	mMin[3];
+		PxI32	mMax[3];
+
+		PX_FORCE_INLINE	CellRange()
+		{
+			mMin[0] = mMin[1] = mMin[2] = 0;
+			mMax[0] = mMax[1] = mMax[2] = -1;
+		}
+
+		// An object is stored in the cell containing its center, so its bounds are contained in the cell inflated by
+		// the level's loose extent e (at most half a cell). Cell k can touch the box if (k - e)*size <= boxMax and
+		// (k + 1 + e)*size >= boxMin. The range is clipped against the cells actually used by the level.
+		PX_FORCE_INLINE	CellRange(const PxVec3& boxMin, const PxVec3& boxMax, float invCellSize, float looseExtent, const HashGridKeyBounds& levelBounds)
+		{
+			for(PxU32 j=0;j<3;j++)
+			{
+				const float lo = PxClamp(boxMin[j]*invCellSize - 1.0f - looseExtent, -MAX_CELL_COORD, MAX_CELL_COORD);
+				const float hi = PxClamp(boxMax[j]*invCellSize + looseExtent, -MAX_CELL_COORD, MAX_CELL_COORD);
+				mMin[j] = PxMax(PxI32(PxCeil(lo)), levelBounds.mMin[j]);
+				mMax[j] = PxMin(PxI32(PxFloor(hi)), levelBounds.mMax[j]);
+			}
+		}
+
+		PX_FORCE_INLINE	bool	isEmpty()	const
+		{
+			return mMin[0]>mMax[0] || mMin[1]>mMax[1] || mMin[2]>mMax[2];
+		}
+
+		PX_FORCE_INLINE	float	getNbCells()	const
+		{
+			return isEmpty() ? 0.0f : float(mMax[0] - mMin[0] + 1) * float(mMax[1] - mMin[1] + 1) * float(mMax[2] - mMin[2] + 1);
+		}
+
+		PX_FORCE_INLINE	bool	contains(const HashGridCellKey& key)	const
+		{
+			return		key.mX>=mMin[0] && key.mX<=mMax[0]
+					&&	key.mY>=mMin[1] && key.mY<=mMax[1]
+					&&	key.mZ>=mMin[2] && key.mZ<=mMax[2];
+		}
+	};
+
+	// Looks up the cells of a range in the hash map, skipping the ones from an already visited range.
+	template<class CellVisitor>
+	PX_FORCE_INLINE bool visitRange(const HashGrid& grid, PxU32 level, const CellRange& range, const CellRange& visited, CellVisitor& visitor)
+	{
+		HashGridCellKey key;
+		key.mLevel = level;
+		for(key.mZ=range.mMin[2];key.mZ<=range.mMax[2];key.mZ++)
+		{
+			for(key.mY=range.mMin[1];key.mY<=range.mMax[1];key.mY++)
+			{
+				for(key.mX=range.mMin[0];key.mX<=range.mMax[0];key.mX++)
+				{
+					if(visited.contains(key))
+						continue;
+
+					const HashGridCell* cell = grid.findCell(key);
+					if(cell && !visitor(*cell))
+						return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	// Visits the cells of a level that can touch a box. When the box covers fewer cells than the level contains,
+	// cells are looked up in the hash map. Otherwise we iterate over the active cells directly.
+	template<class CellVisitor>
+	PX_FORCE_INLINE bool visitLevel(const HashGrid& grid, PxU32 level, const CellRange& range, CellVisitor& visitor)
+	{
+		if(range.isEmpty())
+			return true;
+
+		const PxU32 nbActiveCells = grid.getNbCells(level);
+		if(range.getNbCells() < float(nbActiveCells))
+			return visitRange(grid, level, range, CellRange(), visitor);
+
+		const PxU32* cells = grid.getLevelCells(level);
+		for(PxU32 i=0;i<nbActiveCells;i++)
+		{
+			const HashGridCell& cell = grid.getCell(cells[i]);
+			if(range.contains(cell.mKey) && !visitor(cell))
+				return false;
+		}
+		return true;
+	}
+
+	// Clips a ray against a box, returns false if they do not intersect
+	PX_FORCE_INLINE bool clipRay(const PxVec3& origin, const PxVec3& dir, float maxDist, const PxVec3& boxMin, const PxVec3& boxMax, float& tEnter, float& tExit)
+	{
+		tEnter = 0.0f;
+		tExit = maxDist;
+		for(PxU32 j=0;j<3;j++)
+		{
+			if(PxAbs(dir[j])<1e-9f)
+			{
+				if(origin[j]<boxMin[j] || origin[j]>boxMax[j])
+					return false;
+			}
+			else
+			{
+				const float oneOverDir = 1.0f / dir[j];
+				float t0 = (boxMin[j] - origin[j]) * oneOverDir;
+				float t1 = (boxMax[j] - origin[j]) * oneOverDir;
+				if(t0>t1)
+					PxSwap(t0, t1);
+				tEnter = PxMax(tEnter, t0);
+				tExit = PxMin(tExit, t1);
+				if(tEnter>tExit)
+					return false;
+			}
+		}
+		return true;
+	}
+
+	// Only the first block of a cell can be partially used
+	PX_FORCE_INLINE PxU32 getFirstBlockMask(const HashGridCell& cell)
+	{
+		return (1<<(((cell.mNbBoxes-1)&3)+1))-1;
+	}
+
+	PX_FORCE_INLINE void getBox(const HashGridBoxes4& boxes, PxU32 lane, Vec3V& center, Vec3V& extents)
+	{
+		const Vec3V boxMin = V3LoadU(PxVec3(boxes.mMinX[lane], boxes.mMinY[lane], boxes.mMinZ[lane]));
+		const Vec3V boxMax = V3LoadU(PxVec3(boxes.mMaxX[lane], boxes.mMaxY[lane], boxes.mMaxZ[lane]));
+		const FloatV half = FHalf();
+		center = V3Scale(V3Add(boxMin, boxMax), half);
+		extents = V3Scale(V3Sub(boxMax, boxMin), half);
+	}
+
+	template<class Test>
+	struct OverlapCellVisitor
+	{
+		OverlapCellVisitor(const HashGridBoxes4* blocks, const Test& test, const PxBounds3& queryBounds, OverlapCallbackAdapter& pcb, const PruningPool& pool) :
+			mBlocks		(blocks),
+			mTest		(test),
+			mPcb		(pcb),
+			mPool		(pool),
+			mQueryMinX	(V4Load(queryBounds.minimum.x)),
+			mQueryMinY	(V4Load(queryBounds.minimum.y)),
+			mQueryMinZ	(V4Load(queryBounds.minimum.z)),
+			mQueryMaxX	(V4Load(queryBounds.maximum.x)),
+			mQueryMaxY	(V4Load(queryBounds.maximum.y)),
+			mQueryMaxZ	(V4Load(queryBounds.maximum.z))
+		{
+		}
+
+		PX_FORCE_INLINE bool operator()(const HashGridCell& cell)
+		{
+			PxU32 laneMask = getFirstBlockMask(cell);
+			for(PxU32 block=cell.mFirstBlock;block!=INVALID_ID;block=mBlocks[block].mNext, laneMask=0xf)
+			{
+				const HashGridBoxes4& b = mBlocks[block];
+
+				// Four AABB-vs-AABB tests at once against the query's bounds, then the exact test for the survivors
+				const BoolV overlapX = BAnd(V4IsGrtrOrEq(mQueryMaxX, V4LoadA(b.mMinX)), V4IsGrtrOrEq(V4LoadA(b.mMaxX), mQueryMinX));
+				const BoolV overlapY = BAnd(V4IsGrtrOrEq(mQueryMaxY, V4LoadA(b.mMinY)), V4IsGrtrOrEq(V4LoadA(b.mMaxY), mQueryMinY));
+				const BoolV overlapZ = BAnd(V4IsGrtrOrEq(mQueryMaxZ, V4LoadA(b.mMinZ)), V4IsGrtrOrEq(V4LoadA(b.mMaxZ), mQueryMinZ));
+				PxU32 mask = BGetBitMask(BAnd(overlapX, BAnd(overlapY, overlapZ))) & laneMask;
+				while(mask)
+				{
+					const PxU32 lane = PxLowestSetBit(mask);
+					mask &= mask - 1;
+
+					Vec3V center, extents;
+					getBox(b, lane, center, extents);
+					if(mTest(center, extents))
+					{
+						if(!mPcb.invoke(mPool.getIndex(b.mHandles[lane])))
+							return false;
+					}
+				}
+			}
+			return true;
+		}
+
+		const HashGridBoxes4*	mBlocks;
+		const Test&				mTest;
+		OverlapCallbackAdapter&	mPcb;
+		const PruningPool&		mPool;
+		const Vec4V				mQueryMinX, mQueryMinY, mQueryMinZ;
+		const Vec4V				mQueryMaxX, mQueryMaxY, mQueryMaxZ;
+		PX_NOCOPY(OverlapCellVisitor)
+	};
+
+	PX_FORCE_INLINE Vec4V getSafeInvDir(float dir)
+	{
+		// Large but finite value for axis-aligned rays, so that the slab tests below never produce NaNs
+		return V4Load(PxAbs(dir)>1e-9f ? 1.0f/dir : (dir>=0.0f ? 1e18f : -1e18f));
+	}
+
+	template<bool tInflate>
+	struct RaycastCellVisitor
+	{
+		RaycastCellVisitor(const HashGridBoxes4* blocks, RayAABBTest& test, const PxVec3& origin, const PxVec3& unitDir, const PxVec3& inflation,
+			RaycastCallbackAdapter& pcb, const PruningPool& pool, PxReal& maxDist, float cellSize, float looseExtent) :
+			mBlocks		(blocks),
+			mTest		(test),
+			mPcb		(pcb),
+			mPool		(pool),
+			mMaxDist	(maxDist),
+			mCellSize	(cellSize),
+			mCellExtents((0.5f + looseExtent) * cellSize),
+			mOriginX	(V4Load(origin.x)),
+			mOriginY	(V4Load(origin.y)),
+			mOriginZ	(V4Load(origin.z)),
+			mInvDirX	(getSafeInvDir(unitDir.x)),
+			mInvDirY	(getSafeInvDir(unitDir.y)),
+			mInvDirZ	(getSafeInvDir(unitDir.z)),
+			mInflationX	(V4Load(inflation.x)),
+			mInflationY	(V4Load(inflation.y)),
+			mInflationZ	(V4Load(inflation.z))
+		{
+		}
+
+		PX_FORCE_INLINE bool operator()(const HashGridCell& cell)
+		{
+			if(cell.mKey.mLevel!=OVERFLOW_LEVEL)
+			{
+				// Loose bounds of the cell: the cell itself plus the level's loose extent on each side
+				const PxVec3 cellCenter((float(cell.mKey.mX)+0.5f)*mCellSize, (float(cell.mKey.mY)+0.5f)*mCellSize, (float(cell.mKey.mZ)+0.5f)*mCellSize);
+				if(!mTest.check<tInflate>(V3LoadU(cellCenter), V3Load(mCellExtents)))
+					return true;
+			}
+
+			const Vec4V zero = V4Zero();
+			PxU32 laneMask = getFirstBlockMask(cell);
+			for(PxU32 block=cell.mFirstBlock;block!=INVALID_ID;block=mBlocks[block].mNext, laneMask=0xf)
+			{
+				const HashGridBoxes4& b = mBlocks[block];
+
+				Vec4V minX = V4LoadA(b.mMinX), minY = V4LoadA(b.mMinY), minZ = V4LoadA(b.mMinZ);
+				Vec4V maxX = V4LoadA(b.mMaxX), maxY = V4LoadA(b.mMaxY), maxZ = V4LoadA(b.mMaxZ);
+				if(tInflate)
+				{
+					minX = V4Sub(minX, mInflationX);	maxX = V4Add(maxX, mInflationX);
+					minY = V4Sub(minY, mInflationY);	maxY = V4Add(maxY, mInflationY);
+					minZ = V4Sub(minZ, mInflationZ);	maxZ = V4Add(maxZ, mInflationZ);
+				}
+
+				// Four segment-vs-AABB slab tests at once
+				const Vec4V t0X = V4Mul(V4Sub(minX, mOriginX), mInvDirX), t1X = V4Mul(V4Sub(maxX, mOriginX), mInvDirX);
+				const Vec4V t0Y = V4Mul(V4Sub(minY, mOriginY), mInvDirY), t1Y = V4Mul(V4Sub(maxY, mOriginY), mInvDirY);
+				const Vec4V t0Z = V4Mul(V4Sub(minZ, mOriginZ), mInvDirZ), t1Z = V4Mul(V4Sub(maxZ, mOriginZ), mInvDirZ);
+				const Vec4V tEnter = V4Max(V4Max(V4Min(t0X, t1X), V4Min(t0Y, t1Y)), V4Max(V4Min(t0Z, t1Z), zero));
+				const Vec4V tExit = V4Min(V4Min(V4Max(t0X, t1X), V4Max(t0Y, t1Y)), V4Min(V4Max(t0Z, t1Z), V4Load(mMaxDist)));
+				PxU32 mask = BGetBitMask(V4IsGrtrOrEq(tExit, tEnter)) & laneMask;
+				while(mask)
+				{
+					const PxU32 lane = PxLowestSetBit(mask);
+					mask &= mask - 1;
+
+					const PxReal oldMaxDist = mMaxDist;
+					PxReal md = mMaxDist;
+					if(!mPcb.invoke(md, mPool.getIndex(b.mHandles[lane])))
+						return false;
+
+					if(md < oldMaxDist)
+					{
+						mMaxDist = md;
+						mTest.setDistance(md);
+					}
+				}
+			}
+			return true;
+		}
+
+		const HashGridBoxes4*	mBlocks;
+		RayAABBTest&			mTest;
+		RaycastCallbackAdapter&	mPcb;
+		const PruningPool&		mPool;
+		PxReal&					mMaxDist;
+		const float				mCellSize;
+		const float				mCellExtents;
+		const Vec4V				mOriginX, mOriginY, mOriginZ;
+		const Vec4V				mInvDirX, mInvDirY, mInvDirZ;
+		const Vec4V				mInflationX, mInflationY, mInflationZ;
+		PX_NOCOPY(RaycastCellVisitor)
+	};
+}
+
+template<class Test>
+bool HashGrid::overlap(const PruningPool& pool, const PxBounds3& queryBounds, const Test& test, PrunerOverlapCallback& pcbArgName) const
+{
+	OverlapCallbackAdapter pcb(pcbArgName, pool);
+	OverlapCellVisitor<Test> visitor(mBlocks.begin(), test, queryBounds, pcb, pool);
+
+	for(PxU32 level=0;level<HASH_GRID_NB_LEVELS;level++)
+	{
+		if(!mLevelCells[level].size())
+			continue;
+
+		const CellRange range(queryBounds.minimum, queryBounds.maximum, mInvCellSizes[level], mLevelExtents[level], mLevelBounds[level]);
+		if(!visitLevel(*this, level, range, visitor))
+			return false;
+	}
+
+	if(mLevelCells[OVERFLOW_LEVEL].size())
+		return visitor(mCells[mLevelCells[OVERFLOW_LEVEL][0]]);
+	return true;
+}
+
+// Number of hash lookups per chunk of ray, used to decide between walking along the ray and scanning all cells
+#define NB_LOOKUPS_PER_RAY_CHUNK	16.0f
+
+template<bool tInflate>
+bool HashGrid::raycast(const PruningPool& pool, const PxVec3& origin, const PxVec3& unitDir, PxReal& inOutDistance, const PxVec3& inflation, PrunerRaycastCallback& pcbArgName) const
+{
+	RaycastCallbackAdapter pcb(pcbArgName, pool);
+	RayAABBTest test(origin, unitDir, inOutDistance, inflation);
+
+	// We test the overflow level first. It usually contains large objects that are likely to shorten the ray
+	// for the regular levels.
+	if(mLevelCells[OVERFLOW_LEVEL].size())
+	{
+		RaycastCellVisitor<tInflate> visitor(mBlocks.begin(), test, origin, unitDir, inflation, pcb, pool, inOutDistance, 0.0f, 0.0f);
+		if(!visitor(mCells[mLevelCells[OVERFLOW_LEVEL][0]]))
+			return false;
+	}
+
+	for(PxU32 level=0;level<HASH_GRID_NB_LEVELS;level++)
+	{
+		const PxU32 nbActiveCells = mLevelCells[level].size();
+		if(!nbActiveCells)
+			continue;
+
+		const float cellSize = mCellSizes[level];
+		const float invCellSize = mInvCellSizes[level];
+		const float looseExtent = mLevelExtents[level];
+		const HashGridKeyBounds& levelBounds = mLevelBounds[level];
+
+		// Clip the ray against the loose bounds of the level. This also makes infinite rays finite.
+		const PxVec3 levelMin = (PxVec3(float(levelBounds.mMin[0]), float(levelBounds.mMin[1]), float(levelBounds.mMin[2])) - PxVec3(looseExtent)) * cellSize - inflation;
+		const PxVec3 levelMax = (PxVec3(float(levelBounds.mMax[0]), float(levelBounds.mMax[1]), float(levelBounds.mMax[2])) + PxVec3(1.0f + looseExtent)) * cellSize + inflation;
+		float tEnter, tExit;
+		if(!clipRay(origin, unitDir, inOutDistance, levelMin, levelMax, tEnter, tExit))
+			continue;
+
+		RaycastCellVisitor<tInflate> visitor(mBlocks.begin(), test, origin, unitDir, inflation, pcb, pool, inOutDistance, cellSize, looseExtent);
+
+		const float nbChunks = (tExit - tEnter) * invCellSize + 1.0f;
+		if(nbChunks * NB_LOOKUPS_PER_RAY_CHUNK >= float(nbActiveCells))
+		{
+			const PxVec3 p0 = origin + unitDir * tEnter;
+			const PxVec3 p1 = origin + unitDir * tExit;
+			const CellRange range(p0.minimum(p1) - inflation, p0.maximum(p1) + inflation, invCellSize, looseExtent, levelBounds);
+			if(!visitLevel(*this, level, range, visitor))
+				return false;
+			continue;
+		}
+
+		// Walk along the ray one cell-sized chunk at a time, so that cells are visited roughly in ray order and
+		// closest-hit queries can stop early. Consecutive ranges overlap, so we skip the cells of the previous
+		// range. Ranges only move forward along each axis, so a cell cannot be visited twice.
+		CellRange visited;
+		float t = tEnter;
+		for(;;)
+		{
+			const float tMax = PxMin(tExit, inOutDistance);
+			const float tEnd = PxMin(t + cellSize, tMax);
+			if(t > tEnd)
+				break;
+
+			const PxVec3 p0 = origin + unitDir * t;
+			const PxVec3 p1 = origin + unitDir * tEnd;
+			const CellRange range(p0.minimum(p1) - inflation, p0.maximum(p1) + inflation, invCellSize, looseExtent, levelBounds);
+			if(!visitRange(*this, level, range, visited, visitor))
+				return false;
+
+			if(tEnd >= tMax)
+				break;
+
+			visited = range;
+			t = tEnd;
+		}
+	}
+	return true;
+}
+
+void HashGrid::visualize(PxRenderOutput& out, PxU32 color) const
+{
+	const PxTransform idt = PxTransform(PxIdentity);
+	out << idt;
+	out << color;
+
+	for(PxU32 level=0;level<HASH_GRID_NB_LEVELS;level++)
+	{
+		const float cellSize = mCellSizes[level];
+		const PxU32 nbCells = mLevelCells[level].size();
+		for(PxU32 i=0;i<nbCells;i++)
+		{
+			const HashGridCellKey& key = mCells[mLevelCells[level][i]].mKey;
+			const PxVec3 cellMin(float(key.mX)*cellSize, float(key.mY)*cellSize, float(key.mZ)*cellSize);
+			Cm::renderOutputDebugBox(out, PxBounds3(cellMin, cellMin + PxVec3(cellSize)));
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+HashGridPruner::HashGridPruner(PxU64 contextID, float cellSize) : mGrid(cellSize), mPool(contextID, TRANSFORM_CACHE_GLOBAL)
+{
+}
+
+HashGridPruner::~HashGridPruner()
+{
+}
+
+bool HashGridPruner::addObjects(PrunerHandle* results, const PxBounds3* bounds, const PrunerPayload* data, const PxTransform* transforms, PxU32 count, bool)
+{
+	if(!count)
+		return true;
+
+	const PxU32 valid = mPool.addObjects(results, bounds, data, transforms, count);
+
+	const PxBounds3* boxes = mPool.getCurrentWorldBoxes();
+	for(PxU32 i=0;i<valid;i++)
+		mGrid.addObject(results[i], boxes[mPool.getIndex(results[i])]);
+
+	return valid == count;
+}
+
+void HashGridPruner::removeObjects(const PrunerHandle* handles, PxU32 count, PrunerPayloadRemovalCallback* removalCallback)
+{
+	for(PxU32 i=0;i<count;i++)
+	{
+		mGrid.removeObject(handles[i]);
+		mPool.removeObject(handles[i], removalCallback);
+	}
+}
+
+void HashGridPruner::updateObjects(const PrunerHandle* handles, PxU32 count, float inflation, const PxU32* boundsIndices, const PxBounds3* newBounds, const PxTransform32* newTransforms)
+{
+	if(!count || !handles)
+		return;
+
+	if(boundsIndices && newBounds)
+		mPool.updateAndInflateBounds(handles, boundsIndices, newBounds, newTransforms, count, inflation);
+
+	// Objects that stay in the same cell only get their box copy updated, the others are moved to their new cell
+	mGrid.updateObjects(handles, count, mPool);
+}
+
+void HashGridPruner::purge()
+{
+}
+
+void HashGridPruner::commit()
+{
+	// The grid is always up-to-date, there is nothing to build
+}
+
+void HashGridPruner::merge(const void*)
+{
+	// merge not implemented for hash grid pruner
+}
+
+void HashGridPruner::shiftOrigin(const PxVec3& shift)
+{
+	mPool.shiftOrigin(shift);
+
+	// Cell coordinates depend on the origin so we have to rebin everything
+	mGrid.release();
+	const PxU32 nbObjects = mPool.getNbActiveObjects();
+	const PxBounds3* boxes = mPool.getCurrentWorldBoxes();
+	for(PxU32 i=0;i<nbObjects;i++)
+		mGrid.addObject(mPool.mIndexToHandle[i], boxes[i]);
+}
+
+bool HashGridPruner::overlap(const ShapeData& queryVolume, PrunerOverlapCallback& pcb) const
+{
+	const PxBounds3& queryBounds = queryVolume.getPrunerInflatedWorldAABB();
+
+	bool again = true;
+	switch(queryVolume.getType())
+	{
+		case PxGeometryType::eBOX:
+		{
+			if(queryVolume.isOBB())
+			{	
+				const DefaultOBBAABBTest test(queryVolume);
+				again = mGrid.overlap(mPool, queryBounds, test, pcb);
+			}
+			else
+			{
+				const DefaultAABBAABBTest test(queryVolume);
+				again = mGrid.overlap(mPool, queryBounds, test, pcb);
+			}
+		}
+		break;
+
+		case PxGeometryType::eCAPSULE:
+		{
+			const DefaultCapsuleAABBTest test(queryVolume, SQ_PRUNER_INFLATION);
+			again = mGrid.overlap(mPool, queryBounds, test, pcb);
+		}
+		break;
+
+		case PxGeometryType::eSPHERE:
+		{
+			const DefaultSphereAABBTest test(queryVolume);
+			again = mGrid.overlap(mPool, queryBounds, test, pcb);
+		}
+		break;
+
+		case PxGeometryType::eCONVEXMESH:
+		{
+			const DefaultOBBAABBTest test(queryVolume);
+			again = mGrid.overlap(mPool, queryBounds, test, pcb);
+		}
+		break;
+	default:
+		PX_ALWAYS_ASSERT_MESSAGE("unsupported overlap query volume geometry type");
+	}
+	return again;
+}
+
+bool HashGridPruner::sweep(const ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, PrunerRaycastCallback& pcb) const
+{
+	const PxBounds3& aabb = queryVolume.getPrunerInflatedWorldAABB();
+	return mGrid.raycast<true>(mPool, aabb.getCenter(), unitDir, inOutDistance, aabb.getExtents(), pcb);
+}
+
+bool HashGridPruner::raycast(const PxVec3& origin, const PxVec3& unitDir, PxReal& inOutDistance, PrunerRaycastCallback& pcb) const
+{
+	return mGrid.raycast<false>(mPool, origin, unitDir, inOutDistance, PxVec3(0.0f), pcb);
+}
+
+void HashGridPruner::visualize(PxRenderOutput& out, PxU32 primaryColor, PxU32 /*secondaryColor*/) const
+{
+	mGrid.visualize(out, primaryColor);
+}
+
+void HashGridPruner::getGlobalBounds(PxBounds3& bounds) const
+{
+	bounds.setEmpty();
+
+	const PxU32 nbObjects = mPool.getNbActiveObjects();
+	const PxBounds3* boxes = mPool.getCurrentWorldBoxes();
+	for(PxU32 i=0;i<nbObjects;i++)
+		bounds.include(boxes[i]);
+}
@@ -0,0 +1,263 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2023 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef GU_HASH_GRID_PRUNER_H
+#define GU_HASH_GRID_PRUNER_H
+
+#include "common/PxPhysXCommonConfig.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxHash.h"
+#include "foundation/PxMath.h"
+#include "GuPruner.h"
+#include "GuSqInternal.h"
+#include "GuPruningPool.h"
+
+// Number of regular grid levels. Level i uses cells of size cellSize * 2^i. Objects that do not fit in the last level
+// go to an extra overflow level made of a single cell, which is always tested.
+#define HASH_GRID_NB_LEVELS	16
+
+namespace physx
+{
+	class PxRenderOutput;
+
+namespace Gu
+{
+#if PX_VC 
+    #pragma warning(push)
+	#pragma warning( disable : 4324 ) // Padding was added at the end of a structure because of a __declspec(align) value.
+#endif
+
+	// Bounds of four objects in SoA form, so that cell scans can test four boxes at a time. Blocks are allocated from
+	// a pool shared by all cells and linked together per cell.
+	PX_ALIGN_PREFIX(16)	struct HashGridBoxes4
+	{
+		float			mMinX[4];
+		float			mMinY[4];
+		float			mMinZ[4];
+		float			mMaxX[4];
+		float			mMaxY[4];
+		float			mMaxZ[4];
+		PrunerHandle	mHandles[4];
+		PxU32			mNext;		// Next block of the same cell, or next free block
+		PxU32			mPad[3];
+	}PX_ALIGN_SUFFIX(16);
+
+#if PX_VC 
+     #pragma warning(pop) 
+#endif
+
+	struct HashGridCellKey
+	{
+		PxI32	mX, mY, mZ;
+		PxU32	mLevel;
+	};
+
+	// Bounds of the cell keys used by a level. They only grow while the level has cells, and are reset when the
+	// first cell of an empty level is created.
+	struct HashGridKeyBounds
+	{
+		PxI32	mMin[3];
+		PxI32	mMax[3];
+
+		PX_FORCE_INLINE	void	set(const HashGridCellKey& k)
+		{
+			mMin[0] = mMax[0] = k.mX;
+			mMin[1] = mMax[1] = k.mY;
+			mMin[2] = mMax[2] = k.mZ;
+		}
+
+		PX_FORCE_INLINE	void	include(const HashGridCellKey& k)
+		{
+			mMin[0] = PxMin(mMin[0], k.mX);	mMax[0] = PxMax(mMax[0], k.mX);
+			mMin[1] = PxMin(mMin[1], k.mY);	mMax[1] = PxMax(mMax[1], k.mY);
+			mMin[2] = PxMin(mMin[2], k.mZ);	mMax[2] = PxMax(mMax[2], k.mZ);
+		}
+	};
+
+	struct HashGridCellKeyHash
+	{
+		PX_FORCE_INLINE	PxU32	operator()(const HashGridCellKey& k)	const
+		{
+			return physx::PxComputeHash((PxU32(k.mX)*73856093u) ^ (PxU32(k.mY)*19349663u) ^ (PxU32(k.mZ)*83492791u) ^ (k.mLevel<<27));
+		}
+
+		PX_FORCE_INLINE	bool	equal(const HashGridCellKey& k0, const HashGridCellKey& k1)	const
+		{
+			return k0.mX==k1.mX && k0.mY==k1.mY && k0.mZ==k1.mZ && k0.mLevel==k1.mLevel;
+		}
+	};
+
+	// Map from cell keys to cell indices. This is an open-addressing hash table with linear probing and keys stored
+	// inline, so that a lookup usually touches a single cache line. Most lookups done by queries are for empty cells,
+	// and moving objects constantly create and delete cells, so this is faster than a chained hash map here.
+	class HashGridCellMap : public PxUserAllocated
+	{
+		public:
+												HashGridCellMap();
+												~HashGridCellMap();
+
+		// Returns the index of the cell, or NULL if the cell does not exist
+		PX_FORCE_INLINE	const PxU32*			find(const HashGridCellKey& key)	const
+												{
+													if(!mNbEntries)
+														return NULL;
+
+													const HashGridCellKeyHash hash;
+													PxU32 i = hash(key) & mMask;
+													for(;;)
+													{
+														const Entry& e = mEntries[i];
+														if(e.mCell==0xffffffff)
+															return NULL;
+														if(hash.equal(e.mKey, key))
+															return &e.mCell;
+														i = (i+1) & mMask;
+													}
+												}
+
+						void					insert(const HashGridCellKey& key, PxU32 cellIndex);	// The key must not be in the map already
+						void					erase(const HashGridCellKey& key);						// The key must be in the map
+						void					release();
+		private:
+						struct Entry
+						{
+							HashGridCellKey	mKey;
+							PxU32			mCell;	// 0xffffffff for empty entries
+						};
+
+						void					resize(PxU32 newSize);
+
+						Entry*					mEntries;
+						PxU32					mMask;
+						PxU32					mNbEntries;
+	};
+
+	struct HashGridCell
+	{
+		HashGridCellKey	mKey;
+		PxU32			mLevelSlot;		// Index of the cell in its level's list of active cells
+		PxU32			mNbBoxes;
+		PxU32			mFirstBlock;	// Copy of the objects' bounds. Only the first block of the list can be partially used.
+		PxU32			mPad;
+	};
+
+	// Location of an object in the grid, indexed by PrunerHandle. The key is duplicated here so that updates of
+	// objects that stay in the same cell do not need to look at the cell itself.
+	struct HashGridObject
+	{
+		HashGridCellKey	mKey;
+		PxU32			mCell;
+		PxU32			mBox;	// Block index * 4 + lane
+	};
+
+	// Loose multi-level hash grid. Each object lives in exactly one cell, selected by the object's center on the
+	// level whose cell size best matches the object's size. Cells are only allocated when occupied and are found
+	// through a hash map, so insertion, update and removal are O(1) regardless of the world size.
+	class HashGrid : public PxUserAllocated
+	{
+		public:
+												HashGrid(float cellSize);
+												~HashGrid();
+
+						void					addObject(PrunerHandle handle, const PxBounds3& bounds);
+						void					updateObject(PrunerHandle handle, const PxBounds3& bounds);
+						void					updateObjects(const PrunerHandle* handles, PxU32 count, const PruningPool& pool);
+						void					removeObject(PrunerHandle handle);
+						void					release();
+
+		template<class Test>
+						bool					overlap(const PruningPool& pool, const PxBounds3& queryBounds, const Test& test, PrunerOverlapCallback& pcb)	const;
+		template<bool tInflate>
+						bool					raycast(const PruningPool& pool, const PxVec3& origin, const PxVec3& unitDir, PxReal& inOutDistance, const PxVec3& inflation, PrunerRaycastCallback& pcb)	const;
+
+						void					visualize(PxRenderOutput& out, PxU32 color)	const;
+
+		PX_FORCE_INLINE	float					getCellSize(PxU32 level)	const	{ return mCellSizes[level];	}
+		PX_FORCE_INLINE	float					getLooseExtent(PxU32 level)	const	{ return mLevelExtents[level];	}
+		PX_FORCE_INLINE	const HashGridBoxes4*	getBlocks()					const	{ return mBlocks.begin();	}
+		PX_FORCE_INLINE	PxU32					getNbCells(PxU32 level)		const	{ return mLevelCells[level].size();	}
+		PX_FORCE_INLINE	const HashGridCell&		getCell(PxU32 index)		const	{ return mCells[index];	}
+		PX_FORCE_INLINE	const PxU32*			getLevelCells(PxU32 level)	const	{ return mLevelCells[level].begin();	}
+		PX_FORCE_INLINE	const HashGridCell*		findCell(const HashGridCellKey& key)	const
+												{
+													const PxU32* cellIndex = mCellMap.find(key);
+													return cellIndex ? &mCells[*cellIndex] : NULL;
+												}
+		private:
+						void					computeCellKey(const PxBounds3& bounds, HashGridCellKey& key, float& extent)	const;
+						PxU32					getOrCreateCell(const HashGridCellKey& key);
+						void					insertInCell(PrunerHandle handle, PxU32 cellIndex, const PxBounds3& bounds, float extent);
+						void					removeFromCell(PrunerHandle handle);
+						PxU32					allocBlock();
+						void					freeBlock(PxU32 block);
+
+						float					mCellSizes[HASH_GRID_NB_LEVELS];
+						float					mInvCellSizes[HASH_GRID_NB_LEVELS];
+						HashGridKeyBounds		mLevelBounds[HASH_GRID_NB_LEVELS];
+						// Largest half-extent of the objects of each level, in cell units. At most half a cell, but
+						// usually much smaller. It bounds how far objects can stick out of their cell, and like the
+						// level bounds it only grows until the level becomes empty.
+						float					mLevelExtents[HASH_GRID_NB_LEVELS];
+
+						PxArray<HashGridCell>	mCells;
+						PxArray<PxU32>			mFreeCells;
+						PxArray<HashGridBoxes4>	mBlocks;
+						PxU32					mFreeBlocks;
+						PxArray<PxU32>			mLevelCells[HASH_GRID_NB_LEVELS+1];	// Active cells per level, last one is the overflow level
+						PxArray<HashGridObject>	mObjects;
+						HashGridCellMap			mCellMap;
+	};
+
+	// Pruner for large numbers of small, uniformly distributed dynamic objects (projectiles, debris...). Trees degrade
+	// when such objects all move every frame, while the hash grid only rebins the objects that changed cells.
+	class HashGridPruner : public Pruner
+	{
+		public:
+		PX_PHYSX_COMMON_API						HashGridPruner(PxU64 contextID, float cellSize);
+		virtual									~HashGridPruner();
+
+		// BasePruner
+												DECLARE_BASE_PRUNER_API
+		//~BasePruner
+
+		// Pruner
+												DECLARE_PRUNER_API_COMMON
+		//~Pruner
+
+		// direct access for test code
+		PX_FORCE_INLINE	const HashGrid&			getGrid()	const	{ return mGrid;	}
+
+		private:
+						HashGrid				mGrid;
+						PruningPool				mPool;
+	};
+}
+
+}
+
+#endif
@@ -42,14 +42,11 @@
 #include "GuBox.h"
 #include "GuCapsule.h"
 #include "GuQuery.h"
+#include "GuSqInternal.h"
 
 using namespace physx;
 using namespace Gu;
 
-// PT: TODO: this is copied from SqBounds.h, should be either moved to Gu and shared or passed as a user parameter
-	#define SQ_PRUNER_EPSILON	0.005f
-	#define SQ_PRUNER_INFLATION	(1.0f + SQ_PRUNER_EPSILON)	// pruner test shape inflation (not narrow phase shape)
-
 #define PARANOIA_CHECKS 0
 
 IncrementalAABBPruner::IncrementalAABBPruner(PxU32 sceneLimit, PxU64 contextID) :
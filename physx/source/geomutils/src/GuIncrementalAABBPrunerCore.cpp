@@ -43,10 +43,6 @@ using namespace Gu;
 
 #define PARANOIA_CHECKS 0
 
-// PT: TODO: this is copied from SqBounds.h, should be either moved to Gu and shared or passed as a user parameter
-	#define SQ_PRUNER_EPSILON	0.005f
-	#define SQ_PRUNER_INFLATION	(1.0f + SQ_PRUNER_EPSILON)	// pruner test shape inflation (not narrow phase shape)
-
 IncrementalAABBPrunerCore::IncrementalAABBPrunerCore(const PruningPool* pool) :
 	mCurrentTree	(1),
 	mLastTree		(0),
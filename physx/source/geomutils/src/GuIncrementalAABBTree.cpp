@@ -198,35 +198,31 @@ PX_FORCE_INLINE static bool boundsEqual(const Vec4V& testMin, const Vec4V& testM
 	return (PxIntBool(V4AllEq(nodeMin, testMin)) && PxIntBool(V4AllEq(testMax, nodeMax)));
 }
 
-// update the node hierarchy bounds when remove happen, we can early exit if the bounds are equal and no bounds update
-// did happen
-PX_FORCE_INLINE static void updateHierarchyAfterRemove(IncrementalAABBTreeNode* node, const PxBounds3* bounds)
-{	
-	if(node->isLeaf())
-	{		
-		const AABBTreeIndices& indices = *node->mIndices;
-		PX_ASSERT(indices.nbIndices > 0);
-
-		Vec4V bvMin = V4LoadU(&bounds[indices.indices[0]].minimum.x);
-		Vec4V bvMax = V4LoadU(&bounds[indices.indices[0]].maximum.x);
-		for(PxU32 i = 1; i < indices.nbIndices; i++)
-		{
-			const Vec4V minV = V4LoadU(&bounds[indices.indices[i]].minimum.x);
-			const Vec4V maxV = V4LoadU(&bounds[indices.indices[i]].maximum.x);
-
-			bvMin = V4Min(bvMin, minV);
-			bvMax = V4Max(bvMax, maxV);
-		}
+// recompute the leaf bounds from its primitives
+PX_FORCE_INLINE static void refitLeafNode(IncrementalAABBTreeNode* node, const PxBounds3* bounds)
+{
+	PX_ASSERT(node->isLeaf());
+	const AABBTreeIndices& indices = *node->mIndices;
+	PX_ASSERT(indices.nbIndices > 0);
 
-		node->mBVMin = V4ClearW(bvMin);
-		node->mBVMax = V4ClearW(bvMax);
-	}
-	else
+	Vec4V bvMin = V4LoadU(&bounds[indices.indices[0]].minimum.x);
+	Vec4V bvMax = V4LoadU(&bounds[indices.indices[0]].maximum.x);
+	for(PxU32 i = 1; i < indices.nbIndices; i++)
 	{
-		node->mBVMin = V4Min(node->mChilds[0]->mBVMin, node->mChilds[1]->mBVMin);
-		node->mBVMax = V4Max(node->mChilds[0]->mBVMax, node->mChilds[1]->mBVMax);
+		const Vec4V minV = V4LoadU(&bounds[indices.indices[i]].minimum.x);
+		const Vec4V maxV = V4LoadU(&bounds[indices.indices[i]].maximum.x);
+
+		bvMin = V4Min(bvMin, minV);
+		bvMax = V4Max(bvMax, maxV);
 	}
 
+	node->mBVMin = V4ClearW(bvMin);
+	node->mBVMax = V4ClearW(bvMax);
+}
+
+// propagate the node bounds to its parents, we can early exit if the parent bounds did not change
+PX_FORCE_INLINE static void refitParents(IncrementalAABBTreeNode* node)
+{
 	IncrementalAABBTreeNode* parent = node->mParent;
 	while(parent)
 	{
@@ -244,6 +240,23 @@ PX_FORCE_INLINE static void updateHierarchyAfterRemove(IncrementalAABBTreeNode*
 	}
 }
 
+// update the node hierarchy bounds when remove happen, we can early exit if the bounds are equal and no bounds update
+// did happen
+PX_FORCE_INLINE static void updateHierarchyAfterRemove(IncrementalAABBTreeNode* node, const PxBounds3* bounds)
+{	
+	if(node->isLeaf())
+	{
+		refitLeafNode(node, bounds);
+	}
+	else
+	{
+		node->mBVMin = V4Min(node->mChilds[0]->mBVMin, node->mChilds[1]->mBVMin);
+		node->mBVMax = V4Max(node->mChilds[0]->mBVMax, node->mChilds[1]->mBVMax);
+	}
+
+	refitParents(node);
+}
+
 // split the leaf node along the most significant axis
 IncrementalAABBTreeNode* IncrementalAABBTree::splitLeafNode(IncrementalAABBTreeNode* node, const PoolIndex index,  const Vec4V& minV,  const Vec4V& maxV, const PxBounds3* bounds)
 {
@@ -699,6 +712,20 @@ IncrementalAABBTreeNode* IncrementalAABBTree::updateFast(IncrementalAABBTreeNode
 	}
 }
 
+// refit a set of leaves whose primitives moved, the tree topology is kept
+void IncrementalAABBTree::refitLeaves(IncrementalAABBTreeNode* const* leaves, PxU32 nbLeaves, const PxBounds3* bounds)
+{
+	PX_SIMD_GUARD;
+
+	// first refit all the leaves, so that the parents are recomputed only once from their final children
+	for(PxU32 i = 0; i < nbLeaves; i++)
+		refitLeafNode(leaves[i], bounds);
+
+	// then walk up, the walk stops as soon as a parent already encloses exactly its children
+	for(PxU32 i = 0; i < nbLeaves; i++)
+		refitParents(leaves[i]);
+}
+
 // remove primitive from the tree, return a node if it moved to its parent
 IncrementalAABBTreeNode* IncrementalAABBTree::remove(IncrementalAABBTreeNode* node, const PoolIndex index, const PxBounds3* bounds)
 {
@@ -144,6 +144,9 @@ namespace physx
 			// update the object in the tree, faster method, that may unbalance the tree
 			PX_PHYSX_COMMON_API	IncrementalAABBTreeNode*			updateFast(IncrementalAABBTreeNode* node, const PoolIndex index, const PxBounds3* bounds, NodeList& changedLeaf);
 
+			// refit the given leaves and their parents after their objects moved, faster than update but keeps the tree topology
+			PX_PHYSX_COMMON_API	void								refitLeaves(IncrementalAABBTreeNode* const* leaves, PxU32 nbLeaves, const PxBounds3* bounds);
+
 			// remove object from the tree
 			PX_PHYSX_COMMON_API	IncrementalAABBTreeNode*			remove(IncrementalAABBTreeNode* node, const PoolIndex index, const PxBounds3* bounds);
 
@@ -409,6 +409,7 @@ void Gu::TriangleMesh::getBinaryMetaData(PxOutputStream& stream)
 	PX_DEF_BIN_METADATA_ITEM(stream,	TriangleMesh, PxU32,			mAccumulatedTrianglesRef,	PxMetaDataFlag::ePTR)
 	PX_DEF_BIN_METADATA_ITEM(stream,	TriangleMesh, PxU32,			mTrianglesReferences,		PxMetaDataFlag::ePTR)
 	PX_DEF_BIN_METADATA_ITEM(stream,	TriangleMesh, PxU32,			mNbTrianglesReferences,		0)
+	PX_DEF_BIN_METADATA_ITEM(stream,	TriangleMesh, PxU32,			mModificationStamp,			0)
 
 	//------ Extra-data ------
 
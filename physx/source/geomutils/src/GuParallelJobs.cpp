@@ -0,0 +1,147 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2023 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "foundation/PxAtomic.h"
+#include "foundation/PxMath.h"
+#include "foundation/PxThread.h"
+#include "foundation/PxUserAllocated.h"
+#include "task/PxTask.h"
+#include "task/PxCpuDispatcher.h"
+#include "GuParallelJobs.h"
+
+using namespace physx;
+using namespace Gu;
+
+#define PARALLEL_JOBS_MAX_NB_TASKS	32
+
+namespace
+{
+	class JobRunner;
+
+	class JobTask : public PxBaseTask
+	{
+	public:
+		virtual	void		run()							PX_OVERRIDE;
+		virtual	const char*	getName()				const	PX_OVERRIDE	{ return "Gu::ParallelJob";	}
+		virtual	void		addReference()					PX_OVERRIDE	{}
+		virtual	void		removeReference()				PX_OVERRIDE	{}
+		virtual	PxI32		getReference()			const	PX_OVERRIDE	{ return 1;						}
+		virtual	void		release()						PX_OVERRIDE;
+
+				JobRunner*	mOwner;
+	};
+
+	// Shared by the calling thread and the worker tasks. Tasks can start after the calling thread completed all the jobs and
+	// moved on, so the runner is deleted by whoever releases it last, and tasks that find no job left never touch the user data.
+	class JobRunner : public PxUserAllocated
+	{
+	public:
+		JobRunner(JobFunction function, void* userData, PxU32 nbJobs, PxU32 nbTasks) :
+			mFunction	(function),
+			mUserData	(userData),
+			mNbJobs		(PxI32(nbJobs)),
+			mNextJob	(0),
+			mNbDoneJobs	(0),
+			mRefCount	(PxI32(nbTasks + 1))
+		{
+			for(PxU32 i=0;i<nbTasks;i++)
+				mTasks[i].mOwner = this;
+		}
+
+		void	processJobs()
+		{
+			for(;;)
+			{
+				const PxI32 jobIndex = PxAtomicIncrement(&mNextJob) - 1;
+				if(jobIndex >= mNbJobs)
+					return;
+
+				mFunction(mUserData, PxU32(jobIndex));
+				PxAtomicIncrement(&mNbDoneJobs);
+			}
+		}
+
+		bool	isDone()
+		{
+			return PxAtomicAdd(&mNbDoneJobs, 0) == mNbJobs;
+		}
+
+		void	releaseReference()
+		{
+			if(!PxAtomicDecrement(&mRefCount))
+				PX_DELETE_THIS;
+		}
+
+		const JobFunction	mFunction;
+		void* const			mUserData;
+		const PxI32			mNbJobs;
+		volatile PxI32		mNextJob;
+		volatile PxI32		mNbDoneJobs;
+		volatile PxI32		mRefCount;
+		JobTask				mTasks[PARALLEL_JOBS_MAX_NB_TASKS];
+	};
+
+	void JobTask::run()
+	{
+		mOwner->processJobs();
+	}
+
+	void JobTask::release()
+	{
+		mOwner->releaseReference();
+	}
+}
+
+// Runs the jobs on the calling thread and on up to one task per worker thread, and returns when all of them are done.
+void Gu::runJobs(PxCpuDispatcher* dispatcher, JobFunction function, void* userData, PxU32 nbJobs)
+{
+	if(!nbJobs)
+		return;
+
+	const PxU32 nbWorkers = dispatcher ? dispatcher->getWorkerCount() : 0;
+	const PxU32 nbTasks = PxMin(PxMin(nbWorkers, nbJobs - 1), PxU32(PARALLEL_JOBS_MAX_NB_TASKS));
+	if(!nbTasks)
+	{
+		for(PxU32 i=0;i<nbJobs;i++)
+			function(userData, i);
+		return;
+	}
+
+	JobRunner* runner = PX_NEW(JobRunner)(function, userData, nbJobs, nbTasks);
+	for(PxU32 i=0;i<nbTasks;i++)
+		dispatcher->submitTask(runner->mTasks[i]);
+
+	runner->processJobs();
+
+	// Jobs claimed by the workers may still be running. They never wait for anything, so this cannot deadlock even when
+	// the calling thread is itself a worker thread.
+	while(!runner->isDone())
+		PxThread::yield();
+
+	runner->releaseReference();
+}
@@ -0,0 +1,63 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2023 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef GU_PARALLEL_JOBS_H
+#define GU_PARALLEL_JOBS_H
+
+/** \addtogroup geomutils
+@{
+*/
+
+#include "foundation/PxSimpleTypes.h"
+#include "common/PxPhysXCommonConfig.h"
+
+namespace physx
+{
+	class PxCpuDispatcher;
+
+namespace Gu
+{
+	typedef void (*JobFunction)(void* userData, PxU32 jobIndex);
+
+	/*
+	*	\brief		Runs a set of independent jobs on the calling thread and on the workers of a CPU dispatcher.
+	*
+	*	Jobs are claimed dynamically by the calling thread and by up to one task per worker thread. The function returns
+	*	when all jobs are done. Without a dispatcher, or with a single job, everything runs on the calling thread.
+	*
+	*	\param		dispatcher			[in]	CPU dispatcher, or NULL
+	*	\param		function			[in]	Job function, called once per job index
+	*	\param		userData			[in]	User data passed to the job function
+	*	\param		nbJobs				[in]	Number of jobs
+	*/
+	PX_PHYSX_COMMON_API void	runJobs(PxCpuDispatcher* dispatcher, JobFunction function, void* userData, PxU32 nbJobs);
+}
+}
+
+/** @} */
+#endif
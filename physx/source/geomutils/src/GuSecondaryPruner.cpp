@@ -179,6 +179,7 @@ class CompanionPrunerIncremental : public CompanionPruner
 #include "GuAABBTreeBuildStats.h"
 #include "GuAABBTreeQuery.h"
 #include "GuQuery.h"
+#include "GuSqInternal.h"
 #ifdef USE_MAVERICK_NODE
 	#include "GuMaverickNode.h"
 #endif
@@ -866,10 +867,6 @@ bool CompanionPrunerAABBTree::raycast(const PxVec3& origin, const PxVec3& unitDi
 	return true;
 }
 
-// PT: TODO: this is copied from SqBounds.h, should be either moved to Gu and shared or passed as a user parameter
-	#define SQ_PRUNER_EPSILON	0.005f
-	#define SQ_PRUNER_INFLATION	(1.0f + SQ_PRUNER_EPSILON)	// pruner test shape inflation (not narrow phase shape)
-
 bool CompanionPrunerAABBTree::overlap(const ShapeData& queryVolume, PrunerOverlapCallback& prunerCallback) const
 {
 	PX_UNUSED(queryVolume);
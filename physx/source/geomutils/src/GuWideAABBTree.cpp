@@ -0,0 +1,294 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2023 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "foundation/PxArray.h"
+#include "foundation/PxBitUtils.h"
+#include "GuWideAABBTree.h"
+#include "GuAABBTree.h"
+#include "GuAABBTreeNode.h"
+
+using namespace physx;
+using namespace Gu;
+
+// Quantized values are in [-GU_WIDE_TREE_QUANTIZED_MAX, GU_WIDE_TREE_QUANTIZED_MAX]
+#define GU_WIDE_TREE_QUANTIZED_MAX	32767
+// Packed min/max for empty children: min > max, so that they fail all tests
+#define GU_WIDE_TREE_EMPTY_BOUNDS	((PxU32(0x8000)<<16)|0x7fff)
+// Extra room around the tree bounds when setting up the quantization range, so that objects moving a bit outside of them
+// don't force a requantization of the whole tree at each refit.
+#define GU_WIDE_TREE_RANGE_MARGIN	1.5f
+
+WideAABBTree::WideAABBTree() :
+	mCenter			(0.0f),
+	mScale			(1.0f),
+	mInvScale		(1.0f),
+	mNodes			(NULL),
+	mNbNodes		(0),
+	mSlotNodes		(NULL),
+	mNodeSlots		(NULL),
+	mNbBinaryNodes	(0)
+{
+}
+
+WideAABBTree::~WideAABBTree()
+{
+	release();
+}
+
+void WideAABBTree::release()
+{
+	PX_FREE(mNodeSlots);
+	PX_FREE(mSlotNodes);
+	PX_FREE(mNodes);
+	mNbNodes = 0;
+	mNbBinaryNodes = 0;
+}
+
+static PX_FORCE_INLINE float getSurfaceArea(const PxBounds3& bounds)
+{
+	const PxVec3 e = bounds.maximum - bounds.minimum;
+	return e.x * e.y + e.y * e.z + e.z * e.x;
+}
+
+bool WideAABBTree::build(const BVHCoreData& tree)
+{
+	release();
+
+	const PxU32 nbBinaryNodes = tree.getNbNodes();
+	const BVHNode* nodes = tree.getNodes();
+	if(!nbBinaryNodes || !nodes)
+		return false;
+
+	// Each wide node is created for a different internal binary node, and a binary tree with N nodes has (N-1)/2 of them.
+	// The only exception is a tree made of a single leaf, which still needs a root.
+	const PxU32 maxNbNodes = PxMax(PxU32(1), (nbBinaryNodes - 1)/2);
+	mNodes = PX_ALLOCATE(WideBVHNode, maxNbNodes, "WideBVHNode");
+	mSlotNodes = PX_ALLOCATE(PxU32, maxNbNodes*GU_WIDE_TREE_WIDTH, "WideAABBTree slot nodes");
+	mNodeSlots = PX_ALLOCATE(PxU32, nbBinaryNodes, "WideAABBTree node slots");
+	for(PxU32 i=0;i<nbBinaryNodes;i++)
+		mNodeSlots[i] = GU_WIDE_TREE_EMPTY_CHILD;
+	mNbBinaryNodes = nbBinaryNodes;
+
+	// Pairs of (binary node, wide node to fill with its collapsed children)
+	PxArray<PxU32> stack;
+	stack.pushBack(0);
+	stack.pushBack(0);
+	mNbNodes = 1;
+
+	while(stack.size())
+	{
+		const PxU32 wideIndex = stack.popBack();
+		const PxU32 binaryIndex = stack.popBack();
+
+		// Open the internal child with the largest surface area until there are four children or only leaves left
+		PxU32 children[GU_WIDE_TREE_WIDTH];
+		PxU32 nbChildren;
+		if(nodes[binaryIndex].isLeaf())
+		{
+			// Only happens for a single-leaf tree
+			children[0] = binaryIndex;
+			nbChildren = 1;
+		}
+		else
+		{
+			children[0] = nodes[binaryIndex].getPosIndex();
+			children[1] = nodes[binaryIndex].getNegIndex();
+			nbChildren = 2;
+			while(nbChildren<GU_WIDE_TREE_WIDTH)
+			{
+				PxU32 best = GU_WIDE_TREE_EMPTY_CHILD;
+				float bestArea = -PX_MAX_F32;
+				for(PxU32 i=0;i<nbChildren;i++)
+				{
+					const BVHNode& child = nodes[children[i]];
+					if(!child.isLeaf())
+					{
+						const float area = getSurfaceArea(child.mBV);
+						if(area>bestArea)
+						{
+							bestArea = area;
+							best = i;
+						}
+					}
+				}
+				if(best==GU_WIDE_TREE_EMPTY_CHILD)
+					break;
+
+				const BVHNode& opened = nodes[children[best]];
+				children[best] = opened.getPosIndex();
+				children[nbChildren++] = opened.getNegIndex();
+			}
+		}
+
+		WideBVHNode& node = mNodes[wideIndex];
+		for(PxU32 i=0;i<GU_WIDE_TREE_WIDTH;i++)
+		{
+			const PxU32 slot = wideIndex*GU_WIDE_TREE_WIDTH + i;
+			if(i>=nbChildren)
+			{
+				node.mData[i] = GU_WIDE_TREE_EMPTY_CHILD;
+				mSlotNodes[slot] = GU_WIDE_TREE_EMPTY_CHILD;
+				continue;
+			}
+
+			const PxU32 childIndex = children[i];
+			mSlotNodes[slot] = childIndex;
+			mNodeSlots[childIndex] = slot;
+			if(nodes[childIndex].isLeaf())
+			{
+				node.mData[i] = (childIndex<<1)|1;
+			}
+			else
+			{
+				const PxU32 childWideIndex = mNbNodes++;
+				PX_ASSERT(childWideIndex<maxNbNodes);
+				node.mData[i] = childWideIndex<<1;
+				stack.pushBack(childIndex);
+				stack.pushBack(childWideIndex);
+			}
+		}
+	}
+
+	requantize(nodes);
+	return true;
+}
+
+void WideAABBTree::setQuantizationRange(const PxBounds3& bounds)
+{
+	if(bounds.isEmpty())
+	{
+		mCenter = PxVec4(0.0f);
+		mScale = PxVec4(1.0f);
+		mInvScale = PxVec3(1.0f);
+		return;
+	}
+
+	const PxVec3 center = bounds.getCenter();
+	const PxVec3 extents = bounds.getExtents();
+	mCenter = PxVec4(center, 0.0f);
+	for(PxU32 i=0;i<3;i++)
+	{
+		const float halfRange = PxMax(extents[i], 1e-3f) * GU_WIDE_TREE_RANGE_MARGIN;
+		mScale[i] = halfRange / float(GU_WIDE_TREE_QUANTIZED_MAX);
+		mInvScale[i] = float(GU_WIDE_TREE_QUANTIZED_MAX) / halfRange;
+	}
+	mScale.w = 0.0f;
+}
+
+bool WideAABBTree::quantizeSlot(PxU32 slot, const PxBounds3& bounds)
+{
+	WideBVHNode& node = mNodes[slot/GU_WIDE_TREE_WIDTH];
+	const PxU32 i = slot%GU_WIDE_TREE_WIDTH;
+	PxU32* words[3] = { node.mX, node.mY, node.mZ };
+
+	if(bounds.isEmpty())
+	{
+		// Might happen after a node has been invalidated
+		for(PxU32 axis=0;axis<3;axis++)
+			words[axis][i] = GU_WIDE_TREE_EMPTY_BOUNDS;
+		return true;
+	}
+
+	const float limit = float(GU_WIDE_TREE_QUANTIZED_MAX - 1);
+	bool inRange = true;
+	for(PxU32 axis=0;axis<3;axis++)
+	{
+		const float fmin = (bounds.minimum[axis] - mCenter[axis]) * mInvScale[axis];
+		const float fmax = (bounds.maximum[axis] - mCenter[axis]) * mInvScale[axis];
+
+		PxI32 qmin, qmax;
+		if(fmin >= -limit && fmax <= limit)
+		{
+			// Rounded outwards, plus one extra step to absorb rounding differences in the SIMD dequantization
+			qmin = PxI32(PxFloor(fmin)) - 1;
+			qmax = PxI32(PxCeil(fmax)) + 1;
+		}
+		else
+		{
+			inRange = false;
+			qmin = -GU_WIDE_TREE_QUANTIZED_MAX;
+			qmax = GU_WIDE_TREE_QUANTIZED_MAX;
+		}
+		words[axis][i] = (PxU32(qmin) & 0xffff) | (PxU32(qmax)<<16);
+	}
+	return inRange;
+}
+
+void WideAABBTree::requantize(const BVHNode* nodes)
+{
+	setQuantizationRange(nodes[0].mBV);
+
+	const PxU32 nbSlots = mNbNodes*GU_WIDE_TREE_WIDTH;
+	for(PxU32 slot=0;slot<nbSlots;slot++)
+	{
+		const PxU32 binaryIndex = mSlotNodes[slot];
+		if(binaryIndex==GU_WIDE_TREE_EMPTY_CHILD)
+		{
+			WideBVHNode& node = mNodes[slot/GU_WIDE_TREE_WIDTH];
+			const PxU32 i = slot%GU_WIDE_TREE_WIDTH;
+			node.mX[i] = node.mY[i] = node.mZ[i] = GU_WIDE_TREE_EMPTY_BOUNDS;
+		}
+		else
+		{
+			// The root bounds enclose all the nodes so this cannot fail
+			const bool inRange = quantizeSlot(slot, nodes[binaryIndex].mBV);
+			PX_ASSERT(inRange);
+			PX_UNUSED(inRange);
+		}
+	}
+}
+
+void WideAABBTree::refitMarkedNodes(const BVHNode* nodes, const PxU32* bits, PxU32 nbWords)
+{
+	if(!mNodes || !bits)
+		return;
+
+	bool inRange = true;
+	for(PxU32 w=0;w<nbWords;w++)
+	{
+		for(PxU32 b=bits[w];b;b&=b-1)
+		{
+			const PxU32 index = w<<5|PxLowestSetBit(b);
+			PX_ASSERT(index<mNbBinaryNodes);
+			const PxU32 slot = mNodeSlots[index];
+			if(slot!=GU_WIDE_TREE_EMPTY_CHILD && !quantizeSlot(slot, nodes[index].mBV))
+				inRange = false;
+		}
+	}
+
+	// Some objects moved outside of the quantization range, recompute it from the refit root
+	if(!inRange)
+		requantize(nodes);
+}
+
+void WideAABBTree::shiftOrigin(const PxVec3& shift)
+{
+	mCenter.x -= shift.x;
+	mCenter.y -= shift.y;
+	mCenter.z -= shift.z;
+}
@@ -0,0 +1,113 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2023 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef GU_WIDE_AABBTREE_H
+#define GU_WIDE_AABBTREE_H
+
+#include "foundation/PxBounds3.h"
+#include "foundation/PxVec4.h"
+#include "foundation/PxUserAllocated.h"
+#include "common/PxPhysXCommonConfig.h"
+
+#define GU_WIDE_TREE_WIDTH			4
+#define GU_WIDE_TREE_EMPTY_CHILD	0xffffffff
+
+namespace physx
+{
+namespace Gu
+{
+	struct BVHNode;
+	class BVHCoreData;
+
+	// 4-wide node with quantized child bounds, i.e. one cache line for four children. Bounds are stored per axis, one 32-bit
+	// word per child: quantized min in the low 16 bits, quantized max in the high 16 bits, both signed. This is the same
+	// packing as BV4's swizzled quantized nodes, so that the four children can be dequantized and tested with SIMD at once.
+	PX_ALIGN_PREFIX(16)
+	struct WideBVHNode
+	{
+		PX_FORCE_INLINE	PxU32	isEmpty(PxU32 i)		const	{ return mData[i]==GU_WIDE_TREE_EMPTY_CHILD;	}
+		PX_FORCE_INLINE	PxU32	isLeaf(PxU32 i)			const	{ return mData[i]&1;							}
+		PX_FORCE_INLINE	PxU32	getChildIndex(PxU32 i)	const	{ return mData[i]>>1;							}
+
+		PxU32	mX[GU_WIDE_TREE_WIDTH];
+		PxU32	mY[GU_WIDE_TREE_WIDTH];
+		PxU32	mZ[GU_WIDE_TREE_WIDTH];
+		// (binary leaf node index<<1)|1 for leaves, (wide node index<<1) for internal nodes, GU_WIDE_TREE_EMPTY_CHILD for unused slots.
+		// Leaves point back to the binary tree, so that changes to leaf data (invalidation, index shifts) don't need to be mirrored here.
+		PxU32	mData[GU_WIDE_TREE_WIDTH];
+	}
+	PX_ALIGN_SUFFIX(16);
+
+	PX_COMPILE_TIME_ASSERT(sizeof(WideBVHNode)==64);
+
+	//! Wide quantized copy of a binary BVH, used for faster traversals of large trees. The binary tree remains the
+	//! reference: it is still built, refit and remapped as before, and the wide tree mirrors its bounds.
+	class WideAABBTree : public PxUserAllocated
+	{
+		public:
+		PX_PHYSX_COMMON_API						WideAABBTree();
+		PX_PHYSX_COMMON_API						~WideAABBTree();
+
+		PX_PHYSX_COMMON_API		void			release();
+
+		// Builds the wide layout of a binary tree, collapsing binary nodes into 4-wide nodes.
+		PX_PHYSX_COMMON_API		bool			build(const BVHCoreData& tree);
+
+		// Updates the quantized bounds of the children whose binary node is set in the given refit bitmask.
+		PX_PHYSX_COMMON_API		void			refitMarkedNodes(const BVHNode* nodes, const PxU32* bits, PxU32 nbWords);
+
+		// Recomputes the quantization range from the binary root and requantizes all children.
+		PX_PHYSX_COMMON_API		void			requantize(const BVHNode* nodes);
+
+		PX_PHYSX_COMMON_API		void			shiftOrigin(const PxVec3& shift);
+
+		PX_FORCE_INLINE			const WideBVHNode*	getNodes()		const	{ return mNodes;	}
+		PX_FORCE_INLINE			PxU32				getNbNodes()	const	{ return mNbNodes;	}
+
+		// Dequantized value = center + quantized value * scale
+		PX_FORCE_INLINE			const PxVec4&		getCenter()		const	{ return mCenter;	}
+		PX_FORCE_INLINE			const PxVec4&		getScale()		const	{ return mScale;	}
+
+		private:
+								PX_ALIGN(16, PxVec4)	mCenter;
+								PX_ALIGN(16, PxVec4)	mScale;
+								PxVec3					mInvScale;
+								WideBVHNode*			mNodes;
+								PxU32					mNbNodes;
+								PxU32*					mSlotNodes;			//!< Binary node index for each child slot (node index*4 + child index)
+								PxU32*					mNodeSlots;			//!< Child slot for each binary node, or GU_WIDE_TREE_EMPTY_CHILD if it got collapsed
+								PxU32					mNbBinaryNodes;
+
+								void					setQuantizationRange(const PxBounds3& bounds);
+								bool					quantizeSlot(PxU32 slot, const PxBounds3& bounds);
+	};
+
+} // namespace Gu
+}
+
+#endif // GU_WIDE_AABBTREE_H
@@ -0,0 +1,292 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2023 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef GU_WIDE_AABBTREE_QUERY_H
+#define GU_WIDE_AABBTREE_QUERY_H
+
+#include "foundation/PxBitUtils.h"
+#include "GuAABBTreeQuery.h"
+#include "GuAABBTree.h"
+#include "GuWideAABBTree.h"
+
+namespace physx
+{
+	namespace Gu
+	{
+		// Dequantized bounds of the four children of a wide node, in SoA form
+		struct WideNodeBounds
+		{
+			Vec4V	mMinX, mMinY, mMinZ;
+			Vec4V	mMaxX, mMaxY, mMaxZ;
+		};
+
+		// Per-axis dequantization constants
+		struct WideTreeDequantizer
+		{
+			PX_FORCE_INLINE	WideTreeDequantizer(const WideAABBTree& tree)
+			{
+				const Vec4V centerV = V4LoadA(&tree.getCenter().x);
+				const Vec4V scaleV = V4LoadA(&tree.getScale().x);
+				mCenterX = V4SplatElement<0>(centerV);
+				mCenterY = V4SplatElement<1>(centerV);
+				mCenterZ = V4SplatElement<2>(centerV);
+				mScaleX = V4SplatElement<0>(scaleV);
+				mScaleY = V4SplatElement<1>(scaleV);
+				mScaleZ = V4SplatElement<2>(scaleV);
+			}
+
+			static PX_FORCE_INLINE void dequantizeAxis(Vec4V& minV, Vec4V& maxV, const PxU32* packed, const Vec4V centerV, const Vec4V scaleV)
+			{
+				// Same unpacking as BV4's OPC_DEQ4: sign-extended low 16 bits for min, arithmetic shift of the high 16 bits for max
+				const VecI32V packedV = I4LoadA(reinterpret_cast<const PxI32*>(packed));
+				const VecI32V minI = VecI32V_RightShift(VecI32V_LeftShift(packedV, 16), 16);
+				const VecI32V maxI = VecI32V_RightShift(packedV, 16);
+				minV = V4MulAdd(Vec4V_From_VecI32V(minI), scaleV, centerV);
+				maxV = V4MulAdd(Vec4V_From_VecI32V(maxI), scaleV, centerV);
+			}
+
+			PX_FORCE_INLINE	void	dequantize(WideNodeBounds& bounds, const WideBVHNode& node)	const
+			{
+				dequantizeAxis(bounds.mMinX, bounds.mMaxX, node.mX, mCenterX, mScaleX);
+				dequantizeAxis(bounds.mMinY, bounds.mMaxY, node.mY, mCenterY, mScaleY);
+				dequantizeAxis(bounds.mMinZ, bounds.mMaxZ, node.mZ, mCenterZ, mScaleZ);
+			}
+
+			Vec4V	mCenterX, mCenterY, mCenterZ;
+			Vec4V	mScaleX, mScaleY, mScaleZ;
+		};
+
+		// Children that are neither unused nor invalidated have min <= max
+		static PX_FORCE_INLINE BoolV getValidChildren(const WideNodeBounds& bounds)
+		{
+			return V4IsGrtrOrEq(bounds.mMaxX, bounds.mMinX);
+		}
+
+		//////////////////////////////////////////////////////////////////////////
+
+		// Overlap traversal. The four children of each node are first culled against the query's AABB with SIMD, then the
+		// surviving ones go through the exact test, as for the binary tree.
+		template<typename Test, typename QueryCallback>
+		class WideAABBTreeOverlap
+		{
+		public:
+			bool operator()(const AABBTreeBounds& treeBounds, const BVHCoreData& tree, const WideAABBTree& wideTree, const PxBounds3& cullBox, const Test& test, QueryCallback& visitor)
+			{
+				const PxBounds3* bounds = treeBounds.getBounds();
+				const BVHNode* const binaryNodes = tree.getNodes();
+				const WideBVHNode* const nodes = wideTree.getNodes();
+				const WideTreeDequantizer dequantizer(wideTree);
+
+				const Vec4V boxMinX = V4Load(cullBox.minimum.x);
+				const Vec4V boxMinY = V4Load(cullBox.minimum.y);
+				const Vec4V boxMinZ = V4Load(cullBox.minimum.z);
+				const Vec4V boxMaxX = V4Load(cullBox.maximum.x);
+				const Vec4V boxMaxY = V4Load(cullBox.maximum.y);
+				const Vec4V boxMaxZ = V4Load(cullBox.maximum.z);
+
+				PxInlineArray<PxU32, RAW_TRAVERSAL_STACK_SIZE> stack;
+				stack.forceSize_Unsafe(RAW_TRAVERSAL_STACK_SIZE);
+				stack[0] = 0;
+				PxU32 stackIndex = 1;
+
+				while(stackIndex > 0)
+				{
+					const WideBVHNode& node = nodes[stack[--stackIndex]];
+
+					WideNodeBounds nb;
+					dequantizer.dequantize(nb, node);
+
+					const BoolV overlapX = BAnd(V4IsGrtrOrEq(nb.mMaxX, boxMinX), V4IsGrtrOrEq(boxMaxX, nb.mMinX));
+					const BoolV overlapY = BAnd(V4IsGrtrOrEq(nb.mMaxY, boxMinY), V4IsGrtrOrEq(boxMaxY, nb.mMinY));
+					const BoolV overlapZ = BAnd(V4IsGrtrOrEq(nb.mMaxZ, boxMinZ), V4IsGrtrOrEq(boxMaxZ, nb.mMinZ));
+					PxU32 mask = BGetBitMask(BAnd(BAnd(overlapX, overlapY), BAnd(overlapZ, getValidChildren(nb))));
+					if(!mask)
+						continue;
+
+					// Exact tests use the same center/extents as the binary traversal
+					PX_ALIGN(16, PxVec4) minX, minY, minZ, maxX, maxY, maxZ;
+					V4StoreA(nb.mMinX, &minX.x);	V4StoreA(nb.mMinY, &minY.x);	V4StoreA(nb.mMinZ, &minZ.x);
+					V4StoreA(nb.mMaxX, &maxX.x);	V4StoreA(nb.mMaxY, &maxY.x);	V4StoreA(nb.mMaxZ, &maxZ.x);
+
+					while(mask)
+					{
+						const PxU32 i = PxLowestSetBit(mask);
+						mask &= mask - 1;
+
+						const PxVec3 childMin(minX[i], minY[i], minZ[i]);
+						const PxVec3 childMax(maxX[i], maxY[i], maxZ[i]);
+						const Vec3V center = V3LoadU((childMax + childMin)*0.5f);
+						const Vec3V extents = V3LoadU((childMax - childMin)*0.5f);
+						if(!test(center, extents))
+							continue;
+
+						if(node.isLeaf(i))
+						{
+							if(!doOverlapLeafTest<true, Test, BVHNode>(test, binaryNodes + node.getChildIndex(i), bounds, tree.getIndices(), visitor))
+								return false;
+						}
+						else
+						{
+							stack[stackIndex++] = node.getChildIndex(i);
+							if(stackIndex == stack.capacity())
+								stack.resizeUninitialized(stack.capacity() * 2);
+						}
+					}
+				}
+				return true;
+			}
+		};
+
+		//////////////////////////////////////////////////////////////////////////
+
+		// Raycast / sweep traversal, using a four-wide slab test (Kay & Kajiya) on each node. Children are visited front to
+		// back, and stack entries keep their entry distance so that they can be skipped once a closer hit has been found.
+		template <const bool tInflate, typename QueryCallback> // use inflate=true for sweeps, inflate=false for raycasts
+		class WideAABBTreeRaycast
+		{
+			struct StackEntry
+			{
+				PxU32	mData;
+				float	mDistance;
+			};
+
+			static PX_FORCE_INLINE float getSafeInverse(float d)
+			{
+				// Keep the sign for axis-aligned rays, to get infinite but well-defined slab distances
+				const float eps = 1e-9f;
+				return 1.0f / (PxAbs(d) < eps ? (d < 0.0f ? -eps : eps) : d);
+			}
+
+		public:
+			bool operator()(
+				const AABBTreeBounds& treeBounds, const BVHCoreData& tree, const WideAABBTree& wideTree,
+				const PxVec3& origin, const PxVec3& unitDir, PxReal& maxDist, const PxVec3& inflation,
+				QueryCallback& pcb)
+			{
+				const PxBounds3* bounds = treeBounds.getBounds();
+				const BVHNode* const binaryNodes = tree.getNodes();
+				const WideBVHNode* const nodes = wideTree.getNodes();
+				const WideTreeDequantizer dequantizer(wideTree);
+
+				// Leaves are tested exactly as in AABBTreeRaycast, which works with center*2 and extents*2
+				Gu::RayAABBTest test(origin*2.0f, unitDir*2.0f, maxDist, inflation*2.0f);
+
+				const Vec4V originX = V4Load(origin.x);
+				const Vec4V originY = V4Load(origin.y);
+				const Vec4V originZ = V4Load(origin.z);
+				const Vec4V invDirX = V4Load(getSafeInverse(unitDir.x));
+				const Vec4V invDirY = V4Load(getSafeInverse(unitDir.y));
+				const Vec4V invDirZ = V4Load(getSafeInverse(unitDir.z));
+				const Vec4V inflationX = V4Load(inflation.x);
+				const Vec4V inflationY = V4Load(inflation.y);
+				const Vec4V inflationZ = V4Load(inflation.z);
+				const Vec4V zero = V4Zero();
+
+				PxInlineArray<StackEntry, RAW_TRAVERSAL_STACK_SIZE> stack;
+				stack.forceSize_Unsafe(RAW_TRAVERSAL_STACK_SIZE);
+				stack[0].mData = 0;
+				stack[0].mDistance = 0.0f;
+				PxU32 stackIndex = 1;
+
+				while(stackIndex--)
+				{
+					const StackEntry entry = stack[stackIndex];
+					if(entry.mDistance > maxDist)
+						continue;
+
+					if(entry.mData & 1)
+					{
+						if(!doLeafTest<tInflate, true, BVHNode>(binaryNodes + (entry.mData>>1), test, bounds, tree.getIndices(), maxDist, pcb))
+							return false;
+						continue;
+					}
+
+					const WideBVHNode& node = nodes[entry.mData>>1];
+
+					WideNodeBounds nb;
+					dequantizer.dequantize(nb, node);
+					const BoolV validV = getValidChildren(nb);
+					if(tInflate)
+					{
+						nb.mMinX = V4Sub(nb.mMinX, inflationX);	nb.mMaxX = V4Add(nb.mMaxX, inflationX);
+						nb.mMinY = V4Sub(nb.mMinY, inflationY);	nb.mMaxY = V4Add(nb.mMaxY, inflationY);
+						nb.mMinZ = V4Sub(nb.mMinZ, inflationZ);	nb.mMaxZ = V4Add(nb.mMaxZ, inflationZ);
+					}
+
+					const Vec4V t0X = V4Mul(V4Sub(nb.mMinX, originX), invDirX);
+					const Vec4V t1X = V4Mul(V4Sub(nb.mMaxX, originX), invDirX);
+					const Vec4V t0Y = V4Mul(V4Sub(nb.mMinY, originY), invDirY);
+					const Vec4V t1Y = V4Mul(V4Sub(nb.mMaxY, originY), invDirY);
+					const Vec4V t0Z = V4Mul(V4Sub(nb.mMinZ, originZ), invDirZ);
+					const Vec4V t1Z = V4Mul(V4Sub(nb.mMaxZ, originZ), invDirZ);
+
+					const Vec4V tNear = V4Max(V4Max(V4Min(t0X, t1X), V4Min(t0Y, t1Y)), V4Max(V4Min(t0Z, t1Z), zero));
+					const Vec4V tFar = V4Min(V4Min(V4Max(t0X, t1X), V4Max(t0Y, t1Y)), V4Min(V4Max(t0Z, t1Z), V4Load(maxDist)));
+
+					PxU32 mask = BGetBitMask(BAnd(V4IsGrtrOrEq(tFar, tNear), validV));
+					if(!mask)
+						continue;
+
+					PX_ALIGN(16, PxVec4) distances;
+					V4StoreA(tNear, &distances.x);
+
+					// Sort the hit children by decreasing entry distance and push them in that order, so that the closest one is popped first
+					PxU32 hits[GU_WIDE_TREE_WIDTH];
+					PxU32 nbHits = 0;
+					while(mask)
+					{
+						const PxU32 i = PxLowestSetBit(mask);
+						mask &= mask - 1;
+
+						PxU32 j = nbHits++;
+						while(j && distances[hits[j-1]] < distances[i])
+						{
+							hits[j] = hits[j-1];
+							j--;
+						}
+						hits[j] = i;
+					}
+
+					if(stackIndex + GU_WIDE_TREE_WIDTH >= stack.capacity())
+						stack.resizeUninitialized(stack.capacity() * 2);
+
+					for(PxU32 j=0;j<nbHits;j++)
+					{
+						const PxU32 i = hits[j];
+						stack[stackIndex].mData = node.mData[i];
+						stack[stackIndex].mDistance = distances[i];
+						stackIndex++;
+					}
+				}
+				return true;
+			}
+		};
+	}
+}
+
+#endif   // GU_WIDE_AABBTREE_QUERY_H
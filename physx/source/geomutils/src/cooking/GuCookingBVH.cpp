@@ -52,6 +52,8 @@ static bool buildBVH(const PxBVHDesc& desc, BVHData& data, const char* errorMess
 		bs = BVH_SPLATTER_POINTS;
 	else if(desc.buildStrategy==PxBVHBuildStrategy::eDEFAULT)
 		bs = BVH_SPLATTER_POINTS_SPLIT_GEOM_CENTER;
+	else if(desc.buildStrategy==PxBVHBuildStrategy::eBINNED_SAH)
+		bs = BVH_BINNED_SAH;
 	else //if(desc.buildStrategy==PxBVHBuildStrategy::eSAH)
 		bs = BVH_SAH;
 
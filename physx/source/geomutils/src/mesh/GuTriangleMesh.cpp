@@ -31,12 +31,20 @@
 #include "GuConvexEdgeFlags.h"
 #include "GuEdgeList.h"
 #include "geometry/PxGeometryInternal.h"
+#include "foundation/PxAtomic.h"
 
 using namespace physx;
 using namespace Gu;
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+static volatile PxI32 gModificationStamp = 0;
+
+PxU32 TriangleMesh::getNewModificationStamp()
+{
+	return PxU32(PxAtomicIncrement(&gModificationStamp));
+}
+
 static PxConcreteType::Enum gTable[] = {	PxConcreteType::eTRIANGLE_MESH_BVH33,
 											PxConcreteType::eTRIANGLE_MESH_BVH34
 										};
@@ -67,7 +75,8 @@ TriangleMesh::TriangleMesh(MeshFactory* factory, TriangleMeshData& d) :
 	mSdfData					(d.mSdfData),
 	mAccumulatedTrianglesRef	(d.mAccumulatedTrianglesRef),
     mTrianglesReferences		(d.mTrianglesReferences),
-    mNbTrianglesReferences		(d.mNbTrianglesReferences)
+    mNbTrianglesReferences		(d.mNbTrianglesReferences),
+	mModificationStamp			(getNewModificationStamp())
 {
 	// this constructor takes ownership of memory from the data object
 	d.mVertices = NULL;
@@ -117,7 +126,8 @@ TriangleMesh::TriangleMesh(const PxTriangleMeshInternalData& data) :
 	mGRB_BV32Tree			(NULL),
 	mAccumulatedTrianglesRef(NULL),
 	mTrianglesReferences	(NULL),
-	mNbTrianglesReferences	(0)
+	mNbTrianglesReferences	(0),
+	mModificationStamp		(getNewModificationStamp())
 {
 	mAABB.mCenter = data.mAABB_Center;
 	mAABB.mExtents = data.mAABB_Extents;
@@ -217,6 +227,9 @@ void TriangleMesh::exportExtraData(PxSerializationContext& stream)
 
 void TriangleMesh::importExtraData(PxDeserializationContext& context)
 {
+	// The serialized stamp may be shared with other meshes deserialized from the same data
+	mModificationStamp = getNewModificationStamp();
+
 	// PT: vertices are followed by indices, so it will be safe to V4Load vertices from a deserialized binary file
 	if(mVertices)
 		mVertices = context.readExtraData<PxVec3, PX_SERIAL_ALIGN>(mNbVertices);
@@ -185,6 +185,12 @@ public:
 	PX_FORCE_INLINE				const PxU32*			getTriangleReferences()		const	{ return mTrianglesReferences;		}
 	PX_FORCE_INLINE				PxU32					getNbTriangleReferences()	const	{ return mNbTrianglesReferences;	}
 
+								// Identifies the mesh and its current vertices, for data cached per contact pair. The stamp is unique across
+								// all meshes and is replaced each time the vertices may have been modified in place.
+	PX_FORCE_INLINE				PxU32					getModificationStamp()		const	{ return mModificationStamp;		}
+	PX_FORCE_INLINE				void					invalidateModificationStamp()		{ mModificationStamp = getNewModificationStamp();	}
+	static						PxU32					getNewModificationStamp();
+
 	PX_FORCE_INLINE			const CenterExtentsPadded&	getPaddedBounds()			const
 														{
 															// PT: see compile-time assert in cpp
@@ -262,6 +268,8 @@ public:
 								PxU32*					mTrianglesReferences;
 								PxU32					mNbTrianglesReferences;
 								//End of vertex mapping data
+
+								PxU32					mModificationStamp;
 };
 
 #if PX_VC
@@ -133,11 +133,14 @@ void BV4TriangleMesh::importExtraData(PxDeserializationContext& context)
 
 PxVec3 * BV4TriangleMesh::getVerticesForModification()
 {
+	invalidateModificationStamp();
 	return const_cast<PxVec3*>(getVertices());
 }
 
 PxBounds3 BV4TriangleMesh::refitBVH()
 {
+	invalidateModificationStamp();
+
 	PxBounds3 newBounds;
 
 	const float gBoxEpsilon = 2e-4f;
@@ -65,6 +65,7 @@ void Gu::RTreeTriangleMesh::importExtraData(PxDeserializationContext& context)
 
 PxVec3 * Gu::RTreeTriangleMesh::getVerticesForModification()
 {
+	invalidateModificationStamp();
 	return const_cast<PxVec3*>(getVertices());
 }
 
@@ -112,6 +113,8 @@ struct RefitCallback : Gu::RTree::CallbackRefit
 
 PxBounds3 Gu::RTreeTriangleMesh::refitBVH()
 {
+	invalidateModificationStamp();
+
 	PxBounds3 meshBounds;
 	if (has16BitIndices())
 	{
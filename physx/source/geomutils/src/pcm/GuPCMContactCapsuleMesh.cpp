@@ -142,14 +142,14 @@ bool physx::Gu::pcmContactCapsuleMesh(GU_CONTACT_METHOD_ARGS)
 			renderOutput);
 
 		//bound the capsule in shape space by an OBB:
-		Box queryBox;
+		BoxPadded queryBox;
 		queryBox.create(queryCapsule);
 
 		//apply the skew transform to the box:
 		if(!idtMeshScale)
 			meshScaling.transformQueryBounds(queryBox.center, queryBox.extents, queryBox.rot);
 
-		Midphase::intersectOBB(meshData, queryBox, callback, true);
+		intersectOBBCached(meshData, queryBox, callback, multiManifold);
 
 		callback.flushCache();
 	
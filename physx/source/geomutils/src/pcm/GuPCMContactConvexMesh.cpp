@@ -143,7 +143,7 @@ bool Gu::PCMContactConvexMesh(const PolygonalData& polyData, SupportLocal* polyM
 			polyData, polyMap, &delayedContacts, convexScaling, idtConvexScale, meshScaling, extraData, idtMeshScale, true,
 			hullOBB, renderOutput);
 
-		Midphase::intersectOBB(meshData, hullOBB, blockCallback, true);
+		intersectOBBCached(meshData, hullOBB, blockCallback, multiManifold);
 
 		PX_ASSERT(multiManifold.mNumManifolds <= GU_MAX_MANIFOLD_SIZE);
 
@@ -34,6 +34,9 @@
 #include "GuHeightFieldUtil.h"
 #include "GuTriangleCache.h"
 #include "GuConvexEdgeFlags.h"
+#include "GuBox.h"
+#include "GuIntersectionTriangleBox.h"
+#include "GuPersistentContactManifold.h"
 
 namespace physx
 {
@@ -114,6 +117,100 @@ protected:
 	PCMMeshContactGenerationCallback& operator=(const PCMMeshContactGenerationCallback&);
 };
 
+// Records the indices of the triangles touched by the inflated query volume, and forwards the ones touching the actual query box
+// to the contact generation callback. This makes the contact generation independent of the inflation.
+struct PCMCachedTrianglesRecorder : MeshHitCallback<PxGeomRaycastHit>
+{
+	MeshHitCallback<PxGeomRaycastHit>&	mCallback;
+	const BoxPadded&					mQueryBox;
+	PxU32*								mTriangles;
+	PxU32								mNbTriangles;
+
+	PCMCachedTrianglesRecorder(MeshHitCallback<PxGeomRaycastHit>& callback, const BoxPadded& queryBox, PxU32* triangles) :
+		MeshHitCallback<PxGeomRaycastHit>(CallbackMode::eMULTIPLE), mCallback(callback), mQueryBox(queryBox), mTriangles(triangles), mNbTriangles(0)
+	{
+	}
+
+	virtual PxAgain processHit(
+		const PxGeomRaycastHit& hit, const PxVec3& v0, const PxVec3& v1, const PxVec3& v2, PxReal& shrunkMaxT, const PxU32* vinds)
+	{
+		if(mNbTriangles < GU_PCM_MAX_CACHED_TRIANGLES)
+			mTriangles[mNbTriangles] = hit.faceIndex;
+		mNbTriangles++;
+
+		if(intersectTriangleBox(mQueryBox, v0, v1, v2))
+			mCallback.processHit(hit, v0, v1, v2, shrunkMaxT, vinds);
+		return true;
+	}
+
+private:
+	PCMCachedTrianglesRecorder& operator=(const PCMCachedTrianglesRecorder&);
+};
+
+// Equivalent to Midphase::intersectOBB(meshData, queryBox, callback, true), using the triangle set cached in the multi-manifold
+// while the query box stays inside the cached volume. The cached set is rebuilt with an inflated volume when the box leaves it.
+// The query box is in mesh vertex space, so the cache remains valid when the mesh actor moves. The mesh's modification stamp is unique per
+// mesh and replaced when the vertices are modified, so the cache is also invalidated when a cache kept by the user is used with another mesh.
+PX_FORCE_INLINE void intersectOBBCached(const TriangleMesh* meshData, const BoxPadded& queryBox, MeshHitCallback<PxGeomRaycastHit>& callback,
+	MultiplePersistentContactManifold& multiManifold)
+{
+	const PxBounds3 queryBounds = PxBounds3::basisExtent(queryBox.center, queryBox.rot, queryBox.extents);
+	const PxU32 meshStamp = meshData->getModificationStamp();
+
+	if(multiManifold.hasCachedTriangles(queryBounds, meshStamp))
+	{
+		if(multiManifold.mNumCachedTriangles == GU_PCM_CACHED_TRIANGLES_OVERFLOW)
+		{
+			// Too many triangles in the cached volume, we only avoid rebuilding the cache until the query box leaves it
+			Midphase::intersectOBB(meshData, queryBox, callback, true);
+			return;
+		}
+
+		const PxVec3* PX_RESTRICT vertices = meshData->getVerticesFast();
+		const void* PX_RESTRICT indices = meshData->getTriangles();
+		const bool has16BitIndices = meshData->has16BitIndices();
+
+		PxGeomRaycastHit hit;
+		PxReal shrunkMaxT = PX_MAX_F32;
+		const PxU32 nbTriangles = multiManifold.mNumCachedTriangles;
+		for(PxU32 i=0; i<nbTriangles; i++)
+		{
+			const PxU32 triangleIndex = multiManifold.mCachedTriangles[i];
+			PX_ASSERT(triangleIndex < meshData->getNbTrianglesFast());
+			PxU32 vinds[3];
+			getVertexRefs(triangleIndex, vinds[0], vinds[1], vinds[2], indices, has16BitIndices);
+			const PxVec3& v0 = vertices[vinds[0]];
+			const PxVec3& v1 = vertices[vinds[1]];
+			const PxVec3& v2 = vertices[vinds[2]];
+			if(intersectTriangleBox(queryBox, v0, v1, v2))
+			{
+				hit.faceIndex = triangleIndex;
+				callback.processHit(hit, v0, v1, v2, shrunkMaxT, vinds);
+			}
+		}
+		return;
+	}
+
+	// Inflate the query volume by half its largest extent, so that small motions of the pair keep hitting the cache
+	const PxVec3 extents = queryBounds.getExtents();
+	const PxVec3 inflatedExtents = extents + PxVec3(extents.maxElement() * 0.5f);
+
+	Box inflatedBox;
+	inflatedBox.center = queryBounds.getCenter();
+	inflatedBox.extents = inflatedExtents;
+	inflatedBox.rot = PxMat33(PxIdentity);
+
+	PCMCachedTrianglesRecorder recorder(callback, queryBox, multiManifold.mCachedTriangles);
+	Midphase::intersectOBB(meshData, inflatedBox, recorder, true);
+
+	multiManifold.mCachedTrianglesBounds = PxBounds3(inflatedBox.center - inflatedExtents, inflatedBox.center + inflatedExtents);
+	multiManifold.mCachedTrianglesStamp = meshStamp;
+	if(recorder.mNbTriangles > GU_PCM_MAX_CACHED_TRIANGLES)
+		multiManifold.mNumCachedTriangles = GU_PCM_CACHED_TRIANGLES_OVERFLOW;
+	else
+		multiManifold.mNumCachedTriangles = recorder.mNbTriangles;
+}
+
 template <typename Derived>
 struct PCMHeightfieldContactGenerationCallback : Gu::OverlapReport
 {
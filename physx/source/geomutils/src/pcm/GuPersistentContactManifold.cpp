@@ -2446,10 +2446,22 @@ void physx::Gu::MultiplePersistentContactManifold::fromBuffer(PxU8* PX_RESTRICT
 			}
 			buff += sizeof(Gu::CachedMeshPersistentContact) * numContacts;
 		}
+
+		mNumCachedTriangles = header->mNumCachedTriangles;
+		if(mNumCachedTriangles)
+		{
+			const CachedTriangleSetHeader* PX_RESTRICT triHeader = reinterpret_cast<const CachedTriangleSetHeader*>(buff);
+			buff += sizeof(CachedTriangleSetHeader);
+			mCachedTrianglesBounds = PxBounds3(triHeader->mMin, triHeader->mMax);
+			mCachedTrianglesStamp = triHeader->mMeshStamp;
+			PX_ASSERT(getNbCachedTriangles() <= GU_PCM_MAX_CACHED_TRIANGLES);
+			PxMemCopy(mCachedTriangles, buff, getNbCachedTriangles() * sizeof(PxU32));
+		}
 	}
 	else
 	{
 		mRelativeTransform.Invalidate();
+		mNumCachedTriangles = 0;
 	}
 	mNumManifolds = PxU8(numManifolds);
 	for (PxU32 a = numManifolds; a < GU_MAX_MANIFOLD_SIZE; ++a)
@@ -33,6 +33,7 @@
 #include "foundation/PxUnionCast.h"
 #include "foundation/PxMemory.h"
 #include "foundation/PxVecTransform.h"
+#include "foundation/PxBounds3.h"
 
 #define PCM_LOW_LEVEL_DEBUG 0
 
@@ -52,6 +53,11 @@ namespace physx
 
 #define GU_MANIFOLD_INVALID_INDEX	0xffffffff
 
+//Maximum number of mesh triangles remembered by a mesh multi-manifold between frames, see MultiplePersistentContactManifold::mCachedTriangles
+#define GU_PCM_MAX_CACHED_TRIANGLES			32
+//Marks a cached query volume that touched more than GU_PCM_MAX_CACHED_TRIANGLES triangles
+#define GU_PCM_CACHED_TRIANGLES_OVERFLOW	0xffffffff
+
 
 //ML: this is used to compared with the shape's margin to decide the final tolerance used in the manifold to validate the existing contacts.
 //In the case of big shape and relatively speaking small triangles in the mesh, we need to take a smaller margin. This helps because the PCM 
@@ -513,7 +519,17 @@ struct MultiPersistentManifoldHeader
 {
 	aos::PxTransformV mRelativeTransform;//aToB
 	PxU32 mNumManifolds;
-	PxU32 pad[3];
+	PxU32 mNumCachedTriangles;
+	PxU32 pad[2];
+};
+
+//This is a structure used to cache the query volume of the cached triangle set in the cache stream. The triangle indices follow it.
+struct CachedTriangleSetHeader
+{
+	PxVec3 mMin;
+	PxU32 mMeshStamp;
+	PxVec3 mMax;
+	PxU32 pad1;
 };
 
 struct SingleManifoldHeader
@@ -531,7 +547,7 @@ PX_ALIGN_PREFIX(16)
 class PX_PHYSX_COMMON_API MultiplePersistentContactManifold
 {
 public:
-	MultiplePersistentContactManifold():mNumManifolds(0), mNumTotalContacts(0)
+	MultiplePersistentContactManifold():mNumManifolds(0), mNumTotalContacts(0), mNumCachedTriangles(0)
 	{
 		mRelativeTransform.Invalidate();
 	}
@@ -697,6 +713,7 @@ public:
 	{
 		mNumManifolds = 0;
 		mNumTotalContacts = 0;
+		mNumCachedTriangles = 0;
 		mRelativeTransform.Invalidate();
 		for(PxU8 i=0; i<GU_MAX_MANIFOLD_SIZE; ++i)
 		{
@@ -713,9 +730,35 @@ public:
 		}
 		mNumManifolds = 0;
 		mNumTotalContacts = 0;
+		mNumCachedTriangles = 0;
 		mRelativeTransform.Invalidate();
 	}
 
+	/*
+		This function returns true if the cached triangle set can be reused for a midphase query whose bounds (in mesh vertex space) are queryBounds,
+		against a mesh whose modification stamp is meshStamp
+	*/
+	PX_FORCE_INLINE bool hasCachedTriangles(const PxBounds3& queryBounds, PxU32 meshStamp)	const
+	{
+		return mNumCachedTriangles && mCachedTrianglesStamp == meshStamp && queryBounds.isInside(mCachedTrianglesBounds);
+	}
+
+	PX_FORCE_INLINE PxU32 getNbCachedTriangles()	const
+	{
+		return mNumCachedTriangles == GU_PCM_CACHED_TRIANGLES_OVERFLOW ? 0 : mNumCachedTriangles;
+	}
+
+	/*
+		This function returns the size of the compressed manifold written by toBuffer()
+	*/
+	PX_FORCE_INLINE PxU32 getBufferSize()	const
+	{
+		PxU32 size = sizeof(MultiPersistentManifoldHeader) + mNumManifolds * sizeof(SingleManifoldHeader) + mNumTotalContacts * sizeof(CachedMeshPersistentContact);
+		if(mNumCachedTriangles)
+			size += sizeof(CachedTriangleSetHeader) + ((getNbCachedTriangles() + 3) & ~3) * sizeof(PxU32);
+		return size;
+	}
+
 	PX_FORCE_INLINE SinglePersistentContactManifold* getManifold(const PxU32 index)
 	{
 		PX_ASSERT(index < GU_MAX_MANIFOLD_SIZE);
@@ -753,6 +796,16 @@ public:
 	PxU8 mNumManifolds;
 	PxU8 mNumTotalContacts;
 	SinglePersistentContactManifold mManifolds[GU_MAX_MANIFOLD_SIZE];
+
+	//Mesh triangles touching mCachedTrianglesBounds, an inflated query volume in mesh vertex space. While the midphase query
+	//volume of the pair stays inside these bounds, the triangles are reused instead of running the midphase again.
+	//GU_PCM_CACHED_TRIANGLES_OVERFLOW means that the volume touched too many triangles to be cached.
+	//The set is discarded when mCachedTrianglesStamp differs from the mesh's modification stamp, i.e. after the vertices were modified and refit,
+	//or when the cache is used with another mesh.
+	PxBounds3 mCachedTrianglesBounds;
+	PxU32 mCachedTrianglesStamp;
+	PxU32 mNumCachedTriangles;
+	PxU32 mCachedTriangles[GU_PCM_MAX_CACHED_TRIANGLES];
 	
 	
 } PX_ALIGN_SUFFIX(16);
@@ -868,6 +921,17 @@ PX_INLINE void MultiplePersistentContactManifold::toBuffer(PxU8*  PX_RESTRICT bu
 		}
 		buff += sizeof(CachedMeshPersistentContact) * manifold.mNumContacts;
 	}
+
+	header->mNumCachedTriangles = mNumCachedTriangles;
+	if(mNumCachedTriangles)
+	{
+		CachedTriangleSetHeader* PX_RESTRICT triHeader = reinterpret_cast<CachedTriangleSetHeader*>(buff);
+		buff += sizeof(CachedTriangleSetHeader);
+		triHeader->mMin = mCachedTrianglesBounds.minimum;
+		triHeader->mMeshStamp = mCachedTrianglesStamp;
+		triHeader->mMax = mCachedTrianglesBounds.maximum;
+		PxMemCopy(buff, mCachedTriangles, getNbCachedTriangles() * sizeof(PxU32));
+	}
 }
 
 #define PX_CP_TO_PCP(contactPoint)				(reinterpret_cast<PersistentContact*>(contactPoint)) //this is used in the normal pcm contact gen
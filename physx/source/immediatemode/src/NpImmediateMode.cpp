@@ -44,6 +44,7 @@
 #include "../../lowleveldynamics/include/DyFeatherstoneArticulation.h"
 
 #include "../../lowlevel/common/include/utils/PxcScratchAllocator.h"
+#include "GuParallelJobs.h"
 
 using namespace physx;
 using namespace Dy;
@@ -1100,9 +1101,7 @@ bool immediate::PxGenerateContacts(const PxGeometry* const * geom0, const PxGeom
 			//Do collision detection, then write manifold out...
 			g_PCMContactMethodTable[type0][type1](*tempGeom0, *tempGeom1, transform0, transform1, params, cache, contactBuffer, NULL);
 
-			const PxU32 size = (sizeof(Gu::MultiPersistentManifoldHeader) +
-				multiManifold.mNumManifolds * sizeof(Gu::SingleManifoldHeader) +
-				multiManifold.mNumTotalContacts * sizeof(Gu::CachedMeshPersistentContact));
+			const PxU32 size = multiManifold.getBufferSize();
 
 			PxU8* buffer = allocator.allocateCacheData(size);
 
@@ -1544,6 +1543,198 @@ void immediate::PxUpdateArticulationBodiesTGS(PxArticulationHandle articulation,
 	FeatherstoneArticulation::updateBodies(immArt, immArt->mTempDeltaV.begin(), dt, false);
 }
 
+// number of articulations processed by each job of the batched functions. Small enough to balance the load over the
+// workers, large enough to amortize the job overhead.
+#define IMM_ARTICULATIONS_PER_JOB	8
+
+namespace
+{
+	struct ArticulationBatch
+	{
+		enum Operation
+		{
+			eCOMPUTE_UNCONSTRAINED_VELOCITIES,
+			eCOMPUTE_UNCONSTRAINED_VELOCITIES_TGS,
+			eUPDATE_BODIES,
+			eUPDATE_BODIES_TGS,
+			eCOPY_TO_CACHE,
+			eAPPLY_CACHE
+		};
+
+		ArticulationBatch(Operation op, const PxArticulationHandle* articulations, PxArticulationCache*const* caches, PxU32 nbArticulations) :
+			mOperation		(op),
+			mArticulations	(articulations),
+			mCaches			(caches),
+			mNbArticulations(nbArticulations),
+			mGravity		(PxVec3(0.0f)),
+			mDt				(0.0f),
+			mTotalDt		(0.0f),
+			mInvDt			(0.0f),
+			mInvTotalDt		(0.0f),
+			mInvLengthScale	(1.0f)
+		{
+		}
+
+		const Operation						mOperation;
+		const PxArticulationHandle*			mArticulations;
+		PxArticulationCache*const*			mCaches;
+		const PxU32							mNbArticulations;
+		PxVec3								mGravity;
+		PxReal								mDt;
+		PxReal								mTotalDt;
+		PxReal								mInvDt;
+		PxReal								mInvTotalDt;
+		PxReal								mInvLengthScale;
+		PxArticulationCacheFlags			mFlags;
+
+		PX_NOCOPY(ArticulationBatch)
+	};
+}
+
+static PX_FORCE_INLINE void prepareArticulation(immArticulation* immArt)
+{
+	immArt->complete();
+	if(immArt->mJCalcDirty)
+	{
+		immArt->mJCalcDirty = false;
+		immArt->jcalc(immArt->mArticulationData);
+	}
+}
+
+static void processArticulationBatch(void* userData, PxU32 jobIndex)
+{
+	const ArticulationBatch& batch = *reinterpret_cast<const ArticulationBatch*>(userData);
+
+	const PxU32 start = jobIndex * IMM_ARTICULATIONS_PER_JOB;
+	const PxU32 end = PxMin(start + IMM_ARTICULATIONS_PER_JOB, batch.mNbArticulations);
+
+	for(PxU32 i=start;i<end;i++)
+	{
+		immArticulation* immArt = static_cast<immArticulation*>(batch.mArticulations[i]);
+		if(!immArt)
+			continue;
+
+		// the articulations are unrelated objects scattered in memory, start fetching the next one early
+		if(i+1<end)
+			PxPrefetchLine(batch.mArticulations[i+1]);
+
+		switch(batch.mOperation)
+		{
+			case ArticulationBatch::eCOMPUTE_UNCONSTRAINED_VELOCITIES:
+			{
+				prepareArticulation(immArt);
+				immArt->immComputeUnconstrainedVelocities(batch.mDt, batch.mGravity, batch.mInvLengthScale);
+			}
+			break;
+			case ArticulationBatch::eCOMPUTE_UNCONSTRAINED_VELOCITIES_TGS:
+			{
+				prepareArticulation(immArt);
+				immArt->immComputeUnconstrainedVelocitiesTGS(batch.mDt, batch.mTotalDt, batch.mInvDt, batch.mInvTotalDt, batch.mGravity, batch.mInvLengthScale);
+			}
+			break;
+			case ArticulationBatch::eUPDATE_BODIES:
+			{
+				FeatherstoneArticulation::updateBodies(immArt, immArt->mTempDeltaV.begin(), batch.mDt, true);
+			}
+			break;
+			case ArticulationBatch::eUPDATE_BODIES_TGS:
+			{
+				FeatherstoneArticulation::updateBodies(immArt, immArt->mTempDeltaV.begin(), batch.mDt, false);
+			}
+			break;
+			case ArticulationBatch::eCOPY_TO_CACHE:
+			{
+				immArt->copyInternalStateToCache(*batch.mCaches[i], batch.mFlags);
+			}
+			break;
+			case ArticulationBatch::eAPPLY_CACHE:
+			{
+				bool shouldWake = false;
+				immArt->applyCache(*batch.mCaches[i], batch.mFlags, shouldWake);
+			}
+			break;
+		}
+	}
+}
+
+static void runArticulationBatch(const ArticulationBatch& batch, PxCpuDispatcher* dispatcher)
+{
+	const PxU32 nbJobs = (batch.mNbArticulations + IMM_ARTICULATIONS_PER_JOB - 1) / IMM_ARTICULATIONS_PER_JOB;
+	Gu::runJobs(dispatcher, processArticulationBatch, const_cast<ArticulationBatch*>(&batch), nbJobs);
+}
+
+void immediate::PxComputeUnconstrainedVelocitiesBatch(	const PxArticulationHandle* articulations, const PxU32 nbArticulations, const PxVec3& gravity,
+														const PxReal dt, const PxReal invLengthScale, PxCpuDispatcher* dispatcher)
+{
+	if(!articulations || !nbArticulations)
+		return;
+
+	ArticulationBatch batch(ArticulationBatch::eCOMPUTE_UNCONSTRAINED_VELOCITIES, articulations, NULL, nbArticulations);
+	batch.mGravity = gravity;
+	batch.mDt = dt;
+	batch.mInvLengthScale = invLengthScale;
+	runArticulationBatch(batch, dispatcher);
+}
+
+void immediate::PxUpdateArticulationBodiesBatch(const PxArticulationHandle* articulations, const PxU32 nbArticulations, const PxReal dt, PxCpuDispatcher* dispatcher)
+{
+	if(!articulations || !nbArticulations)
+		return;
+
+	ArticulationBatch batch(ArticulationBatch::eUPDATE_BODIES, articulations, NULL, nbArticulations);
+	batch.mDt = dt;
+	runArticulationBatch(batch, dispatcher);
+}
+
+void immediate::PxComputeUnconstrainedVelocitiesBatchTGS(	const PxArticulationHandle* articulations, const PxU32 nbArticulations, const PxVec3& gravity,
+															const PxReal dt, const PxReal totalDt, const PxReal invDt, const PxReal invTotalDt,
+															const PxReal invLengthScale, PxCpuDispatcher* dispatcher)
+{
+	if(!articulations || !nbArticulations)
+		return;
+
+	ArticulationBatch batch(ArticulationBatch::eCOMPUTE_UNCONSTRAINED_VELOCITIES_TGS, articulations, NULL, nbArticulations);
+	batch.mGravity = gravity;
+	batch.mDt = dt;
+	batch.mTotalDt = totalDt;
+	batch.mInvDt = invDt;
+	batch.mInvTotalDt = invTotalDt;
+	batch.mInvLengthScale = invLengthScale;
+	runArticulationBatch(batch, dispatcher);
+}
+
+void immediate::PxUpdateArticulationBodiesBatchTGS(const PxArticulationHandle* articulations, const PxU32 nbArticulations, const PxReal dt, PxCpuDispatcher* dispatcher)
+{
+	if(!articulations || !nbArticulations)
+		return;
+
+	ArticulationBatch batch(ArticulationBatch::eUPDATE_BODIES_TGS, articulations, NULL, nbArticulations);
+	batch.mDt = dt;
+	runArticulationBatch(batch, dispatcher);
+}
+
+void immediate::PxCopyInternalStateToArticulationCacheBatch(const PxArticulationHandle* articulations, PxArticulationCache*const* caches, const PxU32 nbArticulations,
+															PxArticulationCacheFlags flag, PxCpuDispatcher* dispatcher)
+{
+	if(!articulations || !caches || !nbArticulations)
+		return;
+
+	ArticulationBatch batch(ArticulationBatch::eCOPY_TO_CACHE, articulations, caches, nbArticulations);
+	batch.mFlags = flag;
+	runArticulationBatch(batch, dispatcher);
+}
+
+void immediate::PxApplyArticulationCacheBatch(	const PxArticulationHandle* articulations, PxArticulationCache*const* caches, const PxU32 nbArticulations,
+												PxArticulationCacheFlags flag, PxCpuDispatcher* dispatcher)
+{
+	if(!articulations || !caches || !nbArticulations)
+		return;
+
+	ArticulationBatch batch(ArticulationBatch::eAPPLY_CACHE, articulations, caches, nbArticulations);
+	batch.mFlags = flag;
+	runArticulationBatch(batch, dispatcher);
+}
+
 static void copyLinkData(PxArticulationLinkDerivedDataRC& data, const immArticulation* immArt, PxU32 index)
 {
 	data.pose				= immArt->mBodyCores[index].body2World;
@@ -104,6 +104,9 @@ struct PxvSimStats
 	PxU32	mNbLostTouches;
 
 	PxU32	mNbPartitions;
+
+	PxU32	mNbDeferredIslandWakes;
+	PxU32	mNbDeferredNodeWakes;
 };
 
 }
@@ -433,9 +433,7 @@ static PX_FORCE_INLINE void discreteNarrowPhase(PxcNpThreadContext& context, con
 		if(isMultiManifold)
 		{
 			//Store the manifold back...
-			const PxU32 size = (sizeof(MultiPersistentManifoldHeader) +
-				manifold.mNumManifolds * sizeof(SingleManifoldHeader) +
-				manifold.mNumTotalContacts * sizeof(Gu::CachedMeshPersistentContact));
+			const PxU32 size = manifold.getBufferSize();
 
 			PxU8* buffer = context.mNpCacheStreamPair.reserve(size);
 
@@ -467,6 +467,17 @@ class IslandSim
 
 	PxArray<EdgeIndex> mDeactivatingEdges[Edge::eEDGE_TYPE_COUNT];
 
+	//Islands that a waking kinematic could not wake up this frame because of the activation budget. One node is recorded
+	//per island, the island is looked up again when the wake is retried because islands may be merged or split meanwhile.
+	PxArray<PxNodeIndex> mDeferredIslandWakes;
+	PxArray<PxNodeIndex> mRetriedIslandWakes;
+	PxBitMap mIslandWakeDeferred;						//! Indicates whether an island's wake has been deferred this frame
+	PxU32 mMaxNbKinematicWakeNodes;						//! Max number of nodes woken per frame by waking kinematics
+	PxU32 mKinematicWakeBudget;							//! Number of nodes that waking kinematics may still wake this frame
+	const IslandSim* mKinematicWakeReference;			//! If set, island wakes are deferred whenever that island sim deferred them
+	PxU32 mNbDeferredIslandWakes;
+	PxU32 mNbDeferredNodeWakes;
+
 	PxArray<PartitionEdge*>* mFirstPartitionEdges;
 	Cm::BlockArray<PxNodeIndex>& mEdgeNodeIndices;
 	PxArray<physx::PartitionEdge*>* mDestroyedPartitionEdges;
@@ -639,6 +650,24 @@ public:
 
 	bool checkInternalConsistency();
 
+	//Bounds the number of nodes that kinematics may activate per frame by waking the islands they touch, either when
+	//the kinematic wakes up or when an active kinematic gets a new connection. Islands that do not fit in the budget
+	//stay asleep and are woken in subsequent frames, oldest first. At least one island is always woken per frame so
+	//that islands larger than the budget are not starved. Islands woken by a dynamic node are never deferred.
+	//PX_MAX_U32 (the default) disables the budget.
+	//If a reference island sim is provided, the budget is not evaluated here: an island is woken if and only if the
+	//reference sim woke the node, so the reference sim (whose islands must contain ours) stays a superset of this one.
+	PX_FORCE_INLINE void setMaxNbKinematicWakeNodesPerFrame(PxU32 maxNbNodes, const IslandSim* referenceSim = NULL)
+	{
+		mMaxNbKinematicWakeNodes = maxNbNodes;
+		mKinematicWakeReference = referenceSim;
+	}
+	PX_FORCE_INLINE PxU32 getMaxNbKinematicWakeNodesPerFrame() const { return mMaxNbKinematicWakeNodes; }
+
+	//Number of islands (and of nodes in these islands) whose wake was deferred to a later frame by the activation budget
+	PX_FORCE_INLINE PxU32 getNbDeferredIslandWakes() const { return mNbDeferredIslandWakes; }
+	PX_FORCE_INLINE PxU32 getNbDeferredNodeWakes() const { return mNbDeferredNodeWakes; }
+
 
 	PX_INLINE void activateNode_ForGPUSolver(PxNodeIndex index)
 	{
@@ -683,6 +712,10 @@ private:
 
 	void activateIsland(IslandId island);
 
+	void wakeIslandWithinBudget(IslandId islandId, PxNodeIndex nodeIndex, PxU32& budget, bool activateNodes);
+
+	void retryDeferredIslandWakes(PxU32& budget);
+
 	void deactivateIsland(IslandId island);
 
 	bool canFindRoot(PxNodeIndex startNode, PxNodeIndex targetNode, PxArray<PxNodeIndex>* visitedNodes);
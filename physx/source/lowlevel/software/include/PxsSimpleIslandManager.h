@@ -180,6 +180,14 @@ public:
 	IslandSim& getAccurateIslandSim() { return mIslandManager; }
 	IslandSim& getSpeculativeIslandSim() { return mSpeculativeIslandManager; }
 
+	//The speculative island sim applies the budget, and the accurate one follows its decisions so that the speculative sim
+	//always wakes a superset of the accurate sim's nodes.
+	void setMaxNbKinematicWakeNodesPerFrame(PxU32 maxNbNodes)
+	{
+		mSpeculativeIslandManager.setMaxNbKinematicWakeNodesPerFrame(maxNbNodes);
+		mIslandManager.setMaxNbKinematicWakeNodesPerFrame(maxNbNodes, &mSpeculativeIslandManager);
+	}
+
 	PX_FORCE_INLINE PxU32 getNbEdgeHandles() const { return mEdgeHandles.getTotalHandles(); }
 
 	PX_FORCE_INLINE PxU32 getNbNodeHandles() const { return mNodeHandles.getTotalHandles(); }
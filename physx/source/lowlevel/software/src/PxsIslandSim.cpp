@@ -55,6 +55,13 @@ namespace IG
 		mDestroyedEdges("IslandSim::mDestroyedEdges"),
 		mTempIslandIds("IslandSim::mTempIslandIds"),
 		mVisitedNodes("IslandSim::mVisitedNodes"),
+		mDeferredIslandWakes("IslandSim::mDeferredIslandWakes"),
+		mRetriedIslandWakes("IslandSim::mRetriedIslandWakes"),
+		mMaxNbKinematicWakeNodes(PX_MAX_U32),
+		mKinematicWakeBudget(PX_MAX_U32),
+		mKinematicWakeReference(NULL),
+		mNbDeferredIslandWakes(0),
+		mNbDeferredNodeWakes(0),
 		mFirstPartitionEdges(firstPartitionEdges),
 		mEdgeNodeIndices(edgeNodeIndices),
 		mDestroyedPartitionEdges(destroyedPartitionEdges),
@@ -714,6 +721,69 @@ void IslandSim::deactivateIsland(IslandId islandId)
 }
 
 
+void IslandSim::wakeIslandWithinBudget(IslandId islandId, PxNodeIndex nodeIndex, PxU32& budget, bool activateNodes)
+{
+	if(mIslandAwake.test(islandId) || mIslandWakeDeferred.boundedTest(islandId))
+		return;
+
+	const Island& island = mIslands[islandId];
+	PxU32 nbNodes = 0;
+	for(PxU32 a = 0; a < Node::eTYPE_COUNT; ++a)
+		nbNodes += island.mSize[a];
+
+	bool wake;
+	if(mMaxNbKinematicWakeNodes == PX_MAX_U32)
+		wake = true;
+	else if(mKinematicWakeReference)
+		wake = mKinematicWakeReference->getNode(nodeIndex).isActive();
+	else
+		wake = nbNodes <= budget || budget == mMaxNbKinematicWakeNodes;	//The first island of the frame is always woken, otherwise an island larger than the budget would never wake up
+
+	if(wake)
+	{
+		budget -= PxMin(nbNodes, budget);
+		//Islands woken while processing new edges must have their nodes activated immediately, the others are activated at the end of wakeIslands()
+		if(activateNodes)
+			activateIsland(islandId);
+		else
+			markIslandActive(islandId);
+	}
+	else
+	{
+		mIslandWakeDeferred.growAndSet(islandId);
+		mDeferredIslandWakes.pushBack(nodeIndex);
+		mNbDeferredIslandWakes++;
+		mNbDeferredNodeWakes += nbNodes;
+	}
+}
+
+void IslandSim::retryDeferredIslandWakes(PxU32& budget)
+{
+	mNbDeferredIslandWakes = 0;
+	mNbDeferredNodeWakes = 0;
+
+	if(mDeferredIslandWakes.empty())
+		return;
+
+	PX_PROFILE_ZONE("Basic.retryDeferredIslandWakes", getContextId());
+
+	mRetriedIslandWakes.swap(mDeferredIslandWakes);
+	mDeferredIslandWakes.forceSize_Unsafe(0);
+	mIslandWakeDeferred.clear();
+
+	for(PxU32 a = 0; a < mRetriedIslandWakes.size(); ++a)
+	{
+		const PxNodeIndex nodeIndex = mRetriedIslandWakes[a];
+		//The node may have been removed or made kinematic since its island's wake was deferred
+		if(mNodes[nodeIndex.index()].isDeleted())
+			continue;
+		const IslandId islandId = mIslandIds[nodeIndex.index()];
+		if(islandId != IG_INVALID_ISLAND)
+			wakeIslandWithinBudget(islandId, nodeIndex, budget, false);
+	}
+	mRetriedIslandWakes.forceSize_Unsafe(0);
+}
+
 void IslandSim::wakeIslands()
 {
 	PX_PROFILE_ZONE("Basic.wakeIslands", getContextId());
@@ -742,6 +812,9 @@ void IslandSim::wakeIslands()
 		mInitialActiveNodeCount[a] = mActiveNodes[a].size();
 	}
 
+	mKinematicWakeBudget = mMaxNbKinematicWakeNodes;
+	retryDeferredIslandWakes(mKinematicWakeBudget);
+
 	for(PxU32 a = 0; a < mActivatingNodes.size(); ++a)
 	{
 		PxNodeIndex wakeNode = mActivatingNodes[a];
@@ -796,12 +869,8 @@ void IslandSim::wakeIslands()
 				}
 				else
 				{
-					IslandId connectedIslandId = mIslandIds[nodeIndex.index()];
-					if(!mIslandAwake.test(connectedIslandId))
-					{
-						//Wake up that island
-						markIslandActive(connectedIslandId);
-					}
+					//Wake up that island, unless the activation budget is exhausted
+					wakeIslandWithinBudget(mIslandIds[nodeIndex.index()], nodeIndex, mKinematicWakeBudget, false);
 				}
 
 				index = edgeInstance.mNextEdge;
@@ -884,12 +953,8 @@ void IslandSim::wakeIslands2()
 				}
 				else
 				{
-					IslandId connectedIslandId = mIslandIds[nodeIndex.index()];
-					if (!mIslandAwake.test(connectedIslandId))
-					{
-						//Wake up that island
-						markIslandActive(connectedIslandId);
-					}
+					//Wake up that island, unless the activation budget is exhausted
+					wakeIslandWithinBudget(mIslandIds[nodeIndex.index()], nodeIndex, mKinematicWakeBudget, false);
 				}
 
 				index = edgeInstance.mNextEdge;
@@ -1075,6 +1140,7 @@ void IslandSim::processNewEdges()
 
 							if(active1 || active2)
 							{
+								//Not a kinematic wake: node1 is dynamic and now part of island2, so the island cannot be deferred
 								if(!mIslandAwake.test(islandId2))
 								{
 									//This island wasn't already awake, so need to wake the whole island up
@@ -1089,8 +1155,8 @@ void IslandSim::processNewEdges()
 						}
 						else if(active1 && !active2)
 						{
-							//Active kinematic object -> wake island!
-							activateIsland(islandId2);
+							//Active kinematic object -> wake island, unless the activation budget is exhausted
+							wakeIslandWithinBudget(islandId2, nodeIndex2, mKinematicWakeBudget, true);
 						}
 					}
 					else
@@ -1131,6 +1197,7 @@ void IslandSim::processNewEdges()
 
 							if(active1 || active2)
 							{
+								//Not a kinematic wake: node2 is dynamic and now part of island1, so the island cannot be deferred
 								if(!mIslandAwake.test(islandId1))
 								{
 									//This island wasn't already awake, so need to wake the whole island up
@@ -1145,8 +1212,8 @@ void IslandSim::processNewEdges()
 						}
 						else if(active2 && !active1)
 						{
-							//Active kinematic object -> wake island!
-							activateIsland(islandId1);
+							//Active kinematic object -> wake island, unless the activation budget is exhausted
+							wakeIslandWithinBudget(islandId1, nodeIndex1, mKinematicWakeBudget, true);
 						}
 					}
 					else
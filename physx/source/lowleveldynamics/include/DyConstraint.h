@@ -69,6 +69,8 @@ public:
 	PxsBodyCore*			bodyCore1;				//36
 	PxU32					index;					//40 //this is also a constraint write back index
 	PxReal					minResponseThreshold;	//44
+
+	PxConstraintSolverPrepBatch	solverPrepBatch;	//48
 }
 PX_ALIGN_SUFFIX(16);
 #if PX_VC 
@@ -76,7 +78,7 @@ PX_ALIGN_SUFFIX(16);
 #endif
 
 #if !PX_P64_FAMILY
-PX_COMPILE_TIME_ASSERT(48==sizeof(Constraint));
+PX_COMPILE_TIME_ASSERT(64==sizeof(Constraint));
 #endif
 
 }
@@ -30,6 +30,7 @@
 #define DY_CONSTRAINT_PREP_H
 
 #include "DyConstraint.h"
+#include "DyConstraintWriteBack.h"
 
 #include "DySolverConstraintDesc.h"
 #include "foundation/PxArray.h"
@@ -136,6 +137,90 @@ namespace Dy
 			c.maxImpulse = PX_MAX_REAL;
 		}
 	}
+
+	PX_FORCE_INLINE bool isWarmStarted(const SolverConstraintShaderPrepDesc& shaderDesc)
+	{
+		return shaderDesc.constraint && (shaderDesc.constraint->flags & PxConstraintFlag::eWARM_START);
+	}
+
+	// Computes the warm-start impulse of a row from the impulse its constraint applied in the previous step. linImpulse and
+	// angImpulse hold what is left of that impulse (angular part about the joint point, as in ConstraintWriteback). lin and ang
+	// are the row's linear and unscaled angular axes for body 0, ang being taken about the joint point as well. The impulse is
+	// projected onto the row and removed from what is left, so that rows sharing a direction do not pick it up twice.
+	PX_FORCE_INLINE PxReal computeWarmStartImpulse(PxVec3& linImpulse, PxVec3& angImpulse, const PxVec3& lin, const PxVec3& ang, PxReal minImpulse, PxReal maxImpulse)
+	{
+		const PxReal denom = lin.magnitudeSquared() + ang.magnitudeSquared();
+		if(denom == 0.0f)
+			return 0.0f;
+
+		const PxReal impulse = PxClamp((lin.dot(linImpulse) + ang.dot(angImpulse))/denom, minImpulse, maxImpulse);
+		linImpulse -= lin * impulse;
+		angImpulse -= ang * impulse;
+		return impulse;
+	}
+
+	// Returns the batched shader shared by the 4 constraints of a solver batch, or NULL if they must be prepped one by one.
+	PX_FORCE_INLINE PxConstraintSolverPrepBatch getSolverPrepBatch4(const SolverConstraintShaderPrepDesc* PX_RESTRICT shaderDescs)
+	{
+		const PxConstraintSolverPrepBatch prep = shaderDescs[0].constraint ? shaderDescs[0].constraint->solverPrepBatch : NULL;
+		for(PxU32 a=1; a<4; a++)
+		{
+			if(!shaderDescs[a].constraint || shaderDescs[a].constraint->solverPrepBatch != prep)
+				return NULL;
+		}
+		return prep;
+	}
+
+	// Runs the batched shader for the 4 constraints of a solver batch. Constraint i gets the rows starting at
+	// allRows + i*MAX_CONSTRAINT_ROWS. Returns false if one of the constraints is disabled or generated no rows,
+	// in which case the batch cannot be built.
+	template<class PrepDesc>
+	PX_FORCE_INLINE bool setupConstraintRowsBatch4(PxConstraintSolverPrepBatch prep, const SolverConstraintShaderPrepDesc* PX_RESTRICT shaderDescs,
+		PrepDesc* PX_RESTRICT descs, Px1DConstraint* PX_RESTRICT allRows, PxVec3p* cA2w, PxVec3p* cB2w, PxU32& maxRows)
+	{
+		Px1DConstraint* rows[4];
+		PxU32 nbRows[4];
+		PxVec3p body0WorldOffsets[4];
+		PxConstraintInvMassScale invMassScales[4];
+		const void* constantBlocks[4];
+		PxTransform bodyFrames0[4];
+		PxTransform bodyFrames1[4];
+		bool extendedLimits[4];
+
+		for(PxU32 a=0; a<4; a++)
+		{
+			if(descs[a].disableConstraint)
+				return false;
+
+			rows[a] = allRows + a*MAX_CONSTRAINT_ROWS;
+			invMassScales[a] = PxConstraintInvMassScale(1.0f, 1.0f, 1.0f, 1.0f);
+			body0WorldOffsets[a] = PxVec3(0.0f);
+			constantBlocks[a] = shaderDescs[a].constantBlock;
+			bodyFrames0[a] = descs[a].bodyFrame0;
+			bodyFrames1[a] = descs[a].bodyFrame1;
+			extendedLimits[a] = descs[a].extendedLimits;
+		}
+
+		setupConstraintRows(allRows, MAX_CONSTRAINT_ROWS*4);
+
+		//TAG:solverprepcall
+		(*prep)(4, rows, nbRows, body0WorldOffsets, MAX_CONSTRAINT_ROWS, invMassScales, constantBlocks, bodyFrames0, bodyFrames1, extendedLimits, cA2w, cB2w);
+
+		maxRows = 0;
+		for(PxU32 a=0; a<4; a++)
+		{
+			if(!nbRows[a])
+				return false;
+
+			PrepDesc& desc = descs[a];
+			desc.rows = rows[a];
+			desc.numRows = nbRows[a];
+			desc.invMassScales = invMassScales[a];
+			desc.body0WorldOffset = body0WorldOffsets[a];
+			maxRows = PxMax(maxRows, nbRows[a]);
+		}
+		return true;
+	}
 }
 
 }
@@ -560,6 +560,35 @@ Cm::SpatialVectorF* Z)
 	return prepDesc.numRows;
 }
 
+// Seeds the rows of a rigid body constraint with the impulse the constraint applied in the previous step. The impulse is
+// applied to the bodies by the first solve of the constraint.
+static void setupWarmStart1D(PxSolverConstraintDesc& desc)
+{
+	SolverConstraint1DHeader* header = reinterpret_cast<SolverConstraint1DHeader*>(desc.constraint);
+	const ConstraintWriteback* writeback = reinterpret_cast<const ConstraintWriteback*>(desc.writeBack);
+	if(!header || !writeback || header->type != DY_SC_TYPE_RB_1D)
+		return;
+
+	PxVec3 linImpulse = writeback->linearImpulse;
+	PxVec3 angImpulse = writeback->angularImpulse;
+	bool warmStarted = false;
+
+	SolverConstraint1D* rows = reinterpret_cast<SolverConstraint1D*>(desc.constraint + sizeof(SolverConstraint1DHeader));
+	for(PxU32 i=0; i<header->count; i++)
+	{
+		SolverConstraint1D& c = rows[i];
+		if(!(c.flags & DY_SC_FLAG_OUTPUT_FORCE) || c.velMultiplier == 0.0f)
+			continue;
+
+		const PxVec3 ang = c.ang0Writeback - header->body0WorldOffset.cross(c.lin0);
+		c.appliedForce = computeWarmStartImpulse(linImpulse, angImpulse, c.lin0, ang, c.minImpulse, c.maxImpulse);
+		warmStarted = warmStarted || c.appliedForce != 0.0f;
+	}
+
+	if(warmStarted)
+		header->flags |= DY_SC_1D_FLAG_WARM_START;
+}
+
 PxU32 SetupSolverConstraint(SolverConstraintShaderPrepDesc& shaderDesc,
 	PxSolverConstraintPrepDesc& prepDesc,
 	PxConstraintAllocator& allocator,
@@ -594,7 +623,10 @@ PxU32 SetupSolverConstraint(SolverConstraintShaderPrepDesc& shaderDesc,
 
 	prepDesc.rows = rows;
 
-	return ConstraintHelper::setupSolverConstraint(prepDesc, allocator, dt, invdt, Z);
+	const PxU32 nbRows = ConstraintHelper::setupSolverConstraint(prepDesc, allocator, dt, invdt, Z);
+	if(nbRows && isWarmStarted(shaderDesc))
+		setupWarmStart1D(*prepDesc.desc);
+	return nbRows;
 }
 
 }
@@ -67,6 +67,49 @@ SolverConstraintPrepState::Enum setupSolverConstraint4
 		const PxReal dt, const PxReal recipdt, PxU32& totalRows,
 		PxConstraintAllocator& allocator, PxU32 maxRows);
 
+static PX_FORCE_INLINE PxReal& getLane(Vec4V& v, PxU32 lane)
+{
+	return reinterpret_cast<PxVec4&>(v)[lane];
+}
+
+// Seeds the rows of the warm-started constraints of a batch with the impulses they applied in the previous step.
+// The impulses are applied to the bodies by the first solve of the batch.
+static void setupWarmStart1D4(const SolverConstraintShaderPrepDesc* PX_RESTRICT shaderDescs, const PxSolverConstraintPrepDesc* PX_RESTRICT descs)
+{
+	SolverConstraint1DHeader4* header = reinterpret_cast<SolverConstraint1DHeader4*>(descs[0].desc->constraint);
+	SolverConstraint1DDynamic4* rows = reinterpret_cast<SolverConstraint1DDynamic4*>(header + 1);
+	const PxU32 counts[4] = { header->count0, header->count1, header->count2, header->count3 };
+
+	bool warmStarted = false;
+	for(PxU32 a = 0; a < 4; ++a)
+	{
+		const ConstraintWriteback* writeback = reinterpret_cast<const ConstraintWriteback*>(descs[a].writeback);
+		if(!writeback || !isWarmStarted(shaderDescs[a]))
+			continue;
+
+		PxVec3 linImpulse = writeback->linearImpulse;
+		PxVec3 angImpulse = writeback->angularImpulse;
+		const PxVec3 body0WorldOffset = descs[a].body0WorldOffset;
+
+		for(PxU32 i = 0; i < counts[a]; ++i)
+		{
+			SolverConstraint1DDynamic4& c = rows[i];
+			if(!(c.flags[a] & DY_SC_FLAG_OUTPUT_FORCE) || getLane(c.velMultiplier, a) == 0.0f)
+				continue;
+
+			const PxVec3 lin0(getLane(c.lin0X, a), getLane(c.lin0Y, a), getLane(c.lin0Z, a));
+			const PxVec3 ang0(getLane(c.ang0WritebackX, a), getLane(c.ang0WritebackY, a), getLane(c.ang0WritebackZ, a));
+			const PxReal impulse = computeWarmStartImpulse(linImpulse, angImpulse, lin0, ang0 - body0WorldOffset.cross(lin0),
+				getLane(c.minImpulse, a), getLane(c.maxImpulse, a));
+			getLane(c.appliedForce, a) = impulse;
+			warmStarted = warmStarted || impulse != 0.0f;
+		}
+	}
+
+	if(warmStarted)
+		header->flags |= DY_SC_1D_FLAG_WARM_START;
+}
+
 SolverConstraintPrepState::Enum setupSolverConstraint4
 (SolverConstraintShaderPrepDesc* PX_RESTRICT constraintShaderDescs,
 PxSolverConstraintPrepDesc* PX_RESTRICT constraintDescs,
@@ -79,49 +122,64 @@ PxConstraintAllocator& allocator)
 	totalRows = 0;
 
 	Px1DConstraint allRows[MAX_CONSTRAINT_ROWS * 4];
-	Px1DConstraint* rows = allRows;
-	Px1DConstraint* rows2 = allRows;
-	
+
 	PxU32 maxRows = 0;
-	PxU32 nbToPrep = MAX_CONSTRAINT_ROWS;
 
-	for (PxU32 a = 0; a < 4; ++a)
+	const PxConstraintSolverPrepBatch prepBatch = getSolverPrepBatch4(constraintShaderDescs);
+	if(prepBatch)
 	{
-		SolverConstraintShaderPrepDesc& shaderDesc = constraintShaderDescs[a];
-		PxSolverConstraintPrepDesc& desc = constraintDescs[a];
-
-		if (!shaderDesc.solverPrep)
+		PxVec3p unused_ra[4], unused_rb[4];
+		if(!setupConstraintRowsBatch4(prepBatch, constraintShaderDescs, constraintDescs, allRows, unused_ra, unused_rb, maxRows))
 			return SolverConstraintPrepState::eUNBATCHABLE;
+	}
+	else
+	{
+		Px1DConstraint* rows = allRows;
+		Px1DConstraint* rows2 = allRows;
+	
+		PxU32 nbToPrep = MAX_CONSTRAINT_ROWS;
 
-		PX_ASSERT(rows2 + nbToPrep <= allRows + MAX_CONSTRAINT_ROWS*4);
-		setupConstraintRows(rows2, nbToPrep);
-		rows2 += nbToPrep;
+		for (PxU32 a = 0; a < 4; ++a)
+		{
+			SolverConstraintShaderPrepDesc& shaderDesc = constraintShaderDescs[a];
+			PxSolverConstraintPrepDesc& desc = constraintDescs[a];
 
-		desc.invMassScales.linear0 = desc.invMassScales.linear1 = desc.invMassScales.angular0 = desc.invMassScales.angular1 = 1.0f;
-		desc.body0WorldOffset = PxVec3(0.0f);
+			if (!shaderDesc.solverPrep)
+				return SolverConstraintPrepState::eUNBATCHABLE;
 
-		PxVec3p unused_ra, unused_rb;
+			PX_ASSERT(rows2 + nbToPrep <= allRows + MAX_CONSTRAINT_ROWS*4);
+			setupConstraintRows(rows2, nbToPrep);
+			rows2 += nbToPrep;
 
-		//TAG:solverprepcall
-		const PxU32 constraintCount = desc.disableConstraint ? 0 : (*shaderDesc.solverPrep)(rows,
-			desc.body0WorldOffset,
-			MAX_CONSTRAINT_ROWS,
-			desc.invMassScales,
-			shaderDesc.constantBlock,
-			desc.bodyFrame0, desc.bodyFrame1, desc.extendedLimits, unused_ra, unused_rb);
+			desc.invMassScales.linear0 = desc.invMassScales.linear1 = desc.invMassScales.angular0 = desc.invMassScales.angular1 = 1.0f;
+			desc.body0WorldOffset = PxVec3(0.0f);
 
-		nbToPrep = constraintCount;
-		maxRows = PxMax(constraintCount, maxRows);
+			PxVec3p unused_ra, unused_rb;
 
-		if (constraintCount == 0)
-			return SolverConstraintPrepState::eUNBATCHABLE;
+			//TAG:solverprepcall
+			const PxU32 constraintCount = desc.disableConstraint ? 0 : (*shaderDesc.solverPrep)(rows,
+				desc.body0WorldOffset,
+				MAX_CONSTRAINT_ROWS,
+				desc.invMassScales,
+				shaderDesc.constantBlock,
+				desc.bodyFrame0, desc.bodyFrame1, desc.extendedLimits, unused_ra, unused_rb);
 
-		desc.rows = rows;
-		desc.numRows = constraintCount;
-		rows += constraintCount;
+			nbToPrep = constraintCount;
+			maxRows = PxMax(constraintCount, maxRows);
+
+			if (constraintCount == 0)
+				return SolverConstraintPrepState::eUNBATCHABLE;
+
+			desc.rows = rows;
+			desc.numRows = constraintCount;
+			rows += constraintCount;
+		}
 	}
 
-	return setupSolverConstraint4(constraintDescs, dt, recipdt, totalRows, allocator, maxRows);
+	const SolverConstraintPrepState::Enum state = setupSolverConstraint4(constraintDescs, dt, recipdt, totalRows, allocator, maxRows);
+	if(state == SolverConstraintPrepState::eSUCCESS)
+		setupWarmStart1D4(constraintShaderDescs, constraintDescs);
+	return state;
 }
 
 SolverConstraintPrepState::Enum setupSolverConstraint4
@@ -304,6 +362,7 @@ PxConstraintAllocator& allocator, PxU32 maxRows)
 
 		header->count = maxRows;
 		header->type = DY_SC_TYPE_BLOCK_1D;
+		header->flags = 0;
 		header->linBreakImpulse = V4Scale(linBreakForce, dtV);
 		header->angBreakImpulse = V4Scale(angBreakForce, dtV);
 		header->count0 = PxTo8(constraintDescs[0].numRows);
@@ -43,7 +43,8 @@ namespace Dy
 struct SolverConstraint1DHeader4
 {
 	PxU8	type;			// enum SolverConstraintType - must be first byte
-	PxU8	pad0[3];	
+	PxU8	flags;		// SolverConstraint1DHeaderFlags
+	PxU8	pad0[2];
 	//These counts are the max of the 4 sets of data.
 	//When certain pairs have fewer constraints than others, they are padded with 0s so that no work is performed but 
 	//calculations are still shared (afterall, they're computationally free because we're doing 4 things at a time in SIMD)
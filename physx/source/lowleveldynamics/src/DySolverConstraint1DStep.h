@@ -122,7 +122,7 @@ namespace physx
 		{
 			PxU8	type;			// enum SolverConstraintType - must be first byte
 			PxU8	count;			// count of following 1D constraints
-			PxU8	dominance;
+			PxU8	flags;			// SolverConstraint1DHeaderFlags
 			PxU8	breakable;		// indicate whether this constraint is breakable or not						
 			PxReal	linBreakImpulse;
 			PxReal	angBreakImpulse;
@@ -155,7 +155,7 @@ namespace physx
 		{
 			h.type = PxU8(isExtended ? DY_SC_TYPE_EXT_1D : DY_SC_TYPE_RB_1D);
 			h.count = count;
-			h.dominance = 0;
+			h.flags = 0;
 			h.linearInvMassScale0 = ims.linear0;
 			h.angularInvMassScale0 = ims.angular0;
 			h.linearInvMassScale1 = -ims.linear1;
@@ -65,6 +65,11 @@ enum SolverConstraintFlags
 	DY_SC_FLAG_INEQUALITY		= (1<<6)
 };
 
+enum SolverConstraint1DHeaderFlags
+{
+	DY_SC_1D_FLAG_WARM_START	= (1<<0)	// the rows' appliedForce holds a warm-start impulse that has not been applied yet
+};
+
 }
 
 #endif
@@ -48,6 +48,43 @@ namespace physx
 namespace Dy
 {
 
+// Applies the warm-start impulses written to the rows' appliedForce at prep time. Done once, right before the first solve
+// of a warm-started constraint, which then carries on from the applied impulses.
+static void warmStart1D(const PxSolverConstraintDesc& desc, SolverConstraint1DHeader& header, const SolverConstraint1D* PX_RESTRICT base)
+{
+	PxSolverBody& b0 = *desc.bodyA;
+	PxSolverBody& b1 = *desc.bodyB;
+
+	Vec3V linVel0 = V3LoadA(b0.linearVelocity);
+	Vec3V linVel1 = V3LoadA(b1.linearVelocity);
+	Vec3V angState0 = V3LoadA(b0.angularState);
+	Vec3V angState1 = V3LoadA(b1.angularState);
+
+	const FloatV invMass0 = FLoad(header.invMass0D0);
+	const FloatV invMass1 = FLoad(header.invMass1D1);
+	const FloatV invInertiaScale0 = FLoad(header.angularInvMassScale0);
+	const FloatV invInertiaScale1 = FLoad(header.angularInvMassScale1);
+
+	for(PxU32 i=0; i<header.count; ++i, base++)
+	{
+		const SolverConstraint1D& c = *base;
+		const FloatV appliedForce = FLoad(c.appliedForce);
+
+		linVel0 = V3ScaleAdd(V3LoadA(c.lin0), FMul(appliedForce, invMass0), linVel0);
+		linVel1 = V3NegScaleSub(V3LoadA(c.lin1), FMul(appliedForce, invMass1), linVel1);
+		angState0 = V3ScaleAdd(V3LoadA(c.ang0), FMul(appliedForce, invInertiaScale0), angState0);
+		//This should be negScaleSub but invInertiaScale1 is negated already
+		angState1 = V3ScaleAdd(V3LoadA(c.ang1), FMul(appliedForce, invInertiaScale1), angState1);
+	}
+
+	header.flags &= ~DY_SC_1D_FLAG_WARM_START;
+
+	V3StoreA(linVel0, b0.linearVelocity);
+	V3StoreA(angState0, b0.angularState);
+	V3StoreA(linVel1, b1.linearVelocity);
+	V3StoreA(angState1, b1.angularState);
+}
+
 //Port of scalar implementation to SIMD maths with some interleaving of instructions
 void solve1D(const PxSolverConstraintDesc& desc, SolverContext& cache)
 {
@@ -60,9 +97,12 @@ void solve1D(const PxSolverConstraintDesc& desc, SolverContext& cache)
 		return;
 	//PxU32 length = desc.constraintLength;
 
-	const SolverConstraint1DHeader* PX_RESTRICT  header = reinterpret_cast<const SolverConstraint1DHeader*>(bPtr);
+	SolverConstraint1DHeader* PX_RESTRICT  header = reinterpret_cast<SolverConstraint1DHeader*>(bPtr);
 	SolverConstraint1D* PX_RESTRICT base = reinterpret_cast<SolverConstraint1D*>(bPtr + sizeof(SolverConstraint1DHeader));
 
+	if(header->flags & DY_SC_1D_FLAG_WARM_START)
+		warmStart1D(desc, *header, base);
+
 	Vec3V linVel0 = V3LoadA(b0.linearVelocity);
 	Vec3V linVel1 = V3LoadA(b1.linearVelocity);
 	Vec3V angState0 = V3LoadA(b0.angularState);
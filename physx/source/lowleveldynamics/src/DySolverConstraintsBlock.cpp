@@ -897,6 +897,36 @@ static void solve1D4_Block(const PxSolverConstraintDesc* PX_RESTRICT desc, Solve
 
 	PxU32 maxConstraints = header->count;
 
+	if(header->flags & DY_SC_1D_FLAG_WARM_START)
+	{
+		//Apply the warm-start impulses written to appliedForce at prep time before the first solve. Padding rows have no impulse.
+		for(PxU32 a = 0; a < maxConstraints; ++a)
+		{
+			const SolverConstraint1DDynamic4& c = base[a];
+
+			const Vec4V fInvMass0 = V4Mul(c.appliedForce, invMass0D0);
+			const Vec4V fInvMass1 = V4Mul(c.appliedForce, invMass1D1);
+			const Vec4V angFInvMass0 = V4Mul(c.appliedForce, angD0);
+			const Vec4V angFInvMass1 = V4Mul(c.appliedForce, angD1);
+
+			linVel0T0 = V4MulAdd(c.lin0X, fInvMass0, linVel0T0);
+			linVel1T0 = V4NegMulSub(c.lin1X, fInvMass1, linVel1T0);
+			angState0T0 = V4MulAdd(c.ang0X, angFInvMass0, angState0T0);
+			angState1T0 = V4NegMulSub(c.ang1X, angFInvMass1, angState1T0);
+
+			linVel0T1 = V4MulAdd(c.lin0Y, fInvMass0, linVel0T1);
+			linVel1T1 = V4NegMulSub(c.lin1Y, fInvMass1, linVel1T1);
+			angState0T1 = V4MulAdd(c.ang0Y, angFInvMass0, angState0T1);
+			angState1T1 = V4NegMulSub(c.ang1Y, angFInvMass1, angState1T1);
+
+			linVel0T2 = V4MulAdd(c.lin0Z, fInvMass0, linVel0T2);
+			linVel1T2 = V4NegMulSub(c.lin1Z, fInvMass1, linVel1T2);
+			angState0T2 = V4MulAdd(c.ang0Z, angFInvMass0, angState0T2);
+			angState1T2 = V4NegMulSub(c.ang1Z, angFInvMass1, angState1T2);
+		}
+		header->flags &= ~DY_SC_1D_FLAG_WARM_START;
+	}
+
 	for(PxU32 a = 0; a < maxConstraints; ++a)
 	{
 		SolverConstraint1DDynamic4& c = *base;
@@ -2417,6 +2417,36 @@ PxU32 setupSolverConstraintStep(
 }
 
 
+// Seeds the rows of a rigid body constraint with the impulse the constraint applied in the previous step. The writeback
+// holds the impulse accumulated over all the substeps, stepScale brings it back to a single substep. The impulse is applied
+// to the bodies by the first solve of the constraint. Rows re-orthogonalized at solve time are left alone.
+static void setupWarmStart1DStep(PxSolverConstraintDesc& desc, const PxReal stepScale)
+{
+	SolverConstraint1DHeaderStep* header = reinterpret_cast<SolverConstraint1DHeaderStep*>(desc.constraint);
+	const ConstraintWriteback* writeback = reinterpret_cast<const ConstraintWriteback*>(desc.writeBack);
+	if(!header || !writeback || header->type != DY_SC_TYPE_RB_1D)
+		return;
+
+	PxVec3 linImpulse = writeback->linearImpulse * stepScale;
+	PxVec3 angImpulse = writeback->angularImpulse * stepScale;
+	bool warmStarted = false;
+
+	SolverConstraint1DStep* rows = reinterpret_cast<SolverConstraint1DStep*>(desc.constraint + sizeof(SolverConstraint1DHeaderStep));
+	for(PxU32 i=0; i<header->count; i++)
+	{
+		SolverConstraint1DStep& c = rows[i];
+		if(!(c.flags & DY_SC_FLAG_OUTPUT_FORCE) || (c.flags & DY_SC_FLAG_ORTHO_TARGET) || c.velMultiplier == 0.0f)
+			continue;
+
+		const PxVec3 ang = c.ang0 + c.lin0.cross(header->rAWorld) - header->body0WorldOffset.cross(c.lin0);
+		c.appliedForce = computeWarmStartImpulse(linImpulse, angImpulse, c.lin0, ang, c.minImpulse, c.maxImpulse);
+		warmStarted = warmStarted || c.appliedForce != 0.0f;
+	}
+
+	if(warmStarted)
+		header->flags |= DY_SC_1D_FLAG_WARM_START;
+}
+
 PxU32 SetupSolverConstraintStep(SolverConstraintShaderPrepDesc& shaderDesc,
 	PxTGSSolverConstraintPrepDesc& prepDesc,
 	PxConstraintAllocator& allocator,
@@ -2457,7 +2487,10 @@ PxU32 SetupSolverConstraintStep(SolverConstraintShaderPrepDesc& shaderDesc,
 	if (prepDesc.bodyState1 != PxSolverContactDesc::eARTICULATION && prepDesc.body1->isKinematic)
 		prepDesc.invMassScales.angular1 = 0.f;
 
-	return setupSolverConstraintStep(prepDesc, allocator, dt, totalDt, invdt, invTotalDt, lengthScale, biasCoefficient);
+	const PxU32 nbRows = setupSolverConstraintStep(prepDesc, allocator, dt, totalDt, invdt, invTotalDt, lengthScale, biasCoefficient);
+	if(nbRows && isWarmStarted(shaderDesc))
+		setupWarmStart1DStep(*prepDesc.desc, dt/totalDt);
+	return nbRows;
 }
 
 void solveExt1D(const PxSolverConstraintDesc& desc, Vec3V& linVel0, Vec3V& linVel1, Vec3V& angVel0, Vec3V& angVel1,
@@ -2675,7 +2708,7 @@ void solve1DStep(const PxSolverConstraintDesc& desc, const PxTGSSolverBodyTxIner
 	const PxTGSSolverBodyTxInertia& txI0 = txInertias[desc.bodyADataIndex];
 	const PxTGSSolverBodyTxInertia& txI1 = txInertias[desc.bodyBDataIndex];	
 
-	const SolverConstraint1DHeaderStep* PX_RESTRICT  header = reinterpret_cast<const SolverConstraint1DHeaderStep*>(bPtr);
+	SolverConstraint1DHeaderStep* PX_RESTRICT  header = reinterpret_cast<SolverConstraint1DHeaderStep*>(bPtr);
 	SolverConstraint1DStep* PX_RESTRICT base = reinterpret_cast<SolverConstraint1DStep*>(bPtr + sizeof(SolverConstraint1DHeaderStep));
 
 	Vec3V linVel0 = V3LoadA(b0.linearVelocity);
@@ -2736,6 +2769,28 @@ void solve1DStep(const PxSolverConstraintDesc& desc, const PxTGSSolverBodyTxIner
 	FloatV error1 = FAdd(V4GetW(ang1Ortho1_Error1), FSub(V3Dot(ang0Ortho1, ang0), V3Dot(ang1Ortho1, ang1)));
 	FloatV error2 = FAdd(V4GetW(ang1Ortho2_Error2), FSub(V3Dot(ang0Ortho2, ang0), V3Dot(ang1Ortho2, ang1)));
 
+	if (header->flags & DY_SC_1D_FLAG_WARM_START)
+	{
+		//Apply the warm-start impulses written to appliedForce at prep time before the first solve
+		for (PxU32 i = 0; i<header->count; ++i)
+		{
+			const SolverConstraint1DStep& c = base[i];
+
+			const Vec3V clinVel0 = V3LoadA(c.lin0);
+			const Vec3V clinVel1 = V3LoadA(c.lin1);
+			const FloatV appliedForce = FLoad(c.appliedForce);
+
+			const Vec3V raXnI = M33MulV3(sqrtInvInertia0, V3Add(V3LoadA(c.ang0), V3Cross(raCross, clinVel0)));
+			const Vec3V rbXnI = M33MulV3(sqrtInvInertia1, V3Add(V3LoadA(c.ang1), V3Cross(rbCross, clinVel1)));
+
+			linVel0 = V3ScaleAdd(clinVel0, FMul(appliedForce, invMass0), linVel0);
+			linVel1 = V3NegScaleSub(clinVel1, FMul(appliedForce, invMass1), linVel1);
+			angState0 = V3ScaleAdd(raXnI, FMul(appliedForce, invInertiaScale0), angState0);
+			angState1 = V3ScaleAdd(rbXnI, FMul(appliedForce, invInertiaScale1), angState1);
+		}
+		header->flags &= ~DY_SC_1D_FLAG_WARM_START;
+	}
+
 	for (PxU32 i = 0; i<header->count; ++i, base++)
 	{
 		PxPrefetchLine(base + 1);
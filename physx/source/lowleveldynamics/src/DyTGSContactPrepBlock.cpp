@@ -1789,7 +1789,38 @@ SolverConstraintPrepState::Enum setupSolverConstraintStep4
 
 	totalRows = 0;
 
+	//Warm-started constraints are seeded by the scalar prep
+	for (PxU32 a = 0; a < 4; ++a)
+	{
+		if (isWarmStarted(constraintShaderDescs[a]))
+			return SolverConstraintPrepState::eUNBATCHABLE;
+	}
+
 	Px1DConstraint allRows[MAX_CONSTRAINT_ROWS * 4];
+
+	const PxConstraintSolverPrepBatch prepBatch = getSolverPrepBatch4(constraintShaderDescs);
+	if(prepBatch)
+	{
+		PxVec3p cA2w[4], cB2w[4];
+		PxU32 maxRows;
+		if(!setupConstraintRowsBatch4(prepBatch, constraintShaderDescs, constraintDescs, allRows, cA2w, cB2w, maxRows))
+			return SolverConstraintPrepState::eUNBATCHABLE;
+
+		for(PxU32 a = 0; a < 4; ++a)
+		{
+			PxTGSSolverConstraintPrepDesc& desc = constraintDescs[a];
+			desc.cA2w = cA2w[a];
+			desc.cB2w = cB2w[a];
+
+			if (desc.body0->isKinematic)
+				desc.invMassScales.angular0 = 0.0f;
+			if (desc.body1->isKinematic)
+				desc.invMassScales.angular1 = 0.0f;
+		}
+
+		return setupSolverConstraintStep4(constraintDescs, dt, totalDt, recipdt, recipTotalDt, totalRows, allocator, maxRows, lengthScale, biasCoefficient);
+	}
+
 	Px1DConstraint* rows = allRows;
 	Px1DConstraint* rows2 = allRows;
 
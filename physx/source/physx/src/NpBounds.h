@@ -29,6 +29,8 @@
 #ifndef NP_BOUNDS_H
 #define NP_BOUNDS_H
 
+#include "GuSqInternal.h"	// for SQ_PRUNER_EPSILON
+
 namespace physx
 {
 	class PxBounds3;
@@ -40,10 +42,6 @@ namespace Sq
 	typedef void(*ComputeBoundsFunc)	(PxBounds3& bounds, const NpShape& scShape, const NpActor& npActor);
 
 	extern const ComputeBoundsFunc gComputeBoundsTable[2];
-
-//	#define SQ_PRUNER_EPSILON	0.01f
-	#define SQ_PRUNER_EPSILON	0.005f
-	#define SQ_PRUNER_INFLATION	(1.0f + SQ_PRUNER_EPSILON)	// pruner test shape inflation (not narrow phase shape)
 }
 }
 
@@ -1557,7 +1557,7 @@ PxParticleRigidBuffer* NpPhysics::createParticleRigidBuffer(PxU32 maxParticles,
 
 ///////////////////////////////////////////////////////////////////////////////
 
-PxPruningStructure* NpPhysics::createPruningStructure(PxRigidActor*const* actors, PxU32 nbActors)
+PxPruningStructure* NpPhysics::createPruningStructure(PxRigidActor*const* actors, PxU32 nbActors, PxBVHBuildStrategy::Enum buildStrategy, PxCpuDispatcher* dispatcher)
 {
 	PX_SIMD_GUARD;
 
@@ -1565,7 +1565,7 @@ PxPruningStructure* NpPhysics::createPruningStructure(PxRigidActor*const* actors
 	PX_ASSERT(nbActors > 0);
 
 	Sq::PruningStructure* ps = PX_NEW(Sq::PruningStructure)();	
-	if(!ps->build(actors, nbActors))
+	if(!ps->build(actors, nbActors, buildStrategy, dispatcher))
 	{
 		PX_DELETE(ps);		
 	}
@@ -223,7 +223,7 @@ public:
 	PX_FORCE_INLINE void			unregisterPhysXIndicatorGpuClient() {}
 #endif
 
-	virtual		PxPruningStructure*			createPruningStructure(PxRigidActor*const* actors, PxU32 nbActors)	PX_OVERRIDE;
+	virtual		PxPruningStructure*			createPruningStructure(PxRigidActor*const* actors, PxU32 nbActors, PxBVHBuildStrategy::Enum buildStrategy, PxCpuDispatcher* dispatcher)	PX_OVERRIDE;
 
 	virtual		const PxTolerancesScale&	getTolerancesScale() const	PX_OVERRIDE;
 
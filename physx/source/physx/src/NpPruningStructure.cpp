@@ -120,7 +120,7 @@ static void getShapeBounds(PxRigidActor* actor, bool dynamic, PxBounds3* bounds,
 }
 
 //////////////////////////////////////////////////////////////////////////
-bool PruningStructure::build(PxRigidActor*const* actors, PxU32 nbActors)
+bool PruningStructure::build(PxRigidActor*const* actors, PxU32 nbActors, PxBVHBuildStrategy::Enum buildStrategy, PxCpuDispatcher* dispatcher)
 {
 	PX_ASSERT(actors);
 	PX_ASSERT(nbActors > 0);
@@ -218,6 +218,16 @@ bool PruningStructure::build(PxRigidActor*const* actors, PxU32 nbActors)
 		}
 	}
 	
+	BVHBuildStrategy bs;
+	if(buildStrategy==PxBVHBuildStrategy::eDEFAULT)
+		bs = BVH_SPLATTER_POINTS_SPLIT_GEOM_CENTER;
+	else if(buildStrategy==PxBVHBuildStrategy::eSAH)
+		bs = BVH_SAH;
+	else if(buildStrategy==PxBVHBuildStrategy::eBINNED_SAH)
+		bs = BVH_BINNED_SAH;
+	else
+		bs = BVH_SPLATTER_POINTS;
+
 	AABBTree aabbTrees[2];
 	for (PxU32 i = 0; i < 2; i++)
 	{
@@ -226,7 +236,9 @@ bool PruningStructure::build(PxRigidActor*const* actors, PxU32 nbActors)
 		{
 			// create the AABB tree
 			NodeAllocator nodeAllocator;
-			bool status = aabbTrees[i].build(AABBTreeBuildParams(PS_NB_OBJECTS_PER_NODE, numShapes[i], &bounds[i]), nodeAllocator);
+			AABBTreeBuildParams params(PS_NB_OBJECTS_PER_NODE, numShapes[i], &bounds[i], bs);
+			params.mDispatcher = dispatcher;
+			bool status = aabbTrees[i].build(params, nodeAllocator);
 
 			PX_UNUSED(status);
 			PX_ASSERT(status);
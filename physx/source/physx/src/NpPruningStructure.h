@@ -32,12 +32,15 @@
 @{ */
 
 #include "PxPruningStructure.h"
+#include "geometry/PxBVHBuildStrategy.h"
 
 #include "foundation/PxUserAllocated.h"
 #include "GuPrunerMergeData.h"
 
 namespace physx
 {
+	class PxCpuDispatcher;
+
 	namespace Sq
 	{
 		class PruningStructure : public PxPruningStructure, public PxUserAllocated
@@ -65,7 +68,7 @@ namespace physx
 													PruningStructure();
 			virtual									~PruningStructure();
 
-							bool					build(PxRigidActor*const* actors, PxU32 nbActors);			
+							bool					build(PxRigidActor*const* actors, PxU32 nbActors, PxBVHBuildStrategy::Enum buildStrategy, PxCpuDispatcher* dispatcher);			
 
 			PX_FORCE_INLINE	PxU32					getNbActors()				const	{ return mNbActors;	}
 			PX_FORCE_INLINE	PxActor*const*			getActors()					const	{ return mActors;	}
@@ -339,6 +339,7 @@ class NpScene : public NpSceneAccessor, public PxUserAllocated
 	virtual			void							setUpdateMode(PxSceneQueryUpdateMode::Enum updateMode);
 	virtual			PxSceneQueryUpdateMode::Enum	getUpdateMode() const;
 	virtual			PxU32							getStaticTimestamp()	const;
+	virtual			void							getDynamicTreeRefitStats(PxDynamicTreeRefitStats& stats)	const;
 	virtual			void							flushUpdates();
 	virtual			bool							raycast(
 														const PxVec3& origin, const PxVec3& unitDir, const PxReal distance,	// Ray data
@@ -699,6 +700,8 @@ private:
 					SceneAdvance					mSceneAdvance;
 					PxSQBuildStepHandle				mStaticBuildStepHandle;
 					PxSQBuildStepHandle				mDynamicBuildStepHandle;
+					PxArray<PxSQCompoundHandle>		mSyncedCompoundHandles;		// scratch buffers for the batched compound updates in syncSQ()
+					PxArray<PxTransform>			mSyncedCompoundTransforms;
 					bool                            mControllingSimulation;
 					bool							mIsAPIReadForbidden;	// Set to true when the user is not allowed to call certain read APIs
 																			// (properties that get written to during the simulation. Search the macros PX_CHECK_SCENE_API_READ_FORBIDDEN... 
@@ -342,6 +342,12 @@ namespace
 			SQ().updateCompoundActor(PrunerCompoundId(compoundHandle), compoundTransform);
 		}
 
+		virtual		void				updateSQCompounds(const PxSQCompoundHandle* compoundHandles, const PxTransform* compoundTransforms, PxU32 nbCompounds)
+		{
+			PX_COMPILE_TIME_ASSERT(sizeof(PxSQCompoundHandle)==sizeof(PrunerCompoundId));
+			SQ().updateCompoundActors(reinterpret_cast<const PrunerCompoundId*>(compoundHandles), compoundTransforms, nbCompounds);
+		}
+
 		virtual	void							flushUpdates()														{ SQ().flushUpdates();														}
 		virtual	void							flushMemory()														{ SQ().flushMemory();														}
 		virtual	void							visualize(PxU32 prunerIndex, PxRenderOutput& out)			const	{ SQ().visualize(prunerIndex, out);										}
@@ -354,6 +360,7 @@ namespace
 		virtual	PxSceneQueryUpdateMode::Enum	getUpdateMode()												const	{ return mUpdateMode;														}
 		virtual	void							setUpdateMode(PxSceneQueryUpdateMode::Enum mode)					{ mUpdateMode = mode;														}
 		virtual	PxU32							getStaticTimestamp()										const	{ return SQ().getStaticTimestamp();										}
+		virtual	void							getDynamicTreeRefitStats(PxDynamicTreeRefitStats& stats)	const	{ SQ().getDynamicTreeRefitStats(stats);									}
 
 		virtual	void							finalizeUpdates()
 		{
@@ -455,12 +462,13 @@ static BVHBuildStrategy getBuildStrategy(PxBVHBuildStrategy::Enum bs)
 		case PxBVHBuildStrategy::eFAST:		return BVH_SPLATTER_POINTS;
 		case PxBVHBuildStrategy::eDEFAULT:	return BVH_SPLATTER_POINTS_SPLIT_GEOM_CENTER;
 		case PxBVHBuildStrategy::eSAH:		return BVH_SAH;
+		case PxBVHBuildStrategy::eBINNED_SAH:	return BVH_BINNED_SAH;
 		case PxBVHBuildStrategy::eLAST:		return BVH_SPLATTER_POINTS;
 	}
 	return BVH_SPLATTER_POINTS;
 }
 
-static Pruner* create(PxPruningStructureType::Enum type, PxU64 contextID, PxDynamicTreeSecondaryPruner::Enum secondaryType, PxBVHBuildStrategy::Enum buildStrategy, PxU32 nbObjectsPerNode)
+static Pruner* create(PxPruningStructureType::Enum type, PxU64 contextID, PxDynamicTreeSecondaryPruner::Enum secondaryType, PxBVHBuildStrategy::Enum buildStrategy, PxU32 nbObjectsPerNode, PxCpuDispatcher* dispatcher, bool wideTree, float cellSize)
 {
 	// PT: to force testing the bucket pruner
 //	return createBucketPruner(contextID);
@@ -473,8 +481,9 @@ static Pruner* create(PxPruningStructureType::Enum type, PxU64 contextID, PxDyna
 	switch(type)
 	{
 		case PxPruningStructureType::eNONE:					{ pruner = createBucketPruner(contextID);										break;	}
-		case PxPruningStructureType::eDYNAMIC_AABB_TREE:	{ pruner = createAABBPruner(contextID, true, cpType, bs, nbObjectsPerNode);		break;	}
-		case PxPruningStructureType::eSTATIC_AABB_TREE:		{ pruner = createAABBPruner(contextID, false, cpType, bs, nbObjectsPerNode);	break;	}
+		case PxPruningStructureType::eDYNAMIC_AABB_TREE:	{ pruner = createAABBPruner(contextID, true, cpType, bs, nbObjectsPerNode, dispatcher, wideTree);		break;	}
+		case PxPruningStructureType::eSTATIC_AABB_TREE:		{ pruner = createAABBPruner(contextID, false, cpType, bs, nbObjectsPerNode, dispatcher, wideTree);	break;	}
+		case PxPruningStructureType::eHASH_GRID:			{ pruner = createHashGridPruner(contextID, cellSize);							break;	}
 		// PT: for tests
 		case PxPruningStructureType::eLAST:					{ pruner = createIncrementalPruner(contextID);									break;	}
 //		case PxPruningStructureType::eLAST:					break;
@@ -491,8 +500,8 @@ static PxSceneQuerySystem* getPxSQ(const PxSceneDesc& desc, PVDCapture* pvd, PxU
 	}
 	else
 	{
-		Pruner* staticPruner = create(desc.staticStructure, contextID, desc.dynamicTreeSecondaryPruner, desc.staticBVHBuildStrategy, desc.staticNbObjectsPerNode);
-		Pruner* dynamicPruner = create(desc.dynamicStructure, contextID, desc.dynamicTreeSecondaryPruner, desc.dynamicBVHBuildStrategy, desc.dynamicNbObjectsPerNode);
+		Pruner* staticPruner = create(desc.staticStructure, contextID, desc.dynamicTreeSecondaryPruner, desc.staticBVHBuildStrategy, desc.staticNbObjectsPerNode, desc.cpuDispatcher, desc.staticWideTree, desc.hashGridCellSize);
+		Pruner* dynamicPruner = create(desc.dynamicStructure, contextID, desc.dynamicTreeSecondaryPruner, desc.dynamicBVHBuildStrategy, desc.dynamicNbObjectsPerNode, desc.cpuDispatcher, desc.dynamicWideTree, desc.hashGridCellSize);
 		return PX_NEW(InternalPxSQ)(desc, pvd, contextID, staticPruner, dynamicPruner);
 	}
 }
@@ -605,6 +614,11 @@ PxU32 NpScene::getStaticTimestamp() const
 	return getSQAPI().getStaticTimestamp();
 }
 
+void NpScene::getDynamicTreeRefitStats(PxDynamicTreeRefitStats& stats) const
+{
+	getSQAPI().getDynamicTreeRefitStats(stats);
+}
+
 PxPruningStructureType::Enum NpScene::getStaticStructure() const
 {
 	return mPrunerType[0];
@@ -652,6 +666,8 @@ void NpScene::syncSQ()
 		// PT: we emulate "getGlobalPose" here by doing the equivalent matrix computation directly.
 		// This works because the code is the same for rigid dynamic & articulation links.
 		// PT: TODO: SIMD
+		mSyncedCompoundHandles.resizeUninitialized(numBodies);
+		mSyncedCompoundTransforms.resizeUninitialized(numBodies);
 		for(PxU32 i = 0; i < numBodies; i++)
 		{
 			// PT: we don't have access to Np from here so we have to go through Px, which is a bit ugly.
@@ -663,8 +679,12 @@ void NpScene::syncSQ()
 			const PxU32 id = static_cast<PxRigidActor*>(actor)->getInternalActorIndex();
 			PX_ASSERT(id!=0xffffffff);
 
-			pm.updateSQCompound(PxSQCompoundHandle(id), bodies[i]->getBody2World() * bodies[i]->getBody2Actor().getInverse());
+			mSyncedCompoundHandles[i] = PxSQCompoundHandle(id);
+			mSyncedCompoundTransforms[i] = bodies[i]->getBody2World() * bodies[i]->getBody2Actor().getInverse();
 		}
+
+		// the compounds are updated in one batch so that the compound-level tree is refit once per frame
+		pm.updateSQCompounds(mSyncedCompoundHandles.begin(), mSyncedCompoundTransforms.begin(), numBodies);
 	}
 
 	SqRefFinder sqRefFinder(pm);
@@ -78,23 +78,6 @@ static PX_FORCE_INLINE PxHitFlags getSweepHitFlags(const CCTParams& params)
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-static bool shouldApplyRecoveryModule(const PxRigidActor& rigidActor)
-{
-	// PT: we must let the dynamic objects go through the CCT for proper 2-way interactions.
-	// But we should still apply the recovery module for kinematics.
-
-	const PxType type = rigidActor.getConcreteType();
-	if(type==PxConcreteType::eRIGID_STATIC)
-		return true;
-
-	if(type!=PxConcreteType::eRIGID_DYNAMIC)
-		return false;
-
-	return static_cast<const PxRigidBody&>(rigidActor).getRigidBodyFlags() & PxRigidBodyFlag::eKINEMATIC;
-}
-
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
 static const bool gUseLocalSpace = true;
 static PxVec3 worldToLocal(const PxObstacle& obstacle, const PxExtendedVec3& worldPos)
 {
@@ -1044,6 +1027,12 @@ void SweepTest::onRelease(const PxBase& observed)
 		mTouchedShape = NULL;
 }
 
+void SweepTest::onShapeChanged(const void* shape)
+{
+	if(ParseGeomStream(shape, mGeomStream))
+		mCacheBounds.setEmpty();
+}
+
 void SweepTest::updateCachedShapesRegistration(PxU32 startIndex, bool unregister)
 {
 	if(!mRegisterDeletionListener)
@@ -1188,7 +1177,7 @@ static PxBounds3 getBounds3(const PxExtendedBounds3& extended)
 }
 
 // PT: finds both touched CCTs and touched user-defined obstacles
-void SweepTest::findTouchedObstacles(const UserObstacles& userObstacles, const PxExtendedBounds3& worldBox)
+void SweepTest::findTouchedObstacles(const InternalCBData_FindTouchedGeom* userData, const UserObstacles& userObstacles, const PxExtendedBounds3& worldBox)
 {
 	PxExtendedVec3 Origin;	// Will be TouchedGeom::mOffset
 	getCenter(worldBox, Origin);
@@ -1260,6 +1249,9 @@ void SweepTest::findTouchedObstacles(const UserObstacles& userObstacles, const P
 			UserCapsule->mCapsule		= capsules[i];
 		}
 	}
+
+	// user-defined obstacles are culled by the obstacle context's AABB trees instead of being tested one by one
+	findTouchedUserObstacles(userData, worldBox, mGeomStream, Origin);
 }
 
 void SweepTest::updateTouchedGeoms(	const InternalCBData_FindTouchedGeom* userData, const UserObstacles& userObstacles,
@@ -1283,14 +1275,24 @@ void SweepTest::updateTouchedGeoms(	const InternalCBData_FindTouchedGeom* userDa
 	filter.mPreFilter		= filters.mFilterFlags & PxQueryFlag::ePREFILTER;
 	filter.mPostFilter		= filters.mFilterFlags & PxQueryFlag::ePOSTFILTER;
 
-	// PT: detect changes to the static pruning structure
+	// PT: detect changes to the static pruning structure. The timestamp changes when any static shape is added, removed
+	// or updated anywhere in the scene, so we then check whether the shapes touched by the cached volume are affected
+	// before throwing the cache away.
 	bool sceneHasChanged = false;
 	{
 		const PxU32 currentTimestamp = getSceneTimestamp(userData);
 		if(currentTimestamp!=mSQTimeStamp)
 		{
 			mSQTimeStamp = currentTimestamp;
-			sceneHasChanged = true;
+			if(gUsePartialUpdates && worldTemporalBox.isInside(mCacheBounds))
+			{
+				CCTFilter staticFilter = filter;
+				staticFilter.mStaticShapes	= (filters.mFilterFlags & PxQueryFlag::eSTATIC) ? true : false;
+				staticFilter.mDynamicShapes	= false;
+				sceneHasChanged = touchedGeometryHasChanged(userData, mCacheBounds, staticFilter, mCachedShapes);
+			}
+			else
+				sceneHasChanged = true;
 		}
 	}
 
@@ -1314,7 +1316,7 @@ void SweepTest::updateTouchedGeoms(	const InternalCBData_FindTouchedGeom* userDa
 			findTouchedGeometry(userData, DYNAMIC_BOX, mWorldTriangles, mTriangleIndices, mGeomStream, filter, mUserParams, mNbTessellation);
 			updateCachedShapesRegistration(mNbCachedStatic, false);
 
-			findTouchedObstacles(userObstacles, DYNAMIC_BOX);
+			findTouchedObstacles(userData, userObstacles, DYNAMIC_BOX);
 
 			mNbPartialUpdates++;
 		}
@@ -1368,7 +1370,8 @@ void SweepTest::updateTouchedGeoms(	const InternalCBData_FindTouchedGeom* userDa
 		if(filters.mFilterFlags & PxQueryFlag::eSTATIC)
 			filter.mStaticShapes	= true;
 		filter.mDynamicShapes	= false;
-		findTouchedGeometry(userData, mCacheBounds, mWorldTriangles, mTriangleIndices, mGeomStream, filter, mUserParams, mNbTessellation);
+		mCachedShapes.clear();
+		findTouchedGeometry(userData, mCacheBounds, mWorldTriangles, mTriangleIndices, mGeomStream, filter, mUserParams, mNbTessellation, &mCachedShapes);
 
 		mNbCachedStatic = mGeomStream.size();
 		mNbCachedT = mWorldTriangles.size();
@@ -1381,7 +1384,7 @@ void SweepTest::updateTouchedGeoms(	const InternalCBData_FindTouchedGeom* userDa
 		// We can't early exit when no tris are touched since we also have to handle the boxes
 		updateCachedShapesRegistration(0, false);
 
-		findTouchedObstacles(userObstacles, DYNAMIC_BOX);
+		findTouchedObstacles(userData, userObstacles, DYNAMIC_BOX);
 
 		mFlags &= ~STF_FIRST_UPDATE;
 		//printf("CACHEOUTNSDONE=%d\n", mNbCachedStatic);
@@ -2454,55 +2457,28 @@ PxControllerCollisionFlags Controller::move(SweptVolume& volume, const PxVec3& o
 	{
 		obstacles = static_cast<const ObstacleContext*>(obstacleContext);
 
-		// PT: TODO: optimize this
-		const PxU32 nbExtraBoxes = obstacles->mBoxObstacles.size();
-		for(PxU32 i=0;i<nbExtraBoxes;i++)
+		// user obstacles are not copied to the boxes & capsules arrays anymore. They are fetched from the
+		// obstacle context's trees in findTouchedUserObstacles(), only for the region actually touched by the CCT.
+		if(renderBuffer && (debugRenderFlags & PxControllerDebugRenderFlag::eOBSTACLES))
 		{
-			const PxBoxObstacle& userBoxObstacle = obstacles->mBoxObstacles[i].mData;
+			PxRenderOutput out(*renderBuffer);
+			out << gObstacleDebugColor;
 
-			PxExtendedBox extraBox;
-			extraBox.center		= userBoxObstacle.mPos;
-			extraBox.extents	= userBoxObstacle.mHalfExtents;
-			extraBox.rot		= userBoxObstacle.mRot;
-			boxes.pushBack(extraBox);
-
-			const size_t code = encodeUserObject(i, USER_OBJECT_BOX_OBSTACLE);
-			boxUserData.pushBack(reinterpret_cast<const void*>(code));
-
-			if(renderBuffer && (debugRenderFlags & PxControllerDebugRenderFlag::eOBSTACLES))
+			const PxU32 nbExtraBoxes = obstacles->mBoxObstacles.size();
+			for(PxU32 i=0;i<nbExtraBoxes;i++)
 			{
-				PxRenderOutput out(*renderBuffer);
-				out << gObstacleDebugColor;
+				const PxBoxObstacle& userBoxObstacle = obstacles->mBoxObstacles[i].mData;
 
 				out << PxTransform(toVec3(userBoxObstacle.mPos), userBoxObstacle.mRot);
 
 				renderOutputDebugBox(out, PxBounds3(-userBoxObstacle.mHalfExtents, userBoxObstacle.mHalfExtents));
 			}
-		}
 
-		const PxU32 nbExtraCapsules = obstacles->mCapsuleObstacles.size();
-		for(PxU32 i=0;i<nbExtraCapsules;i++)
-		{
-			const PxCapsuleObstacle& userCapsuleObstacle = obstacles->mCapsuleObstacles[i].mData;
-
-			PxExtendedCapsule extraCapsule;
-			const PxVec3 capsuleAxis = userCapsuleObstacle.mRot.getBasisVector0() * userCapsuleObstacle.mHalfHeight;
-			extraCapsule.p0		= PxExtendedVec3(	userCapsuleObstacle.mPos.x - PxExtended(capsuleAxis.x),
-													userCapsuleObstacle.mPos.y - PxExtended(capsuleAxis.y),
-													userCapsuleObstacle.mPos.z - PxExtended(capsuleAxis.z));
-			extraCapsule.p1		= PxExtendedVec3(	userCapsuleObstacle.mPos.x + PxExtended(capsuleAxis.x),
-													userCapsuleObstacle.mPos.y + PxExtended(capsuleAxis.y),
-													userCapsuleObstacle.mPos.z + PxExtended(capsuleAxis.z));
-
-			extraCapsule.radius	= userCapsuleObstacle.mRadius;
-			capsules.pushBack(extraCapsule);
-			const size_t code = encodeUserObject(i, USER_OBJECT_CAPSULE_OBSTACLE);
-			capsuleUserData.pushBack(reinterpret_cast<const void*>(code));
-
-			if(renderBuffer && (debugRenderFlags & PxControllerDebugRenderFlag::eOBSTACLES))
+			const PxU32 nbExtraCapsules = obstacles->mCapsuleObstacles.size();
+			for(PxU32 i=0;i<nbExtraCapsules;i++)
 			{
-				PxRenderOutput out(*renderBuffer);
-				out << gObstacleDebugColor;
+				const PxCapsuleObstacle& userCapsuleObstacle = obstacles->mCapsuleObstacles[i].mData;
+
 				out.outputCapsule(userCapsuleObstacle.mRadius, userCapsuleObstacle.mHalfHeight, PxTransform(toVec3(userCapsuleObstacle.mPos), userCapsuleObstacle.mRot));
 			}
 		}
@@ -2533,6 +2509,8 @@ PxControllerCollisionFlags Controller::move(SweptVolume& volume, const PxVec3& o
 	findGeomData.scene				= mScene;
 	findGeomData.renderBuffer		= renderBuffer;
 	findGeomData.cctShapeHashSet	= &mManager->mCCTShapes;
+	findGeomData.obstacles			= obstacles;
+	findGeomData.triangleCache		= &mManager->mTriangleCache;
 
 	mCctModule.mFlags &= ~STF_WALK_EXPERIMENT;
 
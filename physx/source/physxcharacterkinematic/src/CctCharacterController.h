@@ -258,6 +258,19 @@ namespace Cct
 		const void**				mCapsuleUserData;
 	};
 
+	// a static shape that contributed to the cached geometry. When the scene's static pruning structure changes, these
+	// are compared to the shapes currently touched by the cached volume, and the cache is only rebuilt if they differ.
+	struct CachedShape
+	{
+		const void*		mShape;
+		PxTransform		mPose;
+		PxBounds3		mBounds;
+		const void*		mGeometryData;	// Mesh or heightfield referenced by the geometry, catches a different mesh with the same bounds
+		PxU32			mGeometryType;	// Catches a geometry of another type with the same bounds
+		PxU32			mGeometryStamp;	// Catches heightfield samples modified in place
+	};
+	typedef PxArray<CachedShape>	CachedShapeArray;
+
 	struct InternalCBData_OnHit{};
 	struct InternalCBData_FindTouchedGeom{};
 
@@ -350,10 +363,11 @@ namespace Cct
 													PxU32* nb_collisions, PxF32 min_dist, const PxControllerFilters& filters, SweepPass sweepPass,
 													const PxRigidActor*& touchedActor, const PxShape*& touchedShape, PxU64 contextID);
 
-					void				findTouchedObstacles(const UserObstacles& userObstacles, const PxExtendedBounds3& world_box);
+					void				findTouchedObstacles(const InternalCBData_FindTouchedGeom* userData, const UserObstacles& userObstacles, const PxExtendedBounds3& world_box);
 
 					void				voidTestCache();
 					void				onRelease(const PxBase& observed);
+					void				onShapeChanged(const void* shape);
 					void				updateCachedShapesRegistration(PxU32 startIndex, bool unregister);
 
 		// observer notifications
@@ -398,6 +412,7 @@ namespace Cct
 					PxF32				mVolumeGrowth;		// Must be >1.0f and not too big
 					PxF32				mContactPointHeight;	// UBI
 					PxU32				mSQTimeStamp;
+					CachedShapeArray	mCachedShapes;		// Static shapes touched by mCacheBounds
 					PxU16				mNbFullUpdates;
 					PxU16				mNbPartialUpdates;
 					PxU16				mNbTessellation;
@@ -462,7 +477,18 @@ namespace Cct
 
 		const CCTFilter& filter,
 		const CCTParams& params,
-		PxU16& nbTessellation);
+		PxU16& nbTessellation,
+		CachedShapeArray* cachedShapes = NULL);
+
+	bool touchedGeometryHasChanged(const InternalCBData_FindTouchedGeom* userData,
+		const PxExtendedBounds3& world_aabb,
+		const CCTFilter& filter,
+		const CachedShapeArray& cachedShapes);
+
+	void findTouchedUserObstacles(const InternalCBData_FindTouchedGeom* userData,
+		const PxExtendedBounds3& world_aabb,
+		IntArray& geomStream,
+		const PxExtendedVec3& origin);
 
 	PxU32 shapeHitCallback(const InternalCBData_OnHit* userData, const SweptContact& contact, const PxVec3& dir, PxF32 length);
 	PxU32 userHitCallback(const InternalCBData_OnHit* userData, const SweptContact& contact, const PxVec3& dir, PxF32 length);
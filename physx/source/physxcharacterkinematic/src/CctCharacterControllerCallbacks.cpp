@@ -33,8 +33,10 @@
 #include "geometry/PxTriangleMeshGeometry.h"
 #include "geometry/PxConvexMeshGeometry.h"
 #include "geometry/PxHeightFieldGeometry.h"
+#include "geometry/PxHeightField.h"
 #include "geometry/PxConvexMesh.h"
 #include "geometry/PxMeshQuery.h"
+#include "geometry/PxGeometryQuery.h"
 #include "common/PxRenderBuffer.h"
 #include "common/PxRenderOutput.h"
 #include "foundation/PxMathUtils.h"
@@ -42,6 +44,7 @@
 #include "extensions/PxTriangleMeshExt.h"
 #include "PxScene.h"
 #include "CctInternalStructs.h"
+#include "CctTriangleCache.h"
 #include "GuIntersectionTriangleBox.h"
 #include "CmUtils.h"
 
@@ -503,20 +506,18 @@ static PxU32 createInvisibleWalls(const CCTParams& params, const PxTriangle& cur
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 static void outputMeshToStream(	PxShape* meshShape, const PxRigidActor* actor, const PxTransform& meshPose, IntArray& geomStream, TriArray& worldTriangles, IntArray& triIndicesArray,
-								const PxExtendedVec3& origin, const PxBounds3& tmpBounds, const CCTParams& params, PxRenderBuffer* renderBuffer, PxU16& nbTessellation)
+								const PxExtendedVec3& origin, const PxBounds3& tmpBounds, const CCTParams& params, PxRenderBuffer* renderBuffer, PxU16& nbTessellation, TriangleCache& triangleCache)
 {
 	PX_ASSERT(meshShape->getGeometryType() == PxGeometryType::eTRIANGLEMESH);
 	// Do AABB-mesh query
 
-	PxTriangleMeshGeometry triGeom;
-	meshShape->getTriangleMeshGeometry(triGeom);
-
 	const PxBoxGeometry boxGeom(tmpBounds.getExtents());
 	const PxTransform boxPose(tmpBounds.getCenter());
 
-	// Collide AABB against current mesh
-	PxMeshOverlapUtil overlapUtil;
-	const PxU32 nbTouchedTris = overlapUtil.findOverlap(boxGeom, boxPose, triGeom, meshPose);
+	// Collide AABB against current mesh. Triangles of static meshes are shared with nearby controllers through the manager's cache.
+	PxArray<PxTriangle> touchedTriangles;
+	IntArray touchedIndices;
+	const PxU32 nbTouchedTris = triangleCache.getTriangles(*meshShape, *actor, meshPose, tmpBounds, touchedTriangles, touchedIndices);
 
 	const PxVec3 offset(float(-origin.x), float(-origin.y), float(-origin.z));
 
@@ -528,7 +529,7 @@ static void outputMeshToStream(	PxShape* meshShape, const PxRigidActor* actor, c
 	touchedMesh->mNbTris				= nbTouchedTris;
 	touchedMesh->mIndexWorldTriangles	= worldTriangles.size();
 
-	const PxU32* PX_RESTRICT indices = overlapUtil.getResults();
+	const PxU32* PX_RESTRICT indices = touchedIndices.begin();
 
 	if(params.mSlopeLimit!=0.0f)
 	{
@@ -542,7 +543,7 @@ static void outputMeshToStream(	PxShape* meshShape, const PxRigidActor* actor, c
 
 				// Compute triangle in world space, add to array
 				PxTrianglePadded currentTriangle;
-				PxMeshQuery::getTriangle(triGeom, meshPose, triangleIndex, currentTriangle);
+				static_cast<PxTriangle&>(currentTriangle) = touchedTriangles[i];
 				currentTriangle.verts[0] += offset;
 				currentTriangle.verts[1] += offset;
 				currentTriangle.verts[2] += offset;
@@ -571,7 +572,7 @@ static void outputMeshToStream(	PxShape* meshShape, const PxRigidActor* actor, c
 
 				// Compute triangle in world space, add to array
 				PxTrianglePadded currentTriangle;
-				PxMeshQuery::getTriangle(triGeom, meshPose, triangleIndex, currentTriangle);
+				static_cast<PxTriangle&>(currentTriangle) = touchedTriangles[i];
 				currentTriangle.verts[0] += offset;
 				currentTriangle.verts[1] += offset;
 				currentTriangle.verts[2] += offset;
@@ -606,7 +607,7 @@ static void outputMeshToStream(	PxShape* meshShape, const PxRigidActor* actor, c
 
 				// Compute triangle in world space, add to array
 				PxTriangle& currentTriangle = *TouchedTriangles++;
-				PxMeshQuery::getTriangle(triGeom, meshPose, triangleIndex, currentTriangle);
+				static_cast<PxTriangle&>(currentTriangle) = touchedTriangles[i];
 				currentTriangle.verts[0] += offset;
 				currentTriangle.verts[1] += offset;
 				currentTriangle.verts[2] += offset;
@@ -625,7 +626,7 @@ static void outputMeshToStream(	PxShape* meshShape, const PxRigidActor* actor, c
 
 				// Compute triangle in world space, add to array
 				PxTrianglePadded currentTriangle;
-				PxMeshQuery::getTriangle(triGeom, meshPose, triangleIndex, currentTriangle);
+				static_cast<PxTriangle&>(currentTriangle) = touchedTriangles[i];
 
 				currentTriangle.verts[0] += offset;
 				currentTriangle.verts[1] += offset;
@@ -647,20 +648,18 @@ static void outputMeshToStream(	PxShape* meshShape, const PxRigidActor* actor, c
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 static void outputHeightFieldToStream(	PxShape* hfShape, const PxRigidActor* actor, const PxTransform& heightfieldPose, IntArray& geomStream, TriArray& worldTriangles, IntArray& triIndicesArray,
-										const PxExtendedVec3& origin, const PxBounds3& tmpBounds, const CCTParams& params, PxRenderBuffer* renderBuffer, PxU16& nbTessellation)
+										const PxExtendedVec3& origin, const PxBounds3& tmpBounds, const CCTParams& params, PxRenderBuffer* renderBuffer, PxU16& nbTessellation, TriangleCache& triangleCache)
 {
 	PX_ASSERT(hfShape->getGeometryType() == PxGeometryType::eHEIGHTFIELD);
 	// Do AABB-mesh query
 
-	PxHeightFieldGeometry hfGeom;
-	hfShape->getHeightFieldGeometry(hfGeom);
-
 	const PxBoxGeometry boxGeom(tmpBounds.getExtents());
 	const PxTransform boxPose(tmpBounds.getCenter());
 
-	// Collide AABB against current heightfield
-	PxMeshOverlapUtil overlapUtil;
-	const PxU32 nbTouchedTris = overlapUtil.findOverlap(boxGeom, boxPose, hfGeom, heightfieldPose);
+	// Collide AABB against current heightfield. Triangles of static heightfields are shared with nearby controllers through the manager's cache.
+	PxArray<PxTriangle> touchedTriangles;
+	IntArray touchedIndices;
+	const PxU32 nbTouchedTris = triangleCache.getTriangles(*hfShape, *actor, heightfieldPose, tmpBounds, touchedTriangles, touchedIndices);
 
 	const PxVec3 offset(float(-origin.x), float(-origin.y), float(-origin.z));
 
@@ -672,7 +671,7 @@ static void outputHeightFieldToStream(	PxShape* hfShape, const PxRigidActor* act
 	touchedMesh->mNbTris				= nbTouchedTris;
 	touchedMesh->mIndexWorldTriangles	= worldTriangles.size();
 
-	const PxU32* PX_RESTRICT indices = overlapUtil.getResults();
+	const PxU32* PX_RESTRICT indices = touchedIndices.begin();
 
 	if(params.mSlopeLimit!=0.0f)
 	{
@@ -686,7 +685,7 @@ static void outputHeightFieldToStream(	PxShape* hfShape, const PxRigidActor* act
 
 				// Compute triangle in world space, add to array
 				PxTrianglePadded currentTriangle;
-				PxMeshQuery::getTriangle(hfGeom, heightfieldPose, triangleIndex, currentTriangle);
+				static_cast<PxTriangle&>(currentTriangle) = touchedTriangles[i];
 				currentTriangle.verts[0] += offset;
 				currentTriangle.verts[1] += offset;
 				currentTriangle.verts[2] += offset;
@@ -715,7 +714,7 @@ static void outputHeightFieldToStream(	PxShape* hfShape, const PxRigidActor* act
 
 				// Compute triangle in world space, add to array
 				PxTrianglePadded currentTriangle;
-				PxMeshQuery::getTriangle(hfGeom, heightfieldPose, triangleIndex, currentTriangle);
+				static_cast<PxTriangle&>(currentTriangle) = touchedTriangles[i];
 				currentTriangle.verts[0] += offset;
 				currentTriangle.verts[1] += offset;
 				currentTriangle.verts[2] += offset;
@@ -746,7 +745,7 @@ static void outputHeightFieldToStream(	PxShape* hfShape, const PxRigidActor* act
 
 				// Compute triangle in world space, add to array
 				PxTriangle& currentTriangle = *TouchedTriangles++;
-				PxMeshQuery::getTriangle(hfGeom, heightfieldPose, triangleIndex, currentTriangle);
+				static_cast<PxTriangle&>(currentTriangle) = touchedTriangles[i];
 				currentTriangle.verts[0] += offset;
 				currentTriangle.verts[1] += offset;
 				currentTriangle.verts[2] += offset;
@@ -765,7 +764,7 @@ static void outputHeightFieldToStream(	PxShape* hfShape, const PxRigidActor* act
 
 				// Compute triangle in world space, add to array
 				PxTrianglePadded currentTriangle;
-				PxMeshQuery::getTriangle(hfGeom, heightfieldPose, triangleIndex, currentTriangle);
+				static_cast<PxTriangle&>(currentTriangle) = touchedTriangles[i];
 
 				currentTriangle.verts[0] += offset;
 				currentTriangle.verts[1] += offset;
@@ -924,30 +923,10 @@ PxU32 Cct::getSceneTimestamp(const InternalCBData_FindTouchedGeom* userData)
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void Cct::findTouchedGeometry(
-	const InternalCBData_FindTouchedGeom* userData,
-	const PxExtendedBounds3& worldBounds,		// ### we should also accept other volumes
-
-	TriArray& worldTriangles,
-	IntArray& triIndicesArray,
-	IntArray& geomStream,
-
-	const CCTFilter& filter,
-	const CCTParams& params,
-	PxU16& nbTessellation)
+// overlaps the scene with the given bounds and returns the touched shapes that pass the CCT's own filtering,
+// compacted at the start of the hits buffer.
+static PxU32 overlapTouchedShapes(const PxInternalCBData_FindTouchedGeom* internalData, const PxBounds3& tmpBounds, const CCTFilter& filter, PxOverlapHit* hits, PxU32 size)
 {
-	PX_ASSERT(userData);
-	
-	const PxInternalCBData_FindTouchedGeom* internalData = static_cast<const PxInternalCBData_FindTouchedGeom*>(userData);
-	PxScene* scene = internalData->scene;
-
-	PX_PROFILE_ZONE("CharacterController.findTouchedGeometry", PxU64(scene));
-
-	PxRenderBuffer* renderBuffer = internalData->renderBuffer;
-
-	PxExtendedVec3 Origin;	// Will be TouchedGeom::mOffset
-	getCenter(worldBounds, Origin);
-
 	// Find touched *boxes* i.e. touched objects' AABBs in the world
 	// We collide against dynamic shapes too, to get back dynamic boxes/etc
 	// TODO: add active groups in interface!
@@ -962,22 +941,17 @@ void Cct::findTouchedGeometry(
 			sqFilterFlags |= PxQueryFlag::ePOSTFILTER;
 	}
 
-	// ### this one is dangerous
-	const PxBounds3 tmpBounds(toVec3(worldBounds.minimum), toVec3(worldBounds.maximum));	// LOSS OF ACCURACY
-
 	// PT: unfortunate conversion forced by the PxGeometry API
 	const PxVec3 center = tmpBounds.getCenter();
 	const PxVec3 extents = tmpBounds.getExtents();
 
-	const PxU32 size = 100;
-	PxOverlapHit hits[size];
-
 	PxQueryFilterData sceneQueryFilterData = filter.mFilterData ? PxQueryFilterData(*filter.mFilterData, sqFilterFlags) : PxQueryFilterData(sqFilterFlags);
 
 	PxOverlapBuffer hitBuffer(hits, size);
 	sceneQueryFilterData.flags |= PxQueryFlag::eNO_BLOCK; // fix for DE8255
-	scene->overlap(PxBoxGeometry(extents), PxTransform(center), hitBuffer, sceneQueryFilterData, filter.mFilterCallback);
-	PxU32 numberHits = hitBuffer.getNbAnyHits();
+	internalData->scene->overlap(PxBoxGeometry(extents), PxTransform(center), hitBuffer, sceneQueryFilterData, filter.mFilterCallback);
+	const PxU32 numberHits = hitBuffer.getNbAnyHits();
+	PxU32 nbKept = 0;
 	for(PxU32 i = 0; i < numberHits; i++)
 	{
 		const PxOverlapHit& hit = hitBuffer.getAnyHit(i);
@@ -999,15 +973,93 @@ void Cct::findTouchedGeometry(
 
 		// PT: here you might want to disable kinematic objects.
 
+		hits[nbKept++] = hit;
+	}
+	return nbKept;
+}
+
+static void computeCachedShape(CachedShape& cachedShape, const PxShape& shape, const PxTransform& globalPose)
+{
+	const PxGeometry& geom = shape.getGeometry();
+	const PxGeometryType::Enum type = geom.getType();
+
+	cachedShape.mShape = &shape;
+	cachedShape.mPose = globalPose;
+	PxGeometryQuery::computeGeomBounds(cachedShape.mBounds, geom, globalPose);
+	cachedShape.mGeometryType = PxU32(type);
+	cachedShape.mGeometryStamp = 0;
+	if(type==PxGeometryType::eTRIANGLEMESH)
+		cachedShape.mGeometryData = static_cast<const PxTriangleMeshGeometry&>(geom).triangleMesh;
+	else if(type==PxGeometryType::eHEIGHTFIELD)
+	{
+		const PxHeightField* hf = static_cast<const PxHeightFieldGeometry&>(geom).heightField;
+		cachedShape.mGeometryData = hf;
+		cachedShape.mGeometryStamp = hf->getTimestamp();
+	}
+	else if(type==PxGeometryType::eCONVEXMESH)
+		cachedShape.mGeometryData = static_cast<const PxConvexMeshGeometry&>(geom).convexMesh;
+	else
+		cachedShape.mGeometryData = NULL;
+}
+
+static PX_FORCE_INLINE bool sameCachedShape(const CachedShape& a, const CachedShape& b)
+{
+	return	a.mPose==b.mPose
+		&&	a.mBounds.minimum==b.mBounds.minimum && a.mBounds.maximum==b.mBounds.maximum
+		&&	a.mGeometryType==b.mGeometryType
+		&&	a.mGeometryData==b.mGeometryData
+		&&	a.mGeometryStamp==b.mGeometryStamp;
+}
+
+void Cct::findTouchedGeometry(
+	const InternalCBData_FindTouchedGeom* userData,
+	const PxExtendedBounds3& worldBounds,		// ### we should also accept other volumes
+
+	TriArray& worldTriangles,
+	IntArray& triIndicesArray,
+	IntArray& geomStream,
+
+	const CCTFilter& filter,
+	const CCTParams& params,
+	PxU16& nbTessellation,
+	CachedShapeArray* cachedShapes)
+{
+	PX_ASSERT(userData);
+	
+	const PxInternalCBData_FindTouchedGeom* internalData = static_cast<const PxInternalCBData_FindTouchedGeom*>(userData);
+	PxScene* scene = internalData->scene;
+
+	PX_PROFILE_ZONE("CharacterController.findTouchedGeometry", PxU64(scene));
+
+	PxRenderBuffer* renderBuffer = internalData->renderBuffer;
+
+	PxExtendedVec3 Origin;	// Will be TouchedGeom::mOffset
+	getCenter(worldBounds, Origin);
+
+	// ### this one is dangerous
+	const PxBounds3 tmpBounds(toVec3(worldBounds.minimum), toVec3(worldBounds.maximum));	// LOSS OF ACCURACY
+
+	const PxU32 size = 100;
+	PxOverlapHit hits[size];
+
+	const PxU32 numberHits = overlapTouchedShapes(internalData, tmpBounds, filter, hits, size);
+	for(PxU32 i = 0; i < numberHits; i++)
+	{
+		PxShape* shape = hits[i].shape;
+		PxRigidActor* actor = hits[i].actor;
+
 		// Output shape to stream
 		const PxTransform globalPose = getShapeGlobalPose(*shape, *actor);
 
+		if(cachedShapes)
+			computeCachedShape(cachedShapes->insert(), *shape, globalPose);
+
 		const PxGeometryType::Enum type = shape->getGeometryType();	// ### VIRTUAL!
 		if(type==PxGeometryType::eSPHERE)				outputSphereToStream		(shape, actor, globalPose, geomStream, Origin);
 		else	if(type==PxGeometryType::eCAPSULE)		outputCapsuleToStream		(shape, actor, globalPose, geomStream, Origin);
 		else	if(type==PxGeometryType::eBOX)			outputBoxToStream			(shape, actor, globalPose, geomStream, worldTriangles, triIndicesArray, Origin, tmpBounds, params, nbTessellation);
-		else	if(type==PxGeometryType::eTRIANGLEMESH)	outputMeshToStream			(shape, actor, globalPose, geomStream, worldTriangles, triIndicesArray, Origin, tmpBounds, params, renderBuffer, nbTessellation);
-		else	if(type==PxGeometryType::eHEIGHTFIELD)	outputHeightFieldToStream	(shape, actor, globalPose, geomStream, worldTriangles, triIndicesArray, Origin, tmpBounds, params, renderBuffer, nbTessellation);
+		else	if(type==PxGeometryType::eTRIANGLEMESH)	outputMeshToStream			(shape, actor, globalPose, geomStream, worldTriangles, triIndicesArray, Origin, tmpBounds, params, renderBuffer, nbTessellation, *internalData->triangleCache);
+		else	if(type==PxGeometryType::eHEIGHTFIELD)	outputHeightFieldToStream	(shape, actor, globalPose, geomStream, worldTriangles, triIndicesArray, Origin, tmpBounds, params, renderBuffer, nbTessellation, *internalData->triangleCache);
 		else	if(type==PxGeometryType::eCONVEXMESH)	outputConvexToStream		(shape, actor, globalPose, geomStream, worldTriangles, triIndicesArray, Origin, tmpBounds, params, renderBuffer, nbTessellation);
 		else	if(type==PxGeometryType::ePLANE)		outputPlaneToStream			(shape, actor, globalPose, geomStream, worldTriangles, triIndicesArray, Origin, tmpBounds, params, renderBuffer);
 		else	if(type==PxGeometryType::eCUSTOM)		outputCustomToStream		(shape, actor, globalPose, geomStream, Origin);
@@ -1016,11 +1068,114 @@ void Cct::findTouchedGeometry(
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+bool Cct::touchedGeometryHasChanged(
+	const InternalCBData_FindTouchedGeom* userData,
+	const PxExtendedBounds3& worldBounds,
+	const CCTFilter& filter,
+	const CachedShapeArray& cachedShapes)
+{
+	PX_ASSERT(userData);
+
+	const PxInternalCBData_FindTouchedGeom* internalData = static_cast<const PxInternalCBData_FindTouchedGeom*>(userData);
+
+	PX_PROFILE_ZONE("CharacterController.touchedGeometryHasChanged", PxU64(internalData->scene));
+
+	const PxBounds3 tmpBounds(toVec3(worldBounds.minimum), toVec3(worldBounds.maximum));	// LOSS OF ACCURACY
+
+	const PxU32 size = 100;
+	PxOverlapHit hits[size];
+
+	// a shape is reported at most once by the overlap, so same count + all current shapes found unchanged
+	// in the cached set means both sets are identical.
+	const PxU32 numberHits = overlapTouchedShapes(internalData, tmpBounds, filter, hits, size);
+	const PxU32 nbCached = cachedShapes.size();
+	if(numberHits!=nbCached)
+		return true;
+
+	for(PxU32 i = 0; i < numberHits; i++)
+	{
+		const PxShape* shape = hits[i].shape;
+
+		CachedShape current;
+		computeCachedShape(current, *shape, getShapeGlobalPose(*shape, *hits[i].actor));
+
+		bool found = false;
+		for(PxU32 j = 0; j < nbCached; j++)
+		{
+			if(cachedShapes[j].mShape==shape)
+			{
+				if(!sameCachedShape(cachedShapes[j], current))
+					return true;
+				found = true;
+				break;
+			}
+		}
+		if(!found)
+			return true;
+	}
+	return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 #include "characterkinematic/PxControllerBehavior.h"
 
 #include "CctCharacterControllerManager.h"
 #include "CctObstacleContext.h"
 
+void Cct::findTouchedUserObstacles(const InternalCBData_FindTouchedGeom* userData, const PxExtendedBounds3& worldBounds, IntArray& geomStream, const PxExtendedVec3& origin)
+{
+	PX_ASSERT(userData);
+	const PxInternalCBData_FindTouchedGeom* internalData = static_cast<const PxInternalCBData_FindTouchedGeom*>(userData);
+	const ObstacleContext* obstacles = internalData->obstacles;
+	if(!obstacles)
+		return;
+
+	PX_PROFILE_ZONE("CharacterController.findTouchedUserObstacles", PxU64(internalData->scene));
+
+	IntArray boxIndices;
+	IntArray capsuleIndices;
+	obstacles->findOverlappingObstacles(PxBounds3(toVec3(worldBounds.minimum), toVec3(worldBounds.maximum)), boxIndices, capsuleIndices);	// LOSS OF ACCURACY
+
+	const PxU32 nbBoxes = boxIndices.size();
+	for(PxU32 i=0;i<nbBoxes;i++)
+	{
+		const PxU32 index = boxIndices[i];
+		const PxBoxObstacle& userBoxObstacle = obstacles->mBoxObstacles[index].mData;
+
+		TouchedUserBox* PX_RESTRICT userBox = reinterpret_cast<TouchedUserBox*>(reserveContainerMemory(geomStream, sizeof(TouchedUserBox)/sizeof(PxU32)));
+		userBox->mType			= TouchedGeomType::eUSER_BOX;
+		userBox->mTGUserData	= reinterpret_cast<const void*>(size_t(encodeUserObject(index, USER_OBJECT_BOX_OBSTACLE)));
+		userBox->mActor			= NULL;
+		userBox->mOffset		= origin;
+		userBox->mBox.center	= userBoxObstacle.mPos;
+		userBox->mBox.extents	= userBoxObstacle.mHalfExtents;
+		userBox->mBox.rot		= userBoxObstacle.mRot;
+	}
+
+	const PxU32 nbCapsules = capsuleIndices.size();
+	for(PxU32 i=0;i<nbCapsules;i++)
+	{
+		const PxU32 index = capsuleIndices[i];
+		const PxCapsuleObstacle& userCapsuleObstacle = obstacles->mCapsuleObstacles[index].mData;
+
+		const PxVec3 capsuleAxis = userCapsuleObstacle.mRot.getBasisVector0() * userCapsuleObstacle.mHalfHeight;
+
+		TouchedUserCapsule* PX_RESTRICT userCapsule = reinterpret_cast<TouchedUserCapsule*>(reserveContainerMemory(geomStream, sizeof(TouchedUserCapsule)/sizeof(PxU32)));
+		userCapsule->mType				= TouchedGeomType::eUSER_CAPSULE;
+		userCapsule->mTGUserData		= reinterpret_cast<const void*>(size_t(encodeUserObject(index, USER_OBJECT_CAPSULE_OBSTACLE)));
+		userCapsule->mActor				= NULL;
+		userCapsule->mOffset			= origin;
+		userCapsule->mCapsule.p0		= PxExtendedVec3(	userCapsuleObstacle.mPos.x - PxExtended(capsuleAxis.x),
+															userCapsuleObstacle.mPos.y - PxExtended(capsuleAxis.y),
+															userCapsuleObstacle.mPos.z - PxExtended(capsuleAxis.z));
+		userCapsule->mCapsule.p1		= PxExtendedVec3(	userCapsuleObstacle.mPos.x + PxExtended(capsuleAxis.x),
+															userCapsuleObstacle.mPos.y + PxExtended(capsuleAxis.y),
+															userCapsuleObstacle.mPos.z + PxExtended(capsuleAxis.z));
+		userCapsule->mCapsule.radius	= userCapsuleObstacle.mRadius;
+	}
+}
+
 // #### hmmm, in the down case, isn't reported length too big ? It contains our artificial up component,
 // that might confuse the user
 
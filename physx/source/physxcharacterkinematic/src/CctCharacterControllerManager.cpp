@@ -32,10 +32,14 @@
 #include "CctObstacleContext.h"
 #include "GuDistanceSegmentSegment.h"
 #include "GuDistanceSegmentBox.h"
+#include "GuParallelJobs.h"
 #include "foundation/PxUtilities.h"
 #include "PxRigidDynamic.h"
 #include "PxScene.h"
+#include "PxSceneLock.h"
 #include "PxPhysics.h"
+#include "geometry/PxGeometryQuery.h"
+#include "common/PxProfileZone.h"
 #include "CmRenderBuffer.h"
 #include "CmRadixSort.h"
 
@@ -50,6 +54,7 @@ CharacterControllerManager::CharacterControllerManager(PxScene& scene, bool lock
 	mScene									(scene),
 	mRenderBuffer							(NULL),
 	mDebugRenderingFlags					(0),
+	mTriangleCache							(lockingEnabled),
 	mMaxEdgeLength							(1.0f),
 	mTessellation							(false),
 	mOverlapRecovery						(true),
@@ -215,6 +220,10 @@ void CharacterControllerManager::onRelease(const PxBase* observed, void* , PxDel
 	if(type!=PxConcreteType:: eRIGID_DYNAMIC && type!=PxConcreteType:: eRIGID_STATIC && type!=PxConcreteType::eSHAPE && type!=PxConcreteType::eARTICULATION_LINK)
 		return;
 
+	// the shared triangle cache does not register its shapes, it is purged for all released shapes & statics
+	if(type==PxConcreteType::eSHAPE || type==PxConcreteType::eRIGID_STATIC)
+		mTriangleCache.invalidate(*observed);
+
 	// check if object was registered
 	if(mLockingEnabled)
 		mWriteLock.lock();
@@ -380,11 +389,31 @@ void CharacterControllerManager::shiftOrigin(const PxVec3& shift)
 	if(mRenderBuffer)
 		mRenderBuffer->shift(-shift);
 
+	mTriangleCache.clear();
+
 	// assumption is that these are just used for temporary stuff
 	PX_ASSERT(!mBoxes.size());
 	PX_ASSERT(!mCapsules.size());
 }
 
+void CharacterControllerManager::invalidateShapeCache(const PxShape& shape)
+{
+	mTriangleCache.invalidate(shape);
+
+	const PxU32 size = mControllers.size();
+	for(PxU32 i=0; i<size; i++)
+	{
+		Controller* controller = mControllers[i];
+		if(mLockingEnabled)
+			controller->mWriteLock.lock();
+
+		controller->mCctModule.onShapeChanged(&shape);
+
+		if(mLockingEnabled)
+			controller->mWriteLock.unlock();
+	}
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 static bool computeMTD(PxVec3& mtd, PxF32& depth, const PxVec3& e0, const PxVec3& c0, const PxMat33& r0, const PxVec3& e1, const PxVec3& c1, const PxMat33& r1)
@@ -474,21 +503,23 @@ static PxVec3 fixDir(const PxVec3& dir, const PxVec3& up)
 	return tangentCompo.getNormalized();
 }
 
-static void InteractionCharacterCharacter(Controller* entity0, Controller* entity1, PxF32 elapsedTime)
+// Returns the penetration depth between two characters. The returned direction is the one along which entity0 should be pushed away from entity1.
+static PxF32 computeCharacterCharacterOverlap(PxVec3& dir, const Controller* entity0, const Controller* entity1)
 {
 	PX_ASSERT(entity0);
 	PX_ASSERT(entity1);
 
 	PxF32 overlap=0.0f;
-	PxVec3 dir(0.0f);
+	dir = PxVec3(0.0f);
 
-	if(entity0->mType>entity1->mType)
+	const bool swapped = entity0->mType>entity1->mType;
+	if(swapped)
 		PxSwap(entity0, entity1);
 
 	if(entity0->mType==PxControllerShapeType::eCAPSULE && entity1->mType==PxControllerShapeType::eCAPSULE)
 	{
-		CapsuleController* cc0 = static_cast<CapsuleController*>(entity0);
-		CapsuleController* cc1 = static_cast<CapsuleController*>(entity1);
+		const CapsuleController* cc0 = static_cast<const CapsuleController*>(entity0);
+		const CapsuleController* cc1 = static_cast<const CapsuleController*>(entity1);
 
 		PxExtendedCapsule capsule0;
 		cc0->getCapsule(capsule0);
@@ -516,8 +547,8 @@ static void InteractionCharacterCharacter(Controller* entity0, Controller* entit
 	}
 	else if(entity0->mType==PxControllerShapeType::eBOX && entity1->mType==PxControllerShapeType::eCAPSULE)
 	{
-		BoxController* cc0 = static_cast<BoxController*>(entity0);
-		CapsuleController* cc1 = static_cast<CapsuleController*>(entity1);
+		const BoxController* cc0 = static_cast<const BoxController*>(entity0);
+		const CapsuleController* cc1 = static_cast<const CapsuleController*>(entity1);
 
 		PxExtendedBox obb;
 		cc0->getOBB(obb);
@@ -547,8 +578,8 @@ static void InteractionCharacterCharacter(Controller* entity0, Controller* entit
 	{
 		PX_ASSERT(entity0->mType==PxControllerShapeType::eBOX);
 		PX_ASSERT(entity1->mType==PxControllerShapeType::eBOX);
-		BoxController* cc0 = static_cast<BoxController*>(entity0);
-		BoxController* cc1 = static_cast<BoxController*>(entity1);
+		const BoxController* cc0 = static_cast<const BoxController*>(entity0);
+		const BoxController* cc1 = static_cast<const BoxController*>(entity1);
 
 		PxExtendedBox obb0;
 		cc0->getOBB(obb0);
@@ -575,6 +606,16 @@ static void InteractionCharacterCharacter(Controller* entity0, Controller* entit
 		}
 	}
 
+	if(swapped)
+		dir = -dir;
+
+	return overlap;
+}
+
+static void InteractionCharacterCharacter(Controller* entity0, Controller* entity1, PxF32 elapsedTime)
+{
+	PxVec3 dir;
+	PxF32 overlap = computeCharacterCharacterOverlap(dir, entity0, entity1);
 	if(overlap!=0.0f)
 	{
 		// We want to limit this to some reasonable amount, to avoid obvious "popping".
@@ -676,6 +717,188 @@ void CharacterControllerManager::computeInteractions(PxF32 elapsedTime, PxContro
 	PX_FREE(boxes);
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+	struct OverlapRecoveryJobData
+	{
+		PxScene*					mScene;
+		const PxHashSet<PxShape*>*	mCCTShapes;
+		Controller*const*			mControllers;
+		PxVec3*						mDeltas;
+		PxQueryFilterData			mFilterData;
+		PxQueryFilterCallback*		mFilterCallback;
+		PxU32						mNbControllers;
+		bool						mLockScene;
+	};
+}
+
+static const PxU32 gNbRecoveryTouches = 32;
+static const PxU32 gNbControllersPerRecoveryJob = 16;
+
+// Computes the displacement needed to push a character out of the static and kinematic objects it currently overlaps.
+// This is the batched counterpart of the overlap recovery module's computeMTD(), using a scene query instead of the touched geoms.
+static PxVec3 computeStaticOverlapRecovery(const OverlapRecoveryJobData& data, const Controller& ctrl)
+{
+	const PxF32 contactOffset = ctrl.mUserParams.mContactOffset;
+
+	PxCapsuleGeometry capsuleGeom;
+	PxBoxGeometry boxGeom;
+	const PxGeometry* volumeGeom;
+	if(ctrl.mType==PxControllerShapeType::eCAPSULE)
+	{
+		const CapsuleController& cc = static_cast<const CapsuleController&>(ctrl);
+		capsuleGeom = PxCapsuleGeometry(cc.mRadius+contactOffset, cc.mHeight*0.5f);
+		volumeGeom = &capsuleGeom;
+	}
+	else
+	{
+		PX_ASSERT(ctrl.mType==PxControllerShapeType::eBOX);
+		const BoxController& bc = static_cast<const BoxController&>(ctrl);
+		boxGeom = PxBoxGeometry(PxVec3(bc.mHalfHeight, bc.mHalfSideExtent, bc.mHalfForwardExtent)+PxVec3(contactOffset));
+		volumeGeom = &boxGeom;
+	}
+
+	const PxVec3 initialPos = toVec3(ctrl.mPosition);	// ### LOSS OF ACCURACY
+	PxTransform volumePose(initialPos, ctrl.mUserParams.mQuatFromUp);
+
+	PxOverlapHit touches[gNbRecoveryTouches];
+	PxOverlapBuffer hits(touches, gNbRecoveryTouches);
+	data.mScene->overlap(*volumeGeom, volumePose, hits, data.mFilterData, data.mFilterCallback);
+
+	const PxU32 nbTouches = hits.getNbTouches();
+	for(PxU32 i=0;i<nbTouches;i++)
+	{
+		PxShape* touchedShape = touches[i].shape;
+		const PxRigidActor* touchedActor = touches[i].actor;
+
+		// skip the characters' own kinematic actors, they are handled by the character-character pass
+		if(data.mCCTShapes->contains(touchedShape) || !shouldApplyRecoveryModule(*touchedActor))
+			continue;
+
+		PxVec3 mtd;
+		PxF32 depth;
+		if(PxGeometryQuery::computePenetration(mtd, depth, *volumeGeom, volumePose, touchedShape->getGeometry(), getShapeGlobalPose(*touchedShape, *touchedActor)))
+			volumePose.p += mtd * depth;
+	}
+	return volumePose.p - initialPos;
+}
+
+static void overlapRecoveryJob(void* userData, PxU32 jobIndex)
+{
+	const OverlapRecoveryJobData& data = *reinterpret_cast<const OverlapRecoveryJobData*>(userData);
+
+	const PxU32 start = jobIndex * gNbControllersPerRecoveryJob;
+	const PxU32 end = PxMin(start + gNbControllersPerRecoveryJob, data.mNbControllers);
+
+	PxSceneWorkerReadLock lock(*data.mScene, data.mLockScene, PX_FL);
+
+	for(PxU32 i=start;i<end;i++)
+		data.mDeltas[i] = computeStaticOverlapRecovery(data, *data.mControllers[i]);
+}
+
+PxU32 CharacterControllerManager::recoverFromOverlaps(const PxControllerFilters& filters, PxCpuDispatcher* dispatcher, PxU32 maxIterations)
+{
+	PX_PROFILE_ZONE("CharacterControllerManager.recoverFromOverlaps", PxU64(&mScene));
+
+	const PxU32 nbControllers = mControllers.size();
+	if(!nbControllers)
+		return 0;
+
+	PxArray<PxVec3> deltas(nbControllers);
+	PxArray<PxBounds3> boxes(nbControllers);
+	PxArray<bool> moved(nbControllers, false);
+	PxArray<PxU32> pairs;
+
+	// touches only, we need all the overlapped objects. Blocking hits returned by the user's filter are reported as touches.
+	const PxQueryFlags queryFlags = (filters.mFilterFlags & (PxQueryFlag::eSTATIC|PxQueryFlag::eDYNAMIC|PxQueryFlag::ePREFILTER|PxQueryFlag::ePOSTFILTER)) | PxQueryFlag::eNO_BLOCK;
+
+	OverlapRecoveryJobData data;
+	data.mScene				= &mScene;
+	data.mCCTShapes			= &mCCTShapes;
+	data.mControllers		= mControllers.begin();
+	data.mDeltas			= deltas.begin();
+	data.mFilterData		= PxQueryFilterData(filters.mFilterData ? *filters.mFilterData : PxFilterData(), queryFlags);
+	data.mFilterCallback	= filters.mFilterCallback;
+	data.mNbControllers		= nbControllers;
+	data.mLockScene			= PxSceneWorkerReadLock::isRequired(mScene);
+
+	const PxU32 nbJobs = (nbControllers + gNbControllersPerRecoveryJob - 1) / gNbControllersPerRecoveryJob;
+
+	for(PxU32 iter=0;iter<maxIterations;iter++)
+	{
+		// all characters are pushed out of static objects in parallel, from their positions at the end of the previous pass.
+		Gu::runJobs(dispatcher, overlapRecoveryJob, &data, nbJobs);
+
+		// character-character overlaps use the same positions, and are accumulated serially so that results are deterministic.
+		for(PxU32 i=0;i<nbControllers;i++)
+		{
+			PxExtendedBounds3 extBox;
+			mControllers[i]->getWorldBox(extBox);
+			boxes[i] = PxBounds3(toVec3(extBox.minimum), toVec3(extBox.maximum));	// ### LOSS OF ACCURACY
+		}
+
+		completeBoxPruning(boxes.begin(), nbControllers, pairs);
+
+		PxU32 nbPairs = pairs.size()>>1;
+		const PxU32* indices = pairs.begin();
+		while(nbPairs--)
+		{
+			const PxU32 index0 = *indices++;
+			const PxU32 index1 = *indices++;
+			Controller* ctrl0 = mControllers[index0];
+			Controller* ctrl1 = mControllers[index1];
+
+			if(filters.mCCTFilterCallback && !filters.mCCTFilterCallback->filter(*ctrl0->getPxController(), *ctrl1->getPxController()))
+				continue;
+
+			PxVec3 dir;
+			const PxF32 overlap = computeCharacterCharacterOverlap(dir, ctrl0, ctrl1);
+			if(overlap!=0.0f)
+			{
+				const PxVec3 sep = dir * overlap * 0.5f;
+				deltas[index0] += sep;
+				deltas[index1] -= sep;
+			}
+		}
+
+		// then all characters are moved at once. The queries above took their own read locks, so the write lock needed
+		// to update the kinematic actors is only taken here.
+		if(data.mLockScene)
+			mScene.lockWrite(PX_FL);
+
+		bool hasMoved = false;
+		for(PxU32 i=0;i<nbControllers;i++)
+		{
+			if(isAlmostZero(deltas[i]))
+				continue;
+
+			Controller* ctrl = mControllers[i];
+			PxExtendedVec3 newPos = ctrl->mPosition;
+			newPos += deltas[i];
+			ctrl->getPxController()->setPosition(newPos);
+
+			moved[i] = true;
+			hasMoved = true;
+		}
+
+		if(data.mLockScene)
+			mScene.unlockWrite();
+
+		if(!hasMoved)
+			break;
+	}
+
+	PxU32 nbMoved = 0;
+	for(PxU32 i=0;i<nbControllers;i++)
+	{
+		if(moved[i])
+			nbMoved++;
+	}
+	return nbMoved;
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //Public factory methods
 
@@ -40,6 +40,7 @@
 #include "characterkinematic/PxControllerObstacles.h"
 #include "PxDeletionListener.h"
 #include "CctUtils.h"
+#include "CctTriangleCache.h"
 #include "foundation/PxMutex.h"
 #include "foundation/PxArray.h"
 #include "foundation/PxUserAllocated.h"
@@ -88,6 +89,8 @@ namespace Cct
 		virtual			void							setPreciseSweeps(bool flag)	PX_OVERRIDE;
 		virtual			void							setPreventVerticalSlidingAgainstCeiling(bool flag)	PX_OVERRIDE;
 		virtual			void							shiftOrigin(const PxVec3& shift)	PX_OVERRIDE;
+		virtual			void							invalidateShapeCache(const PxShape& shape)	PX_OVERRIDE;
+		virtual			PxU32							recoverFromOverlaps(const PxControllerFilters& filters, PxCpuDispatcher* dispatcher, PxU32 maxIterations)	PX_OVERRIDE;
 		//~PxControllerManager
 
 		// PxDeletionListener
@@ -122,6 +125,8 @@ namespace Cct
 
 						PxArray<ObstacleContext*>		mObstacleContexts;
 
+						TriangleCache					mTriangleCache;
+
 						float							mMaxEdgeLength;
 						bool							mTessellation;
 
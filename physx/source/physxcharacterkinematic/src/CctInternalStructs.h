@@ -38,6 +38,7 @@ namespace physx
 namespace Cct
 {
 	class ObstacleContext;
+	class TriangleCache;
 
 	enum UserObjectType
 	{
@@ -77,6 +78,8 @@ namespace Cct
 		PxRenderBuffer*			renderBuffer;	// Render buffer from controller manager, not the one from the scene
 
 		PxHashSet<PxShape*>*	cctShapeHashSet;
+		const ObstacleContext*	obstacles;		// User obstacles, culled through the obstacle context's trees
+		TriangleCache*			triangleCache;	// Mesh & heightfield triangles shared by the manager's controllers
 	};
 }
 }
@@ -30,6 +30,8 @@
 #include "CctObstacleContext.h"
 #include "CctCharacterControllerManager.h"
 #include "foundation/PxUtilities.h"
+#include "foundation/PxInlineArray.h"
+#include "foundation/PxMat33.h"
 
 using namespace physx;
 using namespace Cct;
@@ -202,6 +204,244 @@ static PX_FORCE_INLINE PxU32 decodeIndex(ObstacleHandle handle)
 }
 #endif
 
+ObstacleTree::ObstacleTree()
+{
+}
+
+ObstacleTree::~ObstacleTree()
+{
+	mTree.release();
+}
+
+void ObstacleTree::updateMapping(PxU32 index, Gu::IncrementalAABBTreeNode* node)
+{
+	// same as IncrementalAABBPrunerCore::updateMapping. Splitting or rotating the tree moves other objects to new leaves.
+	if(!mChangedLeaves.empty())
+	{
+		if(node && node->isLeaf())
+		{
+			for(PxU32 j=0; j<node->getNbPrimitives(); j++)
+				mMapping[node->getPrimitives(NULL)[j]] = node;
+		}
+
+		for(PxU32 i=0; i<mChangedLeaves.size(); i++)
+		{
+			Gu::IncrementalAABBTreeNode* changedNode = mChangedLeaves[i];
+			PX_ASSERT(changedNode->isLeaf());
+
+			for(PxU32 j=0; j<changedNode->getNbPrimitives(); j++)
+				mMapping[changedNode->getPrimitives(NULL)[j]] = changedNode;
+		}
+	}
+	else
+	{
+		PX_ASSERT(node->isLeaf());
+		mMapping[index] = node;
+	}
+}
+
+void ObstacleTree::addObject(PxU32 index, const PxBounds3& bounds)
+{
+	PX_ASSERT(index==mBounds.size());
+	PX_UNUSED(index);
+	mBounds.pushBack(bounds);
+	// the tree uses V4LoadU on the bounds' maximum, which reads one float past the last entry
+	if(mBounds.size()==mBounds.capacity())
+		mBounds.reserve(mBounds.size()*2);
+	mMapping.pushBack(NULL);
+
+	mChangedLeaves.clear();
+	Gu::IncrementalAABBTreeNode* node = mTree.insert(index, mBounds.begin(), mChangedLeaves);
+	updateMapping(index, node);
+}
+
+void ObstacleTree::updateObject(PxU32 index, const PxBounds3& bounds)
+{
+	PX_ASSERT(index<mBounds.size());
+	mBounds[index] = bounds;
+
+	Gu::IncrementalAABBTreeNode* oldNode = mMapping[index];
+	mChangedLeaves.clear();
+	Gu::IncrementalAABBTreeNode* node = mTree.updateFast(oldNode, index, mBounds.begin(), mChangedLeaves);
+	if(!mChangedLeaves.empty() || node!=oldNode)
+		updateMapping(index, node);
+}
+
+void ObstacleTree::removeObject(PxU32 index)
+{
+	PX_ASSERT(index<mBounds.size());
+
+	Gu::IncrementalAABBTreeNode* node = mTree.remove(mMapping[index], index, mBounds.begin());
+	if(node && node->isLeaf())
+	{
+		for(PxU32 j=0; j<node->getNbPrimitives(); j++)
+			mMapping[node->getPrimitives(NULL)[j]] = node;
+	}
+
+	// mirror replaceWithLast() on the obstacle array: the last object takes the removed object's index
+	const PxU32 lastIndex = mBounds.size() - 1;
+	if(index!=lastIndex)
+	{
+		Gu::IncrementalAABBTreeNode* lastNode = mMapping[lastIndex];
+		mTree.fixupTreeIndices(lastNode, lastIndex, index);
+		mMapping[index] = lastNode;
+		mBounds[index] = mBounds[lastIndex];
+	}
+	mMapping.popBack();
+	mBounds.popBack();
+}
+
+void ObstacleTree::shiftOrigin(const PxVec3& shift)
+{
+	mTree.shiftOrigin(shift);
+
+	const PxU32 nbObjects = mBounds.size();
+	for(PxU32 i=0; i<nbObjects; i++)
+	{
+		mBounds[i].minimum -= shift;
+		mBounds[i].maximum -= shift;
+	}
+}
+
+static PX_FORCE_INLINE void getNodeBounds(const Gu::IncrementalAABBTreeNode* node, PxVec3& minimum, PxVec3& maximum)
+{
+	V3StoreU(Vec3V_From_Vec4V(node->mBVMin), minimum);
+	V3StoreU(Vec3V_From_Vec4V(node->mBVMax), maximum);
+}
+
+void ObstacleTree::overlap(const PxBounds3& bounds, PxArray<PxU32>& indices) const
+{
+	const Gu::IncrementalAABBTreeNode* root = mTree.getNodes();
+	if(!root)
+		return;
+
+	PxInlineArray<const Gu::IncrementalAABBTreeNode*, 64> stack;
+	stack.pushBack(root);
+	while(stack.size())
+	{
+		const Gu::IncrementalAABBTreeNode* node = stack.popBack();
+
+		PxBounds3 nodeBounds;
+		getNodeBounds(node, nodeBounds.minimum, nodeBounds.maximum);
+		if(!nodeBounds.intersects(bounds))
+			continue;
+
+		if(node->isLeaf())
+		{
+			const PxU32* primitives = node->getPrimitives(NULL);
+			const PxU32 nbPrimitives = node->getNbPrimitives();
+			for(PxU32 i=0; i<nbPrimitives; i++)
+			{
+				if(mBounds[primitives[i]].intersects(bounds))
+					indices.pushBack(primitives[i]);
+			}
+		}
+		else
+		{
+			stack.pushBack(node->getPos(node));
+			stack.pushBack(node->getNeg(node));
+		}
+	}
+}
+
+// Slab test. Returns the entry distance along the ray in 'enter'.
+static bool intersectRayBounds(const PxVec3& origin, const PxVec3& unitDir, const PxVec3& minimum, const PxVec3& maximum, PxReal maxDist, PxReal& enter)
+{
+	PxReal tMin = 0.0f;
+	PxReal tMax = maxDist;
+	for(PxU32 axis=0; axis<3; axis++)
+	{
+		if(PxAbs(unitDir[axis])<1e-9f)
+		{
+			if(origin[axis]<minimum[axis] || origin[axis]>maximum[axis])
+				return false;
+		}
+		else
+		{
+			const PxReal invDir = 1.0f/unitDir[axis];
+			PxReal t0 = (minimum[axis] - origin[axis]) * invDir;
+			PxReal t1 = (maximum[axis] - origin[axis]) * invDir;
+			if(t0>t1)
+				PxSwap(t0, t1);
+			tMin = PxMax(tMin, t0);
+			tMax = PxMin(tMax, t1);
+			if(tMin>tMax)
+				return false;
+		}
+	}
+	enter = tMin;
+	return true;
+}
+
+template<class Processor>
+void ObstacleTree::raycast(const PxVec3& origin, const PxVec3& unitDir, PxReal maxDist, Processor& processor) const
+{
+	const Gu::IncrementalAABBTreeNode* root = mTree.getNodes();
+	if(!root)
+		return;
+
+	struct StackEntry
+	{
+		const Gu::IncrementalAABBTreeNode*	mNode;
+		PxReal								mEnter;
+	};
+
+	PxVec3 minimum, maximum;
+	StackEntry entry;
+	getNodeBounds(root, minimum, maximum);
+	if(!intersectRayBounds(origin, unitDir, minimum, maximum, maxDist, entry.mEnter))
+		return;
+	entry.mNode = root;
+
+	PxInlineArray<StackEntry, 64> stack;
+	stack.pushBack(entry);
+	while(stack.size())
+	{
+		const StackEntry current = stack.popBack();
+		// the processor may have shrunk maxDist since this node was pushed
+		if(current.mEnter>maxDist)
+			continue;
+
+		const Gu::IncrementalAABBTreeNode* node = current.mNode;
+		if(node->isLeaf())
+		{
+			const PxU32* primitives = node->getPrimitives(NULL);
+			const PxU32 nbPrimitives = node->getNbPrimitives();
+			for(PxU32 i=0; i<nbPrimitives; i++)
+				processor.invoke(primitives[i], maxDist);
+		}
+		else
+		{
+			StackEntry children[2];
+			PxU32 nbChildren = 0;
+			for(PxU32 j=0; j<2; j++)
+			{
+				const Gu::IncrementalAABBTreeNode* child = j ? node->getNeg(node) : node->getPos(node);
+				getNodeBounds(child, minimum, maximum);
+				if(intersectRayBounds(origin, unitDir, minimum, maximum, maxDist, children[nbChildren].mEnter))
+					children[nbChildren++].mNode = child;
+			}
+
+			// push the farthest child first so that the closest one is visited first
+			if(nbChildren==2 && children[0].mEnter<children[1].mEnter)
+				PxSwap(children[0], children[1]);
+			for(PxU32 j=0; j<nbChildren; j++)
+				stack.pushBack(children[j]);
+		}
+	}
+}
+
+static PxBounds3 computeObstacleBounds(const PxBoxObstacle& obstacle)
+{
+	return PxBounds3::basisExtent(toVec3(obstacle.mPos), PxMat33(obstacle.mRot), obstacle.mHalfExtents);	// LOSS OF ACCURACY
+}
+
+static PxBounds3 computeObstacleBounds(const PxCapsuleObstacle& obstacle)
+{
+	const PxVec3 capsuleAxis = obstacle.mRot.getBasisVector0() * obstacle.mHalfHeight;
+	return PxBounds3::centerExtents(toVec3(obstacle.mPos), capsuleAxis.abs() + PxVec3(obstacle.mRadius));	// LOSS OF ACCURACY
+}
+
 ObstacleContext::ObstacleContext(CharacterControllerManager& cctMan)
 	: mCCTManager(cctMan)
 {
@@ -233,6 +473,7 @@ PxObstacleHandle ObstacleContext::addObstacle(const PxObstacle& obstacle)
 		const PxObstacleHandle handle = encodeHandle(index, type);
 #endif
 		mBoxObstacles.pushBack(InternalBoxObstacle(handle, static_cast<const PxBoxObstacle&>(obstacle)));
+		mBoxTree.addObject(index, computeObstacleBounds(mBoxObstacles[index].mData));
 		mCCTManager.onObstacleAdded(handle, this);
 		return handle;
 	}
@@ -245,6 +486,7 @@ PxObstacleHandle ObstacleContext::addObstacle(const PxObstacle& obstacle)
 		const PxObstacleHandle handle = encodeHandle(index, type);
 #endif
 		mCapsuleObstacles.pushBack(InternalCapsuleObstacle(handle, static_cast<const PxCapsuleObstacle&>(obstacle)));
+		mCapsuleTree.addObject(index, computeObstacleBounds(mCapsuleObstacles[index].mData));
 		mCCTManager.onObstacleAdded(handle, this);
 		return handle;
 	}
@@ -289,6 +531,7 @@ bool ObstacleContext::removeObstacle(PxObstacleHandle handle)
 		remove<InternalBoxObstacle>(mHandleManager, object, handle, index, size, mBoxObstacles);
 #endif
 		mBoxObstacles.replaceWithLast(index);
+		mBoxTree.removeObject(index);
 #ifdef NEW_ENCODING
 		mCCTManager.onObstacleRemoved(handle);
 #else
@@ -308,6 +551,7 @@ bool ObstacleContext::removeObstacle(PxObstacleHandle handle)
 #endif
 
 		mCapsuleObstacles.replaceWithLast(index);
+		mCapsuleTree.removeObject(index);
 #ifdef NEW_ENCODING
 		mCCTManager.onObstacleRemoved(handle);
 #else
@@ -345,6 +589,7 @@ bool ObstacleContext::updateObstacle(PxObstacleHandle handle, const PxObstacle&
 			return false;
 
 		mBoxObstacles[index].mData = static_cast<const PxBoxObstacle&>(obstacle);
+		mBoxTree.updateObject(index, computeObstacleBounds(mBoxObstacles[index].mData));
 		mCCTManager.onObstacleUpdated(handle,this);
 		return true;
 	}
@@ -356,6 +601,7 @@ bool ObstacleContext::updateObstacle(PxObstacleHandle handle, const PxObstacle&
 			return false;
 
 		mCapsuleObstacles[index].mData = static_cast<const PxCapsuleObstacle&>(obstacle);
+		mCapsuleTree.updateObject(index, computeObstacleBounds(mCapsuleObstacles[index].mData));
 		mCCTManager.onObstacleUpdated(handle,this);
 		return true;
 	}
@@ -417,65 +663,86 @@ const PxObstacle* ObstacleContext::getObstacleByHandle(PxObstacleHandle handle)
 #include "geometry/PxBoxGeometry.h"
 #include "geometry/PxCapsuleGeometry.h"
 using namespace Gu;
-const PxObstacle* ObstacleContext::raycastSingle(PxGeomRaycastHit& hit, const PxVec3& origin, const PxVec3& unitDir, const PxReal distance, PxObstacleHandle& obstacleHandle) const
+static PX_FORCE_INLINE PxBoxGeometry getObstacleGeometry(const PxBoxObstacle& obstacle)
 {
-	PxGeomRaycastHit localHit;
-	PxF32 t = FLT_MAX;
-	const PxObstacle* touchedObstacle = NULL;
+	return PxBoxGeometry(obstacle.mHalfExtents);
+}
 
-	const PxHitFlags hitFlags = PxHitFlags(0);
+static PX_FORCE_INLINE PxCapsuleGeometry getObstacleGeometry(const PxCapsuleObstacle& obstacle)
+{
+	return PxCapsuleGeometry(obstacle.mRadius, obstacle.mHalfHeight);
+}
 
+namespace
+{
+	// Raycasts the obstacles reported by the tree and keeps the closest hit. The tree stops visiting nodes farther than that hit.
+	template<class InternalObstacle>
+	struct ObstacleRaycastProcessor
 	{
-		const RaycastFunc raycastFunc = Gu::getRaycastFuncTable()[PxGeometryType::eBOX];
-		PX_ASSERT(raycastFunc);
-
-		const PxU32 nbExtraBoxes = mBoxObstacles.size();
-		for(PxU32 i=0;i<nbExtraBoxes;i++)
+		ObstacleRaycastProcessor(const PxArray<InternalObstacle>& obstacles, PxGeometryType::Enum type, const PxVec3& origin, const PxVec3& unitDir,
+									PxGeomRaycastHit& hit, PxObstacleHandle& obstacleHandle, const PxObstacle*& touchedObstacle, PxReal& closest) :
+			mObstacles		(obstacles),
+			mRaycastFunc	(Gu::getRaycastFuncTable()[type]),
+			mOrigin			(origin),
+			mUnitDir		(unitDir),
+			mHit			(hit),
+			mObstacleHandle	(obstacleHandle),
+			mTouchedObstacle(touchedObstacle),
+			mClosest		(closest)
 		{
-			const PxBoxObstacle& userBoxObstacle = mBoxObstacles[i].mData;
-
-			PxU32 status = raycastFunc(	PxBoxGeometry(userBoxObstacle.mHalfExtents),
-										PxTransform(toVec3(userBoxObstacle.mPos), userBoxObstacle.mRot),
-										origin, unitDir, distance,
-										hitFlags,
-										1, &localHit, sizeof(PxGeomRaycastHit), UNUSED_RAYCAST_THREAD_CONTEXT);
-			if(status && localHit.distance<t)
-			{
-				t = localHit.distance;
-				hit = localHit;
-				obstacleHandle = mBoxObstacles[i].mHandle;
-				touchedObstacle = &userBoxObstacle;
-			}
+			PX_ASSERT(mRaycastFunc);
 		}
-	}
 
-	{
-		const RaycastFunc raycastFunc = Gu::getRaycastFuncTable()[PxGeometryType::eCAPSULE];
-		PX_ASSERT(raycastFunc);
-
-		const PxU32 nbExtraCapsules = mCapsuleObstacles.size();
-		for(PxU32 i=0;i<nbExtraCapsules;i++)
+		void	invoke(PxU32 index, PxReal& maxDist)
 		{
-			const PxCapsuleObstacle& userCapsuleObstacle = mCapsuleObstacles[i].mData;
-
-			PxU32 status = raycastFunc(	PxCapsuleGeometry(userCapsuleObstacle.mRadius, userCapsuleObstacle.mHalfHeight),
-										PxTransform(toVec3(userCapsuleObstacle.mPos), userCapsuleObstacle.mRot),
-										origin, unitDir, distance,
-										hitFlags,
-										1, &localHit, sizeof(PxGeomRaycastHit), UNUSED_RAYCAST_THREAD_CONTEXT);
-			if(status && localHit.distance<t)
+			const InternalObstacle& obstacle = mObstacles[index];
+
+			PxGeomRaycastHit localHit;
+			const PxU32 status = mRaycastFunc(	getObstacleGeometry(obstacle.mData),
+												PxTransform(toVec3(obstacle.mData.mPos), obstacle.mData.mRot),
+												mOrigin, mUnitDir, maxDist,
+												PxHitFlags(0),
+												1, &localHit, sizeof(PxGeomRaycastHit), UNUSED_RAYCAST_THREAD_CONTEXT);
+			if(status && localHit.distance<mClosest)
 			{
-				t = localHit.distance;
-				hit = localHit;
-				obstacleHandle = mCapsuleObstacles[i].mHandle;
-				touchedObstacle = &userCapsuleObstacle;
+				mClosest = localHit.distance;
+				maxDist = localHit.distance;
+				mHit = localHit;
+				mObstacleHandle = obstacle.mHandle;
+				mTouchedObstacle = &obstacle.mData;
 			}
 		}
+
+		const PxArray<InternalObstacle>&	mObstacles;
+		const RaycastFunc					mRaycastFunc;
+		const PxVec3						mOrigin;
+		const PxVec3						mUnitDir;
+		PxGeomRaycastHit&					mHit;
+		PxObstacleHandle&					mObstacleHandle;
+		const PxObstacle*&					mTouchedObstacle;
+		PxReal&								mClosest;
+
+		PX_NOCOPY(ObstacleRaycastProcessor)
+	};
+}
+
+const PxObstacle* ObstacleContext::raycastSingle(PxGeomRaycastHit& hit, const PxVec3& origin, const PxVec3& unitDir, const PxReal distance, PxObstacleHandle& obstacleHandle) const
+{
+	const PxObstacle* touchedObstacle = NULL;
+
+	// boxes first then capsules, like the previous brute-force loops. The closest box hit bounds the capsule query.
+	PxReal closest = PX_MAX_F32;
+	{
+		ObstacleRaycastProcessor<InternalBoxObstacle> processor(mBoxObstacles, PxGeometryType::eBOX, origin, unitDir, hit, obstacleHandle, touchedObstacle, closest);
+		mBoxTree.raycast(origin, unitDir, distance, processor);
+	}
+	{
+		ObstacleRaycastProcessor<InternalCapsuleObstacle> processor(mCapsuleObstacles, PxGeometryType::eCAPSULE, origin, unitDir, hit, obstacleHandle, touchedObstacle, closest);
+		mCapsuleTree.raycast(origin, unitDir, PxMin(distance, closest), processor);
 	}
 	return touchedObstacle;
 }
 
-
 const PxObstacle* ObstacleContext::raycastSingle(PxGeomRaycastHit& hit, const PxObstacleHandle& obstacleHandle, const PxVec3& origin, const PxVec3& unitDir, const PxReal distance) const
 {	
 	const PxHitFlags hitFlags = PxHitFlags(0);
@@ -533,4 +800,13 @@ void ObstacleContext::onOriginShift(const PxVec3& shift)
 
 	for(PxU32 i=0; i < mCapsuleObstacles.size(); i++)
 		mCapsuleObstacles[i].mData.mPos -= shift;
+
+	mBoxTree.shiftOrigin(shift);
+	mCapsuleTree.shiftOrigin(shift);
+}
+
+void ObstacleContext::findOverlappingObstacles(const PxBounds3& bounds, PxArray<PxU32>& boxIndices, PxArray<PxU32>& capsuleIndices) const
+{
+	mBoxTree.overlap(bounds, boxIndices);
+	mCapsuleTree.overlap(bounds, capsuleIndices);
 }
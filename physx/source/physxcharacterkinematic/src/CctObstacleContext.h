@@ -35,6 +35,7 @@
 #include "characterkinematic/PxControllerObstacles.h"
 #include "foundation/PxUserAllocated.h"
 #include "foundation/PxArray.h"
+#include "GuIncrementalAABBTree.h"
 
 namespace physx
 {
@@ -79,6 +80,38 @@ namespace Cct
 						bool		SetupLists(void** objects=NULL, PxU16* oti=NULL, PxU16* ito=NULL, PxU16* stamps=NULL);
 	};
 
+	// Incremental AABB tree over the obstacles of one type. Tree primitives are indices in the matching obstacle
+	// array, and removals mirror that array's replaceWithLast() so that indices stay in sync.
+	class ObstacleTree
+	{
+		public:
+												ObstacleTree();
+												~ObstacleTree();
+
+				void							addObject(PxU32 index, const PxBounds3& bounds);
+				void							updateObject(PxU32 index, const PxBounds3& bounds);
+				void							removeObject(PxU32 index);
+				void							shiftOrigin(const PxVec3& shift);
+
+				// Appends the indices of all objects whose bounds overlap the query box.
+				void							overlap(const PxBounds3& bounds, PxArray<PxU32>& indices)	const;
+
+				// Calls processor.invoke(index, maxDist) for each object whose bounds are hit by the ray, closest
+				// nodes first. The processor can shrink maxDist to cull the remaining nodes.
+				template<class Processor>
+				void							raycast(const PxVec3& origin, const PxVec3& unitDir, PxReal maxDist, Processor& processor)	const;
+
+		PX_FORCE_INLINE	PxU32					getNbObjects()	const	{ return mBounds.size();	}
+
+		private:
+				void							updateMapping(PxU32 index, Gu::IncrementalAABBTreeNode* node);
+
+				Gu::IncrementalAABBTree			mTree;
+				PxArray<PxBounds3>				mBounds;		// Object bounds, indexed like the obstacle array
+				PxArray<Gu::IncrementalAABBTreeNode*>	mMapping;		// Object index to tree leaf
+				Gu::NodeList					mChangedLeaves;
+	};
+
 	class ObstacleContext : public PxObstacleContext, public PxUserAllocated
 	{
 		public:
@@ -101,6 +134,9 @@ namespace Cct
 
 				void							onOriginShift(const PxVec3& shift);
 
+				// Tree-based culling. Appends the indices (in mBoxObstacles and mCapsuleObstacles) of the obstacles whose bounds overlap the query box.
+				void							findOverlappingObstacles(const PxBounds3& bounds, PxArray<PxU32>& boxIndices, PxArray<PxU32>& capsuleIndices)	const;
+
 				struct InternalBoxObstacle
 				{
 					InternalBoxObstacle(PxObstacleHandle handle, const PxBoxObstacle& data) : mHandle(handle), mData(data)	{}
@@ -122,6 +158,8 @@ namespace Cct
 	private:
 				ObstacleContext&				operator=(const ObstacleContext&);
 				HandleManager					mHandleManager;
+				ObstacleTree					mBoxTree;
+				ObstacleTree					mCapsuleTree;
 				CharacterControllerManager&		mCCTManager;
 	};
 
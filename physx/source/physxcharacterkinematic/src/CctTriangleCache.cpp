@@ -0,0 +1,319 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2023 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "CctTriangleCache.h"
+#include "geometry/PxTriangleMeshGeometry.h"
+#include "geometry/PxHeightFieldGeometry.h"
+#include "geometry/PxHeightField.h"
+#include "geometry/PxBoxGeometry.h"
+#include "geometry/PxMeshQuery.h"
+#include "extensions/PxTriangleMeshExt.h"
+#include "PxShape.h"
+#include "PxRigidActor.h"
+
+using namespace physx;
+using namespace Cct;
+
+// each entry can hold a few thousand triangles, so we keep a small number of them and evict the least recently used one
+static const PxU32 gMaxNbEntries = 64;
+
+namespace
+{
+	// Everything the extracted triangles depend on, apart from the extraction region
+	struct GeometrySignature
+	{
+		PxTransform		mPose;
+		const void*		mData;			// Triangle mesh or heightfield
+		PxVec3			mScale;			// Mesh scale, or heightfield height / row / column scales
+		PxQuat			mScaleRotation;
+		PxU32			mStamp;			// Heightfield timestamp, bumped by modifySamples()
+
+		PX_FORCE_INLINE	bool	operator==(const GeometrySignature& other)	const
+		{
+			return mPose==other.mPose && mData==other.mData && mScale==other.mScale && mScaleRotation==other.mScaleRotation && mStamp==other.mStamp;
+		}
+	};
+}
+
+struct TriangleCache::Entry : public PxUserAllocated
+{
+	const PxShape*			mShape;
+	const PxRigidActor*		mActor;
+	PxI32					mRegion[6];		// Extraction region, in cells
+	PxI32					mLevel;			// Cell size is 2^mLevel
+	GeometrySignature		mSignature;
+	PxU32					mLastUse;
+	PxArray<PxTriangle>		mTriangles;
+	PxArray<PxU32>			mIndices;
+};
+
+static bool computeSignature(const PxShape& shape, const PxTransform& shapePose, GeometrySignature& signature)
+{
+	const PxGeometry& geom = shape.getGeometry();
+	signature.mPose = shapePose;
+	if(geom.getType()==PxGeometryType::eTRIANGLEMESH)
+	{
+		const PxTriangleMeshGeometry& meshGeom = static_cast<const PxTriangleMeshGeometry&>(geom);
+		signature.mData				= meshGeom.triangleMesh;
+		signature.mScale			= meshGeom.scale.scale;
+		signature.mScaleRotation	= meshGeom.scale.rotation;
+		signature.mStamp			= 0;
+		return true;
+	}
+	else if(geom.getType()==PxGeometryType::eHEIGHTFIELD)
+	{
+		const PxHeightFieldGeometry& hfGeom = static_cast<const PxHeightFieldGeometry&>(geom);
+		signature.mData				= hfGeom.heightField;
+		signature.mScale			= PxVec3(hfGeom.heightScale, hfGeom.rowScale, hfGeom.columnScale);
+		signature.mScaleRotation	= PxQuat(PxIdentity);
+		signature.mStamp			= hfGeom.heightField->getTimestamp();
+		return true;
+	}
+	return false;
+}
+
+// the cell size is the smallest power of two above half the largest dimension of the query bounds. The region is then
+// at most one cell larger than the bounds on each side, and controllers of similar sizes standing close to each other end
+// up using the same region.
+static bool computeRegion(const PxBounds3& bounds, PxI32* region, PxI32& level)
+{
+	if(!bounds.isFinite() || bounds.isEmpty())
+		return false;
+
+	const float halfSize = PxMax(bounds.getDimensions().maxElement()*0.5f, 1e-3f);
+	float cellSize = 1.0f;
+	level = 0;
+	while(cellSize<halfSize)
+	{
+		cellSize *= 2.0f;
+		level++;
+	}
+	while(cellSize*0.5f>=halfSize)
+	{
+		cellSize *= 0.5f;
+		level--;
+	}
+
+	const float invCellSize = 1.0f/cellSize;
+	for(PxU32 i=0;i<3;i++)
+	{
+		const float lo = PxFloor(bounds.minimum[i]*invCellSize);
+		const float hi = PxCeil(bounds.maximum[i]*invCellSize);
+		if(PxAbs(lo)>1e9f || PxAbs(hi)>1e9f)
+			return false;
+		region[i]	= PxI32(lo);
+		region[i+3]	= PxI32(hi);
+	}
+	return true;
+}
+
+static PxU32 extractTriangles(const PxShape& shape, const PxTransform& shapePose, const PxBounds3& regionBounds, PxArray<PxTriangle>& triangles, PxArray<PxU32>& indices)
+{
+	const PxBoxGeometry boxGeom(regionBounds.getExtents());
+	const PxTransform boxPose(regionBounds.getCenter());
+
+	const PxGeometry& geom = shape.getGeometry();
+
+	PxMeshOverlapUtil overlapUtil;
+	PxU32 nbTouchedTris;
+	if(geom.getType()==PxGeometryType::eTRIANGLEMESH)
+		nbTouchedTris = overlapUtil.findOverlap(boxGeom, boxPose, static_cast<const PxTriangleMeshGeometry&>(geom), shapePose);
+	else
+		nbTouchedTris = overlapUtil.findOverlap(boxGeom, boxPose, static_cast<const PxHeightFieldGeometry&>(geom), shapePose);
+
+	const PxU32* PX_RESTRICT results = overlapUtil.getResults();
+
+	const PxU32 start = triangles.size();
+	triangles.resize(start + nbTouchedTris);
+	indices.resize(start + nbTouchedTris);
+	for(PxU32 i=0;i<nbTouchedTris;i++)
+	{
+		if(geom.getType()==PxGeometryType::eTRIANGLEMESH)
+			PxMeshQuery::getTriangle(static_cast<const PxTriangleMeshGeometry&>(geom), shapePose, results[i], triangles[start+i]);
+		else
+			PxMeshQuery::getTriangle(static_cast<const PxHeightFieldGeometry&>(geom), shapePose, results[i], triangles[start+i]);
+		indices[start+i] = results[i];
+	}
+	return nbTouchedTris;
+}
+
+static PX_FORCE_INLINE bool sameRegion(const PxI32* region0, const PxI32* region1)
+{
+	return region0[0]==region1[0] && region0[1]==region1[1] && region0[2]==region1[2]
+		&& region0[3]==region1[3] && region0[4]==region1[4] && region0[5]==region1[5];
+}
+
+// only output the triangles whose bounds touch the query box. The region can be much larger than the box.
+static void outputTriangles(const PxArray<PxTriangle>& cachedTriangles, const PxArray<PxU32>& cachedIndices, const PxBounds3& bounds, PxArray<PxTriangle>& triangles, PxArray<PxU32>& indices)
+{
+	const PxU32 nbTris = cachedTriangles.size();
+	for(PxU32 i=0;i<nbTris;i++)
+	{
+		const PxTriangle& tri = cachedTriangles[i];
+		const PxVec3 minimum = tri.verts[0].minimum(tri.verts[1].minimum(tri.verts[2]));
+		const PxVec3 maximum = tri.verts[0].maximum(tri.verts[1].maximum(tri.verts[2]));
+		if(!bounds.intersects(PxBounds3(minimum, maximum)))
+			continue;
+
+		triangles.pushBack(tri);
+		indices.pushBack(cachedIndices[i]);
+	}
+}
+
+TriangleCache::TriangleCache(bool lockingEnabled) : mTimestamp(0), mLockingEnabled(lockingEnabled)
+{
+}
+
+TriangleCache::~TriangleCache()
+{
+	clear();
+}
+
+PxU32 TriangleCache::getTriangles(const PxShape& shape, const PxRigidActor& actor, const PxTransform& shapePose, const PxBounds3& bounds,
+								PxArray<PxTriangle>& triangles, PxArray<PxU32>& indices)
+{
+	PX_ASSERT(shape.getGeometryType()==PxGeometryType::eTRIANGLEMESH || shape.getGeometryType()==PxGeometryType::eHEIGHTFIELD);
+
+	// dynamic actors move every frame, caching their triangles would be a waste of time
+	GeometrySignature signature;
+	PxI32 region[6];
+	PxI32 level;
+	if(actor.getConcreteType()!=PxConcreteType::eRIGID_STATIC || !computeSignature(shape, shapePose, signature) || !computeRegion(bounds, region, level))
+		return extractTriangles(shape, shapePose, bounds, triangles, indices);
+
+	const PxU32 nbInitialTris = triangles.size();
+
+	if(mLockingEnabled)
+		mMutex.lock();
+
+	mTimestamp++;
+
+	// linear search is fine for the small number of entries we keep
+	const PxU32 nbEntries = mEntries.size();
+	for(PxU32 i=0;i<nbEntries;i++)
+	{
+		Entry* entry = mEntries[i];
+		if(entry->mShape!=&shape || entry->mLevel!=level || !sameRegion(entry->mRegion, region))
+			continue;
+
+		if(entry->mSignature==signature)
+		{
+			entry->mLastUse = mTimestamp;
+			outputTriangles(entry->mTriangles, entry->mIndices, bounds, triangles, indices);
+
+			if(mLockingEnabled)
+				mMutex.unlock();
+			return triangles.size() - nbInitialTris;
+		}
+
+		// the shape moved or its geometry changed, the entry is stale
+		PX_DELETE(entry);
+		mEntries.replaceWithLast(i);
+		break;
+	}
+
+	if(mLockingEnabled)
+		mMutex.unlock();
+
+	// extract outside of the lock so that other controllers are not blocked meanwhile
+	Entry* entry = PX_NEW(Entry);
+	entry->mShape		= &shape;
+	entry->mActor		= &actor;
+	PxMemCopy(entry->mRegion, region, sizeof(PxI32)*6);
+	entry->mLevel		= level;
+	entry->mSignature	= signature;
+
+	const float cellSize = PxPow(2.0f, float(level));
+	const PxVec3 regionMin = PxVec3(float(region[0]), float(region[1]), float(region[2]))*cellSize;
+	const PxVec3 regionMax = PxVec3(float(region[3]), float(region[4]), float(region[5]))*cellSize;
+	const PxBounds3 regionBounds(regionMin, regionMax);
+	extractTriangles(shape, shapePose, regionBounds, entry->mTriangles, entry->mIndices);
+
+	outputTriangles(entry->mTriangles, entry->mIndices, bounds, triangles, indices);
+
+	if(mLockingEnabled)
+		mMutex.lock();
+
+	entry->mLastUse = ++mTimestamp;
+	if(mEntries.size()<gMaxNbEntries)
+	{
+		mEntries.pushBack(entry);
+	}
+	else
+	{
+		PxU32 oldest = 0;
+		for(PxU32 i=1;i<mEntries.size();i++)
+		{
+			if(mEntries[i]->mLastUse<mEntries[oldest]->mLastUse)
+				oldest = i;
+		}
+		PX_DELETE(mEntries[oldest]);
+		mEntries[oldest] = entry;
+	}
+
+	if(mLockingEnabled)
+		mMutex.unlock();
+
+	return triangles.size() - nbInitialTris;
+}
+
+void TriangleCache::invalidate(const PxBase& object)
+{
+	if(mLockingEnabled)
+		mMutex.lock();
+
+	PxU32 i = 0;
+	while(i<mEntries.size())
+	{
+		Entry* entry = mEntries[i];
+		if(static_cast<const PxBase*>(entry->mShape)==&object || static_cast<const PxBase*>(entry->mActor)==&object)
+		{
+			PX_DELETE(entry);
+			mEntries.replaceWithLast(i);
+		}
+		else
+			i++;
+	}
+
+	if(mLockingEnabled)
+		mMutex.unlock();
+}
+
+void TriangleCache::clear()
+{
+	if(mLockingEnabled)
+		mMutex.lock();
+
+	const PxU32 nbEntries = mEntries.size();
+	for(PxU32 i=0;i<nbEntries;i++)
+		PX_DELETE(mEntries[i]);
+	mEntries.clear();
+
+	if(mLockingEnabled)
+		mMutex.unlock();
+}
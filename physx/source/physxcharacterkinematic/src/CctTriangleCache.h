@@ -0,0 +1,83 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2023 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef CCT_TRIANGLE_CACHE
+#define CCT_TRIANGLE_CACHE
+
+/* Exclude from documentation */
+/** \cond */
+
+#include "geometry/PxTriangle.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxBounds3.h"
+#include "foundation/PxTransform.h"
+#include "foundation/PxMutex.h"
+#include "foundation/PxUserAllocated.h"
+
+namespace physx
+{
+	class PxBase;
+	class PxShape;
+	class PxRigidActor;
+
+namespace Cct
+{
+	// Cache of world-space triangles extracted from static triangle meshes and heightfields, shared by all the
+	// controllers of a manager. Triangles are extracted lazily, for a grid-aligned region enclosing the query
+	// bounds, so that controllers querying nearby regions reuse the same extraction instead of redoing it.
+	class TriangleCache : public PxUserAllocated
+	{
+		public:
+									TriangleCache(bool lockingEnabled);
+									~TriangleCache();
+
+		// Appends to 'triangles' and 'indices' the world-space triangles of a mesh or heightfield shape touched by 'bounds',
+		// and returns their number. Static shapes use a cached extraction when their pose and geometry did not change since,
+		// other shapes are queried directly.
+				PxU32				getTriangles(const PxShape& shape, const PxRigidActor& actor, const PxTransform& shapePose, const PxBounds3& bounds,
+												PxArray<PxTriangle>& triangles, PxArray<PxU32>& indices);
+
+		// Discards the cached triangles of a shape, or of all the shapes of an actor.
+				void				invalidate(const PxBase& object);
+				void				clear();
+
+		private:
+				struct Entry;
+
+				PxArray<Entry*>		mEntries;
+				PxU32				mTimestamp;		// Incremented for each lookup, used to evict the least recently used entry
+				PxMutex				mMutex;
+				bool				mLockingEnabled;
+	};
+
+} // namespace Cct
+
+}
+
+/** \endcond */
+#endif
@@ -31,6 +31,7 @@
 #define CCT_UTILS
 
 #include "extensions/PxShapeExt.h"
+#include "PxRigidBody.h"
 #include "characterkinematic/PxExtended.h"
 
 namespace physx
@@ -61,6 +62,21 @@ PX_FORCE_INLINE bool isAlmostZero(const PxVec3& v)
 	return true;
 }
 
+PX_INLINE bool shouldApplyRecoveryModule(const PxRigidActor& rigidActor)
+{
+	// PT: we must let the dynamic objects go through the CCT for proper 2-way interactions.
+	// But we should still apply the recovery module for kinematics.
+
+	const PxType type = rigidActor.getConcreteType();
+	if(type==PxConcreteType::eRIGID_STATIC)
+		return true;
+
+	if(type!=PxConcreteType::eRIGID_DYNAMIC)
+		return false;
+
+	return static_cast<const PxRigidBody&>(rigidActor).getRigidBodyFlags() & PxRigidBodyFlag::eKINEMATIC;
+}
+
 
 #ifdef PX_BIG_WORLDS
 
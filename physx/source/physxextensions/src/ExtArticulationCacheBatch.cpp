@@ -0,0 +1,350 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2023 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "extensions/PxArticulationCacheBatch.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxAtomic.h"
+#include "foundation/PxSync.h"
+#include "foundation/PxUserAllocated.h"
+#include "task/PxTask.h"
+#include "PxScene.h"
+
+using namespace physx;
+
+namespace
+{
+	class ArticulationCacheBatch;
+
+	class ArticulationCacheGatherTask : public PxLightCpuTask
+	{
+	public:
+										ArticulationCacheGatherTask() : mBatch(NULL), mStart(0), mEnd(0)	{}
+
+		virtual			void			run()	PX_OVERRIDE;
+		virtual			void			release()	PX_OVERRIDE;
+		virtual			const char*		getName()	const	PX_OVERRIDE	{ return "ArticulationCacheBatch.gather";	}
+
+						ArticulationCacheBatch*	mBatch;
+						PxU32					mStart;
+						PxU32					mEnd;
+	};
+
+	class ArticulationCacheBatch : public PxArticulationCacheBatch, public PxUserAllocated
+	{
+																PX_NOCOPY(ArticulationCacheBatch)
+	public:
+																ArticulationCacheBatch(PxCpuDispatcher* dispatcher, PxU32 batchSize);
+		virtual													~ArticulationCacheBatch();
+
+						bool									init(PxArticulationReducedCoordinate*const* articulations, PxU32 nbArticulations);
+
+		// PxArticulationCacheBatch
+		virtual			void									release()											PX_OVERRIDE	{ PX_DELETE_THIS;					}
+		virtual			PxU32									getNbArticulations()						const	PX_OVERRIDE	{ return mArticulations.size();		}
+		virtual			PxArticulationReducedCoordinate*		getArticulation(PxU32 index)				const	PX_OVERRIDE	{ return mArticulations[index];		}
+		virtual			PxU32									getDofStride()								const	PX_OVERRIDE	{ return mDofStride;				}
+		virtual			PxU32									getLinkStride()								const	PX_OVERRIDE	{ return mLinkStride;				}
+		virtual			PxU32									getSensorStride()							const	PX_OVERRIDE	{ return mSensorStride;				}
+		virtual			void									copyInternalStateToTensors(const PxArticulationCacheTensors& tensors, PxArticulationCacheFlags flags, const PxU32* indices, PxU32 nbIndices)	PX_OVERRIDE;
+		virtual			void									applyTensors(const PxArticulationCacheTensors& tensors, PxArticulationCacheFlags flags, bool autowake, const PxU32* indices, PxU32 nbIndices)	PX_OVERRIDE;
+		//~PxArticulationCacheBatch
+
+						void									gather(PxU32 start, PxU32 end);
+		PX_FORCE_INLINE	void									taskDone()
+																{
+																	if(!PxAtomicDecrement(&mNbPendingTasks))
+																		mSync.set();
+																}
+	private:
+						PxArray<PxArticulationReducedCoordinate*>	mArticulations;
+						PxArray<PxArticulationCache*>			mCaches;
+						PxCpuDispatcher*						mDispatcher;
+						PxTaskManager*							mTaskManager;
+						ArticulationCacheGatherTask*			mTasks;
+						PxU32									mNbTasks;
+						PxU32									mBatchSize;
+						PxU32									mDofStride;
+						PxU32									mLinkStride;
+						PxU32									mSensorStride;
+						PxSync									mSync;
+						volatile PxI32							mNbPendingTasks;
+
+						// Parameters of the gather in flight
+						PxArticulationCacheTensors				mTensors;
+						PxArticulationCacheFlags				mFlags;
+						const PxU32*							mIndices;
+
+						bool									checkTensors(const PxArticulationCacheTensors& tensors, PxArticulationCacheFlags flags, const PxU32* indices, PxU32 nbIndices, const char* function)	const;
+						void									setupView(PxArticulationCache& view, const PxArticulationCacheTensors& tensors, PxU32 index)	const;
+	};
+}
+
+void ArticulationCacheGatherTask::run()
+{
+	mBatch->gather(mStart, mEnd);
+}
+
+void ArticulationCacheGatherTask::release()
+{
+	ArticulationCacheBatch* batch = mBatch;
+	PxLightCpuTask::release();
+	batch->taskDone();
+}
+
+ArticulationCacheBatch::ArticulationCacheBatch(PxCpuDispatcher* dispatcher, PxU32 batchSize) :
+	mDispatcher		(dispatcher),
+	mTaskManager	(NULL),
+	mTasks			(NULL),
+	mNbTasks		(0),
+	mBatchSize		(PxMax(batchSize, 1u)),
+	mDofStride		(0),
+	mLinkStride		(0),
+	mSensorStride	(0),
+	mNbPendingTasks	(0),
+	mIndices		(NULL)
+{
+}
+
+ArticulationCacheBatch::~ArticulationCacheBatch()
+{
+	const PxU32 nb = mCaches.size();
+	for(PxU32 i=0;i<nb;i++)
+		mCaches[i]->release();
+
+	for(PxU32 i=0;i<mNbTasks;i++)
+		mTasks[i].~ArticulationCacheGatherTask();
+	PX_FREE(mTasks);
+
+	PX_RELEASE(mTaskManager);
+}
+
+bool ArticulationCacheBatch::init(PxArticulationReducedCoordinate*const* articulations, PxU32 nbArticulations)
+{
+	mArticulations.reserve(nbArticulations);
+	mCaches.reserve(nbArticulations);
+	for(PxU32 i=0;i<nbArticulations;i++)
+	{
+		PxArticulationReducedCoordinate* articulation = articulations[i];
+		PxArticulationCache* cache = articulation->createCache();
+		if(!cache)
+			return false;
+
+		mArticulations.pushBack(articulation);
+		mCaches.pushBack(cache);
+
+		mDofStride = PxMax(mDofStride, articulation->getDofs());
+		mLinkStride = PxMax(mLinkStride, articulation->getNbLinks());
+		mSensorStride = PxMax(mSensorStride, articulation->getNbSensors());
+	}
+
+	if(!mDispatcher)
+		mDispatcher = articulations[0]->getScene()->getCpuDispatcher();
+
+	if(mDispatcher && nbArticulations > mBatchSize)
+	{
+		mTaskManager = PxTaskManager::createTaskManager(*PxGetErrorCallback(), mDispatcher);
+		if(!mTaskManager)
+			return false;
+
+		mNbTasks = (nbArticulations + mBatchSize - 1) / mBatchSize;
+		mTasks = PX_ALLOCATE(ArticulationCacheGatherTask, mNbTasks, "ArticulationCacheGatherTask");
+		for(PxU32 i=0;i<mNbTasks;i++)
+		{
+			PX_PLACEMENT_NEW(mTasks + i, ArticulationCacheGatherTask)();
+			mTasks[i].mBatch = this;
+		}
+	}
+	return true;
+}
+
+bool ArticulationCacheBatch::checkTensors(const PxArticulationCacheTensors& tensors, PxArticulationCacheFlags flags, const PxU32* indices, PxU32 nbIndices, const char* function) const
+{
+#if PX_CHECKED
+	struct Local
+	{
+		static PX_FORCE_INLINE bool isMissing(PxArticulationCacheFlags flags, PxArticulationCacheFlag::Enum flag, const void* buffer)
+		{
+			return (flags & flag) && !buffer;
+		}
+	};
+
+	if(	Local::isMissing(flags, PxArticulationCacheFlag::eVELOCITY, tensors.jointVelocity)
+	||	Local::isMissing(flags, PxArticulationCacheFlag::eACCELERATION, tensors.jointAcceleration)
+	||	Local::isMissing(flags, PxArticulationCacheFlag::ePOSITION, tensors.jointPosition)
+	||	Local::isMissing(flags, PxArticulationCacheFlag::eFORCE, tensors.jointForce)
+	||	Local::isMissing(flags, PxArticulationCacheFlag::eJOINT_SOLVER_FORCES, tensors.jointSolverForces)
+	||	Local::isMissing(flags, PxArticulationCacheFlag::eLINK_VELOCITY, tensors.linkVelocity)
+	||	Local::isMissing(flags, PxArticulationCacheFlag::eLINK_ACCELERATION, tensors.linkAcceleration)
+	||	Local::isMissing(flags, PxArticulationCacheFlag::eROOT_TRANSFORM, tensors.rootLinkData)
+	||	Local::isMissing(flags, PxArticulationCacheFlag::eROOT_VELOCITIES, tensors.rootLinkData)
+	||	Local::isMissing(flags, PxArticulationCacheFlag::eSENSOR_FORCES, tensors.sensorForces))
+		return PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "%s: missing tensor for requested cache flags.", function);
+
+	if(indices)
+	{
+		const PxU32 nbArticulations = mArticulations.size();
+		for(PxU32 i=0;i<nbIndices;i++)
+		{
+			if(indices[i] >= nbArticulations)
+				return PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "%s: articulation index out of bounds.", function);
+		}
+	}
+#else
+	PX_UNUSED(tensors);
+	PX_UNUSED(flags);
+	PX_UNUSED(indices);
+	PX_UNUSED(nbIndices);
+	PX_UNUSED(function);
+#endif
+	return true;
+}
+
+// The view is a shallow copy of the articulation's own cache (so that the version & scratch data are valid) whose
+// data pointers are redirected to the rows of the user tensors. The low-level copy functions then read/write the
+// tensors directly.
+void ArticulationCacheBatch::setupView(PxArticulationCache& view, const PxArticulationCacheTensors& tensors, PxU32 index) const
+{
+	view = *mCaches[index];
+
+	const PxU32 dofOffset = index * mDofStride;
+	const PxU32 linkOffset = index * mLinkStride;
+
+	if(tensors.jointVelocity)
+		view.jointVelocity = tensors.jointVelocity + dofOffset;
+	if(tensors.jointAcceleration)
+		view.jointAcceleration = tensors.jointAcceleration + dofOffset;
+	if(tensors.jointPosition)
+		view.jointPosition = tensors.jointPosition + dofOffset;
+	if(tensors.jointForce)
+		view.jointForce = tensors.jointForce + dofOffset;
+	if(tensors.jointSolverForces)
+		view.jointSolverForces = tensors.jointSolverForces + dofOffset;
+	if(tensors.linkVelocity)
+		view.linkVelocity = tensors.linkVelocity + linkOffset;
+	if(tensors.linkAcceleration)
+		view.linkAcceleration = tensors.linkAcceleration + linkOffset;
+	if(tensors.rootLinkData)
+		view.rootLinkData = tensors.rootLinkData + index;
+	if(tensors.sensorForces)
+		view.sensorForces = tensors.sensorForces + index * mSensorStride;
+}
+
+void ArticulationCacheBatch::gather(PxU32 start, PxU32 end)
+{
+	PxArticulationCache view;
+	for(PxU32 i=start;i<end;i++)
+	{
+		const PxU32 index = mIndices ? mIndices[i] : i;
+		setupView(view, mTensors, index);
+		mArticulations[index]->copyInternalStateToCache(view, mFlags);
+	}
+}
+
+void ArticulationCacheBatch::copyInternalStateToTensors(const PxArticulationCacheTensors& tensors, PxArticulationCacheFlags flags, const PxU32* indices, PxU32 nbIndices)
+{
+	if(!checkTensors(tensors, flags, indices, nbIndices, "PxArticulationCacheBatch::copyInternalStateToTensors"))
+		return;
+
+	const PxU32 nbToProcess = indices ? nbIndices : mArticulations.size();
+
+	mTensors = tensors;
+	mFlags = flags;
+	mIndices = indices;
+
+	const PxU32 nbTasks = PxMin((nbToProcess + mBatchSize - 1) / mBatchSize, mNbTasks);
+	if(nbTasks < 2)
+	{
+		gather(0, nbToProcess);
+	}
+	else
+	{
+		// Spread the work evenly over the tasks, the first ones taking one more articulation if needed
+		const PxU32 nbPerTask = nbToProcess / nbTasks;
+		PxU32 remainder = nbToProcess - nbPerTask * nbTasks;
+
+		mSync.reset();
+		mNbPendingTasks = PxI32(nbTasks);
+
+		PxU32 start = 0;
+		for(PxU32 i=0;i<nbTasks;i++)
+		{
+			ArticulationCacheGatherTask& task = mTasks[i];
+			const PxU32 nb = nbPerTask + (remainder ? 1u : 0u);
+			if(remainder)
+				remainder--;
+			task.mStart = start;
+			task.mEnd = start + nb;
+			start += nb;
+
+			task.setContinuation(*mTaskManager, NULL);
+		}
+		PX_ASSERT(start == nbToProcess);
+
+		for(PxU32 i=0;i<nbTasks;i++)
+			mTasks[i].removeReference();
+
+		mSync.wait();
+	}
+
+	mIndices = NULL;
+}
+
+void ArticulationCacheBatch::applyTensors(const PxArticulationCacheTensors& tensors, PxArticulationCacheFlags flags, bool autowake, const PxU32* indices, PxU32 nbIndices)
+{
+	if(!checkTensors(tensors, flags, indices, nbIndices, "PxArticulationCacheBatch::applyTensors"))
+		return;
+
+	// applyCache touches scene-level data (wake counters, active lists, shape bounds) so this part is not multithreaded.
+	const PxU32 nbToProcess = indices ? nbIndices : mArticulations.size();
+	PxArticulationCache view;
+	for(PxU32 i=0;i<nbToProcess;i++)
+	{
+		const PxU32 index = indices ? indices[i] : i;
+		setupView(view, tensors, index);
+		mArticulations[index]->applyCache(view, flags, autowake);
+	}
+}
+
+PxArticulationCacheBatch* physx::PxCreateArticulationCacheBatch(PxArticulationReducedCoordinate*const* articulations, PxU32 nbArticulations, PxCpuDispatcher* dispatcher, PxU32 batchSize)
+{
+	PX_CHECK_AND_RETURN_NULL(articulations && nbArticulations, "PxCreateArticulationCacheBatch: invalid articulation array");
+#if PX_CHECKED
+	for(PxU32 i=0;i<nbArticulations;i++)
+	{
+		PX_CHECK_AND_RETURN_NULL(articulations[i] && articulations[i]->getScene(), "PxCreateArticulationCacheBatch: articulations must be in a scene");
+	}
+#endif
+
+	ArticulationCacheBatch* batch = PX_NEW(ArticulationCacheBatch)(dispatcher, batchSize);
+	if(!batch->init(articulations, nbArticulations))
+	{
+		PX_DELETE(batch);
+		return NULL;
+	}
+	return batch;
+}
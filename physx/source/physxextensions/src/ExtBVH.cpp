@@ -0,0 +1,87 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2023 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "extensions/PxBVHExt.h"
+#include "foundation/PxAtomic.h"
+#include "GuParallelJobs.h"
+
+using namespace physx;
+
+namespace
+{
+	struct FrustaCullData
+	{
+		const PxBVH*			mBVH;
+		const PxBVH::Frustum*	mFrusta;
+		PxU32*					mIndices;
+		PxU32*					mNbIndices;
+		PxU32					mNbFrusta;
+		PxU32					mMaxNbIndices;
+		PxU32					mNbFrustaPerTask;
+		PxGeometryQueryFlags	mQueryFlags;
+		volatile PxI32			mOverflow;
+	};
+}
+
+static void frustaCullJob(void* userData, PxU32 jobIndex)
+{
+	FrustaCullData& data = *reinterpret_cast<FrustaCullData*>(userData);
+
+	const PxU32 start = jobIndex * data.mNbFrustaPerTask;
+	const PxU32 nb = PxMin(data.mNbFrustaPerTask, data.mNbFrusta - start);
+	if(!data.mBVH->cullFrusta(nb, data.mFrusta + start, data.mMaxNbIndices, data.mIndices + start * data.mMaxNbIndices, data.mNbIndices + start, data.mQueryFlags))
+		PxAtomicExchange(&data.mOverflow, 1);
+}
+
+bool PxBVHExt::cullFrusta(	const PxBVH& bvh, PxU32 nbFrusta, const PxBVH::Frustum* frusta, PxU32 maxNbIndicesPerFrustum, PxU32* indices, PxU32* nbIndices,
+							PxCpuDispatcher* dispatcher, PxU32 nbFrustaPerTask, PxGeometryQueryFlags queryFlags)
+{
+	PX_CHECK_AND_RETURN_VAL(!nbFrusta || (frusta && nbIndices), "PxBVHExt::cullFrusta: invalid frusta or output buffers", false);
+	PX_CHECK_AND_RETURN_VAL(!nbFrusta || !maxNbIndicesPerFrustum || indices, "PxBVHExt::cullFrusta: invalid output buffer", false);
+
+	nbFrustaPerTask = PxMax(nbFrustaPerTask, 1u);
+
+	const PxU32 nbChunks = (nbFrusta + nbFrustaPerTask - 1) / nbFrustaPerTask;
+	if(!dispatcher || nbChunks < 2)
+		return bvh.cullFrusta(nbFrusta, frusta, maxNbIndicesPerFrustum, indices, nbIndices, queryFlags);
+
+	FrustaCullData data;
+	data.mBVH				= &bvh;
+	data.mFrusta			= frusta;
+	data.mIndices			= indices;
+	data.mNbIndices			= nbIndices;
+	data.mNbFrusta			= nbFrusta;
+	data.mMaxNbIndices		= maxNbIndicesPerFrustum;
+	data.mNbFrustaPerTask	= nbFrustaPerTask;
+	data.mQueryFlags		= queryFlags;
+	data.mOverflow			= 0;
+
+	Gu::runJobs(dispatcher, frustaCullJob, &data, nbChunks);
+
+	return data.mOverflow == 0;
+}
@@ -0,0 +1,624 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2023 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "extensions/PxSceneQueryExt.h"
+#include "extensions/PxShapeExt.h"
+#include "geometry/PxGeometryQuery.h"
+#include "geometry/PxGeometryHelpers.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxSort.h"
+#include "foundation/PxUserAllocated.h"
+#include "task/PxCpuDispatcher.h"
+#include "PxRigidActor.h"
+#include "PxShape.h"
+#include "PxSceneLock.h"
+#include "GuParallelJobs.h"
+
+using namespace physx;
+
+namespace
+{
+	struct SweepQuery
+	{
+		PxGeometryHolder	geometry;
+		PxTransform			pose;
+		PxVec3				unitDir;
+		PxReal				distance;
+		PxHitFlags			hitFlags;
+		PxQueryFilterData	filterData;
+		PxReal				inflation;
+		PxBounds3			sweptBounds;
+	};
+
+	// Results of a sweep, written by the task processing its cluster. The touches live in that task's scratch.
+	struct SweepResult
+	{
+		PxSweepHit	block;
+		PxU32		taskIndex;
+		PxU32		touchOffset;
+		PxU32		nbTouches;
+		bool		hasBlock;
+	};
+
+	struct SortedSweep
+	{
+		PxU64	key;
+		PxU32	index;
+
+		PX_FORCE_INLINE	bool	operator<(const SortedSweep& other)	const	{ return key < other.key;	}
+	};
+
+	struct Cluster
+	{
+		PxBounds3	bounds;
+		PxU32		start;	// first sweep in the sorted array
+		PxU32		count;
+	};
+
+	struct Candidate
+	{
+		PxTransform				pose;
+		PxBounds3				bounds;
+		const PxShape*			shape;
+		const PxRigidActor*		actor;
+		PxGeometryType::Enum	type;
+	};
+
+	struct CandidateTypeLess
+	{
+		PX_FORCE_INLINE	bool	operator()(const Candidate& a, const Candidate& b)	const	{ return a.type < b.type;	}
+	};
+
+	struct ClusterTouch
+	{
+		PxSweepHit	hit;
+		PxU32		sweep;	// index of the sweep within its cluster
+	};
+
+	struct ClusterTouchLess
+	{
+		PX_FORCE_INLINE	bool	operator()(const ClusterTouch& a, const ClusterTouch& b)	const
+		{
+			return a.sweep < b.sweep || (a.sweep == b.sweep && a.hit.distance < b.hit.distance);
+		}
+	};
+
+	struct SweepState
+	{
+		PxReal	shrunkDistance;
+		bool	done;
+	};
+
+	// Per-task scratch buffers, reused from one execute() call to the next
+	struct TaskScratch
+	{
+		PxArray<Candidate>		candidates;
+		PxArray<ClusterTouch>	clusterTouches;
+		PxArray<SweepState>		states;
+		PxArray<PxSweepHit>		touches;
+	};
+
+	// Gathers the shapes overlapping the swept volume of a whole cluster
+	class CandidateCollector : public PxHitCallback<PxOverlapHit>
+	{
+		PX_NOCOPY(CandidateCollector)
+	public:
+		CandidateCollector(PxArray<Candidate>& candidates) : PxHitCallback<PxOverlapHit>(mLocalTouches, sizeof(mLocalTouches)/sizeof(mLocalTouches[0])), mCandidates(candidates)	{}
+
+		virtual	PxAgain	processTouches(const PxOverlapHit* hits, PxU32 nbHits)
+		{
+			for(PxU32 i=0;i<nbHits;i++)
+			{
+				Candidate& candidate = mCandidates.insert();
+				candidate.shape = hits[i].shape;
+				candidate.actor = hits[i].actor;
+			}
+			return true;
+		}
+
+		PxOverlapHit		mLocalTouches[64];
+		PxArray<Candidate>&	mCandidates;
+	};
+
+	PX_FORCE_INLINE PxReal surfaceArea(const PxBounds3& bounds)
+	{
+		const PxVec3 d = bounds.getDimensions();
+		return d.x*d.y + d.y*d.z + d.z*d.x;
+	}
+
+	PX_FORCE_INLINE PxU32 spreadBits10(PxU32 x)
+	{
+		x = (x | (x << 16)) & 0x030000FF;
+		x = (x | (x <<  8)) & 0x0300F00F;
+		x = (x | (x <<  4)) & 0x030C30C3;
+		x = (x | (x <<  2)) & 0x09249249;
+		return x;
+	}
+
+	PX_FORCE_INLINE bool sameFilterData(const PxQueryFilterData& a, const PxQueryFilterData& b)
+	{
+		return a.flags == b.flags && a.data.word0 == b.data.word0 && a.data.word1 == b.data.word1 && a.data.word2 == b.data.word2 && a.data.word3 == b.data.word3;
+	}
+
+	class BatchSweepQuery : public PxBatchSweepQueryExt, public PxUserAllocated
+	{
+													PX_NOCOPY(BatchSweepQuery)
+	public:
+													BatchSweepQuery(const PxScene& scene, PxQueryFilterCallback* queryFilterCallback, PxU32 maxNbSweepsPerCluster, PxCpuDispatcher* dispatcher);
+		virtual										~BatchSweepQuery();
+
+						bool						init(PxU32 maxNbSweeps, PxU32 maxNbSweepTouches);
+
+		// PxBatchSweepQueryExt
+		virtual			void						release()	PX_OVERRIDE	{ PX_DELETE_THIS;	}
+		virtual			PxSweepBuffer*				sweep(	const PxGeometry& geometry, const PxTransform& pose, const PxVec3& unitDir, const PxReal distance,
+															const PxU16 maxNbTouches, PxHitFlags hitFlags, const PxQueryFilterData& filterData, const PxReal inflation)	PX_OVERRIDE;
+		virtual			void						execute()	PX_OVERRIDE;
+		//~PxBatchSweepQueryExt
+
+						void						processClusters(PxU32 taskIndex, PxU32 start, PxU32 end);
+		static			void						processClustersJob(void* userData, PxU32 jobIndex);
+	private:
+						void						sortAndCluster();
+						void						processCluster(const Cluster& cluster, PxU32 taskIndex);
+
+		const			PxScene&					mScene;
+						PxQueryFilterCallback*		mFilterCallback;
+						PxCpuDispatcher*			mDispatcher;
+
+						PxSweepBuffer*				mBuffers;
+						PxSweepHit*					mTouches;
+						PxU32						mMaxNbSweeps;
+						PxU32						mMaxNbTouches;
+						PxU32						mMaxNbSweepsPerCluster;
+						bool						mLockScene;
+
+						PxArray<SweepQuery>			mQueries;
+						PxArray<SweepResult>		mResults;
+						PxArray<SortedSweep>		mSorted;
+						PxArray<Cluster>			mClusters;
+
+						TaskScratch*				mScratch;
+						PxU32						mNbTasks;
+						PxU32						mNbJobs;
+	};
+}
+
+BatchSweepQuery::BatchSweepQuery(const PxScene& scene, PxQueryFilterCallback* queryFilterCallback, PxU32 maxNbSweepsPerCluster, PxCpuDispatcher* dispatcher) :
+	mScene					(scene),
+	mFilterCallback			(queryFilterCallback),
+	mDispatcher				(dispatcher ? dispatcher : scene.getCpuDispatcher()),
+	mBuffers				(NULL),
+	mTouches				(NULL),
+	mMaxNbSweeps			(0),
+	mMaxNbTouches			(0),
+	mMaxNbSweepsPerCluster	(PxMax(maxNbSweepsPerCluster, 1u)),
+	mLockScene				(false),
+	mScratch				(NULL),
+	mNbTasks				(0),
+	mNbJobs					(0)
+{
+}
+
+BatchSweepQuery::~BatchSweepQuery()
+{
+	for(PxU32 i=0;i<mNbTasks;i++)
+		mScratch[i].~TaskScratch();
+	PX_FREE(mScratch);
+
+	PX_FREE(mBuffers);
+	PX_FREE(mTouches);
+}
+
+bool BatchSweepQuery::init(PxU32 maxNbSweeps, PxU32 maxNbSweepTouches)
+{
+	mMaxNbSweeps = maxNbSweeps;
+	mMaxNbTouches = maxNbSweepTouches;
+
+	if(maxNbSweeps)
+	{
+		mBuffers = PX_ALLOCATE(PxSweepBuffer, maxNbSweeps, "PxSweepBuffer");
+		if(!mBuffers)
+			return false;
+		for(PxU32 i=0;i<maxNbSweeps;i++)
+			PX_PLACEMENT_NEW(mBuffers + i, PxSweepBuffer);
+	}
+
+	if(maxNbSweepTouches)
+	{
+		mTouches = PX_ALLOCATE(PxSweepHit, maxNbSweepTouches, "PxSweepHit");
+		if(!mTouches)
+			return false;
+	}
+
+	mQueries.reserve(maxNbSweeps);
+	mResults.resize(maxNbSweeps);
+	mSorted.reserve(maxNbSweeps);
+
+	// One job (and scratch) for the calling thread and one per worker thread
+	mNbTasks = mDispatcher ? mDispatcher->getWorkerCount() + 1 : 1u;
+
+	mScratch = PX_ALLOCATE(TaskScratch, mNbTasks, "TaskScratch");
+	if(!mScratch)
+	{
+		mNbTasks = 0;
+		return false;
+	}
+
+	for(PxU32 i=0;i<mNbTasks;i++)
+	{
+		PX_PLACEMENT_NEW(mScratch + i, TaskScratch);
+		mScratch[i].states.resize(mMaxNbSweepsPerCluster);
+	}
+	return true;
+}
+
+PxSweepBuffer* BatchSweepQuery::sweep(	const PxGeometry& geometry, const PxTransform& pose, const PxVec3& unitDir, const PxReal distance,
+										const PxU16 maxNbTouches, PxHitFlags hitFlags, const PxQueryFilterData& filterData, const PxReal inflation)
+{
+	PX_CHECK_AND_RETURN_NULL(pose.isValid(), "PxBatchSweepQueryExt::sweep(): pose is not valid.");
+	PX_CHECK_AND_RETURN_NULL(unitDir.isNormalized(), "PxBatchSweepQueryExt::sweep(): unitDir is not normalized.");
+	PX_CHECK_AND_RETURN_NULL(PxIsFinite(distance) && distance > 0.0f, "PxBatchSweepQueryExt::sweep(): distance must be finite and larger than 0.");
+	PX_CHECK_AND_RETURN_NULL(PxIsFinite(inflation) && inflation >= 0.0f, "PxBatchSweepQueryExt::sweep(): inflation is not valid.");
+
+	const PxGeometryType::Enum type = geometry.getType();
+	if(type != PxGeometryType::eSPHERE && type != PxGeometryType::eCAPSULE && type != PxGeometryType::eBOX && type != PxGeometryType::eCONVEXMESH)
+	{
+		PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxBatchSweepQueryExt::sweep(): only box, sphere, capsule and convex geometries are supported. Query discarded.");
+		return NULL;
+	}
+
+	if(mQueries.size() >= mMaxNbSweeps)
+	{
+		PxGetFoundation().error(PxErrorCode::eINVALID_OPERATION, PX_FL, "PxBatchSweepQueryExt::sweep(): number of sweep() calls exceeds maxNbSweeps. Query discarded.");
+		return NULL;
+	}
+
+	const PxReal clampedDistance = PxMin(distance, PX_MAX_SWEEP_DISTANCE);
+
+	SweepQuery& query = mQueries.insert();
+	query.geometry.storeAny(geometry);
+	query.pose = pose;
+	query.unitDir = unitDir;
+	query.distance = clampedDistance;
+	query.hitFlags = hitFlags;
+	query.filterData = filterData;
+	query.inflation = inflation;
+
+	// Swept volume, slightly inflated like the pruner bounds
+	PxBounds3 startBounds;
+	PxGeometryQuery::computeGeomBounds(startBounds, geometry, pose, inflation, 1.01f);
+	const PxVec3 motion = unitDir * clampedDistance;
+	query.sweptBounds = startBounds;
+	query.sweptBounds.include(PxBounds3(startBounds.minimum + motion, startBounds.maximum + motion));
+
+	PxSweepBuffer* buffer = mBuffers + mQueries.size() - 1;
+	buffer->touches = NULL;
+	buffer->maxNbTouches = maxNbTouches;
+	buffer->hasBlock = false;
+	buffer->nbTouches = 0xffffffff;
+	return buffer;
+}
+
+void BatchSweepQuery::sortAndCluster()
+{
+	const PxU32 nbQueries = mQueries.size();
+
+	// Morton order of the swept volume centers within the batch bounds, sorted by sweep geometry type first so that
+	// each cluster uses a single narrow-phase sweep function per candidate type
+	PxBounds3 batchBounds = PxBounds3::empty();
+	for(PxU32 i=0;i<nbQueries;i++)
+		batchBounds.include(mQueries[i].sweptBounds.getCenter());
+
+	const PxVec3 dims = batchBounds.getDimensions();
+	const PxVec3 scale(	dims.x > 0.0f ? 1023.0f / dims.x : 0.0f,
+						dims.y > 0.0f ? 1023.0f / dims.y : 0.0f,
+						dims.z > 0.0f ? 1023.0f / dims.z : 0.0f);
+
+	mSorted.resizeUninitialized(nbQueries);
+	for(PxU32 i=0;i<nbQueries;i++)
+	{
+		const PxVec3 p = (mQueries[i].sweptBounds.getCenter() - batchBounds.minimum).multiply(scale);
+		const PxU32 morton = spreadBits10(PxU32(p.x)) | (spreadBits10(PxU32(p.y)) << 1) | (spreadBits10(PxU32(p.z)) << 2);
+		mSorted[i].key = (PxU64(mQueries[i].geometry.getType()) << 32) | morton;
+		mSorted[i].index = i;
+	}
+	PxSort(mSorted.begin(), nbQueries);
+
+	// Greedy clustering of consecutive sweeps. A sweep joins the current cluster as long as the cluster's bounds stay
+	// compact, i.e. their surface area is not more than twice the total area of the swept volumes. Otherwise the
+	// shared overlap query would gather many candidates that none of the sweeps can reach.
+	mClusters.clear();
+	PxU32 i = 0;
+	while(i < nbQueries)
+	{
+		const SweepQuery& first = mQueries[mSorted[i].index];
+
+		Cluster& cluster = mClusters.insert();
+		cluster.bounds = first.sweptBounds;
+		cluster.start = i;
+		cluster.count = 1;
+
+		PxReal totalArea = surfaceArea(first.sweptBounds);
+		i++;
+
+		while(i < nbQueries && cluster.count < mMaxNbSweepsPerCluster)
+		{
+			const SweepQuery& query = mQueries[mSorted[i].index];
+			if(query.geometry.getType() != first.geometry.getType() || !sameFilterData(query.filterData, first.filterData))
+				break;
+
+			PxBounds3 merged = cluster.bounds;
+			merged.include(query.sweptBounds);
+			const PxReal area = surfaceArea(query.sweptBounds);
+			if(surfaceArea(merged) > 2.0f * (totalArea + area))
+				break;
+
+			cluster.bounds = merged;
+			cluster.count++;
+			totalArea += area;
+			i++;
+		}
+	}
+}
+
+void BatchSweepQuery::processCluster(const Cluster& cluster, PxU32 taskIndex)
+{
+	TaskScratch& scratch = mScratch[taskIndex];
+	const SortedSweep* sorted = mSorted.begin() + cluster.start;
+
+	const PxQueryFilterData& filterData = mQueries[sorted[0].index].filterData;
+	const bool anyHit = (filterData.flags & PxQueryFlag::eANY_HIT) == PxQueryFlag::eANY_HIT;
+	const bool noBlock = (filterData.flags & PxQueryFlag::eNO_BLOCK) == PxQueryFlag::eNO_BLOCK;
+	PxQueryFilterCallback* preFilter = (filterData.flags & PxQueryFlag::ePREFILTER) ? mFilterCallback : NULL;
+	PxQueryFilterCallback* postFilter = (filterData.flags & PxQueryFlag::ePOSTFILTER) ? mFilterCallback : NULL;
+
+	for(PxU32 k=0;k<cluster.count;k++)
+	{
+		SweepResult& result = mResults[sorted[k].index];
+		result.hasBlock = false;
+		result.taskIndex = taskIndex;
+		result.touchOffset = 0;
+		result.nbTouches = 0;
+
+		scratch.states[k].shrunkDistance = mQueries[sorted[k].index].distance;
+		scratch.states[k].done = false;
+	}
+
+	// Shared candidate gathering: one overlap query for the whole cluster. The filter equation and the static/dynamic
+	// flags do not depend on the swept geometry so they are applied here, the user filters are applied per sweep below.
+	scratch.candidates.clear();
+	{
+		const PxQueryFlags gatherFlags = (filterData.flags & (PxQueryFlag::eSTATIC | PxQueryFlag::eDYNAMIC | PxQueryFlag::eBATCH_QUERY_LEGACY_BEHAVIOUR)) | PxQueryFlag::eNO_BLOCK;
+		CandidateCollector collector(scratch.candidates);
+		mScene.overlap(PxBoxGeometry(cluster.bounds.getExtents()), PxTransform(cluster.bounds.getCenter()), collector, PxQueryFilterData(filterData.data, gatherFlags));
+	}
+
+	const PxU32 nbCandidates = scratch.candidates.size();
+	if(!nbCandidates)
+		return;
+
+	for(PxU32 c=0;c<nbCandidates;c++)
+	{
+		Candidate& candidate = scratch.candidates[c];
+		const PxGeometry& geometry = candidate.shape->getGeometry();
+		candidate.pose = PxShapeExt::getGlobalPose(*candidate.shape, *candidate.actor);
+		candidate.type = geometry.getType();
+		PxGeometryQuery::computeGeomBounds(candidate.bounds, geometry, candidate.pose, 0.0f, 1.01f);
+	}
+
+	// Type-homogeneous narrow phase: all the sweeps of the cluster share the same geometry type, and candidates are
+	// processed by geometry type, so consecutive tests go through the same sweep function.
+	PxSort(scratch.candidates.begin(), nbCandidates, CandidateTypeLess());
+
+	scratch.clusterTouches.clear();
+	for(PxU32 c=0;c<nbCandidates;c++)
+	{
+		const Candidate& candidate = scratch.candidates[c];
+		const PxGeometry& shapeGeometry = candidate.shape->getGeometry();
+
+		for(PxU32 k=0;k<cluster.count;k++)
+		{
+			SweepState& state = scratch.states[k];
+			if(state.done)
+				continue;
+
+			const SweepQuery& query = mQueries[sorted[k].index];
+			if(!query.sweptBounds.intersects(candidate.bounds))
+				continue;
+
+			const PxU32 maxNbTouches = mBuffers[sorted[k].index].maxNbTouches;
+
+			// Same default as PxScene::sweep: touches for queries with a touch buffer, blocks otherwise
+			PxQueryHitType::Enum shapeHitType = maxNbTouches ? PxQueryHitType::eTOUCH : PxQueryHitType::eBLOCK;
+
+			PxHitFlags hitFlags = query.hitFlags;
+			if(preFilter)
+			{
+				PxHitFlags outHitFlags = hitFlags;
+				shapeHitType = preFilter->preFilter(filterData.data, candidate.shape, candidate.actor, outHitFlags);
+				hitFlags = (hitFlags & ~PxHitFlag::eMODIFIABLE_FLAGS) | (outHitFlags & PxHitFlag::eMODIFIABLE_FLAGS);
+				if(shapeHitType == PxQueryHitType::eNONE)
+					continue;
+			}
+
+			if(state.shrunkDistance == 0.0f && (hitFlags & PxHitFlag::eASSUME_NO_INITIAL_OVERLAP))
+				continue;
+
+			PxSweepHit hit;
+			if(!PxGeometryQuery::sweep(query.unitDir, state.shrunkDistance, query.geometry.any(), query.pose, shapeGeometry, candidate.pose, hit, hitFlags, query.inflation))
+				continue;
+
+			hit.shape = const_cast<PxShape*>(candidate.shape);
+			hit.actor = const_cast<PxRigidActor*>(candidate.actor);
+			if(hit.distance == 0.0f && !(hitFlags & PxHitFlag::eMTD))
+				hit.normal = -query.unitDir;
+
+			PxQueryHitType::Enum hitType = shapeHitType;
+			if(postFilter)
+				hitType = postFilter->postFilter(filterData.data, hit, hit.shape, hit.actor);
+
+			if(hitType == PxQueryHitType::eNONE)
+				continue;
+
+			SweepResult& result = mResults[sorted[k].index];
+			if(anyHit)
+			{
+				result.block = hit;
+				result.hasBlock = true;
+				state.done = true;
+				continue;
+			}
+
+			if(noBlock)
+				hitType = PxQueryHitType::eTOUCH;
+
+			if(hitType == PxQueryHitType::eTOUCH)
+			{
+				if(maxNbTouches && hit.distance <= state.shrunkDistance)
+				{
+					ClusterTouch& touch = scratch.clusterTouches.insert();
+					touch.hit = hit;
+					touch.sweep = k;
+				}
+			}
+			else if(hit.distance <= state.shrunkDistance)
+			{
+				state.shrunkDistance = hit.distance;
+				result.block = hit;
+				result.hasBlock = true;
+			}
+		}
+	}
+
+	// Keep the touches that are not behind the final blocking hit, sorted by distance
+	const PxU32 nbClusterTouches = scratch.clusterTouches.size();
+	if(!nbClusterTouches)
+		return;
+
+	PxSort(scratch.clusterTouches.begin(), nbClusterTouches, ClusterTouchLess());
+	for(PxU32 t=0;t<nbClusterTouches;t++)
+	{
+		const ClusterTouch& touch = scratch.clusterTouches[t];
+		const PxU32 k = touch.sweep;
+		SweepResult& result = mResults[sorted[k].index];
+		if(result.hasBlock && touch.hit.distance > result.block.distance)
+			continue;
+
+		if(!result.nbTouches)
+			result.touchOffset = scratch.touches.size();
+		result.nbTouches++;
+		scratch.touches.pushBack(touch.hit);
+	}
+}
+
+void BatchSweepQuery::processClusters(PxU32 taskIndex, PxU32 start, PxU32 end)
+{
+	PxSceneWorkerReadLock lock(const_cast<PxScene&>(mScene), mLockScene, PX_FL);
+
+	mScratch[taskIndex].touches.clear();
+	for(PxU32 i=start;i<end;i++)
+		processCluster(mClusters[i], taskIndex);
+}
+
+// Job i processes the i-th of mNbJobs contiguous ranges of clusters, with its own scratch
+void BatchSweepQuery::processClustersJob(void* userData, PxU32 jobIndex)
+{
+	BatchSweepQuery* batch = reinterpret_cast<BatchSweepQuery*>(userData);
+
+	const PxU32 nbClusters = batch->mClusters.size();
+	const PxU32 nbPerJob = nbClusters / batch->mNbJobs;
+	const PxU32 remainder = nbClusters - nbPerJob * batch->mNbJobs;
+	const PxU32 start = jobIndex * nbPerJob + PxMin(jobIndex, remainder);
+	const PxU32 end = start + nbPerJob + (jobIndex < remainder ? 1u : 0u);
+
+	batch->processClusters(jobIndex, start, end);
+}
+
+void BatchSweepQuery::execute()
+{
+	const PxU32 nbQueries = mQueries.size();
+	if(!nbQueries)
+		return;
+
+	sortAndCluster();
+
+	mLockScene = PxSceneWorkerReadLock::isRequired(const_cast<PxScene&>(mScene));
+
+	const PxU32 nbClusters = mClusters.size();
+	mNbJobs = PxMax(PxMin(nbClusters, mNbTasks), 1u);
+	Gu::runJobs(mDispatcher, processClustersJob, this, mNbJobs);
+
+	// Write out the results in submission order, distributing the shared touch buffer like PxBatchQueryExt
+	PxU32 touchesTide = 0;
+	for(PxU32 i=0;i<nbQueries;i++)
+	{
+		const SweepResult& result = mResults[i];
+		PxSweepBuffer& buffer = mBuffers[i];
+
+		buffer.hasBlock = result.hasBlock;
+		if(result.hasBlock)
+			buffer.block = result.block;
+
+		const PxU32 capacity = PxMin(buffer.maxNbTouches, mMaxNbTouches - touchesTide);
+		const PxU32 nbTouches = PxMin(result.nbTouches, capacity);
+		if(nbTouches)
+		{
+			buffer.touches = mTouches + touchesTide;
+			PxMemCopy(buffer.touches, mScratch[result.taskIndex].touches.begin() + result.touchOffset, sizeof(PxSweepHit)*nbTouches);
+			touchesTide += nbTouches;
+		}
+		buffer.nbTouches = nbTouches;
+
+		if(result.nbTouches > capacity)
+			buffer.maxNbTouches = 0xffffffff;
+	}
+
+	mQueries.clear();
+}
+
+PxBatchSweepQueryExt* physx::PxCreateBatchSweepQueryExt(
+	const PxScene& scene, PxQueryFilterCallback* queryFilterCallback,
+	const PxU32 maxNbSweeps, const PxU32 maxNbSweepTouches,
+	const PxU32 maxNbSweepsPerCluster, PxCpuDispatcher* cpuDispatcher)
+{
+	if(!maxNbSweeps)
+	{
+		PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxCreateBatchSweepQueryExt: maxNbSweeps must be larger than 0.");
+		return NULL;
+	}
+
+	BatchSweepQuery* batch = PX_NEW(BatchSweepQuery)(scene, queryFilterCallback, maxNbSweepsPerCluster, cpuDispatcher);
+	if(!batch->init(maxNbSweeps, maxNbSweepTouches))
+	{
+		PxGetFoundation().error(PxErrorCode::eOUT_OF_MEMORY, PX_FL, "PxCreateBatchSweepQueryExt: allocation failed.");
+		batch->release();
+		return NULL;
+	}
+	return batch;
+}
@@ -0,0 +1,1030 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2023 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "extensions/PxCachedSceneQuerySystem.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxAtomic.h"
+#include "foundation/PxFoundation.h"
+#include "foundation/PxHashMap.h"
+#include "foundation/PxInlineArray.h"
+#include "foundation/PxMemory.h"
+#include "foundation/PxMutex.h"
+#include "foundation/PxUserAllocated.h"
+#include "geometry/PxBoxGeometry.h"
+#include "geometry/PxBVH.h"
+#include "geometry/PxCapsuleGeometry.h"
+#include "geometry/PxConvexMeshGeometry.h"
+#include "geometry/PxGeometryQuery.h"
+#include "geometry/PxSphereGeometry.h"
+#include "PxRigidActor.h"
+#include "PxShape.h"
+
+// This file implements a caching layer on top of another scene query system. All calls are forwarded to the wrapped system,
+// but the results of raycasts, sweeps and overlaps are also stored and reported again for identical queries, as long as the
+// scene did not change around them. Changes are tracked with stamps:
+// - a hashed grid of world-space regions, stamped with the bounds of added, updated or removed objects
+// - a hashed table of objects (pruner index + handle), stamped when an object is updated or removed
+// A cached query stays valid while none of the regions touched by its bounds and none of the objects it returned have been
+// stamped since the query was cached. Stamps are only incremented once per "changes then queries" cycle, e.g. once per frame.
+
+using namespace physx;
+
+void addExternalSQ(PxSceneQuerySystem* added);
+void removeExternalSQ(PxSceneQuerySystem* removed);
+
+namespace
+{
+	enum QueryType
+	{
+		QUERY_RAYCAST	= 0,
+		QUERY_SWEEP		= 1,
+		QUERY_OVERLAP	= 2,
+		QUERY_TOUCHES	= 4		// set when the query's callback accepts touching hits, as it changes the default hit type
+	};
+
+	// Full set of query parameters. It is zeroed before being filled and doesn't have implicit padding, so it can be hashed
+	// and compared as raw words.
+	struct QueryKey
+	{
+		const void*		mMesh;
+		const void*		mFilterCall;
+		PxU32			mType;
+		PxU32			mGeomType;
+		PxReal			mGeomParams[8];
+		PxTransform		mPose;
+		PxVec3			mDir;
+		PxReal			mDistance;
+		PxReal			mInflation;
+		PxU32			mHitFlags;
+		PxU32			mFilterFlags;
+		PxFilterData	mFilterData;
+		PxU32			mGeomQueryFlags;
+		PxU32			mPad;
+	};
+	PX_COMPILE_TIME_ASSERT(sizeof(QueryKey) == 2*sizeof(void*) + 30*sizeof(PxU32));
+
+	struct QueryKeyHash
+	{
+		PxU32	operator()(const QueryKey& key)	const
+		{
+			const PxU32* words = reinterpret_cast<const PxU32*>(&key);
+			PxU32 h = 5381;
+			for(PxU32 i=0; i<sizeof(QueryKey)/sizeof(PxU32); i++)
+				h = ((h << 5) + h) ^ words[i];
+			return PxComputeHash(h);
+		}
+
+		bool	equal(const QueryKey& key0, const QueryKey& key1)	const
+		{
+			const PxU32* words0 = reinterpret_cast<const PxU32*>(&key0);
+			const PxU32* words1 = reinterpret_cast<const PxU32*>(&key1);
+			for(PxU32 i=0; i<sizeof(QueryKey)/sizeof(PxU32); i++)
+			{
+				if(words0[i] != words1[i])
+					return false;
+			}
+			return true;
+		}
+	};
+
+	struct CacheEntry
+	{
+		PxU32	mStamp;				// change stamp at the time the query was cached
+		PxU32	mStaticTimestamp;	// static timestamp of the wrapped system at the time the query was cached
+		PxI32	mMinCell[3];		// regions touched by the query's bounds, if not global
+		PxI32	mMaxCell[3];
+		PxU32	mHitStart;			// first hit in the pool of the query's type
+		PxU32	mNbHits;			// number of hits, including the blocking hit
+		PxU32	mObjectStart;		// first object in the object pool
+		PxU32	mNbObjects;
+		bool	mGlobal;			// query's bounds are tracked globally
+		bool	mHasBlock;			// first hit is the blocking hit
+	};
+
+	struct ObjectRef
+	{
+		PxU32	mPrunerIndex;
+		PxU32	mHandle;
+	};
+
+	class ChangeTracker
+	{
+		public:
+		ChangeTracker(const PxSceneQueryCacheDesc& desc) :
+			mInvRegionSize	(1.0f / desc.regionSize),
+			mMask			(desc.nbRegionStamps - 1),
+			mMaxNbRegions	(desc.maxNbRegionsPerQuery),
+			mStamp			(1),
+			mGlobalStamp	(0),
+			mAnyStamp		(0),
+			mDirty			(false)
+		{
+			mRegionStamps.resize(desc.nbRegionStamps, 0);
+			mObjectStamps.resize(desc.nbRegionStamps, 0);
+		}
+
+		// Returns false if the bounds must be tracked globally
+		bool	computeCells(const PxBounds3& bounds, PxI32* minCell, PxI32* maxCell)	const
+		{
+			if(!bounds.isFinite())
+				return false;
+
+			PxU64 nbCells = 1;
+			for(PxU32 i=0; i<3; i++)
+			{
+				const PxReal minCoord = bounds.minimum[i] * mInvRegionSize;
+				const PxReal maxCoord = bounds.maximum[i] * mInvRegionSize;
+				if(minCoord < -1e6f || maxCoord > 1e6f)
+					return false;
+				minCell[i] = PxI32(PxFloor(minCoord));
+				maxCell[i] = PxI32(PxFloor(maxCoord));
+				nbCells *= PxU64(maxCell[i] - minCell[i] + 1);
+			}
+			return nbCells <= mMaxNbRegions;
+		}
+
+		void	markBounds(const PxBounds3& bounds)
+		{
+			if(bounds.isEmpty())
+				return;
+
+			PxI32 minCell[3], maxCell[3];
+			if(!computeCells(bounds, minCell, maxCell))
+				mGlobalStamp = mStamp;
+			else
+			{
+				for(PxI32 z=minCell[2]; z<=maxCell[2]; z++)
+					for(PxI32 y=minCell[1]; y<=maxCell[1]; y++)
+						for(PxI32 x=minCell[0]; x<=maxCell[0]; x++)
+							mRegionStamps[getRegionIndex(x, y, z)] = mStamp;
+			}
+			mAnyStamp = mStamp;
+			mDirty = true;
+		}
+
+		void	markObject(PxU32 prunerIndex, PxU32 handle)
+		{
+			mObjectStamps[getObjectIndex(prunerIndex, handle)] = mStamp;
+			mAnyStamp = mStamp;
+			mDirty = true;
+		}
+
+		// Returns the stamp for a new cache entry. Changes made after this call will use the same stamp and invalidate the entry.
+		PxU32	getEntryStamp()
+		{
+			if(mDirty)
+			{
+				mStamp++;
+				mDirty = false;
+			}
+			return mStamp;
+		}
+
+		bool	isValid(const CacheEntry& entry, const ObjectRef* objects)	const
+		{
+			const PxU32 stamp = entry.mStamp;
+			if(mGlobalStamp >= stamp)
+				return false;
+
+			if(entry.mGlobal)
+			{
+				if(mAnyStamp >= stamp)
+					return false;
+			}
+			else
+			{
+				for(PxI32 z=entry.mMinCell[2]; z<=entry.mMaxCell[2]; z++)
+					for(PxI32 y=entry.mMinCell[1]; y<=entry.mMaxCell[1]; y++)
+						for(PxI32 x=entry.mMinCell[0]; x<=entry.mMaxCell[0]; x++)
+							if(mRegionStamps[getRegionIndex(x, y, z)] >= stamp)
+								return false;
+			}
+
+			for(PxU32 i=0; i<entry.mNbObjects; i++)
+			{
+				if(mObjectStamps[getObjectIndex(objects[i].mPrunerIndex, objects[i].mHandle)] >= stamp)
+					return false;
+			}
+			return true;
+		}
+
+		private:
+		PX_FORCE_INLINE	PxU32	getRegionIndex(PxI32 x, PxI32 y, PxI32 z)	const
+		{
+			return ((PxU32(x) * 73856093u) ^ (PxU32(y) * 19349663u) ^ (PxU32(z) * 83492791u)) & mMask;
+		}
+
+		PX_FORCE_INLINE	PxU32	getObjectIndex(PxU32 prunerIndex, PxU32 handle)	const
+		{
+			return PxComputeHash(handle ^ (prunerIndex << 24)) & mMask;
+		}
+
+		PxArray<PxU32>	mRegionStamps;
+		PxArray<PxU32>	mObjectStamps;
+		const PxReal	mInvRegionSize;
+		const PxU32		mMask;
+		const PxU32		mMaxNbRegions;
+		PxU32			mStamp;
+		PxU32			mGlobalStamp;	// last change tracked globally, invalidates all entries
+		PxU32			mAnyStamp;		// last change anywhere, invalidates entries tracked globally
+		bool			mDirty;			// changes have been made with the current stamp
+	};
+
+	// Collects all the hits of a query in a growing array
+	template<class HitType>
+	struct HitCollector : PxHitCallback<HitType>
+	{
+		HitCollector(PxArray<HitType>& hits, bool acceptTouches) : PxHitCallback<HitType>(NULL, 0), mHits(hits), mNbStored(0)
+		{
+			if(acceptTouches)
+			{
+				mHits.resize(32);
+				setWindow();
+			}
+		}
+
+		virtual	PxAgain	processTouches(const HitType* /*buffer*/, PxU32 nbHits)
+		{
+			mNbStored += nbHits;
+			setWindow();
+			return true;
+		}
+
+		virtual	bool	growTouches(PxReal& /*maxTouchDistance*/)
+		{
+			mNbStored += this->nbTouches;
+			this->nbTouches = 0;
+			setWindow();
+			return true;
+		}
+
+		virtual	void	finalizeQuery()
+		{
+			mNbStored += this->nbTouches;
+			this->nbTouches = 0;
+
+			// hits stored via growTouches have not been clipped against the final blocking hit
+			if(this->hasBlock)
+			{
+				PxU32 i = 0;
+				while(i < mNbStored)
+				{
+					if(isFarther(mHits[i], this->block))
+						mHits[i] = mHits[--mNbStored];
+					else
+						i++;
+				}
+			}
+		}
+
+		void	setWindow()
+		{
+			if(mNbStored == mHits.size())
+				mHits.resize(mNbStored * 2);
+			this->touches = mHits.begin() + mNbStored;
+			this->maxNbTouches = mHits.size() - mNbStored;
+		}
+
+		static PX_FORCE_INLINE bool	isFarther(const PxLocationHit& hit, const PxLocationHit& block)	{ return hit.distance > block.distance;	}
+		static PX_FORCE_INLINE bool	isFarther(const PxOverlapHit&, const PxOverlapHit&)				{ return false;							}
+
+		PxArray<HitType>&	mHits;
+		PxU32				mNbStored;
+
+		PX_NOCOPY(HitCollector)
+	};
+
+	static PX_FORCE_INLINE PxReal	getHitDistance(const PxLocationHit& hit)	{ return hit.distance;	}
+	static PX_FORCE_INLINE PxReal	getHitDistance(const PxOverlapHit&)			{ return 0.0f;			}
+
+	// Reports hits to a user callback the same way the wrapped system would
+	template<class HitType>
+	static void reportHits(PxHitCallback<HitType>& hitCall, const HitType* block, const HitType* touches, PxU32 nbTouches, bool isOverlap)
+	{
+		hitCall.hasBlock = block!=NULL;
+		if(block)
+			hitCall.block = *block;
+		hitCall.nbTouches = 0;
+
+		PxReal maxTouchDist = block ? getHitDistance(*block) : PX_MAX_F32;
+		bool again = true;
+		for(PxU32 i=0; i<nbTouches; i++)
+		{
+			if(getHitDistance(touches[i]) > maxTouchDist)
+				continue;
+
+			if(hitCall.nbTouches == hitCall.maxNbTouches)
+			{
+				if(isOverlap || !hitCall.growTouches(maxTouchDist))
+				{
+					again = hitCall.processTouches(hitCall.touches, hitCall.nbTouches);
+					if(!again)
+						break;
+					hitCall.nbTouches = 0;
+				}
+				else if(getHitDistance(touches[i]) > maxTouchDist)
+					continue;
+			}
+			hitCall.touches[hitCall.nbTouches++] = touches[i];
+		}
+
+		if(again && hitCall.nbTouches)
+		{
+			if(hitCall.processTouches(hitCall.touches, hitCall.nbTouches))
+				hitCall.nbTouches = 0;
+		}
+		hitCall.finalizeQuery();
+	}
+
+	static bool setupGeometry(QueryKey& key, const PxGeometry& geometry)
+	{
+		key.mGeomType = PxU32(geometry.getType());
+		switch(geometry.getType())
+		{
+			case PxGeometryType::eSPHERE:
+			{
+				key.mGeomParams[0] = static_cast<const PxSphereGeometry&>(geometry).radius;
+				return true;
+			}
+			case PxGeometryType::eCAPSULE:
+			{
+				const PxCapsuleGeometry& capsule = static_cast<const PxCapsuleGeometry&>(geometry);
+				key.mGeomParams[0] = capsule.radius;
+				key.mGeomParams[1] = capsule.halfHeight;
+				return true;
+			}
+			case PxGeometryType::eBOX:
+			{
+				const PxBoxGeometry& box = static_cast<const PxBoxGeometry&>(geometry);
+				key.mGeomParams[0] = box.halfExtents.x;
+				key.mGeomParams[1] = box.halfExtents.y;
+				key.mGeomParams[2] = box.halfExtents.z;
+				return true;
+			}
+			case PxGeometryType::eCONVEXMESH:
+			{
+				const PxConvexMeshGeometry& convex = static_cast<const PxConvexMeshGeometry&>(geometry);
+				key.mMesh = convex.convexMesh;
+				key.mGeomParams[0] = convex.scale.scale.x;
+				key.mGeomParams[1] = convex.scale.scale.y;
+				key.mGeomParams[2] = convex.scale.scale.z;
+				key.mGeomParams[3] = convex.scale.rotation.x;
+				key.mGeomParams[4] = convex.scale.rotation.y;
+				key.mGeomParams[5] = convex.scale.rotation.z;
+				key.mGeomParams[6] = convex.scale.rotation.w;
+				key.mGeomParams[7] = PxReal(PxU32(convex.meshFlags));
+				return true;
+			}
+			default:
+				// other geometries are not cached
+				return false;
+		}
+	}
+
+	struct CompoundData
+	{
+		const PxRigidActor*	mActor;
+		PxTransform			mPose;
+		PxBounds3			mLocalBounds;
+
+		PX_FORCE_INLINE	PxBounds3	getWorldBounds()	const	{ return PxBounds3::transformFast(mPose, mLocalBounds);	}
+	};
+
+	class CachedPxSQ : public PxCachedSceneQuerySystem, public PxUserAllocated
+	{
+		public:
+												CachedPxSQ(PxSceneQuerySystem& system, const PxSceneQueryCacheDesc& desc);
+		virtual									~CachedPxSQ();
+
+		// PxSceneQuerySystem
+		virtual	void							release();
+		virtual	void							acquireReference()																	{ mRefCount++;													}
+		virtual	void							preallocate(PxU32 prunerIndex, PxU32 nbShapes)										{ mSystem.preallocate(prunerIndex, nbShapes);					}
+		virtual	void							addSQShape(	const PxRigidActor& actor, const PxShape& shape, const PxBounds3& bounds,
+															const PxTransform& transform, const PxSQCompoundHandle* compoundHandle, bool hasPruningStructure);
+		virtual	void							removeSQShape(const PxRigidActor& actor, const PxShape& shape);
+		virtual	void							updateSQShape(const PxRigidActor& actor, const PxShape& shape, const PxTransform& transform);
+		virtual	PxSQCompoundHandle				addSQCompound(const PxRigidActor& actor, const PxShape** shapes, const PxBVH& bvh, const PxTransform* transforms);
+		virtual	void							removeSQCompound(PxSQCompoundHandle compoundHandle);
+		virtual	void							updateSQCompound(PxSQCompoundHandle compoundHandle, const PxTransform& compoundTransform);
+		virtual	void							updateSQCompounds(const PxSQCompoundHandle* compoundHandles, const PxTransform* compoundTransforms, PxU32 nbCompounds);
+		virtual	void							flushUpdates()																		{ mSystem.flushUpdates();										}
+		virtual	void							flushMemory()																		{ mSystem.flushMemory();										}
+		virtual	void							visualize(PxU32 prunerIndex, PxRenderOutput& out)		const						{ mSystem.visualize(prunerIndex, out);							}
+		virtual	void							shiftOrigin(const PxVec3& shift);
+		virtual	PxSQBuildStepHandle				prepareSceneQueryBuildStep(PxU32 prunerIndex)										{ return mSystem.prepareSceneQueryBuildStep(prunerIndex);		}
+		virtual	void							sceneQueryBuildStep(PxSQBuildStepHandle handle)										{ mSystem.sceneQueryBuildStep(handle);							}
+		virtual	void							finalizeUpdates()																	{ mSystem.finalizeUpdates();									}
+		virtual	void							setDynamicTreeRebuildRateHint(PxU32 dynTreeRebuildRateHint)							{ mSystem.setDynamicTreeRebuildRateHint(dynTreeRebuildRateHint);	}
+		virtual	PxU32							getDynamicTreeRebuildRateHint()							const						{ return mSystem.getDynamicTreeRebuildRateHint();				}
+		virtual	void							forceRebuildDynamicTree(PxU32 prunerIndex)											{ mSystem.forceRebuildDynamicTree(prunerIndex);					}
+		virtual	PxSceneQueryUpdateMode::Enum	getUpdateMode()											const						{ return mSystem.getUpdateMode();								}
+		virtual	void							setUpdateMode(PxSceneQueryUpdateMode::Enum mode)									{ mSystem.setUpdateMode(mode);									}
+		virtual	PxU32							getStaticTimestamp()									const						{ return mSystem.getStaticTimestamp();							}
+		virtual	void							getDynamicTreeRefitStats(PxDynamicTreeRefitStats& stats)	const					{ mSystem.getDynamicTreeRefitStats(stats);						}
+		virtual	void							merge(const PxPruningStructure& pxps);
+		virtual	bool							raycast(const PxVec3& origin, const PxVec3& unitDir, const PxReal distance,
+														PxRaycastCallback& hitCall, PxHitFlags hitFlags,
+														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+														const PxQueryCache* cache, PxGeometryQueryFlags flags)	const;
+		virtual	bool							sweep(	const PxGeometry& geometry, const PxTransform& pose,
+														const PxVec3& unitDir, const PxReal distance,
+														PxSweepCallback& hitCall, PxHitFlags hitFlags,
+														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+														const PxQueryCache* cache, const PxReal inflation, PxGeometryQueryFlags flags)	const;
+		virtual	bool							overlap(const PxGeometry& geometry, const PxTransform& transform,
+														PxOverlapCallback& hitCall,
+														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+														const PxQueryCache* cache, PxGeometryQueryFlags flags)	const;
+		virtual	PxSQPrunerHandle				getHandle(const PxRigidActor& actor, const PxShape& shape, PxU32& prunerIndex)	const	{ return mSystem.getHandle(actor, shape, prunerIndex);		}
+		virtual	void							sync(PxU32 prunerIndex, const PxSQPrunerHandle* handles, const PxU32* indices, const PxBounds3* bounds,
+													const PxTransform32* transforms, PxU32 count, const PxBitMap& ignoredIndices);
+		//~PxSceneQuerySystem
+
+		// PxCachedSceneQuerySystem
+		virtual	void							invalidateCache();
+		virtual	void							getCacheStats(PxSceneQueryCacheStats& stats)	const;
+		virtual	void							resetCacheStats();
+		//~PxCachedSceneQuerySystem
+
+		private:
+				bool							isCacheable(const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall, const PxQueryCache* cache)	const;
+				void							markCompound(const PxRigidActor& actor);
+
+		PX_FORCE_INLINE	CompoundData*			findCompound(PxSQCompoundHandle compoundHandle)
+												{
+													const PxHashMap<PxSQCompoundHandle, CompoundData>::Entry* e = mCompounds.find(compoundHandle);
+													return e ? const_cast<CompoundData*>(&e->second) : NULL;
+												}
+
+				template<class HitType, class QueryT>
+				bool							cachedQuery(const QueryKey& key, const PxBounds3& queryBounds, PxHitCallback<HitType>& hitCall, const QueryT& query, PxArray<HitType>& pool)	const;
+
+		PX_FORCE_INLINE	void					clearCache()	const
+												{
+													mEntryMap.clear();
+													mEntries.clear();
+													mObjects.clear();
+													mRaycastHits.clear();
+													mSweepHits.clear();
+													mOverlapHits.clear();
+												}
+
+				PxSceneQuerySystem&				mSystem;
+				const PxSceneQueryCacheDesc		mDesc;
+				PxU32							mRefCount;
+
+				// change tracking, only modified by the update functions, which do not run concurrently with queries.
+				// Queries only fetch new entry stamps from it, under the cache lock.
+		mutable	ChangeTracker					mTracker;
+				PxHashMap<PxSQCompoundHandle, CompoundData>			mCompounds;
+				PxHashMap<const PxRigidActor*, PxSQCompoundHandle>	mCompoundActors;
+
+				// cache, modified by queries that can run concurrently
+		mutable	PxMutex							mMutex;
+		mutable	PxHashMap<QueryKey, PxU32, QueryKeyHash>	mEntryMap;
+		mutable	PxArray<CacheEntry>				mEntries;
+		mutable	PxArray<ObjectRef>				mObjects;
+		mutable	PxArray<PxRaycastHit>			mRaycastHits;
+		mutable	PxArray<PxSweepHit>				mSweepHits;
+		mutable	PxArray<PxOverlapHit>			mOverlapHits;
+
+		mutable	volatile PxI32					mNbCacheHits;
+		mutable	volatile PxI32					mNbCacheMisses;
+		mutable	volatile PxI32					mNbInvalidatedEntries;
+		mutable	volatile PxI32					mNbUncachedQueries;
+
+		PX_NOCOPY(CachedPxSQ)
+	};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+CachedPxSQ::CachedPxSQ(PxSceneQuerySystem& system, const PxSceneQueryCacheDesc& desc) :
+	mSystem					(system),
+	mDesc					(desc),
+	mRefCount				(1),
+	mTracker				(desc),
+	mNbCacheHits			(0),
+	mNbCacheMisses			(0),
+	mNbInvalidatedEntries	(0),
+	mNbUncachedQueries		(0)
+{
+	mSystem.acquireReference();
+}
+
+CachedPxSQ::~CachedPxSQ()
+{
+	mSystem.release();
+}
+
+void CachedPxSQ::release()
+{
+	mRefCount--;
+	if(!mRefCount)
+	{
+		removeExternalSQ(this);
+		PX_DELETE_THIS;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void CachedPxSQ::markCompound(const PxRigidActor& actor)
+{
+	const PxHashMap<const PxRigidActor*, PxSQCompoundHandle>::Entry* e = mCompoundActors.find(&actor);
+	if(e)
+	{
+		const CompoundData* compound = findCompound(e->second);
+		if(compound)
+			mTracker.markBounds(compound->getWorldBounds());
+	}
+}
+
+void CachedPxSQ::addSQShape(const PxRigidActor& actor, const PxShape& shape, const PxBounds3& bounds, const PxTransform& transform, const PxSQCompoundHandle* compoundHandle, bool hasPruningStructure)
+{
+	mSystem.addSQShape(actor, shape, bounds, transform, compoundHandle, hasPruningStructure);
+
+	if(compoundHandle)
+	{
+		// SQ compound shapes use local bounds
+		CompoundData* compound = findCompound(*compoundHandle);
+		if(compound)
+		{
+			compound->mLocalBounds.include(bounds);
+			mTracker.markBounds(compound->getWorldBounds());
+		}
+	}
+	else
+		mTracker.markBounds(bounds);
+}
+
+void CachedPxSQ::removeSQShape(const PxRigidActor& actor, const PxShape& shape)
+{
+	PxU32 prunerIndex;
+	const PxSQPrunerHandle handle = mSystem.getHandle(actor, shape, prunerIndex);
+	mTracker.markObject(prunerIndex, handle);
+	markCompound(actor);
+
+	mSystem.removeSQShape(actor, shape);
+}
+
+void CachedPxSQ::updateSQShape(const PxRigidActor& actor, const PxShape& shape, const PxTransform& transform)
+{
+	mSystem.updateSQShape(actor, shape, transform);
+
+	PxU32 prunerIndex;
+	const PxSQPrunerHandle handle = mSystem.getHandle(actor, shape, prunerIndex);
+	mTracker.markObject(prunerIndex, handle);
+
+	PxBounds3 bounds;
+	PxGeometryQuery::computeGeomBounds(bounds, shape.getGeometry(), transform);
+
+	const PxHashMap<const PxRigidActor*, PxSQCompoundHandle>::Entry* e = mCompoundActors.find(&actor);
+	if(e)
+	{
+		// SQ compound shapes use local transforms
+		CompoundData* compound = findCompound(e->second);
+		if(compound)
+		{
+			mTracker.markBounds(compound->getWorldBounds());
+			compound->mLocalBounds.include(bounds);
+			mTracker.markBounds(compound->getWorldBounds());
+		}
+	}
+	else
+		mTracker.markBounds(bounds);
+}
+
+PxSQCompoundHandle CachedPxSQ::addSQCompound(const PxRigidActor& actor, const PxShape** shapes, const PxBVH& bvh, const PxTransform* transforms)
+{
+	const PxSQCompoundHandle handle = mSystem.addSQCompound(actor, shapes, bvh, transforms);
+
+	CompoundData data;
+	data.mActor = &actor;
+	data.mPose = actor.getGlobalPose();
+	data.mLocalBounds.setEmpty();
+	const PxU32 nbBounds = bvh.getNbBounds();
+	const PxBounds3* bounds = bvh.getBounds();
+	for(PxU32 i=0; i<nbBounds; i++)
+		data.mLocalBounds.include(bounds[i]);
+
+	mCompounds[handle] = data;
+	mCompoundActors[&actor] = handle;
+
+	mTracker.markBounds(data.getWorldBounds());
+	return handle;
+}
+
+void CachedPxSQ::removeSQCompound(PxSQCompoundHandle compoundHandle)
+{
+	const PxHashMap<PxSQCompoundHandle, CompoundData>::Entry* c = mCompounds.find(compoundHandle);
+	if(c)
+	{
+		mTracker.markBounds(c->second.getWorldBounds());
+		mCompoundActors.erase(c->second.mActor);
+		mCompounds.erase(compoundHandle);
+	}
+
+	mSystem.removeSQCompound(compoundHandle);
+}
+
+void CachedPxSQ::updateSQCompound(PxSQCompoundHandle compoundHandle, const PxTransform& compoundTransform)
+{
+	CompoundData* compound = findCompound(compoundHandle);
+	if(compound)
+	{
+		mTracker.markBounds(compound->getWorldBounds());
+		compound->mPose = compoundTransform;
+		mTracker.markBounds(compound->getWorldBounds());
+	}
+
+	mSystem.updateSQCompound(compoundHandle, compoundTransform);
+}
+
+void CachedPxSQ::updateSQCompounds(const PxSQCompoundHandle* compoundHandles, const PxTransform* compoundTransforms, PxU32 nbCompounds)
+{
+	for(PxU32 i=0; i<nbCompounds; i++)
+	{
+		CompoundData* compound = findCompound(compoundHandles[i]);
+		if(compound)
+		{
+			mTracker.markBounds(compound->getWorldBounds());
+			compound->mPose = compoundTransforms[i];
+			mTracker.markBounds(compound->getWorldBounds());
+		}
+	}
+
+	mSystem.updateSQCompounds(compoundHandles, compoundTransforms, nbCompounds);
+}
+
+void CachedPxSQ::shiftOrigin(const PxVec3& shift)
+{
+	mSystem.shiftOrigin(shift);
+
+	for(PxHashMap<PxSQCompoundHandle, CompoundData>::Iterator iter = mCompounds.getIterator(); !iter.done(); ++iter)
+		iter->second.mPose.p -= shift;
+
+	invalidateCache();
+}
+
+void CachedPxSQ::merge(const PxPruningStructure& pxps)
+{
+	mSystem.merge(pxps);
+
+	invalidateCache();
+}
+
+void CachedPxSQ::sync(PxU32 prunerIndex, const PxSQPrunerHandle* handles, const PxU32* indices, const PxBounds3* bounds,
+						const PxTransform32* transforms, PxU32 count, const PxBitMap& ignoredIndices)
+{
+	mSystem.sync(prunerIndex, handles, indices, bounds, transforms, count, ignoredIndices);
+
+	for(PxU32 i=0; i<count; i++)
+	{
+		const PxU32 index = indices[i];
+		if(ignoredIndices.boundedTest(index))
+			continue;
+
+		mTracker.markObject(prunerIndex, handles[i]);
+		mTracker.markBounds(bounds[index]);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void CachedPxSQ::invalidateCache()
+{
+	PxMutex::ScopedLock lock(mMutex);
+	clearCache();
+}
+
+void CachedPxSQ::getCacheStats(PxSceneQueryCacheStats& stats) const
+{
+	stats.nbCacheHits			= PxU32(mNbCacheHits);
+	stats.nbCacheMisses			= PxU32(mNbCacheMisses);
+	stats.nbInvalidatedEntries	= PxU32(mNbInvalidatedEntries);
+	stats.nbUncachedQueries		= PxU32(mNbUncachedQueries);
+}
+
+void CachedPxSQ::resetCacheStats()
+{
+	mNbCacheHits = 0;
+	mNbCacheMisses = 0;
+	mNbInvalidatedEntries = 0;
+	mNbUncachedQueries = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool CachedPxSQ::isCacheable(const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall, const PxQueryCache* cache) const
+{
+	if(cache)
+		return false;
+
+	if(filterCall && (filterData.flags & (PxQueryFlag::ePREFILTER | PxQueryFlag::ePOSTFILTER)) && !mDesc.cacheFilteredQueries)
+		return false;
+
+	return true;
+}
+
+static PX_FORCE_INLINE void addObject(PxInlineArray<ObjectRef, 16>& objects, const PxSceneQuerySystem& system, const PxActorShape& hit)
+{
+	if(hit.actor && hit.shape)
+	{
+		ObjectRef ref;
+		ref.mHandle = system.getHandle(*hit.actor, *hit.shape, ref.mPrunerIndex);
+		objects.pushBack(ref);
+	}
+}
+
+template<class HitType, class QueryT>
+bool CachedPxSQ::cachedQuery(const QueryKey& key, const PxBounds3& queryBounds, PxHitCallback<HitType>& hitCall, const QueryT& query, PxArray<HitType>& pool) const
+{
+	const bool isOverlap = (key.mType & 3) == QUERY_OVERLAP;
+
+	PxInlineArray<HitType, 16> cachedHits;
+	bool found = false;
+	bool hasBlock = false;
+	{
+		PxMutex::ScopedLock lock(mMutex);
+
+		const PxHashMap<QueryKey, PxU32, QueryKeyHash>::Entry* e = mEntryMap.find(key);
+		if(e)
+		{
+			const CacheEntry& entry = mEntries[e->second];
+			if(entry.mStaticTimestamp == mSystem.getStaticTimestamp() && mTracker.isValid(entry, mObjects.begin() + entry.mObjectStart))
+			{
+				// copy the hits, since reporting them calls user code and must be done outside of the lock
+				cachedHits.resize(entry.mNbHits);
+				PxMemCopy(cachedHits.begin(), pool.begin() + entry.mHitStart, sizeof(HitType)*entry.mNbHits);
+				hasBlock = entry.mHasBlock;
+				found = true;
+			}
+			else
+				PxAtomicIncrement(&mNbInvalidatedEntries);
+		}
+	}
+
+	if(found)
+	{
+		PxAtomicIncrement(&mNbCacheHits);
+
+		const PxU32 nbHits = cachedHits.size();
+		reportHits(hitCall, hasBlock ? cachedHits.begin() : NULL, cachedHits.begin() + PxU32(hasBlock), nbHits - PxU32(hasBlock), isOverlap);
+		return nbHits!=0;
+	}
+
+	PxAtomicIncrement(&mNbCacheMisses);
+
+	// run the query on the wrapped system, collecting all the hits regardless of the size of the user's buffer
+	PxArray<HitType> touches;
+	HitCollector<HitType> collector(touches, hitCall.maxNbTouches!=0);
+	query(collector);
+
+	const HitType* block = collector.hasBlock ? &collector.block : NULL;
+	const PxU32 nbTouches = collector.mNbStored;
+	const PxU32 nbHits = nbTouches + PxU32(block!=NULL);
+
+	if(nbHits <= mDesc.maxNbHits)
+	{
+		PxInlineArray<ObjectRef, 16> objects;
+		if(block)
+			addObject(objects, mSystem, *block);
+		for(PxU32 i=0; i<nbTouches; i++)
+			addObject(objects, mSystem, touches[i]);
+
+		PxMutex::ScopedLock lock(mMutex);
+
+		if(mEntries.size() >= mDesc.maxNbEntries || pool.size() + nbHits > mDesc.maxNbHits || mObjects.size() + objects.size() > mDesc.maxNbHits)
+			clearCache();
+
+		CacheEntry entry;
+		entry.mStamp			= mTracker.getEntryStamp();
+		entry.mStaticTimestamp	= mSystem.getStaticTimestamp();
+		entry.mGlobal			= !mTracker.computeCells(queryBounds, entry.mMinCell, entry.mMaxCell);
+		entry.mHitStart			= pool.size();
+		entry.mNbHits			= nbHits;
+		entry.mObjectStart		= mObjects.size();
+		entry.mNbObjects		= objects.size();
+		entry.mHasBlock			= block!=NULL;
+
+		if(block)
+			pool.pushBack(*block);
+		for(PxU32 i=0; i<nbTouches; i++)
+			pool.pushBack(touches[i]);
+		for(PxU32 i=0; i<objects.size(); i++)
+			mObjects.pushBack(objects[i]);
+
+		// entries invalidated by changes are replaced, their hits are only discarded when the whole cache is flushed
+		const PxHashMap<QueryKey, PxU32, QueryKeyHash>::Entry* e = mEntryMap.find(key);
+		if(e)
+			mEntries[e->second] = entry;
+		else
+		{
+			mEntryMap.insert(key, mEntries.size());
+			mEntries.pushBack(entry);
+		}
+	}
+
+	reportHits(hitCall, block, touches.begin(), nbTouches, isOverlap);
+	return nbHits!=0;
+}
+
+namespace
+{
+	struct RaycastQuery
+	{
+		RaycastQuery(const PxSceneQuerySystem& system, const PxVec3& origin, const PxVec3& unitDir, PxReal distance, PxHitFlags hitFlags,
+			const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall, PxGeometryQueryFlags flags) :
+			mSystem(system), mOrigin(origin), mUnitDir(unitDir), mDistance(distance), mHitFlags(hitFlags), mFilterData(filterData), mFilterCall(filterCall), mFlags(flags)	{}
+
+		PX_FORCE_INLINE	void	operator()(PxRaycastCallback& hitCall)	const
+		{
+			mSystem.raycast(mOrigin, mUnitDir, mDistance, hitCall, mHitFlags, mFilterData, mFilterCall, NULL, mFlags);
+		}
+
+		const PxSceneQuerySystem&	mSystem;
+		const PxVec3&				mOrigin;
+		const PxVec3&				mUnitDir;
+		const PxReal				mDistance;
+		const PxHitFlags			mHitFlags;
+		const PxQueryFilterData&	mFilterData;
+		PxQueryFilterCallback*		mFilterCall;
+		const PxGeometryQueryFlags	mFlags;
+
+		PX_NOCOPY(RaycastQuery)
+	};
+
+	struct SweepQuery
+	{
+		SweepQuery(const PxSceneQuerySystem& system, const PxGeometry& geometry, const PxTransform& pose, const PxVec3& unitDir, PxReal distance, PxHitFlags hitFlags,
+			const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall, PxReal inflation, PxGeometryQueryFlags flags) :
+			mSystem(system), mGeometry(geometry), mPose(pose), mUnitDir(unitDir), mDistance(distance), mHitFlags(hitFlags), mFilterData(filterData), mFilterCall(filterCall),
+			mInflation(inflation), mFlags(flags)	{}
+
+		PX_FORCE_INLINE	void	operator()(PxSweepCallback& hitCall)	const
+		{
+			mSystem.sweep(mGeometry, mPose, mUnitDir, mDistance, hitCall, mHitFlags, mFilterData, mFilterCall, NULL, mInflation, mFlags);
+		}
+
+		const PxSceneQuerySystem&	mSystem;
+		const PxGeometry&			mGeometry;
+		const PxTransform&			mPose;
+		const PxVec3&				mUnitDir;
+		const PxReal				mDistance;
+		const PxHitFlags			mHitFlags;
+		const PxQueryFilterData&	mFilterData;
+		PxQueryFilterCallback*		mFilterCall;
+		const PxReal				mInflation;
+		const PxGeometryQueryFlags	mFlags;
+
+		PX_NOCOPY(SweepQuery)
+	};
+
+	struct OverlapQuery
+	{
+		OverlapQuery(const PxSceneQuerySystem& system, const PxGeometry& geometry, const PxTransform& pose,
+			const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall, PxGeometryQueryFlags flags) :
+			mSystem(system), mGeometry(geometry), mPose(pose), mFilterData(filterData), mFilterCall(filterCall), mFlags(flags)	{}
+
+		PX_FORCE_INLINE	void	operator()(PxOverlapCallback& hitCall)	const
+		{
+			mSystem.overlap(mGeometry, mPose, hitCall, mFilterData, mFilterCall, NULL, mFlags);
+		}
+
+		const PxSceneQuerySystem&	mSystem;
+		const PxGeometry&			mGeometry;
+		const PxTransform&			mPose;
+		const PxQueryFilterData&	mFilterData;
+		PxQueryFilterCallback*		mFilterCall;
+		const PxGeometryQueryFlags	mFlags;
+
+		PX_NOCOPY(OverlapQuery)
+	};
+}
+
+static PX_FORCE_INLINE void setupKey(QueryKey& key, PxU32 type, PxHitFlags hitFlags, const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall, PxGeometryQueryFlags flags, PxU32 maxNbTouches)
+{
+	PxMemZero(&key, sizeof(QueryKey));
+	key.mType			= type | (maxNbTouches ? PxU32(QUERY_TOUCHES) : 0);
+	key.mHitFlags		= PxU32(hitFlags);
+	key.mFilterFlags	= PxU32(filterData.flags);
+	key.mFilterData		= filterData.data;
+	key.mFilterCall		= filterCall;
+	key.mGeomQueryFlags	= PxU32(flags);
+}
+
+bool CachedPxSQ::raycast(	const PxVec3& origin, const PxVec3& unitDir, const PxReal distance,
+							PxRaycastCallback& hitCall, PxHitFlags hitFlags,
+							const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+							const PxQueryCache* cache, PxGeometryQueryFlags flags) const
+{
+	if(!isCacheable(filterData, filterCall, cache))
+	{
+		PxAtomicIncrement(&mNbUncachedQueries);
+		return mSystem.raycast(origin, unitDir, distance, hitCall, hitFlags, filterData, filterCall, cache, flags);
+	}
+
+	QueryKey key;
+	setupKey(key, QUERY_RAYCAST, hitFlags, filterData, filterCall, flags, hitCall.maxNbTouches);
+	key.mPose.p		= origin;
+	key.mDir		= unitDir;
+	key.mDistance	= distance;
+
+	PxBounds3 queryBounds(origin, origin);
+	queryBounds.include(origin + unitDir * distance);
+
+	const RaycastQuery query(mSystem, origin, unitDir, distance, hitFlags, filterData, filterCall, flags);
+	return cachedQuery(key, queryBounds, hitCall, query, mRaycastHits);
+}
+
+bool CachedPxSQ::sweep(	const PxGeometry& geometry, const PxTransform& pose,
+						const PxVec3& unitDir, const PxReal distance,
+						PxSweepCallback& hitCall, PxHitFlags hitFlags,
+						const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+						const PxQueryCache* cache, const PxReal inflation, PxGeometryQueryFlags flags) const
+{
+	QueryKey key;
+	setupKey(key, QUERY_SWEEP, hitFlags, filterData, filterCall, flags, hitCall.maxNbTouches);
+	if(!isCacheable(filterData, filterCall, cache) || !setupGeometry(key, geometry))
+	{
+		PxAtomicIncrement(&mNbUncachedQueries);
+		return mSystem.sweep(geometry, pose, unitDir, distance, hitCall, hitFlags, filterData, filterCall, cache, inflation, flags);
+	}
+	key.mPose		= pose;
+	key.mDir		= unitDir;
+	key.mDistance	= distance;
+	key.mInflation	= inflation;
+
+	PxBounds3 queryBounds;
+	PxGeometryQuery::computeGeomBounds(queryBounds, geometry, pose, inflation);
+	const PxVec3 motion = unitDir * distance;
+	queryBounds.include(PxBounds3(queryBounds.minimum + motion, queryBounds.maximum + motion));
+
+	const SweepQuery query(mSystem, geometry, pose, unitDir, distance, hitFlags, filterData, filterCall, inflation, flags);
+	return cachedQuery(key, queryBounds, hitCall, query, mSweepHits);
+}
+
+bool CachedPxSQ::overlap(	const PxGeometry& geometry, const PxTransform& transform,
+							PxOverlapCallback& hitCall,
+							const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+							const PxQueryCache* cache, PxGeometryQueryFlags flags) const
+{
+	QueryKey key;
+	setupKey(key, QUERY_OVERLAP, PxHitFlags(0), filterData, filterCall, flags, hitCall.maxNbTouches);
+	if(!isCacheable(filterData, filterCall, cache) || !setupGeometry(key, geometry))
+	{
+		PxAtomicIncrement(&mNbUncachedQueries);
+		return mSystem.overlap(geometry, transform, hitCall, filterData, filterCall, cache, flags);
+	}
+	key.mPose = transform;
+
+	PxBounds3 queryBounds;
+	PxGeometryQuery::computeGeomBounds(queryBounds, geometry, transform);
+
+	const OverlapQuery query(mSystem, geometry, transform, filterData, filterCall, flags);
+	return cachedQuery(key, queryBounds, hitCall, query, mOverlapHits);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+PxCachedSceneQuerySystem* physx::PxCreateCachedSceneQuerySystem(PxSceneQuerySystem& system, const PxSceneQueryCacheDesc& desc)
+{
+	if(!desc.isValid())
+	{
+		PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxCreateCachedSceneQuerySystem: invalid descriptor.");
+		return NULL;
+	}
+
+	CachedPxSQ* pxsq = PX_NEW(CachedPxSQ)(system, desc);
+
+	addExternalSQ(pxsq);
+
+	return pxsq;
+}
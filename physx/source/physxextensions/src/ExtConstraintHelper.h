@@ -53,6 +53,85 @@ namespace Ext
 			PX_ASSERT(cA2w.isValid() && cB2w.isValid());
 		}
 
+		// SoA transforms, used to compute the joint frames of 4 joints at once
+		struct Transform4V
+		{
+			aos::Vec4V	qx, qy, qz, qw;
+			aos::Vec4V	px, py, pz;
+
+			PX_FORCE_INLINE void load(const PxTransform& t0, const PxTransform& t1, const PxTransform& t2, const PxTransform& t3)
+			{
+				using namespace aos;
+				qx = V4LoadU(&t0.q.x);
+				qy = V4LoadU(&t1.q.x);
+				qz = V4LoadU(&t2.q.x);
+				qw = V4LoadU(&t3.q.x);
+				V4Transpose(qx, qy, qz, qw);
+
+				px = V4LoadXYZW(t0.p.x, t1.p.x, t2.p.x, t3.p.x);
+				py = V4LoadXYZW(t0.p.y, t1.p.y, t2.p.y, t3.p.y);
+				pz = V4LoadXYZW(t0.p.z, t1.p.z, t2.p.z, t3.p.z);
+			}
+
+			PX_FORCE_INLINE void store(PxTransform* t)	const
+			{
+				using namespace aos;
+				PX_ALIGN(16, PxReal) x[4];	V4StoreA(qx, x);
+				PX_ALIGN(16, PxReal) y[4];	V4StoreA(qy, y);
+				PX_ALIGN(16, PxReal) z[4];	V4StoreA(qz, z);
+				PX_ALIGN(16, PxReal) w[4];	V4StoreA(qw, w);
+				PX_ALIGN(16, PxReal) tx[4];	V4StoreA(px, tx);
+				PX_ALIGN(16, PxReal) ty[4];	V4StoreA(py, ty);
+				PX_ALIGN(16, PxReal) tz[4];	V4StoreA(pz, tz);
+				for(PxU32 i=0;i<4;i++)
+				{
+					t[i].q = PxQuat(x[i], y[i], z[i], w[i]);
+					t[i].p = PxVec3(tx[i], ty[i], tz[i]);
+				}
+			}
+
+			// Same as PxTransform::transform(), i.e. this = a * b
+			PX_FORCE_INLINE void transform(const Transform4V& a, const Transform4V& b)
+			{
+				using namespace aos;
+				// Rotation, see PxQuat::operator*
+				qx = V4Add(V4Sub(V4MulAdd(a.qw, b.qx, V4Mul(b.qw, a.qx)), V4Mul(b.qy, a.qz)), V4Mul(a.qy, b.qz));
+				qy = V4Add(V4Sub(V4MulAdd(a.qw, b.qy, V4Mul(b.qw, a.qy)), V4Mul(b.qz, a.qx)), V4Mul(a.qz, b.qx));
+				qz = V4Add(V4Sub(V4MulAdd(a.qw, b.qz, V4Mul(b.qw, a.qz)), V4Mul(b.qx, a.qy)), V4Mul(a.qx, b.qy));
+				qw = V4NegMulSub(a.qz, b.qz, V4NegMulSub(a.qy, b.qy, V4NegMulSub(a.qx, b.qx, V4Mul(a.qw, b.qw))));
+
+				// Translation, see PxQuat::rotate
+				const Vec4V two = V4Load(2.0f);
+				const Vec4V vx = V4Mul(two, b.px);
+				const Vec4V vy = V4Mul(two, b.py);
+				const Vec4V vz = V4Mul(two, b.pz);
+				const Vec4V w2 = V4Sub(V4Mul(a.qw, a.qw), V4Load(0.5f));
+				const Vec4V dot2 = V4MulAdd(a.qz, vz, V4MulAdd(a.qy, vy, V4Mul(a.qx, vx)));
+				const Vec4V cx = V4NegMulSub(a.qz, vy, V4Mul(a.qy, vz));
+				const Vec4V cy = V4NegMulSub(a.qx, vz, V4Mul(a.qz, vx));
+				const Vec4V cz = V4NegMulSub(a.qy, vx, V4Mul(a.qx, vy));
+				px = V4Add(V4MulAdd(a.qx, dot2, V4MulAdd(cx, a.qw, V4Mul(vx, w2))), a.px);
+				py = V4Add(V4MulAdd(a.qy, dot2, V4MulAdd(cy, a.qw, V4Mul(vy, w2))), a.py);
+				pz = V4Add(V4MulAdd(a.qz, dot2, V4MulAdd(cz, a.qw, V4Mul(vz, w2))), a.pz);
+			}
+		};
+
+		// SIMD version of computeJointFrames for 4 joints
+		PX_FORCE_INLINE void computeJointFrames4(PxTransform* cA2w, PxTransform* cB2w, const JointData* const* data, const PxTransform* bA2w, const PxTransform* bB2w)
+		{
+			Transform4V body, local, frame;
+
+			body.load(bA2w[0], bA2w[1], bA2w[2], bA2w[3]);
+			local.load(data[0]->c2b[0], data[1]->c2b[0], data[2]->c2b[0], data[3]->c2b[0]);
+			frame.transform(body, local);
+			frame.store(cA2w);
+
+			body.load(bB2w[0], bB2w[1], bB2w[2], bB2w[3]);
+			local.load(data[0]->c2b[1], data[1]->c2b[1], data[2]->c2b[1], data[3]->c2b[1]);
+			frame.transform(body, local);
+			frame.store(cB2w);
+		}
+
 		PX_INLINE void computeDerived(const JointData& data, 
 									  const PxTransform& bA2w, const PxTransform& bB2w,
 									  PxTransform& cA2w, PxTransform& cB2w, PxTransform& cB2cA,
@@ -202,14 +281,18 @@ namespace Ext
 
 				computeJointFrames(cA2w, cB2w, data, bA2w, bB2w);
 
-				const PxVec3 ra = cB2w.p - bA2w.p;
-				body0WorldOffset = ra;
+				setupFrames(cA2w, cB2w, body0WorldOffset, bA2w, bB2w);
+			}
 
-				mRa = ra;
-				mRb = cB2w.p - bB2w.p;
+			// Same as above, for joint frames that have already been computed (e.g. by computeJointFrames4)
+			ConstraintHelper(Px1DConstraint* c, PxConstraintInvMassScale& invMassScale, PxVec3p& body0WorldOffset,
+					const JointData& data, const PxTransform& bA2w, const PxTransform& bB2w, const PxTransform& cA2w, const PxTransform& cB2w)
+				: mConstraints(c), mCurrent(c)
+			{
+				using namespace aos;
+				V4StoreA(V4LoadA(&data.invMassScale.linear0), &invMassScale.linear0);	//invMassScale = data.invMassScale;
 
-				mCA2w = cA2w.p;
-				mCB2w = cB2w.p;
+				setupFrames(cA2w, cB2w, body0WorldOffset, bA2w, bB2w);
 			}
 
 			PX_FORCE_INLINE const PxVec3& getRa()	const	{ return mRa; }
@@ -326,6 +409,18 @@ namespace Ext
 			}
 
 		private:
+			PX_FORCE_INLINE void setupFrames(const PxTransform& cA2w, const PxTransform& cB2w, PxVec3p& body0WorldOffset, const PxTransform& bA2w, const PxTransform& bB2w)
+			{
+				const PxVec3 ra = cB2w.p - bA2w.p;
+				body0WorldOffset = ra;
+
+				mRa = ra;
+				mRb = cB2w.p - bB2w.p;
+
+				mCA2w = cA2w.p;
+				mCB2w = cB2w.p;
+			}
+
 			PX_FORCE_INLINE Px1DConstraint* linear(const PxVec3& axis, PxReal posErr, PxConstraintSolveHint::Enum hint)
 			{
 				return _linear(axis, mRa, mRb, posErr, hint, mCurrent++);
@@ -379,6 +474,45 @@ namespace Ext
 				PX_ASSERT(c->angular0.isFinite());
 			}
 		};
+
+		// Per-joint part of a solver prep shader, i.e. everything after the joint frames have been computed.
+		// The frames are passed by reference so that the function can flip cB2w.q to the shortest path.
+		typedef PxU32 (*SetupJointRows)(ConstraintHelper& ch, const void* constantBlock, PxTransform& cA2w, PxTransform& cB2w,
+										const PxTransform& bA2w, const PxTransform& bB2w, bool useExtendedLimits, PxVec3p& cA2wOut, PxVec3p& cB2wOut);
+
+		// Generic PxConstraintSolverPrepBatch implementation: joint frames are computed 4 joints at a time in SoA form,
+		// then the joint-specific rows are generated by setupRows for each joint.
+		template<SetupJointRows setupRows>
+		void solverPrepBatch(PxU32 nbConstraints, Px1DConstraint* const* constraints, PxU32* nbRows, PxVec3p* body0WorldOffset, PxU32 /*maxConstraints*/,
+							PxConstraintInvMassScale* invMassScale, const void* const* constantBlock, const PxTransform* bA2w, const PxTransform* bB2w,
+							const bool* useExtendedLimits, PxVec3p* cA2wOut, PxVec3p* cB2wOut)
+		{
+			PxTransform cA2w[4], cB2w[4];
+
+			PxU32 i = 0;
+			for(; i+4<=nbConstraints; i+=4)
+			{
+				const JointData* data[4];
+				for(PxU32 j=0; j<4; j++)
+					data[j] = reinterpret_cast<const JointData*>(constantBlock[i+j]);
+
+				computeJointFrames4(cA2w, cB2w, data, bA2w + i, bB2w + i);
+
+				for(PxU32 j=0; j<4; j++)
+				{
+					const PxU32 index = i + j;
+					ConstraintHelper ch(constraints[index], invMassScale[index], body0WorldOffset[index], *data[j], bA2w[index], bB2w[index], cA2w[j], cB2w[j]);
+					nbRows[index] = setupRows(ch, constantBlock[index], cA2w[j], cB2w[j], bA2w[index], bB2w[index], useExtendedLimits[index], cA2wOut[index], cB2wOut[index]);
+				}
+			}
+
+			for(; i<nbConstraints; i++)
+			{
+				const JointData& data = *reinterpret_cast<const JointData*>(constantBlock[i]);
+				ConstraintHelper ch(constraints[i], invMassScale[i], cA2w[0], cB2w[0], body0WorldOffset[i], data, bA2w[i], bB2w[i]);
+				nbRows[i] = setupRows(ch, constantBlock[i], cA2w[0], cB2w[0], bA2w[i], bB2w[i], useExtendedLimits[i], cA2wOut[i], cB2wOut[i]);
+			}
+		}
 	}
 } // namespace
 
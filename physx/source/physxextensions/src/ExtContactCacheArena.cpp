@@ -0,0 +1,219 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2023 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "extensions/PxContactCacheArenaExt.h"
+#include "foundation/PxHashMap.h"
+#include "foundation/PxUserAllocated.h"
+#include "ExtPagedAllocator.h"
+
+using namespace physx;
+using namespace immediate;
+
+namespace
+{
+	// Double-buffered cache allocator of a thread. All the allocators of an arena flip together.
+	class ThreadCacheAllocator : public PxCacheAllocator, public PxUserAllocated
+	{
+											PX_NOCOPY(ThreadCacheAllocator)
+	public:
+											ThreadCacheAllocator(PxU32 pageSize) : mBuffer(0)
+											{
+												mPages[0].setPageSize(pageSize);
+												mPages[1].setPageSize(pageSize);
+											}
+
+		virtual			PxU8*				allocateCacheData(const PxU32 byteSize)	PX_OVERRIDE	{ return mPages[mBuffer].allocate(byteSize);	}
+
+		// the data written during the previous frame is still read during the current one, so only the other buffer is recycled
+						void				flip()
+											{
+												mBuffer = 1 - mBuffer;
+												mPages[mBuffer].reset();
+											}
+
+						void				reset()
+											{
+												mPages[0].reset();
+												mPages[1].reset();
+											}
+
+						PxU64				getNbAllocatedBytes()	const	{ return mPages[0].getNbAllocatedBytes() + mPages[1].getNbAllocatedBytes();	}
+	private:
+						Ext::PagedAllocator	mPages[2];
+						PxU32				mBuffer;
+	};
+
+	struct CachedPair
+	{
+		CachedPair() : mFrame(0)	{}
+
+		PxCache		mCache;
+		PxU32		mFrame;		// Last frame the pair has been acquired
+	};
+
+	class ContactCacheArena : public PxContactCacheArenaExt, public PxUserAllocated
+	{
+											PX_NOCOPY(ContactCacheArena)
+	public:
+											ContactCacheArena(PxU32 nbThreads, PxU32 pageSize);
+		virtual								~ContactCacheArena();
+
+		// PxContactCacheArenaExt
+		virtual			void				release()	PX_OVERRIDE	{ PX_DELETE_THIS;	}
+		virtual			void				beginFrame()	PX_OVERRIDE;
+		virtual			void				acquireCaches(const PxU64* pairIds, PxU32 nbPairs, PxCache** caches)	PX_OVERRIDE;
+		virtual			PxCacheAllocator&	getAllocator(PxU32 threadIndex)	PX_OVERRIDE
+											{
+												PX_ASSERT(threadIndex<mAllocators.size());
+												return *mAllocators[threadIndex];
+											}
+		virtual			bool				generateContacts(const PxU64* pairIds, const PxGeometry* const* geom0, const PxGeometry* const* geom1,
+															const PxTransform* pose0, const PxTransform* pose1, PxU32 nbPairs, PxContactRecorder& contactRecorder,
+															PxReal contactDistance, PxReal meshContactMargin, PxReal toleranceLength)	PX_OVERRIDE;
+		virtual			void				reset()	PX_OVERRIDE;
+		virtual			PxU32				getNbThreads()	const	PX_OVERRIDE	{ return mAllocators.size();	}
+		virtual			PxU32				getNbPairs()	const	PX_OVERRIDE	{ return mPairs.size();			}
+		virtual			PxU64				getNbAllocatedBytes()	const	PX_OVERRIDE;
+		//~PxContactCacheArenaExt
+	private:
+						PxArray<ThreadCacheAllocator*>	mAllocators;
+						PxHashMap<PxU64, CachedPair>	mPairs;
+						PxArray<PxU64>					mStalePairs;
+						PxArray<PxCache*>				mTempCaches;
+						PxU32							mFrame;
+	};
+}
+
+ContactCacheArena::ContactCacheArena(PxU32 nbThreads, PxU32 pageSize) : mFrame(1)
+{
+	mAllocators.resize(nbThreads);
+	for(PxU32 i=0;i<nbThreads;i++)
+		mAllocators[i] = PX_NEW(ThreadCacheAllocator)(pageSize);
+}
+
+ContactCacheArena::~ContactCacheArena()
+{
+	for(PxU32 i=0;i<mAllocators.size();i++)
+		PX_DELETE(mAllocators[i]);
+}
+
+void ContactCacheArena::beginFrame()
+{
+	// Compaction: the pairs that have not been used during the previous frame are gone. The others have been written to
+	// the current buffer during that frame, so recycling the other buffer is safe.
+	mStalePairs.clear();
+	for(PxHashMap<PxU64, CachedPair>::Iterator iter = mPairs.getIterator(); !iter.done(); ++iter)
+	{
+		if(iter->second.mFrame != mFrame)
+			mStalePairs.pushBack(iter->first);
+	}
+
+	const PxU32 nbStalePairs = mStalePairs.size();
+	for(PxU32 i=0;i<nbStalePairs;i++)
+		mPairs.erase(mStalePairs[i]);
+
+	for(PxU32 i=0;i<mAllocators.size();i++)
+		mAllocators[i]->flip();
+
+	mFrame++;
+}
+
+void ContactCacheArena::acquireCaches(const PxU64* pairIds, PxU32 nbPairs, PxCache** caches)
+{
+	// inserting in the hashmap can move the existing entries, so the pointers are only gathered once all pairs exist
+	for(PxU32 i=0;i<nbPairs;i++)
+		mPairs[pairIds[i]].mFrame = mFrame;
+
+	for(PxU32 i=0;i<nbPairs;i++)
+	{
+		const PxHashMap<PxU64, CachedPair>::Entry* entry = mPairs.find(pairIds[i]);
+		PX_ASSERT(entry);
+		caches[i] = const_cast<PxCache*>(&entry->second.mCache);
+	}
+}
+
+bool ContactCacheArena::generateContacts(	const PxU64* pairIds, const PxGeometry* const* geom0, const PxGeometry* const* geom1,
+											const PxTransform* pose0, const PxTransform* pose1, PxU32 nbPairs, PxContactRecorder& contactRecorder,
+											PxReal contactDistance, PxReal meshContactMargin, PxReal toleranceLength)
+{
+	mTempCaches.resizeUninitialized(nbPairs);
+	acquireCaches(pairIds, nbPairs, mTempCaches.begin());
+
+	// PxGenerateContacts expects contiguous caches, so the pairs are processed one by one. The contact recorder still
+	// receives the index of the pair in the user arrays.
+	class IndexRemapper : public PxContactRecorder
+	{
+		PX_NOCOPY(IndexRemapper)
+	public:
+		IndexRemapper(PxContactRecorder& recorder) : mRecorder(recorder), mIndex(0)	{}
+
+		virtual bool recordContacts(const PxContactPoint* contactPoints, const PxU32 nbContacts, const PxU32 /*index*/)	PX_OVERRIDE
+		{
+			return mRecorder.recordContacts(contactPoints, nbContacts, mIndex);
+		}
+
+		PxContactRecorder&	mRecorder;
+		PxU32				mIndex;
+	};
+	IndexRemapper remapper(contactRecorder);
+
+	PxCacheAllocator& allocator = *mAllocators[0];
+	bool status = true;
+	for(PxU32 i=0;i<nbPairs;i++)
+	{
+		remapper.mIndex = i;
+		if(!PxGenerateContacts(geom0 + i, geom1 + i, pose0 + i, pose1 + i, mTempCaches[i], 1, remapper, contactDistance, meshContactMargin, toleranceLength, allocator))
+			status = false;
+	}
+	return status;
+}
+
+void ContactCacheArena::reset()
+{
+	mPairs.clear();
+	for(PxU32 i=0;i<mAllocators.size();i++)
+		mAllocators[i]->reset();
+}
+
+PxU64 ContactCacheArena::getNbAllocatedBytes() const
+{
+	PxU64 size = 0;
+	for(PxU32 i=0;i<mAllocators.size();i++)
+		size += mAllocators[i]->getNbAllocatedBytes();
+	return size;
+}
+
+PxContactCacheArenaExt* physx::PxCreateContactCacheArenaExt(PxU32 nbThreads, PxU32 pageSize)
+{
+	if(!nbThreads || !pageSize)
+	{
+		PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxCreateContactCacheArenaExt: nbThreads and pageSize must be non-zero.");
+		return NULL;
+	}
+	return PX_NEW(ContactCacheArena)(nbThreads, pageSize);
+}
@@ -73,6 +73,7 @@ static BVHBuildStrategy getBuildStrategy(PxBVHBuildStrategy::Enum bs)
 		case PxBVHBuildStrategy::eFAST:		return BVH_SPLATTER_POINTS;
 		case PxBVHBuildStrategy::eDEFAULT:	return BVH_SPLATTER_POINTS_SPLIT_GEOM_CENTER;
 		case PxBVHBuildStrategy::eSAH:		return BVH_SAH;
+		case PxBVHBuildStrategy::eBINNED_SAH:	return BVH_BINNED_SAH;
 		case PxBVHBuildStrategy::eLAST:		return BVH_SPLATTER_POINTS;
 	}
 	return BVH_SPLATTER_POINTS;
@@ -92,6 +93,7 @@ static Pruner* create(PxPruningStructureType::Enum type, PxU64 contextID, PxDyna
 		case PxPruningStructureType::eNONE:					{ pruner = createBucketPruner(contextID);										break;	}
 		case PxPruningStructureType::eDYNAMIC_AABB_TREE:	{ pruner = createAABBPruner(contextID, true, cpType, bs, nbObjectsPerNode);		break;	}
 		case PxPruningStructureType::eSTATIC_AABB_TREE:		{ pruner = createAABBPruner(contextID, false, cpType, bs, nbObjectsPerNode);	break;	}
+		case PxPruningStructureType::eHASH_GRID:			{ pruner = createHashGridPruner(contextID);										break;	}
 		case PxPruningStructureType::eLAST:					break;
 	}
 	return pruner;
@@ -220,6 +222,7 @@ namespace
 		virtual	PxSQCompoundHandle				addSQCompound(const PxRigidActor& actor, const PxShape** shapes, const PxBVH& pxbvh, const PxTransform* transforms);
 		virtual	void							removeSQCompound(PxSQCompoundHandle compoundHandle);
 		virtual	void							updateSQCompound(PxSQCompoundHandle compoundHandle, const PxTransform& compoundTransform);
+		virtual	void							updateSQCompounds(const PxSQCompoundHandle* compoundHandles, const PxTransform* compoundTransforms, PxU32 nbCompounds);
 		virtual	void							flushUpdates()																		{ SQ().flushUpdates();											}
 		virtual	void							flushMemory()																		{ SQ().flushMemory();											}
 		virtual	void							visualize(PxU32 prunerIndex, PxRenderOutput& out)		const						{ SQ().visualize(prunerIndex, out);							}
@@ -233,6 +236,7 @@ namespace
 		virtual	PxSceneQueryUpdateMode::Enum	getUpdateMode()											const						{ return mUpdateMode;											}
 		virtual	void							setUpdateMode(PxSceneQueryUpdateMode::Enum mode)									{ mUpdateMode = mode;											}
 		virtual	PxU32							getStaticTimestamp()									const						{ return SQ().getStaticTimestamp();							}
+		virtual	void							getDynamicTreeRefitStats(PxDynamicTreeRefitStats& stats)	const					{ SQ().getDynamicTreeRefitStats(stats);						}
 		virtual	void							merge(const PxPruningStructure& pxps);
 		virtual	bool							raycast(const PxVec3& origin, const PxVec3& unitDir, const PxReal distance,
 														PxRaycastCallback& hitCall, PxHitFlags hitFlags,
@@ -404,6 +408,12 @@ void CustomPxSQ::updateSQCompound(PxSQCompoundHandle compoundHandle, const PxTra
 	SQ().updateCompoundActor(PrunerCompoundId(compoundHandle), compoundTransform);
 }
 
+void CustomPxSQ::updateSQCompounds(const PxSQCompoundHandle* compoundHandles, const PxTransform* compoundTransforms, PxU32 nbCompounds)
+{
+	PX_COMPILE_TIME_ASSERT(sizeof(PxSQCompoundHandle)==sizeof(PrunerCompoundId));
+	SQ().updateCompoundActors(reinterpret_cast<const PrunerCompoundId*>(compoundHandles), compoundTransforms, nbCompounds);
+}
+
 PxSQBuildStepHandle CustomPxSQ::prepareSceneQueryBuildStep(PxU32 prunerIndex)
 {
 	return SQ().prepareSceneQueriesUpdate(prunerIndex);
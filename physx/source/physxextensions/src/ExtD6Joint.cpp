@@ -911,22 +911,11 @@ static void setupLinearLimit(joint::ConstraintHelper& ch, const PxJointLinearLim
 	ch.linearLimit(-axis, -origin, -limit.lower, limit);
 }
 
-//TAG:solverprepshader
-static PxU32 D6JointSolverPrep(Px1DConstraint* constraints,
-	PxVec3p& body0WorldOffset,
-	PxU32 /*maxConstraints*/,
-	PxConstraintInvMassScale& invMassScale,
-	const void* constantBlock,
-	const PxTransform& bA2w,
-	const PxTransform& bB2w,
-	bool useExtendedLimits,
-	PxVec3p& cA2wOut, PxVec3p& cB2wOut)
+static PxU32 setupD6JointRows(joint::ConstraintHelper& ch, const void* constantBlock, PxTransform& cA2w, PxTransform& cB2w,
+	const PxTransform& bA2w, const PxTransform& bB2w, bool useExtendedLimits, PxVec3p& cA2wOut, PxVec3p& cB2wOut)
 {
 	const D6JointData& data = *reinterpret_cast<const D6JointData*>(constantBlock);
 
-	PxTransform cA2w, cB2w;
-	joint::ConstraintHelper ch(constraints, invMassScale, cA2w, cB2w, body0WorldOffset, data, bA2w, bB2w);
-
 	const PxU32 SWING1_FLAG = 1<<PxD6Axis::eSWING1;
 	const PxU32 SWING2_FLAG = 1<<PxD6Axis::eSWING2;
 	const PxU32 TWIST_FLAG = 1<<PxD6Axis::eTWIST;
@@ -1128,9 +1117,28 @@ static PxU32 D6JointSolverPrep(Px1DConstraint* constraints,
 	return ch.getCount();
 }
 
+//TAG:solverprepshader
+static PxU32 D6JointSolverPrep(Px1DConstraint* constraints,
+	PxVec3p& body0WorldOffset,
+	PxU32 /*maxConstraints*/,
+	PxConstraintInvMassScale& invMassScale,
+	const void* constantBlock,
+	const PxTransform& bA2w,
+	const PxTransform& bB2w,
+	bool useExtendedLimits,
+	PxVec3p& cA2wOut, PxVec3p& cB2wOut)
+{
+	const D6JointData& data = *reinterpret_cast<const D6JointData*>(constantBlock);
+
+	PxTransform cA2w, cB2w;
+	joint::ConstraintHelper ch(constraints, invMassScale, cA2w, cB2w, body0WorldOffset, data, bA2w, bB2w);
+
+	return setupD6JointRows(ch, constantBlock, cA2w, cB2w, bA2w, bB2w, useExtendedLimits, cA2wOut, cB2wOut);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
-static PxConstraintShaderTable gD6JointShaders = { D6JointSolverPrep, D6JointProject, D6JointVisualize, /*PxConstraintFlag::Enum(0)*/PxConstraintFlag::eGPU_COMPATIBLE };
+static PxConstraintShaderTable gD6JointShaders = { D6JointSolverPrep, D6JointProject, D6JointVisualize, /*PxConstraintFlag::Enum(0)*/PxConstraintFlag::eGPU_COMPATIBLE, joint::solverPrepBatch<setupD6JointRows> };
 
 PxConstraintSolverPrep D6Joint::getPrep()	const	{ return gD6JointShaders.solverPrep; }
 
@@ -98,6 +98,20 @@ static void FixedJointVisualize(PxConstraintVisualizer& viz, const void* constan
 	}
 }
 
+static PxU32 setupFixedJointRows(joint::ConstraintHelper& ch, const void* /*constantBlock*/, PxTransform& cA2w, PxTransform& cB2w,
+	const PxTransform& bA2w, const PxTransform& bB2w, bool /*useExtendedLimits*/, PxVec3p& cA2wOut, PxVec3p& cB2wOut)
+{
+	if (cA2w.q.dot(cB2w.q)<0.0f)	// minimum dist quat (equiv to flipping cB2bB.q, which we don't use anywhere)
+		cB2w.q = -cB2w.q;
+
+	PxVec3 ra, rb;
+	ch.prepareLockedAxes(cA2w.q, cB2w.q, cA2w.transformInv(cB2w.p), 7, 7, ra, rb);
+	cA2wOut = ra + bA2w.p;
+	cB2wOut = rb + bB2w.p;
+
+	return ch.getCount();
+}
+
 //TAG:solverprepshader
 static PxU32 FixedJointSolverPrep(Px1DConstraint* constraints,
 	PxVec3p& body0WorldOffset,
@@ -106,7 +120,7 @@ static PxU32 FixedJointSolverPrep(Px1DConstraint* constraints,
 	const void* constantBlock,
 	const PxTransform& bA2w,
 	const PxTransform& bB2w,
-	bool /*useExtendedLimits*/,
+	bool useExtendedLimits,
 	PxVec3p& cA2wOut, PxVec3p& cB2wOut)
 {
 	const FixedJointData& data = *reinterpret_cast<const FixedJointData*>(constantBlock);
@@ -114,20 +128,12 @@ static PxU32 FixedJointSolverPrep(Px1DConstraint* constraints,
 	PxTransform cA2w, cB2w;
 	joint::ConstraintHelper ch(constraints, invMassScale, cA2w, cB2w, body0WorldOffset, data, bA2w, bB2w);
 
-	if (cA2w.q.dot(cB2w.q)<0.0f)	// minimum dist quat (equiv to flipping cB2bB.q, which we don't use anywhere)
-		cB2w.q = -cB2w.q;
-
-	PxVec3 ra, rb;
-	ch.prepareLockedAxes(cA2w.q, cB2w.q, cA2w.transformInv(cB2w.p), 7, 7, ra, rb);
-	cA2wOut = ra + bA2w.p;
-	cB2wOut = rb + bB2w.p;
-
-	return ch.getCount();
+	return setupFixedJointRows(ch, constantBlock, cA2w, cB2w, bA2w, bB2w, useExtendedLimits, cA2wOut, cB2wOut);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
-static PxConstraintShaderTable gFixedJointShaders = { FixedJointSolverPrep, FixedJointProject, FixedJointVisualize, PxConstraintFlag::Enum(0) };
+static PxConstraintShaderTable gFixedJointShaders = { FixedJointSolverPrep, FixedJointProject, FixedJointVisualize, PxConstraintFlag::Enum(0), joint::solverPrepBatch<setupFixedJointRows> };
 
 PxConstraintSolverPrep FixedJoint::getPrep()	const	{ return gFixedJointShaders.solverPrep;  }
 
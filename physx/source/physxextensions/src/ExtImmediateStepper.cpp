@@ -0,0 +1,1242 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2023 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "extensions/PxImmediateStepperExt.h"
+#include "geometry/PxGeometryQuery.h"
+#include "foundation/PxAtomic.h"
+#include "foundation/PxHashMap.h"
+#include "foundation/PxSort.h"
+#include "foundation/PxUserAllocated.h"
+#include "task/PxCpuDispatcher.h"
+#include "ExtPagedAllocator.h"
+#include "GuParallelJobs.h"
+
+using namespace physx;
+using namespace immediate;
+
+// size of the pages used by the per-thread allocators
+static const PxU32 gPageSize = 64 * 1024;
+
+// small islands are packed together into work items of at least this many bodies, to amortize the per-call overhead
+// of the immediate mode functions. Independent islands can safely be batched and solved together.
+static const PxU32 gMinBodiesPerWorkItem = 64;
+
+// minimum number of shapes per bounds job
+static const PxU32 gMinShapesPerJob = 256;
+
+namespace
+{
+	// Persistent data of a shape pair, kept as long as the broadphase reports the pair
+	struct PairCache
+	{
+		PairCache() : mFrictions(NULL), mNbFrictions(0), mTimestamp(0)	{}
+
+		PxCache		mCache;
+		PxU8*		mFrictions;
+		PxU32		mNbFrictions;
+		PxU32		mTimestamp;
+	};
+
+	// Broadphase pair ready for contact generation. Shape 0 always belongs to a dynamic body.
+	struct ShapePair
+	{
+		PxU32		mShape0;
+		PxU32		mShape1;
+		PairCache*	mCache;
+	};
+
+	// Shape pair with contacts. The contacts live in the context of the thread that generated them.
+	struct ContactPair
+	{
+		PairCache*	mCache;
+		PxU32		mBody0;			// Always dynamic
+		PxU32		mBody1;			// Dynamic or static
+		PxU32		mContext;
+		PxU32		mStartContact;
+		PxU32		mNbContacts;
+	};
+
+	// Per-thread allocators and scratch buffers
+	struct ThreadContext : public PxCacheAllocator, public PxConstraintAllocator, public PxUserAllocated
+	{
+											ThreadContext() : mBuffer(0)
+											{
+												mCacheData[0].setPageSize(gPageSize);
+												mCacheData[1].setPageSize(gPageSize);
+												mFrictionData[0].setPageSize(gPageSize);
+												mFrictionData[1].setPageSize(gPageSize);
+												mConstraintData.setPageSize(gPageSize);
+											}
+
+		// PxCacheAllocator
+		virtual			PxU8*				allocateCacheData(const PxU32 byteSize)		PX_OVERRIDE	{ return mCacheData[mBuffer].allocate(byteSize);		}
+		// PxConstraintAllocator
+		virtual			PxU8*				reserveConstraintData(const PxU32 byteSize)	PX_OVERRIDE	{ return mConstraintData.allocate(byteSize);			}
+		virtual			PxU8*				reserveFrictionData(const PxU32 byteSize)	PX_OVERRIDE	{ return mFrictionData[mBuffer].allocate(byteSize);	}
+
+		// contact caches and friction patches are read back during the next step, so they are double-buffered.
+		// Constraint rows only live until the end of the island solve.
+						void				flip()
+											{
+												mBuffer = 1 - mBuffer;
+												mCacheData[mBuffer].reset();
+												mFrictionData[mBuffer].reset();
+												mConstraintData.reset();
+												mTouchingPairs.clear();
+												mContacts.clear();
+											}
+
+						Ext::PagedAllocator	mCacheData[2];
+						Ext::PagedAllocator	mFrictionData[2];
+						Ext::PagedAllocator	mConstraintData;
+						PxU32				mBuffer;
+
+		// Contact generation output
+						PxArray<ContactPair>				mTouchingPairs;
+						PxArray<PxContactPoint>				mContacts;
+
+		// Island solver scratch
+						PxArray<PxTransform>				mStaticPoses;
+						PxArray<PxRigidBodyData>			mRigidData;
+						PxArray<PxSolverConstraintDesc>		mDescs;
+						PxArray<PxSolverConstraintDesc>		mOrderedDescs;
+						PxArray<PxConstraintBatchHeader>	mHeaders;
+						PxArray<PxReal>						mContactForces;
+
+						PxArray<PxSolverBody>				mBodies;
+						PxArray<PxSolverBodyData>			mBodyData;
+						PxArray<PxVec3>						mLinearMotion;
+						PxArray<PxVec3>						mAngularMotion;
+
+						PxArray<PxTGSSolverBodyVel>			mBodiesTGS;
+						PxArray<PxTGSSolverBodyTxInertia>	mTxInertiasTGS;
+						PxArray<PxTGSSolverBodyData>		mBodyDataTGS;
+						PxArray<PxTransform>				mPosesTGS;
+	};
+
+	class ContactRecorder : public PxContactRecorder
+	{
+											PX_NOCOPY(ContactRecorder)
+	public:
+											ContactRecorder(PxArray<PxContactPoint>& contacts, const PxVec3& material) :
+												mContacts(contacts), mMaterial(material), mNbContacts(0)	{}
+
+		virtual			bool				recordContacts(const PxContactPoint* contactPoints, const PxU32 nbContacts, const PxU32 index)	PX_OVERRIDE
+											{
+												PX_UNUSED(index);
+												for(PxU32 i=0;i<nbContacts;i++)
+												{
+													PxContactPoint& point = mContacts.insert();
+													point = contactPoints[i];
+													point.maxImpulse		= PX_MAX_F32;
+													point.targetVel			= PxVec3(0.0f);
+													point.staticFriction	= mMaterial.x;
+													point.dynamicFriction	= mMaterial.y;
+													point.restitution		= mMaterial.z;
+													point.materialFlags		= 0;
+													point.damping			= 0.0f;
+												}
+												mNbContacts += nbContacts;
+												return true;
+											}
+
+						PxArray<PxContactPoint>&	mContacts;
+		const			PxVec3				mMaterial;
+						PxU32				mNbContacts;
+	};
+
+	// Default broadphase, a PxAABBManager whose incremental results are turned into the full set of current pairs
+	class DefaultBroadPhase : public PxImmediateBroadPhaseExt, public PxUserAllocated
+	{
+											PX_NOCOPY(DefaultBroadPhase)
+	public:
+											DefaultBroadPhase() : mBroadPhase(NULL), mManager(NULL)	{}
+		virtual								~DefaultBroadPhase()	{ reset();	}
+
+		virtual			void				findPairs(PxU32 nbShapes, const PxBounds3* bounds, const PxBpFilterGroup* groups, PxArray<PxBroadPhasePair>& pairs)	PX_OVERRIDE;
+		virtual			void				reset()	PX_OVERRIDE
+											{
+												PX_RELEASE(mManager);
+												PX_RELEASE(mBroadPhase);
+												mGroups.reset();
+												mPairs.reset();
+												mPairIndices.clear();
+											}
+	private:
+		static PX_FORCE_INLINE	PxU64		getPairKey(PxU32 id0, PxU32 id1)
+											{
+												return id0<id1 ? (PxU64(id0)<<32)|id1 : (PxU64(id1)<<32)|id0;
+											}
+
+						PxBroadPhase*				mBroadPhase;
+						PxAABBManager*				mManager;
+						PxArray<PxBpFilterGroup>	mGroups;
+						PxArray<PxBroadPhasePair>	mPairs;
+						PxHashMap<PxU64, PxU32>		mPairIndices;
+	};
+
+	class ImmediateStepper : public PxImmediateStepperExt, public PxUserAllocated
+	{
+											PX_NOCOPY(ImmediateStepper)
+	public:
+		enum Stage
+		{
+			eBOUNDS,
+			eCONTACTS,
+			eISLANDS
+		};
+
+											ImmediateStepper(const PxImmediateStepperDescExt& desc);
+		virtual								~ImmediateStepper();
+
+						bool				init();
+
+		// PxImmediateStepperExt
+		virtual			void				release()	PX_OVERRIDE	{ PX_DELETE_THIS;	}
+		virtual			bool				step(const PxImmediateSceneDataExt& data, PxReal dt)	PX_OVERRIDE;
+		virtual			void				resetContactCaches()	PX_OVERRIDE;
+		virtual	const	PxImmediateStepperStatsExt&	getStats()	const	PX_OVERRIDE	{ return mStats;	}
+		//~PxImmediateStepperExt
+
+	private:
+						bool				validate(const PxImmediateSceneDataExt& data)	const;
+		static			void				stageJob(void* userData, PxU32 jobIndex);
+						void				runStage(Stage stage, PxU32 nbJobs, PxU32 nbItems);
+						void				computeBounds(PxU32 start, PxU32 end);
+						void				gatherShapePairs();
+						void				generateContacts(PxU32 contextIndex, PxU32 start, PxU32 end);
+						void				buildIslands();
+						void				solveWorkItem(PxU32 contextIndex, PxU32 itemIndex);
+						void				solveWorkItemPGS(ThreadContext& context, PxU32 itemIndex);
+						void				solveWorkItemTGS(ThreadContext& context, PxU32 itemIndex);
+						PxU32				setupConstraints(ThreadContext& context, PxU32 itemIndex, PxU32& nbStaticSlots);
+
+		PX_FORCE_INLINE	PxTransform			getShapePose(PxU32 shapeIndex)	const
+											{
+												const PxTransform& bodyPose = mData->bodyPoses[mData->shapeBodies[shapeIndex]];
+												return mData->shapeLocalPoses ? bodyPose.transform(mData->shapeLocalPoses[shapeIndex]) : bodyPose;
+											}
+		PX_FORCE_INLINE	bool				isDynamic(PxU32 bodyIndex)	const	{ return bodyIndex < mData->nbDynamicBodies;	}
+
+		const			PxImmediateStepperDescExt	mDesc;
+						DefaultBroadPhase*			mDefaultBroadPhase;
+						PxImmediateBroadPhaseExt*	mBroadPhase;
+
+						ThreadContext**				mContexts;
+						PxU32						mNbContexts;
+
+		// Current step
+		const			PxImmediateSceneDataExt*	mData;
+						PxReal						mDt;
+						Stage						mStage;
+						PxU32						mNbJobs;
+						PxU32						mNbStageItems;
+						volatile PxI32				mNextItem;
+						PxU32						mTimestamp;
+
+						PxArray<PxBounds3>			mBounds;
+						PxArray<PxBpFilterGroup>	mGroups;
+						PxArray<PxBroadPhasePair>	mBroadPhasePairs;
+						PxHashMap<PxU64, PairCache>	mPairCaches;
+						PxArray<PxU64>				mStalePairs;
+						PxArray<ShapePair>			mShapePairs;
+
+		// Islands, as work items made of one or more islands. Bodies, contact pairs and joints are sorted by work item.
+						PxArray<PxU32>				mParents;
+						PxArray<PxU32>				mIslandOfBody;
+						PxArray<PxU32>				mItemOfIsland;
+						PxArray<PxU32>				mLocalIndices;
+						PxArray<PxU32>				mItemBodies;
+						PxArray<PxU32>				mItemBodyStart;
+						PxArray<ContactPair>		mItemContacts;
+						PxArray<PxU32>				mItemContactStart;
+						PxArray<PxU32>				mItemJoints;
+						PxArray<PxU32>				mItemJointStart;
+
+						PxImmediateStepperStatsExt	mStats;
+	};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static bool groupsChanged(const PxArray<PxBpFilterGroup>& currentGroups, PxU32 nbShapes, const PxBpFilterGroup* groups)
+{
+	if(currentGroups.size()!=nbShapes)
+		return true;
+	for(PxU32 i=0;i<nbShapes;i++)
+	{
+		if(currentGroups[i]!=groups[i])
+			return true;
+	}
+	return false;
+}
+
+void DefaultBroadPhase::findPairs(PxU32 nbShapes, const PxBounds3* bounds, const PxBpFilterGroup* groups, PxArray<PxBroadPhasePair>& pairs)
+{
+	// the filter group of an object cannot be changed, so we start from scratch when the set of shapes changes
+	if(mManager && groupsChanged(mGroups, nbShapes, groups))
+		reset();
+
+	if(!mManager)
+	{
+		mBroadPhase = PxCreateBroadPhase(PxBroadPhaseDesc(PxBroadPhaseType::eABP));
+		if(!mBroadPhase)
+			return;
+		mManager = PxCreateAABBManager(*mBroadPhase);
+		if(!mManager)
+		{
+			PX_RELEASE(mBroadPhase);
+			return;
+		}
+
+		mGroups.resize(nbShapes);
+		for(PxU32 i=0;i<nbShapes;i++)
+		{
+			mGroups[i] = groups[i];
+			mManager->addObject(i, bounds[i], groups[i]);
+		}
+	}
+	else
+	{
+		// only send the objects that actually moved, so that static shapes don't cost anything
+		const PxBounds3* currentBounds = mManager->getBounds();
+		for(PxU32 i=0;i<nbShapes;i++)
+		{
+			if(currentBounds[i].minimum!=bounds[i].minimum || currentBounds[i].maximum!=bounds[i].maximum)
+				mManager->updateObject(i, bounds + i);
+		}
+	}
+
+	PxBroadPhaseResults results;
+	mManager->update(results);
+
+	for(PxU32 i=0;i<results.mNbDeletedPairs;i++)
+	{
+		const PxBroadPhasePair& pair = results.mDeletedPairs[i];
+		PxHashMap<PxU64, PxU32>::Entry entry;
+		if(mPairIndices.erase(getPairKey(pair.mID0, pair.mID1), entry))
+		{
+			const PxU32 index = entry.second;
+			mPairs.replaceWithLast(index);
+			if(index<mPairs.size())
+				mPairIndices[getPairKey(mPairs[index].mID0, mPairs[index].mID1)] = index;
+		}
+	}
+
+	for(PxU32 i=0;i<results.mNbCreatedPairs;i++)
+	{
+		const PxBroadPhasePair& pair = results.mCreatedPairs[i];
+		if(mPairIndices.insert(getPairKey(pair.mID0, pair.mID1), mPairs.size()))
+			mPairs.pushBack(pair);
+	}
+
+	pairs.resize(mPairs.size());
+	if(mPairs.size())
+		PxMemCopy(pairs.begin(), mPairs.begin(), sizeof(PxBroadPhasePair)*mPairs.size());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+ImmediateStepper::ImmediateStepper(const PxImmediateStepperDescExt& desc) :
+	mDesc				(desc),
+	mDefaultBroadPhase	(NULL),
+	mBroadPhase			(desc.broadPhase),
+	mContexts			(NULL),
+	mNbContexts			(0),
+	mData				(NULL),
+	mDt					(0.0f),
+	mStage				(eBOUNDS),
+	mNbJobs				(0),
+	mNbStageItems		(0),
+	mNextItem			(0),
+	mTimestamp			(0)
+{
+	PxMemZero(&mStats, sizeof(PxImmediateStepperStatsExt));
+}
+
+ImmediateStepper::~ImmediateStepper()
+{
+	for(PxU32 i=0;i<mNbContexts;i++)
+		PX_DELETE(mContexts[i]);
+	PX_FREE(mContexts);
+
+	PX_DELETE(mDefaultBroadPhase);
+}
+
+bool ImmediateStepper::init()
+{
+	if(!mBroadPhase)
+	{
+		mDefaultBroadPhase = PX_NEW(DefaultBroadPhase);
+		mBroadPhase = mDefaultBroadPhase;
+	}
+
+	// One job and one context per worker thread, plus one for the calling thread
+	const PxU32 nbContexts = mDesc.cpuDispatcher ? mDesc.cpuDispatcher->getWorkerCount() + 1 : 1u;
+
+	mContexts = PX_ALLOCATE(ThreadContext*, nbContexts, "ThreadContext");
+	if(!mContexts)
+		return false;
+
+	for(PxU32 i=0;i<nbContexts;i++)
+		mContexts[i] = PX_NEW(ThreadContext);
+	mNbContexts = nbContexts;
+	return true;
+}
+
+void ImmediateStepper::resetContactCaches()
+{
+	mPairCaches.clear();
+	mBroadPhase->reset();
+}
+
+bool ImmediateStepper::validate(const PxImmediateSceneDataExt& data) const
+{
+	if(data.nbDynamicBodies > data.nbBodies)
+		return false;
+	if(data.nbBodies && !data.bodyPoses)
+		return false;
+	if(data.nbDynamicBodies && (!data.linearVelocities || !data.angularVelocities || !data.invMasses || !data.invInertias))
+		return false;
+	if(data.nbShapes && (!data.shapeGeometries || !data.shapeBodies))
+		return false;
+	if(data.nbJoints && (!data.jointConstraints || !data.jointBodies0 || !data.jointBodies1))
+		return false;
+#if PX_CHECKED
+	for(PxU32 i=0;i<data.nbShapes;i++)
+	{
+		if(data.shapeBodies[i] >= data.nbBodies)
+			return false;
+	}
+	for(PxU32 i=0;i<data.nbJoints;i++)
+	{
+		if((data.jointBodies0[i] >= data.nbBodies && data.jointBodies0[i] != 0xffffffff) || (data.jointBodies1[i] >= data.nbBodies && data.jointBodies1[i] != 0xffffffff))
+			return false;
+	}
+#endif
+	return true;
+}
+
+// Job i uses the i-th thread context. The runJobs call of a stage never runs more than mNbContexts jobs.
+void ImmediateStepper::stageJob(void* userData, PxU32 jobIndex)
+{
+	ImmediateStepper* stepper = reinterpret_cast<ImmediateStepper*>(userData);
+	const PxU32 nbItems = stepper->mNbStageItems;
+
+	if(stepper->mStage==eISLANDS)
+	{
+		// islands have very different sizes, so threads grab work items one by one. Items are sorted by decreasing size.
+		for(;;)
+		{
+			const PxU32 itemIndex = PxU32(PxAtomicIncrement(&stepper->mNextItem) - 1);
+			if(itemIndex >= nbItems)
+				break;
+			stepper->solveWorkItem(jobIndex, itemIndex);
+		}
+		return;
+	}
+
+	const PxU32 nbJobs = stepper->mNbJobs;
+	const PxU32 nbPerJob = nbItems / nbJobs;
+	const PxU32 remainder = nbItems - nbPerJob * nbJobs;
+	const PxU32 start = jobIndex * nbPerJob + PxMin(jobIndex, remainder);
+	const PxU32 end = start + nbPerJob + (jobIndex < remainder ? 1u : 0u);
+
+	if(stepper->mStage==eBOUNDS)
+		stepper->computeBounds(start, end);
+	else
+		stepper->generateContacts(jobIndex, start, end);
+}
+
+void ImmediateStepper::runStage(Stage stage, PxU32 nbJobs, PxU32 nbItems)
+{
+	mStage = stage;
+	mNbStageItems = nbItems;
+	mNextItem = 0;
+	mNbJobs = PxClamp(nbJobs, 1u, mNbContexts);
+
+	Gu::runJobs(mDesc.cpuDispatcher, stageJob, this, mNbJobs);
+}
+
+void ImmediateStepper::computeBounds(PxU32 start, PxU32 end)
+{
+	const PxImmediateSceneDataExt& data = *mData;
+	const PxBpFilterGroup staticGroup = PxGetBroadPhaseStaticFilterGroup();
+	for(PxU32 i=start;i<end;i++)
+	{
+		const PxU32 bodyIndex = data.shapeBodies[i];
+		PxGeometryQuery::computeGeomBounds(mBounds[i], *data.shapeGeometries[i], getShapePose(i), mDesc.contactDistance);
+		mGroups[i] = isDynamic(bodyIndex) ? PxGetBroadPhaseDynamicFilterGroup(bodyIndex) : staticGroup;
+	}
+}
+
+void ImmediateStepper::gatherShapePairs()
+{
+	const PxImmediateSceneDataExt& data = *mData;
+	const PxU32 nbPairs = mBroadPhasePairs.size();
+
+	// create or retrieve the persistent data of each pair. This is done first, since inserting in the hashmap can
+	// move its entries around.
+	mShapePairs.clear();
+	mShapePairs.reserve(nbPairs);
+	for(PxU32 i=0;i<nbPairs;i++)
+	{
+		PxU32 shape0 = mBroadPhasePairs[i].mID0;
+		PxU32 shape1 = mBroadPhasePairs[i].mID1;
+		if(shape0 >= data.nbShapes || shape1 >= data.nbShapes)
+			continue;
+
+		const PxU32 body0 = data.shapeBodies[shape0];
+		const PxU32 body1 = data.shapeBodies[shape1];
+		if(body0==body1 || (!isDynamic(body0) && !isDynamic(body1)))
+			continue;
+
+		// Dynamic shape first
+		if(!isDynamic(body0))
+			PxSwap(shape0, shape1);
+
+		mPairCaches[(PxU64(shape0)<<32)|shape1];
+
+		ShapePair& pair = mShapePairs.insert();
+		pair.mShape0 = shape0;
+		pair.mShape1 = shape1;
+		pair.mCache = NULL;
+	}
+
+	// discard pairs that are not overlapping anymore
+	mTimestamp++;
+	mStalePairs.clear();
+	const PxU32 nbShapePairs = mShapePairs.size();
+	for(PxU32 i=0;i<nbShapePairs;i++)
+	{
+		ShapePair& pair = mShapePairs[i];
+		PairCache* pairCache = &mPairCaches[(PxU64(pair.mShape0)<<32)|pair.mShape1];
+		pairCache->mTimestamp = mTimestamp;
+		pair.mCache = pairCache;
+	}
+	for(PxHashMap<PxU64, PairCache>::Iterator iter = mPairCaches.getIterator(); !iter.done(); ++iter)
+	{
+		if(iter->second.mTimestamp != mTimestamp)
+			mStalePairs.pushBack(iter->first);
+	}
+	for(PxU32 i=0;i<mStalePairs.size();i++)
+		mPairCaches.erase(mStalePairs[i]);
+
+	// erasing moves entries around too, refresh the pointers
+	if(mStalePairs.size())
+	{
+		for(PxU32 i=0;i<nbShapePairs;i++)
+		{
+			ShapePair& pair = mShapePairs[i];
+			pair.mCache = &mPairCaches[(PxU64(pair.mShape0)<<32)|pair.mShape1];
+		}
+	}
+}
+
+void ImmediateStepper::generateContacts(PxU32 contextIndex, PxU32 start, PxU32 end)
+{
+	const PxImmediateSceneDataExt& data = *mData;
+	ThreadContext& context = *mContexts[contextIndex];
+
+	for(PxU32 i=start;i<end;i++)
+	{
+		const ShapePair& pair = mShapePairs[i];
+		PairCache& pairCache = *pair.mCache;
+
+		const PxGeometry* geom0 = data.shapeGeometries[pair.mShape0];
+		const PxGeometry* geom1 = data.shapeGeometries[pair.mShape1];
+		const PxTransform pose0 = getShapePose(pair.mShape0);
+		const PxTransform pose1 = getShapePose(pair.mShape1);
+
+		// PhysX' default combine mode for materials is the average
+		const PxVec3 material = data.shapeMaterials ? (data.shapeMaterials[pair.mShape0] + data.shapeMaterials[pair.mShape1])*0.5f : mDesc.defaultMaterial;
+
+		const PxU32 startContact = context.mContacts.size();
+		ContactRecorder recorder(context.mContacts, material);
+		PxGenerateContacts(&geom0, &geom1, &pose0, &pose1, &pairCache.mCache, 1, recorder,
+							mDesc.contactDistance, mDesc.meshContactMargin, mDesc.toleranceLength, context);
+
+		if(!recorder.mNbContacts)
+		{
+			// No touch, the friction patches are meaningless next time
+			pairCache.mFrictions = NULL;
+			pairCache.mNbFrictions = 0;
+			continue;
+		}
+
+		ContactPair& contactPair = context.mTouchingPairs.insert();
+		contactPair.mCache			= &pairCache;
+		contactPair.mBody0			= data.shapeBodies[pair.mShape0];
+		contactPair.mBody1			= data.shapeBodies[pair.mShape1];
+		contactPair.mContext		= contextIndex;
+		contactPair.mStartContact	= startContact;
+		contactPair.mNbContacts		= recorder.mNbContacts;
+	}
+}
+
+static PX_FORCE_INLINE PxU32 findRoot(PxU32* parents, PxU32 index)
+{
+	while(parents[index]!=index)
+	{
+		parents[index] = parents[parents[index]];
+		index = parents[index];
+	}
+	return index;
+}
+
+static PX_FORCE_INLINE void unionBodies(PxU32* parents, PxU32 index0, PxU32 index1)
+{
+	const PxU32 root0 = findRoot(parents, index0);
+	const PxU32 root1 = findRoot(parents, index1);
+	if(root0!=root1)
+	{
+		// Deterministic: the smallest index becomes the root
+		if(root0<root1)
+			parents[root1] = root0;
+		else
+			parents[root0] = root1;
+	}
+}
+
+namespace
+{
+	struct IslandSize
+	{
+		PxU32	mIsland;
+		PxU32	mNbBodies;
+	};
+
+	struct IslandSizeGreater
+	{
+		PX_FORCE_INLINE bool operator()(const IslandSize& a, const IslandSize& b) const
+		{
+			return a.mNbBodies > b.mNbBodies || (a.mNbBodies == b.mNbBodies && a.mIsland < b.mIsland);
+		}
+	};
+}
+
+void ImmediateStepper::buildIslands()
+{
+	const PxImmediateSceneDataExt& data = *mData;
+	const PxU32 nbDynamics = data.nbDynamicBodies;
+
+	// Union-find over dynamic bodies. Static bodies and the world frame don't connect islands.
+	mParents.resize(nbDynamics);
+	PxU32* parents = mParents.begin();
+	for(PxU32 i=0;i<nbDynamics;i++)
+		parents[i] = i;
+
+	PxU32 nbTouchingPairs = 0;
+	PxU32 nbContacts = 0;
+	for(PxU32 c=0;c<mNbContexts;c++)
+	{
+		const ThreadContext& context = *mContexts[c];
+		const PxU32 nb = context.mTouchingPairs.size();
+		for(PxU32 i=0;i<nb;i++)
+		{
+			const ContactPair& pair = context.mTouchingPairs[i];
+			if(isDynamic(pair.mBody1))
+				unionBodies(parents, pair.mBody0, pair.mBody1);
+		}
+		nbTouchingPairs += nb;
+		nbContacts += context.mContacts.size();
+	}
+
+	for(PxU32 i=0;i<data.nbJoints;i++)
+	{
+		const PxU32 body0 = data.jointBodies0[i];
+		const PxU32 body1 = data.jointBodies1[i];
+		if(isDynamic(body0) && isDynamic(body1))
+			unionBodies(parents, body0, body1);
+	}
+
+	// Island indices, in order of appearance of their roots
+	mIslandOfBody.resize(nbDynamics);
+	PxArray<IslandSize> islandSizes;
+	for(PxU32 i=0;i<nbDynamics;i++)
+	{
+		const PxU32 root = findRoot(parents, i);
+		if(root==i)
+		{
+			mIslandOfBody[i] = islandSizes.size();
+			IslandSize& size = islandSizes.insert();
+			size.mIsland = islandSizes.size() - 1;
+			size.mNbBodies = 0;
+		}
+		else
+		{
+			// The root has a smaller index, so it has been processed already
+			mIslandOfBody[i] = mIslandOfBody[root];
+		}
+		islandSizes[mIslandOfBody[i]].mNbBodies++;
+	}
+	const PxU32 nbIslands = islandSizes.size();
+
+	// Pack islands into work items, largest first
+	if(nbIslands)
+		PxSort(islandSizes.begin(), nbIslands, IslandSizeGreater());
+
+	mItemOfIsland.resize(nbIslands);
+	PxU32 nbItems = 0;
+	PxU32 nbBodiesInItem = 0;
+	for(PxU32 i=0;i<nbIslands;i++)
+	{
+		if(nbBodiesInItem >= gMinBodiesPerWorkItem)
+		{
+			nbItems++;
+			nbBodiesInItem = 0;
+		}
+		mItemOfIsland[islandSizes[i].mIsland] = nbItems;
+		nbBodiesInItem += islandSizes[i].mNbBodies;
+	}
+	if(nbBodiesInItem)
+		nbItems++;
+
+	// Counting sorts of bodies, contact pairs and joints by work item
+	mItemBodyStart.resize(nbItems + 1);
+	mItemContactStart.resize(nbItems + 1);
+	mItemJointStart.resize(nbItems + 1);
+	PxMemZero(mItemBodyStart.begin(), sizeof(PxU32)*(nbItems + 1));
+	PxMemZero(mItemContactStart.begin(), sizeof(PxU32)*(nbItems + 1));
+	PxMemZero(mItemJointStart.begin(), sizeof(PxU32)*(nbItems + 1));
+
+	for(PxU32 i=0;i<nbDynamics;i++)
+		mItemBodyStart[mItemOfIsland[mIslandOfBody[i]] + 1]++;
+	for(PxU32 c=0;c<mNbContexts;c++)
+	{
+		const ThreadContext& context = *mContexts[c];
+		for(PxU32 i=0;i<context.mTouchingPairs.size();i++)
+			mItemContactStart[mItemOfIsland[mIslandOfBody[context.mTouchingPairs[i].mBody0]] + 1]++;
+	}
+	for(PxU32 i=0;i<data.nbJoints;i++)
+	{
+		const PxU32 body = isDynamic(data.jointBodies0[i]) ? data.jointBodies0[i] : data.jointBodies1[i];
+		if(isDynamic(body))
+			mItemJointStart[mItemOfIsland[mIslandOfBody[body]] + 1]++;
+	}
+
+	for(PxU32 i=0;i<nbItems;i++)
+	{
+		mItemBodyStart[i + 1] += mItemBodyStart[i];
+		mItemContactStart[i + 1] += mItemContactStart[i];
+		mItemJointStart[i + 1] += mItemJointStart[i];
+	}
+
+	// the start arrays are used as write cursors, then shifted back
+	mItemBodies.resize(nbDynamics);
+	mItemContacts.resize(nbTouchingPairs);
+	mItemJoints.resize(mItemJointStart[nbItems]);
+
+	for(PxU32 i=0;i<nbDynamics;i++)
+		mItemBodies[mItemBodyStart[mItemOfIsland[mIslandOfBody[i]]]++] = i;
+	for(PxU32 c=0;c<mNbContexts;c++)
+	{
+		const ThreadContext& context = *mContexts[c];
+		for(PxU32 i=0;i<context.mTouchingPairs.size();i++)
+		{
+			const ContactPair& pair = context.mTouchingPairs[i];
+			mItemContacts[mItemContactStart[mItemOfIsland[mIslandOfBody[pair.mBody0]]]++] = pair;
+		}
+	}
+	for(PxU32 i=0;i<data.nbJoints;i++)
+	{
+		const PxU32 body = isDynamic(data.jointBodies0[i]) ? data.jointBodies0[i] : data.jointBodies1[i];
+		if(isDynamic(body))
+			mItemJoints[mItemJointStart[mItemOfIsland[mIslandOfBody[body]]]++] = i;
+	}
+
+	for(PxU32 i=nbItems;i>0;i--)
+	{
+		mItemBodyStart[i] = mItemBodyStart[i - 1];
+		mItemContactStart[i] = mItemContactStart[i - 1];
+		mItemJointStart[i] = mItemJointStart[i - 1];
+	}
+	mItemBodyStart[0] = 0;
+	mItemContactStart[0] = 0;
+	mItemJointStart[0] = 0;
+
+	mLocalIndices.resize(nbDynamics);
+
+	mStats.nbTouchingPairs	= nbTouchingPairs;
+	mStats.nbContacts		= nbContacts;
+	mStats.nbIslands		= nbIslands;
+	mStats.largestIsland	= nbIslands ? islandSizes[0].mNbBodies : 0;
+	mNbStageItems			= nbItems;
+}
+
+// fills the body data and the constraint descs of a work item. Dynamic bodies get local indices [0, nbBodies) and
+// each reference to a static body (or to the world frame) gets its own slot after them, which the batching treats as
+// infinite mass. Contacts come first in the descs, then joints. Returns the number of dynamic bodies.
+PxU32 ImmediateStepper::setupConstraints(ThreadContext& context, PxU32 itemIndex, PxU32& nbStaticSlots)
+{
+	const PxImmediateSceneDataExt& data = *mData;
+
+	const PxU32 bodyStart = mItemBodyStart[itemIndex];
+	const PxU32 nbBodies = mItemBodyStart[itemIndex + 1] - bodyStart;
+	const PxU32 contactStart = mItemContactStart[itemIndex];
+	const PxU32 nbContactPairs = mItemContactStart[itemIndex + 1] - contactStart;
+	const PxU32 jointStart = mItemJointStart[itemIndex];
+	const PxU32 nbJoints = mItemJointStart[itemIndex + 1] - jointStart;
+
+	const PxReal maxLinearVelocitySq = mDesc.maxLinearVelocity * mDesc.maxLinearVelocity;
+	const PxReal maxAngularVelocitySq = mDesc.maxAngularVelocity * mDesc.maxAngularVelocity;
+
+	context.mRigidData.resize(nbBodies);
+	for(PxU32 i=0;i<nbBodies;i++)
+	{
+		const PxU32 bodyIndex = mItemBodies[bodyStart + i];
+		mLocalIndices[bodyIndex] = i;
+
+		PxRigidBodyData& rigidData = context.mRigidData[i];
+		rigidData.linearVelocity			= data.linearVelocities[bodyIndex];
+		rigidData.invMass					= data.invMasses[bodyIndex];
+		rigidData.angularVelocity			= data.angularVelocities[bodyIndex];
+		rigidData.maxDepenetrationVelocity	= mDesc.maxDepenetrationVelocity;
+		rigidData.invInertia				= data.invInertias[bodyIndex];
+		rigidData.maxContactImpulse			= PX_MAX_F32;
+		rigidData.body2World				= data.bodyPoses[bodyIndex];
+		rigidData.linearDamping				= mDesc.linearDamping;
+		rigidData.angularDamping			= mDesc.angularDamping;
+		rigidData.maxLinearVelocitySq		= maxLinearVelocitySq;
+		rigidData.maxAngularVelocitySq		= maxAngularVelocitySq;
+		rigidData.pad						= 0;
+	}
+
+	context.mDescs.resize(nbContactPairs + nbJoints);
+	context.mStaticPoses.clear();
+
+	for(PxU32 i=0;i<nbContactPairs;i++)
+	{
+		const ContactPair& pair = mItemContacts[contactStart + i];
+
+		PxSolverConstraintDesc& desc = context.mDescs[i];
+		PxMemZero(&desc, sizeof(PxSolverConstraintDesc));
+		desc.bodyADataIndex = mLocalIndices[pair.mBody0];
+		if(isDynamic(pair.mBody1))
+		{
+			desc.bodyBDataIndex = mLocalIndices[pair.mBody1];
+		}
+		else
+		{
+			desc.bodyBDataIndex = nbBodies + context.mStaticPoses.size();
+			context.mStaticPoses.pushBack(data.bodyPoses[pair.mBody1]);
+		}
+		desc.linkIndexA = PxSolverConstraintDesc::RIGID_BODY;
+		desc.linkIndexB = PxSolverConstraintDesc::RIGID_BODY;
+		desc.constraint = reinterpret_cast<PxU8*>(const_cast<ContactPair*>(&pair));
+		desc.constraintLengthOver16 = PxSolverConstraintDesc::eCONTACT_CONSTRAINT;
+	}
+
+	for(PxU32 i=0;i<nbJoints;i++)
+	{
+		const PxU32 jointIndex = mItemJoints[jointStart + i];
+		const PxU32 body0 = data.jointBodies0[jointIndex];
+		const PxU32 body1 = data.jointBodies1[jointIndex];
+
+		PxSolverConstraintDesc& desc = context.mDescs[nbContactPairs + i];
+		PxMemZero(&desc, sizeof(PxSolverConstraintDesc));
+		if(isDynamic(body0))
+		{
+			desc.bodyADataIndex = mLocalIndices[body0];
+		}
+		else
+		{
+			desc.bodyADataIndex = nbBodies + context.mStaticPoses.size();
+			context.mStaticPoses.pushBack(body0 < data.nbBodies ? data.bodyPoses[body0] : PxTransform(PxIdentity));
+		}
+		if(isDynamic(body1))
+		{
+			desc.bodyBDataIndex = mLocalIndices[body1];
+		}
+		else
+		{
+			desc.bodyBDataIndex = nbBodies + context.mStaticPoses.size();
+			context.mStaticPoses.pushBack(body1 < data.nbBodies ? data.bodyPoses[body1] : PxTransform(PxIdentity));
+		}
+		desc.linkIndexA = PxSolverConstraintDesc::RIGID_BODY;
+		desc.linkIndexB = PxSolverConstraintDesc::RIGID_BODY;
+		desc.constraint = reinterpret_cast<PxU8*>(data.jointConstraints + jointIndex);
+		desc.constraintLengthOver16 = PxSolverConstraintDesc::eJOINT_CONSTRAINT;
+	}
+
+	PxU32 nbContacts = 0;
+	for(PxU32 i=0;i<nbContactPairs;i++)
+		nbContacts += mItemContacts[contactStart + i].mNbContacts;
+	context.mContactForces.resize(nbContacts);
+
+	context.mOrderedDescs.resize(nbContactPairs + nbJoints);
+	context.mHeaders.resize(nbContactPairs + nbJoints);
+
+	nbStaticSlots = context.mStaticPoses.size();
+	return nbBodies;
+}
+
+
+void ImmediateStepper::solveWorkItem(PxU32 contextIndex, PxU32 itemIndex)
+{
+	ThreadContext& context = *mContexts[contextIndex];
+	if(mDesc.useTGS)
+		solveWorkItemTGS(context, itemIndex);
+	else
+		solveWorkItemPGS(context, itemIndex);
+}
+
+void ImmediateStepper::solveWorkItemPGS(ThreadContext& context, PxU32 itemIndex)
+{
+	const PxImmediateSceneDataExt& data = *mData;
+
+	PxU32 nbStatics;
+	const PxU32 nbBodies = setupConstraints(context, itemIndex, nbStatics);
+	const PxU32 nbContactPairs = mItemContactStart[itemIndex + 1] - mItemContactStart[itemIndex];
+	const PxU32 nbJoints = mItemJointStart[itemIndex + 1] - mItemJointStart[itemIndex];
+	const PxU32 nbSlots = nbBodies + nbStatics;
+
+	context.mBodies.resize(nbSlots);
+	context.mBodyData.resize(nbSlots);
+	context.mLinearMotion.resize(nbBodies);
+	context.mAngularMotion.resize(nbBodies);
+
+	PxSolverBody* bodies = context.mBodies.begin();
+	PxSolverBodyData* bodyData = context.mBodyData.begin();
+
+	PxConstructSolverBodies(context.mRigidData.begin(), bodyData, nbBodies, mDesc.gravity, mDt);
+	for(PxU32 i=0;i<nbStatics;i++)
+		PxConstructStaticSolverBody(context.mStaticPoses[i], bodyData[nbBodies + i]);
+
+	// The solver bodies accumulate delta velocities and must be zeroed
+	PxMemZero(bodies, sizeof(PxSolverBody)*nbSlots);
+
+	PxSolverConstraintDesc* descs = context.mDescs.begin();
+	for(PxU32 i=0;i<nbContactPairs + nbJoints;i++)
+	{
+		descs[i].bodyA = bodies + descs[i].bodyADataIndex;
+		descs[i].bodyB = bodies + descs[i].bodyBDataIndex;
+	}
+
+	// contacts and joints are batched separately, so that each header only contains one type of constraint
+	PxSolverConstraintDesc* orderedDescs = context.mOrderedDescs.begin();
+	PxConstraintBatchHeader* headers = context.mHeaders.begin();
+	const PxU32 nbContactHeaders = PxBatchConstraints(descs, nbContactPairs, bodies, nbBodies, headers, orderedDescs);
+	const PxU32 nbJointHeaders = PxBatchConstraints(descs + nbContactPairs, nbJoints, bodies, nbBodies, headers + nbContactHeaders, orderedDescs + nbContactPairs);
+
+	const PxReal invDt = 1.0f / mDt;
+
+	PxU32 forceIndex = 0;
+	for(PxU32 i=0;i<nbContactHeaders;i++)
+	{
+		PxConstraintBatchHeader& header = headers[i];
+		PxSolverContactDesc contactDescs[4];
+		for(PxU32 a=0;a<header.stride;a++)
+		{
+			PxSolverConstraintDesc& constraintDesc = orderedDescs[header.startIndex + a];
+			const ContactPair& pair = *reinterpret_cast<const ContactPair*>(constraintDesc.constraint);
+
+			PxSolverContactDesc& contactDesc = contactDescs[a];
+			PxMemZero(&contactDesc, sizeof(PxSolverContactDesc));
+			contactDesc.body0				= constraintDesc.bodyA;
+			contactDesc.body1				= constraintDesc.bodyB;
+			contactDesc.data0				= bodyData + constraintDesc.bodyADataIndex;
+			contactDesc.data1				= bodyData + constraintDesc.bodyBDataIndex;
+			contactDesc.bodyFrame0			= contactDesc.data0->body2World;
+			contactDesc.bodyFrame1			= contactDesc.data1->body2World;
+			contactDesc.bodyState0			= PxSolverConstraintPrepDescBase::eDYNAMIC_BODY;
+			contactDesc.bodyState1			= isDynamic(pair.mBody1) ? PxSolverConstraintPrepDescBase::eDYNAMIC_BODY : PxSolverConstraintPrepDescBase::eSTATIC_BODY;
+			contactDesc.desc				= &constraintDesc;
+			contactDesc.invMassScales.linear0 = contactDesc.invMassScales.linear1 = contactDesc.invMassScales.angular0 = contactDesc.invMassScales.angular1 = 1.0f;
+			contactDesc.contacts			= mContexts[pair.mContext]->mContacts.begin() + pair.mStartContact;
+			contactDesc.numContacts			= pair.mNbContacts;
+			contactDesc.contactForces		= context.mContactForces.begin() + forceIndex;
+			contactDesc.frictionPtr			= pair.mCache->mFrictions;
+			contactDesc.frictionCount		= PxU8(pair.mCache->mNbFrictions);
+			contactDesc.shapeInteraction	= NULL;
+			contactDesc.maxCCDSeparation	= PX_MAX_F32;
+			forceIndex += pair.mNbContacts;
+		}
+
+		PxCreateContactConstraints(&header, 1, contactDescs, context, invDt, mDesc.bounceThreshold, mDesc.frictionOffsetThreshold, mDesc.correlationDistance);
+
+		// Friction patches are kept for the next step. Each pair belongs to a single work item, so there is no contention here.
+		for(PxU32 a=0;a<header.stride;a++)
+		{
+			PairCache& pairCache = *reinterpret_cast<const ContactPair*>(orderedDescs[header.startIndex + a].constraint)->mCache;
+			pairCache.mFrictions = contactDescs[a].frictionPtr;
+			pairCache.mNbFrictions = contactDescs[a].frictionCount;
+		}
+	}
+
+	for(PxU32 i=nbContactHeaders;i<nbContactHeaders + nbJointHeaders;i++)
+	{
+		PxConstraintBatchHeader& header = headers[i];
+		header.startIndex += nbContactPairs;
+
+		PxSolverConstraintPrepDesc jointDescs[4];
+		PxImmediateConstraint constraints[4];
+		for(PxU32 a=0;a<header.stride;a++)
+		{
+			PxSolverConstraintDesc& constraintDesc = orderedDescs[header.startIndex + a];
+			const PxU32 jointIndex = PxU32(reinterpret_cast<const PxImmediateConstraint*>(constraintDesc.constraint) - data.jointConstraints);
+			constraints[a] = data.jointConstraints[jointIndex];
+
+			PxSolverConstraintPrepDesc& jointDesc = jointDescs[a];
+			PxMemZero(&jointDesc, sizeof(PxSolverConstraintPrepDesc));
+			jointDesc.body0					= constraintDesc.bodyA;
+			jointDesc.body1					= constraintDesc.bodyB;
+			jointDesc.data0					= bodyData + constraintDesc.bodyADataIndex;
+			jointDesc.data1					= bodyData + constraintDesc.bodyBDataIndex;
+			jointDesc.bodyFrame0			= jointDesc.data0->body2World;
+			jointDesc.bodyFrame1			= jointDesc.data1->body2World;
+			jointDesc.bodyState0			= isDynamic(data.jointBodies0[jointIndex]) ? PxSolverConstraintPrepDescBase::eDYNAMIC_BODY : PxSolverConstraintPrepDescBase::eSTATIC_BODY;
+			jointDesc.bodyState1			= isDynamic(data.jointBodies1[jointIndex]) ? PxSolverConstraintPrepDescBase::eDYNAMIC_BODY : PxSolverConstraintPrepDescBase::eSTATIC_BODY;
+			jointDesc.desc					= &constraintDesc;
+			jointDesc.linBreakForce			= PX_MAX_F32;
+			jointDesc.angBreakForce			= PX_MAX_F32;
+			jointDesc.minResponseThreshold	= 0.0f;
+			jointDesc.writeback				= NULL;
+		}
+
+		PxCreateJointConstraintsWithImmediateShaders(&header, 1, constraints, jointDescs, context, mDt, invDt);
+	}
+
+	const PxU32 nbHeaders = nbContactHeaders + nbJointHeaders;
+	PxSolveConstraints(headers, nbHeaders, orderedDescs, bodies, context.mLinearMotion.begin(), context.mAngularMotion.begin(),
+						nbBodies, mDesc.nbPositionIterations, mDesc.nbVelocityIterations);
+
+	PxIntegrateSolverBodies(bodyData, bodies, context.mLinearMotion.begin(), context.mAngularMotion.begin(), nbBodies, mDt);
+
+	const PxU32* itemBodies = mItemBodies.begin() + mItemBodyStart[itemIndex];
+	for(PxU32 i=0;i<nbBodies;i++)
+	{
+		const PxU32 bodyIndex = itemBodies[i];
+		data.bodyPoses[bodyIndex]			= bodyData[i].body2World;
+		data.linearVelocities[bodyIndex]	= bodyData[i].linearVelocity;
+		data.angularVelocities[bodyIndex]	= bodyData[i].angularVelocity;
+	}
+}
+
+void ImmediateStepper::solveWorkItemTGS(ThreadContext& context, PxU32 itemIndex)
+{
+	const PxImmediateSceneDataExt& data = *mData;
+
+	PxU32 nbStatics;
+	const PxU32 nbBodies = setupConstraints(context, itemIndex, nbStatics);
+	const PxU32 nbContactPairs = mItemContactStart[itemIndex + 1] - mItemContactStart[itemIndex];
+	const PxU32 nbJoints = mItemJointStart[itemIndex + 1] - mItemJointStart[itemIndex];
+	const PxU32 nbSlots = nbBodies + nbStatics;
+
+	context.mBodiesTGS.resize(nbSlots);
+	context.mTxInertiasTGS.resize(nbSlots);
+	context.mBodyDataTGS.resize(nbSlots);
+	context.mPosesTGS.resize(nbSlots);
+
+	PxTGSSolverBodyVel* bodies = context.mBodiesTGS.begin();
+	PxTGSSolverBodyTxInertia* txInertias = context.mTxInertiasTGS.begin();
+	PxTGSSolverBodyData* bodyData = context.mBodyDataTGS.begin();
+	PxTransform* poses = context.mPosesTGS.begin();
+
+	PxConstructSolverBodiesTGS(context.mRigidData.begin(), bodies, txInertias, bodyData, nbBodies, mDesc.gravity, mDt);
+	for(PxU32 i=0;i<nbBodies;i++)
+		poses[i] = context.mRigidData[i].body2World;
+	for(PxU32 i=0;i<nbStatics;i++)
+	{
+		poses[nbBodies + i] = context.mStaticPoses[i];
+		PxConstructStaticSolverBodyTGS(context.mStaticPoses[i], bodies[nbBodies + i], txInertias[nbBodies + i], bodyData[nbBodies + i]);
+	}
+
+	PxSolverConstraintDesc* descs = context.mDescs.begin();
+	for(PxU32 i=0;i<nbContactPairs + nbJoints;i++)
+	{
+		descs[i].tgsBodyA = bodies + descs[i].bodyADataIndex;
+		descs[i].tgsBodyB = bodies + descs[i].bodyBDataIndex;
+	}
+
+	PxSolverConstraintDesc* orderedDescs = context.mOrderedDescs.begin();
+	PxConstraintBatchHeader* headers = context.mHeaders.begin();
+	const PxU32 nbContactHeaders = PxBatchConstraintsTGS(descs, nbContactPairs, bodies, nbBodies, headers, orderedDescs);
+	const PxU32 nbJointHeaders = PxBatchConstraintsTGS(descs + nbContactPairs, nbJoints, bodies, nbBodies, headers + nbContactHeaders, orderedDescs + nbContactPairs);
+
+	const PxReal stepDt = mDt / PxReal(mDesc.nbPositionIterations);
+	const PxReal invStepDt = 1.0f / stepDt;
+	const PxReal invDt = 1.0f / mDt;
+
+	PxU32 forceIndex = 0;
+	for(PxU32 i=0;i<nbContactHeaders;i++)
+	{
+		PxConstraintBatchHeader& header = headers[i];
+		PxTGSSolverContactDesc contactDescs[4];
+		for(PxU32 a=0;a<header.stride;a++)
+		{
+			PxSolverConstraintDesc& constraintDesc = orderedDescs[header.startIndex + a];
+			const ContactPair& pair = *reinterpret_cast<const ContactPair*>(constraintDesc.constraint);
+
+			PxTGSSolverContactDesc& contactDesc = contactDescs[a];
+			PxMemZero(&contactDesc, sizeof(PxTGSSolverContactDesc));
+			contactDesc.body0				= constraintDesc.tgsBodyA;
+			contactDesc.body1				= constraintDesc.tgsBodyB;
+			contactDesc.bodyData0			= bodyData + constraintDesc.bodyADataIndex;
+			contactDesc.bodyData1			= bodyData + constraintDesc.bodyBDataIndex;
+			contactDesc.body0TxI			= txInertias + constraintDesc.bodyADataIndex;
+			contactDesc.body1TxI			= txInertias + constraintDesc.bodyBDataIndex;
+			contactDesc.bodyFrame0			= poses[constraintDesc.bodyADataIndex];
+			contactDesc.bodyFrame1			= poses[constraintDesc.bodyBDataIndex];
+			contactDesc.bodyState0			= PxSolverConstraintPrepDescBase::eDYNAMIC_BODY;
+			contactDesc.bodyState1			= isDynamic(pair.mBody1) ? PxSolverConstraintPrepDescBase::eDYNAMIC_BODY : PxSolverConstraintPrepDescBase::eSTATIC_BODY;
+			contactDesc.desc				= &constraintDesc;
+			contactDesc.invMassScales.linear0 = contactDesc.invMassScales.linear1 = contactDesc.invMassScales.angular0 = contactDesc.invMassScales.angular1 = 1.0f;
+			contactDesc.contacts			= mContexts[pair.mContext]->mContacts.begin() + pair.mStartContact;
+			contactDesc.numContacts			= pair.mNbContacts;
+			contactDesc.contactForces		= context.mContactForces.begin() + forceIndex;
+			contactDesc.frictionPtr			= pair.mCache->mFrictions;
+			contactDesc.frictionCount		= PxU8(pair.mCache->mNbFrictions);
+			contactDesc.shapeInteraction	= NULL;
+			contactDesc.maxCCDSeparation	= PX_MAX_F32;
+			contactDesc.maxImpulse			= PX_MAX_F32;
+			contactDesc.offsetSlop			= 0.0f;
+			forceIndex += pair.mNbContacts;
+		}
+
+		PxCreateContactConstraintsTGS(&header, 1, contactDescs, context, invStepDt, invDt, mDesc.bounceThreshold, mDesc.frictionOffsetThreshold, mDesc.correlationDistance);
+
+		for(PxU32 a=0;a<header.stride;a++)
+		{
+			PairCache& pairCache = *reinterpret_cast<const ContactPair*>(orderedDescs[header.startIndex + a].constraint)->mCache;
+			pairCache.mFrictions = contactDescs[a].frictionPtr;
+			pairCache.mNbFrictions = contactDescs[a].frictionCount;
+		}
+	}
+
+	for(PxU32 i=nbContactHeaders;i<nbContactHeaders + nbJointHeaders;i++)
+	{
+		PxConstraintBatchHeader& header = headers[i];
+		header.startIndex += nbContactPairs;
+
+		PxTGSSolverConstraintPrepDesc jointDescs[4];
+		PxImmediateConstraint constraints[4];
+		for(PxU32 a=0;a<header.stride;a++)
+		{
+			PxSolverConstraintDesc& constraintDesc = orderedDescs[header.startIndex + a];
+			const PxU32 jointIndex = PxU32(reinterpret_cast<const PxImmediateConstraint*>(constraintDesc.constraint) - data.jointConstraints);
+			constraints[a] = data.jointConstraints[jointIndex];
+
+			PxTGSSolverConstraintPrepDesc& jointDesc = jointDescs[a];
+			PxMemZero(&jointDesc, sizeof(PxTGSSolverConstraintPrepDesc));
+			jointDesc.body0					= constraintDesc.tgsBodyA;
+			jointDesc.body1					= constraintDesc.tgsBodyB;
+			jointDesc.bodyData0				= bodyData + constraintDesc.bodyADataIndex;
+			jointDesc.bodyData1				= bodyData + constraintDesc.bodyBDataIndex;
+			jointDesc.body0TxI				= txInertias + constraintDesc.bodyADataIndex;
+			jointDesc.body1TxI				= txInertias + constraintDesc.bodyBDataIndex;
+			jointDesc.bodyFrame0			= poses[constraintDesc.bodyADataIndex];
+			jointDesc.bodyFrame1			= poses[constraintDesc.bodyBDataIndex];
+			jointDesc.bodyState0			= isDynamic(data.jointBodies0[jointIndex]) ? PxSolverConstraintPrepDescBase::eDYNAMIC_BODY : PxSolverConstraintPrepDescBase::eSTATIC_BODY;
+			jointDesc.bodyState1			= isDynamic(data.jointBodies1[jointIndex]) ? PxSolverConstraintPrepDescBase::eDYNAMIC_BODY : PxSolverConstraintPrepDescBase::eSTATIC_BODY;
+			jointDesc.desc					= &constraintDesc;
+			jointDesc.linBreakForce			= PX_MAX_F32;
+			jointDesc.angBreakForce			= PX_MAX_F32;
+			jointDesc.minResponseThreshold	= 0.0f;
+			jointDesc.writeback				= NULL;
+		}
+
+		PxCreateJointConstraintsWithImmediateShadersTGS(&header, 1, constraints, jointDescs, context, stepDt, mDt, invStepDt, invDt, mDesc.toleranceLength);
+	}
+
+	const PxU32 nbHeaders = nbContactHeaders + nbJointHeaders;
+	PxSolveConstraintsTGS(headers, nbHeaders, orderedDescs, bodies, txInertias, nbBodies, mDesc.nbPositionIterations, mDesc.nbVelocityIterations, stepDt, invStepDt);
+
+	PxIntegrateSolverBodiesTGS(bodies, txInertias, poses, nbBodies, mDt);
+
+	const PxU32* itemBodies = mItemBodies.begin() + mItemBodyStart[itemIndex];
+	for(PxU32 i=0;i<nbBodies;i++)
+	{
+		const PxU32 bodyIndex = itemBodies[i];
+		data.bodyPoses[bodyIndex]			= poses[i];
+		data.linearVelocities[bodyIndex]	= bodies[i].linearVelocity;
+		data.angularVelocities[bodyIndex]	= bodies[i].angularVelocity;
+	}
+}
+
+bool ImmediateStepper::step(const PxImmediateSceneDataExt& data, PxReal dt)
+{
+	if(!(dt > 0.0f))
+		return PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxImmediateStepperExt::step: dt must be positive.");
+
+	if(!validate(data))
+		return PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxImmediateStepperExt::step: invalid scene data.");
+
+	mData = &data;
+	mDt = dt;
+
+	for(PxU32 i=0;i<mNbContexts;i++)
+		mContexts[i]->flip();
+
+	// 1) Shape bounds
+	const PxU32 nbShapes = data.nbShapes;
+	mBounds.resize(nbShapes);
+	mGroups.resize(nbShapes);
+	runStage(eBOUNDS, nbShapes / gMinShapesPerJob, nbShapes);
+
+	// 2) Broadphase
+	mBroadPhasePairs.clear();
+	if(nbShapes)
+		mBroadPhase->findPairs(nbShapes, mBounds.begin(), mGroups.begin(), mBroadPhasePairs);
+	mStats.nbBroadPhasePairs = mBroadPhasePairs.size();
+
+	// 3) Narrowphase
+	gatherShapePairs();
+	const PxU32 nbShapePairs = mShapePairs.size();
+	runStage(eCONTACTS, nbShapePairs / mDesc.minPairsPerTask, nbShapePairs);
+
+	// 4) Islands
+	buildIslands();
+
+	// 5) Solver, one work item at a time
+	const PxU32 nbItems = mNbStageItems;
+	runStage(eISLANDS, nbItems, nbItems);
+
+	mData = NULL;
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+PxImmediateStepperExt* physx::PxCreateImmediateStepperExt(const PxImmediateStepperDescExt& desc)
+{
+	if(!desc.isValid())
+	{
+		PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxCreateImmediateStepperExt: invalid descriptor.");
+		return NULL;
+	}
+
+	ImmediateStepper* stepper = PX_NEW(ImmediateStepper)(desc);
+	if(!stepper->init())
+	{
+		PX_DELETE(stepper);
+		PxGetFoundation().error(PxErrorCode::eOUT_OF_MEMORY, PX_FL, "PxCreateImmediateStepperExt: initialization failed.");
+		return NULL;
+	}
+	return stepper;
+}
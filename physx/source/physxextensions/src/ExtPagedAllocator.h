@@ -0,0 +1,120 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2023 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef EXT_PAGED_ALLOCATOR_H
+#define EXT_PAGED_ALLOCATOR_H
+
+#include "foundation/PxAllocator.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxMath.h"
+
+namespace physx
+{
+namespace Ext
+{
+	// Linear allocator handing out 16-byte aligned memory from pages that are kept and recycled after reset(). Allocations
+	// larger than the page size get their own page. There is no per-allocation free.
+	class PagedAllocator
+	{
+		struct Page
+		{
+			PxU8*	mMemory;
+			PxU32	mSize;
+		};
+										PX_NOCOPY(PagedAllocator)
+	public:
+										PagedAllocator(PxU32 pageSize = 32 * 1024) : mPageSize(pageSize), mCurrentPage(0), mOffset(0), mNbUsedPages(0)	{}
+										~PagedAllocator()	{ releasePages(0);	}
+
+		PX_FORCE_INLINE	void			setPageSize(PxU32 pageSize)	{ mPageSize = pageSize;	}
+
+						PxU8*			allocate(PxU32 size)
+										{
+											size = (size + 15) & ~15;
+											while(mCurrentPage<mPages.size())
+											{
+												const Page& page = mPages[mCurrentPage];
+												if(mOffset + size <= page.mSize)
+												{
+													PxU8* memory = page.mMemory + mOffset;
+													mOffset += size;
+													mNbUsedPages = PxMax(mNbUsedPages, mCurrentPage + 1);
+													return memory;
+												}
+												mCurrentPage++;
+												mOffset = 0;
+											}
+
+											Page page;
+											page.mSize = PxMax(size, mPageSize);
+											page.mMemory = PX_ALLOCATE(PxU8, page.mSize, "PagedAllocator");
+											if(!page.mMemory)
+												return NULL;
+											mPages.pushBack(page);
+											mCurrentPage = mPages.size() - 1;
+											mOffset = size;
+											mNbUsedPages = mPages.size();
+											return page.mMemory;
+										}
+
+		// Makes all the memory available again. If less than half of the pages have been used since the previous reset,
+		// the unused ones are freed, so that a temporary peak does not keep its memory forever.
+						void			reset()
+										{
+											if(mNbUsedPages < mPages.size()/2)
+												releasePages(mNbUsedPages);
+											mCurrentPage = 0;
+											mOffset = 0;
+											mNbUsedPages = 0;
+										}
+
+						PxU64			getNbAllocatedBytes()	const
+										{
+											PxU64 size = 0;
+											for(PxU32 i=0;i<mPages.size();i++)
+												size += mPages[i].mSize;
+											return size;
+										}
+	private:
+						void			releasePages(PxU32 nbToKeep)
+										{
+											for(PxU32 i=nbToKeep;i<mPages.size();i++)
+												PX_FREE(mPages[i].mMemory);
+											mPages.forceSize_Unsafe(nbToKeep);
+										}
+
+						PxArray<Page>	mPages;
+						PxU32			mPageSize;
+						PxU32			mCurrentPage;
+						PxU32			mOffset;
+						PxU32			mNbUsedPages;
+	};
+}
+}
+
+#endif
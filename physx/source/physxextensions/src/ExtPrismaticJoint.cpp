@@ -159,22 +159,11 @@ static void PrismaticJointVisualize(PxConstraintVisualizer& viz, const void* con
 	}
 }
 
-//TAG:solverprepshader
-static PxU32 PrismaticJointSolverPrep(Px1DConstraint* constraints,
-	PxVec3p& body0WorldOffset,
-	PxU32 /*maxConstraints*/,
-	PxConstraintInvMassScale& invMassScale,
-	const void* constantBlock,
-	const PxTransform& bA2w,
-	const PxTransform& bB2w,
-	bool /*useExtendedLimits*/,
-	PxVec3p& cA2wOut, PxVec3p& cB2wOut)
+static PxU32 setupPrismaticJointRows(joint::ConstraintHelper& ch, const void* constantBlock, PxTransform& cA2w, PxTransform& cB2w,
+	const PxTransform& bA2w, const PxTransform& bB2w, bool /*useExtendedLimits*/, PxVec3p& cA2wOut, PxVec3p& cB2wOut)
 {
 	const PrismaticJointData& data = *reinterpret_cast<const PrismaticJointData*>(constantBlock);
 
-	PxTransform cA2w, cB2w;
-	joint::ConstraintHelper ch(constraints, invMassScale, cA2w, cB2w, body0WorldOffset, data, bA2w, bB2w);
-
 	if (cA2w.q.dot(cB2w.q)<0.0f)	// minimum dist quat (equiv to flipping cB2bB.q, which we don't use anywhere)
 		cB2w.q = -cB2w.q;
 
@@ -201,9 +190,28 @@ static PxU32 PrismaticJointSolverPrep(Px1DConstraint* constraints,
 	return ch.getCount();
 }
 
+//TAG:solverprepshader
+static PxU32 PrismaticJointSolverPrep(Px1DConstraint* constraints,
+	PxVec3p& body0WorldOffset,
+	PxU32 /*maxConstraints*/,
+	PxConstraintInvMassScale& invMassScale,
+	const void* constantBlock,
+	const PxTransform& bA2w,
+	const PxTransform& bB2w,
+	bool useExtendedLimits,
+	PxVec3p& cA2wOut, PxVec3p& cB2wOut)
+{
+	const PrismaticJointData& data = *reinterpret_cast<const PrismaticJointData*>(constantBlock);
+
+	PxTransform cA2w, cB2w;
+	joint::ConstraintHelper ch(constraints, invMassScale, cA2w, cB2w, body0WorldOffset, data, bA2w, bB2w);
+
+	return setupPrismaticJointRows(ch, constantBlock, cA2w, cB2w, bA2w, bB2w, useExtendedLimits, cA2wOut, cB2wOut);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
-static PxConstraintShaderTable gPrismaticJointShaders = { PrismaticJointSolverPrep, PrismaticJointProject, PrismaticJointVisualize, PxConstraintFlag::Enum(0) };
+static PxConstraintShaderTable gPrismaticJointShaders = { PrismaticJointSolverPrep, PrismaticJointProject, PrismaticJointVisualize, PxConstraintFlag::Enum(0), joint::solverPrepBatch<setupPrismaticJointRows> };
 
 PxConstraintSolverPrep PrismaticJoint::getPrep()	const	{ return gPrismaticJointShaders.solverPrep; }
 
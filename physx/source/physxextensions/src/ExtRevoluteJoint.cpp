@@ -252,22 +252,11 @@ static void RevoluteJointVisualize(PxConstraintVisualizer& viz, const void* cons
 	}
 }
 
-//TAG:solverprepshader
-static PxU32 RevoluteJointSolverPrep(Px1DConstraint* constraints,
-	PxVec3p& body0WorldOffset,
-	PxU32 /*maxConstraints*/,
-	PxConstraintInvMassScale& invMassScale,
-	const void* constantBlock,
-	const PxTransform& bA2w,
-	const PxTransform& bB2w,
-	bool useExtendedLimits,
-	PxVec3p& cA2wOut, PxVec3p& cB2wOut)
+static PxU32 setupRevoluteJointRows(joint::ConstraintHelper& ch, const void* constantBlock, PxTransform& cA2w, PxTransform& cB2w,
+	const PxTransform& bA2w, const PxTransform& bB2w, bool useExtendedLimits, PxVec3p& cA2wOut, PxVec3p& cB2wOut)
 {
 	const RevoluteJointData& data = *reinterpret_cast<const RevoluteJointData*>(constantBlock);
 
-	PxTransform cA2w, cB2w;
-	joint::ConstraintHelper ch(constraints, invMassScale, cA2w, cB2w, body0WorldOffset, data, bA2w, bB2w);
-
 	const PxJointAngularLimitPair& limit = data.limit;
 
 	const bool limitEnabled = data.jointFlags & PxRevoluteJointFlag::eLIMIT_ENABLED;
@@ -320,9 +309,28 @@ static PxU32 RevoluteJointSolverPrep(Px1DConstraint* constraints,
 	return ch.getCount();
 }
 
+//TAG:solverprepshader
+static PxU32 RevoluteJointSolverPrep(Px1DConstraint* constraints,
+	PxVec3p& body0WorldOffset,
+	PxU32 /*maxConstraints*/,
+	PxConstraintInvMassScale& invMassScale,
+	const void* constantBlock,
+	const PxTransform& bA2w,
+	const PxTransform& bB2w,
+	bool useExtendedLimits,
+	PxVec3p& cA2wOut, PxVec3p& cB2wOut)
+{
+	const RevoluteJointData& data = *reinterpret_cast<const RevoluteJointData*>(constantBlock);
+
+	PxTransform cA2w, cB2w;
+	joint::ConstraintHelper ch(constraints, invMassScale, cA2w, cB2w, body0WorldOffset, data, bA2w, bB2w);
+
+	return setupRevoluteJointRows(ch, constantBlock, cA2w, cB2w, bA2w, bB2w, useExtendedLimits, cA2wOut, cB2wOut);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
-static PxConstraintShaderTable gRevoluteJointShaders = { RevoluteJointSolverPrep, RevoluteJointProject, RevoluteJointVisualize, PxConstraintFlag::Enum(0) };
+static PxConstraintShaderTable gRevoluteJointShaders = { RevoluteJointSolverPrep, RevoluteJointProject, RevoluteJointVisualize, PxConstraintFlag::Enum(0), joint::solverPrepBatch<setupRevoluteJointRows> };
 
 PxConstraintSolverPrep RevoluteJoint::getPrep()	const	{ return gRevoluteJointShaders.solverPrep; }
 
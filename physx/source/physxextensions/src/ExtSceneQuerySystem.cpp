@@ -161,6 +161,7 @@ namespace
 		virtual	PxSQCompoundHandle				addSQCompound(const PxRigidActor& actor, const PxShape** shapes, const PxBVH& pxbvh, const PxTransform* transforms);
 		virtual	void							removeSQCompound(PxSQCompoundHandle compoundHandle);
 		virtual	void							updateSQCompound(PxSQCompoundHandle compoundHandle, const PxTransform& compoundTransform);
+		virtual	void							updateSQCompounds(const PxSQCompoundHandle* compoundHandles, const PxTransform* compoundTransforms, PxU32 nbCompounds);
 		virtual	void							flushUpdates()																		{ SQ().flushUpdates();											}
 		virtual	void							flushMemory()																		{ SQ().flushMemory();											}
 		virtual	void							visualize(PxU32 prunerIndex, PxRenderOutput& out)		const						{ SQ().visualize(prunerIndex, out);							}
@@ -174,6 +175,7 @@ namespace
 		virtual	PxSceneQueryUpdateMode::Enum	getUpdateMode()											const						{ return mUpdateMode;											}
 		virtual	void							setUpdateMode(PxSceneQueryUpdateMode::Enum mode)									{ mUpdateMode = mode;											}
 		virtual	PxU32							getStaticTimestamp()									const						{ return SQ().getStaticTimestamp();							}
+		virtual	void							getDynamicTreeRefitStats(PxDynamicTreeRefitStats& stats)	const					{ SQ().getDynamicTreeRefitStats(stats);						}
 		virtual	void							merge(const PxPruningStructure& pxps);
 		virtual	bool							raycast(const PxVec3& origin, const PxVec3& unitDir, const PxReal distance,
 														PxRaycastCallback& hitCall, PxHitFlags hitFlags,
@@ -331,6 +333,12 @@ void ExternalPxSQ::updateSQCompound(PxSQCompoundHandle compoundHandle, const PxT
 	SQ().updateCompoundActor(PrunerCompoundId(compoundHandle), compoundTransform);
 }
 
+void ExternalPxSQ::updateSQCompounds(const PxSQCompoundHandle* compoundHandles, const PxTransform* compoundTransforms, PxU32 nbCompounds)
+{
+	PX_COMPILE_TIME_ASSERT(sizeof(PxSQCompoundHandle)==sizeof(PrunerCompoundId));
+	SQ().updateCompoundActors(reinterpret_cast<const PrunerCompoundId*>(compoundHandles), compoundTransforms, nbCompounds);
+}
+
 PxSQBuildStepHandle ExternalPxSQ::prepareSceneQueryBuildStep(PxU32 prunerIndex)
 {
 	return SQ().prepareSceneQueriesUpdate(PruningIndex::Enum(prunerIndex));
@@ -431,12 +439,13 @@ static BVHBuildStrategy getBuildStrategy(PxBVHBuildStrategy::Enum bs)
 		case PxBVHBuildStrategy::eFAST:		return BVH_SPLATTER_POINTS;
 		case PxBVHBuildStrategy::eDEFAULT:	return BVH_SPLATTER_POINTS_SPLIT_GEOM_CENTER;
 		case PxBVHBuildStrategy::eSAH:		return BVH_SAH;
+		case PxBVHBuildStrategy::eBINNED_SAH:	return BVH_BINNED_SAH;
 		case PxBVHBuildStrategy::eLAST:		return BVH_SPLATTER_POINTS;
 	}
 	return BVH_SPLATTER_POINTS;
 }
 
-static Pruner* create(PxPruningStructureType::Enum type, PxU64 contextID, PxDynamicTreeSecondaryPruner::Enum secondaryType, PxBVHBuildStrategy::Enum buildStrategy, PxU32 nbObjectsPerNode)
+static Pruner* create(PxPruningStructureType::Enum type, PxU64 contextID, PxDynamicTreeSecondaryPruner::Enum secondaryType, PxBVHBuildStrategy::Enum buildStrategy, PxU32 nbObjectsPerNode, bool wideTree, float cellSize)
 {
 //	if(0)
 //		return createIncrementalPruner(contextID);
@@ -448,8 +457,9 @@ static Pruner* create(PxPruningStructureType::Enum type, PxU64 contextID, PxDyna
 	switch(type)
 	{
 		case PxPruningStructureType::eNONE:					{ pruner = createBucketPruner(contextID);										break;	}
-		case PxPruningStructureType::eDYNAMIC_AABB_TREE:	{ pruner = createAABBPruner(contextID, true, cpType, bs, nbObjectsPerNode);		break;	}
-		case PxPruningStructureType::eSTATIC_AABB_TREE:		{ pruner = createAABBPruner(contextID, false, cpType, bs, nbObjectsPerNode);	break;	}
+		case PxPruningStructureType::eDYNAMIC_AABB_TREE:	{ pruner = createAABBPruner(contextID, true, cpType, bs, nbObjectsPerNode, NULL, wideTree);		break;	}
+		case PxPruningStructureType::eSTATIC_AABB_TREE:		{ pruner = createAABBPruner(contextID, false, cpType, bs, nbObjectsPerNode, NULL, wideTree);	break;	}
+		case PxPruningStructureType::eHASH_GRID:			{ pruner = createHashGridPruner(contextID, cellSize);							break;	}
 		case PxPruningStructureType::eLAST:					break;
 	}
 	return pruner;
@@ -458,8 +468,8 @@ static Pruner* create(PxPruningStructureType::Enum type, PxU64 contextID, PxDyna
 PxSceneQuerySystem* physx::PxCreateExternalSceneQuerySystem(const PxSceneQueryDesc& desc, PxU64 contextID)
 {
 	PVDCapture* pvd = NULL;
-	Pruner* staticPruner = create(desc.staticStructure, contextID, desc.dynamicTreeSecondaryPruner, desc.staticBVHBuildStrategy, desc.staticNbObjectsPerNode);
-	Pruner* dynamicPruner = create(desc.dynamicStructure, contextID, desc.dynamicTreeSecondaryPruner, desc.dynamicBVHBuildStrategy, desc.dynamicNbObjectsPerNode);
+	Pruner* staticPruner = create(desc.staticStructure, contextID, desc.dynamicTreeSecondaryPruner, desc.staticBVHBuildStrategy, desc.staticNbObjectsPerNode, desc.staticWideTree, desc.hashGridCellSize);
+	Pruner* dynamicPruner = create(desc.dynamicStructure, contextID, desc.dynamicTreeSecondaryPruner, desc.dynamicBVHBuildStrategy, desc.dynamicNbObjectsPerNode, desc.dynamicWideTree, desc.hashGridCellSize);
 
 	ExternalPxSQ* pxsq = PX_NEW(ExternalPxSQ)(pvd, contextID, staticPruner, dynamicPruner, desc.dynamicTreeRebuildRateHint, desc.sceneQueryUpdateMode, PxSceneLimits());
 
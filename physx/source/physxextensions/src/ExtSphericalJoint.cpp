@@ -158,22 +158,11 @@ static void SphericalJointVisualize(PxConstraintVisualizer& viz, const void* con
 	}
 }
 
-//TAG:solverprepshader
-static PxU32 SphericalJointSolverPrep(Px1DConstraint* constraints,
-	PxVec3p& body0WorldOffset,
-	PxU32 /*maxConstraints*/,
-	PxConstraintInvMassScale& invMassScale,
-	const void* constantBlock,							  
-	const PxTransform& bA2w,
-	const PxTransform& bB2w,
-	bool /*useExtendedLimits*/,
-	PxVec3p& cA2wOut, PxVec3p& cB2wOut)
+static PxU32 setupSphericalJointRows(joint::ConstraintHelper& ch, const void* constantBlock, PxTransform& cA2w, PxTransform& cB2w,
+	const PxTransform& bA2w, const PxTransform& bB2w, bool /*useExtendedLimits*/, PxVec3p& cA2wOut, PxVec3p& cB2wOut)
 {
 	const SphericalJointData& data = *reinterpret_cast<const SphericalJointData*>(constantBlock);
 
-	PxTransform cA2w, cB2w;
-	joint::ConstraintHelper ch(constraints, invMassScale, cA2w, cB2w, body0WorldOffset, data, bA2w, bB2w);
-
 	if(cB2w.q.dot(cA2w.q)<0.0f)
 		cB2w.q = -cB2w.q;
 
@@ -201,9 +190,28 @@ static PxU32 SphericalJointSolverPrep(Px1DConstraint* constraints,
 	return ch.getCount();
 }
 
+//TAG:solverprepshader
+static PxU32 SphericalJointSolverPrep(Px1DConstraint* constraints,
+	PxVec3p& body0WorldOffset,
+	PxU32 /*maxConstraints*/,
+	PxConstraintInvMassScale& invMassScale,
+	const void* constantBlock,
+	const PxTransform& bA2w,
+	const PxTransform& bB2w,
+	bool useExtendedLimits,
+	PxVec3p& cA2wOut, PxVec3p& cB2wOut)
+{
+	const SphericalJointData& data = *reinterpret_cast<const SphericalJointData*>(constantBlock);
+
+	PxTransform cA2w, cB2w;
+	joint::ConstraintHelper ch(constraints, invMassScale, cA2w, cB2w, body0WorldOffset, data, bA2w, bB2w);
+
+	return setupSphericalJointRows(ch, constantBlock, cA2w, cB2w, bA2w, bB2w, useExtendedLimits, cA2wOut, cB2wOut);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
-static PxConstraintShaderTable gSphericalJointShaders = { SphericalJointSolverPrep, SphericalJointProject, SphericalJointVisualize, PxConstraintFlag::Enum(0) };
+static PxConstraintShaderTable gSphericalJointShaders = { SphericalJointSolverPrep, SphericalJointProject, SphericalJointVisualize, PxConstraintFlag::Enum(0), joint::solverPrepBatch<setupSphericalJointRows> };
 
 PxConstraintSolverPrep SphericalJoint::getPrep()	const	{ return gSphericalJointShaders.solverPrep; }
 
@@ -45,6 +45,7 @@ using namespace Gu;
 #include "common/PxRenderBuffer.h"
 #include "GuBVH.h"
 #include "foundation/PxAlloca.h"
+#include "PxSceneQuerySystem.h"
 
 // PT: this is a customized version of physx::Sq::PrunerManager that supports more than 2 hardcoded pruners.
 // It might not be possible to support the whole PxSceneQuerySystem API with an arbitrary number of pruners.
@@ -413,6 +414,27 @@ void ExtPrunerManager::visualize(PxU32 prunerIndex, PxRenderOutput& out) const
 	}
 }
 
+static void accumulateRefitStats(PxDynamicTreeRefitStats& stats, const Pruner* pruner)
+{
+	if(!pruner || !pruner->isDynamic())
+		return;
+
+	PrunerRefitStats refitStats;
+	static_cast<const DynamicPruner*>(pruner)->getRefitStats(refitStats);
+	stats.nbUpdatedObjects	+= refitStats.mNbUpdatedObjects;
+	stats.nbRefitNodes		+= refitStats.mNbRefitNodes;
+	stats.nbBulkRefits		+= refitStats.mBulkRefit ? 1u : 0u;
+	stats.refitTime			+= refitStats.mRefitTime;
+}
+
+void ExtPrunerManager::getDynamicTreeRefitStats(PxDynamicTreeRefitStats& stats) const
+{
+	stats = PxDynamicTreeRefitStats();
+	const PxU32 nb = getNbPruners();
+	for(PxU32 i=0;i<nb;i++)
+		accumulateRefitStats(stats, getPruner(i));
+}
+
 void ExtPrunerManager::shiftOrigin(const PxVec3& shift)
 {
 	const PxU32 nb = mPrunerExt.size();
@@ -445,6 +467,16 @@ void ExtPrunerManager::updateCompoundActor(PrunerCompoundId compoundId, const Px
 		invalidateStaticTimestamp();
 }
 
+void ExtPrunerManager::updateCompoundActors(const PrunerCompoundId* compoundIds, const PxTransform* compoundTransforms, PxU32 nbCompounds)
+{
+	PX_ASSERT(mCompoundPrunerExt.mPruner);
+	if(!nbCompounds)
+		return;
+	const bool allDynamic = mCompoundPrunerExt.mPruner->updateCompounds(compoundIds, compoundTransforms, nbCompounds);
+	if(!allDynamic)
+		invalidateStaticTimestamp();
+}
+
 void ExtPrunerManager::removeCompoundActor(PrunerCompoundId compoundId, PrunerPayloadRemovalCallback* removalCallback)
 {
 	PX_ASSERT(mCompoundPrunerExt.mPruner);
@@ -52,6 +52,7 @@ namespace physx
 class PxRenderOutput;
 class PxBVH;
 class PxSceneLimits;
+struct PxDynamicTreeRefitStats;
 
 namespace Gu
 {
@@ -90,6 +91,7 @@ namespace Sq
 						void							forceRebuildDynamicTree(PxU32 prunerIndex);
 
 						void							updateCompoundActor(PrunerCompoundId compoundId, const PxTransform& compoundTransform);
+						void							updateCompoundActors(const PrunerCompoundId* compoundIds, const PxTransform* compoundTransforms, PxU32 nbCompounds);
 						void							removeCompoundActor(PrunerCompoundId compoundId, Gu::PrunerPayloadRemovalCallback* removalCallback);
 
 						void*							prepareSceneQueriesUpdate(PxU32 prunerIndex);
@@ -104,6 +106,7 @@ namespace Sq
 		PX_FORCE_INLINE PxU32							getStaticTimestamp()	const	{ return mStaticTimestamp;	}
 		PX_FORCE_INLINE const Adapter&					getAdapter()			const	{ return mAdapter;			}
 		PX_FORCE_INLINE	const Gu::BVH*					getTreeOfPruners()		const	{ return mTreeOfPruners;	}
+						void							getDynamicTreeRefitStats(PxDynamicTreeRefitStats& stats)	const;
 
 						PxU32							startCustomBuildstep();
 						void							customBuildstep(PxU32 index);
@@ -402,6 +402,7 @@ struct ExtMultiQueryCallback : public PrunerRaycastCallback, public PrunerOverla
 	const PxQueryFilterData&	mFilterData;
 	PxQueryFilterCallback*		mFilterCall;
 	PxReal						mShrunkDistance;
+	PxReal						mTouchDistance;		// touch hits farther than this are discarded, see PxHitCallback::growTouches. Does not affect blocking hits.
 	const PxHitFlags			mMeshAnyHitFlags;
 	bool						mReportTouchesAgain;
 	bool						mFarBlockFound; // this is to prevent repeated searches for far block
@@ -426,6 +427,7 @@ struct ExtMultiQueryCallback : public PrunerRaycastCallback, public PrunerOverla
 			mFilterData			(filterData),
 			mFilterCall			(filterCall),
 			mShrunkDistance		(shrunkDistance),
+			mTouchDistance		(PX_MAX_F32),
 			mMeshAnyHitFlags	((hitFlags.isSet(PxHitFlag::eMESH_ANY) || anyHit) ? PxHitFlag::eMESH_ANY : PxHitFlag::Enum(0)),
 			mReportTouchesAgain	(true),
 			mFarBlockFound		(filterData.flags & PxQueryFlag::eNO_BLOCK),
@@ -452,10 +454,24 @@ struct ExtMultiQueryCallback : public PrunerRaycastCallback, public PrunerOverla
 			outputError<PxErrorCode::eINVALID_OPERATION>(__LINE__, "User filter returned PxQueryHitType::eTOUCH but the touches buffer was empty. Hit was discarded.");
 		#endif
 
-		if(mHitCall.maxNbTouches && mReportTouchesAgain && HITDIST(hit) <= mShrunkDistance)
+		if(mHitCall.maxNbTouches && mReportTouchesAgain && HITDIST(hit) <= mShrunkDistance && HITDIST(hit) <= mTouchDistance)
 		{
-			// Buffer full: need to find the closest blocking hit, clip touch hits and flush the buffer
-			if(mHitCall.nbTouches == mHitCall.maxNbTouches)
+			// Buffer full: let growable callbacks make room first, otherwise need to find the closest blocking hit,
+			// clip touch hits and flush the buffer
+			PxReal maxTouchDist = PxMin(mShrunkDistance, mTouchDistance);
+			if(mHitCall.nbTouches == mHitCall.maxNbTouches && HitTypeSupport<HitType>::IsOverlap == 0 && mHitCall.growTouches(maxTouchDist))
+			{
+				PX_ASSERT(mHitCall.nbTouches < mHitCall.maxNbTouches);
+				if(maxTouchDist < mTouchDistance)
+				{
+					// callback only keeps a limited number of closest hits: cull farther touches from now on, but keep
+					// the query distance so that a blocking hit beyond the last kept touch is still found
+					mTouchDistance = maxTouchDist;
+					if(HITDIST(hit) > mTouchDistance)
+						return true;
+				}
+			}
+			else if(mHitCall.nbTouches == mHitCall.maxNbTouches)
 			{
 				// issue a second nested query just looking for the closest blocking hit
 				// could do better perf-wise by saving traversal state (start looking for blocking from this point)
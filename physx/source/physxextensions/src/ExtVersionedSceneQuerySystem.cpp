@@ -0,0 +1,656 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2023 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "extensions/PxVersionedSceneQuerySystem.h"
+#include "extensions/PxSceneQuerySystemExt.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxAtomic.h"
+#include "foundation/PxBitMap.h"
+#include "foundation/PxBounds3.h"
+#include "foundation/PxFoundation.h"
+#include "foundation/PxSync.h"
+#include "foundation/PxUserAllocated.h"
+
+// This file implements a double-buffered scene query system. Two identical external SQ systems are created: updates are
+// applied to the "back" one and recorded in a command log, while queries run against the published "front" one. Publishing
+// swaps the two systems, waits for the queries still running against the previous front, and replays the log on it so that
+// both systems contain the same objects again. Since both systems receive the same sequence of additions and removals,
+// they return the same pruner and compound handles, and the scene can keep using the handles returned by either one.
+//
+// Queries only increment the reader count of the front system, and check that it is still the front system afterwards.
+
+using namespace physx;
+
+void addExternalSQ(PxSceneQuerySystem* added);
+void removeExternalSQ(PxSceneQuerySystem* removed);
+
+namespace
+{
+	enum CommandType
+	{
+		CMD_ADD_SHAPE,
+		CMD_REMOVE_SHAPE,
+		CMD_UPDATE_SHAPE,
+		CMD_ADD_COMPOUND,
+		CMD_REMOVE_COMPOUND,
+		CMD_UPDATE_COMPOUND,
+		CMD_UPDATE_COMPOUNDS,
+		CMD_SYNC,
+		CMD_FINALIZE,
+		CMD_SHIFT_ORIGIN,
+		CMD_PREALLOCATE,
+		CMD_FLUSH_MEMORY,
+		CMD_FORCE_REBUILD,
+		CMD_MERGE
+	};
+
+	// Recorded update. Pointers to user data (BVH, pruning structure, arrays of shapes) are only recorded for updates
+	// that immediately publish, i.e. they are replayed before the update call returns.
+	struct Command
+	{
+		PxBounds3				mBounds;
+		PxTransform				mTransform;
+		const PxRigidActor*		mActor;
+		const PxShape*			mShape;
+		const PxShape**			mShapes;
+		const void*				mData;
+		const PxTransform*		mTransforms;
+		PxU32					mType;
+		PxU32					mIndex;		// pruner index, compound handle, or number of shapes
+		PxU32					mStart;		// first item in the log arrays
+		PxU32					mCount;		// number of items in the log arrays
+		bool					mHasCompound;
+		bool					mHasPruningStructure;
+	};
+
+	class VersionedPxSQ : public PxVersionedSceneQuerySystem, public PxUserAllocated
+	{
+		public:
+												VersionedPxSQ(PxSceneQuerySystem& system0, PxSceneQuerySystem& system1, PxSceneQueryUpdateMode::Enum mode);
+		virtual									~VersionedPxSQ();
+
+		// PxSceneQuerySystem
+		virtual	void							release();
+		virtual	void							acquireReference()																	{ mRefCount++;											}
+		virtual	void							preallocate(PxU32 prunerIndex, PxU32 nbShapes);
+		virtual	void							addSQShape(	const PxRigidActor& actor, const PxShape& shape, const PxBounds3& bounds,
+															const PxTransform& transform, const PxSQCompoundHandle* compoundHandle, bool hasPruningStructure);
+		virtual	void							removeSQShape(const PxRigidActor& actor, const PxShape& shape);
+		virtual	void							updateSQShape(const PxRigidActor& actor, const PxShape& shape, const PxTransform& transform);
+		virtual	PxSQCompoundHandle				addSQCompound(const PxRigidActor& actor, const PxShape** shapes, const PxBVH& bvh, const PxTransform* transforms);
+		virtual	void							removeSQCompound(PxSQCompoundHandle compoundHandle);
+		virtual	void							updateSQCompound(PxSQCompoundHandle compoundHandle, const PxTransform& compoundTransform);
+		virtual	void							updateSQCompounds(const PxSQCompoundHandle* compoundHandles, const PxTransform* compoundTransforms, PxU32 nbCompounds);
+		virtual	void							flushUpdates()																		{ publish();											}
+		virtual	void							flushMemory();
+		virtual	void							visualize(PxU32 prunerIndex, PxRenderOutput& out)		const;
+		virtual	void							shiftOrigin(const PxVec3& shift);
+		virtual	PxSQBuildStepHandle				prepareSceneQueryBuildStep(PxU32 prunerIndex);
+		virtual	void							sceneQueryBuildStep(PxSQBuildStepHandle handle);
+		virtual	void							finalizeUpdates();
+		virtual	void							setDynamicTreeRebuildRateHint(PxU32 dynTreeRebuildRateHint);
+		virtual	PxU32							getDynamicTreeRebuildRateHint()							const						{ return getBack().getDynamicTreeRebuildRateHint();	}
+		virtual	void							forceRebuildDynamicTree(PxU32 prunerIndex);
+		virtual	PxSceneQueryUpdateMode::Enum	getUpdateMode()											const						{ return mUpdateMode;									}
+		virtual	void							setUpdateMode(PxSceneQueryUpdateMode::Enum mode)									{ mUpdateMode = mode;									}
+		virtual	PxU32							getStaticTimestamp()									const;
+		virtual	void							getDynamicTreeRefitStats(PxDynamicTreeRefitStats& stats)	const;
+		virtual	void							merge(const PxPruningStructure& pxps);
+		virtual	bool							raycast(const PxVec3& origin, const PxVec3& unitDir, const PxReal distance,
+														PxRaycastCallback& hitCall, PxHitFlags hitFlags,
+														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+														const PxQueryCache* cache, PxGeometryQueryFlags flags)	const;
+		virtual	bool							sweep(	const PxGeometry& geometry, const PxTransform& pose,
+														const PxVec3& unitDir, const PxReal distance,
+														PxSweepCallback& hitCall, PxHitFlags hitFlags,
+														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+														const PxQueryCache* cache, const PxReal inflation, PxGeometryQueryFlags flags)	const;
+		virtual	bool							overlap(const PxGeometry& geometry, const PxTransform& transform,
+														PxOverlapCallback& hitCall,
+														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+														const PxQueryCache* cache, PxGeometryQueryFlags flags)	const;
+		virtual	PxSQPrunerHandle				getHandle(const PxRigidActor& actor, const PxShape& shape, PxU32& prunerIndex)	const	{ return getBack().getHandle(actor, shape, prunerIndex);	}
+		virtual	void							sync(PxU32 prunerIndex, const PxSQPrunerHandle* handles, const PxU32* indices, const PxBounds3* bounds,
+													const PxTransform32* transforms, PxU32 count, const PxBitMap& ignoredIndices);
+		//~PxSceneQuerySystem
+
+		// PxVersionedSceneQuerySystem
+		virtual	void							publish();
+		virtual	PxU32							getVersion()	const	{ return PxU32(mVersion);	}
+		//~PxVersionedSceneQuerySystem
+
+		private:
+		// Registers a reader on the front system and returns its index. The reader count is incremented before checking
+		// that the system is still the front one, so that publish() either sees the reader or the reader sees the swap.
+		PX_FORCE_INLINE	PxU32					acquireFront()	const
+												{
+													for(;;)
+													{
+														const PxI32 front = mFront;
+														PxAtomicIncrement(&mNbReaders[front]);
+														if(front == mFront)
+															return PxU32(front);
+														releaseFront(PxU32(front));
+													}
+												}
+
+		// The last reader of a system that is no longer the front one wakes up publish(). Both the decrement here and the swap
+		// in publish() are full barriers, so either the reader sees the swap or publish() sees the reader count drop to zero.
+		PX_FORCE_INLINE	void					releaseFront(PxU32 front)	const
+												{
+													if(!PxAtomicDecrement(&mNbReaders[front]) && PxI32(front) != mFront)
+														mReadersDone.set();
+												}
+
+		// Blocks until count is zero. The sync is only reset here, and set after the count was decremented, so a wake-up
+		// cannot be lost. Stale wake-ups just re-check the count.
+		static			void					waitForZero(volatile PxI32& count, PxSync& sync)
+												{
+													for(;;)
+													{
+														sync.reset();
+														if(!count)
+															return;
+														sync.wait();
+													}
+												}
+
+		PX_FORCE_INLINE	PxSceneQuerySystem&		getBack()	const	{ return *mSystems[1 - mFront];	}
+
+		PX_FORCE_INLINE	Command&				addCommand(CommandType type)
+												{
+													Command& cmd = mCommands.insert();
+													cmd.mType = type;
+													cmd.mActor = NULL;
+													cmd.mShape = NULL;
+													cmd.mShapes = NULL;
+													cmd.mData = NULL;
+													cmd.mTransforms = NULL;
+													cmd.mIndex = 0;
+													cmd.mStart = 0;
+													cmd.mCount = 0;
+													cmd.mHasCompound = false;
+													cmd.mHasPruningStructure = false;
+													return cmd;
+												}
+
+				void							replay(PxSceneQuerySystem& system);
+
+				PxSceneQuerySystem*				mSystems[2];
+				PxSceneQueryUpdateMode::Enum	mUpdateMode;
+				PxU32							mRefCount;
+
+				// index of the published system, and number of queries running against each system
+				volatile PxI32					mFront;
+		mutable	volatile PxI32					mNbReaders[2];
+				volatile PxI32					mVersion;
+				volatile PxI32					mNbPendingBuildSteps;
+				volatile PxI32					mBuildStepsCompleted;	// build steps have progressed the back system since the last publish
+		mutable	PxSync							mReadersDone;
+				PxSync							mBuildStepsDone;
+
+				// updates applied to the back system but not to the front system yet
+				PxArray<Command>				mCommands;
+				PxArray<PxSQCompoundHandle>		mLogCompoundHandles;
+				PxArray<PxTransform>			mLogCompoundTransforms;
+				PxArray<PxSQPrunerHandle>		mLogSyncHandles;
+				PxArray<PxU32>					mLogSyncIndices;
+				PxArray<PxBounds3>				mLogSyncBounds;
+				PxArray<PxTransform32>			mLogSyncTransforms;
+				PxBitMap						mNoIgnoredIndices;
+
+		PX_NOCOPY(VersionedPxSQ)
+	};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+VersionedPxSQ::VersionedPxSQ(PxSceneQuerySystem& system0, PxSceneQuerySystem& system1, PxSceneQueryUpdateMode::Enum mode) :
+	mUpdateMode				(mode),
+	mRefCount				(1),
+	mFront					(0),
+	mVersion				(0),
+	mNbPendingBuildSteps	(0),
+	mBuildStepsCompleted	(0)
+{
+	mSystems[0] = &system0;
+	mSystems[1] = &system1;
+	mNbReaders[0] = 0;
+	mNbReaders[1] = 0;
+
+	// the update mode is handled here, the wrapped systems always commit what they are asked to
+	system0.setUpdateMode(PxSceneQueryUpdateMode::eBUILD_ENABLED_COMMIT_ENABLED);
+	system1.setUpdateMode(PxSceneQueryUpdateMode::eBUILD_ENABLED_COMMIT_ENABLED);
+}
+
+VersionedPxSQ::~VersionedPxSQ()
+{
+	PX_ASSERT(!mNbReaders[0] && !mNbReaders[1]);
+	mSystems[0]->release();
+	mSystems[1]->release();
+}
+
+void VersionedPxSQ::release()
+{
+	mRefCount--;
+	if(!mRefCount)
+	{
+		removeExternalSQ(this);
+		PX_DELETE_THIS;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void VersionedPxSQ::replay(PxSceneQuerySystem& system)
+{
+	const PxU32 nbCommands = mCommands.size();
+	for(PxU32 i=0;i<nbCommands;i++)
+	{
+		const Command& cmd = mCommands[i];
+		switch(cmd.mType)
+		{
+			case CMD_ADD_SHAPE:
+			{
+				const PxSQCompoundHandle compoundHandle = cmd.mIndex;
+				system.addSQShape(*cmd.mActor, *cmd.mShape, cmd.mBounds, cmd.mTransform, cmd.mHasCompound ? &compoundHandle : NULL, cmd.mHasPruningStructure);
+				break;
+			}
+			case CMD_REMOVE_SHAPE:
+				system.removeSQShape(*cmd.mActor, *cmd.mShape);
+				break;
+			case CMD_UPDATE_SHAPE:
+				system.updateSQShape(*cmd.mActor, *cmd.mShape, cmd.mTransform);
+				break;
+			case CMD_ADD_COMPOUND:
+			{
+				const PxSQCompoundHandle compoundHandle = system.addSQCompound(*cmd.mActor, cmd.mShapes, *reinterpret_cast<const PxBVH*>(cmd.mData), cmd.mTransforms);
+				PX_ASSERT(compoundHandle == cmd.mIndex);
+				PX_UNUSED(compoundHandle);
+				break;
+			}
+			case CMD_REMOVE_COMPOUND:
+				system.removeSQCompound(cmd.mIndex);
+				break;
+			case CMD_UPDATE_COMPOUND:
+				system.updateSQCompound(cmd.mIndex, cmd.mTransform);
+				break;
+			case CMD_UPDATE_COMPOUNDS:
+				system.updateSQCompounds(mLogCompoundHandles.begin() + cmd.mStart, mLogCompoundTransforms.begin() + cmd.mStart, cmd.mCount);
+				break;
+			case CMD_SYNC:
+				// the indices point to the logged bounds & transforms, and ignored indices have been skipped when logging
+				system.sync(cmd.mIndex, mLogSyncHandles.begin() + cmd.mStart, mLogSyncIndices.begin() + cmd.mStart, mLogSyncBounds.begin(), mLogSyncTransforms.begin(), cmd.mCount, mNoIgnoredIndices);
+				break;
+			case CMD_FINALIZE:
+				system.finalizeUpdates();
+				break;
+			case CMD_SHIFT_ORIGIN:
+				system.shiftOrigin(cmd.mTransform.p);
+				break;
+			case CMD_PREALLOCATE:
+				system.preallocate(cmd.mIndex, cmd.mCount);
+				break;
+			case CMD_FLUSH_MEMORY:
+				system.flushMemory();
+				break;
+			case CMD_FORCE_REBUILD:
+				system.forceRebuildDynamicTree(cmd.mIndex);
+				break;
+			case CMD_MERGE:
+				system.merge(*reinterpret_cast<const PxPruningStructure*>(cmd.mData));
+				break;
+		}
+	}
+
+	mCommands.clear();
+	mLogCompoundHandles.clear();
+	mLogCompoundTransforms.clear();
+	mLogSyncHandles.clear();
+	mLogSyncIndices.clear();
+	mLogSyncBounds.clear();
+	mLogSyncTransforms.clear();
+}
+
+void VersionedPxSQ::publish()
+{
+	// the build steps run on the back system, which must not be published before they complete
+	waitForZero(mNbPendingBuildSteps, mBuildStepsDone);
+
+	// publish if there are updates to replay, or if build steps have made the back system's trees more recent than the front ones
+	if(mCommands.empty() && !mBuildStepsCompleted)
+		return;
+
+	mBuildStepsCompleted = 0;
+
+	const PxI32 previous = mFront;
+	mSystems[1 - previous]->flushUpdates();
+
+	// from now on new queries run against the new version
+	PxAtomicExchange(&mFront, 1 - previous);
+	PxAtomicIncrement(&mVersion);
+
+	// wait for the queries still running against the previous version, then bring it up-to-date
+	waitForZero(mNbReaders[previous], mReadersDone);
+
+	replay(*mSystems[previous]);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void VersionedPxSQ::preallocate(PxU32 prunerIndex, PxU32 nbShapes)
+{
+	getBack().preallocate(prunerIndex, nbShapes);
+
+	Command& cmd = addCommand(CMD_PREALLOCATE);
+	cmd.mIndex = prunerIndex;
+	cmd.mCount = nbShapes;
+}
+
+void VersionedPxSQ::addSQShape(const PxRigidActor& actor, const PxShape& shape, const PxBounds3& bounds, const PxTransform& transform, const PxSQCompoundHandle* compoundHandle, bool hasPruningStructure)
+{
+	getBack().addSQShape(actor, shape, bounds, transform, compoundHandle, hasPruningStructure);
+
+	Command& cmd = addCommand(CMD_ADD_SHAPE);
+	cmd.mActor = &actor;
+	cmd.mShape = &shape;
+	cmd.mBounds = bounds;
+	cmd.mTransform = transform;
+	cmd.mIndex = compoundHandle ? *compoundHandle : 0;
+	cmd.mHasCompound = compoundHandle!=NULL;
+	cmd.mHasPruningStructure = hasPruningStructure;
+}
+
+void VersionedPxSQ::removeSQShape(const PxRigidActor& actor, const PxShape& shape)
+{
+	getBack().removeSQShape(actor, shape);
+
+	Command& cmd = addCommand(CMD_REMOVE_SHAPE);
+	cmd.mActor = &actor;
+	cmd.mShape = &shape;
+
+	// the shape can be released as soon as we return, so it must be removed from both versions now
+	publish();
+}
+
+void VersionedPxSQ::updateSQShape(const PxRigidActor& actor, const PxShape& shape, const PxTransform& transform)
+{
+	getBack().updateSQShape(actor, shape, transform);
+
+	Command& cmd = addCommand(CMD_UPDATE_SHAPE);
+	cmd.mActor = &actor;
+	cmd.mShape = &shape;
+	cmd.mTransform = transform;
+}
+
+PxSQCompoundHandle VersionedPxSQ::addSQCompound(const PxRigidActor& actor, const PxShape** shapes, const PxBVH& bvh, const PxTransform* transforms)
+{
+	const PxSQCompoundHandle compoundHandle = getBack().addSQCompound(actor, shapes, bvh, transforms);
+
+	Command& cmd = addCommand(CMD_ADD_COMPOUND);
+	cmd.mActor = &actor;
+	cmd.mShapes = shapes;
+	cmd.mData = &bvh;
+	cmd.mTransforms = transforms;
+	cmd.mIndex = compoundHandle;
+
+	// the BVH and the input arrays are only valid during this call
+	publish();
+	return compoundHandle;
+}
+
+void VersionedPxSQ::removeSQCompound(PxSQCompoundHandle compoundHandle)
+{
+	getBack().removeSQCompound(compoundHandle);
+
+	Command& cmd = addCommand(CMD_REMOVE_COMPOUND);
+	cmd.mIndex = compoundHandle;
+
+	publish();
+}
+
+void VersionedPxSQ::updateSQCompound(PxSQCompoundHandle compoundHandle, const PxTransform& compoundTransform)
+{
+	getBack().updateSQCompound(compoundHandle, compoundTransform);
+
+	Command& cmd = addCommand(CMD_UPDATE_COMPOUND);
+	cmd.mIndex = compoundHandle;
+	cmd.mTransform = compoundTransform;
+}
+
+void VersionedPxSQ::updateSQCompounds(const PxSQCompoundHandle* compoundHandles, const PxTransform* compoundTransforms, PxU32 nbCompounds)
+{
+	if(!nbCompounds)
+		return;
+
+	getBack().updateSQCompounds(compoundHandles, compoundTransforms, nbCompounds);
+
+	Command& cmd = addCommand(CMD_UPDATE_COMPOUNDS);
+	cmd.mStart = mLogCompoundHandles.size();
+	cmd.mCount = nbCompounds;
+	for(PxU32 i=0;i<nbCompounds;i++)
+	{
+		mLogCompoundHandles.pushBack(compoundHandles[i]);
+		mLogCompoundTransforms.pushBack(compoundTransforms[i]);
+	}
+}
+
+void VersionedPxSQ::sync(PxU32 prunerIndex, const PxSQPrunerHandle* handles, const PxU32* indices, const PxBounds3* bounds,
+						const PxTransform32* transforms, PxU32 count, const PxBitMap& ignoredIndices)
+{
+	if(!count)
+		return;
+
+	getBack().sync(prunerIndex, handles, indices, bounds, transforms, count, ignoredIndices);
+
+	// the bounds & transforms belong to the caller, so we copy the ones referenced by the indices
+	Command& cmd = addCommand(CMD_SYNC);
+	cmd.mIndex = prunerIndex;
+	cmd.mStart = mLogSyncHandles.size();
+
+	const bool checkIgnored = ignoredIndices.count()!=0;
+	PxU32 nbLogged = 0;
+	for(PxU32 i=0;i<count;i++)
+	{
+		const PxU32 index = indices[i];
+		if(checkIgnored && ignoredIndices.boundedTest(index))
+			continue;
+
+		mLogSyncHandles.pushBack(handles[i]);
+		mLogSyncIndices.pushBack(mLogSyncBounds.size());
+		mLogSyncBounds.pushBack(bounds[index]);
+		mLogSyncTransforms.pushBack(transforms[index]);
+		nbLogged++;
+	}
+	cmd.mCount = nbLogged;
+}
+
+void VersionedPxSQ::flushMemory()
+{
+	getBack().flushMemory();
+	addCommand(CMD_FLUSH_MEMORY);
+}
+
+void VersionedPxSQ::visualize(PxU32 prunerIndex, PxRenderOutput& out) const
+{
+	const PxU32 front = acquireFront();
+	mSystems[front]->visualize(prunerIndex, out);
+	releaseFront(front);
+}
+
+void VersionedPxSQ::shiftOrigin(const PxVec3& shift)
+{
+	getBack().shiftOrigin(shift);
+
+	Command& cmd = addCommand(CMD_SHIFT_ORIGIN);
+	cmd.mTransform = PxTransform(shift);
+
+	// queries in the previous coordinate system would return wrong results
+	publish();
+}
+
+PxSQBuildStepHandle VersionedPxSQ::prepareSceneQueryBuildStep(PxU32 prunerIndex)
+{
+	const PxSQBuildStepHandle handle = getBack().prepareSceneQueryBuildStep(prunerIndex);
+	if(handle)
+		PxAtomicIncrement(&mNbPendingBuildSteps);
+	return handle;
+}
+
+void VersionedPxSQ::sceneQueryBuildStep(PxSQBuildStepHandle handle)
+{
+	// this runs in parallel with queries, which do not touch the back system
+	getBack().sceneQueryBuildStep(handle);
+	PxAtomicExchange(&mBuildStepsCompleted, 1);
+	if(!PxAtomicDecrement(&mNbPendingBuildSteps))
+		mBuildStepsDone.set();
+}
+
+void VersionedPxSQ::finalizeUpdates()
+{
+	switch(mUpdateMode)
+	{
+		case PxSceneQueryUpdateMode::eBUILD_ENABLED_COMMIT_ENABLED:
+		{
+			getBack().finalizeUpdates();
+			addCommand(CMD_FINALIZE);
+			publish();
+		}
+		break;
+		case PxSceneQueryUpdateMode::eBUILD_ENABLED_COMMIT_DISABLED:
+		{
+			getBack().finalizeUpdates();
+			addCommand(CMD_FINALIZE);
+		}
+		break;
+		case PxSceneQueryUpdateMode::eBUILD_DISABLED_COMMIT_DISABLED:
+		break;
+	}
+}
+
+void VersionedPxSQ::setDynamicTreeRebuildRateHint(PxU32 dynTreeRebuildRateHint)
+{
+	// only used by updates, not by queries
+	mSystems[0]->setDynamicTreeRebuildRateHint(dynTreeRebuildRateHint);
+	mSystems[1]->setDynamicTreeRebuildRateHint(dynTreeRebuildRateHint);
+}
+
+void VersionedPxSQ::forceRebuildDynamicTree(PxU32 prunerIndex)
+{
+	getBack().forceRebuildDynamicTree(prunerIndex);
+
+	Command& cmd = addCommand(CMD_FORCE_REBUILD);
+	cmd.mIndex = prunerIndex;
+}
+
+PxU32 VersionedPxSQ::getStaticTimestamp() const
+{
+	const PxU32 front = acquireFront();
+	const PxU32 timestamp = mSystems[front]->getStaticTimestamp();
+	releaseFront(front);
+	return timestamp;
+}
+
+void VersionedPxSQ::getDynamicTreeRefitStats(PxDynamicTreeRefitStats& stats) const
+{
+	const PxU32 front = acquireFront();
+	mSystems[front]->getDynamicTreeRefitStats(stats);
+	releaseFront(front);
+}
+
+void VersionedPxSQ::merge(const PxPruningStructure& pxps)
+{
+	getBack().merge(pxps);
+
+	Command& cmd = addCommand(CMD_MERGE);
+	cmd.mData = &pxps;
+
+	// the pruning structure can be released as soon as we return
+	publish();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool VersionedPxSQ::raycast(const PxVec3& origin, const PxVec3& unitDir, const PxReal distance,
+							PxRaycastCallback& hitCall, PxHitFlags hitFlags,
+							const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+							const PxQueryCache* cache, PxGeometryQueryFlags flags) const
+{
+	const PxU32 front = acquireFront();
+	const bool status = mSystems[front]->raycast(origin, unitDir, distance, hitCall, hitFlags, filterData, filterCall, cache, flags);
+	releaseFront(front);
+	return status;
+}
+
+bool VersionedPxSQ::sweep(	const PxGeometry& geometry, const PxTransform& pose,
+							const PxVec3& unitDir, const PxReal distance,
+							PxSweepCallback& hitCall, PxHitFlags hitFlags,
+							const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+							const PxQueryCache* cache, const PxReal inflation, PxGeometryQueryFlags flags) const
+{
+	const PxU32 front = acquireFront();
+	const bool status = mSystems[front]->sweep(geometry, pose, unitDir, distance, hitCall, hitFlags, filterData, filterCall, cache, inflation, flags);
+	releaseFront(front);
+	return status;
+}
+
+bool VersionedPxSQ::overlap(const PxGeometry& geometry, const PxTransform& transform,
+							PxOverlapCallback& hitCall,
+							const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
+							const PxQueryCache* cache, PxGeometryQueryFlags flags) const
+{
+	const PxU32 front = acquireFront();
+	const bool status = mSystems[front]->overlap(geometry, transform, hitCall, filterData, filterCall, cache, flags);
+	releaseFront(front);
+	return status;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+PxVersionedSceneQuerySystem* physx::PxCreateVersionedSceneQuerySystem(const PxSceneQueryDesc& desc, PxU64 contextID)
+{
+	if(!desc.isValid())
+	{
+		PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxCreateVersionedSceneQuerySystem: invalid descriptor.");
+		return NULL;
+	}
+
+	// both versions are created from the same descriptor, so that they return the same handles for the same updates
+	PxSceneQuerySystem* system0 = PxCreateExternalSceneQuerySystem(desc, contextID);
+	PxSceneQuerySystem* system1 = PxCreateExternalSceneQuerySystem(desc, contextID);
+
+	// the versioned system owns them, they are released with it
+	removeExternalSQ(system0);
+	removeExternalSQ(system1);
+
+	VersionedPxSQ* pxsq = PX_NEW(VersionedPxSQ)(*system0, *system1, desc.sceneQueryUpdateMode);
+
+	addExternalSQ(pxsq);
+
+	return pxsq;
+}
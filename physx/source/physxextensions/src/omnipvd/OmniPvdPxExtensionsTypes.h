@@ -46,6 +46,7 @@ OMNI_PVD_ENUM_VALUE		(constraintflag,		eENABLE_EXTENDED_LIMITS,					PxConstraint
 OMNI_PVD_ENUM_VALUE		(constraintflag,		eGPU_COMPATIBLE,							PxConstraintFlag::eGPU_COMPATIBLE)
 OMNI_PVD_ENUM_VALUE		(constraintflag,		eALWAYS_UPDATE,								PxConstraintFlag::eALWAYS_UPDATE)
 OMNI_PVD_ENUM_VALUE		(constraintflag,		eDISABLE_CONSTRAINT,						PxConstraintFlag::eDISABLE_CONSTRAINT)
+OMNI_PVD_ENUM_VALUE		(constraintflag,		eWARM_START,								PxConstraintFlag::eWARM_START)
 
 OMNI_PVD_ENUM			(revolutejointflag,		PxRevoluteJointFlag)
 OMNI_PVD_ENUM_VALUE		(revolutejointflag,		eLIMIT_ENABLED,								PxRevoluteJointFlag::eLIMIT_ENABLED)
@@ -1459,6 +1459,7 @@ template<> struct PxEnumTraits< physx::PxArticulationCacheFlag::Enum > { PxEnumT
 		{ "eGPU_COMPATIBLE", static_cast<PxU32>( physx::PxConstraintFlag::eGPU_COMPATIBLE ) },
 		{ "eALWAYS_UPDATE", static_cast<PxU32>( physx::PxConstraintFlag::eALWAYS_UPDATE ) },
 		{ "eDISABLE_CONSTRAINT", static_cast<PxU32>( physx::PxConstraintFlag::eDISABLE_CONSTRAINT ) },
+		{ "eWARM_START", static_cast<PxU32>( physx::PxConstraintFlag::eWARM_START ) },
 		{ NULL, 0 }
 	};
 
@@ -2377,6 +2378,7 @@ template<> struct PxEnumTraits< physx::PxGeometryQueryFlag::Enum > { PxEnumTrait
 		{ "eNONE", static_cast<PxU32>( physx::PxPruningStructureType::eNONE ) },
 		{ "eDYNAMIC_AABB_TREE", static_cast<PxU32>( physx::PxPruningStructureType::eDYNAMIC_AABB_TREE ) },
 		{ "eSTATIC_AABB_TREE", static_cast<PxU32>( physx::PxPruningStructureType::eSTATIC_AABB_TREE ) },
+		{ "eHASH_GRID", static_cast<PxU32>( physx::PxPruningStructureType::eHASH_GRID ) },
 		{ "eLAST", static_cast<PxU32>( physx::PxPruningStructureType::eLAST ) },
 		{ NULL, 0 }
 	};
@@ -3107,6 +3109,7 @@ template<> struct PxEnumTraits< physx::PxDynamicTreeSecondaryPruner::Enum > { Px
 		{ "eFAST", static_cast<PxU32>( physx::PxBVHBuildStrategy::eFAST ) },
 		{ "eDEFAULT", static_cast<PxU32>( physx::PxBVHBuildStrategy::eDEFAULT ) },
 		{ "eSAH", static_cast<PxU32>( physx::PxBVHBuildStrategy::eSAH ) },
+		{ "eBINNED_SAH", static_cast<PxU32>( physx::PxBVHBuildStrategy::eBINNED_SAH ) },
 		{ "eLAST", static_cast<PxU32>( physx::PxBVHBuildStrategy::eLAST ) },
 		{ NULL, 0 }
 	};
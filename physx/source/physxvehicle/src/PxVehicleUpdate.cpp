@@ -28,6 +28,8 @@
 
 #include "foundation/PxQuat.h"
 #include "foundation/PxBitMap.h"
+#include "foundation/PxInlineArray.h"
+#include "foundation/PxIntrinsics.h"
 #include "common/PxProfileZone.h"
 #include "common/PxTolerancesScale.h"
 #include "vehicle/PxVehicleUpdate.h"
@@ -4531,6 +4533,11 @@ public:
 		const PxU32 numVehicles, PxVehicleWheels** vehicles, PxVehicleWheelQueryResult* wheelQueryResults, PxVehicleConcurrentUpdateData* vehicleConcurrentUpdates,
 		VehicleTelemetryDataContext* vehicleTelemetryDataContext, const PxVehicleContext&);
 
+	static void updateGrouped(
+		const PxF32 timestep, const PxVec3& gravity, const PxVehicleDrivableSurfaceToTireFrictionPairs& vehicleDrivableSurfaceToTireFrictionPairs, 
+		const PxU32 numVehicles, PxVehicleWheels** vehicles, PxVehicleWheelQueryResult* wheelQueryResults, PxVehicleConcurrentUpdateData* vehicleConcurrentUpdates,
+		const PxVehicleContext&);
+
 	static void updatePost(
 		const PxVehicleConcurrentUpdateData* vehicleConcurrentUpdates, const PxU32 numVehicles, PxVehicleWheels** vehicles,
 		const PxVehicleContext&);
@@ -4576,6 +4583,38 @@ public:
 		PxVehicleNoDrive* vehDriveTank, PxVehicleWheelQueryResult* vehWheelQueryResults, PxVehicleConcurrentUpdateData* vehConcurrentUpdates,
 		VehicleTelemetryDataContext*, const PxVehicleContext&);
 
+	static bool checkUpdateParams(
+		const PxF32 timestep, const PxVec3& gravity, 
+		const PxU32 numVehicles, PxVehicleWheels** vehicles, PxVehicleWheelQueryResult* wheelQueryResults, PxVehicleConcurrentUpdateData* vehicleConcurrentUpdates);
+
+	template<class VehicleType>
+	static void updateGroup(
+		void (*updateFn)(const PxF32, const PxVec3&, const PxF32, const PxF32, const PxVehicleDrivableSurfaceToTireFrictionPairs&,
+			VehicleType*, PxVehicleWheelQueryResult*, PxVehicleConcurrentUpdateData*, VehicleTelemetryDataContext*, const PxVehicleContext&),
+		const PxF32 timestep, 
+		const PxVec3& gravity, const PxF32 gravityMagnitude, const PxF32 recipGravityMagnitude, 
+		const PxVehicleDrivableSurfaceToTireFrictionPairs& drivableSurfaceToTireFrictionPairs,
+		const PxU32* vehicleIndices, const PxU32 numVehicleIndices, PxVehicleWheels** vehicles,
+		PxVehicleWheelQueryResult* vehWheelQueryResults, PxVehicleConcurrentUpdateData* vehConcurrentUpdates,
+		const PxVehicleContext& context)
+	{
+		for(PxU32 i=0;i<numVehicleIndices;i++)
+		{
+			const PxU32 vehicleIndex=vehicleIndices[i];
+			if(i+1<numVehicleIndices)
+				PxPrefetchLine(vehicles[vehicleIndices[i+1]]);
+
+			updateFn(
+				timestep,
+				gravity,gravityMagnitude,recipGravityMagnitude,
+				drivableSurfaceToTireFrictionPairs,
+				static_cast<VehicleType*>(vehicles[vehicleIndex]),
+				vehWheelQueryResults ? &vehWheelQueryResults[vehicleIndex] : NULL,
+				vehConcurrentUpdates ? &vehConcurrentUpdates[vehicleIndex] : NULL,
+				NULL, context);
+		}
+	}
+
 	static PxU32 computeNumberOfSubsteps(const PxVehicleWheelsSimData& wheelsSimData, const PxVec3& linVel, const PxTransform& globalPose, const PxVec3& forward)
 	{
 		const PxVec3 z=globalPose.q.rotate(forward);
@@ -6854,14 +6893,13 @@ void physx::PxVehicleUpdateSingleVehicleAndStoreTelemetryData
 //Update an array of vehicles of any type
 ////////////////////////////////////////////////////////////
 
-void PxVehicleUpdate::update
-(const PxF32 timestep, const PxVec3& gravity, const PxVehicleDrivableSurfaceToTireFrictionPairs& vehicleDrivableSurfaceToTireFrictionPairs, 
- const PxU32 numVehicles, PxVehicleWheels** vehicles, PxVehicleWheelQueryResult* vehicleWheelQueryResults, PxVehicleConcurrentUpdateData* vehicleConcurrentUpdates,
- VehicleTelemetryDataContext* vehicleTelemetryDataContext, const PxVehicleContext& context)
+bool PxVehicleUpdate::checkUpdateParams
+(const PxF32 timestep, const PxVec3& gravity, 
+ const PxU32 numVehicles, PxVehicleWheels** vehicles, PxVehicleWheelQueryResult* vehicleWheelQueryResults, PxVehicleConcurrentUpdateData* vehicleConcurrentUpdates)
 {
-	PX_CHECK_AND_RETURN(gravity.magnitude()>0, "gravity vector must have non-zero length");
-	PX_CHECK_AND_RETURN(timestep>0, "timestep must be greater than zero");
-	PX_CHECK_AND_RETURN(gThresholdForwardSpeedForWheelAngleIntegration>0, "PxInitVehicleSDK needs to be called before ever calling PxVehicleUpdates or PxVehicleUpdateSingleVehicleAndStoreTelemetryData");
+	PX_CHECK_AND_RETURN_VAL(gravity.magnitude()>0, "gravity vector must have non-zero length", false);
+	PX_CHECK_AND_RETURN_VAL(timestep>0, "timestep must be greater than zero", false);
+	PX_CHECK_AND_RETURN_VAL(gThresholdForwardSpeedForWheelAngleIntegration>0, "PxInitVehicleSDK needs to be called before ever calling PxVehicleUpdates or PxVehicleUpdateSingleVehicleAndStoreTelemetryData", false);
 
 #if PX_CHECKED
 	for(PxU32 i=0;i<numVehicles;i++)
@@ -6885,35 +6923,55 @@ void PxVehicleUpdate::update
 		}
 		PX_CHECK_MSG(vehWheels->mWheelsDynData.mTireForceCalculators->mShader, "Need to set non-null tire force shader function");
 
-		PX_CHECK_AND_RETURN(NULL==vehicleWheelQueryResults || vehicleWheelQueryResults[i].nbWheelQueryResults >= vehicles[i]->mWheelsSimData.getNbWheels(),
-			"nbWheelQueryResults must always be greater than or equal to number of wheels in corresponding vehicle");
+		PX_CHECK_AND_RETURN_VAL(NULL==vehicleWheelQueryResults || vehicleWheelQueryResults[i].nbWheelQueryResults >= vehicles[i]->mWheelsSimData.getNbWheels(),
+			"nbWheelQueryResults must always be greater than or equal to number of wheels in corresponding vehicle", false);
 
 		for(PxU32 j=0;j<vehWheels->mWheelsSimData.mNbActiveWheels;j++)
 		{
-			PX_CHECK_AND_RETURN(!vehWheels->mWheelsSimData.getIsWheelDisabled(j) || -1==vehWheels->mWheelsSimData.getWheelShapeMapping(j), 
-				"Disabled wheels must not be associated with a PxShape:  use setWheelShapeMapping to remove the association");
+			PX_CHECK_AND_RETURN_VAL(!vehWheels->mWheelsSimData.getIsWheelDisabled(j) || -1==vehWheels->mWheelsSimData.getWheelShapeMapping(j), 
+				"Disabled wheels must not be associated with a PxShape:  use setWheelShapeMapping to remove the association", false);
 
-			PX_CHECK_AND_RETURN(!vehWheels->mWheelsSimData.getIsWheelDisabled(j) || 0==vehWheels->mWheelsDynData.getWheelRotationSpeed(j), 
-				"Disabled wheels must have zero rotation speed:  use setWheelRotationSpeed to set the wheel to zero rotation speed");
+			PX_CHECK_AND_RETURN_VAL(!vehWheels->mWheelsSimData.getIsWheelDisabled(j) || 0==vehWheels->mWheelsDynData.getWheelRotationSpeed(j), 
+				"Disabled wheels must have zero rotation speed:  use setWheelRotationSpeed to set the wheel to zero rotation speed", false);
 		}
 
-		PX_CHECK_AND_RETURN(!vehicleConcurrentUpdates || (vehicleConcurrentUpdates[i].concurrentWheelUpdates && vehicleConcurrentUpdates[i].nbConcurrentWheelUpdates >= vehicles[i]->mWheelsSimData.getNbWheels()),
-			"vehicleConcurrentUpdates is illegally configured with either null pointers or with insufficient memory for successful concurrent updates."); 
+		PX_CHECK_AND_RETURN_VAL(!vehicleConcurrentUpdates || (vehicleConcurrentUpdates[i].concurrentWheelUpdates && vehicleConcurrentUpdates[i].nbConcurrentWheelUpdates >= vehicles[i]->mWheelsSimData.getNbWheels()),
+			"vehicleConcurrentUpdates is illegally configured with either null pointers or with insufficient memory for successful concurrent updates.", false); 
 
 		for(PxU32 j=0; j < vehWheels->mWheelsSimData.mNbActiveAntiRollBars; j++)
 		{
 			const PxVehicleAntiRollBarData antiRoll = vehWheels->mWheelsSimData.getAntiRollBarData(j);
-			PX_CHECK_AND_RETURN(!vehWheels->mWheelsSimData.getIsWheelDisabled(antiRoll.mWheel0), "Wheel0 of antiroll bar is disabled.  This is not supported."); 
-			PX_CHECK_AND_RETURN(!vehWheels->mWheelsSimData.getIsWheelDisabled(antiRoll.mWheel1), "Wheel1 of antiroll bar is disabled.  This is not supported."); 
+			PX_CHECK_AND_RETURN_VAL(!vehWheels->mWheelsSimData.getIsWheelDisabled(antiRoll.mWheel0), "Wheel0 of antiroll bar is disabled.  This is not supported.", false); 
+			PX_CHECK_AND_RETURN_VAL(!vehWheels->mWheelsSimData.getIsWheelDisabled(antiRoll.mWheel1), "Wheel1 of antiroll bar is disabled.  This is not supported.", false); 
 		}
 	}
 #endif
 
+	PX_UNUSED(timestep);
+	PX_UNUSED(gravity);
+	PX_UNUSED(numVehicles);
+	PX_UNUSED(vehicles);
+	PX_UNUSED(vehicleWheelQueryResults);
+	PX_UNUSED(vehicleConcurrentUpdates);
+	return true;
+}
+
+void PxVehicleUpdate::update
+(const PxF32 timestep, const PxVec3& gravity, const PxVehicleDrivableSurfaceToTireFrictionPairs& vehicleDrivableSurfaceToTireFrictionPairs, 
+ const PxU32 numVehicles, PxVehicleWheels** vehicles, PxVehicleWheelQueryResult* vehicleWheelQueryResults, PxVehicleConcurrentUpdateData* vehicleConcurrentUpdates,
+ VehicleTelemetryDataContext* vehicleTelemetryDataContext, const PxVehicleContext& context)
+{
+	if(!checkUpdateParams(timestep, gravity, numVehicles, vehicles, vehicleWheelQueryResults, vehicleConcurrentUpdates))
+		return;
+
 	const PxF32 gravityMagnitude=gravity.magnitude();
 	const PxF32 recipGravityMagnitude=1.0f/gravityMagnitude;
 
 	for(PxU32 i=0;i<numVehicles;i++)
 	{
+		if(i+1<numVehicles)
+			PxPrefetchLine(vehicles[i+1]);
+
 		PxVehicleWheels* vehWheels=vehicles[i];
 		PxVehicleWheelQueryResult* vehWheelQueryResults = vehicleWheelQueryResults ? &vehicleWheelQueryResults[i] : NULL;
 		PxVehicleConcurrentUpdateData* vehConcurrentUpdateData = vehicleConcurrentUpdates ? &vehicleConcurrentUpdates[i] : NULL;
@@ -6978,6 +7036,73 @@ void PxVehicleUpdate::update
 	}
 }
 
+void PxVehicleUpdate::updateGrouped
+(const PxF32 timestep, const PxVec3& gravity, const PxVehicleDrivableSurfaceToTireFrictionPairs& vehicleDrivableSurfaceToTireFrictionPairs, 
+ const PxU32 numVehicles, PxVehicleWheels** vehicles, PxVehicleWheelQueryResult* vehicleWheelQueryResults, PxVehicleConcurrentUpdateData* vehicleConcurrentUpdates,
+ const PxVehicleContext& context)
+{
+	if(!checkUpdateParams(timestep, gravity, numVehicles, vehicles, vehicleWheelQueryResults, vehicleConcurrentUpdates))
+		return;
+
+	const PxF32 gravityMagnitude=gravity.magnitude();
+	const PxF32 recipGravityMagnitude=1.0f/gravityMagnitude;
+
+	//Stable counting sort of the vehicle indices by vehicle type so that each type is updated in one contiguous run.
+	//Results are still written to the entries of vehicleWheelQueryResults and vehicleConcurrentUpdates matching the original vehicle order.
+	PxU32 typeStarts[PxVehicleTypes::eMAX_NB_VEHICLE_TYPES+1];
+	PxMemZero(typeStarts, sizeof(typeStarts));
+	for(PxU32 i=0;i<numVehicles;i++)
+	{
+		PX_ASSERT(vehicles[i]->mType < PxVehicleTypes::eMAX_NB_VEHICLE_TYPES);
+		typeStarts[vehicles[i]->mType+1]++;
+	}
+	for(PxU32 i=0;i<PxVehicleTypes::eMAX_NB_VEHICLE_TYPES;i++)
+		typeStarts[i+1]+=typeStarts[i];
+
+	PxU32 typeOffsets[PxVehicleTypes::eMAX_NB_VEHICLE_TYPES];
+	PxMemCopy(typeOffsets, typeStarts, sizeof(typeOffsets));
+
+	PxInlineArray<PxU32, 64> sortedIndices;
+	sortedIndices.resizeUninitialized(numVehicles);
+	for(PxU32 i=0;i<numVehicles;i++)
+		sortedIndices[typeOffsets[vehicles[i]->mType]++]=i;
+
+	for(PxU32 type=0;type<PxVehicleTypes::eMAX_NB_VEHICLE_TYPES;type++)
+	{
+		const PxU32* indices=sortedIndices.begin()+typeStarts[type];
+		const PxU32 nbIndices=typeStarts[type+1]-typeStarts[type];
+		if(!nbIndices)
+			continue;
+
+		switch(type)
+		{
+		case PxVehicleTypes::eDRIVE4W:
+			updateGroup<PxVehicleDrive4W>(&PxVehicleUpdate::updateDrive4W, timestep, gravity, gravityMagnitude, recipGravityMagnitude,
+				vehicleDrivableSurfaceToTireFrictionPairs, indices, nbIndices, vehicles, vehicleWheelQueryResults, vehicleConcurrentUpdates, context);
+			break;
+
+		case PxVehicleTypes::eDRIVENW:
+			updateGroup<PxVehicleDriveNW>(&PxVehicleUpdate::updateDriveNW, timestep, gravity, gravityMagnitude, recipGravityMagnitude,
+				vehicleDrivableSurfaceToTireFrictionPairs, indices, nbIndices, vehicles, vehicleWheelQueryResults, vehicleConcurrentUpdates, context);
+			break;
+
+		case PxVehicleTypes::eDRIVETANK:
+			updateGroup<PxVehicleDriveTank>(&PxVehicleUpdate::updateTank, timestep, gravity, gravityMagnitude, recipGravityMagnitude,
+				vehicleDrivableSurfaceToTireFrictionPairs, indices, nbIndices, vehicles, vehicleWheelQueryResults, vehicleConcurrentUpdates, context);
+			break;
+
+		case PxVehicleTypes::eNODRIVE:
+			updateGroup<PxVehicleNoDrive>(&PxVehicleUpdate::updateNoDrive, timestep, gravity, gravityMagnitude, recipGravityMagnitude,
+				vehicleDrivableSurfaceToTireFrictionPairs, indices, nbIndices, vehicles, vehicleWheelQueryResults, vehicleConcurrentUpdates, context);
+			break;
+
+		default:
+			PX_CHECK_MSG(false, "updateGrouped - unsupported vehicle type"); 
+			break;
+		}
+	}
+}
+
 
 void PxVehicleUpdate::updatePost
 (const PxVehicleConcurrentUpdateData* vehicleConcurrentUpdates, const PxU32 numVehicles, PxVehicleWheels** vehicles,
@@ -7093,6 +7218,19 @@ void physx::PxVehicleUpdates
 		NULL, context);
 }
 
+void physx::PxVehicleUpdatesGrouped
+(const PxReal timestep, const PxVec3& gravity, const PxVehicleDrivableSurfaceToTireFrictionPairs& vehicleDrivableSurfaceToTireFrictionPairs, 
+ const PxU32 numVehicles, PxVehicleWheels** vehicles, PxVehicleWheelQueryResult* vehicleWheelQueryResults, PxVehicleConcurrentUpdateData* vehicleConcurrentUpdates,
+ const PxVehicleContext& context)
+{
+	PX_PROFILE_ZONE("PxVehicleUpdates::ePROFILE_UPDATES",0);
+
+	PX_CHECK_AND_RETURN(context.isValid(), "PxVehicleUpdatesGrouped: provided PxVehicleContext is not valid");
+
+	PxVehicleUpdate::updateGrouped(timestep, gravity, vehicleDrivableSurfaceToTireFrictionPairs, numVehicles, vehicles, vehicleWheelQueryResults, vehicleConcurrentUpdates,
+		context);
+}
+
 void physx::PxVehiclePostUpdates
 (const PxVehicleConcurrentUpdateData* vehicleConcurrentUpdates, const PxU32 numVehicles, PxVehicleWheels** vehicles,
  const PxVehicleContext& context)
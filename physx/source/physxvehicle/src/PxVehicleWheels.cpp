@@ -720,7 +720,8 @@ static PxConstraintShaderTable t =
 			PxVehicleConstraintShader::vehicleSuspLimitConstraintSolverPrep,
 			0,
 			PxVehicleConstraintShader::visualiseConstraint,
-			PxConstraintFlag::Enum(0)
+			PxConstraintFlag::Enum(0),
+			NULL
 		};
 
 void PxVehicleWheels::setup
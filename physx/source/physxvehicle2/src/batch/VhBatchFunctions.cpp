@@ -0,0 +1,368 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2023 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "foundation/PxFoundation.h"
+#include "foundation/PxMath.h"
+#include "foundation/PxVecMath.h"
+
+#include "vehicle2/batch/PxVehicleBatchFunctions.h"
+#include "vehicle2/batch/PxVehicleBatchStates.h"
+
+#include "VhBatchTasks.h"
+
+namespace physx
+{
+namespace vehicle2
+{
+
+using namespace aos;
+
+//Replace zero denominators with one. 
+//The lanes this affects are always discarded by the callers so this only serves to keep the arithmetic finite.
+PX_FORCE_INLINE Vec4V safeDenominator(const Vec4V d)
+{
+	return V4Sel(V4IsEq(d, V4Zero()), V4One(), d);
+}
+
+//Booleans are stored as 0.0f or 1.0f.
+PX_FORCE_INLINE BoolV loadFlag(const PxReal* flags)
+{
+	return V4IsGrtr(V4LoadA(flags), V4Zero());
+}
+
+PX_FORCE_INLINE Vec4V flagToFloat(const BoolV b)
+{
+	return V4Sel(b, V4One(), V4Zero());
+}
+
+PX_FORCE_INLINE Vec4V dot3
+(const Vec4V ax, const Vec4V ay, const Vec4V az,
+ const Vec4V bx, const Vec4V by, const Vec4V bz)
+{
+	return V4MulAdd(ax, bx, V4MulAdd(ay, by, V4Mul(az, bz)));
+}
+
+//atan(x) for x in [0,1] approximated with the polynomial of Abramowitz and Stegun 4.4.49 (maximum error about 1e-5).
+//Larger arguments use atan(x) = pi/2 - atan(1/x) and the sign is restored at the end.
+PX_FORCE_INLINE Vec4V atan4(const Vec4V x)
+{
+	const Vec4V one = V4One();
+	const Vec4V ax = V4Abs(x);
+	const BoolV isLarge = V4IsGrtr(ax, one);
+	const Vec4V t = V4Sel(isLarge, V4Div(one, V4Max(ax, one)), ax);
+	const Vec4V t2 = V4Mul(t, t);
+	Vec4V p = V4Load(0.0208351f);
+	p = V4MulAdd(p, t2, V4Load(-0.0851330f));
+	p = V4MulAdd(p, t2, V4Load(0.1801410f));
+	p = V4MulAdd(p, t2, V4Load(-0.3302995f));
+	p = V4MulAdd(p, t2, V4Load(0.9998660f));
+	p = V4Mul(p, t);
+	const Vec4V r = V4Sel(isLarge, V4Sub(V4Load(PxPiDivTwo), p), p);
+	return V4Sel(V4IsGrtr(V4Zero(), x), V4Neg(r), r);
+}
+
+PX_FORCE_INLINE Vec4V tan4(const Vec4V x)
+{
+	return V4Div(V4Sin(x), safeDenominator(V4Cos(x)));
+}
+
+//See smoothingFunction1 and smoothingFunction2 in VhTireFunctions.cpp.
+#define ONE_TWENTYSEVENTH 0.037037f
+#define ONE_THIRD 0.33333f
+PX_FORCE_INLINE Vec4V smoothingFunction1(const Vec4V K)
+{
+	const Vec4V K2 = V4Mul(K, K);
+	const Vec4V K3 = V4Mul(K2, K);
+	const Vec4V f = V4MulAdd(V4Load(ONE_TWENTYSEVENTH), K3, V4NegMulSub(V4Load(ONE_THIRD), K2, K));
+	return V4Min(V4One(), f);
+}
+PX_FORCE_INLINE Vec4V smoothingFunction2(const Vec4V K)
+{
+	const Vec4V K2 = V4Mul(K, K);
+	const Vec4V K3 = V4Mul(K2, K);
+	const Vec4V K4 = V4Mul(K3, K);
+	return V4NegMulSub(V4Load(ONE_TWENTYSEVENTH), K4, V4MulAdd(V4Load(ONE_THIRD), K3, V4Sub(K, K2)));
+}
+
+PX_FORCE_INLINE void suspensionForceUpdate4(const PxU32 i, PxVehicleWheelBatchState& b)
+{
+	const Vec4V zero = V4Zero();
+
+	//Spring and damper force along the suspension direction, projected on the road normal.
+	const Vec4V dx = V4LoadA(b.suspDirX + i);
+	const Vec4V dy = V4LoadA(b.suspDirY + i);
+	const Vec4V dz = V4LoadA(b.suspDirZ + i);
+	const Vec4V nx = V4LoadA(b.normalX + i);
+	const Vec4V ny = V4LoadA(b.normalY + i);
+	const Vec4V nz = V4LoadA(b.normalZ + i);
+	const Vec4V springForce = V4Neg(V4MulAdd(V4LoadA(b.jounce + i), V4LoadA(b.suspStiffness + i), 
+		V4Mul(V4LoadA(b.jounceSpeed + i), V4LoadA(b.suspDamping + i))));
+	const Vec4V nDotSuspDir = dot3(nx, ny, nz, dx, dy, dz);
+	Vec4V suspForceMagnitude = V4Mul(nDotSuspDir, springForce);
+
+	//Collision force working against the part of the external force that is perpendicular to the suspension
+	//direction and pushes the suspension into the ground (see PxVehicleSuspensionForceUpdate).
+	//-n.(Fe - d*(d.Fe)) = (n.d)*(d.Fe) - n.Fe
+	const Vec4V sprungMassRatio = V4LoadA(b.sprungMassRatio + i);
+	const Vec4V ex = V4Mul(V4LoadA(b.externalForceX + i), sprungMassRatio);
+	const Vec4V ey = V4Mul(V4LoadA(b.externalForceY + i), sprungMassRatio);
+	const Vec4V ez = V4Mul(V4LoadA(b.externalForceZ + i), sprungMassRatio);
+	const Vec4V nDotExternalForce = dot3(nx, ny, nz, ex, ey, ez);
+	const Vec4V suspDirDotExternalForce = dot3(dx, dy, dz, ex, ey, ez);
+	const Vec4V collisionForce = V4Sub(V4Mul(nDotSuspDir, suspDirDotExternalForce), nDotExternalForce);
+	suspForceMagnitude = V4Sel(V4IsGrtr(zero, nDotExternalForce), V4Add(suspForceMagnitude, collisionForce), suspForceMagnitude);
+
+	V4StoreA(V4Sel(loadFlag(b.isOnGround + i), suspForceMagnitude, zero), b.normalForce + i);
+}
+
+PX_FORCE_INLINE void tireUpdate4(const Vec4V dt, const PxU32 i, PxVehicleWheelBatchState& b)
+{
+	const Vec4V zero = V4Zero();
+	const Vec4V one = V4One();
+
+	const BoolV isOnGround = loadFlag(b.isOnGround + i);
+	const Vec4V lngSpeed = V4LoadA(b.lngSpeed + i);
+	const Vec4V latSpeed = V4LoadA(b.latSpeed + i);
+	const Vec4V lngSpeedAbs = V4Abs(lngSpeed);
+	const Vec4V latSpeedAbs = V4Abs(latSpeed);
+	const Vec4V wheelOmega = V4LoadA(b.rotationSpeed + i);
+	const Vec4V wheelRadius = V4LoadA(b.radius + i);
+	const Vec4V wheelSpeed = V4Mul(wheelOmega, wheelRadius);
+
+	//Tire slips (PxVehicleTireSlipsUpdate).
+	Vec4V latSlip = atan4(V4Div(latSpeed, safeDenominator(V4Add(lngSpeedAbs, V4LoadA(b.minLatSlipDenominator + i)))));
+	Vec4V lngSlip;
+	{
+		const BoolV isTorqueApplied = BOr(loadFlag(b.isBrakeApplied + i), loadFlag(b.isDriveApplied + i));
+		const Vec4V minDenominator = V4Sel(isTorqueApplied, V4LoadA(b.minActiveLongSlipDenominator + i), V4LoadA(b.minPassiveLongSlipDenominator + i));
+		lngSlip = V4Div(V4Sub(wheelSpeed, lngSpeed), safeDenominator(V4Add(lngSpeedAbs, minDenominator)));
+		const BoolV isAtRest = BAnd(V4IsEq(lngSpeed, zero), V4IsEq(wheelOmega, zero));
+		lngSlip = V4Sel(isAtRest, zero, lngSlip);
+	}
+
+	//Tire load and friction (PxVehicleTireGripUpdate).
+	const Vec4V restLoad = V4LoadA(b.restLoad + i);
+	Vec4V load;
+	{
+		const Vec4V xmin = V4LoadA(b.loadFilterMinX + i);
+		const Vec4V ymin = V4LoadA(b.loadFilterMinY + i);
+		const Vec4V xmax = V4LoadA(b.loadFilterMaxX + i);
+		const Vec4V ymax = V4LoadA(b.loadFilterMaxY + i);
+		const Vec4V x = V4Div(V4LoadA(b.normalForce + i), safeDenominator(restLoad));
+		const Vec4V y = V4MulAdd(V4Sub(x, xmin), V4Div(V4Sub(ymax, ymin), safeDenominator(V4Sub(xmax, xmin))), ymin);
+		const Vec4V filtered = V4Sel(V4IsGrtr(x, xmin), V4Sel(V4IsGrtrOrEq(x, xmax), ymax, y), ymin);
+		load = V4Sel(isOnGround, V4Mul(restLoad, filtered), zero);
+	}
+	Vec4V friction;
+	{
+		const Vec4V x0 = V4LoadA(b.frictionVsSlipX0 + i);
+		const Vec4V y0 = V4LoadA(b.frictionVsSlipY0 + i);
+		const Vec4V x1 = V4LoadA(b.frictionVsSlipX1 + i);
+		const Vec4V y1 = V4LoadA(b.frictionVsSlipY1 + i);
+		const Vec4V x2 = V4LoadA(b.frictionVsSlipX2 + i);
+		const Vec4V y2 = V4LoadA(b.frictionVsSlipY2 + i);
+		const Vec4V longSlipAbs = V4Abs(lngSlip);
+		const Vec4V mu01 = V4MulAdd(V4Sub(longSlipAbs, x0), V4Div(V4Sub(y1, y0), safeDenominator(V4Sub(x1, x0))), y0);
+		const Vec4V mu12 = V4MulAdd(V4Sub(longSlipAbs, x1), V4Div(V4Sub(y2, y1), safeDenominator(V4Sub(x2, x1))), y1);
+		const Vec4V mu = V4Sel(V4IsGrtr(x1, longSlipAbs), mu01, V4Sel(V4IsGrtr(x2, longSlipAbs), mu12, y2));
+		friction = V4Sel(isOnGround, V4Mul(V4LoadA(b.roadFriction + i), mu), zero);
+	}
+	const Vec4V frictionTimesLoad = V4Mul(friction, load);
+	const BoolV canGenerateForce = BNot(V4IsEq(frictionTimesLoad, zero));
+
+	//Sticky states (PxVehicleTireStickyStateUpdate).
+	BoolV isLngStickyActive;
+	BoolV isLatStickyActive;
+	{
+		const BoolV isIntentionToAccelerate = loadFlag(b.isIntentionToAccelerate + i);
+		const BoolV isIntentionToBrake = loadFlag(b.isIntentionToBrake + i);
+
+		const Vec4V lngThresholdSpeed = V4LoadA(b.lngStickyThresholdSpeed + i);
+		const BoolV isLngSpeedLow = V4IsGrtr(lngThresholdSpeed, lngSpeedAbs);
+		const BoolV isLngLow = BAnd(BAnd(isLngSpeedLow, V4IsGrtr(lngThresholdSpeed, V4Abs(wheelSpeed))), BNot(isIntentionToAccelerate));
+		Vec4V lngLowSpeedTime = V4Sel(isLngLow, V4Add(V4LoadA(b.lngLowSpeedTime + i), dt), zero);
+		lngLowSpeedTime = V4Sel(canGenerateForce, lngLowSpeedTime, zero);
+		const BoolV isWheelLocked = BAnd(BAnd(isLngSpeedLow, V4IsEq(wheelOmega, zero)), isIntentionToBrake);
+		isLngStickyActive = BAnd(canGenerateForce, BOr(isWheelLocked, V4IsGrtr(lngLowSpeedTime, V4LoadA(b.lngStickyThresholdTime + i))));
+
+		const BoolV isLatLow = BAnd(V4IsGrtr(V4LoadA(b.latStickyThresholdSpeed + i), latSpeedAbs), BNot(isIntentionToAccelerate));
+		Vec4V latLowSpeedTime = V4Sel(isLatLow, V4Add(V4LoadA(b.latLowSpeedTime + i), dt), zero);
+		latLowSpeedTime = V4Sel(canGenerateForce, latLowSpeedTime, zero);
+		isLatStickyActive = BAnd(V4IsGrtr(lngLowSpeedTime, zero), V4IsGrtr(latLowSpeedTime, V4LoadA(b.latStickyThresholdTime + i)));
+
+		V4StoreA(lngLowSpeedTime, b.lngLowSpeedTime + i);
+		V4StoreA(latLowSpeedTime, b.latLowSpeedTime + i);
+		V4StoreA(flagToFloat(isLngStickyActive), b.isLngStickyActive + i);
+		V4StoreA(flagToFloat(isLatStickyActive), b.isLatStickyActive + i);
+	}
+
+	//Slips accounting for sticky states (PxVehicleTireSlipsAccountingForStickyStatesUpdate).
+	lngSlip = V4Sel(isLngStickyActive, zero, lngSlip);
+	latSlip = V4Sel(isLatStickyActive, zero, latSlip);
+	V4StoreA(lngSlip, b.lngSlip + i);
+	V4StoreA(latSlip, b.latSlip + i);
+	V4StoreA(load, b.load + i);
+	V4StoreA(friction, b.friction + i);
+
+	//Tire forces (computeTireForceMichiganModel).
+	{
+		const Vec4V minimumSlipThreshold = V4Load(1e-5f);
+		const Vec4V lat = V4Sel(V4IsGrtrOrEq(V4Abs(latSlip), minimumSlipThreshold), latSlip, zero);
+		const Vec4V lng = V4Sel(V4IsGrtrOrEq(V4Abs(lngSlip), minimumSlipThreshold), lngSlip, zero);
+		const Vec4V camberRaw = V4LoadA(b.camber + i);
+		const Vec4V camber = V4Sel(V4IsGrtrOrEq(V4Abs(camberRaw), minimumSlipThreshold), camberRaw, zero);
+
+		const Vec4V normalisedTireLoad = V4Div(load, safeDenominator(restLoad));
+		const Vec4V latStiffX = V4LoadA(b.latStiffX + i);
+		const Vec4V latStiffY = V4LoadA(b.latStiffY + i);
+		const Vec4V latStiff = V4Sel(V4IsEq(latStiffX, zero), latStiffY, 
+			V4Mul(latStiffY, smoothingFunction1(V4Div(V4Mul(normalisedTireLoad, V4Load(3.0f)), safeDenominator(latStiffX)))));
+		const Vec4V longStiff = V4LoadA(b.longStiff + i);
+		const Vec4V camberStiff = V4LoadA(b.camberStiff + i);
+
+		const BoolV hasNoSlip = BAnd(BAnd(V4IsEq(V4Mul(lat, latStiff), zero), V4IsEq(V4Mul(lng, longStiff), zero)), V4IsEq(V4Mul(camber, camberStiff), zero));
+		const BoolV hasForce = BAnd(canGenerateForce, BNot(hasNoSlip));
+
+		const Vec4V TEff = tan4(V4Add(lat, V4Div(V4Mul(camber, camberStiff), safeDenominator(latStiff))));
+		const Vec4V latStiffTEff = V4Mul(latStiff, TEff);
+		const Vec4V longStiffSlip = V4Mul(longStiff, lng);
+		const Vec4V K = V4Div(V4Sqrt(V4MulAdd(latStiffTEff, latStiffTEff, V4Mul(longStiffSlip, longStiffSlip))), safeDenominator(frictionTimesLoad));
+		const Vec4V FBar = smoothingFunction1(K);
+		const Vec4V MBar = smoothingFunction2(K);
+		const Vec4V latOverLong = V4Div(latStiff, safeDenominator(longStiff));
+		const Vec4V nuLowK = V4Mul(V4Load(0.5f), V4NegMulSub(V4Sub(one, latOverLong), V4Cos(V4Mul(K, V4Load(0.5f))), V4Add(one, latOverLong)));
+		const Vec4V nu = V4Sel(V4IsGrtr(K, V4Load(2.0f*PxPi)), one, nuLowK);
+		const Vec4V nuTEff = V4Mul(nu, TEff);
+		const Vec4V FZero = V4Div(frictionTimesLoad, safeDenominator(V4Sqrt(V4MulAdd(lng, lng, V4Mul(nuTEff, nuTEff)))));
+		const Vec4V fz = V4Mul(V4Mul(lng, FBar), FZero);
+		const Vec4V fx = V4Neg(V4Mul(V4Mul(nuTEff, FBar), FZero));
+		const Vec4V fMy = V4Mul(V4Mul(nuTEff, MBar), FZero);
+
+		V4StoreA(V4Sel(hasForce, fz, zero), b.lngForce + i);
+		V4StoreA(V4Sel(hasForce, fx, zero), b.latForce + i);
+		V4StoreA(V4Sel(hasForce, fMy, zero), b.aligningMoment + i);
+		V4StoreA(V4Sel(hasForce, V4Neg(V4Mul(fz, wheelRadius)), zero), b.wheelTorque + i);
+	}
+}
+
+PX_FORCE_INLINE void directDriveUpdate4(const Vec4V dt, const PxU32 i, PxVehicleWheelBatchState& b)
+{
+	const Vec4V zero = V4Zero();
+	const Vec4V one = V4One();
+
+	//See PxVehicleDirectDriveUpdate for the implicit integration.
+	const Vec4V wheelRotSpeed = V4LoadA(b.rotationSpeed + i);
+	const Vec4V dtOverMOI = V4Div(dt, safeDenominator(V4LoadA(b.moi + i)));
+	const Vec4V sign = V4Sel(V4IsGrtr(wheelRotSpeed, zero), one, V4Sel(V4IsGrtr(zero, wheelRotSpeed), V4Neg(one), zero));
+	const Vec4V brakeTorque = V4Neg(V4Mul(V4LoadA(b.brakeTorque + i), sign));
+	const Vec4V torque = V4Add(V4Add(V4LoadA(b.wheelTorque + i), V4LoadA(b.driveTorque + i)), brakeTorque);
+	const Vec4V newRotSpeedNoBrakelock = V4Div(V4MulAdd(dtOverMOI, torque, wheelRotSpeed), V4MulAdd(V4LoadA(b.dampingRate + i), dtOverMOI, one));
+
+	//If the brake is applied and the sign flipped then lock the brake.
+	const BoolV isBrakeLocked = BAnd(loadFlag(b.isBrakeApplied + i), BNot(V4IsGrtr(V4Mul(wheelRotSpeed, newRotSpeedNoBrakelock), zero)));
+	V4StoreA(V4Sel(isBrakeLocked, zero, newRotSpeedNoBrakelock), b.rotationSpeed + i);
+}
+
+void PxVehicleWheelBatchSuspensionForceUpdate
+(const PxU32 startWheel, const PxU32 endWheel, PxVehicleWheelBatchState& batchState)
+{
+	PX_ASSERT(0 == (startWheel & 3));
+	PX_ASSERT(endWheel <= batchState.maxNbWheels);
+	for (PxU32 i = startWheel; i < endWheel; i += 4)
+		suspensionForceUpdate4(i, batchState);
+}
+
+void PxVehicleWheelBatchTireUpdate
+(const PxReal dt, const PxU32 startWheel, const PxU32 endWheel, PxVehicleWheelBatchState& batchState)
+{
+	PX_ASSERT(0 == (startWheel & 3));
+	PX_ASSERT(endWheel <= batchState.maxNbWheels);
+	const Vec4V dtV = V4Load(dt);
+	for (PxU32 i = startWheel; i < endWheel; i += 4)
+		tireUpdate4(dtV, i, batchState);
+}
+
+void PxVehicleWheelBatchDirectDriveUpdate
+(const PxReal dt, const PxU32 startWheel, const PxU32 endWheel, PxVehicleWheelBatchState& batchState)
+{
+	PX_ASSERT(0 == (startWheel & 3));
+	PX_ASSERT(endWheel <= batchState.maxNbWheels);
+	const Vec4V dtV = V4Load(dt);
+	for (PxU32 i = startWheel; i < endWheel; i += 4)
+		directDriveUpdate4(dtV, i, batchState);
+}
+
+namespace
+{
+	struct WheelBatchRangeProcessor
+	{
+		PxVehicleWheelBatchState* batchState;
+		Vec4V dt;
+		PxU32 stages;
+		PxU32 nbWheels;
+		PxU32 nbWheelsPerRange;
+
+		void process(const PxU32 range)
+		{
+			//Run all stages of a range of wheels back to back while its data is in cache.
+			PxVehicleWheelBatchState& b = *batchState;
+			const PxU32 startWheel = range*nbWheelsPerRange;
+			const PxU32 endWheel = PxMin(startWheel + nbWheelsPerRange, nbWheels);
+			for (PxU32 i = startWheel; i < endWheel; i += 4)
+			{
+				if (stages & PxVehicleWheelBatchStages::eSUSPENSION_FORCE)
+					suspensionForceUpdate4(i, b);
+				if (stages & PxVehicleWheelBatchStages::eTIRE)
+					tireUpdate4(dt, i, b);
+				if (stages & PxVehicleWheelBatchStages::eDIRECT_DRIVE)
+					directDriveUpdate4(dt, i, b);
+			}
+		}
+	};
+}
+
+void PxVehicleWheelBatchUpdate
+(const PxReal dt, const PxU32 stages, PxVehicleWheelBatchState& batchState,
+ PxCpuDispatcher* dispatcher, const PxU32 nbWheelsPerTask)
+{
+	PX_CHECK_AND_RETURN(batchState.nbWheels <= batchState.maxNbWheels, "PxVehicleWheelBatchUpdate: nbWheels must be less than or equal to maxNbWheels");
+
+	//The arrays are padded so the wheel count can always be rounded up to whole blocks of 4.
+	WheelBatchRangeProcessor processor;
+	processor.batchState = &batchState;
+	processor.dt = V4Load(dt);
+	processor.stages = stages;
+	processor.nbWheels = (batchState.nbWheels + 3) & ~3u;
+	processor.nbWheelsPerRange = PxMax(4u, (nbWheelsPerTask + 3) & ~3u);
+	const PxU32 nbRanges = (processor.nbWheels + processor.nbWheelsPerRange - 1) / processor.nbWheelsPerRange;
+
+	runBatchRanges(nbRanges, processor, dispatcher);
+}
+
+} //namespace vehicle2
+} //namespace physx
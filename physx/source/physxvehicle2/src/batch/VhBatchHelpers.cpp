@@ -0,0 +1,311 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2023 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "foundation/PxAllocatorCallback.h"
+#include "foundation/PxMemory.h"
+
+#include "vehicle2/PxVehicleParams.h"
+
+#include "vehicle2/batch/PxVehicleBatchHelpers.h"
+#include "vehicle2/batch/PxVehicleBatchStates.h"
+
+#include "vehicle2/rigidBody/PxVehicleRigidBodyStates.h"
+
+#include "vehicle2/roadGeometry/PxVehicleRoadGeometryState.h"
+
+#include "vehicle2/suspension/PxVehicleSuspensionHelpers.h"
+#include "vehicle2/suspension/PxVehicleSuspensionParams.h"
+#include "vehicle2/suspension/PxVehicleSuspensionStates.h"
+
+#include "vehicle2/tire/PxVehicleTireParams.h"
+#include "vehicle2/tire/PxVehicleTireStates.h"
+
+#include "vehicle2/wheel/PxVehicleWheelHelpers.h"
+#include "vehicle2/wheel/PxVehicleWheelParams.h"
+#include "vehicle2/wheel/PxVehicleWheelStates.h"
+
+namespace physx
+{
+namespace vehicle2
+{
+
+//Every array of the batch, in the order they are laid out in memory.
+static PxReal* PxVehicleWheelBatchState::* const gBatchArrays[] =
+{
+	&PxVehicleWheelBatchState::radius,
+	&PxVehicleWheelBatchState::moi,
+	&PxVehicleWheelBatchState::dampingRate,
+	&PxVehicleWheelBatchState::suspStiffness,
+	&PxVehicleWheelBatchState::suspDamping,
+	&PxVehicleWheelBatchState::sprungMassRatio,
+	&PxVehicleWheelBatchState::restLoad,
+	&PxVehicleWheelBatchState::loadFilterMinX,
+	&PxVehicleWheelBatchState::loadFilterMinY,
+	&PxVehicleWheelBatchState::loadFilterMaxX,
+	&PxVehicleWheelBatchState::loadFilterMaxY,
+	&PxVehicleWheelBatchState::frictionVsSlipX0,
+	&PxVehicleWheelBatchState::frictionVsSlipY0,
+	&PxVehicleWheelBatchState::frictionVsSlipX1,
+	&PxVehicleWheelBatchState::frictionVsSlipY1,
+	&PxVehicleWheelBatchState::frictionVsSlipX2,
+	&PxVehicleWheelBatchState::frictionVsSlipY2,
+	&PxVehicleWheelBatchState::latStiffX,
+	&PxVehicleWheelBatchState::latStiffY,
+	&PxVehicleWheelBatchState::longStiff,
+	&PxVehicleWheelBatchState::camberStiff,
+	&PxVehicleWheelBatchState::minLatSlipDenominator,
+	&PxVehicleWheelBatchState::minPassiveLongSlipDenominator,
+	&PxVehicleWheelBatchState::minActiveLongSlipDenominator,
+	&PxVehicleWheelBatchState::lngStickyThresholdSpeed,
+	&PxVehicleWheelBatchState::lngStickyThresholdTime,
+	&PxVehicleWheelBatchState::latStickyThresholdSpeed,
+	&PxVehicleWheelBatchState::latStickyThresholdTime,
+
+	&PxVehicleWheelBatchState::isOnGround,
+	&PxVehicleWheelBatchState::jounce,
+	&PxVehicleWheelBatchState::jounceSpeed,
+	&PxVehicleWheelBatchState::suspDirX,
+	&PxVehicleWheelBatchState::suspDirY,
+	&PxVehicleWheelBatchState::suspDirZ,
+	&PxVehicleWheelBatchState::normalX,
+	&PxVehicleWheelBatchState::normalY,
+	&PxVehicleWheelBatchState::normalZ,
+	&PxVehicleWheelBatchState::externalForceX,
+	&PxVehicleWheelBatchState::externalForceY,
+	&PxVehicleWheelBatchState::externalForceZ,
+	&PxVehicleWheelBatchState::roadFriction,
+	&PxVehicleWheelBatchState::lngSpeed,
+	&PxVehicleWheelBatchState::latSpeed,
+	&PxVehicleWheelBatchState::camber,
+	&PxVehicleWheelBatchState::brakeTorque,
+	&PxVehicleWheelBatchState::driveTorque,
+	&PxVehicleWheelBatchState::isBrakeApplied,
+	&PxVehicleWheelBatchState::isDriveApplied,
+	&PxVehicleWheelBatchState::isIntentionToAccelerate,
+	&PxVehicleWheelBatchState::isIntentionToBrake,
+
+	&PxVehicleWheelBatchState::rotationSpeed,
+	&PxVehicleWheelBatchState::lngLowSpeedTime,
+	&PxVehicleWheelBatchState::latLowSpeedTime,
+
+	&PxVehicleWheelBatchState::normalForce,
+	&PxVehicleWheelBatchState::lngSlip,
+	&PxVehicleWheelBatchState::latSlip,
+	&PxVehicleWheelBatchState::load,
+	&PxVehicleWheelBatchState::friction,
+	&PxVehicleWheelBatchState::isLngStickyActive,
+	&PxVehicleWheelBatchState::isLatStickyActive,
+	&PxVehicleWheelBatchState::lngForce,
+	&PxVehicleWheelBatchState::latForce,
+	&PxVehicleWheelBatchState::aligningMoment,
+	&PxVehicleWheelBatchState::wheelTorque
+};
+
+static const PxU32 gNbBatchArrays = sizeof(gBatchArrays) / sizeof(gBatchArrays[0]);
+
+PxVehicleWheelBatchState* PxVehicleWheelBatchStateCreate
+(const PxU32 maxNbWheels, PxAllocatorCallback& allocator)
+{
+	const PxU32 nbWheels = (maxNbWheels + 3) & ~3u;
+	const PxU32 headerSize = (sizeof(PxVehicleWheelBatchState) + 15) & ~15u;
+	const PxU32 arraySize = sizeof(PxReal)*nbWheels;
+	const PxU32 byteSize = headerSize + arraySize*gNbBatchArrays;
+
+	PxU8* buffer = reinterpret_cast<PxU8*>(allocator.allocate(byteSize, "PxVehicleWheelBatchState", __FILE__, __LINE__));
+	if (!buffer)
+		return NULL;
+	PX_ASSERT(0 == (size_t(buffer) & 15));
+	PxMemZero(buffer, byteSize);
+
+	PxVehicleWheelBatchState* batchState = reinterpret_cast<PxVehicleWheelBatchState*>(buffer);
+	batchState->nbWheels = 0;
+	batchState->maxNbWheels = nbWheels;
+
+	PxU8* arrays = buffer + headerSize;
+	for (PxU32 i = 0; i < gNbBatchArrays; i++)
+	{
+		batchState->*gBatchArrays[i] = reinterpret_cast<PxReal*>(arrays);
+		arrays += arraySize;
+	}
+
+	return batchState;
+}
+
+void PxVehicleWheelBatchStateRelease
+(PxVehicleWheelBatchState* batchState, PxAllocatorCallback& allocator)
+{
+	allocator.deallocate(batchState);
+}
+
+void PxVehicleWheelBatchParamsSet
+(const PxVehicleWheelParams& wheelParams, const PxVehicleSuspensionForceParams& suspForceParams, const PxReal vehicleMass,
+ const PxVehicleTireSlipParams& tireSlipParams, const PxVehicleTireStickyParams& tireStickyParams,
+ const PxVehicleTireForceParams& tireForceParams,
+ const PxU32 slot, PxVehicleWheelBatchState& b)
+{
+	PX_CHECK_AND_RETURN(slot < b.maxNbWheels, "PxVehicleWheelBatchParamsSet: slot must be less than maxNbWheels");
+	PX_CHECK_AND_RETURN(vehicleMass > 0.0f, "PxVehicleWheelBatchParamsSet: vehicleMass must be greater than zero");
+
+	b.radius[slot] = wheelParams.radius;
+	b.moi[slot] = wheelParams.moi;
+	b.dampingRate[slot] = wheelParams.dampingRate;
+
+	b.suspStiffness[slot] = suspForceParams.stiffness;
+	b.suspDamping[slot] = suspForceParams.damping;
+	b.sprungMassRatio[slot] = suspForceParams.sprungMass / vehicleMass;
+
+	b.restLoad[slot] = tireForceParams.restLoad;
+	b.loadFilterMinX[slot] = tireForceParams.loadFilter[0][0];
+	b.loadFilterMinY[slot] = tireForceParams.loadFilter[0][1];
+	b.loadFilterMaxX[slot] = tireForceParams.loadFilter[1][0];
+	b.loadFilterMaxY[slot] = tireForceParams.loadFilter[1][1];
+	b.frictionVsSlipX0[slot] = tireForceParams.frictionVsSlip[0][0];
+	b.frictionVsSlipY0[slot] = tireForceParams.frictionVsSlip[0][1];
+	b.frictionVsSlipX1[slot] = tireForceParams.frictionVsSlip[1][0];
+	b.frictionVsSlipY1[slot] = tireForceParams.frictionVsSlip[1][1];
+	b.frictionVsSlipX2[slot] = tireForceParams.frictionVsSlip[2][0];
+	b.frictionVsSlipY2[slot] = tireForceParams.frictionVsSlip[2][1];
+	b.latStiffX[slot] = tireForceParams.latStiffX;
+	b.latStiffY[slot] = tireForceParams.latStiffY;
+	b.longStiff[slot] = tireForceParams.longStiff;
+	b.camberStiff[slot] = tireForceParams.camberStiff;
+
+	b.minLatSlipDenominator[slot] = tireSlipParams.minLatSlipDenominator;
+	b.minPassiveLongSlipDenominator[slot] = tireSlipParams.minPassiveLongSlipDenominator;
+	b.minActiveLongSlipDenominator[slot] = tireSlipParams.minActiveLongSlipDenominator;
+
+	b.lngStickyThresholdSpeed[slot] = tireStickyParams.stickyParams[PxVehicleTireDirectionModes::eLONGITUDINAL].thresholdSpeed;
+	b.lngStickyThresholdTime[slot] = tireStickyParams.stickyParams[PxVehicleTireDirectionModes::eLONGITUDINAL].thresholdTime;
+	b.latStickyThresholdSpeed[slot] = tireStickyParams.stickyParams[PxVehicleTireDirectionModes::eLATERAL].thresholdSpeed;
+	b.latStickyThresholdTime[slot] = tireStickyParams.stickyParams[PxVehicleTireDirectionModes::eLATERAL].thresholdTime;
+}
+
+void PxVehicleWheelBatchInputsSet
+(const PxVehicleSuspensionParams& suspParams,
+ const PxVehicleRoadGeometryState& roadGeomState, const PxVehicleSuspensionState& suspState,
+ const PxVehicleRigidBodyState& rigidBodyState, const PxVec3& gravity, const PxReal vehicleMass,
+ const PxVehicleTireSpeedState& tireSpeedState, const PxVehicleTireCamberAngleState& camberAngleState,
+ const PxVehicleWheelActuationState& actuationState, const PxReal brakeTorque, const PxReal driveTorque,
+ const bool isIntentionToAccelerate, const bool isIntentionToBrake,
+ const PxVehicleWheelRigidBody1dState& wheelRigidBody1dState, const PxVehicleTireStickyState& tireStickyState,
+ const PxU32 slot, PxVehicleWheelBatchState& b)
+{
+	PX_CHECK_AND_RETURN(slot < b.maxNbWheels, "PxVehicleWheelBatchInputsSet: slot must be less than maxNbWheels");
+
+	b.isOnGround[slot] = (roadGeomState.hitState && PxVehicleIsWheelOnGround(suspState)) ? 1.0f : 0.0f;
+	b.jounce[slot] = suspState.jounce;
+	b.jounceSpeed[slot] = suspState.jounceSpeed;
+
+	//Resolve the geometric quantities of the suspension force model here so that the batched
+	//update only needs to deal with vectors that are already in the world frame.
+	const PxVec3 suspDir = PxVehicleComputeSuspensionDirection(suspParams, rigidBodyState.pose);
+	b.suspDirX[slot] = suspDir.x;
+	b.suspDirY[slot] = suspDir.y;
+	b.suspDirZ[slot] = suspDir.z;
+	b.normalX[slot] = roadGeomState.plane.n.x;
+	b.normalY[slot] = roadGeomState.plane.n.y;
+	b.normalZ[slot] = roadGeomState.plane.n.z;
+
+	//See PxVehicleSuspensionForceUpdate for the derivation of the angular part.
+	const PxVec3 comToSusp = rigidBodyState.pose.rotate(suspParams.suspensionAttachment.p);
+	const PxReal comToSuspDistSqr = comToSusp.magnitudeSquared();
+	PxVec3 externalForce = (gravity * vehicleMass) + rigidBodyState.externalForce;
+	if (comToSuspDistSqr > 0.0f)
+		externalForce += (rigidBodyState.externalTorque.cross(comToSusp)) / comToSuspDistSqr;
+	b.externalForceX[slot] = externalForce.x;
+	b.externalForceY[slot] = externalForce.y;
+	b.externalForceZ[slot] = externalForce.z;
+
+	b.roadFriction[slot] = roadGeomState.friction;
+	b.lngSpeed[slot] = tireSpeedState.speedStates[PxVehicleTireDirectionModes::eLONGITUDINAL];
+	b.latSpeed[slot] = tireSpeedState.speedStates[PxVehicleTireDirectionModes::eLATERAL];
+	b.camber[slot] = camberAngleState.camberAngle;
+
+	b.brakeTorque[slot] = brakeTorque;
+	b.driveTorque[slot] = driveTorque;
+	b.isBrakeApplied[slot] = actuationState.isBrakeApplied ? 1.0f : 0.0f;
+	b.isDriveApplied[slot] = actuationState.isDriveApplied ? 1.0f : 0.0f;
+	b.isIntentionToAccelerate[slot] = isIntentionToAccelerate ? 1.0f : 0.0f;
+	b.isIntentionToBrake[slot] = isIntentionToBrake ? 1.0f : 0.0f;
+
+	b.rotationSpeed[slot] = wheelRigidBody1dState.rotationSpeed;
+	b.lngLowSpeedTime[slot] = tireStickyState.lowSpeedTime[PxVehicleTireDirectionModes::eLONGITUDINAL];
+	b.latLowSpeedTime[slot] = tireStickyState.lowSpeedTime[PxVehicleTireDirectionModes::eLATERAL];
+}
+
+void PxVehicleWheelBatchOutputsGet
+(const PxVehicleWheelBatchState& b, const PxU32 slot,
+ const PxVehicleSuspensionParams& suspParams,
+ const PxVehicleRoadGeometryState& roadGeomState, const PxVehicleSuspensionComplianceState& complianceState,
+ const PxVehicleRigidBodyState& rigidBodyState, const PxVehicleTireDirectionState& tireDirectionState,
+ PxVehicleSuspensionForce& suspForce, PxVehicleTireSlipState& tireSlipState, PxVehicleTireGripState& tireGripState,
+ PxVehicleTireStickyState& tireStickyState, PxVehicleTireForce& tireForce, PxVehicleWheelRigidBody1dState& wheelRigidBody1dState)
+{
+	PX_CHECK_AND_RETURN(slot < b.maxNbWheels, "PxVehicleWheelBatchOutputsGet: slot must be less than maxNbWheels");
+
+	//Suspension force.
+	suspForce.setToDefault();
+	if (b.isOnGround[slot] != 0.0f)
+	{
+		const PxVec3 r = rigidBodyState.pose.rotate(suspParams.suspensionAttachment.transform(complianceState.suspForceAppPoint));
+		const PxVec3 f = roadGeomState.plane.n*b.normalForce[slot];
+		suspForce.force = f;
+		suspForce.torque = r.cross(f);
+		suspForce.normalForce = b.normalForce[slot];
+	}
+
+	//Tire slip, grip and sticky state.
+	tireSlipState.slips[PxVehicleTireDirectionModes::eLONGITUDINAL] = b.lngSlip[slot];
+	tireSlipState.slips[PxVehicleTireDirectionModes::eLATERAL] = b.latSlip[slot];
+	tireGripState.load = b.load[slot];
+	tireGripState.friction = b.friction[slot];
+	tireStickyState.lowSpeedTime[PxVehicleTireDirectionModes::eLONGITUDINAL] = b.lngLowSpeedTime[slot];
+	tireStickyState.lowSpeedTime[PxVehicleTireDirectionModes::eLATERAL] = b.latLowSpeedTime[slot];
+	tireStickyState.activeStatus[PxVehicleTireDirectionModes::eLONGITUDINAL] = (b.isLngStickyActive[slot] != 0.0f);
+	tireStickyState.activeStatus[PxVehicleTireDirectionModes::eLATERAL] = (b.isLatStickyActive[slot] != 0.0f);
+
+	//Tire force.
+	tireForce.setToDefault();
+	if (0 != b.friction[slot]*b.load[slot])
+	{
+		const PxVec3 tireLongForce = tireDirectionState.directions[PxVehicleTireDirectionModes::eLONGITUDINAL]*b.lngForce[slot];
+		const PxVec3 tireLatForce = tireDirectionState.directions[PxVehicleTireDirectionModes::eLATERAL]*b.latForce[slot];
+		const PxVec3 r = rigidBodyState.pose.rotate(suspParams.suspensionAttachment.transform(complianceState.tireForceAppPoint));
+		tireForce.forces[PxVehicleTireDirectionModes::eLONGITUDINAL] = tireLongForce;
+		tireForce.torques[PxVehicleTireDirectionModes::eLONGITUDINAL] = r.cross(tireLongForce);
+		tireForce.forces[PxVehicleTireDirectionModes::eLATERAL] = tireLatForce;
+		tireForce.torques[PxVehicleTireDirectionModes::eLATERAL] = r.cross(tireLatForce);
+		tireForce.aligningMoment = b.aligningMoment[slot];
+		tireForce.wheelTorque = b.wheelTorque[slot];
+	}
+
+	wheelRigidBody1dState.rotationSpeed = b.rotationSpeed[slot];
+}
+
+} //namespace vehicle2
+} //namespace physx
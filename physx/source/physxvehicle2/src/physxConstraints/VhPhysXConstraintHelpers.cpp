@@ -50,7 +50,8 @@ PxConstraintShaderTable gVehicleConstraintTable =
 	vehicleConstraintSolverPrep,
 	0,
 	visualiseVehicleConstraint,
-	PxConstraintFlag::Enum(0)
+	PxConstraintFlag::Enum(0),
+	NULL
 };
 
 void PxVehicleConstraintsCreate(
@@ -37,16 +37,22 @@
 
 #include "vehicle2/suspension/PxVehicleSuspensionHelpers.h"
 
+#include "foundation/PxAtomic.h"
+
 #include "extensions/PxRigidBodyExt.h"
 
 #include "PxScene.h"
+#include "PxSceneLock.h"
 #include "PxShape.h"
 #include "PxRigidActor.h"
+#include "PxRigidStatic.h"
 #include "PxMaterial.h"
 #include "geometry/PxMeshScale.h"
 #include "geometry/PxConvexMeshGeometry.h"
 #include "geometry/PxGeometryQuery.h"
 
+#include "../batch/VhBatchTasks.h"
+
 namespace physx
 {
 namespace vehicle2
@@ -85,15 +91,77 @@ PX_FORCE_INLINE void copyHitInfo(const THitBuffer& hitBuffer, PxMaterial* hitMat
 	physxRoadGeometryState.hitPosition = hitBuffer.position;
 }
 
-void PxVehiclePhysXRoadGeometryQueryUpdate
+struct QueryCache
+{
+	const PxVehiclePhysXRoadGeometryQueryCacheParams* params;
+	PxReal cosDirectionTolerance;
+	PxVehiclePhysXRoadGeometryQueryCacheState* state;
+};
+
+PX_FORCE_INLINE bool reuseCachedQuery
+(const QueryCache& cache, const PxVec3& origin, const PxVec3& dir, const PxF32 dist, const bool isRaycast,
+ PxVehicleRoadGeometryState& roadGeomState, PxVehiclePhysXRoadGeometryQueryState* physxRoadGeometryState)
+{
+	PxVehiclePhysXRoadGeometryQueryCacheState& cacheState = *cache.state;
+	if (!cacheState.isValid || cacheState.nbReuses >= cache.params->maxNbReuses)
+		return false;
+
+	//The query must not have moved or turned too far from the cached query.
+	const PxF32 positionTolerance = cache.params->positionTolerance;
+	if ((origin - cacheState.queryOrigin).magnitudeSquared() > positionTolerance*positionTolerance)
+		return false;
+	if (dir.dot(cacheState.queryDir) < cache.cosDirectionTolerance)
+		return false;
+
+	//A raycast must still reach the cached plane within the length of the query.
+	if (isRaycast)
+	{
+		const PxPlane& plane = cacheState.roadGeomState.plane;
+		const PxF32 nDotDir = plane.n.dot(dir);
+		if (nDotDir >= 0.0f)
+			return false;
+		const PxF32 hitDist = -plane.distance(origin) / nDotDir;
+		if (hitDist <= 0.0f || hitDist > dist)
+			return false;
+	}
+
+	cacheState.nbReuses++;
+	roadGeomState = cacheState.roadGeomState;
+	if (physxRoadGeometryState)
+		*physxRoadGeometryState = cacheState.physxRoadGeometryState;
+	return true;
+}
+
+PX_FORCE_INLINE void updateCachedQuery
+(const PxVec3& origin, const PxVec3& dir, 
+ const PxVehicleRoadGeometryState& roadGeomState, const PxVehiclePhysXRoadGeometryQueryState& physxRoadGeometryState,
+ PxVehiclePhysXRoadGeometryQueryCacheState& cacheState)
+{
+	//Only static actors are guaranteed to be where they were at the time of the query.
+	cacheState.roadGeomState = roadGeomState;
+	cacheState.physxRoadGeometryState = physxRoadGeometryState;
+	cacheState.queryOrigin = origin;
+	cacheState.queryDir = dir;
+	cacheState.nbReuses = 0;
+	cacheState.isValid = roadGeomState.hitState && physxRoadGeometryState.actor && physxRoadGeometryState.actor->is<PxRigidStatic>();
+}
+
+void roadGeometryQueryUpdate
 (const PxVehicleWheelParams& wheelParams, const PxVehicleSuspensionParams& suspParams,
  const PxVehiclePhysXRoadGeometryQueryParams& roadGeomParams, const PxVehiclePhysXMaterialFrictionParams& materialFrictionParams,
  const PxF32 steerAngle, const PxVehicleRigidBodyState& rigidBodyState, 
  const PxScene& scene, const PxConvexMesh* unitCylinderSweepMesh, 
- const PxVehicleFrame& frame,
+ const PxVehicleFrame& frame, const QueryCache* cache,
  PxVehicleRoadGeometryState& roadGeomState,
- PxVehiclePhysXRoadGeometryQueryState* physxRoadGeometryState)
+ PxVehiclePhysXRoadGeometryQueryState* physxRoadGeometryState,
+ PxU32& nbSceneQueries)
 {
+	//The cache needs the hit actor even if the caller does not.
+	PxVehiclePhysXRoadGeometryQueryState localPhysXRoadGeometryState;
+	PxVehiclePhysXRoadGeometryQueryState* outputPhysXRoadGeometryState = physxRoadGeometryState;
+	if (cache && !physxRoadGeometryState)
+		physxRoadGeometryState = &localPhysXRoadGeometryState;
+
 	if(PxVehiclePhysXRoadGeometryQueryType::eRAYCAST == roadGeomParams.roadGeometryQueryType)
 	{
 		//Assume no hits until we know otherwise.
@@ -104,9 +172,13 @@ void PxVehiclePhysXRoadGeometryQueryUpdate
 		PxF32 dist;
 		PxVehicleComputeSuspensionRaycast(frame, wheelParams, suspParams, steerAngle, rigidBodyState.pose, v, w, dist);
 
+		if (cache && reuseCachedQuery(*cache, v, w, dist, true, roadGeomState, outputPhysXRoadGeometryState))
+			return;
+
 		//Perform the raycast.
 		PxRaycastBuffer buff;
 		scene.raycast(v, w, dist, buff, PxHitFlag::eDEFAULT, roadGeomParams.filterData, roadGeomParams.filterCallback);
+		nbSceneQueries++;
 
 		//Process the raycast result.
 		if(buff.hasBlock && buff.block.distance != 0.0f)
@@ -129,6 +201,9 @@ void PxVehiclePhysXRoadGeometryQueryUpdate
 			if (physxRoadGeometryState)
 				physxRoadGeometryState->setToDefault();
 		}
+
+		if (cache)
+			updateCachedQuery(v, w, roadGeomState, *physxRoadGeometryState, *cache->state);
 	}
 	else if(PxVehiclePhysXRoadGeometryQueryType::eSWEEP == roadGeomParams.roadGeometryQueryType)
 	{
@@ -143,6 +218,9 @@ void PxVehiclePhysXRoadGeometryQueryUpdate
 		PxF32 dist;
 		PxVehicleComputeSuspensionSweep(frame, suspParams, steerAngle, rigidBodyState.pose, T, w, dist);
 
+		if (cache && reuseCachedQuery(*cache, T.p, w, dist, false, roadGeomState, outputPhysXRoadGeometryState))
+			return;
+
 		//Scale the unit cylinder.
 		const PxVec3 scale = PxVehicleComputeTranslation(frame, wheelParams.radius, wheelParams.halfWidth, wheelParams.radius).abs();
 		const PxMeshScale meshScale(scale, PxQuat(PxIdentity));
@@ -151,6 +229,7 @@ void PxVehiclePhysXRoadGeometryQueryUpdate
 		//Perform the sweep.
 		PxSweepBuffer buff;
 		scene.sweep(convMeshGeom, T,  w,  dist, buff, PxHitFlag::eDEFAULT | PxHitFlag::eMTD, roadGeomParams.filterData, roadGeomParams.filterCallback);
+		nbSceneQueries++;
 
 		//Process the sweep result.
 		if (buff.hasBlock && buff.block.distance > 0.0f)
@@ -221,8 +300,94 @@ void PxVehiclePhysXRoadGeometryQueryUpdate
 			if (physxRoadGeometryState)
 				physxRoadGeometryState->setToDefault();
 		}
+
+		if (cache)
+			updateCachedQuery(T.p, w, roadGeomState, *physxRoadGeometryState, *cache->state);
 	}
+}
+
+void PxVehiclePhysXRoadGeometryQueryUpdate
+(const PxVehicleWheelParams& wheelParams, const PxVehicleSuspensionParams& suspParams,
+ const PxVehiclePhysXRoadGeometryQueryParams& roadGeomParams, const PxVehiclePhysXMaterialFrictionParams& materialFrictionParams,
+ const PxF32 steerAngle, const PxVehicleRigidBodyState& rigidBodyState, 
+ const PxScene& scene, const PxConvexMesh* unitCylinderSweepMesh, 
+ const PxVehicleFrame& frame,
+ PxVehicleRoadGeometryState& roadGeomState,
+ PxVehiclePhysXRoadGeometryQueryState* physxRoadGeometryState)
+{
+	PxU32 nbSceneQueries = 0;
+	roadGeometryQueryUpdate(
+		wheelParams, suspParams, roadGeomParams, materialFrictionParams,
+		steerAngle, rigidBodyState, scene, unitCylinderSweepMesh, frame, NULL,
+		roadGeomState, physxRoadGeometryState, nbSceneQueries);
+}
+
+namespace
+{
+	struct RoadGeometryQueryRangeProcessor
+	{
+		const PxVehiclePhysXRoadGeometryQueryBatchEntry* entries;
+		PxU32 nbEntries;
+		PxU32 nbEntriesPerRange;
+		const PxVehiclePhysXRoadGeometryQueryCacheParams* cacheParams;
+		PxReal cosDirectionTolerance;
+		const PxScene* scene;
+		const PxConvexMesh* unitCylinderSweepMesh;
+		bool lockScene;
+		volatile PxI32 nbSceneQueries;
+
+		void process(const PxU32 range)
+		{
+			const PxU32 start = range*nbEntriesPerRange;
+			const PxU32 end = PxMin(start + nbEntriesPerRange, nbEntries);
+
+			PxSceneWorkerReadLock lock(const_cast<PxScene&>(*scene), lockScene, PX_FL);
+
+			PxU32 nbRangeSceneQueries = 0;
+			for (PxU32 i = start; i < end; i++)
+			{
+				const PxVehiclePhysXRoadGeometryQueryBatchEntry& e = entries[i];
+				QueryCache cache;
+				cache.params = cacheParams;
+				cache.cosDirectionTolerance = cosDirectionTolerance;
+				cache.state = e.cacheState;
+				roadGeometryQueryUpdate(
+					*e.wheelParams, *e.suspParams, *e.roadGeomParams, *e.materialFrictionParams,
+					e.wheelYawAngle, *e.rigidBodyState, *scene, unitCylinderSweepMesh, *e.frame,
+					e.cacheState ? &cache : NULL,
+					*e.roadGeomState, e.physxRoadGeometryState, nbRangeSceneQueries);
+			}
+
+			if (nbRangeSceneQueries)
+				PxAtomicAdd(&nbSceneQueries, PxI32(nbRangeSceneQueries));
+		}
+	};
+}
+
+PxU32 PxVehiclePhysXRoadGeometryQueryBatchUpdate
+(const PxVehiclePhysXRoadGeometryQueryBatchEntry* entries, const PxU32 nbEntries,
+ const PxVehiclePhysXRoadGeometryQueryCacheParams& cacheParams,
+ const PxScene& scene, const PxConvexMesh* unitCylinderSweepMesh,
+ PxCpuDispatcher* dispatcher, const PxU32 nbEntriesPerTask)
+{
+	PX_CHECK_AND_RETURN_VAL(entries || !nbEntries, "PxVehiclePhysXRoadGeometryQueryBatchUpdate: entries must be a valid pointer", 0);
+	PX_CHECK_AND_RETURN_VAL(cacheParams.isValid(), "PxVehiclePhysXRoadGeometryQueryBatchUpdate: cacheParams must be valid", 0);
+
+	RoadGeometryQueryRangeProcessor processor;
+	processor.entries = entries;
+	processor.nbEntries = nbEntries;
+	processor.nbEntriesPerRange = PxMax(1u, nbEntriesPerTask);
+	processor.cacheParams = &cacheParams;
+	processor.cosDirectionTolerance = PxCos(cacheParams.directionTolerance);
+	processor.scene = &scene;
+	processor.unitCylinderSweepMesh = unitCylinderSweepMesh;
+	processor.lockScene = PxSceneWorkerReadLock::isRequired(const_cast<PxScene&>(scene));
+	processor.nbSceneQueries = 0;
+	const PxU32 nbRanges = (nbEntries + processor.nbEntriesPerRange - 1) / processor.nbEntriesPerRange;
+
+	runBatchRanges(nbRanges, processor, dispatcher);
 
+	return PxU32(processor.nbSceneQueries);
 }
 
 } //namespace vehicle2
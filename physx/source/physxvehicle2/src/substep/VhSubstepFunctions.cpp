@@ -0,0 +1,107 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2023 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "foundation/PxMath.h"
+
+#include "vehicle2/PxVehicleParams.h"
+
+#include "vehicle2/commands/PxVehicleCommandStates.h"
+
+#include "vehicle2/drivetrain/PxVehicleDrivetrainParams.h"
+#include "vehicle2/drivetrain/PxVehicleDrivetrainStates.h"
+
+#include "vehicle2/rigidBody/PxVehicleRigidBodyStates.h"
+
+#include "vehicle2/substep/PxVehicleSubstepFunctions.h"
+#include "vehicle2/substep/PxVehicleSubstepParams.h"
+#include "vehicle2/substep/PxVehicleSubstepStates.h"
+
+#include "vehicle2/suspension/PxVehicleSuspensionParams.h"
+
+namespace physx
+{
+namespace vehicle2
+{
+
+//Smallest number of substeps n such that quantity/n <= maxQuantityPerSubstep.
+PX_FORCE_INLINE PxU32 computeNbSubsteps(const PxReal quantity, const PxReal maxQuantityPerSubstep)
+{
+	const PxReal nbSubsteps = PxCeil(quantity / maxQuantityPerSubstep);
+	return nbSubsteps < 255.0f ? PxU32(nbSubsteps) : 255;
+}
+
+PxU8 PxVehicleSubstepCountUpdate
+(const PxVehicleAxleDescription& axleDescription, const PxVehicleSubstepParams& substepParams,
+ const PxVehicleArrayData<const PxVehicleSuspensionForceParams>& suspensionForceParams,
+ const PxVehicleRigidBodyState& rigidBodyState, const PxVehicleCommandState* commands,
+ const PxVehicleEngineParams* engineParams, const PxVehicleEngineState* engineState,
+ const PxReal dt, const PxVehicleFrame& frame,
+ PxVehicleSubstepState& substepState)
+{
+	PX_ASSERT(!engineState || engineParams);
+
+	//The explicit integration of the suspension springs needs dt*sqrt(k/m) to stay small.
+	//This applies whether the vehicle moves or not.
+	PxReal maxSquaredFrequency = 0.0f;
+	for (PxU32 i = 0; i < axleDescription.nbWheels; i++)
+	{
+		const PxU32 wheelId = axleDescription.wheelIdsInAxleOrder[i];
+		const PxVehicleSuspensionForceParams& suspParams = suspensionForceParams[wheelId];
+		if (suspParams.sprungMass > 0.0f)
+			maxSquaredFrequency = PxMax(maxSquaredFrequency, suspParams.stiffness / suspParams.sprungMass);
+	}
+	PxU32 nbSubsteps = computeNbSubsteps(dt * PxSqrt(maxSquaredFrequency), substepParams.maxSuspensionPhasePerSubstep);
+
+	const PxReal speed = rigidBodyState.linearVelocity.magnitude();
+	const bool throttleReleased = !commands || commands->throttle <= 0.0f;
+	const bool engineIdle = !engineState || engineState->rotationSpeed <= (engineParams->idleOmega + substepParams.engineIdleTolerance);
+	const bool atRest = (speed < substepParams.restSpeed) && throttleReleased && engineIdle;
+
+	if (!atRest)
+	{
+		//Limit the distance travelled per substep.
+		nbSubsteps = PxMax(nbSubsteps, computeNbSubsteps(speed * dt, substepParams.maxTravelPerSubstep));
+
+		//Tire slips are computed with small denominators at low longitudinal speed.
+		if (PxAbs(rigidBodyState.getLongitudinalSpeed(frame)) < substepParams.lowSpeed)
+			nbSubsteps = PxMax(nbSubsteps, PxU32(substepParams.lowSpeedNbSubsteps));
+	}
+
+	nbSubsteps = PxClamp(nbSubsteps, PxU32(substepParams.minNbSubsteps), PxU32(substepParams.maxNbSubsteps));
+
+	substepState.nbSubsteps = PxU8(nbSubsteps);
+	substepState.nbSavedSubsteps = PxU8(substepParams.maxNbSubsteps - nbSubsteps);
+	substepState.atRest = atRest;
+	substepState.totalNbSubsteps += substepState.nbSubsteps;
+	substepState.totalNbSavedSubsteps += substepState.nbSavedSubsteps;
+
+	return substepState.nbSubsteps;
+}
+
+} //namespace vehicle2
+} //namespace physx
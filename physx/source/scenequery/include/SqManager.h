@@ -129,6 +129,7 @@ namespace physx
 class PxRenderOutput;
 class PxBVH;
 class PxSceneLimits;	// PT: TODO: decouple from PxSceneLimits
+struct PxDynamicTreeRefitStats;
 
 namespace Sq
 {
@@ -159,6 +160,7 @@ namespace Sq
 						void							forceRebuildDynamicTree(PxU32 prunerIndex);
 
 						void							updateCompoundActor(PrunerCompoundId compoundId, const PxTransform& compoundTransform);
+						void							updateCompoundActors(const PrunerCompoundId* compoundIds, const PxTransform* compoundTransforms, PxU32 nbCompounds);
 						void							removeCompoundActor(PrunerCompoundId compoundId, Gu::PrunerPayloadRemovalCallback* removalCallback);
 
 						void*							prepareSceneQueriesUpdate(PruningIndex::Enum index);
@@ -172,6 +174,7 @@ namespace Sq
 						void							flushMemory();
 		PX_FORCE_INLINE PxU32							getStaticTimestamp()	const	{ return mStaticTimestamp;	}
 		PX_FORCE_INLINE const Adapter&					getAdapter()			const	{ return mAdapter;			}
+						void							getDynamicTreeRefitStats(PxDynamicTreeRefitStats& stats)	const;
 	private:
 						const Adapter&					mAdapter;
 						PrunerExt						mPrunerExt[PruningIndex::eCOUNT];
@@ -116,6 +116,17 @@ class CompoundPruner : public Gu::BasePruner
 	*/
 	virtual bool					updateCompound(PrunerCompoundId compoundId, const PxTransform& transform) = 0;
 
+	/**
+	Updates a batch of compound objects. The compound-level tree is refit once for the whole batch,
+	compounds that left their neighborhood are reinserted.
+	\param		compoundIds	[in]	compounds to update
+	\param		transforms	[in]	compound transformations
+	\param		nbCompounds	[in]	number of compounds
+
+	\return		true if all updated compounds were dynamic
+	*/
+	virtual bool					updateCompounds(const PrunerCompoundId* compoundIds, const PxTransform* transforms, PxU32 nbCompounds) = 0;
+
 	/**
 	Updates object after manually updating their bounds via "getPayload" calls.
 	\param		compoundId	[in]	compound that the object belongs to
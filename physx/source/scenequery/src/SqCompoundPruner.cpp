@@ -46,10 +46,6 @@ using namespace physx;
 using namespace Gu;
 using namespace Sq;
 
-// PT: TODO: this is copied from SqBounds.h, should be either moved to Gu and shared or passed as a user parameter
-	#define SQ_PRUNER_EPSILON	0.005f
-	#define SQ_PRUNER_INFLATION	(1.0f + SQ_PRUNER_EPSILON)	// pruner test shape inflation (not narrow phase shape)
-
 #define PARANOIA_CHECKS 0
 
 ///////////////////////////////////////////////////////////////////////////////////////////////
@@ -218,6 +214,88 @@ bool BVHCompoundPruner::updateCompound(PrunerCompoundId compoundId, const PxTran
 
 ///////////////////////////////////////////////////////////////////////////////////////////////
 
+// computes the world-space bounds of a compound from the root of its local tree, same as PxBounds3::transformFast
+static PX_FORCE_INLINE void computeCompoundBounds(Vec4V& minV, Vec4V& maxV, const CompoundTree& compoundTree, const PxTransform& transform)
+{
+	const IncrementalAABBTreeNode* root = compoundTree.mTree->getNodes();
+
+	const FloatV halfV = FLoad(0.5f);
+	const Vec3V localCenter = Vec3V_From_Vec4V(V4Scale(V4Add(root->mBVMax, root->mBVMin), halfV));
+	const Vec3V localExtents = Vec3V_From_Vec4V(V4Scale(V4Sub(root->mBVMax, root->mBVMin), halfV));
+
+	const QuatV q = QuatVLoadU(&transform.q.x);
+	const Vec3V center = V3Add(V3LoadU(transform.p), QuatRotate(q, localCenter));
+	const Vec3V extents = M33MulV3(M33Abs(QuatGetMat33V(q)), localExtents);
+
+	minV = V4ClearW(Vec4V_From_Vec3V(V3Sub(center, extents)));
+	maxV = V4ClearW(Vec4V_From_Vec3V(V3Add(center, extents)));
+}
+
+bool BVHCompoundPruner::updateCompounds(const PrunerCompoundId* compoundIds, const PxTransform* transforms, PxU32 nbCompounds)
+{
+	bool allDynamic = true;
+
+	CompoundTree* compoundTrees = mCompoundTreePool.getCompoundTrees();
+	PxBounds3* compoundBounds = mCompoundTreePool.getCurrentCompoundBounds();
+
+	mRefitLeaves.clear();
+	mReinsertedCompounds.clear();
+
+	// first pass: update the poses & bounds, and decide per compound between a refit and a reinsertion. A compound
+	// that stays within the bounds of its leaf's parent can be refit without growing any node of the main tree, i.e.
+	// without degrading the tree. Otherwise it left its neighborhood and it is reinserted like in updateCompound.
+	for(PxU32 i = 0; i < nbCompounds; i++)
+	{
+		const ActorIdPoolIndexMap::Entry* poolIndexEntry = mActorPoolMap.find(compoundIds[i]);
+		PX_ASSERT(poolIndexEntry);
+		if(!poolIndexEntry)
+			continue;
+
+		const PoolIndex poolIndex = poolIndexEntry->second;
+
+		CompoundTree& compoundTree = compoundTrees[poolIndex];
+		if(!(compoundTree.mFlags & PxCompoundPrunerQueryFlag::eDYNAMIC))
+			allDynamic = false;
+
+		compoundTree.mGlobalPose = transforms[i];
+
+		Vec4V minV, maxV;
+		computeCompoundBounds(minV, maxV, compoundTree, transforms[i]);
+		V3StoreU(Vec3V_From_Vec4V(minV), compoundBounds[poolIndex].minimum);
+		V3StoreU(Vec3V_From_Vec4V(maxV), compoundBounds[poolIndex].maximum);
+
+		IncrementalAABBTreeNode* leaf = mMainTreeUpdateMap[poolIndex];
+		const IncrementalAABBTreeNode* parent = leaf->mParent;
+		if(!parent || !(PxIntBool(V4AnyGrtr3(parent->mBVMin, minV)) || PxIntBool(V4AnyGrtr3(maxV, parent->mBVMax))))
+			mRefitLeaves.pushBack(leaf);
+		else
+			mReinsertedCompounds.pushBack(poolIndex);
+	}
+
+	// second pass: refit the main tree once for the whole batch
+	if(mRefitLeaves.size())
+		mMainTree.refitLeaves(mRefitLeaves.begin(), mRefitLeaves.size(), compoundBounds);
+
+	// third pass: reinsert the compounds that moved away
+	const PxU32 nbReinserted = mReinsertedCompounds.size();
+	for(PxU32 i = 0; i < nbReinserted; i++)
+	{
+		const PoolIndex poolIndex = mReinsertedCompounds[i];
+		mChangedLeaves.clear();
+		IncrementalAABBTreeNode* mainTreeNode = mMainTree.update(mMainTreeUpdateMap[poolIndex], poolIndex, compoundBounds, mChangedLeaves);
+		// we removed node during update, need to update the mapping
+		updateMapping(poolIndex, mainTreeNode);
+	}
+
+#if PARANOIA_CHECKS
+	test();
+#endif
+
+	return allDynamic;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+
 void BVHCompoundPruner::test()
 {
 	if(mMainTree.getNodes())
@@ -313,16 +391,18 @@ struct MainTreeRaycastCompoundPrunerCallback : MainTreeCompoundPrunerCallback<Co
 		if(filtering(compoundTree))
 			return true;
 
-		// transfer to actor local space
-		const PxVec3 localOrigin = compoundTree.mGlobalPose.transformInv(mOrigin);
-		const PxVec3 localDir = compoundTree.mGlobalPose.q.rotateInv(mUnitDir);
-		PxVec3 localExtent = mExtent;
+		// transfer to actor local space. With many small compounds this runs for most main tree hits, so it's done in SIMD.
+		const QuatV q = QuatVLoadU(&compoundTree.mGlobalPose.q.x);
 
+		PxVec3 localOrigin, localDir;
+		V3StoreU(QuatRotateInv(q, V3Sub(V3LoadU(mOrigin), V3LoadU(compoundTree.mGlobalPose.p))), localOrigin);
+		V3StoreU(QuatRotateInv(q, V3LoadU(mUnitDir)), localDir);
+
+		PxVec3 localExtent = mExtent;
 		if(tInflate)
 		{
-			const PxBounds3 wBounds = PxBounds3::centerExtents(mOrigin, mExtent);
-			const PxBounds3 localBounds = PxBounds3::transformSafe(compoundTree.mGlobalPose.getInverse(), wBounds);
-			localExtent = localBounds.getExtents();
+			// local extents of the world-space inflation box, same as transforming its bounds by the inverse pose
+			V3StoreU(M33TrnspsMulV3(M33Abs(QuatGetMat33V(q)), V3LoadU(mExtent)), localExtent);
 		}
 
 		// raycast the merged tree
@@ -65,6 +65,7 @@ namespace Sq
 		virtual		bool						addCompound(Gu::PrunerHandle* results, const Gu::BVH& bvh, PrunerCompoundId compoundId, const PxTransform& transform, bool isDynamic, const Gu::PrunerPayload* data, const PxTransform* transforms);
 		virtual		bool						removeCompound(PrunerCompoundId compoundId, Gu::PrunerPayloadRemovalCallback* removalCallback);
 		virtual		bool						updateCompound(PrunerCompoundId compoundId, const PxTransform& transform);
+		virtual		bool						updateCompounds(const PrunerCompoundId* compoundIds, const PxTransform* transforms, PxU32 nbCompounds);
 		// object level
 		virtual		void						updateObjectAfterManualBoundsUpdates(PrunerCompoundId compoundId, const Gu::PrunerHandle handle);
 		virtual		void						removeObject(PrunerCompoundId compoundId, const Gu::PrunerHandle handle, Gu::PrunerPayloadRemovalCallback* removalCallback);
@@ -93,6 +94,8 @@ namespace Sq
 					ActorIdPoolIndexMap			mActorPoolMap;
 					PoolIndexActorIdMap			mPoolActorMap;
 					Gu::NodeList				mChangedLeaves;
+					Gu::NodeList				mRefitLeaves;
+					PxArray<Gu::PoolIndex>		mReinsertedCompounds;
 		mutable		bool						mDrawStatic;
 		mutable		bool						mDrawDynamic;
 	};
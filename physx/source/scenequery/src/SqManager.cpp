@@ -235,6 +235,7 @@ void CompoundPrunerExt::removeFromDirtyList(PrunerCompoundId compoundId, PrunerH
 #include "GuBVH.h"
 #include "foundation/PxAlloca.h"
 #include "PxSceneDesc.h"	// PT: for PxSceneLimits TODO: remove
+#include "PxSceneQuerySystem.h"
 
 namespace
 {
@@ -499,6 +500,26 @@ void PrunerManager::visualize(PxU32 prunerIndex, PxRenderOutput& out) const
 	}
 }
 
+static void accumulateRefitStats(PxDynamicTreeRefitStats& stats, const Pruner* pruner)
+{
+	if(!pruner || !pruner->isDynamic())
+		return;
+
+	PrunerRefitStats refitStats;
+	static_cast<const DynamicPruner*>(pruner)->getRefitStats(refitStats);
+	stats.nbUpdatedObjects	+= refitStats.mNbUpdatedObjects;
+	stats.nbRefitNodes		+= refitStats.mNbRefitNodes;
+	stats.nbBulkRefits		+= refitStats.mBulkRefit ? 1u : 0u;
+	stats.refitTime			+= refitStats.mRefitTime;
+}
+
+void PrunerManager::getDynamicTreeRefitStats(PxDynamicTreeRefitStats& stats) const
+{
+	stats = PxDynamicTreeRefitStats();
+	for(PxU32 i=0; i<PruningIndex::eCOUNT; i++)
+		accumulateRefitStats(stats, getPruner(PruningIndex::Enum(i)));
+}
+
 void PrunerManager::shiftOrigin(const PxVec3& shift)
 {
 	for(PxU32 i=0; i<PruningIndex::eCOUNT; i++)
@@ -532,6 +553,16 @@ void PrunerManager::updateCompoundActor(PrunerCompoundId compoundId, const PxTra
 		invalidateStaticTimestamp();
 }
 
+void PrunerManager::updateCompoundActors(const PrunerCompoundId* compoundIds, const PxTransform* compoundTransforms, PxU32 nbCompounds)
+{
+	PX_ASSERT(mCompoundPrunerExt.mPruner);
+	if(!nbCompounds)
+		return;
+	const bool allDynamic = mCompoundPrunerExt.mPruner->updateCompounds(compoundIds, compoundTransforms, nbCompounds);
+	if(!allDynamic)
+		invalidateStaticTimestamp();
+}
+
 void PrunerManager::removeCompoundActor(PrunerCompoundId compoundId, PrunerPayloadRemovalCallback* removalCallback)
 {
 	PX_ASSERT(mCompoundPrunerExt.mPruner);
@@ -54,6 +54,7 @@ namespace Sc
 											{ 
 												mConnector = &n;	
 												mSolverPrep = shaders.solverPrep;
+												mSolverPrepBatch = shaders.solverPrepBatch;
 												mProject = shaders.project;
 												mVisualize = shaders.visualize;
 											}
@@ -88,6 +89,7 @@ namespace Sc
 	PX_FORCE_INLINE	PxConstraintVisualize	getVisualize()									const	{ return mVisualize;				}
 	PX_FORCE_INLINE	PxConstraintProject		getProject()									const	{ return mProject;					}
 	PX_FORCE_INLINE	PxConstraintSolverPrep	getSolverPrep()									const	{ return mSolverPrep;				}
+	PX_FORCE_INLINE	PxConstraintSolverPrepBatch	getSolverPrepBatch()						const	{ return mSolverPrepBatch;			}
 	PX_FORCE_INLINE	PxU32					getConstantBlockSize()							const	{ return mDataSize;					}
 
 	PX_FORCE_INLINE	void					setSim(ConstraintSim* sim)
@@ -120,6 +122,7 @@ namespace Sc
 					PxReal					mMinResponseThreshold;
 
 					ConstraintSim*			mSim;
+					PxConstraintSolverPrepBatch	mSolverPrepBatch;
 	};
 
 } // namespace Sc
@@ -45,7 +45,8 @@ Sc::ConstraintCore::ConstraintCore(PxConstraintConnector& connector, const PxCon
 	mLinearBreakForce		(PX_MAX_F32),
 	mAngularBreakForce		(PX_MAX_F32),
 	mMinResponseThreshold	(0.0f),
-	mSim					(NULL)
+	mSim					(NULL),
+	mSolverPrepBatch		(shaders.solverPrepBatch)
 {
 }
 
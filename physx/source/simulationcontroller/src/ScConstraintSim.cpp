@@ -135,6 +135,7 @@ bool Sc::ConstraintSim::createLLConstraint()
 	llc.constantBlockSize		= PxU16(constantBlockSize);
 
 	llc.solverPrep				= core.getSolverPrep();
+	llc.solverPrepBatch			= core.getSolverPrepBatch();
 	llc.project					= core.getProject();
 	llc.constantBlock			= constantBlock;
 
@@ -193,6 +193,7 @@ void Sc::ConstraintCore::getBinaryMetaData(PxOutputStream& stream)
 	PX_DEF_BIN_METADATA_ITEM(stream,		ConstraintCore, PxReal,					mAngularBreakForce,		0)
 	PX_DEF_BIN_METADATA_ITEM(stream,		ConstraintCore, PxReal,					mMinResponseThreshold,	0)		
 	PX_DEF_BIN_METADATA_ITEM(stream,		ConstraintCore, ConstraintSim,			mSim,					PxMetaDataFlag::ePTR)
+	PX_DEF_BIN_METADATA_ITEM(stream,		ConstraintCore, PxConstraintSolverPrepBatch,	mSolverPrepBatch,	PxMetaDataFlag::ePTR)
 }
 
 ///////////////////////////////////////////////////////////////////////////////
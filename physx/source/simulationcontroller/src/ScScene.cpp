@@ -925,6 +925,7 @@ Sc::Scene::Scene(const PxSceneDesc& desc, PxU64 contextID) :
 	const bool useEnhancedDeterminism = mPublicFlags & PxSceneFlag::eENABLE_ENHANCED_DETERMINISM;
 
 	mSimpleIslandManager = PX_NEW(IG::SimpleIslandManager)(useEnhancedDeterminism, contextID);
+	mSimpleIslandManager->setMaxNbKinematicWakeNodesPerFrame(desc.maxNbKinematicWakeNodesPerFrame);
 
 	if (!useGpuDynamics)
 	{
@@ -3471,6 +3472,13 @@ void Sc::Scene::setEdgesConnected(PxBaseTask*)
 
 	mSimpleIslandManager->secondPassIslandGen();
 
+	{
+		const IG::IslandSim& islandSim = mSimpleIslandManager->getAccurateIslandSim();
+		PxvSimStats& simStats = mLLContext->getSimStats();
+		simStats.mNbDeferredIslandWakes = islandSim.getNbDeferredIslandWakes();
+		simStats.mNbDeferredNodeWakes = islandSim.getNbDeferredNodeWakes();
+	}
+
 	wakeObjectsUp(ActorSim::AS_PART_OF_ISLAND_GEN);
 }
 
@@ -131,6 +131,8 @@ void Sc::SimStats::readOut(PxSimulationStatistics& s, const PxvSimStats& simStat
 	s.nbNewTouches = simStats.mNbNewTouches;
 	s.nbLostTouches = simStats.mNbLostTouches;
 	s.nbPartitions = simStats.mNbPartitions;
+	s.nbDeferredIslandWakes = simStats.mNbDeferredIslandWakes;
+	s.nbDeferredNodeWakes = simStats.mNbDeferredNodeWakes;
 
 	s.gpuMemParticles = gpuMemSizeParticles;
 	s.gpuMemSoftBodies = gpuMemSizeSoftBodies;